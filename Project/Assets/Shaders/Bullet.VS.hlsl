@@ -1,11 +1,6 @@
-struct RENDER_DATA {
-	float4x4 Transform;
-	uint ElementType;
-	float Opacity;
-};
+#include"InstanceRecord.hlsli"
 
-StructuredBuffer<RENDER_DATA> BulletPool : register(t0);
-StructuredBuffer<uint> Indices_Active : register(t1);
+StructuredBuffer<uint4> BulletPool : register(t0);
 
 StructuredBuffer<float4> MeshPositions : register(t0, space3);
 StructuredBuffer<float2> MeshTexCoords : register(t1, space3);
@@ -42,12 +37,12 @@ VSOutput main(VSInput input_, uint instID_ : SV_InstanceID, uint vertID_ : SV_Ve
 	VSOutput output;
 	
 	output.Position = MeshPositions[input_.IDX_POSITION];
-	RENDER_DATA data = BulletPool[Indices_Active[instID_]];
-	output.Position = mul(output.Position, data.Transform);
+	INSTANCE data = DecodeInstance(BulletPool[instID_]);
+	output.Position = mul(output.Position, InstanceTransform(data));
 	output.Position = mul(output.Position, VP.Mat);
 	//output.Color = float4(1.0f, 1.0f, 1.0f, 1.0f);
 	float3 color0 = float3(MeshTexCoords[input_.IDX_TEXCOORD], 1.0f);
-	output.Color = float4(color0 * ElementColor[data.ElementType], 0.25f * data.Opacity);
+	output.Color = float4(color0 * ElementColor[data.Element], 0.25f * data.Life / 180.0f);
 	
 	//SetVSOutput(output, input_, instID_);
 	
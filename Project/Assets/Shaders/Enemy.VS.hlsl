@@ -1,10 +1,6 @@
-struct RENDER_DATA {
-	float4x4 Transform;
-	uint ElementType;
-};
+#include"InstanceRecord.hlsli"
 
-StructuredBuffer<RENDER_DATA> EnemyPool : register(t0);
-StructuredBuffer<uint> Indices_Active : register(t1);
+StructuredBuffer<uint4> EnemyPool : register(t0);
 
 StructuredBuffer<float4> MeshPositions : register(t0, space3);
 StructuredBuffer<float2> MeshTexCoords : register(t1, space3);
@@ -42,12 +38,12 @@ VSOutput main(VSInput input_, uint instID_ : SV_InstanceID, uint vertID_ : SV_Ve
 	VSOutput output;
 	
 	output.Position = MeshPositions[input_.IDX_POSITION];
-	RENDER_DATA data = EnemyPool[Indices_Active[instID_]];
-	output.Position = mul(output.Position, data.Transform);
+	INSTANCE data = DecodeInstance(EnemyPool[instID_]);
+	output.Position = mul(output.Position, InstanceTransform(data));
 	output.Position = mul(output.Position, VP.Mat);
 	//output.Color = float4(1.0f, 1.0f, 1.0f, 1.0f);
 	float3 color0 = float3(MeshTexCoords[input_.IDX_TEXCOORD], 1.0f);
-	output.Color = float4(color0 * 0.5f + ElementColor[data.ElementType], 1.0f);
+	output.Color = float4(color0 * 0.5f + ElementColor[data.Element], 1.0f);
 	output.TexCoord = MeshTexCoords[input_.IDX_TEXCOORD];
 	
 	//SetVSOutput(output, input_, instID_);
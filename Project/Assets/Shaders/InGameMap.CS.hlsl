@@ -8,9 +8,11 @@ struct MapBlock {
 	uint TextureID;
 };
 
+// Counterpart of Scene_InGame::MapMetadata. The map is a window of Width x Height chunks, held chunk by chunk.
 struct MAPMETADATA {
 	uint Width;
 	uint Height;
+	float2 Offset;
 };
 
 StructuredBuffer<int> MapBlockData : register(t0);
@@ -1,6 +1,8 @@
+// Counterpart of Scene_InGame::MapMetadata. The map is a window of Width x Height chunks, held chunk by chunk.
 struct MAPMETADATA {
 	uint Width;
 	uint Height;
+	float2 Offset;
 };
 
 StructuredBuffer<int> Map : register(t0);
@@ -70,10 +72,15 @@ ConstantBuffer<ViewProjection> VP : register(b0, space1);
 //	output_.Color = float4(1.0f, 1.0f, 1.0f, 1.0f);
 //}
 
-float3 BlockPosition(int block_) {
-	uint x = block_ % MapMetadata.Width;
-	uint y = block_ / MapMetadata.Width;
-	return float3(x * 2.0f, y * 2.0f, 0.0f);
+#define LOG2_CHUNK_SIZE 5U
+#define CHUNK_MASK ((1U << LOG2_CHUNK_SIZE) - 1U)
+
+// Relative to the render origin: the chunk's slot in the window, then the tile in the chunk, both row by row.
+float3 BlockPosition(uint block_) {
+	uint slot = block_ >> (LOG2_CHUNK_SIZE * 2U);
+	uint2 tile = uint2(slot % MapMetadata.Width, slot / MapMetadata.Width) << LOG2_CHUNK_SIZE;
+	tile += uint2(block_ & CHUNK_MASK, (block_ >> LOG2_CHUNK_SIZE) & CHUNK_MASK);
+	return float3(MapMetadata.Offset + float2(tile) * 2.0f, 0.0f);
 }
 
 static float v[6] = { 0.1f, 0.2f, 0.0f, 0.1f, 0.3f, 0.2f };
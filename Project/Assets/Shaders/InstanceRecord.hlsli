@@ -0,0 +1,42 @@
+// Counterpart of Game.InstanceRecord (Src/Game/InstanceRecord.ixx).
+//
+//	Word[0] : half PositionX	| half PositionY << 16
+//	Word[1] : half Scale		| uint16 Angle.z << 16
+//	Word[2] : uint16 Angle.x	| uint16 Angle.y << 16
+//	Word[3] : uint8 Element		| uint24 Life << 8
+
+struct INSTANCE {
+	float3 Position;
+	float3 Rotate;
+	float Scale;
+	uint Element;
+	uint Life;
+};
+
+static const float TurnToAngle = 6.28318530718f / 65536.0f;
+
+INSTANCE DecodeInstance(uint4 record_) {
+	INSTANCE inst;
+	inst.Position = float3(f16tof32(record_.x), f16tof32(record_.x >> 16), 0.0f);
+	inst.Scale = f16tof32(record_.y);
+	inst.Rotate = float3(
+		(record_.z & 0xFFFF) * TurnToAngle,
+		(record_.z >> 16) * TurnToAngle,
+		(record_.y >> 16) * TurnToAngle
+	);
+	inst.Element = record_.w & 0xFF;
+	inst.Life = record_.w >> 8;
+	return inst;
+}
+
+// Same layout as Lumina::Mat4::SRT, for row vectors.
+float4x4 InstanceTransform(INSTANCE inst_) {
+	float3 c, s;
+	sincos(inst_.Rotate, s, c);
+	return float4x4(
+		inst_.Scale * float4(c.y * c.z, c.y * s.z, -s.y, 0.0f),
+		inst_.Scale * float4(s.x * s.y * c.z - c.x * s.z, s.x * s.y * s.z + c.x * c.z, s.x * c.y, 0.0f),
+		inst_.Scale * float4(c.x * s.y * c.z + s.x * s.z, c.x * s.y * s.z - s.x * c.z, c.x * c.y, 0.0f),
+		float4(inst_.Position, 1.0f)
+	);
+}
\ No newline at end of file
@@ -0,0 +1,360 @@
+export module Benchmark.AABBTree;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cmath>;
+
+import <random>;
+import <memory>;
+import <utility>;
+
+import <vector>;
+import <algorithm>;
+
+import Benchmark.Harness;
+
+import Lumina.Math.Vector;
+import Lumina.Math.KDTree;
+import Lumina.Math.AABBTree;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::AABBTree {
+	namespace {
+		template<uint32_t N_Dims>
+		using Point = typename Lumina::AABBTree<N_Dims>::Point;
+		template<uint32_t N_Dims>
+		using Box = typename Lumina::AABBTree<N_Dims>::Box;
+
+		// A bouncing ball: enemies and bullets of a few sizes, drifting at different speeds.
+		template<uint32_t N_Dims>
+		struct Mover {
+			Point<N_Dims> Position;
+			Point<N_Dims> Velocity;
+			float Radius;
+		};
+
+		constexpr uint32_t Num_Movers{ 10000U };
+		// About 5 neighbours per mover at Num_Movers in 2D.
+		constexpr float WorldSize{ 400.0f };
+
+		template<uint32_t N_Dims>
+		std::vector<Mover<N_Dims>> Movers(uint32_t num_, std::mt19937& rndGen_) {
+			std::uniform_real_distribution<float> dist_Position{ 0.0f, WorldSize };
+			std::uniform_real_distribution<float> dist_Velocity{ -0.2f, 0.2f };
+			std::uniform_real_distribution<float> dist_Radius{ 0.25f, 1.0f };
+			std::vector<Mover<N_Dims>> movers(num_);
+			for (auto& mover : movers) {
+				for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+					mover.Position[idx_Dim] = dist_Position(rndGen_);
+					mover.Velocity[idx_Dim] = dist_Velocity(rndGen_);
+				}
+				mover.Radius = dist_Radius(rndGen_);
+			}
+			return movers;
+		}
+
+		template<uint32_t N_Dims>
+		void Step(Mover<N_Dims>& mover_) {
+			for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+				mover_.Position[idx_Dim] += mover_.Velocity[idx_Dim];
+				if (mover_.Position[idx_Dim] < 0.0f || mover_.Position[idx_Dim] > WorldSize) { mover_.Velocity[idx_Dim] *= -1.0f; }
+			}
+		}
+
+		template<uint32_t N_Dims>
+		Box<N_Dims> BoxOf(Mover<N_Dims> const& mover_) {
+			Box<N_Dims> box{};
+			for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+				box.Min[idx_Dim] = mover_.Position[idx_Dim] - mover_.Radius;
+				box.Max[idx_Dim] = mover_.Position[idx_Dim] + mover_.Radius;
+			}
+			return box;
+		}
+
+		// Index pairs (i < j) of movers whose tight boxes overlap, sorted.
+		template<uint32_t N_Dims>
+		std::vector<std::pair<uint32_t, uint32_t>> BruteForcePairs(std::vector<Box<N_Dims>> const& boxes_) {
+			std::vector<std::pair<uint32_t, uint32_t>> pairs{};
+			for (uint32_t i{ 0U }; i < static_cast<uint32_t>(boxes_.size()); ++i) {
+				for (uint32_t j{ i + 1U }; j < static_cast<uint32_t>(boxes_.size()); ++j) {
+					if (Lumina::AABBTree<N_Dims>::Overlaps(boxes_[i], boxes_[j])) { pairs.emplace_back(i, j); }
+				}
+			}
+			return pairs;
+		}
+
+		// Moves, adds and removes proxies for a number of frames, checking the structure and every kind of query
+		// against a scan of the fat boxes as the tree reports them.
+		template<uint32_t N_Dims>
+		bool MatchesBruteForce(uint32_t num_Movers_, uint32_t seed_) {
+			using Tree = Lumina::AABBTree<N_Dims>;
+
+			std::mt19937 rndGen{ seed_ };
+			auto movers{ Movers<N_Dims>(num_Movers_, rndGen) };
+			// Slots of destroyed movers hold Invalid.
+			std::vector<uint32_t> proxies(num_Movers_);
+			Tree tree{};
+			for (uint32_t i{ 0U }; i < num_Movers_; ++i) { proxies[i] = tree.CreateProxy(BoxOf(movers[i]), i); }
+
+			std::uniform_real_distribution<float> dist_Position{ 0.0f, WorldSize };
+			for (uint32_t frame{ 0U }; frame < 60U; ++frame) {
+				for (uint32_t i{ 0U }; i < num_Movers_; ++i) {
+					uint32_t const dice{ static_cast<uint32_t>(rndGen() % 64U) };
+					if (dice == 0U) {
+						if (proxies[i] == Tree::Invalid) {
+							proxies[i] = tree.CreateProxy(BoxOf(movers[i]), i);
+						}
+						else {
+							tree.DestroyProxy(proxies[i]);
+							proxies[i] = Tree::Invalid;
+						}
+						continue;
+					}
+					if (proxies[i] == Tree::Invalid) { continue; }
+
+					Point<N_Dims> const position_Old{ movers[i].Position };
+					if (dice == 1U) {
+						// Teleports, which the fat box cannot anticipate.
+						for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) { movers[i].Position[idx_Dim] = dist_Position(rndGen); }
+					}
+					else {
+						Step(movers[i]);
+					}
+					tree.MoveProxy(proxies[i], BoxOf(movers[i]), movers[i].Position - position_Old);
+					if (!Tree::Contains(tree.FatBounds(proxies[i]), BoxOf(movers[i]))) { return false; }
+				}
+				if (!tree.Validate()) { return false; }
+
+				std::vector<Box<N_Dims>> fats(num_Movers_);
+				for (uint32_t i{ 0U }; i < num_Movers_; ++i) {
+					if (proxies[i] != Tree::Invalid) {
+						if (tree.UserData(proxies[i]) != i) { return false; }
+						fats[i] = tree.FatBounds(proxies[i]);
+					}
+					else {
+						// Far outside the world, where it overlaps nothing.
+						for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+							fats[i].Min[idx_Dim] = -1000.0f - static_cast<float>(i) * 4.0f;
+							fats[i].Max[idx_Dim] = -1000.0f - static_cast<float>(i) * 4.0f + 1.0f;
+						}
+					}
+				}
+
+				// Regions
+				for (uint32_t idx_Query{ 0U }; idx_Query < 16U; ++idx_Query) {
+					Box<N_Dims> region{};
+					for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+						region.Min[idx_Dim] = dist_Position(rndGen);
+						region.Max[idx_Dim] = region.Min[idx_Dim] + 30.0f;
+					}
+					std::vector<uint32_t> found{};
+					tree.Query(region, [&] (uint32_t proxy_) { found.emplace_back(tree.UserData(proxy_)); });
+					std::sort(found.begin(), found.end());
+					std::vector<uint32_t> expected{};
+					for (uint32_t i{ 0U }; i < num_Movers_; ++i) {
+						if (Tree::Overlaps(fats[i], region)) { expected.emplace_back(i); }
+					}
+					if (found != expected) { return false; }
+				}
+
+				// Pairs
+				if (frame % 10U == 9U) {
+					std::vector<std::pair<uint32_t, uint32_t>> found{};
+					tree.QueryPairs(
+						[&] (uint32_t proxyA_, uint32_t proxyB_) {
+							uint32_t const a{ tree.UserData(proxyA_) };
+							uint32_t const b{ tree.UserData(proxyB_) };
+							found.emplace_back(std::min(a, b), std::max(a, b));
+						}
+					);
+					std::sort(found.begin(), found.end());
+					if (found != BruteForcePairs<N_Dims>(fats)) { return false; }
+				}
+			}
+
+			for (uint32_t const proxy : proxies) {
+				if (proxy != Tree::Invalid) { tree.DestroyProxy(proxy); }
+			}
+			return tree.Num_Proxies() == 0U && tree.Height() == 0U && tree.Validate();
+		}
+
+		// Entry distance of origin_ + t * direction_ into box_, or a negative value for a miss.
+		template<uint32_t N_Dims>
+		float RayHit(Point<N_Dims> const& origin_, Point<N_Dims> const& direction_, Box<N_Dims> const& box_) {
+			float t_Enter{ 0.0f };
+			float t_Exit{ WorldSize * 4.0f };
+			for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+				if (direction_[idx_Dim] == 0.0f) {
+					if (origin_[idx_Dim] < box_.Min[idx_Dim] || origin_[idx_Dim] > box_.Max[idx_Dim]) { return -1.0f; }
+					continue;
+				}
+				float t1{ (box_.Min[idx_Dim] - origin_[idx_Dim]) / direction_[idx_Dim] };
+				float t2{ (box_.Max[idx_Dim] - origin_[idx_Dim]) / direction_[idx_Dim] };
+				if (t1 > t2) { std::swap(t1, t2); }
+				t_Enter = std::max(t_Enter, t1);
+				t_Exit = std::min(t_Exit, t2);
+			}
+			return (t_Enter <= t_Exit) ? t_Enter : -1.0f;
+		}
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		suite_.Verify("Math/AABBTree/2D/BruteForce", [] () {
+			for (uint32_t const num_Movers : { 1U, 2U, 3U, 17U, 1000U }) {
+				if (!MatchesBruteForce<2U>(num_Movers, num_Movers + 1U)) { return false; }
+			}
+			return true;
+		});
+		suite_.Verify("Math/AABBTree/3D/BruteForce", [] () {
+			for (uint32_t const num_Movers : { 1U, 2U, 3U, 17U, 1000U }) {
+				if (!MatchesBruteForce<3U>(num_Movers, num_Movers + 2U)) { return false; }
+			}
+			return true;
+		});
+		// The nearest tight box along a ray, found by clipping the ray at every hit.
+		suite_.Verify("Math/AABBTree/RayCast", [] () {
+			std::mt19937 rndGen{ 5U };
+			auto const movers{ Movers<2U>(2000U, rndGen) };
+			Lumina::AABBTree<2U> tree{};
+			for (uint32_t i{ 0U }; i < static_cast<uint32_t>(movers.size()); ++i) { tree.CreateProxy(BoxOf(movers[i]), i); }
+
+			std::uniform_real_distribution<float> dist_Position{ 0.0f, WorldSize };
+			std::uniform_real_distribution<float> dist_Angle{ 0.0f, 6.2831853f };
+			for (uint32_t idx_Ray{ 0U }; idx_Ray < 256U; ++idx_Ray) {
+				Lumina::Vec2 const origin{ dist_Position(rndGen), dist_Position(rndGen) };
+				float const angle{ dist_Angle(rndGen) };
+				// Some rays run along an axis.
+				Lumina::Vec2 const direction{
+					(idx_Ray % 8U == 0U) ? Lumina::Vec2{ 1.0f, 0.0f } : Lumina::Vec2{ std::cos(angle), std::sin(angle) }
+				};
+				float const maxT{ 50.0f };
+
+				uint32_t idx_Hit{ Lumina::AABBTree<2U>::Invalid };
+				tree.RayCast(
+					origin, direction, maxT,
+					[&] (uint32_t proxy_, float maxT_) {
+						float const t{ RayHit<2U>(origin, direction, BoxOf(movers[tree.UserData(proxy_)])) };
+						if (t < 0.0f || t >= maxT_) { return maxT_; }
+						idx_Hit = tree.UserData(proxy_);
+						return t;
+					}
+				);
+
+				float t_Nearest{ maxT };
+				uint32_t idx_Nearest{ Lumina::AABBTree<2U>::Invalid };
+				for (uint32_t i{ 0U }; i < static_cast<uint32_t>(movers.size()); ++i) {
+					float const t{ RayHit<2U>(origin, direction, BoxOf(movers[i])) };
+					if (t >= 0.0f && t < t_Nearest) {
+						t_Nearest = t;
+						idx_Nearest = i;
+					}
+				}
+				if ((idx_Hit == Lumina::AABBTree<2U>::Invalid) != (idx_Nearest == Lumina::AABBTree<2U>::Invalid)) { return false; }
+				if (idx_Hit != Lumina::AABBTree<2U>::Invalid && RayHit<2U>(origin, direction, BoxOf(movers[idx_Hit])) != t_Nearest) { return false; }
+			}
+			return true;
+		});
+		// Boxes inserted in sorted order, which degenerate a tree that only ever appends, stay within a few levels of log2(n).
+		suite_.Verify("Math/AABBTree/Balanced", [] () {
+			Lumina::AABBTree<2U> tree{};
+			for (uint32_t i{ 0U }; i < 4096U; ++i) {
+				float const x{ static_cast<float>(i) };
+				tree.CreateProxy({ { x, 0.0f }, { x + 0.5f, 0.5f } }, i);
+			}
+			return tree.Validate() && tree.Height() <= 24U;
+		});
+
+		//----	------	------	------	------	----//
+		//	Update and query					//
+		//----	------	------	------	------	----//
+
+		// One frame of Num_Movers moving objects: move everything, then find every overlapping pair.
+		std::mt19937 rndGen{ 0x4C554D49U };
+		auto const movers{ std::make_shared<std::vector<Mover<2U>>>(Movers<2U>(Num_Movers, rndGen)) };
+		float const maxRadius{
+			std::max_element(movers->cbegin(), movers->cend(), [] (auto const& lhs_, auto const& rhs_) { return lhs_.Radius < rhs_.Radius; })->Radius
+		};
+
+		suite_.Add("Math/AABBTree/10k/BruteForce", [movers] (uint64_t num_Iterations_) {
+			auto frame{ *movers };
+			std::vector<Box<2U>> boxes(frame.size());
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				for (uint32_t j{ 0U }; j < Num_Movers; ++j) {
+					Step(frame[j]);
+					boxes[j] = BoxOf(frame[j]);
+				}
+				uint32_t num_Pairs{ 0U };
+				for (uint32_t j{ 0U }; j < Num_Movers; ++j) {
+					for (uint32_t k{ j + 1U }; k < Num_Movers; ++k) {
+						num_Pairs += Lumina::AABBTree<2U>::Overlaps(boxes[j], boxes[k]) ? 1U : 0U;
+					}
+				}
+				DoNotOptimize(num_Pairs);
+			}
+		});
+		// Rebuilt every frame; a query has to reach as far as the largest object, and each pair turns up from both sides.
+		suite_.Add("Math/AABBTree/10k/KDTree", [movers, maxRadius] (uint64_t num_Iterations_) {
+			auto frame{ *movers };
+			std::vector<Lumina::Vec2> positions(frame.size());
+			Lumina::KDTree<2U> tree{};
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				for (uint32_t j{ 0U }; j < Num_Movers; ++j) {
+					Step(frame[j]);
+					positions[j] = frame[j].Position;
+				}
+				tree.Rebuild(positions);
+				uint32_t num_Pairs{ 0U };
+				for (uint32_t j{ 0U }; j < Num_Movers; ++j) {
+					Box<2U> const box{ BoxOf(frame[j]) };
+					tree.ForEachInRadius(
+						positions[j], (frame[j].Radius + maxRadius) * 1.4142136f,
+						[&] (uint32_t idx_, float) {
+							if (idx_ > j && Lumina::AABBTree<2U>::Overlaps(box, BoxOf(frame[idx_]))) { ++num_Pairs; }
+						}
+					);
+				}
+				DoNotOptimize(num_Pairs);
+			}
+		});
+		suite_.Add("Math/AABBTree/10k/AABBTree", [movers] (uint64_t num_Iterations_) {
+			auto frame{ *movers };
+			Lumina::AABBTree<2U> tree{};
+			std::vector<uint32_t> proxies(frame.size());
+			for (uint32_t j{ 0U }; j < Num_Movers; ++j) { proxies[j] = tree.CreateProxy(BoxOf(frame[j]), j); }
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				for (uint32_t j{ 0U }; j < Num_Movers; ++j) {
+					Step(frame[j]);
+					tree.MoveProxy(proxies[j], BoxOf(frame[j]), frame[j].Velocity);
+				}
+				uint32_t num_Pairs{ 0U };
+				tree.QueryPairs(
+					[&] (uint32_t proxyA_, uint32_t proxyB_) {
+						if (Lumina::AABBTree<2U>::Overlaps(BoxOf(frame[tree.UserData(proxyA_)]), BoxOf(frame[tree.UserData(proxyB_)]))) { ++num_Pairs; }
+					}
+				);
+				DoNotOptimize(num_Pairs);
+			}
+		});
+		// The update alone, where the fat boxes pay off: most frames move no proxy at all.
+		suite_.Add("Math/AABBTree/10k/MoveProxy", [movers] (uint64_t num_Iterations_) {
+			auto frame{ *movers };
+			Lumina::AABBTree<2U> tree{};
+			std::vector<uint32_t> proxies(frame.size());
+			for (uint32_t j{ 0U }; j < Num_Movers; ++j) { proxies[j] = tree.CreateProxy(BoxOf(frame[j]), j); }
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				uint32_t num_Reinserted{ 0U };
+				for (uint32_t j{ 0U }; j < Num_Movers; ++j) {
+					Step(frame[j]);
+					num_Reinserted += tree.MoveProxy(proxies[j], BoxOf(frame[j]), frame[j].Velocity) ? 1U : 0U;
+				}
+				DoNotOptimize(num_Reinserted);
+			}
+		});
+	}
+}
\ No newline at end of file
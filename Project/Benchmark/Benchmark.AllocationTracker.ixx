@@ -0,0 +1,161 @@
+export module Benchmark.AllocationTracker;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <memory>;
+import <new>;
+
+import <vector>;
+import <string>;
+
+import <thread>;
+
+import Benchmark.Harness;
+
+import Lumina.Utils.Debug.AllocationTracker;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::AllocationTracker {
+	namespace {
+		using Lumina::Utils::Debug::ALLOCATION_TAG;
+		using Tracker = Lumina::Utils::Debug::AllocationTracker;
+
+		struct alignas(64) CacheLine {
+			uint32_t Value;
+		};
+
+		constexpr uint32_t Num_Blocks{ 1000U };
+		constexpr uint32_t Num_Cycles{ 1U << 16U };
+
+		// Replaces a block of varying size per cycle, keeping the live set small.
+		void Churn(uint32_t num_Cycles_) {
+			std::unique_ptr<uint8_t[]> live[64]{};
+			for (uint32_t i{ 0U }; i < num_Cycles_; ++i) {
+				live[i & 63U] = std::make_unique<uint8_t[]>(16LLU + (i & 255U));
+				DoNotOptimize(live[i & 63U].get());
+			}
+		}
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		// The counters are global, so the checks look at the change over their own allocations only.
+		// Builds without LUMINA_TRACK_ALLOCATIONS have no tracker and run only the first.
+
+		suite_.Verify("Utils/AllocationTracker/OverAligned", [] () {
+			std::vector<std::unique_ptr<CacheLine>> lines{};
+			for (uint32_t i{ 0U }; i < 100U; ++i) { lines.emplace_back(std::make_unique<CacheLine>(i)); }
+			for (auto const& line : lines) {
+				if ((reinterpret_cast<uintptr_t>(line.get()) & 63LLU) != 0LLU) { return false; }
+			}
+			auto* const nothrow{ new (std::nothrow) CacheLine[3]{} };
+			bool const isAligned{ (reinterpret_cast<uintptr_t>(nothrow) & 63LLU) == 0LLU };
+			delete[] nothrow;
+			return isAligned;
+		});
+		if constexpr (Tracker::IsEnabled) {
+			suite_.Verify("Utils/AllocationTracker/CountsPerTag", [] () {
+				auto const before{ Tracker::Stats(ALLOCATION_TAG::GAME) };
+				std::vector<std::unique_ptr<uint64_t>> blocks{};
+				blocks.reserve(Num_Blocks);
+				{
+					Tracker::TagScope const tagScope{ ALLOCATION_TAG::GAME };
+					for (uint32_t i{ 0U }; i < Num_Blocks; ++i) { blocks.emplace_back(std::make_unique<uint64_t>(i)); }
+				}
+				auto const during{ Tracker::Stats(ALLOCATION_TAG::GAME) };
+				blocks.clear();
+				auto const after{ Tracker::Stats(ALLOCATION_TAG::GAME) };
+
+				return during.Num_Allocations - before.Num_Allocations == Num_Blocks &&
+					during.LiveBytes - before.LiveBytes == Num_Blocks * sizeof(uint64_t) &&
+					during.PeakBytes >= during.LiveBytes &&
+					after.Num_Deallocations - before.Num_Deallocations == Num_Blocks &&
+					after.LiveBytes == before.LiveBytes;
+			});
+			suite_.Verify("Utils/AllocationTracker/NestedScopes", [] () {
+				ALLOCATION_TAG const outer{ Tracker::CurrentTag() };
+				bool isNested{ true };
+				{
+					Tracker::TagScope const graphics{ ALLOCATION_TAG::GRAPHICS };
+					{
+						Tracker::TagScope const audio{ ALLOCATION_TAG::AUDIO };
+						isNested &= Tracker::CurrentTag() == ALLOCATION_TAG::AUDIO;
+					}
+					isNested &= Tracker::CurrentTag() == ALLOCATION_TAG::GRAPHICS;
+				}
+				return isNested && Tracker::CurrentTag() == outer;
+			});
+			// A block is accounted to the tag it was made under wherever, and on whichever thread, it is freed.
+			suite_.Verify("Utils/AllocationTracker/FreedUnderOwnTag", [] () {
+				auto const before{ Tracker::Stats(ALLOCATION_TAG::AUDIO) };
+				std::vector<std::unique_ptr<uint64_t>> blocks{};
+				blocks.reserve(Num_Blocks);
+				std::thread{
+					[&blocks] () {
+						Tracker::TagScope const tagScope{ ALLOCATION_TAG::AUDIO };
+						for (uint32_t i{ 0U }; i < Num_Blocks; ++i) { blocks.emplace_back(std::make_unique<uint64_t>(i)); }
+					}
+				}.join();
+				// This thread is untagged, or under whatever tag the harness set.
+				if (Tracker::CurrentTag() == ALLOCATION_TAG::AUDIO) { return false; }
+				blocks.clear();
+				auto const after{ Tracker::Stats(ALLOCATION_TAG::AUDIO) };
+
+				return after.Num_Allocations - before.Num_Allocations == Num_Blocks &&
+					after.Num_Deallocations - before.Num_Deallocations == Num_Blocks &&
+					after.LiveBytes == before.LiveBytes;
+			});
+			suite_.Verify("Utils/AllocationTracker/NoAllocationScope", [] () {
+				std::vector<uint32_t> values{};
+				values.reserve(Num_Blocks);
+				uint64_t num_Clean{ 0LLU };
+				{
+					Tracker::NoAllocationScope const scope{};
+					for (uint32_t i{ 0U }; i < Num_Blocks; ++i) { values.emplace_back(i); }
+					num_Clean = scope.Num_Allocations();
+				}
+				// Only counting, so the growth does not assert.
+				Tracker::NoAllocationScope const scope{ false };
+				for (uint32_t i{ 0U }; i < Num_Blocks; ++i) { values.emplace_back(i); }
+				return num_Clean == 0LLU && scope.Num_Allocations() > 0LLU;
+			});
+			suite_.Verify("Utils/AllocationTracker/Report", [] () {
+				{
+					Tracker::TagScope const tagScope{ ALLOCATION_TAG::DEBUG };
+					DoNotOptimize(std::make_unique<uint64_t>(0LLU).get());
+				}
+				std::string const report{ Tracker::Report() };
+				return report.find("Debug") != std::string::npos && report.find("Total") != std::string::npos;
+			});
+		}
+
+		//----	------	------	------	------	----//
+		//	Overhead							//
+		//----	------	------	------	------	----//
+
+		// Against a build of this suite without LUMINA_TRACK_ALLOCATIONS these show what the hooks cost per new and delete.
+		suite_.Add("Utils/AllocationTracker/Churn/Untagged", [] (uint64_t num_Iterations_) {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) { Churn(Num_Cycles); }
+		});
+		suite_.Add("Utils/AllocationTracker/Churn/TagScope", [] (uint64_t num_Iterations_) {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				Tracker::TagScope const tagScope{ ALLOCATION_TAG::GAME };
+				Churn(Num_Cycles);
+			}
+		});
+		suite_.Add("Utils/AllocationTracker/Churn/Threads", [] (uint64_t num_Iterations_) {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				std::vector<std::jthread> threads{};
+				for (uint32_t t{ 0U }; t < 4U; ++t) {
+					threads.emplace_back([] () { Churn(Num_Cycles / 4U); });
+				}
+			}
+		});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+export module Benchmark.CellularAutomaton;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <random>;
+import <memory>;
+
+import <vector>;
+import <utility>;
+
+import <string>;
+import <format>;
+
+import Benchmark.Harness;
+
+import Lumina.Math.CellularAutomaton;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::CellularAutomaton {
+	namespace {
+		using Lumina::AutomatonRule;
+		using Lumina::INSTRUCTION_SET;
+
+		// One byte per cell, stepped one cell at a time: what the kernels must agree with.
+		struct NaiveGrid {
+			uint32_t Width;
+			uint32_t Height;
+			std::vector<uint8_t> Cells;
+			std::vector<uint8_t> Next;
+
+			void Step(AutomatonRule const& rule_) {
+				Next = Cells;
+				for (uint32_t y{ 1U }; y + 1U < Height; ++y) {
+					for (uint32_t x{ 1U }; x + 1U < Width; ++x) {
+						uint32_t num_Alive{ 0U };
+						for (uint32_t ny{ y - 1U }; ny <= y + 1U; ++ny) {
+							for (uint32_t nx{ x - 1U }; nx <= x + 1U; ++nx) { num_Alive += Cells[ny * Width + nx]; }
+						}
+						uint8_t const cell{ Cells[y * Width + x] };
+						num_Alive -= cell;
+						uint16_t const rule{ (cell != 0U) ? rule_.Survival : rule_.Birth };
+						Next[y * Width + x] = static_cast<uint8_t>((rule >> num_Alive) & 1U);
+					}
+				}
+				Cells.swap(Next);
+			}
+		};
+
+		NaiveGrid RandomGrid(uint32_t width_, uint32_t height_, uint32_t seed_, uint32_t percent_Alive_ = 45U) {
+			std::mt19937 rndGen{ seed_ };
+			NaiveGrid grid{ width_, height_, std::vector<uint8_t>(width_ * height_), {} };
+			for (auto& cell : grid.Cells) { cell = static_cast<uint8_t>(rndGen() % 100U < percent_Alive_); }
+			return grid;
+		}
+
+		void Load(Lumina::CellularAutomaton& automaton_, NaiveGrid const& grid_) {
+			automaton_.Resize(grid_.Width, grid_.Height);
+			for (uint32_t y{ 0U }; y < grid_.Height; ++y) {
+				for (uint32_t x{ 0U }; x < grid_.Width; ++x) { automaton_.Grid().Set(x, y, grid_.Cells[y * grid_.Width + x] != 0U); }
+			}
+		}
+
+		// Built on first use, so that a filtered run does not fill an 8192 x 8192 grid for nothing.
+		struct LazyGrids {
+			void Build() {
+				if (Naive) { return; }
+				Naive = std::make_unique<NaiveGrid>(RandomGrid(Width, Height, 0x4C554D49U));
+				Load(Automaton, *Naive);
+			}
+
+			uint32_t Width;
+			uint32_t Height;
+			std::unique_ptr<NaiveGrid> Naive{};
+			Lumina::CellularAutomaton Automaton{};
+		};
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		// Both kernels, against the naive step, generation after generation; padding past the width included,
+		// as the expected grid is built bit by bit and compared whole.
+		suite_.Verify("Math/CellularAutomaton/MatchesNaive", [] () {
+			std::mt19937 rndGen{ 42U };
+			std::vector<AutomatonRule> rules{
+				AutomatonRule::Caves(),
+				AutomatonRule::Caves(3U),
+				AutomatonRule{ .Birth{ 1U << 3U }, .Survival{ (1U << 2U) | (1U << 3U) } },
+				AutomatonRule{ .Birth{ 0x1FFU }, .Survival{ 0x1FFU } },
+			};
+			for (uint32_t i{ 0U }; i < 8U; ++i) {
+				rules.emplace_back(static_cast<uint16_t>(rndGen() & 0x1FFU), static_cast<uint16_t>(rndGen() & 0x1FFU));
+			}
+
+			constexpr std::pair<uint32_t, uint32_t> Sizes[]{ { 128U, 64U }, { 67U, 5U }, { 300U, 200U }, { 3U, 3U }, { 1U, 1U }, { 257U, 2U } };
+			for (auto const& [width, height] : Sizes) {
+				for (auto const& rule : rules) {
+					for (INSTRUCTION_SET const instructionSet : { INSTRUCTION_SET::SCALAR, INSTRUCTION_SET::AVX2 }) {
+						NaiveGrid naive{ RandomGrid(width, height, width * 31U + height) };
+						Lumina::CellularAutomaton automaton{};
+						Load(automaton, naive);
+
+						for (uint32_t step{ 0U }; step < 5U; ++step) {
+							naive.Step(rule);
+							automaton.Step(rule, 1U, instructionSet);
+
+							Lumina::BitGrid expected{ width, height };
+							for (uint32_t y{ 0U }; y < height; ++y) {
+								for (uint32_t x{ 0U }; x < width; ++x) { expected.Set(x, y, naive.Cells[y * width + x] != 0U); }
+							}
+							if (!(automaton.Grid() == expected)) { return false; }
+						}
+					}
+				}
+			}
+			return true;
+		});
+		suite_.Verify("Math/CellularAutomaton/CaveRule", [] () {
+			AutomatonRule const rule{ AutomatonRule::Caves(4U) };
+			return rule.Birth == 0x1E0U && rule.Survival == 0x1F0U;
+		});
+
+		//----	------	------	------	------	----//
+		//	Steps								//
+		//----	------	------	------	------	----//
+
+		// What CellularAutomata::GenerateCaves did before: random single-cell updates, 30000 on a 128 x 64 map.
+		suite_.Add("Math/CellularAutomaton/128x64/RandomUpdates", [] (uint64_t num_Iterations_) {
+			NaiveGrid grid{ RandomGrid(128U, 64U, 7U) };
+			std::mt19937 rndGen{ 7U };
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				for (uint32_t j{ 0U }; j < 30000U; ++j) {
+					uint32_t const x{ 1U + static_cast<uint32_t>(rndGen()) % (grid.Width - 2U) };
+					uint32_t const y{ 1U + static_cast<uint32_t>(rndGen()) % (grid.Height - 2U) };
+					uint32_t num_Walls{ 0U };
+					for (uint32_t ny{ y - 1U }; ny <= y + 1U; ++ny) {
+						for (uint32_t nx{ x - 1U }; nx <= x + 1U; ++nx) { num_Walls += grid.Cells[ny * grid.Width + nx]; }
+					}
+					num_Walls -= grid.Cells[y * grid.Width + x];
+					if (num_Walls > 4U) { grid.Cells[y * grid.Width + x] = 1U; }
+					else if (num_Walls < 4U) { grid.Cells[y * grid.Width + x] = 0U; }
+				}
+				DoNotOptimize(grid.Cells[grid.Width + 1U]);
+			}
+		});
+
+		constexpr std::pair<uint32_t, uint32_t> Sizes[]{ { 128U, 64U }, { 1024U, 1024U }, { 4096U, 4096U }, { 8192U, 8192U } };
+		for (auto const& [width, height] : Sizes) {
+			auto const grids{ std::make_shared<LazyGrids>(width, height) };
+			// Throughput counts cells, each standing for one byte of the map.
+			uint64_t const num_Cells{ static_cast<uint64_t>(width) * height };
+			AutomatonRule const rule{ AutomatonRule::Caves() };
+
+			suite_.Add(std::format("Math/CellularAutomaton/{}x{}/Naive", width, height), [grids, rule] (uint64_t num_Iterations_) {
+				grids->Build();
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					grids->Naive->Step(rule);
+					DoNotOptimize(grids->Naive->Cells[grids->Width + 1U]);
+				}
+			}, num_Cells);
+			for (INSTRUCTION_SET const instructionSet : { INSTRUCTION_SET::SCALAR, INSTRUCTION_SET::AVX2 }) {
+				suite_.Add(
+					std::format("Math/CellularAutomaton/{}x{}/{}", width, height, (instructionSet == INSTRUCTION_SET::AVX2) ? "AVX2" : "Scalar"),
+					[grids, rule, instructionSet] (uint64_t num_Iterations_) {
+						grids->Build();
+						for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+							grids->Automaton.Step(rule, 1U, instructionSet);
+							DoNotOptimize(grids->Automaton.Grid().Row(1U)[0]);
+						}
+					},
+					num_Cells
+				);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,244 @@
+export module Benchmark.ChunkedWorld;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <chrono>;
+import <thread>;
+import <memory>;
+
+import <vector>;
+import <array>;
+import <algorithm>;
+
+import <string>;
+import <format>;
+
+import Benchmark.Harness;
+
+import Lumina.Math.Numerics;
+import Lumina.Math.ConnectedComponents;
+
+import Game.ChunkedWorld;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::ChunkedWorld {
+	namespace {
+		using Game::ChunkedWorld;
+		using Game::WorldGenParams;
+		using Game::ChunkStreamingParams;
+
+		constexpr WorldGenParams GenParams{ .Seed{ 7LLU } };
+		// As Scene_InGame streams.
+		constexpr ChunkStreamingParams StreamingParams{ .Num_Chunks{ 64U }, .Radius_Stream{ 2U }, .Num_Workers{ 2U } };
+
+		ChunkedWorld::Chunk Generate(Lumina::Int2 const& chunk_) {
+			ChunkedWorld::Chunk chunk{};
+			ChunkedWorld::Scratch scratch{};
+			ChunkedWorld::Generate(
+				GenParams, { chunk_.x * ChunkedWorld::ChunkSize, chunk_.y * ChunkedWorld::ChunkSize },
+				ChunkedWorld::ChunkSize, ChunkedWorld::ChunkSize, chunk.data(), scratch
+			);
+			return chunk;
+		}
+
+		// Every resident chunk as generated on its own.
+		bool MatchesGenerated(ChunkedWorld const& world_) {
+			uint32_t num_Resident{ 0U };
+			for (uint32_t idx_Chunk{ 0U }; idx_Chunk < world_.GetStreamingParams().Num_Chunks; ++idx_Chunk) {
+				Lumina::Int2 const coord{ world_.ChunkCoord(idx_Chunk) };
+				if (world_.FindChunk(coord) != idx_Chunk) { continue; }
+				if (world_.GetChunk(idx_Chunk) != Generate(coord)) { return false; }
+				++num_Resident;
+			}
+			return num_Resident == world_.Num_Resident();
+		}
+
+		// Three legs of 128 chunks around a triangle across the origin, the last diagonal, at a tile a frame:
+		// eight times the player's pace.
+		struct Walk {
+			static constexpr int32_t Length_Leg{ 4096 };
+			static constexpr Lumina::Int2 Start{ -Length_Leg / 2, -Length_Leg / 2 };
+			static constexpr Lumina::Int2 Steps[3]{ { 1, 0 }, { 0, 1 }, { -1, -1 } };
+			static constexpr uint32_t Num_Frames{ static_cast<uint32_t>(Length_Leg) * 3U };
+
+			static Lumina::Int2 At(uint32_t frame_) noexcept {
+				Lumina::Int2 tile{ Start };
+				for (auto const& step : Steps) {
+					int32_t const num{ std::min(static_cast<int32_t>(frame_), Length_Leg) };
+					tile.x += step.x * num;
+					tile.y += step.y * num;
+					frame_ -= static_cast<uint32_t>(num);
+				}
+				return tile;
+			}
+		};
+
+		// What the scene reads around the player in a frame: the tiles it may step into and those its bullets may hit.
+		// Returns whether every one of them was resident.
+		bool Collide(ChunkedWorld const& world_, Lumina::Int2 const& tile_) {
+			bool isResident{ true };
+			int solid{ 0 };
+			for (int32_t dy{ -8 }; dy <= 8; ++dy) {
+				for (int32_t dx{ -8 }; dx <= 8; ++dx) {
+					int const* const tile{ world_.Find({ tile_.x + dx, tile_.y + dy }) };
+					isResident = isResident && (tile != nullptr);
+					solid += (tile != nullptr) ? *tile : 0;
+				}
+			}
+			DoNotOptimize(solid);
+			return isResident;
+		}
+
+		// Built, and walked to its start, on first use, so that a filtered run starts no workers for nothing.
+		struct LazyWalk {
+			ChunkedWorld& Get() {
+				if (!World) {
+					World = std::make_unique<ChunkedWorld>(GenParams, StreamingParams);
+					World->Prefetch(Walk::Start, 1U);
+				}
+				return *World;
+			}
+
+			std::unique_ptr<ChunkedWorld> World{};
+			uint32_t Frame{ 0U };
+		};
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		// Chunk by chunk, a region across the origin comes out as when generated at once.
+		suite_.Verify("Game/ChunkedWorld/Seamless", [] () {
+			constexpr int32_t Width{ 5 * ChunkedWorld::ChunkSize };
+			constexpr int32_t Height{ 3 * ChunkedWorld::ChunkSize };
+			constexpr Lumina::Int2 Origin{ -2 * ChunkedWorld::ChunkSize, -ChunkedWorld::ChunkSize };
+			std::vector<int> region(static_cast<size_t>(Width) * Height);
+			ChunkedWorld::Scratch scratch{};
+			ChunkedWorld::Generate(GenParams, Origin, Width, Height, region.data(), scratch);
+
+			uint32_t num_Kinds{ 0U };
+			for (int32_t y_Chunk{ 0 }; y_Chunk < Height / ChunkedWorld::ChunkSize; ++y_Chunk) {
+				for (int32_t x_Chunk{ 0 }; x_Chunk < Width / ChunkedWorld::ChunkSize; ++x_Chunk) {
+					ChunkedWorld::Chunk const chunk{ Generate({ Origin.x / ChunkedWorld::ChunkSize + x_Chunk, Origin.y / ChunkedWorld::ChunkSize + y_Chunk }) };
+					for (int32_t y{ 0 }; y < ChunkedWorld::ChunkSize; ++y) {
+						for (int32_t x{ 0 }; x < ChunkedWorld::ChunkSize; ++x) {
+							int const expected{ region[static_cast<size_t>(y_Chunk * ChunkedWorld::ChunkSize + y) * Width + static_cast<size_t>(x_Chunk * ChunkedWorld::ChunkSize + x)] };
+							if (chunk[static_cast<size_t>(y * ChunkedWorld::ChunkSize + x)] != expected) { return false; }
+							num_Kinds |= 1U << static_cast<uint32_t>(expected);
+						}
+					}
+				}
+			}
+			// Floor, rock and surface all occur.
+			return num_Kinds == 0b111U;
+		});
+		// No floor region inside a generated one is smaller than a cave; those cut by its edge may be, as they go on past it.
+		suite_.Verify("Game/ChunkedWorld/NoSpecks", [] () {
+			constexpr uint32_t Side{ 8U * ChunkedWorld::ChunkSize };
+			std::vector<int> region(static_cast<size_t>(Side) * Side);
+			ChunkedWorld::Scratch scratch{};
+			ChunkedWorld::Generate(GenParams, { -static_cast<int32_t>(Side) / 2, -static_cast<int32_t>(Side) / 2 }, Side, Side, region.data(), scratch);
+
+			Lumina::ConnectedComponents components{};
+			components.Label(Side, Side, [&region] (uint32_t x_, uint32_t y_) { return region[static_cast<size_t>(y_) * Side + x_] == 0; });
+			uint32_t num_Caves{ 0U };
+			for (auto const& component : components.Components()) {
+				bool const isCut{ component.Min.x == 0 || component.Min.y == 0 || component.Max.x + 1 == static_cast<int32_t>(Side) || component.Max.y + 1 == static_cast<int32_t>(Side) };
+				if (!isCut && component.Area < GenParams.MinSize_Cave) { return false; }
+				num_Caves += isCut ? 0U : 1U;
+			}
+			return num_Caves > 0U;
+		});
+		// Streamed chunks are the ones generated on their own, also when they come back after eviction;
+		// the seed changes the world.
+		suite_.Verify("Game/ChunkedWorld/Streamed", [] () {
+			ChunkedWorld world{ GenParams, StreamingParams };
+			world.Prefetch({ 0, 0 }, StreamingParams.Radius_Stream);
+			if (world.Num_Resident() != 25U || !MatchesGenerated(world)) { return false; }
+
+			for (int32_t x{ 0 }; x <= 16 * ChunkedWorld::ChunkSize; x += ChunkedWorld::ChunkSize) { world.Prefetch({ x, 0 }, 2U); }
+			if (world.FindChunk({ 0, 0 }) != ChunkedWorld::InvalidChunk || world.GetStatistics().Num_Evicted == 0LLU) { return false; }
+			world.Prefetch({ 0, 0 }, StreamingParams.Radius_Stream);
+			if (!MatchesGenerated(world)) { return false; }
+
+			ChunkedWorld other{ { .Seed{ GenParams.Seed + 1LLU } }, StreamingParams };
+			other.Prefetch({ 0, 0 }, 0U);
+			return other.GetChunk(other.FindChunk({ 0, 0 })) != world.GetChunk(world.FindChunk({ 0, 0 }));
+		});
+		// Across the whole walk, the tiles around the player are always resident, the chunks held never pass the budget,
+		// nothing is allocated, and no frame waits for generation.
+		suite_.Verify("Game/ChunkedWorld/Walk", [] () {
+			ChunkedWorld world{ GenParams, StreamingParams };
+			world.Prefetch(Walk::Start, 1U);
+			size_t const memoryUsage{ world.MemoryUsage() };
+
+			std::vector<double> frameTimes{};
+			frameTimes.reserve(Walk::Num_Frames);
+			uint32_t num_Misses{ 0U };
+			for (uint32_t frame{ 0U }; frame < Walk::Num_Frames; ++frame) {
+				auto const begin{ std::chrono::steady_clock::now() };
+				Lumina::Int2 const tile{ Walk::At(frame) };
+				world.Update(tile);
+				num_Misses += Collide(world, tile) ? 0U : 1U;
+				frameTimes.emplace_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count());
+
+				if (world.Num_Resident() + world.Num_Pending() > StreamingParams.Num_Chunks) { return false; }
+				// The rest of the frame, in which the workers get the cores.
+				std::this_thread::yield();
+			}
+
+			auto const& statistics{ world.GetStatistics() };
+			Statistics const stats{ Summarize(frameTimes) };
+			return
+				num_Misses == 0U && world.MemoryUsage() == memoryUsage &&
+				// Every chunk the walk passes within two of; the corners of the diagonal leg pass within two of more.
+				statistics.Num_Generated >= 5LLU * 4096LLU * 3LLU / ChunkedWorld::ChunkSize &&
+				statistics.Num_Evicted + StreamingParams.Num_Chunks >= statistics.Num_Generated &&
+				// Well within a 60 Hz frame even at the slowest, and a small part of one almost always.
+				stats.P99 < 1.0 && stats.Max < 16.0;
+		});
+
+		//----	------	------	------	------	----//
+		//	World								//
+		//----	------	------	------	------	----//
+
+		suite_.Add("Game/ChunkedWorld/Generate", [] (uint64_t num_Iterations_) {
+			ChunkedWorld::Chunk chunk{};
+			ChunkedWorld::Scratch scratch{};
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				int32_t const x{ static_cast<int32_t>(i & 0xFFFLLU) * ChunkedWorld::ChunkSize };
+				ChunkedWorld::Generate(GenParams, { x, 0 }, ChunkedWorld::ChunkSize, ChunkedWorld::ChunkSize, chunk.data(), scratch);
+				DoNotOptimize(chunk[0]);
+			}
+		}, sizeof(ChunkedWorld::Chunk));
+
+		// One frame of the walk, carried on from where the last sample stopped.
+		auto const walk{ std::make_shared<LazyWalk>() };
+		suite_.Add("Game/ChunkedWorld/Walk/Frame", [walk] (uint64_t num_Iterations_) {
+			ChunkedWorld& world{ walk->Get() };
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				Lumina::Int2 const tile{ Walk::At(walk->Frame) };
+				world.Update(tile);
+				DoNotOptimize(Collide(world, tile));
+				walk->Frame = (walk->Frame + 1U) % Walk::Num_Frames;
+			}
+		});
+		suite_.Add("Game/ChunkedWorld/Lookup", [walk] (uint64_t num_Iterations_) {
+			ChunkedWorld& world{ walk->Get() };
+			Lumina::Int2 const center{ Walk::At(walk->Frame) };
+			world.Prefetch(center, 1U);
+			int solid{ 0 };
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				int32_t const dx{ static_cast<int32_t>(i & 63LLU) - 32 };
+				int32_t const dy{ static_cast<int32_t>((i >> 6U) & 63LLU) - 32 };
+				solid += world({ center.x + dx, center.y + dy });
+			}
+			DoNotOptimize(solid);
+		});
+	}
+}
\ No newline at end of file
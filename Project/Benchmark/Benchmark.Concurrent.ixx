@@ -0,0 +1,357 @@
+export module Benchmark.Concurrent;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <memory>;
+import <string>;
+
+import <mutex>;
+import <thread>;
+import <atomic>;
+
+import <deque>;
+import <vector>;
+import <algorithm>;
+import <numeric>;
+
+import Benchmark.Harness;
+
+import Lumina.Container.SPSCQueue;
+import Lumina.Container.MPMCQueue;
+import Lumina.Container.List;
+import Lumina.Container.ConcurrentList;
+
+//////	//////	//////	//////	//////	//////
+
+// The threaded cases start their own producer and consumer threads, which are not pinned like the main thread;
+// thread start-up is part of every sample, and the minimum sample duration keeps it small against the transfer.
+
+namespace Benchmark::Concurrent {
+	namespace {
+		constexpr uint32_t Capacity{ 1024U };
+		constexpr uint32_t BatchSize{ 64U };
+
+		// Bounded like the lock-free queues, so that a fast producer cannot run ahead without limit.
+		template<typename T>
+		class LockedDeque {
+		public:
+			explicit LockedDeque(uint32_t capacity_) : Capacity_{ capacity_ } {}
+
+			bool TryPush(T const& val_) {
+				std::lock_guard<std::mutex> lock{ Mutex_ };
+				if (Deque_.size() >= Capacity_) { return false; }
+				Deque_.emplace_back(val_);
+				return true;
+			}
+
+			bool TryPop(T& dst_) {
+				std::lock_guard<std::mutex> lock{ Mutex_ };
+				if (Deque_.empty()) { return false; }
+				dst_ = Deque_.front();
+				Deque_.pop_front();
+				return true;
+			}
+
+			uint32_t TryPushBatch(T const* src_, uint32_t num_) {
+				std::lock_guard<std::mutex> lock{ Mutex_ };
+				uint32_t const num{ std::min(num_, Capacity_ - static_cast<uint32_t>(Deque_.size())) };
+				Deque_.insert(Deque_.end(), src_, src_ + num);
+				return num;
+			}
+
+			uint32_t TryPopBatch(T* dst_, uint32_t num_) {
+				std::lock_guard<std::mutex> lock{ Mutex_ };
+				uint32_t const num{ std::min(num_, static_cast<uint32_t>(Deque_.size())) };
+				std::copy_n(Deque_.begin(), num, dst_);
+				Deque_.erase(Deque_.begin(), Deque_.begin() + num);
+				return num;
+			}
+
+		private:
+			std::mutex Mutex_{};
+			std::deque<T> Deque_{};
+			uint32_t Capacity_{ 0U };
+		};
+
+		// Values are (producer << 32) | sequence; every consumer must see each producer's sequence rising,
+		// and together the consumers must see every value exactly once.
+		template<typename T_Queue>
+		bool Stress(T_Queue& queue_, uint32_t num_Producers_, uint32_t num_Consumers_, uint32_t num_PerProducer_) {
+			uint64_t const num_Total{ static_cast<uint64_t>(num_Producers_) * num_PerProducer_ };
+			std::atomic<uint64_t> num_Popped{ 0LLU };
+			std::vector<std::vector<uint64_t>> popped(num_Consumers_);
+			std::vector<uint8_t> isOrdered(num_Consumers_, 1U);
+
+			std::vector<std::thread> threads{};
+			for (uint32_t idx_Producer{ 0U }; idx_Producer < num_Producers_; ++idx_Producer) {
+				threads.emplace_back([&queue_, idx_Producer, num_PerProducer_] () {
+					uint64_t batch[BatchSize]{};
+					uint32_t seq{ 0U };
+					while (seq < num_PerProducer_) {
+						// Alternates single pushes with batches of varying length.
+						uint32_t const num{ std::min((seq & 1U) ? (seq % BatchSize) + 1U : 1U, num_PerProducer_ - seq) };
+						for (uint32_t i{ 0U }; i < num; ++i) {
+							batch[i] = (static_cast<uint64_t>(idx_Producer) << 32U) | (seq + i);
+						}
+						uint32_t const num_Pushed{ (num == 1U) ? static_cast<uint32_t>(queue_.TryPush(batch[0])) : queue_.TryPushBatch(batch, num) };
+						if (num_Pushed == 0U) { std::this_thread::yield(); }
+						seq += num_Pushed;
+					}
+				});
+			}
+			for (uint32_t idx_Consumer{ 0U }; idx_Consumer < num_Consumers_; ++idx_Consumer) {
+				threads.emplace_back([&, idx_Consumer] () {
+					std::vector<int64_t> seq_Last(num_Producers_, -1);
+					uint64_t batch[BatchSize]{};
+					for (uint32_t i{ 0U }; num_Popped.load(std::memory_order_relaxed) < num_Total; ++i) {
+						uint32_t const num{ (i & 1U) ? queue_.TryPopBatch(batch, (i % BatchSize) + 1U) : static_cast<uint32_t>(queue_.TryPop(batch[0])) };
+						if (num == 0U) {
+							std::this_thread::yield();
+							continue;
+						}
+						for (uint32_t j{ 0U }; j < num; ++j) {
+							uint32_t const idx_Producer{ static_cast<uint32_t>(batch[j] >> 32U) };
+							int64_t const seq{ static_cast<int64_t>(batch[j] & 0xFFFFFFFFLLU) };
+							if (idx_Producer >= num_Producers_ || seq <= seq_Last[idx_Producer]) { isOrdered[idx_Consumer] = 0U; }
+							else { seq_Last[idx_Producer] = seq; }
+							popped[idx_Consumer].emplace_back(batch[j]);
+						}
+						num_Popped.fetch_add(num, std::memory_order_relaxed);
+					}
+				});
+			}
+			for (auto& thread : threads) { thread.join(); }
+
+			std::vector<uint64_t> all{};
+			for (auto const& values : popped) { all.insert(all.end(), values.cbegin(), values.cend()); }
+			std::sort(all.begin(), all.end());
+			if (all.size() != num_Total) { return false; }
+			for (uint64_t i{ 0LLU }; i < num_Total; ++i) {
+				if (all[i] != (((i / num_PerProducer_) << 32U) | (i % num_PerProducer_))) { return false; }
+			}
+			return std::all_of(isOrdered.cbegin(), isOrdered.cend(), [] (uint8_t val_) { return val_ != 0U; });
+		}
+
+		// Elements left in the queue are destroyed with it, and moved-out ones are not leaked.
+		template<template<typename> typename T_Queue>
+		bool ReleasesElements() {
+			auto const shared{ std::make_shared<int>(0) };
+			{
+				T_Queue<std::shared_ptr<int>> queue{ 8U };
+				for (uint32_t i{ 0U }; i < 6U; ++i) { queue.TryPush(shared); }
+				std::shared_ptr<int> popped{};
+				queue.TryPop(popped);
+				std::shared_ptr<int> batch[2]{};
+				queue.TryPopBatch(batch, 2U);
+				if (shared.use_count() != 7LL) { return false; }
+			}
+			return (shared.use_count() == 1LL);
+		}
+
+		// Moves num_Iterations_ values from the producers to the consumers, BatchSize at a time if batched_.
+		template<typename T_Queue>
+		void Transfer(T_Queue& queue_, uint32_t num_Producers_, uint32_t num_Consumers_, uint64_t num_Iterations_, bool batched_) {
+			uint64_t const num_PerProducer{ (num_Iterations_ + num_Producers_ - 1LLU) / num_Producers_ };
+			uint64_t const num_Total{ num_PerProducer * num_Producers_ };
+			std::atomic<uint64_t> num_Popped{ 0LLU };
+
+			std::vector<std::thread> threads{};
+			for (uint32_t i{ 0U }; i < num_Producers_; ++i) {
+				threads.emplace_back([&queue_, num_PerProducer, batched_] () {
+					uint64_t batch[BatchSize]{};
+					std::iota(batch, batch + BatchSize, 0LLU);
+					for (uint64_t num_Pushed{ 0LLU }; num_Pushed < num_PerProducer;) {
+						uint32_t const num{
+							batched_ ?
+							queue_.TryPushBatch(batch, static_cast<uint32_t>(std::min<uint64_t>(BatchSize, num_PerProducer - num_Pushed))) :
+							static_cast<uint32_t>(queue_.TryPush(num_Pushed))
+						};
+						if (num == 0U) { std::this_thread::yield(); }
+						num_Pushed += num;
+					}
+				});
+			}
+			for (uint32_t i{ 0U }; i < num_Consumers_; ++i) {
+				threads.emplace_back([&queue_, &num_Popped, num_Total, batched_] () {
+					uint64_t batch[BatchSize]{};
+					while (num_Popped.load(std::memory_order_relaxed) < num_Total) {
+						uint32_t const num{ batched_ ? queue_.TryPopBatch(batch, BatchSize) : static_cast<uint32_t>(queue_.TryPop(batch[0])) };
+						if (num == 0U) {
+							std::this_thread::yield();
+							continue;
+						}
+						DoNotOptimize(batch[0]);
+						num_Popped.fetch_add(num, std::memory_order_relaxed);
+					}
+				});
+			}
+			for (auto& thread : threads) { thread.join(); }
+		}
+
+		template<typename T_Queue>
+		void RegisterTransfer(Suite& suite_, std::string const& name_, uint32_t num_Producers_, uint32_t num_Consumers_) {
+			std::string const prefix{ name_ + "/" + std::to_string(num_Producers_) + "P" + std::to_string(num_Consumers_) + "C" };
+			for (bool const batched : { false, true }) {
+				suite_.Add(prefix + (batched ? "/Batch64" : "/Single"), [num_Producers_, num_Consumers_, batched] (uint64_t num_Iterations_) {
+					T_Queue queue{ Capacity };
+					Transfer(queue, num_Producers_, num_Consumers_, num_Iterations_, batched);
+				}, sizeof(uint64_t));
+			}
+		}
+
+		//----	------	------	------	------	----//
+
+		struct Spawned {
+			uint32_t Owner;
+			uint32_t Seq;
+		};
+
+		// Rounds of num_Threads_ threads spawning through their own Spawner and deleting every other element (twice),
+		// each followed by the checks and a Tick() on the main thread. At the end everything is deleted and the pool must refill.
+		bool StressList(uint32_t capacity_, uint32_t num_Threads_, uint32_t num_Rounds_) {
+			Lumina::ConcurrentList<Spawned> list{ capacity_ };
+			uint32_t num_Live{ 0U };
+			for (uint32_t idx_Round{ 0U }; idx_Round < num_Rounds_; ++idx_Round) {
+				std::vector<std::vector<uint32_t>> spawned(num_Threads_);
+				std::vector<uint32_t> num_Deleted(num_Threads_, 0U);
+				std::vector<std::thread> threads{};
+				for (uint32_t idx_Thread{ 0U }; idx_Thread < num_Threads_; ++idx_Thread) {
+					threads.emplace_back([&, idx_Thread] () {
+						Lumina::ConcurrentList<Spawned>::Spawner spawner{ list };
+						// Spawns until the pool runs dry, so that every thread also takes the refill and empty paths.
+						for (uint32_t seq{ 0U };; ++seq) {
+							Spawned* const element{ spawner.NewElement() };
+							if (element == nullptr) { break; }
+							*element = Spawned{ idx_Thread, seq };
+							spawned[idx_Thread].emplace_back(list.IndexOf(*element));
+							if (seq & 1U) {
+								list.Delete(*element);
+								list.Delete(*element);
+								++num_Deleted[idx_Thread];
+							}
+						}
+					});
+				}
+				for (auto& thread : threads) { thread.join(); }
+
+				// No slot may have gone to two spawns, and every slot must still hold what its spawner wrote.
+				std::vector<uint32_t> indices{};
+				uint32_t num_Spawned{ 0U };
+				uint32_t num_DeletedTotal{ 0U };
+				for (uint32_t idx_Thread{ 0U }; idx_Thread < num_Threads_; ++idx_Thread) {
+					for (uint32_t seq{ 0U }; seq < static_cast<uint32_t>(spawned[idx_Thread].size()); ++seq) {
+						Spawned const& element{ list[spawned[idx_Thread][seq]] };
+						if (element.Owner != idx_Thread || element.Seq != seq) { return false; }
+					}
+					indices.insert(indices.end(), spawned[idx_Thread].cbegin(), spawned[idx_Thread].cend());
+					num_Spawned += static_cast<uint32_t>(spawned[idx_Thread].size());
+					num_DeletedTotal += num_Deleted[idx_Thread];
+				}
+				std::sort(indices.begin(), indices.end());
+				if (std::adjacent_find(indices.cbegin(), indices.cend()) != indices.cend()) { return false; }
+				// Every slot that was free at the start of the round was handed out, since each spawner ran dry with an empty cache.
+				if (num_Live + num_Spawned != capacity_ || list.Size() != capacity_) { return false; }
+
+				uint32_t num_Visited{ 0U };
+				list.ForEach([&num_Visited] (Spawned&, uint32_t) { ++num_Visited; });
+				if (num_Visited != capacity_) { return false; }
+
+				if (list.Tick() != num_DeletedTotal) { return false; }
+				num_Live = capacity_ - num_DeletedTotal;
+				if (list.Size() != num_Live) { return false; }
+			}
+
+			list.ForEach([&list] (Spawned&, uint32_t idx_) { list.Delete(idx_); });
+			if (list.Tick() != num_Live || list.Size() != 0U) { return false; }
+
+			Lumina::ConcurrentList<Spawned>::Spawner spawner{ list };
+			for (uint32_t i{ 0U }; i < capacity_; ++i) {
+				if (spawner.NewElement() == nullptr) { return false; }
+			}
+			return (spawner.NewElement() == nullptr);
+		}
+
+		// Each sample spawns num_Iterations_ elements over num_Threads_ threads, in rounds of one pool's worth;
+		// the threads delete their own elements and the round ends with a Tick().
+		void SpawnConcurrent(uint32_t num_Threads_, uint64_t num_Iterations_) {
+			constexpr uint32_t capacity{ 1U << 16U };
+			Lumina::ConcurrentList<Spawned> list{ capacity };
+			for (uint64_t num_Done{ 0LLU }; num_Done < num_Iterations_; num_Done += capacity) {
+				uint32_t const num_PerThread{ static_cast<uint32_t>(std::min<uint64_t>(capacity, num_Iterations_ - num_Done)) / num_Threads_ };
+				std::vector<std::thread> threads{};
+				for (uint32_t idx_Thread{ 0U }; idx_Thread < num_Threads_; ++idx_Thread) {
+					threads.emplace_back([&list, idx_Thread, num_PerThread] () {
+						Lumina::ConcurrentList<Spawned>::Spawner spawner{ list };
+						for (uint32_t seq{ 0U }; seq < num_PerThread; ++seq) {
+							Spawned* const element{ spawner.NewElement() };
+							*element = Spawned{ idx_Thread, seq };
+							list.Delete(*element);
+						}
+					});
+				}
+				for (auto& thread : threads) { thread.join(); }
+				list.Tick();
+			}
+		}
+
+		// The same with List behind a mutex; Clear() stands in for the deletes, which List can only do through an iterator.
+		void SpawnLocked(uint32_t num_Threads_, uint64_t num_Iterations_) {
+			constexpr uint32_t capacity{ 1U << 16U };
+			Lumina::List<Spawned> list{ capacity };
+			std::mutex mutex{};
+			for (uint64_t num_Done{ 0LLU }; num_Done < num_Iterations_; num_Done += capacity) {
+				uint32_t const num_PerThread{ static_cast<uint32_t>(std::min<uint64_t>(capacity, num_Iterations_ - num_Done)) / num_Threads_ };
+				std::vector<std::thread> threads{};
+				for (uint32_t idx_Thread{ 0U }; idx_Thread < num_Threads_; ++idx_Thread) {
+					threads.emplace_back([&list, &mutex, idx_Thread, num_PerThread] () {
+						for (uint32_t seq{ 0U }; seq < num_PerThread; ++seq) {
+							std::lock_guard<std::mutex> lock{ mutex };
+							list.NewElement() = Spawned{ idx_Thread, seq };
+						}
+					});
+				}
+				for (auto& thread : threads) { thread.join(); }
+				list.Clear();
+			}
+		}
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		// A small capacity makes the indices wrap and the full/empty paths run often.
+		suite_.Verify("Container/SPSCQueue/Stress", [] () {
+			Lumina::SPSCQueue<uint64_t> queue{ 64U };
+			return Stress(queue, 1U, 1U, 1U << 20U);
+		});
+		suite_.Verify("Container/SPSCQueue/ReleasesElements", ReleasesElements<Lumina::SPSCQueue>);
+		suite_.Verify("Container/MPMCQueue/Stress", [] () {
+			Lumina::MPMCQueue<uint64_t> queue{ 64U };
+			return Stress(queue, 4U, 4U, 1U << 18U);
+		});
+		suite_.Verify("Container/MPMCQueue/ReleasesElements", ReleasesElements<Lumina::MPMCQueue>);
+		suite_.Verify("Container/ConcurrentList/Stress", [] () {
+			return StressList(4096U, 4U, 64U) && StressList(100U, 8U, 16U);
+		});
+
+		//----	------	------	------	------	----//
+		//	Throughput							//
+		//----	------	------	------	------	----//
+
+		RegisterTransfer<Lumina::SPSCQueue<uint64_t>>(suite_, "Container/SPSCQueue", 1U, 1U);
+		RegisterTransfer<Lumina::MPMCQueue<uint64_t>>(suite_, "Container/MPMCQueue", 1U, 1U);
+		RegisterTransfer<Lumina::MPMCQueue<uint64_t>>(suite_, "Container/MPMCQueue", 4U, 4U);
+		RegisterTransfer<LockedDeque<uint64_t>>(suite_, "Container/LockedDeque", 1U, 1U);
+		RegisterTransfer<LockedDeque<uint64_t>>(suite_, "Container/LockedDeque", 4U, 4U);
+
+		for (uint32_t const num_Threads : { 1U, 4U }) {
+			std::string const suffix{ "/" + std::to_string(num_Threads) + "T/Spawn" };
+			suite_.Add("Container/ConcurrentList" + suffix, [num_Threads] (uint64_t num_Iterations_) { SpawnConcurrent(num_Threads, num_Iterations_); });
+			suite_.Add("Container/LockedList" + suffix, [num_Threads] (uint64_t num_Iterations_) { SpawnLocked(num_Threads, num_Iterations_); });
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,266 @@
+export module Benchmark.ConnectedComponents;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cmath>;
+
+import <random>;
+import <memory>;
+
+import <vector>;
+import <algorithm>;
+
+import <string>;
+import <format>;
+
+import Benchmark.Harness;
+
+import Lumina.Math.ConnectedComponents;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::ConnectedComponents {
+	namespace {
+		using Lumina::CONNECTIVITY;
+
+		// 1 marks a wall; floors are the foreground.
+		struct Map {
+			uint32_t Width;
+			uint32_t Height;
+			std::vector<uint8_t> Tiles;
+
+			bool IsFloor(uint32_t x_, uint32_t y_) const noexcept { return Tiles[y_ * Width + x_] == 0U; }
+		};
+
+		// Random walls smoothed by a few steps of the cave rule, as CellularAutomata makes them.
+		Map Caves(uint32_t width_, uint32_t height_, uint32_t seed_) {
+			std::mt19937 rndGen{ seed_ };
+			Map map{ width_, height_, std::vector<uint8_t>(width_ * height_, 1U) };
+			for (uint32_t y{ 1U }; y < height_ - 1U; ++y) {
+				for (uint32_t x{ 1U }; x < width_ - 1U; ++x) { map.Tiles[y * width_ + x] = static_cast<uint8_t>(rndGen() % 100U < 45U); }
+			}
+
+			std::vector<uint8_t> next{ map.Tiles };
+			for (uint32_t step{ 0U }; step < 4U; ++step) {
+				for (uint32_t y{ 1U }; y < height_ - 1U; ++y) {
+					for (uint32_t x{ 1U }; x < width_ - 1U; ++x) {
+						uint32_t num_Walls{ 0U };
+						for (int32_t dy{ -1 }; dy <= 1; ++dy) {
+							for (int32_t dx{ -1 }; dx <= 1; ++dx) { num_Walls += map.Tiles[(y + dy) * width_ + (x + dx)]; }
+						}
+						num_Walls -= map.Tiles[y * width_ + x];
+						next[y * width_ + x] = (num_Walls > 4U) ? 1U : ((num_Walls < 4U) ? 0U : map.Tiles[y * width_ + x]);
+					}
+				}
+				map.Tiles.swap(next);
+			}
+			return map;
+		}
+
+		// What CellularAutomata::IdentifyCaves did before: a recursive flood from every unvisited floor tile, in scan order.
+		struct RecursiveFlood {
+			void Flood(uint32_t x_, uint32_t y_) {
+				if (x_ >= Source.Width || y_ >= Source.Height) { return; }
+				if (!Source.IsFloor(x_, y_) || Labels[y_ * Source.Width + x_] != 0U) { return; }
+
+				Labels[y_ * Source.Width + x_] = static_cast<uint32_t>(Areas.size());
+				++Areas.back();
+
+				Flood(x_ - 1U, y_);
+				Flood(x_ + 1U, y_);
+				Flood(x_, y_ - 1U);
+				Flood(x_, y_ + 1U);
+			}
+
+			explicit RecursiveFlood(Map const& map_) : Source{ map_ }, Labels(map_.Tiles.size(), 0U) {
+				for (uint32_t y{ 0U }; y < map_.Height; ++y) {
+					for (uint32_t x{ 0U }; x < map_.Width; ++x) {
+						if (!map_.IsFloor(x, y) || Labels[y * map_.Width + x] != 0U) { continue; }
+						Areas.emplace_back(0U);
+						Flood(x, y);
+					}
+				}
+			}
+
+			Map const& Source;
+			std::vector<uint32_t> Labels;
+			std::vector<uint32_t> Areas{};
+		};
+
+		// The same with an explicit stack, for any connectivity and for maps the recursion would not survive.
+		struct StackFlood {
+			explicit StackFlood(Map const& map_, CONNECTIVITY connectivity_) : Labels(map_.Tiles.size(), 0U) {
+				int32_t const num_Neighbours{ (connectivity_ == CONNECTIVITY::FOUR) ? 4 : 8 };
+				constexpr int32_t Offsets[8][2]{ { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 }, { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 } };
+
+				std::vector<uint32_t> stack{};
+				for (uint32_t idx_Start{ 0U }; idx_Start < static_cast<uint32_t>(map_.Tiles.size()); ++idx_Start) {
+					if (map_.Tiles[idx_Start] != 0U || Labels[idx_Start] != 0U) { continue; }
+
+					uint32_t const label{ ++Num_Components };
+					Labels[idx_Start] = label;
+					stack.emplace_back(idx_Start);
+					while (!stack.empty()) {
+						uint32_t const idx{ stack.back() };
+						stack.pop_back();
+						int32_t const x{ static_cast<int32_t>(idx % map_.Width) };
+						int32_t const y{ static_cast<int32_t>(idx / map_.Width) };
+						for (int32_t i{ 0 }; i < num_Neighbours; ++i) {
+							int32_t const nx{ x + Offsets[i][0] };
+							int32_t const ny{ y + Offsets[i][1] };
+							if (nx < 0 || ny < 0 || nx >= static_cast<int32_t>(map_.Width) || ny >= static_cast<int32_t>(map_.Height)) { continue; }
+							uint32_t const idx_Neighbour{ static_cast<uint32_t>(ny) * map_.Width + static_cast<uint32_t>(nx) };
+							if (map_.Tiles[idx_Neighbour] != 0U || Labels[idx_Neighbour] != 0U) { continue; }
+							Labels[idx_Neighbour] = label;
+							stack.emplace_back(idx_Neighbour);
+						}
+					}
+				}
+			}
+
+			std::vector<uint32_t> Labels;
+			uint32_t Num_Components{ 0U };
+		};
+
+		// Built on first use, so that a filtered run does not generate a 4096 x 4096 map for nothing.
+		struct LazyMap {
+			Map const& Get() {
+				if (!Instance) { Instance = std::make_unique<Map>(Caves(Side, Side, 0x4C554D49U)); }
+				return *Instance;
+			}
+
+			uint32_t Side;
+			std::unique_ptr<Map> Instance{};
+		};
+
+		bool IsSame(Lumina::ConnectedComponents const& lhs_, Lumina::ConnectedComponents const& rhs_) {
+			if (lhs_.Labels() != rhs_.Labels() || lhs_.Num_Components() != rhs_.Num_Components()) { return false; }
+			for (uint32_t label{ 1U }; label <= lhs_.Num_Components(); ++label) {
+				auto const& l{ lhs_[label] };
+				auto const& r{ rhs_[label] };
+				if (
+					l.Area != r.Area || l.Min.x != r.Min.x || l.Min.y != r.Min.y || l.Max.x != r.Max.x || l.Max.y != r.Max.y ||
+					l.Centroid.x != r.Centroid.x || l.Centroid.y != r.Centroid.y
+				) { return false; }
+			}
+			return true;
+		}
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		// Same caves, same numbering, on maps of the size the game generates.
+		suite_.Verify("Math/ConnectedComponents/MatchesFlood", [] () {
+			for (uint32_t seed{ 0U }; seed < 32U; ++seed) {
+				Map const map{ Caves(128U, 64U, seed) };
+				RecursiveFlood const flood{ map };
+				Lumina::ConnectedComponents components{};
+				components.Label(map.Width, map.Height, [&map] (uint32_t x_, uint32_t y_) { return map.IsFloor(x_, y_); });
+
+				if (components.Labels() != flood.Labels || components.Num_Components() != flood.Areas.size()) { return false; }
+				for (uint32_t label{ 1U }; label <= components.Num_Components(); ++label) {
+					if (components[label].Area != flood.Areas[label - 1U]) { return false; }
+				}
+			}
+			return true;
+		});
+		suite_.Verify("Math/ConnectedComponents/EightConnected", [] () {
+			for (uint32_t seed{ 0U }; seed < 8U; ++seed) {
+				Map const map{ Caves(301U, 157U, seed) };
+				StackFlood const flood{ map, CONNECTIVITY::EIGHT };
+				Lumina::ConnectedComponents components{};
+				components.Label(map.Width, map.Height, [&map] (uint32_t x_, uint32_t y_) { return map.IsFloor(x_, y_); }, CONNECTIVITY::EIGHT);
+				if (components.Labels() != flood.Labels || components.Num_Components() != flood.Num_Components) { return false; }
+			}
+			return true;
+		});
+		suite_.Verify("Math/ConnectedComponents/Statistics", [] () {
+			Map const map{ Caves(257U, 131U, 7U) };
+			Lumina::ConnectedComponents components{};
+			components.Label(map.Width, map.Height, [&map] (uint32_t x_, uint32_t y_) { return map.IsFloor(x_, y_); });
+
+			for (uint32_t label{ 1U }; label <= components.Num_Components(); ++label) {
+				uint32_t area{ 0U };
+				int32_t minX{ INT32_MAX }, minY{ INT32_MAX }, maxX{ -1 }, maxY{ -1 };
+				double sumX{ 0.0 }, sumY{ 0.0 };
+				for (uint32_t y{ 0U }; y < map.Height; ++y) {
+					for (uint32_t x{ 0U }; x < map.Width; ++x) {
+						if (components(x, y) != label) { continue; }
+						++area;
+						minX = std::min(minX, static_cast<int32_t>(x));
+						minY = std::min(minY, static_cast<int32_t>(y));
+						maxX = std::max(maxX, static_cast<int32_t>(x));
+						maxY = std::max(maxY, static_cast<int32_t>(y));
+						sumX += x;
+						sumY += y;
+					}
+				}
+				auto const& component{ components[label] };
+				if (
+					component.Area != area || component.Min.x != minX || component.Min.y != minY || component.Max.x != maxX || component.Max.y != maxY ||
+					std::abs(component.Centroid.x - sumX / area) > 1e-3 || std::abs(component.Centroid.y - sumY / area) > 1e-3
+				) { return false; }
+			}
+			return components.Num_Components() > 1U;
+		});
+		// Strips stitched together give exactly what one pass over the whole map gives, at any strip count.
+		suite_.Verify("Math/ConnectedComponents/Strips", [] () {
+			Map const map{ Caves(517U, 509U, 3U) };
+			auto const isFloor{ [&map] (uint32_t x_, uint32_t y_) { return map.IsFloor(x_, y_); } };
+			for (CONNECTIVITY const connectivity : { CONNECTIVITY::FOUR, CONNECTIVITY::EIGHT }) {
+				Lumina::ConnectedComponents whole{};
+				whole.Label(map.Width, map.Height, isFloor, connectivity);
+				for (uint32_t const num_Strips : { 2U, 3U, 7U, 16U, 1000U }) {
+					Lumina::ConnectedComponents strips{};
+					strips.Label(map.Width, map.Height, isFloor, connectivity, num_Strips);
+					if (!IsSame(whole, strips)) { return false; }
+				}
+			}
+			return true;
+		});
+		// One open cave over the whole map: far deeper than the recursive flood could go.
+		suite_.Verify("Math/ConnectedComponents/OpenMap", [] () {
+			Lumina::ConnectedComponents components{};
+			components.Label(4096U, 4096U, [] (uint32_t, uint32_t) { return true; }, CONNECTIVITY::FOUR, 4U);
+			auto const& component{ components[1U] };
+			return components.Num_Components() == 1U && component.Area == 4096U * 4096U &&
+				component.Max.x == 4095 && component.Max.y == 4095 && component.Centroid.x == 2047.5f;
+		});
+
+		//----	------	------	------	------	----//
+		//	Labelling							//
+		//----	------	------	------	------	----//
+
+		for (uint32_t const side : { 256U, 1024U, 4096U }) {
+			auto const map{ std::make_shared<LazyMap>(side) };
+			auto const label{
+				[map] (CONNECTIVITY connectivity_, uint32_t num_Strips_) {
+					return [map, connectivity_, num_Strips_] (uint64_t num_Iterations_) {
+						Map const& m{ map->Get() };
+						Lumina::ConnectedComponents components{};
+						for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+							components.Label(m.Width, m.Height, [&m] (uint32_t x_, uint32_t y_) { return m.IsFloor(x_, y_); }, connectivity_, num_Strips_);
+							DoNotOptimize(components.Num_Components());
+						}
+					};
+				}
+			};
+
+			suite_.Add(std::format("Math/ConnectedComponents/{0}x{0}/StackFlood", side), [map] (uint64_t num_Iterations_) {
+				Map const& m{ map->Get() };
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					StackFlood const flood{ m, CONNECTIVITY::FOUR };
+					DoNotOptimize(flood.Num_Components);
+				}
+			});
+			suite_.Add(std::format("Math/ConnectedComponents/{0}x{0}/Four", side), label(CONNECTIVITY::FOUR, 1U));
+			suite_.Add(std::format("Math/ConnectedComponents/{0}x{0}/Eight", side), label(CONNECTIVITY::EIGHT, 1U));
+			suite_.Add(std::format("Math/ConnectedComponents/{0}x{0}/Four/4Strips", side), label(CONNECTIVITY::FOUR, 4U));
+			suite_.Add(std::format("Math/ConnectedComponents/{0}x{0}/Four/8Strips", side), label(CONNECTIVITY::FOUR, 8U));
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,207 @@
+export module Benchmark.Container;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <random>;
+import <memory>;
+import <bitset>;
+
+import <vector>;
+
+import Benchmark.Harness;
+
+import Lumina.Container.Bitset;
+import Lumina.Container.List;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::Container {
+	namespace {
+		// Random Set/Flip/SetRange against std::bitset, then every query and binary operation.
+		template<uint32_t N>
+		bool MatchesStd(uint32_t seed_) {
+			std::mt19937 rndGen{ seed_ };
+			Lumina::Bitset<N> lhs{};
+			Lumina::Bitset<N> rhs{};
+			std::bitset<N> lhs_Std{};
+			std::bitset<N> rhs_Std{};
+			for (uint32_t i{ 0U }; i < N; ++i) {
+				uint32_t const pos{ static_cast<uint32_t>(rndGen() % N) };
+				switch (rndGen() % 3U) {
+				case 0U:
+					lhs.Set(pos, (i & 1U) != 0U);
+					lhs_Std.set(pos, (i & 1U) != 0U);
+					break;
+				case 1U:
+					rhs.Flip(pos);
+					rhs_Std.flip(pos);
+					break;
+				default: {
+					uint32_t const last{ pos + static_cast<uint32_t>(rndGen() % (N - pos + 1U)) };
+					for (uint32_t j{ pos }; j < last; ++j) { rhs_Std.set(j, (i & 2U) != 0U); }
+					rhs.SetRange(pos, last, (i & 2U) != 0U);
+					break;
+				}
+				}
+			}
+
+			auto const same{
+				[] (Lumina::Bitset<N> const& bitset_, std::bitset<N> const& std_) {
+					if (bitset_.Count() != std_.count() || bitset_.Any() != std_.any()) { return false; }
+					std::vector<uint32_t> positions{};
+					bitset_.ForEachSet([&positions] (uint32_t pos_) { positions.emplace_back(pos_); });
+					uint32_t pos_Find{ bitset_.FindFirst() };
+					size_t idx{ 0LLU };
+					for (uint32_t pos{ 0U }; pos < N; ++pos) {
+						if (bitset_[pos] != std_[pos]) { return false; }
+						if (!std_[pos]) { continue; }
+						if (idx >= positions.size() || positions[idx++] != pos || pos_Find != pos) { return false; }
+						pos_Find = bitset_.FindNext(pos_Find);
+					}
+					return (idx == positions.size()) && (pos_Find == Lumina::Bitset<N>::NPos);
+				}
+			};
+
+			Lumina::Bitset<N> all{};
+			all.SetAllOne();
+			Lumina::Bitset<N> copy{ lhs };
+			copy ^= rhs;
+			return
+				same(lhs, lhs_Std) && same(rhs, rhs_Std) &&
+				same(lhs & rhs, lhs_Std & rhs_Std) &&
+				same(lhs | rhs, lhs_Std | rhs_Std) &&
+				same(lhs ^ rhs, lhs_Std ^ rhs_Std) &&
+				same(lhs.AndNot(rhs), lhs_Std & ~rhs_Std) &&
+				same(Lumina::Bitset<N>::RisingEdges(lhs, rhs), lhs_Std & ~rhs_Std) &&
+				same(Lumina::Bitset<N>::FallingEdges(lhs, rhs), rhs_Std & ~lhs_Std) &&
+				same(all, std::bitset<N>{}.set()) &&
+				(copy == (lhs ^ rhs));
+		}
+
+		struct Payload {
+			float Position[4];
+			float Velocity[4];
+			int32_t Life;
+		};
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		// 1000 leaves a partial last word; 4096 takes the AVX2 paths.
+		suite_.Verify("Container/Bitset/MatchesStd", [] () {
+			return MatchesStd<1000U>(1U) && MatchesStd<4096U>(2U) && MatchesStd<64U>(3U) && MatchesStd<3U>(4U);
+		});
+
+		//----	------	------	------	------	----//
+		//	Bitset								//
+		//----	------	------	------	------	----//
+
+		// List owns a raw heap array and must not be copied, so each case shares its instance through shared_ptr;
+		// the Bitset cases do the same, which keeps the 8 KiB Bitset<65536> out of the lambda.
+		suite_.Add("Container/Bitset<256>/Set", [bitset = std::make_shared<Lumina::Bitset<256U>>()] (uint64_t num_Iterations_) {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				bitset->Set(static_cast<uint32_t>(i * 37LLU) & 0xFFU, (i & 1LLU) != 0LLU);
+			}
+			DoNotOptimize((*bitset)()[0]);
+		});
+		suite_.Add("Container/Bitset<256>/Test", [bitset = std::make_shared<Lumina::Bitset<256U>>()] (uint64_t num_Iterations_) {
+			uint32_t cnt{ 0U };
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				cnt += (*bitset)[static_cast<uint32_t>(i * 37LLU) & 0xFFU];
+			}
+			DoNotOptimize(cnt);
+		});
+		suite_.Add("Container/Bitset<256>/Copy", [bitsets = std::make_shared<Lumina::Bitset<256U>[]>(2LLU)] (uint64_t num_Iterations_) {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				bitsets[i & 1LLU].Set(bitsets[(i + 1LLU) & 1LLU]);
+			}
+			DoNotOptimize(bitsets[0]()[0]);
+		});
+		// Mirrors the per-frame keyboard edge detection in Scene_InGame: 256 keys, pressed this frame but not the last.
+		suite_.Add("Container/Bitset<256>/EdgeScan", [bitsets = std::make_shared<Lumina::Bitset<256U>[]>(2LLU)] (uint64_t num_Iterations_) {
+			uint32_t cnt{ 0U };
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				for (uint32_t key{ 0U }; key < 256U; ++key) {
+					cnt += (bitsets[0][key] && !bitsets[1][key]);
+				}
+			}
+			DoNotOptimize(cnt);
+		}, 64LLU);
+		suite_.Add("Container/Bitset<256>/RisingEdges", [bitsets = std::make_shared<Lumina::Bitset<256U>[]>(2LLU)] (uint64_t num_Iterations_) {
+			uint32_t cnt{ 0U };
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				bitsets[i & 1LLU].Flip(static_cast<uint32_t>(i) & 0xFFU);
+				cnt += Lumina::Bitset<256U>::RisingEdges(bitsets[0], bitsets[1]).Any();
+			}
+			DoNotOptimize(cnt);
+		}, 64LLU);
+		suite_.Add("Container/Bitset<65536>/Count", [bitset = std::make_shared<Lumina::Bitset<65536U>>()] (uint64_t num_Iterations_) {
+			for (uint32_t pos{ 0U }; pos < 65536U; pos += 3U) { bitset->Set(pos); }
+			uint32_t cnt{ 0U };
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				cnt += bitset->Count();
+				DoNotOptimize(cnt);
+			}
+		}, 8192LLU);
+		suite_.Add("Container/Bitset<65536>/And", [bitsets = std::make_shared<Lumina::Bitset<65536U>[]>(3LLU)] (uint64_t num_Iterations_) {
+			bitsets[0].SetRange(0U, 40000U);
+			bitsets[1].SetRange(20000U, 65536U);
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				bitsets[2] = bitsets[0] & bitsets[1];
+				DoNotOptimize(bitsets[2]()[0]);
+			}
+		}, 8192LLU * 3LLU);
+		// 1 bit in 64 set, roughly the density of live cells in a sparse occupancy mask.
+		suite_.Add("Container/Bitset<65536>/ForEachSet", [bitset = std::make_shared<Lumina::Bitset<65536U>>()] (uint64_t num_Iterations_) {
+			for (uint32_t pos{ 0U }; pos < 65536U; pos += 64U) { bitset->Set(pos + (pos >> 6U) % 64U); }
+			uint64_t sum{ 0LLU };
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				bitset->ForEachSet([&sum] (uint32_t pos_) { sum += pos_; });
+				DoNotOptimize(sum);
+			}
+		}, 8192LLU);
+		suite_.Add("Container/Bitset<65536>/SetAllZero", [bitset = std::make_shared<Lumina::Bitset<65536U>>()] (uint64_t num_Iterations_) {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				bitset->SetAllZero();
+				DoNotOptimize((*bitset)()[0]);
+			}
+		}, 8192LLU);
+
+		//----	------	------	------	------	----//
+		//	List								//
+		//----	------	------	------	------	----//
+
+		// Spawns and retires elements the way the bullet managers do.
+		suite_.Add("Container/List<4096>/NewDelete", [list = std::make_shared<Lumina::List<Payload>>(4096U)] (uint64_t num_Iterations_) {
+			Lumina::List<Payload>::Iterator<Payload> it{ *list };
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				if (list->IsFull()) {
+					it.Begin();
+					list->Delete(it);
+				}
+				auto& elem{ list->NewElement() };
+				elem.Life = static_cast<int32_t>(i);
+			}
+			list->Clear();
+		});
+		suite_.Add("Container/List<4096>/Iterate", [list = std::make_shared<Lumina::List<Payload>>(4096U)] (uint64_t num_Iterations_) {
+			list->Clear();
+			for (uint32_t i{ 0U }; i < 4096U; ++i) {
+				list->NewElement().Life = static_cast<int32_t>(i);
+			}
+			Lumina::List<Payload>::Iterator<Payload> it{ *list };
+			int64_t acc{ 0LL };
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				for (it.Begin(); !it.End(); it.Next()) {
+					acc += (*it).Life;
+				}
+			}
+			DoNotOptimize(acc);
+		}, sizeof(Payload) * 4096LLU);
+	}
+}
\ No newline at end of file
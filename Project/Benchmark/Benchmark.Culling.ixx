@@ -0,0 +1,209 @@
+export module Benchmark.Culling;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <cmath>;
+import <random>;
+import <memory>;
+import <type_traits>;
+
+import <vector>;
+import <algorithm>;
+
+import Benchmark.Harness;
+
+import Lumina.Math.Vector;
+import Lumina.Math.Matrix;
+import Lumina.Math.Bounds;
+import Lumina.Math.Frustum;
+import Lumina.Math.Culling;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::Culling {
+	namespace {
+		constexpr uint32_t Num_Objects{ 100000U };
+		// Not a multiple of 8, so that the padded tail is exercised by the checks.
+		constexpr uint32_t Num_CheckObjects{ 10003U };
+
+		Lumina::Mat4 ViewProjection(Lumina::Vec3 const& rotate_, Lumina::Vec3 const& translate_) {
+			Lumina::Mat4 vp{};
+			Lumina::Mat4::Multiply(
+				vp,
+				Lumina::Mat4::SRT({ 1.0f, 1.0f, 1.0f }, rotate_, translate_).Inv(),
+				Lumina::Mat4::PerspectiveFOV(0.45f, 1280.0f / 720.0f, 0.1f, 200.0f)
+			);
+			return vp;
+		}
+
+		// The in-game camera: looks down +z at the z = 0 plane from 50 units away.
+		Lumina::Mat4 GameViewProjection() {
+			return ViewProjection({ 0.0f, 0.0f, 0.0f }, { 128.0f, 64.0f, -50.0f });
+		}
+
+		struct Scene {
+			Lumina::AABBBatch Boxes;
+			Lumina::SphereBatch Spheres;
+			Lumina::AABBBatch Sprites;
+		};
+
+		// Objects scattered over a region several times larger than the view, so that roughly a quarter survives.
+		void Populate(Scene& scene_, uint32_t num_, std::mt19937& rndGen_) {
+			std::uniform_real_distribution<float> distX{ 0.0f, 256.0f };
+			std::uniform_real_distribution<float> distY{ 0.0f, 128.0f };
+			std::uniform_real_distribution<float> distZ{ -20.0f, 180.0f };
+			std::uniform_real_distribution<float> distSize{ 0.1f, 2.0f };
+			scene_.Boxes.Reserve(num_);
+			scene_.Spheres.Reserve(num_);
+			scene_.Sprites.Reserve(num_);
+			for (uint32_t i{ 0U }; i < num_; ++i) {
+				Lumina::Vec3 const center{ distX(rndGen_), distY(rndGen_), distZ(rndGen_) };
+				float const size{ distSize(rndGen_) };
+				scene_.Boxes.Push(center, { size, size * 0.5f, size * 2.0f });
+				scene_.Spheres.Push(center, size);
+				scene_.Sprites.Push({ center.x, center.y, 0.0f }, { size, size, 0.0f });
+			}
+		}
+
+		template<typename T_Test>
+		std::vector<uint32_t> ScalarReference(uint32_t num_, T_Test&& test_) {
+			std::vector<uint32_t> visible{};
+			for (uint32_t i{ 0U }; i < num_; ++i) {
+				if (test_(i)) { visible.emplace_back(i); }
+			}
+			return visible;
+		}
+
+		template<typename T_Batch, typename T_Volume>
+		bool MatchesReference(T_Volume const& volume_, T_Batch const& batch_) {
+			std::vector<uint32_t> visible(batch_.PaddedSize());
+			visible.resize(Lumina::Cull(volume_, batch_, visible.data()));
+			auto const reference{
+				ScalarReference(batch_.Size(), [&] (uint32_t idx_) {
+					if constexpr (std::is_same_v<T_Volume, Lumina::Rect2D>) { return volume_.Overlaps(batch_[idx_]); }
+					else { return volume_.Intersects(batch_[idx_]); }
+				})
+			};
+			return (visible == reference);
+		}
+	}
+
+	export void Register(Suite& suite_) {
+		std::mt19937 rndGen{ 0x4C554D49U };
+
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		suite_.Verify("Math/Culling/Frustum/AABB", [] () {
+			std::mt19937 rndGen{ 1U };
+			std::uniform_real_distribution<float> distAngle{ -3.14f, 3.14f };
+			Scene scene{};
+			Populate(scene, Num_CheckObjects, rndGen);
+			for (uint32_t i_View{ 0U }; i_View < 16U; ++i_View) {
+				auto const frustum{
+					Lumina::Frustum::Extract(
+						ViewProjection({ distAngle(rndGen), distAngle(rndGen), distAngle(rndGen) }, { 128.0f, 64.0f, 80.0f })
+					)
+				};
+				if (!MatchesReference(frustum, scene.Boxes)) { return false; }
+			}
+			return true;
+		});
+		suite_.Verify("Math/Culling/Frustum/Sphere", [] () {
+			std::mt19937 rndGen{ 2U };
+			std::uniform_real_distribution<float> distAngle{ -3.14f, 3.14f };
+			Scene scene{};
+			Populate(scene, Num_CheckObjects, rndGen);
+			for (uint32_t i_View{ 0U }; i_View < 16U; ++i_View) {
+				auto const frustum{
+					Lumina::Frustum::Extract(
+						ViewProjection({ distAngle(rndGen), distAngle(rndGen), distAngle(rndGen) }, { 128.0f, 64.0f, 80.0f })
+					)
+				};
+				if (!MatchesReference(frustum, scene.Spheres)) { return false; }
+			}
+			return true;
+		});
+		suite_.Verify("Math/Culling/Rect2D", [] () {
+			std::mt19937 rndGen{ 3U };
+			Scene scene{};
+			Populate(scene, Num_CheckObjects, rndGen);
+			return MatchesReference(Lumina::Frustum::Extract(GameViewProjection()).Footprint(0.0f), scene.Sprites);
+		});
+		// The footprint corners must land on the edges of the screen.
+		suite_.Verify("Math/Culling/Footprint", [] () {
+			auto const vp{ GameViewProjection() };
+			auto const rect{ Lumina::Frustum::Extract(vp).Footprint(0.0f) };
+			for (float const x : { rect.MinX, rect.MaxX }) {
+				for (float const y : { rect.MinY, rect.MaxY }) {
+					auto const clip{ Lumina::Vec4{ x, y, 0.0f, 1.0f } * vp };
+					if (std::abs(std::abs(clip.x / clip.w) - 1.0f) > 1.0e-3f || std::abs(std::abs(clip.y / clip.w) - 1.0f) > 1.0e-3f) {
+						return false;
+					}
+				}
+			}
+			return true;
+		});
+
+		//----	------	------	------	------	----//
+		//	Kernels								//
+		//----	------	------	------	------	----//
+
+		auto scene{ std::make_shared<Scene>() };
+		Populate(*scene, Num_Objects, rndGen);
+		auto const frustum{ Lumina::Frustum::Extract(GameViewProjection()) };
+		auto const rect{ frustum.Footprint(0.0f) };
+
+		suite_.Add("Math/Culling/Scalar/AABB100k", [scene, frustum] (uint64_t num_Iterations_) {
+			std::vector<uint32_t> visible(Num_Objects);
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				uint32_t num_Visible{ 0U };
+				for (uint32_t idx{ 0U }; idx < Num_Objects; ++idx) {
+					if (frustum.Intersects(scene->Boxes[idx])) { visible[num_Visible++] = idx; }
+				}
+				DoNotOptimize(num_Visible);
+			}
+		}, sizeof(float) * 6LLU * Num_Objects);
+		suite_.Add("Math/Culling/AVX2/AABB100k", [scene, frustum] (uint64_t num_Iterations_) {
+			std::vector<uint32_t> visible(scene->Boxes.PaddedSize());
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				DoNotOptimize(Lumina::Cull(frustum, scene->Boxes, visible.data()));
+			}
+		}, sizeof(float) * 6LLU * Num_Objects);
+		suite_.Add("Math/Culling/Scalar/Sphere100k", [scene, frustum] (uint64_t num_Iterations_) {
+			std::vector<uint32_t> visible(Num_Objects);
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				uint32_t num_Visible{ 0U };
+				for (uint32_t idx{ 0U }; idx < Num_Objects; ++idx) {
+					if (frustum.Intersects(scene->Spheres[idx])) { visible[num_Visible++] = idx; }
+				}
+				DoNotOptimize(num_Visible);
+			}
+		}, sizeof(float) * 4LLU * Num_Objects);
+		suite_.Add("Math/Culling/AVX2/Sphere100k", [scene, frustum] (uint64_t num_Iterations_) {
+			std::vector<uint32_t> visible(scene->Spheres.PaddedSize());
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				DoNotOptimize(Lumina::Cull(frustum, scene->Spheres, visible.data()));
+			}
+		}, sizeof(float) * 4LLU * Num_Objects);
+		suite_.Add("Math/Culling/Scalar/Rect2D100k", [scene, rect] (uint64_t num_Iterations_) {
+			std::vector<uint32_t> visible(Num_Objects);
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				uint32_t num_Visible{ 0U };
+				for (uint32_t idx{ 0U }; idx < Num_Objects; ++idx) {
+					if (rect.Overlaps(scene->Sprites[idx])) { visible[num_Visible++] = idx; }
+				}
+				DoNotOptimize(num_Visible);
+			}
+		}, sizeof(float) * 4LLU * Num_Objects);
+		suite_.Add("Math/Culling/AVX2/Rect2D100k", [scene, rect] (uint64_t num_Iterations_) {
+			std::vector<uint32_t> visible(scene->Sprites.PaddedSize());
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				DoNotOptimize(Lumina::Cull(rect, scene->Sprites, visible.data()));
+			}
+		}, sizeof(float) * 4LLU * Num_Objects);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,303 @@
+export module Benchmark.FlatHashMap;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <random>;
+import <memory>;
+import <string>;
+import <string_view>;
+
+import <vector>;
+import <unordered_map>;
+import <algorithm>;
+
+import Benchmark.Harness;
+
+import Lumina.Container.FlatHashMap;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::FlatHashMap {
+	namespace {
+		// Applies the same random operations to a FlatHashMap and a std::unordered_map and compares them regularly.
+		// Keys are drawn from a small range so that inserts, hits, and erases all happen often and tombstones pile up.
+		template<typename K, typename V, typename T_MakeKey, typename T_MakeVal>
+		bool MatchesUnorderedMap(uint32_t seed_, T_MakeKey&& makeKey_, T_MakeVal&& makeVal_) {
+			std::mt19937 rndGen{ seed_ };
+			Lumina::FlatHashMap<K, V> flat{};
+			std::unordered_map<K, V> reference{};
+			auto const same{
+				[&] () {
+					if (flat.size() != reference.size()) { return false; }
+					size_t num_Visited{ 0LLU };
+					for (auto const& [key, val] : flat) {
+						auto const it{ reference.find(key) };
+						if (it == reference.cend() || !(it->second == val)) { return false; }
+						++num_Visited;
+					}
+					return num_Visited == reference.size();
+				}
+			};
+
+			for (uint32_t i{ 0U }; i < 20000U; ++i) {
+				uint32_t const op{ static_cast<uint32_t>(rndGen() % 10U) };
+				K const key{ makeKey_(static_cast<uint32_t>(rndGen() % 700U)) };
+				V const val{ makeVal_(i) };
+				switch (op) {
+				case 0U: case 1U: case 2U: {
+					bool const isInserted_Flat{ flat.try_emplace(key, val).second };
+					bool const isInserted_Ref{ reference.try_emplace(key, val).second };
+					if (isInserted_Flat != isInserted_Ref) { return false; }
+					break;
+				}
+				case 3U:
+					flat[key] = val;
+					reference[key] = val;
+					break;
+				case 4U: case 5U: case 6U:
+					if (flat.erase(key) != reference.erase(key)) { return false; }
+					break;
+				case 7U: {
+					auto const it_Flat{ flat.find(key) };
+					auto const it_Ref{ reference.find(key) };
+					if ((it_Flat == flat.cend()) != (it_Ref == reference.cend())) { return false; }
+					if (it_Flat != flat.cend() && !(it_Flat->second == it_Ref->second)) { return false; }
+					break;
+				}
+				case 8U:
+					if (i % 512U == 0U) {
+						auto copy{ flat };
+						auto moved{ std::move(copy) };
+						if (!copy.empty()) { return false; }
+						flat = moved;
+					}
+					break;
+				default:
+					if (i % 4096U == 0U) {
+						flat.clear();
+						reference.clear();
+					}
+					break;
+				}
+				if (i % 64U == 0U && !same()) { return false; }
+			}
+			return same();
+		}
+
+		// Erasing while iterating, and erasing in general, leaves every other element where it was.
+		bool IsEraseStable() {
+			Lumina::FlatHashMap<uint32_t, uint32_t> map{};
+			for (uint32_t i{ 0U }; i < 1000U; ++i) { map.try_emplace(i, i * 3U); }
+
+			std::vector<std::pair<uint32_t, uint32_t const*>> addresses{};
+			for (auto const& [key, val] : map) { addresses.emplace_back(key, &val); }
+
+			for (auto it{ map.begin() }; it != map.end(); ) {
+				if (it->first % 3U == 0U) { it = map.erase(it); }
+				else { ++it; }
+			}
+			return std::all_of(
+				addresses.cbegin(), addresses.cend(),
+				[&] (auto const& pair_) {
+					auto const it{ map.find(pair_.first) };
+					if (pair_.first % 3U == 0U) { return it == map.cend(); }
+					return it != map.cend() && &it->second == pair_.second && it->second == pair_.first * 3U;
+				}
+			) && map.size() == 666LLU;
+		}
+
+		// String keys found by string_view and literal without building a std::string, and reserve() holding its promise.
+		bool IsHeterogeneous() {
+			Lumina::FlatHashMap<std::string, uint32_t> map{};
+			map.reserve(100LLU);
+			size_t const capacity{ map.capacity() };
+			for (uint32_t i{ 0U }; i < 100U; ++i) {
+				std::string const name{ "Assets/Textures/Texture_" + std::to_string(i) + ".png" };
+				map.try_emplace(std::string_view{ name }, i);
+			}
+			std::string_view const key{ "Assets/Textures/Texture_42.png" };
+			return (map.capacity() == capacity) && (map.find(key) != map.cend()) && (map.find(key)->second == 42U) &&
+				map.contains("Assets/Textures/Texture_7.png") && !map.contains(std::string_view{ "Assets/Textures/Texture_100.png" }) &&
+				(map.erase(key) == 1LLU) && !map.contains(key);
+		}
+
+		//----	------	------	------	------	----//
+		//	Key distributions					//
+		//----	------	------	------	------	----//
+
+		// ResourceManager::Dict_ImageTextures_: a few hundred paths sharing long prefixes.
+		std::vector<std::string> TexturePaths(uint32_t num_) {
+			constexpr std::string_view categories[]{ "Characters", "Environment", "Particles", "UI", "Terrain" };
+			std::vector<std::string> paths{};
+			paths.reserve(num_);
+			for (uint32_t i{ 0U }; i < num_; ++i) {
+				paths.emplace_back("Assets/Textures/" + std::string{ categories[i % 5U] } + "/Texture_" + std::to_string(i) + ".png");
+			}
+			return paths;
+		}
+
+		enum class STATEMENT : uint8_t {
+			POSITION,
+			TEXCOORD,
+			NORMAL,
+			FACE,
+			MTLLIB,
+		};
+
+		// WavefrontOBJParser::Statements_: five keywords, looked up once per line in the proportions of a typical mesh,
+		// including the comment, group, and material lines that miss.
+		std::vector<std::string> OBJSpecifiers(uint32_t num_) {
+			std::mt19937 rndGen{ 0x4C554D49U };
+			std::vector<std::string> specifiers{};
+			specifiers.reserve(num_);
+			for (uint32_t i{ 0U }; i < num_; ++i) {
+				uint32_t const roll{ static_cast<uint32_t>(rndGen() % 100U) };
+				specifiers.emplace_back(
+					(roll < 30U) ? "v" : (roll < 55U) ? "vt" : (roll < 80U) ? "vn" : (roll < 97U) ? "f" :
+					(roll < 98U) ? "#" : (roll < 99U) ? "usemtl" : "s"
+				);
+			}
+			return specifiers;
+		}
+
+		// RawInput::MessageProcessors_: two registered messages, against the message stream of a window in focus,
+		// where mouse moves and raw input dominate and everything else misses.
+		std::vector<uint32_t> WindowMessages(uint32_t num_) {
+			constexpr uint32_t WM_INPUT{ 0x00FFU };
+			constexpr uint32_t WM_MOUSEMOVE{ 0x0200U };
+			constexpr uint32_t others[]{ 0x000FU, 0x0020U, 0x0084U, 0x0113U, 0x0100U, 0x0101U, 0x0201U, 0x0202U, 0x020AU, 0x0014U };
+			std::mt19937 rndGen{ 0x4C554D49U };
+			std::vector<uint32_t> msgs(num_);
+			for (auto& msg : msgs) {
+				uint32_t const roll{ static_cast<uint32_t>(rndGen() % 100U) };
+				msg = (roll < 45U) ? WM_INPUT : (roll < 80U) ? WM_MOUSEMOVE : others[roll % 10U];
+			}
+			return msgs;
+		}
+
+		//----	------	------	------	------	----//
+
+		template<typename T_Map, typename T_Keys>
+		uint64_t LookupAll(T_Map const& map_, T_Keys const& keys_) {
+			uint64_t sum{ 0LLU };
+			for (auto const& key : keys_) {
+				auto const it{ map_.find(key) };
+				if (it != map_.cend()) { sum += static_cast<uint64_t>(it->second); }
+			}
+			return sum;
+		}
+
+		template<typename T_Map>
+		void RegisterLookup(Suite& suite_, std::string_view name_, std::shared_ptr<std::vector<std::string> const> keys_) {
+			auto const map{ std::make_shared<T_Map>() };
+			for (uint32_t i{ 0U }; i < keys_->size(); ++i) { map->try_emplace((*keys_)[i], i); }
+			suite_.Add(name_, [map, keys_] (uint64_t num_Iterations_) {
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					DoNotOptimize(LookupAll(*map, *keys_));
+				}
+			});
+		}
+
+		template<typename T_Map>
+		void RegisterInsert(Suite& suite_, std::string_view name_, std::shared_ptr<std::vector<std::string> const> keys_) {
+			suite_.Add(name_, [keys_] (uint64_t num_Iterations_) {
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					T_Map map{};
+					for (uint32_t idx{ 0U }; idx < keys_->size(); ++idx) { map.try_emplace((*keys_)[idx], idx); }
+					DoNotOptimize(map.size());
+				}
+			});
+		}
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		suite_.Verify("Container/FlatHashMap/MatchesUnorderedMap/Integer", [] () {
+			return MatchesUnorderedMap<uint32_t, uint32_t>(
+				1U,
+				[] (uint32_t i_) { return i_ * 0x9E3779B9U; },
+				[] (uint32_t i_) { return i_; }
+			);
+		});
+		// Identity-hashed keys that differ only in the high bits, which a table without hash mixing would pile into one group.
+		suite_.Verify("Container/FlatHashMap/MatchesUnorderedMap/HighBits", [] () {
+			return MatchesUnorderedMap<uint64_t, uint32_t>(
+				2U,
+				[] (uint32_t i_) { return static_cast<uint64_t>(i_) << 40U; },
+				[] (uint32_t i_) { return i_; }
+			);
+		});
+		suite_.Verify("Container/FlatHashMap/MatchesUnorderedMap/String", [] () {
+			// Longer than the small-string buffer, so that leaks and double frees show up under a sanitizer.
+			return MatchesUnorderedMap<std::string, std::string>(
+				3U,
+				[] (uint32_t i_) { return "Assets/Textures/Texture_" + std::to_string(i_) + ".png"; },
+				[] (uint32_t i_) { return std::string(24LLU, 'a') + std::to_string(i_); }
+			);
+		});
+		suite_.Verify("Container/FlatHashMap/EraseStable", IsEraseStable);
+		suite_.Verify("Container/FlatHashMap/Heterogeneous", IsHeterogeneous);
+
+		//----	------	------	------	------	----//
+		//	Texture paths						//
+		//----	------	------	------	------	----//
+
+		using StringMap_Std = std::unordered_map<std::string, uint32_t>;
+		using StringMap_Flat = Lumina::FlatHashMap<std::string, uint32_t>;
+
+		std::shared_ptr<std::vector<std::string> const> const paths{ std::make_shared<std::vector<std::string>>(TexturePaths(512U)) };
+		RegisterLookup<StringMap_Std>(suite_, "Container/FlatHashMap/TexturePaths/Lookup/unordered_map", paths);
+		RegisterLookup<StringMap_Flat>(suite_, "Container/FlatHashMap/TexturePaths/Lookup/FlatHashMap", paths);
+		RegisterInsert<StringMap_Std>(suite_, "Container/FlatHashMap/TexturePaths/Insert/unordered_map", paths);
+		RegisterInsert<StringMap_Flat>(suite_, "Container/FlatHashMap/TexturePaths/Insert/FlatHashMap", paths);
+
+		//----	------	------	------	------	----//
+		//	OBJ keywords						//
+		//----	------	------	------	------	----//
+
+		auto const specifiers{ std::make_shared<std::vector<std::string>>(OBJSpecifiers(16384U)) };
+		auto const statements_Std{
+			std::make_shared<std::unordered_map<std::string, STATEMENT>>(std::unordered_map<std::string, STATEMENT>{
+				{ "v", STATEMENT::POSITION }, { "vt", STATEMENT::TEXCOORD }, { "vn", STATEMENT::NORMAL }, { "f", STATEMENT::FACE }, { "mtllib", STATEMENT::MTLLIB },
+			})
+		};
+		auto const statements_Flat{
+			std::make_shared<Lumina::FlatHashMap<std::string_view, STATEMENT>>(Lumina::FlatHashMap<std::string_view, STATEMENT>{
+				{ "v", STATEMENT::POSITION }, { "vt", STATEMENT::TEXCOORD }, { "vn", STATEMENT::NORMAL }, { "f", STATEMENT::FACE }, { "mtllib", STATEMENT::MTLLIB },
+			})
+		};
+		suite_.Add("Container/FlatHashMap/OBJKeywords/Lookup/unordered_map", [statements_Std, specifiers] (uint64_t num_Iterations_) {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				DoNotOptimize(LookupAll(*statements_Std, *specifiers));
+			}
+		});
+		suite_.Add("Container/FlatHashMap/OBJKeywords/Lookup/FlatHashMap", [statements_Flat, specifiers] (uint64_t num_Iterations_) {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				DoNotOptimize(LookupAll(*statements_Flat, *specifiers));
+			}
+		});
+
+		//----	------	------	------	------	----//
+		//	Message IDs							//
+		//----	------	------	------	------	----//
+
+		auto const msgs{ std::make_shared<std::vector<uint32_t>>(WindowMessages(16384U)) };
+		auto const processors_Std{ std::make_shared<std::unordered_map<uint32_t, uint32_t>>(std::unordered_map<uint32_t, uint32_t>{ { 0x00FFU, 1U }, { 0x0200U, 2U } }) };
+		auto const processors_Flat{ std::make_shared<Lumina::FlatHashMap<uint32_t, uint32_t>>(Lumina::FlatHashMap<uint32_t, uint32_t>{ { 0x00FFU, 1U }, { 0x0200U, 2U } }) };
+		suite_.Add("Container/FlatHashMap/MessageIDs/Lookup/unordered_map", [processors_Std, msgs] (uint64_t num_Iterations_) {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				DoNotOptimize(LookupAll(*processors_Std, *msgs));
+			}
+		});
+		suite_.Add("Container/FlatHashMap/MessageIDs/Lookup/FlatHashMap", [processors_Flat, msgs] (uint64_t num_Iterations_) {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				DoNotOptimize(LookupAll(*processors_Flat, *msgs));
+			}
+		});
+	}
+}
\ No newline at end of file
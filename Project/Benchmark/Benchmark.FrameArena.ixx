@@ -0,0 +1,215 @@
+export module Benchmark.FrameArena;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cstdlib>;
+
+import <random>;
+import <memory>;
+import <memory_resource>;
+import <string>;
+import <string_view>;
+import <format>;
+
+import <vector>;
+import <algorithm>;
+
+import Benchmark.Harness;
+
+import Lumina.Container.FrameArena;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::FrameArena {
+	namespace {
+		struct Request {
+			uint32_t Size;
+			uint32_t Alignment;
+		};
+
+		// Mostly small, some mid-sized, a few large: a frame's worth of scratch lists and strings.
+		std::vector<Request> Requests(uint32_t num_, uint32_t seed_) {
+			std::mt19937 rndGen{ seed_ };
+			std::vector<Request> requests(num_);
+			for (auto& request : requests) {
+				uint32_t const kind{ static_cast<uint32_t>(rndGen() % 16U) };
+				uint32_t const size{
+					(kind < 12U) ? 8U + static_cast<uint32_t>(rndGen() % 120U) :
+					(kind < 15U) ? 128U + static_cast<uint32_t>(rndGen() % 1920U) :
+					4096U + static_cast<uint32_t>(rndGen() % 28672U)
+				};
+				request = { size, 1U << static_cast<uint32_t>(rndGen() % 7U) };
+			}
+			return requests;
+		}
+
+		bool IsAligned(void const* ptr_, size_t alignment_) { return (reinterpret_cast<uintptr_t>(ptr_) & (alignment_ - 1LLU)) == 0LLU; }
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		// Every block is aligned as asked and none overlap, across block boundaries included.
+		suite_.Verify("Container/FrameArena/AlignedDisjoint", [] () {
+			Lumina::FrameArena arena{ 4096LLU };
+			auto const requests{ Requests(2000U, 0x4C554D49U) };
+			std::vector<std::pair<uintptr_t, uintptr_t>> ranges{};
+			for (auto const& request : requests) {
+				void* const ptr{ arena.Allocate(request.Size, request.Alignment) };
+				if (!IsAligned(ptr, request.Alignment)) { return false; }
+				std::fill_n(static_cast<uint8_t*>(ptr), request.Size, uint8_t{ 0xA5U });
+				ranges.emplace_back(reinterpret_cast<uintptr_t>(ptr), reinterpret_cast<uintptr_t>(ptr) + request.Size);
+			}
+			std::sort(ranges.begin(), ranges.end());
+			for (size_t i{ 1LLU }; i < ranges.size(); ++i) {
+				if (ranges[i - 1LLU].second > ranges[i].first) { return false; }
+			}
+			return arena.Num_Blocks() > 1U;
+		});
+		suite_.Verify("Container/FrameArena/Rewind", [] () {
+			Lumina::FrameArena arena{ 1024LLU };
+			[[maybe_unused]] auto const* const head{ arena.Allocate<uint32_t>(16LLU) };
+			auto const marker{ arena.Mark() };
+			auto* const first{ arena.Allocate<uint32_t>(64LLU) };
+			{
+				// Spills into new blocks, all of which the scope gives back.
+				Lumina::FrameArena::Scope const scope{ arena };
+				for (uint32_t i{ 0U }; i < 8U; ++i) { arena.Allocate<uint64_t>(100LLU); }
+			}
+			if (arena.Allocate<uint32_t>(0LLU) != first + 64) { return false; }
+			arena.Rewind(marker);
+			if (arena.Used() != sizeof(uint32_t) * 16LLU || arena.Allocate<uint32_t>(64LLU) != first) { return false; }
+			return arena.HighWater() > 8LLU * 800LLU;
+		});
+		// Once a frame has grown the arena, the same frame again fits in the blocks it kept.
+		suite_.Verify("Container/FrameArena/ReusesBlocks", [] () {
+			Lumina::FrameArena arena{ 4096LLU };
+			auto const requests{ Requests(500U, 0x4C554D49U) };
+			uint32_t num_Blocks{ 0U };
+			for (uint32_t frame{ 0U }; frame < 4U; ++frame) {
+				arena.Reset();
+				for (auto const& request : requests) { arena.Allocate(request.Size, request.Alignment); }
+				if (frame > 0U && arena.Num_Blocks() != num_Blocks) { return false; }
+				num_Blocks = arena.Num_Blocks();
+			}
+			arena.Reset();
+			return arena.Used() == 0LLU;
+		});
+		suite_.Verify("Container/FrameArena/PmrContainers", [] () {
+			Lumina::FrameArena arena{ 1024LLU };
+			std::pmr::vector<std::pmr::string> lines{ &arena.MemoryResource() };
+			lines.reserve(100LLU);
+			for (uint32_t i{ 0U }; i < 100U; ++i) {
+				lines.emplace_back(std::format("Enemy #{:03d} hit by bullet #{:04d}", i, i * 7U));
+			}
+			for (uint32_t i{ 0U }; i < 100U; ++i) {
+				if (std::string_view{ lines[i] } != std::format("Enemy #{:03d} hit by bullet #{:04d}", i, i * 7U)) { return false; }
+			}
+			return lines.get_allocator().resource() == &arena.MemoryResource() && arena.Used() > 100LLU * 32LLU;
+		});
+		suite_.Verify("Container/FrameArena/LocalResetsOnEndFrame", [] () {
+			auto& arena{ Lumina::FrameArena::Local() };
+			arena.Allocate<uint64_t>(10LLU);
+			if (&Lumina::FrameArena::Local() != &arena || arena.Used() == 0LLU) { return false; }
+			Lumina::FrameArena::EndFrame();
+			return &Lumina::FrameArena::Local() == &arena && arena.Used() == 0LLU;
+		});
+
+		//----	------	------	------	------	----//
+		//	Frames								//
+		//----	------	------	------	------	----//
+
+		// 2000 mixed requests per frame, all freed at its end.
+		{
+			auto const requests{ std::make_shared<std::vector<Request>>(Requests(2000U, 0x4C554D49U)) };
+
+			suite_.Add("Container/FrameArena/MixedFrame/malloc", [requests] (uint64_t num_Iterations_) {
+				std::vector<void*> ptrs(requests->size());
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					for (size_t j{ 0LLU }; j < requests->size(); ++j) {
+						ptrs[j] = ::operator new((*requests)[j].Size, std::align_val_t{ (*requests)[j].Alignment });
+						DoNotOptimize(ptrs[j]);
+					}
+					for (size_t j{ 0LLU }; j < requests->size(); ++j) {
+						::operator delete(ptrs[j], std::align_val_t{ (*requests)[j].Alignment });
+					}
+				}
+			});
+			suite_.Add("Container/FrameArena/MixedFrame/FrameArena", [requests] (uint64_t num_Iterations_) {
+				Lumina::FrameArena arena{};
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					for (auto const& request : *requests) {
+						void* const ptr{ arena.Allocate(request.Size, request.Alignment) };
+						DoNotOptimize(ptr);
+					}
+					arena.Reset();
+				}
+			});
+		}
+
+		// The culling scratch of the three instance managers: a candidate pointer and a visible index per live instance.
+		{
+			constexpr uint32_t sizes[]{ 4096U, 128U, 4096U };
+
+			suite_.Add("Container/FrameArena/CullingScratch/std::vector", [sizes] (uint64_t num_Iterations_) {
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					for (uint32_t const size : sizes) {
+						std::vector<void const*> candidates{};
+						candidates.reserve(size);
+						for (uint32_t j{ 0U }; j < size; ++j) { candidates.emplace_back(&candidates); }
+						std::vector<uint32_t> visible(size);
+						DoNotOptimize(candidates.data());
+						DoNotOptimize(visible.data());
+					}
+				}
+			});
+			suite_.Add("Container/FrameArena/CullingScratch/FrameArena", [sizes] (uint64_t num_Iterations_) {
+				Lumina::FrameArena arena{};
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					for (uint32_t const size : sizes) {
+						// Plain arrays: std::pmr::vector's push_back goes through the uses-allocator construction, which costs more than the heap saves here.
+						void const** const candidates{ arena.Allocate<void const*>(size) };
+						for (uint32_t j{ 0U }; j < size; ++j) { candidates[j] = &candidates; }
+						uint32_t* const visible{ arena.Allocate<uint32_t>(size) };
+						std::fill_n(visible, size, 0U);
+						DoNotOptimize(candidates);
+						DoNotOptimize(visible);
+					}
+					arena.Reset();
+				}
+			});
+		}
+
+		// Debug text for 256 instances a frame, past the small string buffer.
+		{
+			suite_.Add("Container/FrameArena/Strings/std::string", [] (uint64_t num_Iterations_) {
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					std::vector<std::string> lines{};
+					lines.reserve(256LLU);
+					for (uint32_t j{ 0U }; j < 256U; ++j) {
+						lines.emplace_back(std::format("Instance #{:04d}: Position ({:.2f}, {:.2f})", j, j * 0.5f, j * 0.25f));
+					}
+					DoNotOptimize(lines.data());
+				}
+			});
+			// Null-terminated, as ImGui::Text takes them.
+			suite_.Add("Container/FrameArena/Strings/format_to_n", [] (uint64_t num_Iterations_) {
+				constexpr size_t maxLength{ 64LLU };
+				Lumina::FrameArena arena{};
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					char const** const lines{ arena.Allocate<char const*>(256LLU) };
+					for (uint32_t j{ 0U }; j < 256U; ++j) {
+						char* const line{ arena.Allocate<char>(maxLength) };
+						*std::format_to_n(line, maxLength - 1LLU, "Instance #{:04d}: Position ({:.2f}, {:.2f})", j, j * 0.5f, j * 0.25f).out = '\0';
+						lines[j] = line;
+					}
+					DoNotOptimize(lines);
+					arena.Reset();
+				}
+			});
+		}
+	}
+}
\ No newline at end of file
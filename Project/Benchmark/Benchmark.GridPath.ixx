@@ -0,0 +1,306 @@
+export module Benchmark.GridPath;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <cmath>;
+import <random>;
+import <memory>;
+
+import <vector>;
+import <array>;
+import <algorithm>;
+import <limits>;
+import <queue>;
+import <functional>;
+import <utility>;
+
+import <string>;
+import <format>;
+
+import Benchmark.Harness;
+
+import Lumina.Math.Numerics;
+import Lumina.Math.PerlinNoise;
+import Lumina.Math.CellularAutomaton;
+import Lumina.Math.ConnectedComponents;
+import Lumina.Math.GridPath;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::GridPath {
+	namespace {
+		constexpr float Cost_Floor{ 1.0f };
+		constexpr float Cost_Rock{ 4.0f };
+		constexpr float Infinity{ std::numeric_limits<float>::infinity() };
+
+		// Caves as CellularAutomata makes them, with the costs it gives tunnels to dig through them.
+		struct CaveMap {
+			uint32_t Width;
+			uint32_t Height;
+			// 1 marks a wall.
+			std::vector<uint8_t> Tiles;
+			std::vector<float> Costs;
+			std::vector<Lumina::Int2> Floors{};
+
+			bool IsFloor(uint32_t x_, uint32_t y_) const noexcept { return Tiles[y_ * Width + x_] == 0U; }
+			float operator()(uint32_t x_, uint32_t y_) const noexcept { return Costs[y_ * Width + x_]; }
+		};
+
+		CaveMap Caves(uint32_t width_, uint32_t height_, uint32_t seed_) {
+			std::mt19937 rndGen{ seed_ };
+			Lumina::CellularAutomaton automaton{};
+			automaton.Resize(width_, height_);
+			for (uint32_t y{ 0U }; y < height_; ++y) {
+				for (uint32_t x{ 0U }; x < width_; ++x) {
+					bool const isBorder{ x == 0U || y == 0U || x + 1U == width_ || y + 1U == height_ };
+					automaton.Grid().Set(x, y, isBorder || rndGen() % 100U < 45U);
+				}
+			}
+			automaton.Step(Lumina::AutomatonRule::Caves(), 4U);
+
+			Lumina::PerlinNoise const noise{ 0.08f, 2U, 0.5f, { 0.0f, 0.0f, static_cast<float>(seed_ & 0xFFFFU) } };
+			CaveMap map{ width_, height_, std::vector<uint8_t>(width_ * height_), std::vector<float>(width_ * height_) };
+			for (uint32_t y{ 0U }; y < height_; ++y) {
+				for (uint32_t x{ 0U }; x < width_; ++x) {
+					bool const isWall{ automaton.Grid()(x, y) };
+					map.Tiles[y * width_ + x] = isWall ? 1U : 0U;
+
+					float& cost{ map.Costs[y * width_ + x] };
+					if (x == 0U || y == 0U || x + 1U == width_ || y + 1U == height_) {
+						cost = Infinity;
+					}
+					else if (!isWall) {
+						cost = Cost_Floor;
+						map.Floors.emplace_back(static_cast<int32_t>(x), static_cast<int32_t>(y));
+					}
+					else {
+						cost = std::max(Cost_Rock * (1.0f + 0.5f * noise(static_cast<float>(x), static_cast<float>(y), 0.0f)), Cost_Floor);
+					}
+				}
+			}
+			return map;
+		}
+
+		// Digs a disk of radius_ around every cell of the path, as CellularAutomata::GenerateTunnel does.
+		void Carve(CaveMap& map_, std::vector<Lumina::Int2> const& path_, int32_t radius_) {
+			for (auto const& pos : path_) {
+				for (int32_t y{ std::max(pos.y - radius_, 1) }; y <= std::min(pos.y + radius_, static_cast<int32_t>(map_.Height) - 2); ++y) {
+					for (int32_t x{ std::max(pos.x - radius_, 1) }; x <= std::min(pos.x + radius_, static_cast<int32_t>(map_.Width) - 2); ++x) {
+						if ((x - pos.x) * (x - pos.x) + (y - pos.y) * (y - pos.y) > radius_ * radius_) { continue; }
+						map_.Tiles[y * map_.Width + x] = 0U;
+						map_.Costs[y * map_.Width + x] = Cost_Floor;
+					}
+				}
+			}
+		}
+
+		// What CellularAutomata::GenerateTunnel did before: a walk thrice as likely to step toward the goal on each axis
+		// it has not reached yet as any other way. Returns the number of steps taken.
+		uint64_t RandomWalk(CaveMap& map_, Lumina::Int2 const& start_, Lumina::Int2 const& goal_, std::mt19937& rndGen_) {
+			constexpr Lumina::Int2 Displacements[4]{ { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+			Lumina::Int2 pos{ start_ };
+			uint64_t num_Steps{ 0LLU };
+			while (pos.x != goal_.x || pos.y != goal_.y) {
+				std::array<float, 4> weights{ 1.0f, 1.0f, 1.0f, 1.0f };
+				if (pos.x > goal_.x) { weights[0] += 2.0f; }
+				else if (pos.x < goal_.x) { weights[1] += 2.0f; }
+				if (pos.y > goal_.y) { weights[2] += 2.0f; }
+				else if (pos.y < goal_.y) { weights[3] += 2.0f; }
+
+				std::discrete_distribution<uint32_t> pick{ weights.cbegin(), weights.cend() };
+				Lumina::Int2 const& dPos{ Displacements[pick(rndGen_)] };
+				Lumina::Int2 const newPos{ pos.x + dPos.x, pos.y + dPos.y };
+				++num_Steps;
+				if (newPos.x < 1 || newPos.y < 1 || newPos.x + 1 >= static_cast<int32_t>(map_.Width) || newPos.y + 1 >= static_cast<int32_t>(map_.Height)) { continue; }
+				pos = newPos;
+				map_.Tiles[pos.y * map_.Width + pos.x] = 0U;
+			}
+			return num_Steps;
+		}
+
+		// Dijkstra's over the same costs, with a priority queue of its own: what A* must agree with.
+		float DijkstraCost(CaveMap const& map_, Lumina::Int2 const& start_, Lumina::Int2 const& goal_) {
+			using Entry = std::pair<float, uint32_t>;
+			std::vector<float> costs(map_.Width * map_.Height, Infinity);
+			std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open{};
+			uint32_t const idx_Start{ static_cast<uint32_t>(start_.y) * map_.Width + static_cast<uint32_t>(start_.x) };
+			uint32_t const idx_Goal{ static_cast<uint32_t>(goal_.y) * map_.Width + static_cast<uint32_t>(goal_.x) };
+			costs[idx_Start] = 0.0f;
+			open.emplace(0.0f, idx_Start);
+			while (!open.empty()) {
+				auto const [cost, cell]{ open.top() };
+				open.pop();
+				if (cost > costs[cell]) { continue; }
+				if (cell == idx_Goal) { break; }
+
+				uint32_t const x{ cell % map_.Width };
+				uint32_t const y{ cell / map_.Width };
+				for (auto const& [nx, ny] : { std::pair{ x - 1U, y }, std::pair{ x + 1U, y }, std::pair{ x, y - 1U }, std::pair{ x, y + 1U } }) {
+					if (nx >= map_.Width || ny >= map_.Height) { continue; }
+					float const next{ cost + map_(nx, ny) };
+					if (next < costs[ny * map_.Width + nx]) {
+						costs[ny * map_.Width + nx] = next;
+						open.emplace(next, ny * map_.Width + nx);
+					}
+				}
+			}
+			return costs[idx_Goal];
+		}
+
+		// Runs from start_ to goal_ in 4-adjacent steps over enterable cells, and costs what the search says.
+		bool IsValid(CaveMap const& map_, std::vector<Lumina::Int2> const& path_, Lumina::Int2 const& start_, Lumina::Int2 const& goal_, float cost_) {
+			if (path_.empty() || path_.front().x != start_.x || path_.front().y != start_.y || path_.back().x != goal_.x || path_.back().y != goal_.y) {
+				return false;
+			}
+			double sum{ 0.0 };
+			for (size_t i{ 1LLU }; i < path_.size(); ++i) {
+				if (std::abs(path_[i].x - path_[i - 1LLU].x) + std::abs(path_[i].y - path_[i - 1LLU].y) != 1) { return false; }
+				float const cost{ map_(static_cast<uint32_t>(path_[i].x), static_cast<uint32_t>(path_[i].y)) };
+				if (!(cost < Infinity)) { return false; }
+				sum += cost;
+			}
+			return std::abs(sum - cost_) <= 1.0e-3 * std::max(1.0, sum);
+		}
+
+		// Random pairs of floor tiles, apart by at least a quarter of the map.
+		std::vector<std::pair<Lumina::Int2, Lumina::Int2>> Pairs(CaveMap const& map_, uint32_t num_Pairs_, uint32_t seed_) {
+			std::mt19937 rndGen{ seed_ };
+			std::vector<std::pair<Lumina::Int2, Lumina::Int2>> pairs{};
+			int32_t const minDistance{ static_cast<int32_t>((map_.Width + map_.Height) / 4U) };
+			while (pairs.size() < num_Pairs_) {
+				Lumina::Int2 const start{ map_.Floors[rndGen() % map_.Floors.size()] };
+				Lumina::Int2 const goal{ map_.Floors[rndGen() % map_.Floors.size()] };
+				if (std::abs(start.x - goal.x) + std::abs(start.y - goal.y) >= minDistance) { pairs.emplace_back(start, goal); }
+			}
+			return pairs;
+		}
+
+		// Built on first use, so that a filtered run does not generate the larger maps for nothing.
+		struct LazyMap {
+			CaveMap const& Get() {
+				if (!Instance) {
+					Instance = std::make_unique<CaveMap>(Caves(Side, Side, 0x4C554D49U));
+					PairsToJoin = Pairs(*Instance, 64U, 7U);
+				}
+				return *Instance;
+			}
+
+			uint32_t Side;
+			std::unique_ptr<CaveMap> Instance{};
+			std::vector<std::pair<Lumina::Int2, Lumina::Int2>> PairsToJoin{};
+		};
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		suite_.Verify("Math/GridPath/Cheapest", [] () {
+			Lumina::GridPathFinder finder{};
+			std::vector<Lumina::Int2> path{};
+			for (uint32_t seed{ 0U }; seed < 8U; ++seed) {
+				CaveMap const map{ Caves(96U + seed * 16U, 64U + seed * 8U, seed) };
+				for (auto const& [start, goal] : Pairs(map, 16U, seed)) {
+					if (!finder.Find(map.Width, map.Height, start, goal, map, Cost_Floor, path)) { return false; }
+					if (!IsValid(map, path, start, goal, finder.Cost())) { return false; }
+
+					float const expected{ DijkstraCost(map, start, goal) };
+					if (std::abs(finder.Cost() - expected) > 1.0e-3f * std::max(1.0f, expected)) { return false; }
+				}
+			}
+			return true;
+		});
+		// Tunnels dug along each path leave every start in the same cave as its goal.
+		suite_.Verify("Math/GridPath/Connected", [] () {
+			Lumina::GridPathFinder finder{};
+			std::vector<Lumina::Int2> path{};
+			for (uint32_t seed{ 0U }; seed < 4U; ++seed) {
+				CaveMap map{ Caves(256U, 256U, seed) };
+				auto const pairs{ Pairs(map, 32U, seed) };
+				for (uint32_t radius{ 0U }; radius <= 2U; ++radius) {
+					for (auto const& [start, goal] : pairs) {
+						if (!finder.Find(map.Width, map.Height, start, goal, map, Cost_Floor, path)) { return false; }
+						Carve(map, path, static_cast<int32_t>(radius));
+
+						Lumina::ConnectedComponents components{};
+						components.Label(map.Width, map.Height, [&map] (uint32_t x_, uint32_t y_) { return map.IsFloor(x_, y_); });
+						auto const label{ [&components] (Lumina::Int2 const& tile_) { return components(static_cast<uint32_t>(tile_.x), static_cast<uint32_t>(tile_.y)); } };
+						if (label(start) != label(goal)) { return false; }
+					}
+				}
+			}
+			return true;
+		});
+		suite_.Verify("Math/GridPath/Unreachable", [] () {
+			CaveMap map{ Caves(64U, 64U, 3U) };
+			// A ring no tunnel may cross, around the goal.
+			for (uint32_t i{ 20U }; i <= 40U; ++i) {
+				for (uint32_t const edge : { 20U, 40U }) {
+					map.Costs[edge * map.Width + i] = Infinity;
+					map.Costs[i * map.Width + edge] = Infinity;
+				}
+			}
+			Lumina::GridPathFinder finder{};
+			std::vector<Lumina::Int2> path{};
+			bool const isFound{ finder.Find(map.Width, map.Height, { 5, 5 }, { 30, 30 }, map, Cost_Floor, path) };
+			return !isFound && path.empty() && finder.Find(map.Width, map.Height, { 30, 30 }, { 35, 25 }, map, Cost_Floor, path);
+		});
+
+		//----	------	------	------	------	----//
+		//	Tunnels								//
+		//----	------	------	------	------	----//
+
+		// Average: 64 pairs of floor tiles taken in turn, each iteration joining one on a fresh copy of the map.
+		// Worst: corner to corner, across the whole map.
+		for (uint32_t const side : { 256U, 1024U }) {
+			auto const map{ std::make_shared<LazyMap>(side) };
+
+			suite_.Add(std::format("Math/GridPath/{0}x{0}/RandomWalk/Average", side), [map] (uint64_t num_Iterations_) {
+				CaveMap const& m{ map->Get() };
+				std::mt19937 rndGen{ 11U };
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					CaveMap copy{ m };
+					auto const& [start, goal]{ map->PairsToJoin[i % map->PairsToJoin.size()] };
+					DoNotOptimize(RandomWalk(copy, start, goal, rndGen));
+				}
+			});
+			suite_.Add(std::format("Math/GridPath/{0}x{0}/AStar/Average", side), [map] (uint64_t num_Iterations_) {
+				CaveMap const& m{ map->Get() };
+				Lumina::GridPathFinder finder{};
+				std::vector<Lumina::Int2> path{};
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					CaveMap copy{ m };
+					auto const& [start, goal]{ map->PairsToJoin[i % map->PairsToJoin.size()] };
+					finder.Find(copy.Width, copy.Height, start, goal, copy, Cost_Floor, path);
+					Carve(copy, path, 1);
+					DoNotOptimize(finder.Num_Expanded());
+				}
+			});
+
+			Lumina::Int2 const corner0{ 1, 1 };
+			Lumina::Int2 const corner1{ static_cast<int32_t>(side) - 2, static_cast<int32_t>(side) - 2 };
+			suite_.Add(std::format("Math/GridPath/{0}x{0}/RandomWalk/Worst", side), [map, corner0, corner1] (uint64_t num_Iterations_) {
+				CaveMap const& m{ map->Get() };
+				std::mt19937 rndGen{ 13U };
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					CaveMap copy{ m };
+					DoNotOptimize(RandomWalk(copy, corner0, corner1, rndGen));
+				}
+			});
+			suite_.Add(std::format("Math/GridPath/{0}x{0}/AStar/Worst", side), [map, corner0, corner1] (uint64_t num_Iterations_) {
+				CaveMap const& m{ map->Get() };
+				Lumina::GridPathFinder finder{};
+				std::vector<Lumina::Int2> path{};
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					CaveMap copy{ m };
+					finder.Find(copy.Width, copy.Height, corner0, corner1, copy, Cost_Floor, path);
+					Carve(copy, path, 1);
+					DoNotOptimize(finder.Num_Expanded());
+				}
+			});
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,334 @@
+module;
+
+#include<External/nlohmann.JSON/single_include/nlohmann/json.hpp>
+
+#if defined(_WIN32)
+#include<Windows.h>
+#include<intrin.h>
+#else
+#include<pthread.h>
+#include<sched.h>
+#endif
+
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+
+export module Benchmark.Harness;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <chrono>;
+
+import <vector>;
+import <algorithm>;
+import <numeric>;
+import <functional>;
+
+import <string>;
+import <format>;
+
+import <fstream>;
+import <iostream>;
+
+//////	//////	//////	//////	//////	//////
+
+export namespace Benchmark {
+	using JSON = nlohmann::json;
+
+	// Keeps the compiler from discarding a value that is computed only to be measured.
+	template<typename T>
+	inline void DoNotOptimize(T const& val_) noexcept {
+#if defined(_MSC_VER)
+		static_cast<void>(*reinterpret_cast<char const volatile*>(&val_));
+		::_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r,m"(val_) : "memory");
+#endif
+	}
+
+	// Body of a benchmark; runs the measured operation num_Iterations_ times.
+	using Body = std::function<void(uint64_t num_Iterations_)>;
+
+	// Correctness check that must hold before the numbers of the same area mean anything.
+	using Predicate = std::function<bool()>;
+
+	struct Case {
+		std::string Name;
+		Body Run;
+		// Optional payload size, used to report throughput.
+		uint64_t BytesPerIteration{ 0LLU };
+	};
+
+	struct Check {
+		std::string Name;
+		Predicate Run;
+	};
+
+	struct Statistics {
+		double Min;
+		double Median;
+		double Mean;
+		double P90;
+		double P99;
+		double Max;
+	};
+
+	struct Result {
+		std::string Name;
+		uint64_t IterationsPerSample;
+		uint64_t BytesPerIteration;
+		// Nanoseconds per iteration
+		Statistics NanosecondsPerIteration;
+	};
+
+	struct Options {
+		std::string Filter{};
+		std::string OutputPath{};
+		std::string BaselinePath{};
+
+		uint32_t Num_Warmups{ 3U };
+		uint32_t Num_Repetitions{ 31U };
+		std::chrono::nanoseconds MinSampleDuration{ std::chrono::milliseconds{ 2 } };
+		int32_t PinnedCPU{ 0 };
+
+		// Relative slowdown of the median beyond which a case is flagged as a regression.
+		double RegressionThreshold{ 0.10 };
+	};
+
+	//////	//////	//////	//////	//////	//////
+
+	class Suite {
+	public:
+		Suite& Add(std::string_view name_, Body&& body_, uint64_t bytesPerIteration_ = 0LLU) {
+			Cases_.emplace_back(std::string{ name_ }, std::move(body_), bytesPerIteration_);
+			return *this;
+		}
+
+		Suite& Verify(std::string_view name_, Predicate&& predicate_) {
+			Checks_.emplace_back(std::string{ name_ }, std::move(predicate_));
+			return *this;
+		}
+
+		std::vector<Result> Run(Options const& options_) const;
+		// Returns the number of failed checks.
+		uint32_t RunChecks(Options const& options_) const;
+
+		//====	======	======	======	======	====//
+
+	private:
+		std::vector<Case> Cases_{};
+		std::vector<Check> Checks_{};
+	};
+
+	//////	//////	//////	//////	//////	//////
+
+	bool PinCurrentThread(int32_t cpu_);
+
+	Statistics Summarize(std::vector<double>& samples_);
+
+	JSON ToJSON(std::vector<Result> const& results_, Options const& options_);
+	void Print(std::vector<Result> const& results_);
+
+	// Returns the number of regressions against the baseline file.
+	uint32_t Compare(std::vector<Result> const& results_, JSON const& baseline_, double threshold_);
+}
+
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark {
+	namespace {
+		using SteadyClock = std::chrono::steady_clock;
+
+		// Linear interpolation between the closest ranks of the sorted samples.
+		double Percentile(std::vector<double> const& sorted_, double p_) {
+			double const rank{ p_ * static_cast<double>(sorted_.size() - 1LLU) };
+			size_t const idx_Lower{ static_cast<size_t>(rank) };
+			size_t const idx_Upper{ std::min<size_t>(idx_Lower + 1LLU, sorted_.size() - 1LLU) };
+			double const t{ rank - static_cast<double>(idx_Lower) };
+			return sorted_[idx_Lower] * (1.0 - t) + sorted_[idx_Upper] * t;
+		}
+
+		double TimeSample(Case const& case_, uint64_t num_Iterations_) {
+			auto const timePoint_Start{ SteadyClock::now() };
+			case_.Run(num_Iterations_);
+			auto const timePoint_End{ SteadyClock::now() };
+			return static_cast<double>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(timePoint_End - timePoint_Start).count()
+			);
+		}
+
+		// Doubles the iteration count until one sample takes at least the minimum duration,
+		// so that timer resolution does not dominate short operations.
+		uint64_t Calibrate(Case const& case_, std::chrono::nanoseconds minSampleDuration_) {
+			double const minDuration{ static_cast<double>(minSampleDuration_.count()) };
+			uint64_t num_Iterations{ 1LLU };
+			while (num_Iterations < (1LLU << 40U)) {
+				double const elapsed{ TimeSample(case_, num_Iterations) };
+				if (elapsed >= minDuration) { break; }
+				// Jumps straight to the estimated count once the measurement is meaningful.
+				num_Iterations = (elapsed > minDuration * 0.01) ?
+					std::max<uint64_t>(num_Iterations + 1LLU, static_cast<uint64_t>(num_Iterations * (minDuration * 1.2 / elapsed))) :
+					(num_Iterations << 1U);
+			}
+			return num_Iterations;
+		}
+
+		bool MatchesFilter(std::string_view name_, std::string_view filter_) {
+			return filter_.empty() || (name_.find(filter_) != std::string_view::npos);
+		}
+	}
+
+	//////	//////	//////	//////	//////	//////
+
+	bool PinCurrentThread(int32_t cpu_) {
+		if (cpu_ < 0) { return false; }
+#if defined(_WIN32)
+		::SetThreadPriority(::GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+		return (::SetThreadAffinityMask(::GetCurrentThread(), DWORD_PTR{ 1 } << cpu_) != 0);
+#else
+		cpu_set_t cpuSet{};
+		CPU_ZERO(&cpuSet);
+		CPU_SET(cpu_, &cpuSet);
+		return (::pthread_setaffinity_np(::pthread_self(), sizeof(cpu_set_t), &cpuSet) == 0);
+#endif
+	}
+
+	Statistics Summarize(std::vector<double>& samples_) {
+		std::sort(samples_.begin(), samples_.end());
+		return Statistics{
+			.Min{ samples_.front() },
+			.Median{ Percentile(samples_, 0.5) },
+			.Mean{ std::reduce(samples_.cbegin(), samples_.cend()) / static_cast<double>(samples_.size()) },
+			.P90{ Percentile(samples_, 0.9) },
+			.P99{ Percentile(samples_, 0.99) },
+			.Max{ samples_.back() },
+		};
+	}
+
+	std::vector<Result> Suite::Run(Options const& options_) const {
+		std::vector<Result> results{};
+		std::vector<double> samples{};
+		samples.reserve(options_.Num_Repetitions);
+
+		for (auto const& benchmarkCase : Cases_) {
+			if (!MatchesFilter(benchmarkCase.Name, options_.Filter)) { continue; }
+
+			uint64_t const num_Iterations{ Calibrate(benchmarkCase, options_.MinSampleDuration) };
+			for (uint32_t i_Warmup{ 0U }; i_Warmup < options_.Num_Warmups; ++i_Warmup) {
+				TimeSample(benchmarkCase, num_Iterations);
+			}
+
+			samples.clear();
+			double const inv_Iterations{ 1.0 / static_cast<double>(num_Iterations) };
+			for (uint32_t i_Rep{ 0U }; i_Rep < std::max<uint32_t>(options_.Num_Repetitions, 1U); ++i_Rep) {
+				samples.emplace_back(TimeSample(benchmarkCase, num_Iterations) * inv_Iterations);
+			}
+
+			results.emplace_back(
+				benchmarkCase.Name,
+				num_Iterations,
+				benchmarkCase.BytesPerIteration,
+				Summarize(samples)
+			);
+		}
+
+		return results;
+	}
+
+	uint32_t Suite::RunChecks(Options const& options_) const {
+		uint32_t num_Failures{ 0U };
+		for (auto const& check : Checks_) {
+			if (!MatchesFilter(check.Name, options_.Filter)) { continue; }
+			if (!check.Run()) {
+				std::cerr << std::format("Check failed: {}\n", check.Name);
+				++num_Failures;
+			}
+		}
+		return num_Failures;
+	}
+
+	JSON ToJSON(std::vector<Result> const& results_, Options const& options_) {
+		JSON json{};
+		json["context"] = {
+			{ "warmups", options_.Num_Warmups },
+			{ "repetitions", options_.Num_Repetitions },
+			{ "min_sample_ns", options_.MinSampleDuration.count() },
+			{ "pinned_cpu", options_.PinnedCPU },
+		};
+		json["benchmarks"] = JSON::array();
+		for (auto const& result : results_) {
+			auto const& stats{ result.NanosecondsPerIteration };
+			json["benchmarks"].push_back({
+				{ "name", result.Name },
+				{ "iterations", result.IterationsPerSample },
+				{ "bytes_per_iteration", result.BytesPerIteration },
+				{ "ns_per_iteration", {
+					{ "min", stats.Min },
+					{ "median", stats.Median },
+					{ "mean", stats.Mean },
+					{ "p90", stats.P90 },
+					{ "p99", stats.P99 },
+					{ "max", stats.Max },
+				} },
+			});
+		}
+		return json;
+	}
+
+	void Print(std::vector<Result> const& results_) {
+		std::cout << std::format(
+			"{:<48} {:>12} {:>12} {:>12} {:>12} {:>10}\n",
+			"Benchmark", "Median(ns)", "P90(ns)", "P99(ns)", "Min(ns)", "MB/s"
+		);
+		for (auto const& result : results_) {
+			auto const& stats{ result.NanosecondsPerIteration };
+			double const throughput{
+				(result.BytesPerIteration > 0LLU) ?
+				(static_cast<double>(result.BytesPerIteration) * 1000.0 / stats.Median) :
+				(0.0)
+			};
+			std::cout << std::format(
+				"{:<48} {:>12.2f} {:>12.2f} {:>12.2f} {:>12.2f} {:>10.1f}\n",
+				result.Name, stats.Median, stats.P90, stats.P99, stats.Min, throughput
+			);
+		}
+	}
+
+	uint32_t Compare(std::vector<Result> const& results_, JSON const& baseline_, double threshold_) {
+		uint32_t num_Regressions{ 0U };
+
+		std::cout << std::format("\n{:<48} {:>12} {:>12} {:>9}\n", "Benchmark", "Base(ns)", "Now(ns)", "Delta");
+		for (auto const& result : results_) {
+			auto const it_Baseline{
+				std::find_if(
+					baseline_.at("benchmarks").cbegin(),
+					baseline_.at("benchmarks").cend(),
+					[&result](JSON const& entry_) { return entry_.at("name") == result.Name; }
+				)
+			};
+			if (it_Baseline == baseline_.at("benchmarks").cend()) {
+				std::cout << std::format("{:<48} {:>12} {:>12.2f} {:>9}\n", result.Name, "-", result.NanosecondsPerIteration.Median, "new");
+				continue;
+			}
+
+			double const median_Baseline{ it_Baseline->at("ns_per_iteration").at("median").get<double>() };
+			double const median_Current{ result.NanosecondsPerIteration.Median };
+			double const delta{ median_Current / median_Baseline - 1.0 };
+			bool const isRegression{ delta > threshold_ };
+			num_Regressions += isRegression;
+
+			std::cout << std::format(
+				"{:<48} {:>12.2f} {:>12.2f} {:>+8.1f}%{}\n",
+				result.Name, median_Baseline, median_Current, delta * 100.0,
+				isRegression ? "  <-- REGRESSION" : ""
+			);
+		}
+
+		return num_Regressions;
+	}
+}
\ No newline at end of file
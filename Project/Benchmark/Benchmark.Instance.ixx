@@ -0,0 +1,153 @@
+export module Benchmark.Instance;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <cmath>;
+import <cstring>;
+import <numbers>;
+import <random>;
+
+import <vector>;
+import <algorithm>;
+
+import Benchmark.Harness;
+
+import Lumina.Math.Vector;
+import Lumina.Math.Matrix;
+
+import Game.InstanceRecord;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::Instance {
+	namespace {
+		// Same capacity as the bullet managers in Scene_InGame.
+		constexpr uint32_t Num_Instances{ 4096U };
+
+		struct Sprite {
+			Lumina::Vec3 Position;
+			Lumina::Vec3 Rotate;
+			float Scale;
+			uint32_t Element;
+			int32_t Life;
+		};
+
+		// Per-instance record the bullet managers uploaded before Game.InstanceRecord.
+		struct Mat4Record {
+			float Transform[4][4];
+			uint32_t ElementType;
+			float Opacity;
+		};
+
+		std::vector<Sprite> RandomSprites(std::mt19937& rndGen_) {
+			// Covers the whole 128x64-block map, and rotations accumulated over many frames.
+			std::uniform_real_distribution<float> distX{ 0.0f, 256.0f };
+			std::uniform_real_distribution<float> distY{ 0.0f, 128.0f };
+			std::uniform_real_distribution<float> distAngle{ -64.0f, 64.0f };
+			std::uniform_real_distribution<float> distScale{ 0.05f, 2.0f };
+			std::vector<Sprite> sprites(Num_Instances);
+			for (auto& sprite : sprites) {
+				sprite.Position = { distX(rndGen_), distY(rndGen_), 0.0f };
+				sprite.Rotate = { distAngle(rndGen_), distAngle(rndGen_), distAngle(rndGen_) };
+				sprite.Scale = distScale(rndGen_);
+				sprite.Element = rndGen_() % 6U;
+				sprite.Life = static_cast<int32_t>(rndGen_() % 181U);
+			}
+			return sprites;
+		}
+
+		// Half-floats keep 11 significant bits, so rounding is off by at most 2^-11 relative.
+		bool WithinHalfPrecision(float original_, float decoded_) {
+			return std::abs(decoded_ - original_) <= std::max(std::abs(original_) * 0.00048828125f, 1.0e-7f);
+		}
+
+		// Compares angles modulo a full turn; one step of the 16-bit encoding is 2pi / 65536.
+		bool WithinAngleStep(float original_, float decoded_) {
+			float const twoPi{ 2.0f * std::numbers::pi_v<float> };
+			float const diff{ std::remainder(decoded_ - original_, twoPi) };
+			// Half a step, plus the float error of wrapping angles of up to 64 rad.
+			return std::abs(diff) <= std::numbers::pi_v<float> / 65536.0f + 1.0e-5f;
+		}
+	}
+
+	export void Register(Suite& suite_) {
+		std::mt19937 rndGen{ 0x4C554D49U };
+
+		auto const sprites{ RandomSprites(rndGen) };
+
+		//----	------	------	------	------	----//
+		//	Round trip							//
+		//----	------	------	------	------	----//
+
+		suite_.Verify("Instance/RoundTrip/PositionScale", [sprites] () {
+			for (auto const& sprite : sprites) {
+				auto const state{
+					Game::Decode(Game::Encode(sprite.Position, sprite.Rotate, sprite.Scale, sprite.Element, static_cast<uint32_t>(sprite.Life)))
+				};
+				if (!WithinHalfPrecision(sprite.Position.x, state.Position.x) ||
+					!WithinHalfPrecision(sprite.Position.y, state.Position.y) ||
+					!WithinHalfPrecision(sprite.Scale, state.Scale)) {
+					return false;
+				}
+			}
+			return true;
+		});
+		suite_.Verify("Instance/RoundTrip/Angle", [sprites] () {
+			for (auto const& sprite : sprites) {
+				auto const state{
+					Game::Decode(Game::Encode(sprite.Position, sprite.Rotate, sprite.Scale, sprite.Element, static_cast<uint32_t>(sprite.Life)))
+				};
+				for (uint32_t i_Axis{ 0U }; i_Axis < 3U; ++i_Axis) {
+					if (!WithinAngleStep(sprite.Rotate[i_Axis], state.Rotate[i_Axis])) { return false; }
+				}
+			}
+			return true;
+		});
+		suite_.Verify("Instance/RoundTrip/ElementLife", [sprites] () {
+			for (auto const& sprite : sprites) {
+				auto const state{
+					Game::Decode(Game::Encode(sprite.Position, sprite.Rotate, sprite.Scale, sprite.Element, static_cast<uint32_t>(sprite.Life)))
+				};
+				if (state.Element != sprite.Element || state.Life != static_cast<uint32_t>(sprite.Life)) { return false; }
+			}
+			// Lives beyond 24 bits saturate rather than wrap into the element byte.
+			auto const state{ Game::Decode(Game::Encode({}, {}, 1.0f, 5U, 0xFFFFFFFFU)) };
+			return (state.Element == 5U) && (state.Life == 0xFFFFFFU);
+		});
+
+		//----	------	------	------	------	----//
+		//	Packing								//
+		//----	------	------	------	------	----//
+
+		// Per frame: what the bullet managers wrote for 4096 bullets, before and after.
+		suite_.Add("Instance/Mat4Record/Pack4096", [sprites, records = std::vector<Mat4Record>(Num_Instances)] (uint64_t num_Iterations_) mutable {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				for (uint32_t idx{ 0U }; idx < Num_Instances; ++idx) {
+					auto const& sprite{ sprites[idx] };
+					auto&& srt{
+						Lumina::Mat4::SRT(
+							{ sprite.Scale, sprite.Scale, sprite.Scale },
+							sprite.Rotate,
+							sprite.Position
+						)
+					};
+					std::memcpy(&records[idx].Transform, &srt, sizeof(Lumina::Mat4));
+					records[idx].ElementType = sprite.Element;
+					records[idx].Opacity = static_cast<float>(sprite.Life) / 180.0f;
+				}
+				DoNotOptimize(records[0]);
+			}
+		}, sizeof(Mat4Record) * Num_Instances);
+		suite_.Add("Instance/CompactRecord/Pack4096", [sprites, records = std::vector<Game::InstanceRecord>(Num_Instances)] (uint64_t num_Iterations_) mutable {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				for (uint32_t idx{ 0U }; idx < Num_Instances; ++idx) {
+					auto const& sprite{ sprites[idx] };
+					records[idx] = Game::Encode(sprite.Position, sprite.Rotate, sprite.Scale, sprite.Element, static_cast<uint32_t>(sprite.Life));
+				}
+				DoNotOptimize(records[0]);
+			}
+		}, sizeof(Game::InstanceRecord) * Num_Instances);
+	}
+}
\ No newline at end of file
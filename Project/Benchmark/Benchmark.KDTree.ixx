@@ -0,0 +1,218 @@
+export module Benchmark.KDTree;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <random>;
+import <memory>;
+import <string>;
+import <format>;
+
+import <vector>;
+import <algorithm>;
+
+import Benchmark.Harness;
+
+import Lumina.Math.Vector;
+import Lumina.Math.KDTree;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::KDTree {
+	namespace {
+		constexpr uint32_t Num_Queries{ 10000U };
+		constexpr uint32_t K{ 8U };
+		// About 8 hits per query for 1M points in 2D; far fewer in 3D and at the smaller sizes.
+		constexpr float QueryRadius{ 0.18f };
+
+		template<uint32_t N_Dims>
+		using Point = typename Lumina::KDTree<N_Dims>::Point;
+
+		// Uniform over [0, 100)^N, with a dense cluster in one corner so that the split axes are not all alike.
+		template<uint32_t N_Dims>
+		std::vector<Point<N_Dims>> RandomPoints(uint32_t num_, std::mt19937& rndGen_) {
+			std::uniform_real_distribution<float> dist_Uniform{ 0.0f, 100.0f };
+			std::normal_distribution<float> dist_Cluster{ 10.0f, 2.0f };
+			std::vector<Point<N_Dims>> points(num_);
+			for (uint32_t i{ 0U }; i < num_; ++i) {
+				for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+					points[i][idx_Dim] = (i & 3U) ? dist_Uniform(rndGen_) : dist_Cluster(rndGen_);
+				}
+			}
+			return points;
+		}
+
+		template<uint32_t N_Dims>
+		float Distance2(Point<N_Dims> const& lhs_, Point<N_Dims> const& rhs_) {
+			float dist2{ 0.0f };
+			for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+				float const d{ lhs_[idx_Dim] - rhs_[idx_Dim] };
+				dist2 += d * d;
+			}
+			return dist2;
+		}
+
+		// Compares distances rather than indices, since equidistant points may come back in either order.
+		template<uint32_t N_Dims>
+		bool MatchesBruteForce(uint32_t num_Points_, uint32_t seed_) {
+			std::mt19937 rndGen{ seed_ };
+			auto const points{ RandomPoints<N_Dims>(num_Points_, rndGen) };
+			auto const queries{ RandomPoints<N_Dims>(256U, rndGen) };
+			Lumina::KDTree<N_Dims> tree{};
+			tree.Build(points);
+
+			std::vector<uint32_t> indices_Nearest{};
+			std::vector<uint32_t> indices_KNearest{};
+			std::vector<float> dist2s_KNearest{};
+			std::vector<uint32_t> offsets_Radius{};
+			std::vector<uint32_t> indices_Radius{};
+			float const radius{ 8.0f };
+			tree.Nearest(queries, indices_Nearest);
+			tree.KNearest(queries, K, indices_KNearest, dist2s_KNearest);
+			tree.InRadius(queries, radius, offsets_Radius, indices_Radius);
+
+			std::vector<float> dist2s(num_Points_);
+			for (size_t idx_Query{ 0LLU }; idx_Query < queries.size(); ++idx_Query) {
+				for (uint32_t i{ 0U }; i < num_Points_; ++i) {
+					dist2s[i] = Distance2<N_Dims>(queries[idx_Query], points[i]);
+				}
+				uint32_t const num_Radius{
+					static_cast<uint32_t>(std::count_if(dist2s.cbegin(), dist2s.cend(), [radius] (float dist2_) { return dist2_ <= radius * radius; }))
+				};
+				std::sort(dist2s.begin(), dist2s.end());
+
+				uint32_t const idx_Nearest{ indices_Nearest[idx_Query] };
+				if (num_Points_ == 0U) {
+					if (idx_Nearest != Lumina::KDTree<N_Dims>::Invalid) { return false; }
+					continue;
+				}
+				if (Distance2<N_Dims>(queries[idx_Query], points[idx_Nearest]) != dist2s[0]) { return false; }
+
+				for (uint32_t i{ 0U }; i < K; ++i) {
+					uint32_t const idx{ indices_KNearest[idx_Query * K + i] };
+					if (i >= num_Points_) {
+						if (idx != Lumina::KDTree<N_Dims>::Invalid) { return false; }
+						continue;
+					}
+					if (dist2s_KNearest[idx_Query * K + i] != dist2s[i]) { return false; }
+					if (Distance2<N_Dims>(queries[idx_Query], points[idx]) != dist2s[i]) { return false; }
+				}
+
+				if (offsets_Radius[idx_Query + 1LLU] - offsets_Radius[idx_Query] != num_Radius) { return false; }
+				for (uint32_t i{ offsets_Radius[idx_Query] }; i < offsets_Radius[idx_Query + 1LLU]; ++i) {
+					if (Distance2<N_Dims>(queries[idx_Query], points[indices_Radius[i]]) > radius * radius) { return false; }
+				}
+			}
+			return true;
+		}
+
+		template<uint32_t N_Dims>
+		void RegisterSize(Suite& suite_, uint32_t num_Points_, std::mt19937& rndGen_) {
+			auto const points{ std::make_shared<std::vector<Point<N_Dims>>>(RandomPoints<N_Dims>(num_Points_, rndGen_)) };
+			auto const queries{ std::make_shared<std::vector<Point<N_Dims>>>(RandomPoints<N_Dims>(Num_Queries, rndGen_)) };
+			auto const tree{ std::make_shared<Lumina::KDTree<N_Dims>>() };
+			tree->Build(*points);
+
+			// Every point drifts a little, as objects do from one frame to the next.
+			auto const moved{ std::make_shared<std::vector<Point<N_Dims>>>(*points) };
+			for (auto& point : *moved) {
+				point[0] += 0.05f;
+			}
+
+			std::string const prefix{ std::format("Math/KDTree/{}D/{}", N_Dims, num_Points_) };
+
+			suite_.Add(prefix + "/Build", [points] (uint64_t num_Iterations_) {
+				Lumina::KDTree<N_Dims> tree{};
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					tree.Build(*points);
+					DoNotOptimize(tree);
+				}
+			}, sizeof(Point<N_Dims>) * num_Points_);
+			suite_.Add(prefix + "/Rebuild", [points, moved] (uint64_t num_Iterations_) {
+				Lumina::KDTree<N_Dims> tree{};
+				tree.Build(*points);
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					tree.Rebuild((i & 1LLU) ? *points : *moved);
+					DoNotOptimize(tree);
+				}
+			}, sizeof(Point<N_Dims>) * num_Points_);
+			suite_.Add(prefix + "/Nearest10k", [tree, queries] (uint64_t num_Iterations_) {
+				std::vector<uint32_t> indices{};
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					tree->Nearest(*queries, indices);
+					DoNotOptimize(indices.data());
+				}
+			});
+			suite_.Add(prefix + "/KNearest10k", [tree, queries] (uint64_t num_Iterations_) {
+				std::vector<uint32_t> indices{};
+				std::vector<float> dist2s{};
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					tree->KNearest(*queries, K, indices, dist2s);
+					DoNotOptimize(indices.data());
+				}
+			});
+			suite_.Add(prefix + "/InRadius10k", [tree, queries] (uint64_t num_Iterations_) {
+				std::vector<uint32_t> offsets{};
+				std::vector<uint32_t> indices{};
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					tree->InRadius(*queries, QueryRadius, offsets, indices);
+					DoNotOptimize(indices.data());
+				}
+			});
+		}
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		// Sizes around LeafSize exercise the linear-scan path and ranges that split unevenly.
+		suite_.Verify("Math/KDTree/2D/BruteForce", [] () {
+			for (uint32_t const num_Points : { 0U, 1U, 7U, 8U, 9U, 17U, 1000U, 4099U }) {
+				if (!MatchesBruteForce<2U>(num_Points, num_Points + 1U)) { return false; }
+			}
+			return true;
+		});
+		suite_.Verify("Math/KDTree/3D/BruteForce", [] () {
+			for (uint32_t const num_Points : { 0U, 1U, 7U, 8U, 9U, 17U, 1000U, 4099U }) {
+				if (!MatchesBruteForce<3U>(num_Points, num_Points + 2U)) { return false; }
+			}
+			return true;
+		});
+		suite_.Verify("Math/KDTree/Rebuild", [] () {
+			std::mt19937 rndGen{ 3U };
+			auto points{ RandomPoints<2U>(1000U, rndGen) };
+			Lumina::KDTree<2U> tree_Rebuilt{};
+			tree_Rebuilt.Build(points);
+			for (auto& point : points) {
+				point.y = 100.0f - point.y;
+			}
+			tree_Rebuilt.Rebuild(points);
+			Lumina::KDTree<2U> tree_Built{};
+			tree_Built.Build(points);
+
+			auto const queries{ RandomPoints<2U>(256U, rndGen) };
+			for (auto const& query : queries) {
+				if (
+					Distance2<2U>(query, points[tree_Rebuilt.Nearest(query)]) !=
+					Distance2<2U>(query, points[tree_Built.Nearest(query)])
+				) {
+					return false;
+				}
+			}
+			return true;
+		});
+
+		//----	------	------	------	------	----//
+		//	Build and query						//
+		//----	------	------	------	------	----//
+
+		std::mt19937 rndGen{ 0x4C554D49U };
+		for (uint32_t const num_Points : { 10000U, 100000U, 1000000U }) {
+			RegisterSize<2U>(suite_, num_Points, rndGen);
+			RegisterSize<3U>(suite_, num_Points, rndGen);
+		}
+	}
+}
\ No newline at end of file
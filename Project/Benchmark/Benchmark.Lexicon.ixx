@@ -0,0 +1,212 @@
+export module Benchmark.Lexicon;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <random>;
+import <memory>;
+import <string>;
+import <string_view>;
+import <functional>;
+
+import <vector>;
+import <unordered_map>;
+import <algorithm>;
+
+import Benchmark.Harness;
+
+import Lumina.Container.Lexicon;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::Lexicon {
+	namespace {
+		// Editor::Lexicon before the perfect hash: a scan comparing std::hash values, and nothing else.
+		template<typename T>
+		class LinearLexicon {
+			struct Entry {
+				std::string Lexis;
+				size_t HashValue_Lexis;
+				T Content;
+			};
+
+		public:
+			T Find(std::string_view lexis_) const {
+				size_t hashVal{ std::hash<std::string_view>{}(lexis_) };
+				for (auto const& entry : Entries_) {
+					if (hashVal == entry.HashValue_Lexis) {
+						return entry.Content;
+					}
+				}
+				return T{};
+			}
+
+		public:
+			template<size_t N>
+			explicit LinearLexicon(Lumina::Lexicon<T, N> const& lexicon_) {
+				for (int i{ 0 }; i < static_cast<int>(N); ++i) {
+					Entries_.emplace_back(std::string{ lexicon_.Lexis(i) }, std::hash<std::string_view>{}(lexicon_.Lexis(i)), lexicon_.Content(i));
+				}
+			}
+
+		private:
+			std::vector<Entry> Entries_{};
+		};
+
+		// The DX12 loaders before the perfect hash: std::unordered_map<std::string, T>::at, with a std::string built per lookup.
+		template<typename T, size_t N>
+		std::unordered_map<std::string, T> ToUnorderedMap(Lumina::Lexicon<T, N> const& lexicon_) {
+			std::unordered_map<std::string, T> map{};
+			for (int i{ 0 }; i < static_cast<int>(N); ++i) { map.emplace(lexicon_.Lexis(i), lexicon_.Content(i)); }
+			return map;
+		}
+
+		//----	------	------	------	------	----//
+
+		// The lexes of DX12.Aux's root parameter and input element sections.
+		constexpr auto RootParameterTypes{ Lumina::MakeLexicon<uint32_t>({
+			{ "DescriptorTable", 0U },
+			{ "32BitConstants", 1U },
+			{ "CBV", 2U },
+			{ "SRV", 3U },
+			{ "UAV", 4U },
+		}) };
+		constexpr auto InputElementFormats{ Lumina::MakeLexicon<uint32_t>({
+			{ "float2", 16U },
+			{ "float3", 6U },
+			{ "float4", 2U },
+			{ "uint", 42U },
+			{ "uint2", 17U },
+			{ "uint3", 7U },
+		}) };
+
+		// The full D3D12_FILTER enumerator names, as a setup spelling filters out would use; the size at which a scan starts to show.
+		constexpr auto Filters{ Lumina::MakeLexicon<uint32_t>({
+			{ "D3D12_FILTER_MIN_MAG_MIP_POINT", 0x00U },
+			{ "D3D12_FILTER_MIN_MAG_POINT_MIP_LINEAR", 0x01U },
+			{ "D3D12_FILTER_MIN_POINT_MAG_LINEAR_MIP_POINT", 0x04U },
+			{ "D3D12_FILTER_MIN_POINT_MAG_MIP_LINEAR", 0x05U },
+			{ "D3D12_FILTER_MIN_LINEAR_MAG_MIP_POINT", 0x10U },
+			{ "D3D12_FILTER_MIN_LINEAR_MAG_POINT_MIP_LINEAR", 0x11U },
+			{ "D3D12_FILTER_MIN_MAG_LINEAR_MIP_POINT", 0x14U },
+			{ "D3D12_FILTER_MIN_MAG_MIP_LINEAR", 0x15U },
+			{ "D3D12_FILTER_ANISOTROPIC", 0x55U },
+			{ "D3D12_FILTER_COMPARISON_MIN_MAG_MIP_POINT", 0x80U },
+			{ "D3D12_FILTER_COMPARISON_MIN_MAG_POINT_MIP_LINEAR", 0x81U },
+			{ "D3D12_FILTER_COMPARISON_MIN_POINT_MAG_LINEAR_MIP_POINT", 0x84U },
+			{ "D3D12_FILTER_COMPARISON_MIN_POINT_MAG_MIP_LINEAR", 0x85U },
+			{ "D3D12_FILTER_COMPARISON_MIN_LINEAR_MAG_MIP_POINT", 0x90U },
+			{ "D3D12_FILTER_COMPARISON_MIN_LINEAR_MAG_POINT_MIP_LINEAR", 0x91U },
+			{ "D3D12_FILTER_COMPARISON_MIN_MAG_LINEAR_MIP_POINT", 0x94U },
+			{ "D3D12_FILTER_COMPARISON_MIN_MAG_MIP_LINEAR", 0x95U },
+			{ "D3D12_FILTER_COMPARISON_ANISOTROPIC", 0xD5U },
+			{ "D3D12_FILTER_MINIMUM_MIN_MAG_MIP_POINT", 0x100U },
+			{ "D3D12_FILTER_MINIMUM_MIN_MAG_POINT_MIP_LINEAR", 0x101U },
+			{ "D3D12_FILTER_MINIMUM_MIN_POINT_MAG_LINEAR_MIP_POINT", 0x104U },
+			{ "D3D12_FILTER_MINIMUM_MIN_POINT_MAG_MIP_LINEAR", 0x105U },
+			{ "D3D12_FILTER_MINIMUM_MIN_LINEAR_MAG_MIP_POINT", 0x110U },
+			{ "D3D12_FILTER_MINIMUM_MIN_LINEAR_MAG_POINT_MIP_LINEAR", 0x111U },
+			{ "D3D12_FILTER_MINIMUM_MIN_MAG_LINEAR_MIP_POINT", 0x114U },
+			{ "D3D12_FILTER_MINIMUM_MIN_MAG_MIP_LINEAR", 0x115U },
+			{ "D3D12_FILTER_MINIMUM_ANISOTROPIC", 0x155U },
+			{ "D3D12_FILTER_MAXIMUM_MIN_MAG_MIP_POINT", 0x180U },
+			{ "D3D12_FILTER_MAXIMUM_MIN_MAG_POINT_MIP_LINEAR", 0x181U },
+			{ "D3D12_FILTER_MAXIMUM_MIN_POINT_MAG_LINEAR_MIP_POINT", 0x184U },
+			{ "D3D12_FILTER_MAXIMUM_MIN_POINT_MAG_MIP_LINEAR", 0x185U },
+			{ "D3D12_FILTER_MAXIMUM_MIN_LINEAR_MAG_MIP_POINT", 0x190U },
+			{ "D3D12_FILTER_MAXIMUM_MIN_LINEAR_MAG_POINT_MIP_LINEAR", 0x191U },
+			{ "D3D12_FILTER_MAXIMUM_MIN_MAG_LINEAR_MIP_POINT", 0x194U },
+			{ "D3D12_FILTER_MAXIMUM_MIN_MAG_MIP_LINEAR", 0x195U },
+			{ "D3D12_FILTER_MAXIMUM_ANISOTROPIC", 0x1D5U },
+		}) };
+
+		template<size_t N>
+		bool RoundTrips(Lumina::Lexicon<uint32_t, N> const& lexicon_) {
+			for (int i{ 0 }; i < static_cast<int>(N); ++i) {
+				uint32_t const* const content{ lexicon_.TryFind(lexicon_.Lexis(i)) };
+				if (content == nullptr || *content != lexicon_.Content(i) || lexicon_.Find(*content) != lexicon_.Lexis(i)) { return false; }
+			}
+			return true;
+		}
+
+		// Near misses must come back empty rather than as whichever entry their slot holds.
+		template<size_t N>
+		bool RejectsAbsent(Lumina::Lexicon<uint32_t, N> const& lexicon_) {
+			for (int i{ 0 }; i < static_cast<int>(N); ++i) {
+				std::string_view const lexis{ lexicon_.Lexis(i) };
+				std::string const variants[]{ std::string{ lexis } + "_", std::string{ lexis.substr(1LLU) }, std::string{ lexis.substr(0LLU, lexis.size() - 1LLU) }, "" };
+				for (auto const& variant : variants) {
+					// Some variants are entries of their own ("uint2" cut short is "uint").
+					uint32_t const* const content{ lexicon_.TryFind(variant) };
+					if (content != nullptr && lexicon_.Find(*content) != variant) { return false; }
+				}
+			}
+			return true;
+		}
+
+		// Every lexis about equally often, in a random order, as a folder of PSO setups would ask for them.
+		template<size_t N>
+		std::vector<std::string> Queries(Lumina::Lexicon<uint32_t, N> const& lexicon_, uint32_t num_) {
+			std::mt19937 rndGen{ 0x4C554D49U };
+			std::vector<std::string> queries(num_);
+			for (auto& query : queries) { query = lexicon_.Lexis(static_cast<int>(rndGen() % N)); }
+			return queries;
+		}
+
+		template<size_t N>
+		void RegisterLookup(Suite& suite_, std::string_view name_, Lumina::Lexicon<uint32_t, N> const& lexicon_) {
+			auto const queries{ std::make_shared<std::vector<std::string>>(Queries(lexicon_, 4096U)) };
+			auto const linear{ std::make_shared<LinearLexicon<uint32_t>>(lexicon_) };
+			auto const map{ std::make_shared<std::unordered_map<std::string, uint32_t>>(ToUnorderedMap(lexicon_)) };
+
+			suite_.Add(std::string{ name_ } + "/LinearScan", [queries, linear] (uint64_t num_Iterations_) {
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					uint32_t sum{ 0U };
+					for (auto const& query : *queries) { sum += linear->Find(query); }
+					DoNotOptimize(sum);
+				}
+			});
+			suite_.Add(std::string{ name_ } + "/unordered_map", [queries, map] (uint64_t num_Iterations_) {
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					uint32_t sum{ 0U };
+					for (std::string_view const query : *queries) { sum += map->at(query.data()); }
+					DoNotOptimize(sum);
+				}
+			});
+			suite_.Add(std::string{ name_ } + "/PerfectHash", [queries, &lexicon_] (uint64_t num_Iterations_) {
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					uint32_t sum{ 0U };
+					for (auto const& query : *queries) { sum += lexicon_.Find(query); }
+					DoNotOptimize(sum);
+				}
+			});
+		}
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		suite_.Verify("Container/Lexicon/RoundTrip", [] () {
+			return RoundTrips(RootParameterTypes) && RoundTrips(InputElementFormats) && RoundTrips(Filters);
+		});
+		suite_.Verify("Container/Lexicon/RejectsAbsent", [] () {
+			return RejectsAbsent(RootParameterTypes) && RejectsAbsent(InputElementFormats) && RejectsAbsent(Filters);
+		});
+		suite_.Verify("Container/Lexicon/MatchesLinearScan", [] () {
+			LinearLexicon<uint32_t> const linear{ Filters };
+			auto const queries{ Queries(Filters, 1024U) };
+			return std::all_of(queries.cbegin(), queries.cend(), [&] (std::string const& query_) { return linear.Find(query_) == Filters.Find(query_); });
+		});
+
+		//----	------	------	------	------	----//
+		//	Lookups								//
+		//----	------	------	------	------	----//
+
+		RegisterLookup(suite_, "Container/Lexicon/RootParameterType", RootParameterTypes);
+		RegisterLookup(suite_, "Container/Lexicon/InputElementFormat", InputElementFormats);
+		RegisterLookup(suite_, "Container/Lexicon/D3D12Filter", Filters);
+	}
+}
\ No newline at end of file
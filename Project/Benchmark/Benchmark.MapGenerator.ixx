@@ -0,0 +1,182 @@
+export module Benchmark.MapGenerator;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <memory>;
+import <filesystem>;
+
+import <vector>;
+import <utility>;
+
+import <string>;
+import <format>;
+
+import Benchmark.Harness;
+
+import Game.MapGenerator;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::MapGenerator {
+	namespace {
+		using Game::CellularAutomata;
+		using Game::MapGenParams;
+
+		// All a run leaves behind, to be compared whole.
+		struct Snapshot {
+			std::vector<std::vector<int>> Map{};
+			std::vector<std::vector<std::pair<int32_t, int32_t>>> Caves{};
+			std::vector<std::pair<int32_t, int32_t>> Features{};
+			uint32_t Length_Tunnels{ 0U };
+
+			bool operator==(Snapshot const&) const = default;
+		};
+
+		Snapshot Take(CellularAutomata& generator_) {
+			Snapshot snapshot{};
+			generator_.GetMap(snapshot.Map);
+			for (auto const& cave : generator_.GetCaves()) {
+				auto& tiles{ snapshot.Caves.emplace_back() };
+				for (auto const& tile : cave) { tiles.emplace_back(tile.x, tile.y); }
+			}
+			for (auto const& feature : generator_.GetFeatures()) { snapshot.Features.emplace_back(feature.x, feature.y); }
+			snapshot.Length_Tunnels = generator_.GetTunnelLength();
+			return snapshot;
+		}
+
+		Snapshot Generate(MapGenParams const& params_) {
+			CellularAutomata generator{};
+			generator.Run(params_);
+			return Take(generator);
+		}
+
+		// A directory of its own under the system's temporary one, emptied on the way in and out.
+		struct ScratchDirectory {
+			explicit ScratchDirectory(std::string_view name_) :
+				Path{ (std::filesystem::temp_directory_path() / name_).string() } {
+				std::error_code error{};
+				std::filesystem::remove_all(Path, error);
+			}
+			~ScratchDirectory() {
+				std::error_code error{};
+				std::filesystem::remove_all(Path, error);
+			}
+
+			std::string Path;
+		};
+
+		// Generated, and written to the cache, on first use, so that a filtered run does not generate the larger maps for nothing.
+		struct LazyCache {
+			MapGenParams const& Get() {
+				if (!Directory) {
+					Directory = std::make_unique<ScratchDirectory>(std::format("LuminaMapCache{}x{}", Params.Width, Params.Height));
+					CellularAutomata generator{};
+					generator.Run(Params, Directory->Path);
+				}
+				return Params;
+			}
+
+			MapGenParams Params;
+			std::unique_ptr<ScratchDirectory> Directory{};
+		};
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		// Tile for tile, cave for cave, feature for feature; from fresh generators and from one reused.
+		suite_.Verify("Game/MapGenerator/Deterministic", [] () {
+			CellularAutomata reused{};
+			for (uint64_t seed{ 0LLU }; seed < 8LLU; ++seed) {
+				MapGenParams const params{ .Width{ 128U + static_cast<uint32_t>(seed) * 32U }, .Height{ 64U }, .Seed{ seed * 0x9E3779B97F4A7C15LLU } };
+				Snapshot const expected{ Generate(params) };
+				if (!(Generate(params) == expected)) { return false; }
+
+				reused.Run(params);
+				if (!(Take(reused) == expected)) { return false; }
+			}
+			return !(Generate({ .Seed{ 1LLU } }) == Generate({ .Seed{ 2LLU } }));
+		});
+		// Without a margin the border is still wall, and no cave reaches it.
+		suite_.Verify("Game/MapGenerator/NoMargin", [] () {
+			for (uint64_t seed{ 0LLU }; seed < 8LLU; ++seed) {
+				MapGenParams const params{ .Width{ 64U }, .Height{ 32U }, .Seed{ seed }, .Margin{ 0U }, .Probability_Wallification{ 0.3f } };
+				Snapshot const snapshot{ Generate(params) };
+				for (uint32_t y{ 0U }; y < params.Height; ++y) {
+					for (uint32_t x{ 0U }; x < params.Width; ++x) {
+						bool const isBorder{ x == 0U || y == 0U || x + 1U == params.Width || y + 1U == params.Height };
+						if (isBorder && (snapshot.Map[y][x] & ((1 << 20U) - 1)) == 0) { return false; }
+					}
+				}
+			}
+			return true;
+		});
+		suite_.Verify("Game/MapGenerator/Key", [] () {
+			MapGenParams const base{};
+			std::vector<MapGenParams> variants(8U, base);
+			variants[0].Width += 1U;
+			variants[1].Height += 1U;
+			variants[2].Seed += 1LLU;
+			variants[3].Probability_Wallification += 0.01f;
+			variants[4].Num_SmoothingSteps += 1U;
+			variants[5].Ratio_ExtraTunnels += 0.1f;
+			variants[6].Radius_Tunnel += 1U;
+			variants[7].Spacing_Features += 1.0f;
+			for (auto const& variant : variants) {
+				if (variant.Key() == base.Key()) { return false; }
+			}
+			return MapGenParams{}.Key() == base.Key();
+		});
+		// A miss generates and stores; a hit loads the very same map; a damaged file is a miss, and is replaced.
+		suite_.Verify("Game/MapGenerator/Cache", [] () {
+			ScratchDirectory const directory{ "LuminaMapCacheCheck" };
+			MapGenParams const params{ .Width{ 256U }, .Height{ 128U }, .Seed{ 42LLU }, .Ratio_ExtraTunnels{ 0.2f } };
+			Snapshot const expected{ Generate(params) };
+
+			CellularAutomata generator{};
+			if (generator.Run(params, directory.Path) || !(Take(generator) == expected)) { return false; }
+			if (!CellularAutomata{}.Run(params, directory.Path)) { return false; }
+			if (!generator.Run(params, directory.Path) || !(Take(generator) == expected)) { return false; }
+
+			std::string const path{ CellularAutomata::CachePath(params, directory.Path) };
+			std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4U);
+			if (generator.Run(params, directory.Path) || !(Take(generator) == expected)) { return false; }
+			if (!generator.Run(params, directory.Path)) { return false; }
+
+			// Other params, other file.
+			MapGenParams other{ params };
+			other.Seed += 1LLU;
+			return !generator.Run(other, directory.Path) && CellularAutomata::CachePath(other, directory.Path) != path;
+		});
+
+		//----	------	------	------	------	----//
+		//	Maps								//
+		//----	------	------	------	------	----//
+
+		constexpr std::pair<uint32_t, uint32_t> Sizes[]{ { 128U, 64U }, { 512U, 512U }, { 1024U, 1024U } };
+		for (auto const& [width, height] : Sizes) {
+			auto const cache{ std::make_shared<LazyCache>(MapGenParams{ .Width{ width }, .Height{ height }, .Seed{ 7LLU } }) };
+			uint64_t const num_Tiles{ static_cast<uint64_t>(width) * height };
+
+			suite_.Add(std::format("Game/MapGenerator/{}x{}/Generate", width, height), [cache] (uint64_t num_Iterations_) {
+				CellularAutomata generator{};
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					generator.Run(cache->Params);
+					DoNotOptimize(generator.GetCaves().size());
+				}
+			}, num_Tiles);
+			suite_.Add(std::format("Game/MapGenerator/{}x{}/CacheHit", width, height), [cache] (uint64_t num_Iterations_) {
+				MapGenParams const& params{ cache->Get() };
+				CellularAutomata generator{};
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					DoNotOptimize(generator.Run(params, cache->Directory->Path));
+					DoNotOptimize(generator.GetCaves().size());
+				}
+			}, num_Tiles);
+		}
+	}
+}
\ No newline at end of file
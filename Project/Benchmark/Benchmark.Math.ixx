@@ -0,0 +1,233 @@
+export module Benchmark.Math;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <cmath>;
+import <random>;
+
+import <vector>;
+
+import Benchmark.Harness;
+
+import Lumina.Math.Numerics;
+import Lumina.Math.Vector;
+import Lumina.Math.Matrix;
+import Lumina.Math.PerlinNoise;
+
+import Lumina.Phys.Collision;
+
+import Lumina.Utils.Color;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::Math {
+	namespace {
+		// Operands are cycled through a small working set that stays in L1,
+		// so that the measurements reflect arithmetic rather than memory traffic.
+		constexpr uint32_t Num_Operands{ 256U };
+		constexpr uint32_t OperandMask{ Num_Operands - 1U };
+
+		std::vector<Lumina::Vec3> RandomVec3s(std::mt19937& rndGen_) {
+			std::uniform_real_distribution<float> dist{ -100.0f, 100.0f };
+			std::vector<Lumina::Vec3> vecs(Num_Operands);
+			for (auto& vec : vecs) {
+				vec = { dist(rndGen_), dist(rndGen_), dist(rndGen_) };
+			}
+			return vecs;
+		}
+
+		std::vector<Lumina::Mat4> RandomMat4s(std::mt19937& rndGen_) {
+			std::uniform_real_distribution<float> dist{ -3.14f, 3.14f };
+			std::vector<Lumina::Mat4> mats(Num_Operands);
+			for (auto& mat : mats) {
+				// SRT matrices are always invertible, which keeps Invert on its common path.
+				mat = Lumina::Mat4::SRT(
+					{ 1.0f + std::abs(dist(rndGen_)), 1.0f + std::abs(dist(rndGen_)), 1.0f + std::abs(dist(rndGen_)) },
+					{ dist(rndGen_), dist(rndGen_), dist(rndGen_) },
+					{ dist(rndGen_) * 10.0f, dist(rndGen_) * 10.0f, dist(rndGen_) * 10.0f }
+				);
+			}
+			return mats;
+		}
+	}
+
+	export void Register(Suite& suite_) {
+		std::mt19937 rndGen{ 0x4C554D49U };
+
+		auto const vec3s{ RandomVec3s(rndGen) };
+		auto const mat4s{ RandomMat4s(rndGen) };
+
+		//----	------	------	------	------	----//
+		//	Vec3								//
+		//----	------	------	------	------	----//
+
+		suite_.Add("Math/Vec3/Add", [vec3s] (uint64_t num_Iterations_) {
+			Lumina::Vec3 acc{};
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				acc += vec3s[i & OperandMask];
+			}
+			DoNotOptimize(acc);
+		});
+		suite_.Add("Math/Vec3/Dot", [vec3s] (uint64_t num_Iterations_) {
+			float acc{ 0.0f };
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				acc += Lumina::Vec3::Dot(vec3s[i & OperandMask], vec3s[(i + 1LLU) & OperandMask]);
+			}
+			DoNotOptimize(acc);
+		});
+		suite_.Add("Math/Vec3/Cross", [vec3s] (uint64_t num_Iterations_) {
+			Lumina::Vec3 acc{};
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				acc += Lumina::Vec3::Cross(vec3s[i & OperandMask], vec3s[(i + 1LLU) & OperandMask]);
+			}
+			DoNotOptimize(acc);
+		});
+		suite_.Add("Math/Vec3/Norm", [vec3s] (uint64_t num_Iterations_) {
+			float acc{ 0.0f };
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				acc += vec3s[i & OperandMask].Norm();
+			}
+			DoNotOptimize(acc);
+		});
+		suite_.Add("Math/Vec3/Unit", [vec3s] (uint64_t num_Iterations_) {
+			Lumina::Vec3 acc{};
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				acc += vec3s[i & OperandMask].Unit();
+			}
+			DoNotOptimize(acc);
+		});
+
+		//----	------	------	------	------	----//
+		//	Mat4								//
+		//----	------	------	------	------	----//
+
+		suite_.Add("Math/Mat4/Multiply", [mat4s] (uint64_t num_Iterations_) {
+			Lumina::Mat4 dst{};
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				Lumina::Mat4::Multiply(dst, mat4s[i & OperandMask], mat4s[(i + 1LLU) & OperandMask]);
+				DoNotOptimize(dst);
+			}
+		});
+		suite_.Add("Math/Mat4/Transpose", [mat4s] (uint64_t num_Iterations_) {
+			Lumina::Mat4 dst{};
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				Lumina::Mat4::Transpose(dst, mat4s[i & OperandMask]);
+				DoNotOptimize(dst);
+			}
+		});
+		suite_.Add("Math/Mat4/Invert", [mat4s] (uint64_t num_Iterations_) {
+			Lumina::Mat4 dst{};
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				Lumina::Mat4::Invert(dst, mat4s[i & OperandMask]);
+				DoNotOptimize(dst);
+			}
+		});
+		suite_.Add("Math/Mat4/Inv", [mat4s] (uint64_t num_Iterations_) {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				auto&& inv{ mat4s[i & OperandMask].Inv() };
+				DoNotOptimize(inv);
+			}
+		});
+		suite_.Add("Math/Mat4/Det", [mat4s] (uint64_t num_Iterations_) {
+			float acc{ 0.0f };
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				acc += mat4s[i & OperandMask].Det();
+			}
+			DoNotOptimize(acc);
+		});
+		suite_.Add("Math/Mat4/SRT", [vec3s] (uint64_t num_Iterations_) {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				auto&& srt{
+					Lumina::Mat4::SRT(
+						vec3s[i & OperandMask],
+						vec3s[(i + 1LLU) & OperandMask],
+						vec3s[(i + 2LLU) & OperandMask]
+					)
+				};
+				DoNotOptimize(srt);
+			}
+		});
+		suite_.Add("Math/Mat4/Vec4xMat4", [vec3s, mat4s] (uint64_t num_Iterations_) {
+			Lumina::Vec4 acc{};
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				acc += vec3s[i & OperandMask] * mat4s[(i + 1LLU) & OperandMask];
+			}
+			DoNotOptimize(acc);
+		});
+
+		//----	------	------	------	------	----//
+		//	PerlinNoise							//
+		//----	------	------	------	------	----//
+
+		suite_.Add("Math/PerlinNoise/1Octave", [vec3s] (uint64_t num_Iterations_) {
+			Lumina::PerlinNoise const noise{ 0.05f, 1U };
+			float acc{ 0.0f };
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				auto const& p{ vec3s[i & OperandMask] };
+				acc += noise(p.x, p.y, p.z);
+			}
+			DoNotOptimize(acc);
+		});
+		suite_.Add("Math/PerlinNoise/8Octaves", [vec3s] (uint64_t num_Iterations_) {
+			Lumina::PerlinNoise const noise{ 0.05f, 8U };
+			float acc{ 0.0f };
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				auto const& p{ vec3s[i & OperandMask] };
+				acc += noise(p.x, p.y, p.z);
+			}
+			DoNotOptimize(acc);
+		});
+
+		//----	------	------	------	------	----//
+		//	Collision							//
+		//----	------	------	------	------	----//
+
+		suite_.Add("Phys/Collision/Elastic", [vec3s] (uint64_t num_Iterations_) {
+			auto vels{ vec3s };
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				Lumina::Phys::Collision::Elastic(
+					vels[i & OperandMask],
+					vels[(i + 1LLU) & OperandMask],
+					vec3s[(i + 2LLU) & OperandMask],
+					vec3s[(i + 3LLU) & OperandMask],
+					1.0f,
+					2.0f
+				);
+			}
+			DoNotOptimize(vels[0]);
+		});
+
+		//----	------	------	------	------	----//
+		//	Color								//
+		//----	------	------	------	------	----//
+
+		suite_.Add("Utils/Color/HSVToRGB", [vec3s] (uint64_t num_Iterations_) {
+			float acc{ 0.0f };
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				auto const& v{ vec3s[i & OperandMask] };
+				auto&& rgb{
+					Lumina::Utils::Color::Convert(
+						Lumina::Utils::Color::HSV{ v.x * 3.6f, std::abs(v.y) * 0.01f, std::abs(v.z) * 0.01f }
+					)
+				};
+				acc += rgb.R + rgb.G + rgb.B;
+			}
+			DoNotOptimize(acc);
+		});
+		suite_.Add("Utils/Color/RGBToHSV", [vec3s] (uint64_t num_Iterations_) {
+			float acc{ 0.0f };
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				auto const& v{ vec3s[i & OperandMask] };
+				auto&& hsv{
+					Lumina::Utils::Color::Convert(
+						Lumina::Utils::Color::RGB{ std::abs(v.x) * 0.01f, std::abs(v.y) * 0.01f, std::abs(v.z) * 0.01f }
+					)
+				};
+				acc += hsv.H + hsv.S + hsv.V;
+			}
+			DoNotOptimize(acc);
+		});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,232 @@
+export module Benchmark.ObjectPool;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <random>;
+import <memory>;
+import <memory_resource>;
+import <stdexcept>;
+
+import <vector>;
+import <list>;
+import <unordered_set>;
+import <algorithm>;
+
+import <atomic>;
+import <thread>;
+
+import Benchmark.Harness;
+
+import Lumina.Container.ObjectPool;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::ObjectPool {
+	namespace {
+		// About the size of a resource wrapper: a COM pointer, a description, a status and a name.
+		struct Object {
+			uint64_t Payload[12];
+		};
+
+		struct Counted {
+			static inline std::atomic<int32_t> Num_Alive{ 0 };
+
+			explicit Counted(uint32_t value_, bool throws_ = false) : Value{ value_ } {
+				if (throws_) { throw std::runtime_error{ "Counted" }; }
+				++Num_Alive;
+			}
+			~Counted() noexcept { --Num_Alive; }
+
+			uint32_t Value;
+		};
+
+		struct alignas(64) CacheLine {
+			uint32_t Value;
+		};
+
+		constexpr uint32_t Num_Live{ 4096U };
+		constexpr uint32_t Num_Cycles{ 1U << 20U };
+		constexpr uint32_t Num_Threads{ 4U };
+
+		// Which live object each cycle replaces.
+		std::vector<uint32_t> Victims(uint32_t num_, uint32_t seed_) {
+			std::mt19937 rndGen{ seed_ };
+			std::vector<uint32_t> victims(num_);
+			for (auto& victim : victims) { victim = static_cast<uint32_t>(rndGen() % Num_Live); }
+			return victims;
+		}
+
+		// Keeps Num_Live objects alive and replaces a random one per cycle, through make_/destroy_.
+		template<typename T_Make, typename T_Destroy>
+		void Churn(std::vector<uint32_t> const& victims_, T_Make&& make_, T_Destroy&& destroy_) {
+			std::vector<Object*> live(Num_Live);
+			for (uint32_t i{ 0U }; i < Num_Live; ++i) { live[i] = make_(i); }
+			for (uint32_t i{ 0U }; i < static_cast<uint32_t>(victims_.size()); ++i) {
+				Object*& victim{ live[victims_[i]] };
+				destroy_(victim);
+				victim = make_(i);
+				DoNotOptimize(victim);
+			}
+			for (Object* const object : live) { destroy_(object); }
+		}
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		suite_.Verify("Container/ObjectPool/ReusesBlocks", [] () {
+			Lumina::ObjectPool<Object> pool{ 64U };
+			auto const victims{ Victims(100000U, 0x4C554D49U) };
+			Churn(victims, [&] (uint32_t) { return pool.New(); }, [&] (Object* object_) { pool.Delete(object_); });
+			auto const stats{ pool.Stats() };
+			// The live set never exceeds Num_Live, so neither do the blocks carved.
+			return stats.Num_Live == 0U && stats.Peak_Live == Num_Live && stats.Num_Slabs == Num_Live / 64U &&
+				stats.Num_Allocations == Num_Live + victims.size() && stats.Num_Allocations == stats.Num_Deallocations;
+		});
+		suite_.Verify("Container/ObjectPool/ConstructsAndDestroys", [] () {
+			Lumina::ObjectPool<Counted> pool{};
+			{
+				std::vector<Lumina::ObjectPool<Counted>::UniPtr> objects{};
+				for (uint32_t i{ 0U }; i < 1000U; ++i) { objects.emplace_back(pool.MakeUnique(i)); }
+				if (Counted::Num_Alive != 1000 || objects[999]->Value != 999U) { return false; }
+				try {
+					[[maybe_unused]] auto* const never{ pool.New(0U, true) };
+					return false;
+				}
+				catch (std::runtime_error const&) {}
+				// The block of the throwing constructor went back to the pool.
+				if (pool.Stats().Num_Live != 1000U) { return false; }
+			}
+			return Counted::Num_Alive == 0 && pool.Stats().Num_Live == 0U;
+		});
+		suite_.Verify("Container/ObjectPool/OverAligned", [] () {
+			Lumina::ObjectPool<CacheLine> pool{ 7U };
+			std::vector<CacheLine*> lines{};
+			for (uint32_t i{ 0U }; i < 100U; ++i) { lines.emplace_back(pool.New(i)); }
+			bool const isAligned{
+				std::all_of(lines.cbegin(), lines.cend(), [] (CacheLine const* line_) { return (reinterpret_cast<uintptr_t>(line_) & 63LLU) == 0LLU; })
+			};
+			for (auto* const line : lines) { pool.Delete(line); }
+			return isAligned;
+		});
+		// Objects made on one thread and deleted on another, as the texture uploader does, through caches on both sides.
+		suite_.Verify("Container/ObjectPool/CachesAcrossThreads", [] () {
+			Lumina::ObjectPool<Counted> pool{};
+			std::vector<std::vector<Counted*>> made(Num_Threads);
+			std::vector<std::thread> threads{};
+			for (uint32_t t{ 0U }; t < Num_Threads; ++t) {
+				threads.emplace_back([&pool, &made, t] () {
+					Lumina::ObjectPool<Counted>::Cache cache{ pool };
+					for (uint32_t i{ 0U }; i < 10000U; ++i) { made[t].emplace_back(cache.New(t * 10000U + i)); }
+				});
+			}
+			for (auto& thread : threads) { thread.join(); }
+
+			std::unordered_set<Counted*> distinct{};
+			for (auto const& objects : made) {
+				for (auto* const object : objects) { distinct.emplace(object); }
+			}
+			if (distinct.size() != Num_Threads * 10000LLU) { return false; }
+
+			threads.clear();
+			for (uint32_t t{ 0U }; t < Num_Threads; ++t) {
+				threads.emplace_back([&pool, &made, t] () {
+					Lumina::ObjectPool<Counted>::Cache cache{ pool };
+					for (auto* const object : made[(t + 1U) % Num_Threads]) { cache.Delete(object); }
+				});
+			}
+			for (auto& thread : threads) { thread.join(); }
+			return Counted::Num_Alive == 0 && pool.Stats().Num_Live == 0U;
+		});
+		suite_.Verify("Container/ObjectPool/PoolResource", [] () {
+			Lumina::PoolResource resource{ 32LLU };
+			{
+				std::pmr::list<uint64_t> list{ &resource };
+				for (uint64_t i{ 0LLU }; i < 1000LLU; ++i) { list.emplace_back(i); }
+				list.remove_if([] (uint64_t value_) { return value_ % 3LLU == 0LLU; });
+				for (uint64_t i{ 0LLU }; i < 500LLU; ++i) { list.emplace_front(i); }
+				// Too large for a block; goes upstream.
+				std::pmr::vector<uint64_t> large{ list.begin(), list.end(), &resource };
+				if (resource.Stats().Num_Live != list.size() || large.size() != list.size()) { return false; }
+			}
+			return resource.Stats().Num_Live == 0U;
+		});
+
+		//----	------	------	------	------	----//
+		//	Churn								//
+		//----	------	------	------	------	----//
+
+		auto const victims{ std::make_shared<std::vector<uint32_t>>(Victims(Num_Cycles, 0x4C554D49U)) };
+
+		suite_.Add("Container/ObjectPool/Churn/new-delete", [victims] (uint64_t num_Iterations_) {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				Churn(*victims, [] (uint32_t) { return new Object{}; }, [] (Object* object_) { delete object_; });
+			}
+		});
+		suite_.Add("Container/ObjectPool/Churn/ObjectPool", [victims] (uint64_t num_Iterations_) {
+			Lumina::ObjectPool<Object> pool{};
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				Churn(*victims, [&pool] (uint32_t) { return pool.New(); }, [&pool] (Object* object_) { pool.Delete(object_); });
+			}
+		});
+		suite_.Add("Container/ObjectPool/Churn/ObjectPool::Cache", [victims] (uint64_t num_Iterations_) {
+			Lumina::ObjectPool<Object> pool{};
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				Lumina::ObjectPool<Object>::Cache cache{ pool };
+				Churn(*victims, [&cache] (uint32_t) { return cache.New(); }, [&cache] (Object* object_) { cache.Delete(object_); });
+			}
+		});
+
+		// The same cycles split across Num_Threads threads churning at once.
+		suite_.Add("Container/ObjectPool/ChurnParallel/new-delete", [victims] (uint64_t num_Iterations_) {
+			std::vector<uint32_t> const share(victims->begin(), victims->begin() + Num_Cycles / Num_Threads);
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				std::vector<std::jthread> threads{};
+				for (uint32_t t{ 0U }; t < Num_Threads; ++t) {
+					threads.emplace_back([&share] () {
+						Churn(share, [] (uint32_t) { return new Object{}; }, [] (Object* object_) { delete object_; });
+					});
+				}
+			}
+		});
+		suite_.Add("Container/ObjectPool/ChurnParallel/ObjectPool::Cache", [victims] (uint64_t num_Iterations_) {
+			std::vector<uint32_t> const share(victims->begin(), victims->begin() + Num_Cycles / Num_Threads);
+			Lumina::ObjectPool<Object> pool{};
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				std::vector<std::jthread> threads{};
+				for (uint32_t t{ 0U }; t < Num_Threads; ++t) {
+					threads.emplace_back([&share, &pool] () {
+						Lumina::ObjectPool<Object>::Cache cache{ pool };
+						Churn(share, [&cache] (uint32_t) { return cache.New(); }, [&cache] (Object* object_) { cache.Delete(object_); });
+					});
+				}
+			}
+		});
+
+		// Node churn of a std::pmr::list, the default resource against a pool of node-sized blocks.
+		{
+			auto const churnList{
+				[victims] (std::pmr::memory_resource* resource_) {
+					std::pmr::list<uint64_t> list{ resource_ };
+					for (uint32_t i{ 0U }; i < Num_Live; ++i) { list.emplace_back(i); }
+					for (uint32_t const victim : *victims) {
+						list.pop_front();
+						list.emplace_back(victim);
+					}
+					DoNotOptimize(list.back());
+				}
+			};
+			suite_.Add("Container/ObjectPool/ListNodes/default_resource", [churnList] (uint64_t num_Iterations_) {
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) { churnList(std::pmr::get_default_resource()); }
+			});
+			suite_.Add("Container/ObjectPool/ListNodes/PoolResource", [churnList] (uint64_t num_Iterations_) {
+				Lumina::PoolResource resource{ 32LLU };
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) { churnList(&resource); }
+			});
+		}
+	}
+}
\ No newline at end of file
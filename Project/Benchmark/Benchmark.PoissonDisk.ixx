@@ -0,0 +1,158 @@
+export module Benchmark.PoissonDisk;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <cmath>;
+import <random>;
+
+import <vector>;
+import <algorithm>;
+
+import Benchmark.Harness;
+
+import Lumina.Math.Vector;
+import Lumina.Math.PoissonDisk;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::PoissonDisk {
+	namespace {
+		// Square/cube domains sized for roughly a million points at unit spacing.
+		constexpr float Extent_1M_2D{ 1280.0f };
+		constexpr float Extent_1M_3D{ 118.0f };
+
+		// Spacing grows from 1 to 3 along x.
+		template<typename T_Point>
+		float Ramp(T_Point const& pos_) {
+			return std::clamp(1.0f + pos_.x / 32.0f, 1.0f, 3.0f);
+		}
+
+		// A hole in the middle of the domain, standing in for solid tiles.
+		template<typename T_Point>
+		bool OutsideHole(T_Point const& pos_) {
+			float const dx{ pos_.x - 32.0f };
+			float const dy{ pos_.y - 32.0f };
+			return (dx * dx + dy * dy > 100.0f);
+		}
+
+		// Brute force over all pairs; the domains used by the checks keep this to a few million distance tests.
+		template<uint32_t N_Dims, typename T_Radius, typename T_Mask>
+		bool IsValid(Lumina::PoissonDisk<N_Dims> const& sampler_, T_Radius&& radius_, T_Mask&& mask_) {
+			auto const& params{ sampler_.Parameters() };
+			auto const& points{ sampler_.Points() };
+			if (points.empty()) { return false; }
+
+			for (size_t i{ 0LLU }; i < points.size(); ++i) {
+				for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+					if (points[i][idx_Dim] < params.Min[idx_Dim] || points[i][idx_Dim] >= params.Max[idx_Dim]) { return false; }
+				}
+				if (!mask_(points[i])) { return false; }
+
+				float const radius_I{ std::clamp(radius_(points[i]), params.MinRadius, params.MaxRadius) };
+				for (size_t j{ i + 1LLU }; j < points.size(); ++j) {
+					float dist2{ 0.0f };
+					for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+						float const d{ points[i][idx_Dim] - points[j][idx_Dim] };
+						dist2 += d * d;
+					}
+					float const spacing{ std::max(radius_I, std::clamp(radius_(points[j]), params.MinRadius, params.MaxRadius)) };
+					if (dist2 < spacing * spacing) { return false; }
+				}
+			}
+			return true;
+		}
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		suite_.Verify("Math/PoissonDisk/2D/MinDistance", [] () {
+			Lumina::PoissonDisk<2U> sampler{ { .Min{ 0.0f, 0.0f }, .Max{ 64.0f, 64.0f }, .MinRadius{ 1.0f }, .MaxRadius{ 3.0f } } };
+			std::mt19937 rndGen{ 1U };
+			sampler.Generate(rndGen, Ramp<Lumina::Vec2>, OutsideHole<Lumina::Vec2>);
+			return IsValid(sampler, Ramp<Lumina::Vec2>, OutsideHole<Lumina::Vec2>);
+		});
+		suite_.Verify("Math/PoissonDisk/3D/MinDistance", [] () {
+			Lumina::PoissonDisk<3U> sampler{ { .Min{ 0.0f, 0.0f, 0.0f }, .Max{ 64.0f, 64.0f, 8.0f }, .MinRadius{ 1.0f }, .MaxRadius{ 3.0f } } };
+			std::mt19937 rndGen{ 2U };
+			sampler.Generate(rndGen, Ramp<Lumina::Vec3>, OutsideHole<Lumina::Vec3>);
+			return IsValid(sampler, Ramp<Lumina::Vec3>, OutsideHole<Lumina::Vec3>);
+		});
+		// Small tiles, so that points meet across many tile borders.
+		suite_.Verify("Math/PoissonDisk/2D/Tiled", [] () {
+			Lumina::PoissonDisk<2U>::Params const params{ .Min{ 0.0f, 0.0f }, .Max{ 64.0f, 64.0f }, .MinRadius{ 1.0f }, .MaxRadius{ 3.0f } };
+			Lumina::PoissonDisk<2U> sampler_Serial{ params };
+			Lumina::PoissonDisk<2U> sampler_Parallel{ params };
+			sampler_Serial.GenerateTiled(3U, Ramp<Lumina::Vec2>, OutsideHole<Lumina::Vec2>, 8, 1U);
+			sampler_Parallel.GenerateTiled(3U, Ramp<Lumina::Vec2>, OutsideHole<Lumina::Vec2>, 8, 4U);
+
+			auto const& points_Serial{ sampler_Serial.Points() };
+			auto const& points_Parallel{ sampler_Parallel.Points() };
+			bool const isDeterministic{
+				std::equal(
+					points_Serial.cbegin(), points_Serial.cend(),
+					points_Parallel.cbegin(), points_Parallel.cend(),
+					[] (Lumina::Vec2 const& lhs_, Lumina::Vec2 const& rhs_) { return (lhs_.x == rhs_.x) && (lhs_.y == rhs_.y); }
+				)
+			};
+			return isDeterministic && IsValid(sampler_Parallel, Ramp<Lumina::Vec2>, OutsideHole<Lumina::Vec2>);
+		});
+		suite_.Verify("Math/PoissonDisk/3D/Tiled", [] () {
+			Lumina::PoissonDisk<3U> sampler{ { .Min{ 0.0f, 0.0f, 0.0f }, .Max{ 24.0f, 24.0f, 24.0f }, .MinRadius{ 1.0f }, .MaxRadius{ 1.0f } } };
+			auto const radius{ [] (Lumina::Vec3 const&) { return 1.0f; } };
+			auto const mask{ [] (Lumina::Vec3 const&) { return true; } };
+			sampler.GenerateTiled(4U, radius, mask, 4, 4U);
+			return IsValid(sampler, radius, mask);
+		});
+		suite_.Verify("Math/PoissonDisk/TryInsert", [] () {
+			Lumina::PoissonDisk<2U> sampler{ { .Min{ 0.0f, 0.0f }, .Max{ 16.0f, 16.0f }, .MinRadius{ 1.0f }, .MaxRadius{ 4.0f } } };
+			return
+				sampler.TryInsert({ 8.0f, 8.0f }, 4.0f) &&
+				// Within the first point's radius, even though its own radius is small.
+				!sampler.TryInsert({ 11.0f, 8.0f }, 1.0f) &&
+				sampler.TryInsert({ 12.5f, 8.0f }, 1.0f) &&
+				!sampler.TryInsert({ 16.0f, 8.0f }, 1.0f) &&
+				(sampler.Points().size() == 2LLU);
+		});
+
+		//----	------	------	------	------	----//
+		//	Generation							//
+		//----	------	------	------	------	----//
+
+		suite_.Add("Math/PoissonDisk/2D/1M", [] (uint64_t num_Iterations_) {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				Lumina::PoissonDisk<2U> sampler{ { .Min{ 0.0f, 0.0f }, .Max{ Extent_1M_2D, Extent_1M_2D }, .MinRadius{ 1.0f }, .MaxRadius{ 1.0f } } };
+				std::mt19937 rndGen{ static_cast<uint32_t>(i) };
+				sampler.Generate(rndGen);
+				DoNotOptimize(sampler.Points().data());
+			}
+		});
+		suite_.Add("Math/PoissonDisk/2D/1M/Tiled", [] (uint64_t num_Iterations_) {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				Lumina::PoissonDisk<2U> sampler{ { .Min{ 0.0f, 0.0f }, .Max{ Extent_1M_2D, Extent_1M_2D }, .MinRadius{ 1.0f }, .MaxRadius{ 1.0f } } };
+				sampler.GenerateTiled(
+					static_cast<uint32_t>(i),
+					[] (Lumina::Vec2 const&) { return 1.0f; },
+					[] (Lumina::Vec2 const&) { return true; }
+				);
+				DoNotOptimize(sampler.Points().data());
+			}
+		});
+		suite_.Add("Math/PoissonDisk/3D/1M/Tiled", [] (uint64_t num_Iterations_) {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				Lumina::PoissonDisk<3U> sampler{ { .Min{ 0.0f, 0.0f, 0.0f }, .Max{ Extent_1M_3D, Extent_1M_3D, Extent_1M_3D }, .MinRadius{ 1.0f }, .MaxRadius{ 1.0f } } };
+				sampler.GenerateTiled(
+					static_cast<uint32_t>(i),
+					[] (Lumina::Vec3 const&) { return 1.0f; },
+					[] (Lumina::Vec3 const&) { return true; },
+					16
+				);
+				DoNotOptimize(sampler.Points().data());
+			}
+		});
+	}
+}
\ No newline at end of file
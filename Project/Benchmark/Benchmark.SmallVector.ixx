@@ -0,0 +1,374 @@
+export module Benchmark.SmallVector;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <random>;
+import <memory>;
+import <string>;
+import <sstream>;
+import <charconv>;
+
+import <vector>;
+import <algorithm>;
+
+import Benchmark.Harness;
+
+import Lumina.Container.SmallVector;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::SmallVector {
+	namespace {
+		// std::allocator that counts the blocks it hands out, to show where the heap is (not) touched.
+		struct AllocationCounter {
+			static inline uint64_t Num_Allocations{ 0LLU };
+		};
+
+		template<typename T>
+		struct CountingAllocator {
+			using value_type = T;
+
+			CountingAllocator() noexcept = default;
+			template<typename T_Other>
+			CountingAllocator(CountingAllocator<T_Other> const&) noexcept {}
+
+			T* allocate(size_t num_) {
+				++AllocationCounter::Num_Allocations;
+				return std::allocator<T>{}.allocate(num_);
+			}
+			void deallocate(T* ptr_, size_t num_) noexcept { std::allocator<T>{}.deallocate(ptr_, num_); }
+
+			template<typename T_Other>
+			bool operator==(CountingAllocator<T_Other> const&) const noexcept { return true; }
+		};
+
+		//----	------	------	------	------	----//
+
+		// Applies the same random operations to a SmallVector and a std::vector and compares them after each one.
+		// N is small so that the inline/heap boundary is crossed in both directions.
+		template<typename T, uint32_t N, typename T_Make>
+		bool MatchesVector(uint32_t seed_, T_Make&& make_) {
+			std::mt19937 rndGen{ seed_ };
+			Lumina::SmallVector<T, N> small{};
+			std::vector<T> reference{};
+			auto const same{ [&] () { return std::equal(small.begin(), small.end(), reference.begin(), reference.end()); } };
+
+			for (uint32_t i{ 0U }; i < 4000U; ++i) {
+				uint32_t const op{ static_cast<uint32_t>(rndGen() % 14U) };
+				size_t const pos{ reference.empty() ? 0LLU : static_cast<size_t>(rndGen() % (reference.size() + 1LLU)) };
+				T const val{ make_(i) };
+				switch (op) {
+				case 0U: case 1U: case 2U:
+					small.push_back(val);
+					reference.push_back(val);
+					break;
+				case 3U:
+					small.emplace(small.begin() + pos, val);
+					reference.emplace(reference.begin() + pos, val);
+					break;
+				case 4U: {
+					size_t const num{ rndGen() % 5LLU };
+					small.insert(small.begin() + pos, num, val);
+					reference.insert(reference.begin() + pos, num, val);
+					break;
+				}
+				case 5U: {
+					T const vals[3]{ make_(i + 1U), make_(i + 2U), make_(i + 3U) };
+					small.insert(small.begin() + pos, vals, vals + 3);
+					reference.insert(reference.begin() + pos, vals, vals + 3);
+					break;
+				}
+				case 6U:
+					if (pos < reference.size()) {
+						small.erase(small.begin() + pos);
+						reference.erase(reference.begin() + pos);
+					}
+					break;
+				case 7U: {
+					size_t const last{ std::min<size_t>(reference.size(), pos + rndGen() % 4LLU) };
+					small.erase(small.begin() + pos, small.begin() + last);
+					reference.erase(reference.begin() + pos, reference.begin() + last);
+					break;
+				}
+				case 8U: {
+					size_t const size{ rndGen() % (2LLU * N + 4LLU) };
+					small.resize(size, val);
+					reference.resize(size, val);
+					break;
+				}
+				case 9U:
+					if (!reference.empty()) {
+						small.pop_back();
+						reference.pop_back();
+					}
+					break;
+				case 10U:
+					small.shrink_to_fit();
+					if (small.size() <= N && !small.IsInline()) { return false; }
+					break;
+				case 11U: {
+					auto copy{ small };
+					auto moved{ std::move(copy) };
+					if (!copy.empty() || !(moved == small)) { return false; }
+					Lumina::SmallVector<T, N> other{ make_(i), make_(i + 1U) };
+					other.swap(moved);
+					small = std::move(other);
+					break;
+				}
+				case 12U:
+					// Aliases an element of the vector itself, which must survive the reallocation.
+					if (!reference.empty()) {
+						small.push_back(small[0]);
+						reference.push_back(reference[0]);
+					}
+					break;
+				default:
+					if (i % 64U == 0U) {
+						small.assign(pos % 7LLU, val);
+						reference.assign(pos % 7LLU, val);
+					}
+					break;
+				}
+				if (!same()) { return false; }
+			}
+			return true;
+		}
+
+		//----	------	------	------	------	----//
+		//	OBJ faces							//
+		//----	------	------	------	------	----//
+
+		struct Vertex {
+			uint32_t Index_Position;
+			uint32_t Index_TexCoord;
+			uint32_t Index_Normal;
+		};
+
+		// Quads, as exported by most tools.
+		std::vector<std::string> FaceLines(uint32_t num_) {
+			std::mt19937 rndGen{ 7U };
+			std::vector<std::string> lines(num_);
+			for (auto& line : lines) {
+				for (uint32_t i{ 0U }; i < 4U; ++i) {
+					line += std::to_string(1U + rndGen() % 20000U) + "/" + std::to_string(1U + rndGen() % 20000U) + "/" + std::to_string(1U + rndGen() % 20000U) + " ";
+				}
+			}
+			return lines;
+		}
+
+		// WavefrontOBJParser::ReadFace before SmallVector: a stream and stoi per index.
+		void ReadFace_Stream(std::istringstream& iss_, std::vector<Vertex>& vertices_) {
+			std::string str_Vert{};
+			std::string str_VertElemIdx{};
+			while (iss_ >> str_Vert) {
+				std::istringstream iss_Vert{ str_Vert };
+				auto& vert{ vertices_.emplace_back() };
+				for (uint32_t i_VertElem{ 0U }; i_VertElem < 3U; ++i_VertElem) {
+					std::getline(iss_Vert, str_VertElemIdx, '/');
+					*(reinterpret_cast<uint32_t*>(&vert) + i_VertElem) = std::stoi(str_VertElemIdx) - 1U;
+				}
+			}
+		}
+
+		// WavefrontOBJParser::ReadFace now, with the index list type left open to compare against std::vector.
+		template<typename T_Indices>
+		void ReadFace_FromChars(std::istringstream& iss_, std::vector<Vertex>& vertices_) {
+			std::string str_Vert{};
+			T_Indices indices{};
+			while (iss_ >> str_Vert) {
+				char const* it{ str_Vert.data() };
+				char const* const it_End{ str_Vert.data() + str_Vert.size() };
+				for (uint32_t i_VertElem{ 0U }; i_VertElem < 3U; ++i_VertElem) {
+					uint32_t idx{ 0U };
+					it = std::from_chars(it, it_End, idx).ptr;
+					indices.emplace_back(idx - 1U);
+					if (it != it_End) { ++it; }
+				}
+			}
+			for (size_t i{ 0LLU }; i < indices.size(); i += 3LLU) {
+				vertices_.emplace_back(indices[i], indices[i + 1LLU], indices[i + 2LLU]);
+			}
+		}
+
+		template<typename T_ReadFace>
+		void ParseFaces(std::vector<std::string> const& lines_, std::vector<Vertex>& vertices_, T_ReadFace&& readFace_) {
+			vertices_.clear();
+			std::istringstream iss{};
+			for (auto const& line : lines_) {
+				iss.clear();
+				iss.str(line);
+				readFace_(iss, vertices_);
+			}
+		}
+
+		//----	------	------	------	------	----//
+		//	Caves								//
+		//----	------	------	------	------	----//
+
+		struct Tile {
+			int32_t x;
+			int32_t y;
+		};
+
+		constexpr uint32_t MapWidth{ 128U };
+		constexpr uint32_t MapHeight{ 64U };
+		constexpr size_t MinSize_Cave{ 16LLU };
+
+		// Noise at the wall probability CellularAutomata starts from, before smoothing: many tiny pockets and a few large caves.
+		std::vector<int> RandomMap(uint32_t seed_) {
+			std::mt19937 rndGen{ seed_ };
+			std::vector<int> map(MapWidth * MapHeight, 1);
+			for (uint32_t y{ 1U }; y < MapHeight - 1U; ++y) {
+				for (uint32_t x{ 1U }; x < MapWidth - 1U; ++x) {
+					map[y * MapWidth + x] = ((rndGen() & 0xFFFFU) < 0x7333U) ? 1 : 0;
+				}
+			}
+			return map;
+		}
+
+		// IdentifyCaves with an explicit stack: floods each open region into its own list and drops the ones below MinSize_Cave.
+		template<typename T_Caves>
+		void IdentifyCaves(std::vector<int> map_, T_Caves& caves_) {
+			caves_.clear();
+			std::vector<Tile> stack{};
+			for (int32_t y{ 0 }; y < static_cast<int32_t>(MapHeight); ++y) {
+				for (int32_t x{ 0 }; x < static_cast<int32_t>(MapWidth); ++x) {
+					if (map_[y * MapWidth + x] != 0) { continue; }
+
+					auto& cave{ caves_.emplace_back() };
+					stack.push_back(Tile{ x, y });
+					map_[y * MapWidth + x] = 2;
+					while (!stack.empty()) {
+						Tile const tile{ stack.back() };
+						stack.pop_back();
+						cave.emplace_back(tile);
+						for (Tile const d : { Tile{ -1, 0 }, Tile{ 1, 0 }, Tile{ 0, -1 }, Tile{ 0, 1 } }) {
+							int& neighbour{ map_[(tile.y + d.y) * MapWidth + (tile.x + d.x)] };
+							if (neighbour == 0) {
+								neighbour = 2;
+								stack.push_back(Tile{ tile.x + d.x, tile.y + d.y });
+							}
+						}
+					}
+					if (cave.size() < MinSize_Cave) { caves_.pop_back(); }
+				}
+			}
+		}
+
+		template<typename T_CaveTiles>
+		using Caves = std::vector<T_CaveTiles, CountingAllocator<T_CaveTiles>>;
+		using CaveTiles_Vector = std::vector<Tile, CountingAllocator<Tile>>;
+		using CaveTiles_Small = Lumina::SmallVector<Tile, 16U, CountingAllocator<Tile>>;
+
+		template<typename T_Func>
+		uint64_t CountAllocations(T_Func&& func_) {
+			uint64_t const num_Before{ AllocationCounter::Num_Allocations };
+			func_();
+			return AllocationCounter::Num_Allocations - num_Before;
+		}
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		suite_.Verify("Container/SmallVector/MatchesVector/Trivial", [] () {
+			return MatchesVector<uint32_t, 4U>(1U, [] (uint32_t i_) { return i_; });
+		});
+		suite_.Verify("Container/SmallVector/MatchesVector/String", [] () {
+			// Longer than the small-string buffer, so that leaks and double frees show up under a sanitizer.
+			return MatchesVector<std::string, 3U>(2U, [] (uint32_t i_) { return std::string(24LLU, 'a') + std::to_string(i_); });
+		});
+		suite_.Verify("Container/SmallVector/ReadFace", [] () {
+			auto const lines{ FaceLines(256U) };
+			std::vector<Vertex> vertices_Stream{};
+			std::vector<Vertex> vertices_Small{};
+			ParseFaces(lines, vertices_Stream, ReadFace_Stream);
+			ParseFaces(lines, vertices_Small, ReadFace_FromChars<Lumina::SmallVector<uint32_t, 12U>>);
+			return std::equal(
+				vertices_Stream.cbegin(), vertices_Stream.cend(), vertices_Small.cbegin(), vertices_Small.cend(),
+				[] (Vertex const& lhs_, Vertex const& rhs_) {
+					return (lhs_.Index_Position == rhs_.Index_Position) && (lhs_.Index_TexCoord == rhs_.Index_TexCoord) && (lhs_.Index_Normal == rhs_.Index_Normal);
+				}
+			);
+		});
+		// The savings themselves: a quad's indices never leave the object, and discarded pockets never allocate.
+		suite_.Verify("Container/SmallVector/Allocations", [] () {
+			auto const lines{ FaceLines(256U) };
+			std::vector<Vertex> vertices{};
+			vertices.reserve(lines.size() * 4LLU);
+			uint64_t const num_Face_Vector{
+				CountAllocations([&] () { ParseFaces(lines, vertices, ReadFace_FromChars<std::vector<uint32_t, CountingAllocator<uint32_t>>>); })
+			};
+			uint64_t const num_Face_Small{
+				CountAllocations([&] () { ParseFaces(lines, vertices, ReadFace_FromChars<Lumina::SmallVector<uint32_t, 12U, CountingAllocator<uint32_t>>>); })
+			};
+
+			auto const map{ RandomMap(5U) };
+			Caves<CaveTiles_Vector> caves_Vector{};
+			Caves<CaveTiles_Small> caves_Small{};
+			caves_Vector.reserve(MapWidth * MapHeight);
+			caves_Small.reserve(MapWidth * MapHeight);
+			uint64_t const num_Cave_Vector{ CountAllocations([&] () { IdentifyCaves(map, caves_Vector); }) };
+			uint64_t const num_Cave_Small{ CountAllocations([&] () { IdentifyCaves(map, caves_Small); }) };
+
+			bool const isSameCaves{
+				std::equal(
+					caves_Vector.cbegin(), caves_Vector.cend(), caves_Small.cbegin(), caves_Small.cend(),
+					[] (CaveTiles_Vector const& lhs_, CaveTiles_Small const& rhs_) { return lhs_.size() == rhs_.size(); }
+				)
+			};
+			return isSameCaves && (num_Face_Small == 0LLU) && (num_Face_Vector >= lines.size()) && (num_Cave_Small * 4LLU < num_Cave_Vector);
+		});
+
+		//----	------	------	------	------	----//
+		//	OBJ faces							//
+		//----	------	------	------	------	----//
+
+		auto const lines{ std::make_shared<std::vector<std::string>>(FaceLines(4096U)) };
+		suite_.Add("Container/SmallVector/ReadFace/Stream", [lines] (uint64_t num_Iterations_) {
+			std::vector<Vertex> vertices{};
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				ParseFaces(*lines, vertices, ReadFace_Stream);
+				DoNotOptimize(vertices.data());
+			}
+		});
+		suite_.Add("Container/SmallVector/ReadFace/FromChars+Vector", [lines] (uint64_t num_Iterations_) {
+			std::vector<Vertex> vertices{};
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				ParseFaces(*lines, vertices, ReadFace_FromChars<std::vector<uint32_t>>);
+				DoNotOptimize(vertices.data());
+			}
+		});
+		suite_.Add("Container/SmallVector/ReadFace/FromChars+SmallVector", [lines] (uint64_t num_Iterations_) {
+			std::vector<Vertex> vertices{};
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				ParseFaces(*lines, vertices, ReadFace_FromChars<Lumina::SmallVector<uint32_t, 12U>>);
+				DoNotOptimize(vertices.data());
+			}
+		});
+
+		//----	------	------	------	------	----//
+		//	Caves								//
+		//----	------	------	------	------	----//
+
+		auto const map{ std::make_shared<std::vector<int>>(RandomMap(0x4C554D49U)) };
+		suite_.Add("Container/SmallVector/IdentifyCaves/Vector", [map] (uint64_t num_Iterations_) {
+			std::vector<std::vector<Tile>> caves{};
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				IdentifyCaves(*map, caves);
+				DoNotOptimize(caves.data());
+			}
+		});
+		suite_.Add("Container/SmallVector/IdentifyCaves/SmallVector", [map] (uint64_t num_Iterations_) {
+			std::vector<Lumina::SmallVector<Tile, 16U>> caves{};
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+				IdentifyCaves(*map, caves);
+				DoNotOptimize(caves.data());
+			}
+		});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,243 @@
+export module Benchmark.SpanningTree;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <random>;
+import <memory>;
+
+import <vector>;
+import <algorithm>;
+import <limits>;
+
+import <string>;
+import <format>;
+
+import Benchmark.Harness;
+
+import Lumina.Math.Numerics;
+import Lumina.Math.CellularAutomaton;
+import Lumina.Math.ConnectedComponents;
+import Lumina.Math.SpanningTree;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::SpanningTree {
+	namespace {
+		using Site = Lumina::RegionSpanningTree::Site;
+
+		constexpr uint32_t MinSize_Cave{ 16U };
+
+		// Caves as CellularAutomata makes them, with their boundary tiles as sites;
+		// from a few more walls than it starts with, so that a 512 x 512 map holds a couple of hundred caves.
+		struct CaveMap {
+			uint32_t Width;
+			uint32_t Height;
+			// 1 marks a wall.
+			std::vector<uint8_t> Tiles;
+			uint32_t Num_Caves{ 0U };
+			std::vector<Site> Sites{};
+			// A tile of each cave.
+			std::vector<Lumina::Int2> Seeds{};
+
+			bool IsFloor(uint32_t x_, uint32_t y_) const noexcept { return Tiles[y_ * Width + x_] == 0U; }
+		};
+
+		CaveMap Caves(uint32_t width_, uint32_t height_, uint32_t seed_) {
+			std::mt19937 rndGen{ seed_ };
+			Lumina::CellularAutomaton automaton{};
+			automaton.Resize(width_, height_);
+			for (uint32_t y{ 0U }; y < height_; ++y) {
+				for (uint32_t x{ 0U }; x < width_; ++x) {
+					bool const isBorder{ x == 0U || y == 0U || x + 1U == width_ || y + 1U == height_ };
+					automaton.Grid().Set(x, y, isBorder || rndGen() % 100U < 50U);
+				}
+			}
+			automaton.Step(Lumina::AutomatonRule::Caves(), 4U);
+
+			CaveMap map{ width_, height_, std::vector<uint8_t>(width_ * height_) };
+			for (uint32_t y{ 0U }; y < height_; ++y) {
+				for (uint32_t x{ 0U }; x < width_; ++x) { map.Tiles[y * width_ + x] = automaton.Grid()(x, y) ? 1U : 0U; }
+			}
+
+			Lumina::ConnectedComponents components{};
+			components.Label(width_, height_, [&map] (uint32_t x_, uint32_t y_) { return map.IsFloor(x_, y_); });
+			std::vector<uint32_t> idx_Caves(components.Num_Components() + 1U, std::numeric_limits<uint32_t>::max());
+			for (uint32_t label{ 1U }; label <= components.Num_Components(); ++label) {
+				if (components[label].Area >= MinSize_Cave) { idx_Caves[label] = map.Num_Caves++; }
+			}
+			map.Seeds.resize(map.Num_Caves);
+			for (uint32_t y{ 1U }; y + 1U < height_; ++y) {
+				for (uint32_t x{ 1U }; x + 1U < width_; ++x) {
+					uint32_t const label{ components(x, y) };
+					if (label == Lumina::ConnectedComponents::Background) { continue; }
+					uint32_t const idx_Cave{ idx_Caves[label] };
+					if (idx_Cave == std::numeric_limits<uint32_t>::max()) { continue; }
+
+					Lumina::Int2 const tile{ static_cast<int32_t>(x), static_cast<int32_t>(y) };
+					map.Seeds[idx_Cave] = tile;
+					if (components(x - 1U, y) != label || components(x + 1U, y) != label || components(x, y - 1U) != label || components(x, y + 1U) != label) {
+						map.Sites.emplace_back(tile, idx_Cave);
+					}
+				}
+			}
+			return map;
+		}
+
+		// The minimum spanning tree's total by Prim over every pair of sites: quadratic, and sure.
+		uint64_t BruteForceWeight(CaveMap const& map_) {
+			uint32_t const num_Caves{ map_.Num_Caves };
+			std::vector<uint32_t> nearest(static_cast<size_t>(num_Caves) * num_Caves, std::numeric_limits<uint32_t>::max());
+			for (size_t i{ 0LLU }; i < map_.Sites.size(); ++i) {
+				for (size_t j{ i + 1LLU }; j < map_.Sites.size(); ++j) {
+					Site const& a{ map_.Sites[i] };
+					Site const& b{ map_.Sites[j] };
+					if (a.Region == b.Region) { continue; }
+					int32_t const dx{ a.Cell.x - b.Cell.x };
+					int32_t const dy{ a.Cell.y - b.Cell.y };
+					uint32_t const distance2{ static_cast<uint32_t>(dx * dx + dy * dy) };
+					uint32_t& ab{ nearest[a.Region * num_Caves + b.Region] };
+					ab = std::min(ab, distance2);
+					nearest[b.Region * num_Caves + a.Region] = ab;
+				}
+			}
+
+			uint64_t weight{ 0LLU };
+			std::vector<uint32_t> best(num_Caves, std::numeric_limits<uint32_t>::max());
+			std::vector<bool> isInTree(num_Caves, false);
+			best[0] = 0U;
+			for (uint32_t step{ 0U }; step < num_Caves; ++step) {
+				uint32_t next{ 0U };
+				uint32_t nextWeight{ std::numeric_limits<uint32_t>::max() };
+				for (uint32_t i{ 0U }; i < num_Caves; ++i) {
+					if (!isInTree[i] && best[i] <= nextWeight) {
+						next = i;
+						nextWeight = best[i];
+					}
+				}
+				isInTree[next] = true;
+				weight += nextWeight;
+				for (uint32_t i{ 0U }; i < num_Caves; ++i) { best[i] = std::min(best[i], nearest[next * num_Caves + i]); }
+			}
+			return weight;
+		}
+
+		// Digs every link as an L of floor and checks that all caves became one.
+		bool IsConnected(CaveMap map_, std::vector<Lumina::RegionSpanningTree::Link> const& links_) {
+			for (auto const& link : links_) {
+				Lumina::Int2 pos{ link.From };
+				while (pos.x != link.To.x) {
+					map_.Tiles[pos.y * map_.Width + pos.x] = 0U;
+					pos.x += (pos.x < link.To.x) ? 1 : -1;
+				}
+				while (pos.y != link.To.y) {
+					map_.Tiles[pos.y * map_.Width + pos.x] = 0U;
+					pos.y += (pos.y < link.To.y) ? 1 : -1;
+				}
+			}
+
+			Lumina::ConnectedComponents components{};
+			components.Label(map_.Width, map_.Height, [&map_] (uint32_t x_, uint32_t y_) { return map_.IsFloor(x_, y_); });
+			if (map_.Seeds.empty()) { return true; }
+			uint32_t const label{ components(static_cast<uint32_t>(map_.Seeds[0].x), static_cast<uint32_t>(map_.Seeds[0].y)) };
+			return std::ranges::all_of(map_.Seeds, [&] (Lumina::Int2 const& seed_) { return components(static_cast<uint32_t>(seed_.x), static_cast<uint32_t>(seed_.y)) == label; });
+		}
+
+		uint64_t TreeWeight(Lumina::RegionSpanningTree const& tree_) {
+			uint64_t weight{ 0LLU };
+			for (uint32_t i{ 0U }; i < tree_.Num_TreeLinks(); ++i) { weight += tree_.Links()[i].Distance2; }
+			return weight;
+		}
+
+		// Built on first use, so that a filtered run does not generate the larger maps for nothing.
+		struct LazyMap {
+			CaveMap const& Get() {
+				if (!Instance) { Instance = std::make_unique<CaveMap>(Caves(Side, Side, 0x4C554D49U)); }
+				return *Instance;
+			}
+
+			uint32_t Side;
+			std::unique_ptr<CaveMap> Instance{};
+		};
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		suite_.Verify("Math/SpanningTree/Minimal", [] () {
+			for (uint32_t seed{ 0U }; seed < 16U; ++seed) {
+				CaveMap const map{ Caves((seed < 12U) ? 128U : 256U, (seed < 12U) ? 64U : 192U, seed) };
+				Lumina::RegionSpanningTree tree{};
+				tree.Build(map.Num_Caves, map.Sites);
+				if (map.Num_Caves > 0U && tree.Num_TreeLinks() != map.Num_Caves - 1U) { return false; }
+				if (TreeWeight(tree) != BruteForceWeight(map)) { return false; }
+			}
+			return true;
+		});
+		suite_.Verify("Math/SpanningTree/Connected", [] () {
+			for (uint32_t seed{ 0U }; seed < 4U; ++seed) {
+				CaveMap const map{ Caves(512U, 512U, seed) };
+				Lumina::RegionSpanningTree tree{};
+				tree.Build(map.Num_Caves, map.Sites);
+				if (map.Num_Caves < 100U || !IsConnected(map, tree.Links())) { return false; }
+			}
+			return true;
+		});
+		// Regions far beyond the first radius, which it has to grow to reach.
+		suite_.Verify("Math/SpanningTree/Distant", [] () {
+			std::vector<Site> const sites{
+				{ { 0, 0 }, 0U }, { { 1, 0 }, 0U }, { { 3, 0 }, 1U },
+				{ { 500, 0 }, 2U }, { { 500, 900 }, 3U }, { { 0, 1000 }, 4U },
+			};
+			Lumina::RegionSpanningTree tree{};
+			tree.Build(5U, sites);
+			return tree.Num_TreeLinks() == 4U && TreeWeight(tree) == 4U + 497U * 497U + 900U * 900U + 500U * 500U + 100U * 100U;
+		});
+		suite_.Verify("Math/SpanningTree/ExtraLinks", [] () {
+			CaveMap const map{ Caves(512U, 512U, 9U) };
+			Lumina::RegionSpanningTree tree{};
+			tree.Build(map.Num_Caves, map.Sites, { .Ratio_ExtraLinks{ 0.25f } });
+			uint32_t const num_Extra{ static_cast<uint32_t>(tree.Links().size()) - tree.Num_TreeLinks() };
+			if (num_Extra == 0U || num_Extra > (tree.Num_TreeLinks() + 3U) / 4U) { return false; }
+
+			// Each extra link joins caves the tree had joined already, and none repeats a tree link.
+			for (uint32_t i{ tree.Num_TreeLinks() }; i < static_cast<uint32_t>(tree.Links().size()); ++i) {
+				auto const& extra{ tree.Links()[i] };
+				for (uint32_t j{ 0U }; j < i; ++j) {
+					auto const& link{ tree.Links()[j] };
+					if (std::min(link.Region0, link.Region1) == std::min(extra.Region0, extra.Region1) &&
+						std::max(link.Region0, link.Region1) == std::max(extra.Region0, extra.Region1)) { return false; }
+				}
+			}
+			return true;
+		});
+
+		//----	------	------	------	------	----//
+		//	Trees								//
+		//----	------	------	------	------	----//
+
+		// Every pair of boundary tiles, as a scan of cave against cave comes to.
+		suite_.Add("Math/SpanningTree/256x256/BruteForce", [map = std::make_shared<LazyMap>(256U)] (uint64_t num_Iterations_) {
+			for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) { DoNotOptimize(BruteForceWeight(map->Get())); }
+		});
+		for (uint32_t const side : { 256U, 1024U, 2048U }) {
+			auto const map{ std::make_shared<LazyMap>(side) };
+			for (float const ratio : { 0.0f, 0.2f }) {
+				suite_.Add(
+					std::format("Math/SpanningTree/{0}x{0}/{1}", side, (ratio > 0.0f) ? "Loops" : "Tree"),
+					[map, ratio] (uint64_t num_Iterations_) {
+						CaveMap const& m{ map->Get() };
+						Lumina::RegionSpanningTree tree{};
+						for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+							tree.Build(m.Num_Caves, m.Sites, { .Ratio_ExtraLinks{ ratio } });
+							DoNotOptimize(tree.Links().size());
+						}
+					}
+				);
+			}
+		}
+	}
+}
\ No newline at end of file
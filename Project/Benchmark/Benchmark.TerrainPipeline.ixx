@@ -0,0 +1,207 @@
+export module Benchmark.TerrainPipeline;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cstring>;
+
+import <chrono>;
+import <thread>;
+import <memory>;
+
+import <vector>;
+
+import <string>;
+import <format>;
+
+import Benchmark.Harness;
+
+import Lumina.TerrainPipeline;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::TerrainPipeline {
+	namespace {
+		using Lumina::TerrainParams;
+		using Pipeline = Lumina::TerrainPipeline;
+
+		// Small enough for the checks to build a few from scratch.
+		constexpr uint32_t Side_Check{ 128U };
+		// As the terrain editor has it.
+		constexpr uint32_t Side_Editor{ 512U };
+
+		// A copy of a result, for comparison.
+		struct Snapshot {
+			std::vector<Lumina::MapSurflet> Surflets{};
+			std::vector<Lumina::Climate> ClimateData{};
+
+			bool operator==(Snapshot const& other_) const noexcept {
+				return
+					std::memcmp(Surflets.data(), other_.Surflets.data(), sizeof(Lumina::MapSurflet) * Surflets.size()) == 0 &&
+					std::memcmp(ClimateData.data(), other_.ClimateData.data(), sizeof(Lumina::Climate) * ClimateData.size()) == 0;
+			}
+		};
+
+		// Waits for the result of submission_, copying it into snapshot_ if given,
+		// and returns the outputs changed since the last read.
+		uint32_t Await(Pipeline& pipeline_, uint64_t submission_, Snapshot* snapshot_ = nullptr) {
+			uint32_t outputs{ 0U };
+			bool isDone{ false };
+			auto const read{
+				[&] (Pipeline::Result const& result_, uint32_t outputs_) {
+					outputs |= outputs_;
+					isDone = (result_.Submission >= submission_);
+					if (!isDone || snapshot_ == nullptr) { return; }
+					size_t const num_Tiles{ static_cast<size_t>(pipeline_.Width()) * pipeline_.Height() };
+					snapshot_->Surflets.assign(result_.Surflets, result_.Surflets + num_Tiles);
+					snapshot_->ClimateData.assign(result_.ClimateData, result_.ClimateData + num_Tiles);
+				}
+			};
+			while (!isDone) {
+				if (!pipeline_.ReadLatest(read)) { std::this_thread::yield(); }
+			}
+			return outputs;
+		}
+
+		// What a pipeline built for params_ from scratch makes.
+		Snapshot FromScratch(TerrainParams const& params_) {
+			Pipeline pipeline{ Side_Check, Side_Check, params_, {} };
+			Snapshot snapshot{};
+			Await(pipeline, 0LLU, &snapshot);
+			return snapshot;
+		}
+
+		// The stages that ran between two statistics, as bits.
+		uint32_t StagesRun(Pipeline::Statistics const& before_, Pipeline::Statistics const& after_) {
+			uint32_t stages{ 0U };
+			for (uint32_t stage{ 0U }; stage < Pipeline::NUM_STAGES; ++stage) {
+				stages |= (after_.Num_Runs[stage] != before_.Num_Runs[stage]) ? (1U << stage) : 0U;
+			}
+			return stages;
+		}
+
+		// Submits the edit, waits, and checks both what ran and what came out against a pipeline built for the result.
+		bool Edit(Pipeline& pipeline_, TerrainParams& params_, void (*edit_)(TerrainParams&), uint32_t stages_, uint32_t outputs_) {
+			edit_(params_);
+			Pipeline::Statistics const before{ pipeline_.GetStatistics() };
+			Snapshot snapshot{};
+			uint32_t const outputs{ Await(pipeline_, pipeline_.Submit(params_), &snapshot) };
+			return StagesRun(before, pipeline_.GetStatistics()) == stages_ && outputs == outputs_ && snapshot == FromScratch(params_);
+		}
+
+		// A parameter flipped between two values at each submission, and the result awaited.
+		struct Tweak {
+			explicit Tweak(void (*flip_)(TerrainParams&, bool)) : Flip{ flip_ } {}
+
+			Pipeline& Get() {
+				if (!Instance) {
+					Instance = std::make_unique<Pipeline>(Side_Editor, Side_Editor, Params, std::chrono::nanoseconds{});
+					Await(*Instance, 0LLU);
+				}
+				return *Instance;
+			}
+
+			void (*Flip)(TerrainParams&, bool);
+			TerrainParams Params{};
+			bool IsFlipped{ false };
+			std::unique_ptr<Pipeline> Instance{};
+		};
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		// Each edit runs the stages it reaches and no more, changes the outputs those stages make,
+		// and comes out as a pipeline built for the edited params from scratch does.
+		suite_.Verify("Terrain/Pipeline/Incremental", [] () {
+			constexpr uint32_t Surflets{ Pipeline::OUTPUT_SURFLETS };
+			constexpr uint32_t Climate{ Pipeline::OUTPUT_CLIMATE };
+			constexpr uint32_t Elevation{ (1U << Pipeline::REDISTRIBUTION) | (1U << Pipeline::TERRACES) | (1U << Pipeline::NORMALS) };
+			constexpr uint32_t Temperature{ 1U << Pipeline::TEMPERATURE };
+
+			TerrainParams params{};
+			Pipeline pipeline{ Side_Check, Side_Check, params, {} };
+			if (Await(pipeline, 0LLU) != Pipeline::OUTPUT_ALL) { return false; }
+			return
+				Edit(pipeline, params, [] (TerrainParams& params_) { params_.Temperature.Redist = 1.5f; }, Temperature, Climate) &&
+				Edit(pipeline, params, [] (TerrainParams& params_) { params_.Precipitation.Offset.x = 7.0f; },
+					(1U << Pipeline::PRECIPITATION_NOISE) | (1U << Pipeline::PRECIPITATION), Climate) &&
+				Edit(pipeline, params, [] (TerrainParams& params_) { params_.Elevation.Redist = 1.5f; }, Elevation | Temperature, Surflets | Climate) &&
+				Edit(pipeline, params, [] (TerrainParams& params_) { params_.Insulation = 0.5f; }, Elevation | Temperature, Surflets | Climate) &&
+				// The factor counts only with terraces on.
+				Edit(pipeline, params, [] (TerrainParams& params_) { params_.TerraceFactor = 4.0f; }, 0U, 0U) &&
+				Edit(pipeline, params, [] (TerrainParams& params_) { params_.IsFormingTerraces = true; },
+					(1U << Pipeline::TERRACES) | (1U << Pipeline::NORMALS) | Temperature, Surflets | Climate) &&
+				Edit(pipeline, params, [] (TerrainParams& params_) { params_.Elevation.Num_Octaves = 4U; },
+					(1U << Pipeline::ELEVATION_NOISE) | Elevation | Temperature, Surflets | Climate);
+		});
+		// A burst of submissions within the debounce delay makes one run, of the last of them.
+		suite_.Verify("Terrain/Pipeline/Debounce", [] () {
+			TerrainParams params{};
+			Pipeline pipeline{ Side_Check, Side_Check, params, std::chrono::milliseconds{ 50 } };
+			Await(pipeline, 0LLU);
+			uint64_t submission{ 0LLU };
+			for (uint32_t i{ 1U }; i <= 20U; ++i) {
+				params.Elevation.Frequency = 0.4f + 0.01f * static_cast<float>(i);
+				submission = pipeline.Submit(params);
+			}
+			Snapshot snapshot{};
+			Await(pipeline, submission, &snapshot);
+			Pipeline::Statistics const statistics{ pipeline.GetStatistics() };
+			return
+				statistics.Num_Results == 2LLU && statistics.Num_Runs[Pipeline::ELEVATION_NOISE] == 2LLU &&
+				statistics.Latency_Last >= std::chrono::milliseconds{ 50 } &&
+				snapshot == FromScratch(params);
+		});
+		// Params coming while a run is under way cut it short, and what comes out is of the last of them.
+		suite_.Verify("Terrain/Pipeline/Superseded", [] () {
+			TerrainParams params{};
+			Pipeline pipeline{ Side_Check, Side_Check, params, {} };
+			uint64_t submission{ 0LLU };
+			for (uint32_t i{ 1U }; i <= 20U; ++i) {
+				params.Elevation.Num_Octaves = 1U + i % 8U;
+				params.Temperature.Offset.x = static_cast<float>(i);
+				submission = pipeline.Submit(params);
+				std::this_thread::yield();
+			}
+			Snapshot snapshot{};
+			Await(pipeline, submission, &snapshot);
+			return snapshot == FromScratch(params);
+		});
+
+		//----	------	------	------	------	----//
+		//	Latency								//
+		//----	------	------	------	------	----//
+
+		// From submitting a change to reading its result, at the editor's size without the debounce delay.
+		// Full is what every change cost before the stages were kept.
+		auto const addLatency{
+			[&suite_] (std::string const& name_, void (*flip_)(TerrainParams&, bool)) {
+				auto const tweak{ std::make_shared<Tweak>(flip_) };
+				suite_.Add(std::format("Terrain/Pipeline/Latency/{}", name_), [tweak] (uint64_t num_Iterations_) {
+					Pipeline& pipeline{ tweak->Get() };
+					for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+						tweak->IsFlipped = !tweak->IsFlipped;
+						tweak->Flip(tweak->Params, tweak->IsFlipped);
+						DoNotOptimize(Await(pipeline, pipeline.Submit(tweak->Params)));
+					}
+				});
+			}
+		};
+		addLatency("Full", [] (TerrainParams& params_, bool isFlipped_) {
+			params_.Elevation.Frequency = isFlipped_ ? 0.5f : 0.4f;
+			params_.Temperature.Frequency = isFlipped_ ? 1.5f : 1.0f;
+			params_.Precipitation.Frequency = isFlipped_ ? 2.5f : 2.0f;
+		});
+		addLatency("ElevationNoise", [] (TerrainParams& params_, bool isFlipped_) { params_.Elevation.Frequency = isFlipped_ ? 0.5f : 0.4f; });
+		addLatency("Redistribution", [] (TerrainParams& params_, bool isFlipped_) { params_.Elevation.Redist = isFlipped_ ? 1.5f : 2.0f; });
+		addLatency("Terraces", [] (TerrainParams& params_, bool isFlipped_) {
+			params_.IsFormingTerraces = true;
+			params_.TerraceFactor = isFlipped_ ? 4.0f : 8.0f;
+		});
+		addLatency("Temperature", [] (TerrainParams& params_, bool isFlipped_) { params_.Temperature.Redist = isFlipped_ ? 1.5f : 1.0f; });
+		addLatency("Precipitation", [] (TerrainParams& params_, bool isFlipped_) { params_.Precipitation.Redist = isFlipped_ ? 1.5f : 1.0f; });
+	}
+}
\ No newline at end of file
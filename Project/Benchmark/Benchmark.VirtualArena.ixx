@@ -0,0 +1,208 @@
+export module Benchmark.VirtualArena;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cstring>;
+
+import <random>;
+import <memory>;
+import <memory_resource>;
+import <new>;
+
+import <vector>;
+import <numeric>;
+import <utility>;
+
+import <string_view>;
+import <format>;
+
+import Benchmark.Harness;
+
+import Lumina.Math.PerlinNoise;
+import Lumina.Container.VirtualArena;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::VirtualArena {
+	namespace {
+		using Lumina::PAGE_SIZE;
+
+		constexpr size_t MiB{ 1024LLU * 1024LLU };
+
+		// A terrain field, a cave map and its double buffer, and a table for dependent loads;
+		// each well past what a small-page TLB covers.
+		constexpr uint32_t FieldSide{ 2048U };
+		constexpr uint32_t GridSide{ 4096U };
+		constexpr uint32_t Num_TableEntries{ 16U * 1024U * 1024U };
+		constexpr uint32_t Num_Hops{ 1U << 20U };
+
+		struct Grids {
+			explicit Grids(PAGE_SIZE pageSize_) : Arena{ 128LLU * MiB, pageSize_ } {
+				Field = Arena.Allocate<float>(FieldSide * FieldSide);
+				Cells = Arena.Allocate<uint8_t>(GridSide * GridSide);
+				Next = Arena.Allocate<uint8_t>(GridSide * GridSide);
+				Table = Arena.Allocate<uint32_t>(Num_TableEntries);
+
+				std::mt19937 rndGen{ 0x4C554D49U };
+				for (uint32_t i{ 0U }; i < GridSide * GridSide; ++i) { Cells[i] = static_cast<uint8_t>(rndGen() % 100U < 45U); }
+				std::memcpy(Next, Cells, GridSide * GridSide);
+				std::memset(Field, 0, sizeof(float) * FieldSide * FieldSide);
+
+				// One cycle through every entry (Sattolo), so that each hop lands somewhere unpredictable.
+				std::iota(Table, Table + Num_TableEntries, 0U);
+				for (uint32_t i{ Num_TableEntries - 1U }; i > 0U; --i) {
+					uint32_t const j{ static_cast<uint32_t>(rndGen() % i) };
+					std::swap(Table[i], Table[j]);
+				}
+			}
+
+			Lumina::VirtualArena Arena;
+			float* Field{ nullptr };
+			uint8_t* Cells{ nullptr };
+			uint8_t* Next{ nullptr };
+			uint32_t* Table{ nullptr };
+		};
+
+		// Built on first use, so that a filtered run does not commit a few hundred megabytes for nothing.
+		using LazyGrids = std::shared_ptr<std::unique_ptr<Grids>>;
+
+		Grids& Get(LazyGrids const& grids_, PAGE_SIZE pageSize_) {
+			if (!*grids_) { *grids_ = std::make_unique<Grids>(pageSize_); }
+			return **grids_;
+		}
+
+		// The cave rule of CellularAutomata: more than four walls around makes a wall, fewer makes a floor.
+		void Step(uint8_t const* cells_, uint8_t* next_) {
+			for (uint32_t y{ 1U }; y < GridSide - 1U; ++y) {
+				uint8_t const* rowAbove{ cells_ + (y - 1U) * GridSide };
+				uint8_t const* row{ cells_ + y * GridSide };
+				uint8_t const* rowBelow{ cells_ + (y + 1U) * GridSide };
+				uint8_t* nextRow{ next_ + y * GridSide };
+				for (uint32_t x{ 1U }; x < GridSide - 1U; ++x) {
+					uint32_t const num_Walls{
+						static_cast<uint32_t>(rowAbove[x - 1U] + rowAbove[x] + rowAbove[x + 1U]) +
+						static_cast<uint32_t>(row[x - 1U] + row[x + 1U]) +
+						static_cast<uint32_t>(rowBelow[x - 1U] + rowBelow[x] + rowBelow[x + 1U])
+					};
+					nextRow[x] = (num_Walls > 4U) ? 1U : ((num_Walls < 4U) ? 0U : row[x]);
+				}
+			}
+		}
+
+		void RegisterPasses(Suite& suite_, std::string_view pages_, PAGE_SIZE pageSize_) {
+			LazyGrids const grids{ std::make_shared<std::unique_ptr<Grids>>() };
+
+			suite_.Add(std::format("Container/VirtualArena/NoiseFill/{}", pages_), [grids, pageSize_] (uint64_t num_Iterations_) {
+				Grids& g{ Get(grids, pageSize_) };
+				Lumina::PerlinNoise const noise{ 4.0f };
+				float const inv_Side{ 1.0f / static_cast<float>(FieldSide) };
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					for (uint32_t v{ 0U }; v < FieldSide; ++v) {
+						float* const row{ g.Field + v * FieldSide };
+						for (uint32_t u{ 0U }; u < FieldSide; ++u) {
+							row[u] = noise(static_cast<float>(u) * inv_Side, static_cast<float>(v) * inv_Side, 0.0f);
+						}
+					}
+					DoNotOptimize(g.Field[i & (FieldSide - 1U)]);
+				}
+			}, sizeof(float) * FieldSide * FieldSide);
+			suite_.Add(std::format("Container/VirtualArena/CAStep/{}", pages_), [grids, pageSize_] (uint64_t num_Iterations_) {
+				Grids& g{ Get(grids, pageSize_) };
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					Step(g.Cells, g.Next);
+					std::swap(g.Cells, g.Next);
+					DoNotOptimize(g.Cells[GridSide + 1U]);
+				}
+			}, 2LLU * GridSide * GridSide);
+			// Dependent loads all over the table; the case where TLB reach matters most.
+			suite_.Add(std::format("Container/VirtualArena/RandomHops/{}", pages_), [grids, pageSize_] (uint64_t num_Iterations_) {
+				Grids& g{ Get(grids, pageSize_) };
+				uint32_t idx{ 0U };
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					for (uint32_t j{ 0U }; j < Num_Hops; ++j) { idx = g.Table[idx]; }
+				}
+				DoNotOptimize(idx);
+			});
+		}
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		suite_.Verify("Container/VirtualArena/CommitsOnDemand", [] () {
+			Lumina::VirtualArena arena{ 1024LLU * MiB };
+			if (arena.Committed() != 0LLU || arena.Capacity() < 1024LLU * MiB) { return false; }
+
+			auto* const small{ arena.Allocate<uint8_t>(100LLU) };
+			small[99] = 1U;
+			if (arena.Committed() != arena.PageSize()) { return false; }
+
+			auto* const large{ arena.Allocate<uint8_t>(10LLU * MiB) };
+			std::memset(large, 0xAB, 10LLU * MiB);
+			return arena.Committed() >= arena.Used() && arena.Committed() < arena.Used() + arena.PageSize() &&
+				large == small + 100LLU;
+		});
+		suite_.Verify("Container/VirtualArena/Alignment", [] () {
+			Lumina::VirtualArena arena{ 16LLU * MiB };
+			for (size_t alignment{ 1LLU }; alignment <= 4096LLU; alignment <<= 1U) {
+				arena.Allocate(1LLU);
+				if ((reinterpret_cast<uintptr_t>(arena.Allocate(3LLU, alignment)) & (alignment - 1LLU)) != 0LLU) { return false; }
+			}
+			return true;
+		});
+		// Trimmed pages come back zeroed on recommit, which shows they really were given back.
+		suite_.Verify("Container/VirtualArena/RewindAndTrim", [] () {
+			Lumina::VirtualArena arena{ 64LLU * MiB };
+			auto* const head{ arena.Allocate<uint8_t>(1LLU) };
+			*head = 7U;
+			auto const marker{ arena.Mark() };
+
+			std::memset(arena.Allocate<uint8_t>(8LLU * MiB), 0xAB, 8LLU * MiB);
+			arena.Rewind(marker);
+			arena.Trim();
+			if (arena.Committed() != arena.PageSize() || arena.Used() != 1LLU) { return false; }
+
+			auto const* const again{ arena.Allocate<uint8_t>(8LLU * MiB) };
+			for (size_t i{ arena.PageSize() }; i < 8LLU * MiB; i += 4096LLU) {
+				if (again[i] != 0U) { return false; }
+			}
+			return *head == 7U;
+		});
+		suite_.Verify("Container/VirtualArena/ThrowsPastCapacity", [] () {
+			Lumina::VirtualArena arena{ 1LLU * MiB };
+			try {
+				[[maybe_unused]] auto* const never{ arena.Allocate(2LLU * MiB) };
+				return false;
+			}
+			catch (std::bad_alloc const&) {}
+			// Still whole after the failure.
+			return arena.Used() == 0LLU && arena.Allocate<uint64_t>(1024LLU) != nullptr;
+		});
+		// Passes whether or not the system grants large pages; only the fallback differs.
+		suite_.Verify("Container/VirtualArena/LargePages", [] () {
+			Lumina::VirtualArena arena{ 64LLU * MiB, PAGE_SIZE::LARGE };
+			if (arena.UsesLargePages() && arena.PageSize() != Lumina::VirtualArena::LargePageSize()) { return false; }
+
+			auto* const values{ arena.Allocate<uint32_t>(8LLU * MiB) };
+			std::iota(values, values + 8LLU * MiB, 0U);
+			return values[8LLU * MiB - 1LLU] == 8LLU * MiB - 1LLU && arena.Committed() >= arena.Used();
+		});
+		suite_.Verify("Container/VirtualArena/Resource", [] () {
+			Lumina::VirtualArena arena{ 64LLU * MiB };
+			std::pmr::vector<uint64_t> values{ &arena.MemoryResource() };
+			values.reserve(1LLU << 20U);
+			for (uint64_t i{ 0LLU }; i < (1LLU << 20U); ++i) { values.emplace_back(i); }
+			return values.back() == (1LLU << 20U) - 1LLU && arena.Used() >= sizeof(uint64_t) << 20U;
+		});
+
+		//----	------	------	------	------	----//
+		//	TLB-sensitive passes				//
+		//----	------	------	------	------	----//
+
+		RegisterPasses(suite_, "SmallPages", PAGE_SIZE::SMALL);
+		RegisterPasses(suite_, "LargePages", PAGE_SIZE::LARGE);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,416 @@
+export module Benchmark.VoxelVolume;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <random>;
+import <memory>;
+
+import <vector>;
+import <algorithm>;
+import <utility>;
+
+import <string>;
+import <format>;
+
+import Benchmark.Harness;
+
+import Lumina.Math.Numerics;
+import Lumina.Math.VoxelVolume;
+
+import Game.MapGenerator;
+
+//////	//////	//////	//////	//////	//////
+
+namespace Benchmark::VoxelVolume {
+	namespace {
+		using Lumina::SparseVoxelVolume;
+		using Lumina::VoxelAutomaton;
+		using Lumina::VoxelComponents;
+		using Lumina::VoxelRule;
+
+		// One byte per voxel, x fastest, worked on one voxel at a time: what the sparse volume must agree with,
+		// and the dense baseline it is measured against.
+		struct NaiveVolume {
+			uint32_t Width;
+			uint32_t Height;
+			uint32_t Depth;
+			std::vector<uint8_t> Voxels;
+			std::vector<uint8_t> Next{};
+
+			size_t Index(uint32_t x_, uint32_t y_, uint32_t z_) const noexcept {
+				return (static_cast<size_t>(z_) * Height + y_) * Width + x_;
+			}
+			// Unset outside.
+			uint8_t At(int32_t x_, int32_t y_, int32_t z_) const noexcept {
+				if (
+					static_cast<uint32_t>(x_) >= Width || static_cast<uint32_t>(y_) >= Height || static_cast<uint32_t>(z_) >= Depth
+				) {
+					return 0U;
+				}
+				return Voxels[Index(static_cast<uint32_t>(x_), static_cast<uint32_t>(y_), static_cast<uint32_t>(z_))];
+			}
+
+			void Step(VoxelRule const& rule_) {
+				Next.resize(Voxels.size());
+				for (int32_t z{ 0 }; z < static_cast<int32_t>(Depth); ++z) {
+					for (int32_t y{ 0 }; y < static_cast<int32_t>(Height); ++y) {
+						for (int32_t x{ 0 }; x < static_cast<int32_t>(Width); ++x) {
+							uint32_t num_Set{ 0U };
+							for (int32_t dz{ -1 }; dz <= 1; ++dz) {
+								for (int32_t dy{ -1 }; dy <= 1; ++dy) {
+									for (int32_t dx{ -1 }; dx <= 1; ++dx) { num_Set += At(x + dx, y + dy, z + dz); }
+								}
+							}
+							uint8_t const voxel{ At(x, y, z) };
+							num_Set -= voxel;
+							uint32_t const rule{ (voxel != 0U) ? rule_.Survival : rule_.Birth };
+							Next[Index(static_cast<uint32_t>(x), static_cast<uint32_t>(y), static_cast<uint32_t>(z))] = static_cast<uint8_t>((rule >> num_Set) & 1U);
+						}
+					}
+				}
+				Voxels.swap(Next);
+			}
+
+			NaiveVolume Surface() const {
+				NaiveVolume surface{ Width, Height, Depth, std::vector<uint8_t>(Voxels.size()) };
+				for (int32_t z{ 0 }; z < static_cast<int32_t>(Depth); ++z) {
+					for (int32_t y{ 0 }; y < static_cast<int32_t>(Height); ++y) {
+						for (int32_t x{ 0 }; x < static_cast<int32_t>(Width); ++x) {
+							if (At(x, y, z) == 0U) { continue; }
+							bool const isInner{
+								At(x - 1, y, z) != 0U && At(x + 1, y, z) != 0U && At(x, y - 1, z) != 0U &&
+								At(x, y + 1, z) != 0U && At(x, y, z - 1) != 0U && At(x, y, z + 1) != 0U
+							};
+							surface.Voxels[Index(static_cast<uint32_t>(x), static_cast<uint32_t>(y), static_cast<uint32_t>(z))] = isInner ? 0U : 1U;
+						}
+					}
+				}
+				return surface;
+			}
+
+			// 6-connected flood fill from every set voxel not yet reached, in scan order; returns the number of components.
+			uint32_t Label(std::vector<uint32_t>& labels_, std::vector<uint64_t>& volumes_) const {
+				labels_.assign(Voxels.size(), 0U);
+				volumes_.clear();
+				std::vector<Lumina::Int3> stack{};
+				for (uint32_t z{ 0U }; z < Depth; ++z) {
+					for (uint32_t y{ 0U }; y < Height; ++y) {
+						for (uint32_t x{ 0U }; x < Width; ++x) {
+							if (Voxels[Index(x, y, z)] == 0U || labels_[Index(x, y, z)] != 0U) { continue; }
+
+							uint32_t const label{ static_cast<uint32_t>(volumes_.size()) + 1U };
+							uint64_t& volume{ volumes_.emplace_back(0LLU) };
+							labels_[Index(x, y, z)] = label;
+							stack.push_back({ static_cast<int32_t>(x), static_cast<int32_t>(y), static_cast<int32_t>(z) });
+							while (!stack.empty()) {
+								Lumina::Int3 const pos{ stack.back() };
+								stack.pop_back();
+								++volume;
+
+								constexpr int32_t Offsets[6][3]{ { -1, 0, 0 }, { 1, 0, 0 }, { 0, -1, 0 }, { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 } };
+								for (auto const& offset : Offsets) {
+									Lumina::Int3 const next{ pos.x + offset[0], pos.y + offset[1], pos.z + offset[2] };
+									if (At(next.x, next.y, next.z) == 0U) { continue; }
+									uint32_t& nextLabel{ labels_[Index(static_cast<uint32_t>(next.x), static_cast<uint32_t>(next.y), static_cast<uint32_t>(next.z))] };
+									if (nextLabel != 0U) { continue; }
+									nextLabel = label;
+									stack.push_back(next);
+								}
+							}
+						}
+					}
+				}
+				return static_cast<uint32_t>(volumes_.size());
+			}
+		};
+
+		NaiveVolume Densify(SparseVoxelVolume const& sparse_) {
+			NaiveVolume dense{
+				sparse_.Width(), sparse_.Height(), sparse_.Depth(),
+				std::vector<uint8_t>(static_cast<size_t>(sparse_.Width()) * sparse_.Height() * sparse_.Depth())
+			};
+			for (uint32_t idx_Brick{ 0U }; idx_Brick < sparse_.Num_Bricks(); ++idx_Brick) {
+				Lumina::Int3 const coord{ sparse_.BrickCoord(idx_Brick) };
+				auto const& brick{ sparse_.GetBrick(idx_Brick) };
+				for (uint32_t z{ 0U }; z < 8U; ++z) {
+					for (uint32_t bit{ 0U }; bit < 64U; ++bit) {
+						if (((brick[z] >> bit) & 1LLU) == 0LLU) { continue; }
+						dense.Voxels[
+							dense.Index(
+								static_cast<uint32_t>(coord.x) * 8U + (bit & 7U),
+								static_cast<uint32_t>(coord.y) * 8U + (bit >> 3U),
+								static_cast<uint32_t>(coord.z) * 8U + z
+							)
+						] = 1U;
+					}
+				}
+			}
+			return dense;
+		}
+
+		// Voxels set at random within a box, so that some bricks are full, some sparse and some never made.
+		SparseVoxelVolume RandomVolume(uint32_t size_, uint32_t seed_, uint32_t percent_Set_) {
+			std::mt19937 rndGen{ seed_ };
+			SparseVoxelVolume volume{ size_, size_, size_ };
+			for (uint32_t z{ 0U }; z < size_; ++z) {
+				for (uint32_t y{ 0U }; y < size_ * 3U / 4U; ++y) {
+					for (uint32_t x{ size_ / 5U }; x < size_; ++x) {
+						if (rndGen() % 100U < percent_Set_) { volume.Set(x, y, z, true); }
+					}
+				}
+			}
+			// And a ball, cut by the side of the volume.
+			volume.FillSphere({ static_cast<int32_t>(size_) - 4, 5, static_cast<int32_t>(size_ / 2U) }, static_cast<int32_t>(size_ / 3U));
+			return volume;
+		}
+
+		// Generated on first use, so that a filtered run does not dig 1024^3 caves for nothing.
+		struct LazyCaves {
+			Game::VoxelCaves const& Get() {
+				if (!Caves) {
+					Caves = std::make_unique<Game::VoxelCaves>();
+					Caves->Run(Params);
+				}
+				return *Caves;
+			}
+
+			Game::VoxelCaveParams Params;
+			std::unique_ptr<Game::VoxelCaves> Caves{};
+		};
+
+		Game::VoxelCaveParams CaveParams(uint32_t size_) {
+			// Walks scaled with the volume's side, so that caves fill about the same share of it at either size.
+			uint32_t const scale{ size_ / 256U };
+			return Game::VoxelCaveParams{
+				.Width{ size_ }, .Height{ size_ }, .Depth{ size_ },
+				.Seed{ 7LLU },
+				.Num_Walkers{ 24U * scale * scale },
+				.Num_StepsPerWalker{ 4096U * scale },
+			};
+		}
+	}
+
+	export void Register(Suite& suite_) {
+		//----	------	------	------	------	----//
+		//	Checks								//
+		//----	------	------	------	------	----//
+
+		// Random rules on random volumes, generation after generation, voxel for voxel; bricks at the sides of the volume
+		// and beside bricks never made included.
+		suite_.Verify("Math/VoxelVolume/MatchesNaive/Step", [] () {
+			std::mt19937 rndGen{ 42U };
+			std::vector<VoxelRule> rules{
+				VoxelRule::AtLeast(14U, 10U),
+				VoxelRule::AtLeast(1U, 0U),
+				VoxelRule::AtLeast(27U, 27U),
+				VoxelRule{ .Birth{ 1U << 4U }, .Survival{ (1U << 4U) | (1U << 5U) } },
+			};
+			for (uint32_t i{ 0U }; i < 4U; ++i) { rules.emplace_back(static_cast<uint32_t>(rndGen() & 0x7FFFFFEU), static_cast<uint32_t>(rndGen() & 0x7FFFFFFU)); }
+
+			for (uint32_t const size : { 8U, 24U, 40U }) {
+				for (uint32_t const percent_Set : { 10U, 50U }) {
+					for (auto const& rule : rules) {
+						VoxelAutomaton automaton{};
+						automaton.Volume() = RandomVolume(size, size + percent_Set, percent_Set);
+						NaiveVolume naive{ Densify(automaton.Volume()) };
+						for (uint32_t step{ 0U }; step < 3U; ++step) {
+							naive.Step(rule);
+							automaton.Step(rule);
+							if (Densify(automaton.Volume()).Voxels != naive.Voxels) { return false; }
+						}
+					}
+				}
+			}
+			return true;
+		});
+		suite_.Verify("Math/VoxelVolume/MatchesNaive/Surface", [] () {
+			for (uint32_t const percent_Set : { 10U, 50U, 90U, 100U }) {
+				SparseVoxelVolume const volume{ RandomVolume(40U, percent_Set, percent_Set) };
+				SparseVoxelVolume surface{};
+				volume.ExtractSurface(surface);
+				if (Densify(surface).Voxels != Densify(volume).Surface().Voxels) { return false; }
+			}
+			return true;
+		});
+		// Same partition, same volumes and bounds, label by label, as a flood fill; and the same numbering
+		// once each side is mapped onto the other.
+		suite_.Verify("Math/VoxelVolume/MatchesNaive/Label", [] () {
+			for (uint32_t const percent_Set : { 10U, 25U, 35U, 60U }) {
+				SparseVoxelVolume const volume{ RandomVolume(40U, percent_Set + 1U, percent_Set) };
+				NaiveVolume const naive{ Densify(volume) };
+				std::vector<uint32_t> labels{};
+				std::vector<uint64_t> volumes{};
+				uint32_t const num_Components{ naive.Label(labels, volumes) };
+
+				VoxelComponents components{};
+				components.Label(volume);
+				if (components.Num_Components() != num_Components) { return false; }
+
+				std::vector<uint32_t> toNaive(num_Components + 1LLU, 0U);
+				std::vector<Lumina::Int3> mins(num_Components + 1LLU, { 1 << 30, 1 << 30, 1 << 30 });
+				std::vector<Lumina::Int3> maxs(num_Components + 1LLU, { -1, -1, -1 });
+				for (uint32_t z{ 0U }; z < naive.Depth; ++z) {
+					for (uint32_t y{ 0U }; y < naive.Height; ++y) {
+						for (uint32_t x{ 0U }; x < naive.Width; ++x) {
+							uint32_t const expected{ labels[naive.Index(x, y, z)] };
+							uint32_t const label{ components(volume, x, y, z) };
+							if ((expected == 0U) != (label == VoxelComponents::Background)) { return false; }
+							if (expected == 0U) { continue; }
+
+							if (toNaive[label] == 0U) { toNaive[label] = expected; }
+							else if (toNaive[label] != expected) { return false; }
+							Lumina::Int3& min{ mins[label] };
+							Lumina::Int3& max{ maxs[label] };
+							min = { std::min(min.x, static_cast<int32_t>(x)), std::min(min.y, static_cast<int32_t>(y)), std::min(min.z, static_cast<int32_t>(z)) };
+							max = { std::max(max.x, static_cast<int32_t>(x)), std::max(max.y, static_cast<int32_t>(y)), std::max(max.z, static_cast<int32_t>(z)) };
+						}
+					}
+				}
+				for (uint32_t label{ 1U }; label <= num_Components; ++label) {
+					auto const& component{ components[label] };
+					if (component.Volume != volumes[toNaive[label] - 1U]) { return false; }
+					if (component.Min.x != mins[label].x || component.Min.y != mins[label].y || component.Min.z != mins[label].z) { return false; }
+					if (component.Max.x != maxs[label].x || component.Max.y != maxs[label].y || component.Max.z != maxs[label].z) { return false; }
+				}
+			}
+			return true;
+		});
+		suite_.Verify("Math/VoxelVolume/Compact", [] () {
+			SparseVoxelVolume volume{ RandomVolume(40U, 3U, 20U) };
+			NaiveVolume const expected{ Densify(volume) };
+			uint32_t const num_Bricks{ volume.Num_Bricks() };
+			// Set and unset again: a brick made for nothing.
+			volume.Set(2U, 39U, 2U, true);
+			volume.Set(2U, 39U, 2U, false);
+			if (volume.Num_Bricks() != num_Bricks + 1U) { return false; }
+
+			volume.Compact();
+			return volume.Num_Bricks() == num_Bricks && Densify(volume).Voxels == expected.Voxels && volume(2U, 39U, 2U) == false;
+		});
+
+		// Voxel for voxel from fresh generators and from one reused; caves past the minimum size, surfaces within them.
+		suite_.Verify("Game/VoxelCaves/Deterministic", [] () {
+			auto const same{
+				[] (SparseVoxelVolume const& lhs_, SparseVoxelVolume const& rhs_) {
+					if (lhs_.Num_Bricks() != rhs_.Num_Bricks()) { return false; }
+					for (uint32_t idx_Brick{ 0U }; idx_Brick < lhs_.Num_Bricks(); ++idx_Brick) {
+						Lumina::Int3 const lhs{ lhs_.BrickCoord(idx_Brick) };
+						Lumina::Int3 const rhs{ rhs_.BrickCoord(idx_Brick) };
+						if (lhs.x != rhs.x || lhs.y != rhs.y || lhs.z != rhs.z || lhs_.GetBrick(idx_Brick) != rhs_.GetBrick(idx_Brick)) { return false; }
+					}
+					return true;
+				}
+			};
+
+			Game::VoxelCaves reused{};
+			for (uint64_t seed{ 0LLU }; seed < 3LLU; ++seed) {
+				Game::VoxelCaveParams const params{ .Width{ 64U }, .Height{ 96U }, .Depth{ 128U }, .Seed{ seed }, .Num_Walkers{ 6U }, .Num_StepsPerWalker{ 1024U } };
+				Game::VoxelCaves expected{};
+				expected.Run(params);
+				Game::VoxelCaves again{};
+				again.Run(params);
+				reused.Run(params);
+				if (!same(expected.GetVolume(), again.GetVolume()) || !same(expected.GetVolume(), reused.GetVolume())) { return false; }
+				if (!same(expected.GetSurface(), reused.GetSurface()) || expected.GetVolume().Num_Voxels() == 0LLU) { return false; }
+
+				for (auto const& cave : expected.GetCaves().Components()) {
+					if (cave.Volume < params.MinSize_Cave) { return false; }
+				}
+				NaiveVolume const volume{ Densify(expected.GetVolume()) };
+				NaiveVolume const surface{ Densify(expected.GetSurface()) };
+				for (size_t i{ 0LLU }; i < volume.Voxels.size(); ++i) {
+					if (surface.Voxels[i] > volume.Voxels[i]) { return false; }
+				}
+			}
+
+			Game::VoxelCaves other{};
+			other.Run({ .Width{ 64U }, .Height{ 96U }, .Depth{ 128U }, .Seed{ 1LLU }, .Num_Walkers{ 6U }, .Num_StepsPerWalker{ 1024U } });
+			reused.Run({ .Width{ 64U }, .Height{ 96U }, .Depth{ 128U }, .Seed{ 2LLU }, .Num_Walkers{ 6U }, .Num_StepsPerWalker{ 1024U } });
+			return !same(other.GetVolume(), reused.GetVolume());
+		});
+
+		//----	------	------	------	------	----//
+		//	Caves								//
+		//----	------	------	------	------	----//
+
+		// Throughput counts voxels; a dense volume of bytes would be one byte for each, a dense bit volume an eighth of that.
+		for (uint32_t const size : { 256U, 1024U }) {
+			auto const caves{ std::make_shared<LazyCaves>(CaveParams(size)) };
+			uint64_t const num_Voxels{ static_cast<uint64_t>(size) * size * size };
+
+			// The memory the caves take, bricks and index together, within a quarter of a dense volume of bits
+			// (2 MiB at 256^3, 128 MiB at 1024^3), and so a thirty-second of one of bytes.
+			suite_.Verify(std::format("Math/VoxelVolume/{}/Memory", size), [caves, num_Voxels] () {
+				SparseVoxelVolume const& volume{ caves->Get().GetVolume() };
+				return volume.Num_Voxels() > 0LLU && volume.MemoryUsage() * 4LLU <= num_Voxels / 8LLU;
+			});
+
+			suite_.Add(std::format("Game/VoxelCaves/{}/Generate", size), [caves] (uint64_t num_Iterations_) {
+				Game::VoxelCaves generator{};
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					generator.Run(caves->Params);
+					DoNotOptimize(generator.GetCaves().Num_Components());
+				}
+			}, num_Voxels);
+			// Stepped over and over from the caves; the smoothing rule settles, so every step sees much the same volume.
+			suite_.Add(std::format("Math/VoxelVolume/{}/Step", size), [caves] (uint64_t num_Iterations_) {
+				auto const& params{ caves->Params };
+				VoxelAutomaton automaton{};
+				automaton.Volume() = caves->Get().GetVolume();
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					automaton.Step(VoxelRule::AtLeast(params.Threshold_Birth, params.Threshold_Survival));
+					DoNotOptimize(automaton.Volume().Num_Bricks());
+				}
+			}, num_Voxels);
+			suite_.Add(std::format("Math/VoxelVolume/{}/Label", size), [caves] (uint64_t num_Iterations_) {
+				SparseVoxelVolume const& volume{ caves->Get().GetVolume() };
+				VoxelComponents components{};
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					components.Label(volume);
+					DoNotOptimize(components.Num_Components());
+				}
+			}, num_Voxels);
+			suite_.Add(std::format("Math/VoxelVolume/{}/Surface", size), [caves] (uint64_t num_Iterations_) {
+				SparseVoxelVolume const& volume{ caves->Get().GetVolume() };
+				SparseVoxelVolume surface{};
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					volume.ExtractSurface(surface);
+					DoNotOptimize(surface.Num_Bricks());
+				}
+			}, num_Voxels);
+
+			// The dense baseline; a gigabyte of bytes at 1024^3, so only at 256^3.
+			if (size > 256U) { continue; }
+			auto const dense{ std::make_shared<std::unique_ptr<NaiveVolume>>() };
+			auto const getDense{
+				[caves, dense] () -> NaiveVolume& {
+					if (!*dense) { *dense = std::make_unique<NaiveVolume>(Densify(caves->Get().GetVolume())); }
+					return **dense;
+				}
+			};
+			suite_.Add(std::format("Math/VoxelVolume/{}/Dense/Step", size), [caves, getDense] (uint64_t num_Iterations_) {
+				auto const& params{ caves->Params };
+				NaiveVolume& volume{ getDense() };
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					volume.Step(VoxelRule::AtLeast(params.Threshold_Birth, params.Threshold_Survival));
+					DoNotOptimize(volume.Voxels[0]);
+				}
+			}, num_Voxels);
+			suite_.Add(std::format("Math/VoxelVolume/{}/Dense/Label", size), [getDense] (uint64_t num_Iterations_) {
+				NaiveVolume const& volume{ getDense() };
+				std::vector<uint32_t> labels{};
+				std::vector<uint64_t> volumes{};
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) { DoNotOptimize(volume.Label(labels, volumes)); }
+			}, num_Voxels);
+			suite_.Add(std::format("Math/VoxelVolume/{}/Dense/Surface", size), [getDense] (uint64_t num_Iterations_) {
+				NaiveVolume const& volume{ getDense() };
+				for (uint64_t i{ 0LLU }; i < num_Iterations_; ++i) {
+					NaiveVolume const surface{ volume.Surface() };
+					DoNotOptimize(surface.Voxels[0]);
+				}
+			}, num_Voxels);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include<External/nlohmann.JSON/single_include/nlohmann/json.hpp>
+
+import <cstdint>;
+
+import <chrono>;
+
+import <string>;
+import <string_view>;
+import <format>;
+
+import <fstream>;
+import <iostream>;
+
+import Benchmark.Harness;
+import Benchmark.Math;
+import Benchmark.Container;
+import Benchmark.Instance;
+import Benchmark.Culling;
+import Benchmark.PoissonDisk;
+import Benchmark.KDTree;
+import Benchmark.Concurrent;
+import Benchmark.SmallVector;
+import Benchmark.FlatHashMap;
+import Benchmark.Lexicon;
+import Benchmark.FrameArena;
+import Benchmark.ObjectPool;
+import Benchmark.AABBTree;
+import Benchmark.AllocationTracker;
+import Benchmark.VirtualArena;
+import Benchmark.ConnectedComponents;
+import Benchmark.CellularAutomaton;
+import Benchmark.SpanningTree;
+import Benchmark.GridPath;
+import Benchmark.MapGenerator;
+import Benchmark.VoxelVolume;
+import Benchmark.ChunkedWorld;
+import Benchmark.TerrainPipeline;
+
+//////	//////	//////	//////	//////	//////
+
+// Usage:
+//	Benchmark [--filter <substring>] [--json <output.json>]
+//	          [--baseline <baseline.json>] [--threshold <percent>]
+//	          [--repetitions <n>] [--warmups <n>] [--min-sample-ms <ms>] [--cpu <index | -1>]
+//
+// Exits with 1 if any case regresses beyond the threshold against the baseline, 2 on bad arguments,
+// 3 if a correctness check fails (no timings are taken in that case).
+
+namespace {
+	bool ParseOptions(int argc_, char* argv_[], Benchmark::Options& options_) {
+		for (int i_Arg{ 1 }; i_Arg < argc_; ++i_Arg) {
+			std::string_view const arg{ argv_[i_Arg] };
+			if (i_Arg + 1 >= argc_) {
+				std::cerr << std::format("Missing value for {}\n", arg);
+				return false;
+			}
+			std::string_view const val{ argv_[++i_Arg] };
+
+			if (arg == "--filter") { options_.Filter = val; }
+			else if (arg == "--json") { options_.OutputPath = val; }
+			else if (arg == "--baseline") { options_.BaselinePath = val; }
+			else if (arg == "--threshold") { options_.RegressionThreshold = std::stod(std::string{ val }) * 0.01; }
+			else if (arg == "--repetitions") { options_.Num_Repetitions = static_cast<uint32_t>(std::stoul(std::string{ val })); }
+			else if (arg == "--warmups") { options_.Num_Warmups = static_cast<uint32_t>(std::stoul(std::string{ val })); }
+			else if (arg == "--min-sample-ms") { options_.MinSampleDuration = std::chrono::milliseconds{ std::stoll(std::string{ val }) }; }
+			else if (arg == "--cpu") { options_.PinnedCPU = std::stoi(std::string{ val }); }
+			else {
+				std::cerr << std::format("Unknown option {}\n", arg);
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	Benchmark::Options options{};
+	if (!ParseOptions(argc, argv, options)) { return 2; }
+
+	if (options.PinnedCPU >= 0 && !Benchmark::PinCurrentThread(options.PinnedCPU)) {
+		std::cerr << std::format("Failed to pin the benchmark thread to CPU {}; results may be noisy.\n", options.PinnedCPU);
+	}
+
+	Benchmark::Suite suite{};
+	Benchmark::Math::Register(suite);
+	Benchmark::Container::Register(suite);
+	Benchmark::Instance::Register(suite);
+	Benchmark::Culling::Register(suite);
+	Benchmark::PoissonDisk::Register(suite);
+	Benchmark::KDTree::Register(suite);
+	Benchmark::Concurrent::Register(suite);
+	Benchmark::SmallVector::Register(suite);
+	Benchmark::FlatHashMap::Register(suite);
+	Benchmark::Lexicon::Register(suite);
+	Benchmark::FrameArena::Register(suite);
+	Benchmark::ObjectPool::Register(suite);
+	Benchmark::AABBTree::Register(suite);
+	Benchmark::AllocationTracker::Register(suite);
+	Benchmark::VirtualArena::Register(suite);
+	Benchmark::ConnectedComponents::Register(suite);
+	Benchmark::CellularAutomaton::Register(suite);
+	Benchmark::SpanningTree::Register(suite);
+	Benchmark::GridPath::Register(suite);
+	Benchmark::MapGenerator::Register(suite);
+	Benchmark::VoxelVolume::Register(suite);
+	Benchmark::ChunkedWorld::Register(suite);
+	Benchmark::TerrainPipeline::Register(suite);
+
+	if (uint32_t const num_Failures{ suite.RunChecks(options) }; num_Failures > 0U) {
+		std::cerr << std::format("{} check(s) failed.\n", num_Failures);
+		return 3;
+	}
+
+	auto&& results{ suite.Run(options) };
+	Benchmark::Print(results);
+
+	if (!options.OutputPath.empty()) {
+		std::ofstream ofs{ options.OutputPath };
+		ofs << Benchmark::ToJSON(results, options).dump(2);
+	}
+
+	if (!options.BaselinePath.empty()) {
+		std::ifstream ifs{ options.BaselinePath };
+		if (!ifs) {
+			std::cerr << std::format("Failed to open baseline {}\n", options.BaselinePath);
+			return 2;
+		}
+		auto const baseline{ Benchmark::JSON::parse(ifs) };
+		uint32_t const num_Regressions{ Benchmark::Compare(results, baseline, options.RegressionThreshold) };
+		if (num_Regressions > 0U) {
+			std::cout << std::format("\n{} regression(s) beyond {:.1f}%.\n", num_Regressions, options.RegressionThreshold * 100.0);
+			return 1;
+		}
+	}
+
+	return 0;
+}
\ No newline at end of file
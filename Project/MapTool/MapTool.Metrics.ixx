@@ -0,0 +1,110 @@
+export module MapTool.Metrics;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <vector>;
+import <algorithm>;
+
+import <string>;
+import <format>;
+import <fstream>;
+
+import Lumina.Math.Numerics;
+import Lumina.Math.ConnectedComponents;
+
+import Game.MapGenerator;
+
+//////	//////	//////	//////	//////	//////
+
+namespace MapTool {
+	namespace {
+		// The low 20 bits of a tile tell what it is; the cave number sits above them.
+		constexpr int TileMask{ (1 << 20U) - 1 };
+		// Marked under floor by CellularAutomata::GenerateFeatures.
+		constexpr int Tile_Surface{ 2 };
+
+		bool IsFloor(int tile_) noexcept { return (tile_ & TileMask) == 0; }
+	}
+
+	export struct Metrics {
+		// Floor tiles over all tiles.
+		double Ratio_Open{ 0.0 };
+		uint32_t Num_Caves{ 0U };
+		// The largest cave's tiles over the tiles of all caves.
+		double Share_LargestCave{ 0.0 };
+		// Steps along every tunnel, before the brush widens it.
+		uint32_t Length_Tunnels{ 0U };
+		// 4-connected floor regions once tunnels are dug; 1 when every floor tile reaches every other.
+		uint32_t Num_Regions{ 0U };
+		// The largest region's tiles over all floor tiles.
+		double Ratio_Connected{ 0.0 };
+	};
+
+	// map_ as CellularAutomata::GetMap gives it. components_ is only scratch, kept by the caller from map to map.
+	export Metrics Measure(
+		Game::CellularAutomata const& generator_,
+		std::vector<std::vector<int>> const& map_,
+		Lumina::ConnectedComponents& components_
+	) {
+		Metrics metrics{};
+		uint32_t const height{ static_cast<uint32_t>(map_.size()) };
+		uint32_t const width{ height > 0U ? static_cast<uint32_t>(map_[0].size()) : 0U };
+		if (width == 0U) { return metrics; }
+
+		uint64_t num_Floors{ 0LLU };
+		for (auto const& mapRow : map_) { num_Floors += static_cast<uint64_t>(std::ranges::count_if(mapRow, IsFloor)); }
+		metrics.Ratio_Open = static_cast<double>(num_Floors) / (static_cast<double>(width) * height);
+
+		auto const& caves{ generator_.GetCaves() };
+		metrics.Num_Caves = static_cast<uint32_t>(caves.size());
+		uint64_t num_CaveTiles{ 0LLU };
+		uint64_t num_LargestCave{ 0LLU };
+		for (auto const& cave : caves) {
+			num_CaveTiles += cave.size();
+			num_LargestCave = std::max<uint64_t>(num_LargestCave, cave.size());
+		}
+		metrics.Share_LargestCave = (num_CaveTiles > 0LLU) ? static_cast<double>(num_LargestCave) / static_cast<double>(num_CaveTiles) : 0.0;
+		metrics.Length_Tunnels = generator_.GetTunnelLength();
+
+		components_.Label(width, height, [&map_] (uint32_t x_, uint32_t y_) { return IsFloor(map_[y_][x_]); });
+		metrics.Num_Regions = components_.Num_Components();
+		uint32_t num_LargestRegion{ 0U };
+		for (auto const& component : components_.Components()) { num_LargestRegion = std::max(num_LargestRegion, component.Area); }
+		metrics.Ratio_Connected = (num_Floors > 0LLU) ? static_cast<double>(num_LargestRegion) / static_cast<double>(num_Floors) : 0.0;
+		return metrics;
+	}
+
+	export std::string CSVHeader() {
+		return "Ratio_Open,Num_Caves,Share_LargestCave,Length_Tunnels,Num_Regions,Ratio_Connected";
+	}
+
+	export std::string ToCSV(Metrics const& metrics_) {
+		return std::format(
+			"{:.4f},{},{:.4f},{},{},{:.4f}",
+			metrics_.Ratio_Open, metrics_.Num_Caves, metrics_.Share_LargestCave,
+			metrics_.Length_Tunnels, metrics_.Num_Regions, metrics_.Ratio_Connected
+		);
+	}
+
+	// A binary greymap: floor white, features light grey, surfaces under floor dark grey, rock black.
+	export bool WritePGM(std::string const& path_, std::vector<std::vector<int>> const& map_, std::vector<Lumina::Int2> const& features_) {
+		uint32_t const height{ static_cast<uint32_t>(map_.size()) };
+		uint32_t const width{ height > 0U ? static_cast<uint32_t>(map_[0].size()) : 0U };
+
+		std::vector<uint8_t> pixels(static_cast<size_t>(width) * height);
+		for (uint32_t y{ 0U }; y < height; ++y) {
+			for (uint32_t x{ 0U }; x < width; ++x) {
+				int const tile{ map_[y][x] & TileMask };
+				pixels[static_cast<size_t>(y) * width + x] = static_cast<uint8_t>((tile == 0) ? 255U : (tile == Tile_Surface) ? 64U : 0U);
+			}
+		}
+		for (auto const& feature : features_) { pixels[static_cast<size_t>(feature.y) * width + static_cast<size_t>(feature.x)] = 160U; }
+
+		std::ofstream ofs{ path_, std::ios::binary | std::ios::trunc };
+		ofs << std::format("P5\n{} {}\n255\n", width, height);
+		ofs.write(reinterpret_cast<char const*>(pixels.data()), static_cast<std::streamsize>(pixels.size()));
+		return static_cast<bool>(ofs);
+	}
+}
\ No newline at end of file
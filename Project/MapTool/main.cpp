@@ -0,0 +1,249 @@
+import <cstdint>;
+
+import <chrono>;
+import <atomic>;
+import <thread>;
+
+import <vector>;
+import <algorithm>;
+import <type_traits>;
+import <stdexcept>;
+
+import <string>;
+import <string_view>;
+import <format>;
+
+import <fstream>;
+import <iostream>;
+import <filesystem>;
+
+import Lumina.Math.ConnectedComponents;
+
+import Game.MapGenerator;
+
+import MapTool.Metrics;
+
+//////	//////	//////	//////	//////	//////
+
+// Usage:
+//	MapTool [--width <n>] [--height <n>] [--seed <first>] [--count <n>]
+//	        [--wallification <p,...>] [--neighbors <n,...>] [--smoothing <n,...>] [--min-cave <n,...>]
+//	        [--extra-tunnels <ratio,...>] [--tunnel-radius <n,...>] [--rock-cost <cost,...>]
+//	        [--threads <n>] [--csv <output.csv>] [--pgm <directory>]
+//
+// Generates a map for each of count seeds from first, for every combination of the values listed,
+// on all cores unless told otherwise, and writes a CSV row of params and metrics per map (to stdout without --csv).
+// With --pgm, a greymap of each map is written there too.
+//
+// Exits with 2 on bad arguments, 1 if an output cannot be written.
+
+namespace {
+	struct Options {
+		uint32_t Width{ 128U };
+		uint32_t Height{ 64U };
+		uint64_t FirstSeed{ 0LLU };
+		uint64_t Num_Seeds{ 100LLU };
+
+		// The grid; one value each by default, that of a default MapGenParams.
+		std::vector<float> Probabilities_Wallification{};
+		std::vector<uint32_t> Conditions_WallifiedByNeighbors{};
+		std::vector<uint32_t> Nums_SmoothingSteps{};
+		std::vector<uint32_t> MinSizes_Cave{};
+		std::vector<float> Ratios_ExtraTunnels{};
+		std::vector<uint32_t> Radii_Tunnel{};
+		std::vector<float> Costs_Rock{};
+
+		uint32_t Num_Threads{ std::max(std::thread::hardware_concurrency(), 1U) };
+		std::string CSVPath{};
+		std::string PGMDirectory{};
+	};
+
+	template<typename T>
+	std::vector<T> ParseList(std::string_view str_) {
+		std::vector<T> values{};
+		while (!str_.empty()) {
+			size_t const end{ std::min(str_.find(','), str_.size()) };
+			std::string const token{ str_.substr(0LLU, end) };
+			if constexpr (std::is_floating_point_v<T>) { values.emplace_back(static_cast<T>(std::stod(token))); }
+			else { values.emplace_back(static_cast<T>(std::stoull(token))); }
+			str_.remove_prefix(std::min<size_t>(end + 1LLU, str_.size()));
+		}
+		return values;
+	}
+
+	bool ParseOptions(int argc_, char* argv_[], Options& options_) {
+		for (int i_Arg{ 1 }; i_Arg < argc_; ++i_Arg) {
+			std::string_view const arg{ argv_[i_Arg] };
+			if (i_Arg + 1 >= argc_) {
+				std::cerr << std::format("Missing value for {}\n", arg);
+				return false;
+			}
+			std::string_view const val{ argv_[++i_Arg] };
+
+			if (arg == "--width") { options_.Width = static_cast<uint32_t>(std::stoul(std::string{ val })); }
+			else if (arg == "--height") { options_.Height = static_cast<uint32_t>(std::stoul(std::string{ val })); }
+			else if (arg == "--seed") { options_.FirstSeed = std::stoull(std::string{ val }); }
+			else if (arg == "--count") { options_.Num_Seeds = std::stoull(std::string{ val }); }
+			else if (arg == "--wallification") { options_.Probabilities_Wallification = ParseList<float>(val); }
+			else if (arg == "--neighbors") { options_.Conditions_WallifiedByNeighbors = ParseList<uint32_t>(val); }
+			else if (arg == "--smoothing") { options_.Nums_SmoothingSteps = ParseList<uint32_t>(val); }
+			else if (arg == "--min-cave") { options_.MinSizes_Cave = ParseList<uint32_t>(val); }
+			else if (arg == "--extra-tunnels") { options_.Ratios_ExtraTunnels = ParseList<float>(val); }
+			else if (arg == "--tunnel-radius") { options_.Radii_Tunnel = ParseList<uint32_t>(val); }
+			else if (arg == "--rock-cost") { options_.Costs_Rock = ParseList<float>(val); }
+			else if (arg == "--threads") { options_.Num_Threads = std::max(static_cast<uint32_t>(std::stoul(std::string{ val })), 1U); }
+			else if (arg == "--csv") { options_.CSVPath = val; }
+			else if (arg == "--pgm") { options_.PGMDirectory = val; }
+			else {
+				std::cerr << std::format("Unknown option {}\n", arg);
+				return false;
+			}
+		}
+		// The border alone is wall, and the generator needs a tile inside it.
+		if (options_.Width < 3U || options_.Height < 3U) {
+			std::cerr << "Maps must be at least 3 x 3\n";
+			return false;
+		}
+		return true;
+	}
+
+	// Every combination of the listed values, the first list varying slowest.
+	std::vector<Game::MapGenParams> ExpandGrid(Options const& options_) {
+		Game::MapGenParams const base{ .Width{ options_.Width }, .Height{ options_.Height } };
+		std::vector<Game::MapGenParams> grid{ base };
+
+		auto const expand{
+			[&grid] <typename T> (std::vector<T> const& values_, T Game::MapGenParams::* field_) {
+				if (values_.empty()) { return; }
+				std::vector<Game::MapGenParams> expanded{};
+				expanded.reserve(grid.size() * values_.size());
+				for (auto const& params : grid) {
+					for (T const& value : values_) {
+						(expanded.emplace_back(params).*field_) = value;
+					}
+				}
+				grid.swap(expanded);
+			}
+		};
+		expand(options_.Probabilities_Wallification, &Game::MapGenParams::Probability_Wallification);
+		expand(options_.Conditions_WallifiedByNeighbors, &Game::MapGenParams::Condition_WallifiedByNeighbors);
+		expand(options_.Nums_SmoothingSteps, &Game::MapGenParams::Num_SmoothingSteps);
+		expand(options_.MinSizes_Cave, &Game::MapGenParams::MinSize_Cave);
+		expand(options_.Ratios_ExtraTunnels, &Game::MapGenParams::Ratio_ExtraTunnels);
+		expand(options_.Radii_Tunnel, &Game::MapGenParams::Radius_Tunnel);
+		expand(options_.Costs_Rock, &Game::MapGenParams::Cost_Rock);
+		return grid;
+	}
+
+	struct Result {
+		MapTool::Metrics Metrics{};
+		double Milliseconds{ 0.0 };
+		bool IsPreviewWritten{ true };
+	};
+}
+
+int main(int argc, char* argv[]) {
+	Options options{};
+	try {
+		if (!ParseOptions(argc, argv, options)) { return 2; }
+	}
+	catch (std::exception const& e) {
+		std::cerr << std::format("Bad argument: {}\n", e.what());
+		return 2;
+	}
+
+	if (!options.PGMDirectory.empty()) {
+		std::error_code error{};
+		std::filesystem::create_directories(options.PGMDirectory, error);
+		if (error) {
+			std::cerr << std::format("Failed to create {}: {}\n", options.PGMDirectory, error.message());
+			return 1;
+		}
+	}
+
+	std::vector<Game::MapGenParams> const grid{ ExpandGrid(options) };
+	uint64_t const num_Maps{ grid.size() * options.Num_Seeds };
+	std::vector<Result> results(num_Maps);
+
+	// Maps go to whichever worker asks next, as their cost varies with the params; each worker keeps its own
+	// generator and buffers, and writes only its own results.
+	std::atomic<uint64_t> next{ 0LLU };
+	auto const work{
+		[&] () {
+			Game::CellularAutomata generator{};
+			std::vector<std::vector<int>> map{};
+			Lumina::ConnectedComponents components{};
+
+			for (uint64_t idx_Map{ next++ }; idx_Map < num_Maps; idx_Map = next++) {
+				Game::MapGenParams params{ grid[idx_Map / options.Num_Seeds] };
+				params.Seed = options.FirstSeed + idx_Map % options.Num_Seeds;
+
+				auto const begin{ std::chrono::steady_clock::now() };
+				generator.Run(params);
+				auto const end{ std::chrono::steady_clock::now() };
+
+				generator.GetMap(map);
+				Result& result{ results[idx_Map] };
+				result.Metrics = MapTool::Measure(generator, map, components);
+				result.Milliseconds = std::chrono::duration<double, std::milli>(end - begin).count();
+				if (!options.PGMDirectory.empty()) {
+					std::string const path{
+						(std::filesystem::path{ options.PGMDirectory } /
+						std::format("{:05}_{}.pgm", idx_Map / options.Num_Seeds, params.Seed)).string()
+					};
+					result.IsPreviewWritten = MapTool::WritePGM(path, map, generator.GetFeatures());
+				}
+			}
+		}
+	};
+
+	uint32_t const num_Threads{ static_cast<uint32_t>(std::min<uint64_t>(options.Num_Threads, std::max<uint64_t>(num_Maps, 1LLU))) };
+	auto const begin{ std::chrono::steady_clock::now() };
+	{
+		std::vector<std::jthread> workers{};
+		for (uint32_t i{ 1U }; i < num_Threads; ++i) { workers.emplace_back(work); }
+		work();
+	}
+	double const seconds{ std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() };
+
+	//----	------	------	------	------	----//
+
+	std::ofstream ofs{};
+	if (!options.CSVPath.empty()) {
+		ofs.open(options.CSVPath, std::ios::trunc);
+		if (!ofs) {
+			std::cerr << std::format("Failed to open {}\n", options.CSVPath);
+			return 1;
+		}
+	}
+	std::ostream& os{ options.CSVPath.empty() ? std::cout : ofs };
+
+	os << "Config,Seed,Width,Height,Probability_Wallification,Condition_WallifiedByNeighbors,Num_SmoothingSteps,"
+		"MinSize_Cave,Ratio_ExtraTunnels,Radius_Tunnel,Cost_Rock," << MapTool::CSVHeader() << ",Milliseconds\n";
+	uint64_t num_MissingPreviews{ 0LLU };
+	for (uint64_t idx_Map{ 0LLU }; idx_Map < num_Maps; ++idx_Map) {
+		uint64_t const idx_Config{ idx_Map / options.Num_Seeds };
+		Game::MapGenParams const& params{ grid[idx_Config] };
+		Result const& result{ results[idx_Map] };
+		os << std::format(
+			"{},{},{},{},{},{},{},{},{},{},{},{},{:.3f}\n",
+			idx_Config, options.FirstSeed + idx_Map % options.Num_Seeds, params.Width, params.Height,
+			params.Probability_Wallification, params.Condition_WallifiedByNeighbors, params.Num_SmoothingSteps,
+			params.MinSize_Cave, params.Ratio_ExtraTunnels, params.Radius_Tunnel, params.Cost_Rock,
+			MapTool::ToCSV(result.Metrics), result.Milliseconds
+		);
+		num_MissingPreviews += result.IsPreviewWritten ? 0LLU : 1LLU;
+	}
+	os.flush();
+
+	std::cerr << std::format(
+		"{} map(s) of {} x {}, {} config(s) x {} seed(s), in {:.3f} s on {} thread(s): {:.1f} maps/s\n",
+		num_Maps, options.Width, options.Height, grid.size(), options.Num_Seeds,
+		seconds, num_Threads, (seconds > 0.0) ? static_cast<double>(num_Maps) / seconds : 0.0
+	);
+	if (!os || num_MissingPreviews > 0LLU) {
+		std::cerr << std::format("Failed to write {} preview(s){}\n", num_MissingPreviews, os ? "" : " and the CSV");
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
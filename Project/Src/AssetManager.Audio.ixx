@@ -138,6 +138,7 @@ namespace Lumina::XAudio2 {
 	}
 
 	AudioStream::Handle AudioManager::LoadFromFile(std::wstring_view filePath_) {
+		Utils::Debug::AllocationTracker::TagScope const tagScope{ Utils::Debug::ALLOCATION_TAG::AUDIO };
 		int handle_Stream{ static_cast<int>(Array_Streams_.size()) };
 		auto& stream{ Array_Streams_.emplace_back() };
 
@@ -7,10 +7,12 @@ export module Lumina.AssetManager : Graphics;
 import <memory>;
 
 import <vector>;
-import <unordered_map>;
 
 import <string>;
 
+import Lumina.Container.FlatHashMap;
+import Lumina.Container.ObjectPool;
+
 import Lumina.DX12;
 import Lumina.DX12.Context;
 import Lumina.DX12.Aux.View;
@@ -18,8 +20,9 @@ import Lumina.DX12.Aux.View;
 import Lumina.Utils.Debug;
 
 namespace {
+	// Owning pointers into the resource manager's pools.
 	template<typename T>
-	using UniPtr = std::unique_ptr<T>;
+	using UniPtr = typename Lumina::ObjectPool<T>::UniPtr;
 }
 
 namespace Lumina::DX12 {
@@ -90,13 +93,11 @@ namespace Lumina::DX12 {
 		void Initialize(Context const& context_);
 
 	private:
-		std::vector<UniPtr<DefaultBuffer>> Arr_DefaultBuffers_{};
-		std::vector<UniPtr<UploadBuffer>> Arr_UploadBuffers_{};
-		std::vector<UniPtr<UnorderedAccessBuffer>> Arr_UorderedAccessBuffers_{};
-		std::vector<UniPtr<ReadbackBuffer>> Arr_ReadbackBuffers_{};
+		// Declared ahead of the array, so that the textures go back to the pool before it is destroyed.
+		ObjectPool<ImageTexture> Pool_ImageTextures_{};
 
 		std::vector<UniPtr<ImageTexture>> Arr_ImageTextures_{};
-		std::unordered_map<std::string, ImageTexture const*> Dict_ImageTextures_{};
+		FlatHashMap<std::string, ImageTexture const*> Dict_ImageTextures_{};
 
 	private:
 		ImageTextureUploader Uploader_{};
@@ -114,20 +115,23 @@ namespace Lumina::DX12 {
 		std::string_view name_,
 		std::string_view filePath_
 	) {
-		(Dict_ImageTextures_.find(name_.data()) == Dict_ImageTextures_.cend()) ||
+		Utils::Debug::AllocationTracker::TagScope const tagScope{ Utils::Debug::ALLOCATION_TAG::GRAPHICS };
+
+		(!Dict_ImageTextures_.contains(name_)) ||
 		Utils::Debug::ThrowIfFalse{
 			"<ResourceManager> Texture of the same name is extant!\n"
 		};
 
 		auto img{ ImageSet::Create(filePath_) };
 		auto mipChain{ MipChain::Create(*img) };
-		auto tex{ ImageTexture::Create(Context_->Device(), *mipChain, name_) };
+		auto tex{ Pool_ImageTextures_.MakeUnique() };
+		tex->Initialize(Context_->Device(), *mipChain, name_);
 
 		uint32_t const idx_Res{ static_cast<uint32_t>(Arr_ImageTextures_.size()) };
 		uint32_t const idx_ResType{ static_cast<uint32_t>(RESOURCE_TYPE::IMAGE_TEXTURE2D) };
 		ResourceID const texID{ idx_Res | (idx_ResType << BitOffset_Index_ResourceType_) };
 
-		Dict_ImageTextures_.emplace(name_, tex.get());
+		Dict_ImageTextures_.try_emplace(name_, tex.get());
 		Arr_ImageTextures_.emplace_back(std::move(tex));
 
 		return texID;
@@ -136,6 +140,8 @@ namespace Lumina::DX12 {
 	void ResourceManager::UploadResources(
 		std::vector<ResourceID> const& unuploadedResIDs_
 	) {
+		Utils::Debug::AllocationTracker::TagScope const tagScope{ Utils::Debug::ALLOCATION_TAG::GRAPHICS };
+
 		Uploader_.Begin();
 		for (ResourceID resID : unuploadedResIDs_) {
 			auto* res{ GetResource(resID) };
@@ -0,0 +1,443 @@
+export module Game.ChunkedWorld;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cstddef>;
+import <cassert>;
+
+import <chrono>;
+import <atomic>;
+import <thread>;
+import <semaphore>;
+
+import <vector>;
+import <array>;
+import <span>;
+import <utility>;
+import <algorithm>;
+
+import Lumina.Math.Numerics;
+import Lumina.Math.CellularAutomaton;
+import Lumina.Math.ConnectedComponents;
+
+import Lumina.Container.FlatHashMap;
+import Lumina.Container.MPMCQueue;
+
+//////	//////	//////	//////	//////	//////
+
+// A map without bounds, in chunks of 32 x 32 tiles generated on worker threads around where the player is,
+// and evicted least recently used first once a fixed number of them are held.
+//
+//	- Tiles read as CellularAutomata::GetMap gives them, with y pointing up: 0 floor, 1 rock, 2 rock with floor above.
+//	- A chunk depends on the seed and its own coordinates alone. Every tile starts as noise hashed from the seed and
+//	  its position, and the cave smoothing runs over the chunk plus an apron one tile wider than the number of steps,
+//	  so a chunk comes out as if the whole endless map had been smoothed at once: neighbours meet without seams
+//	  whatever order they are made in, and an evicted chunk comes back the same.
+//	- Floor regions under MinSize_Cave tiles are filled back in, as CellularAutomata does. The apron reaches
+//	  MinSize_Cave tiles further, so every such region touching a chunk is labelled whole, the same from every chunk it touches.
+//	- Chunks live in a pool allocated up front. A request reserves its slot and a worker writes straight into it,
+//	  then hands it back through a queue; nothing is allocated or copied as the player roams.
+//	- Edits to a tile last as long as its chunk stays resident.
+//	- All but the workers runs on the owner's thread, once a frame in Update, which never waits for them.
+
+namespace Game {
+	namespace {
+		// SplitMix64's finalizer over the seed and the tile, as a uniform float in [0, 1).
+		float TileNoise(uint64_t seed_, int32_t x_, int32_t y_) noexcept {
+			uint64_t hash{
+				seed_ + 0x9E3779B97F4A7C15LLU *
+				((static_cast<uint64_t>(static_cast<uint32_t>(x_)) << 32U) | static_cast<uint32_t>(y_))
+			};
+			hash = (hash ^ (hash >> 30U)) * 0xBF58476D1CE4E5B9LLU;
+			hash = (hash ^ (hash >> 27U)) * 0x94D049BB133111EBLLU;
+			hash ^= hash >> 31U;
+			return static_cast<float>(hash >> 40U) * 0.000000059604644775390625f;
+		}
+
+		uint64_t Key(Lumina::Int2 const& chunk_) noexcept {
+			return (static_cast<uint64_t>(static_cast<uint32_t>(chunk_.x)) << 32U) | static_cast<uint32_t>(chunk_.y);
+		}
+	}
+
+	// Everything a chunk is generated from, besides its coordinates; equal params give equal worlds.
+	export struct WorldGenParams {
+		uint64_t Seed{ 0LLU };
+
+		float Probability_Wallification{ 0.45f };
+		uint32_t Condition_WallifiedByNeighbors{ 4U };
+		uint32_t Num_SmoothingSteps{ 4U };
+		// Smaller 4-connected floor regions are filled with rock. Widens the apron by as many tiles.
+		uint32_t MinSize_Cave{ 16U };
+	};
+
+	export struct ChunkStreamingParams {
+		// Chunks resident or being generated at most; at least the (2 * Radius_Stream + 1)^2 around the player.
+		uint32_t Num_Chunks{ 64U };
+		// Chunks up to this many chunks from the player's, along either axis, are requested and kept.
+		uint32_t Radius_Stream{ 2U };
+		uint32_t Num_Workers{ 2U };
+	};
+
+	export class ChunkedWorld {
+	public:
+		static constexpr uint32_t Log2_ChunkSize{ 5U };
+		static constexpr int32_t ChunkSize{ 1 << Log2_ChunkSize };
+		static constexpr uint32_t Num_TilesPerChunk{ 1U << (Log2_ChunkSize * 2U) };
+		static constexpr uint32_t InvalidChunk{ 0xFFFFFFFFU };
+		// What tiles of chunks that are not resident read as, so that nothing walks into the unknown.
+		static constexpr int Tile_Unknown{ 1 };
+
+		// Tile (x, y) of a chunk at y * ChunkSize + x.
+		using Chunk = std::array<int, Num_TilesPerChunk>;
+
+		// What Generate works in; one per thread, reused.
+		struct Scratch {
+			Lumina::CellularAutomaton Automaton{};
+			Lumina::ConnectedComponents Components{};
+		};
+
+		struct Statistics {
+			uint64_t Num_Generated{ 0LLU };
+			uint64_t Num_Evicted{ 0LLU };
+			// From the Update that requested a chunk to the one that took it in.
+			std::chrono::nanoseconds Latency_Total{};
+			std::chrono::nanoseconds Latency_Max{};
+		};
+
+	private:
+		struct Slot {
+			Lumina::Int2 Coord{};
+			// Neighbours in the LRU list, most recently used first; only resident chunks are in it.
+			uint32_t Prev{ InvalidChunk };
+			uint32_t Next{ InvalidChunk };
+			uint64_t Frame_LastUsed{ 0LLU };
+			std::chrono::steady_clock::time_point Time_Requested{};
+			bool IsResident{ false };
+		};
+
+		struct Request {
+			Lumina::Int2 Coord;
+			uint32_t Slot;
+		};
+
+	public:
+		// The chunk holding a tile, and the tile's index in it; arithmetic shifts floor negative coordinates as well.
+		static Lumina::Int2 ChunkOf(Lumina::Int2 const& tile_) noexcept {
+			return { tile_.x >> Log2_ChunkSize, tile_.y >> Log2_ChunkSize };
+		}
+		static uint32_t LocalIndex(Lumina::Int2 const& tile_) noexcept {
+			return static_cast<uint32_t>(((tile_.y & (ChunkSize - 1)) << Log2_ChunkSize) | (tile_.x & (ChunkSize - 1)));
+		}
+
+		// nullptr while the tile's chunk is not resident. Holds until the next Update.
+		int* Find(Lumina::Int2 const& tile_) noexcept {
+			uint32_t const idx_Chunk{ FindChunk(ChunkOf(tile_)) };
+			return (idx_Chunk != InvalidChunk) ? &Chunks_[idx_Chunk][LocalIndex(tile_)] : nullptr;
+		}
+		int const* Find(Lumina::Int2 const& tile_) const noexcept { return const_cast<ChunkedWorld&>(*this).Find(tile_); }
+		int operator()(Lumina::Int2 const& tile_) const noexcept {
+			int const* const tile{ Find(tile_) };
+			return (tile != nullptr) ? *tile : Tile_Unknown;
+		}
+
+		// Slot of a resident chunk, or InvalidChunk.
+		uint32_t FindChunk(Lumina::Int2 const& chunk_) const noexcept {
+			auto const it{ Index_.find(Key(chunk_)) };
+			return (it != Index_.end() && Slots_[it->second].IsResident) ? it->second : InvalidChunk;
+		}
+		Chunk& GetChunk(uint32_t idx_Chunk_) noexcept { return Chunks_[idx_Chunk_]; }
+		Chunk const& GetChunk(uint32_t idx_Chunk_) const noexcept { return Chunks_[idx_Chunk_]; }
+		Lumina::Int2 ChunkCoord(uint32_t idx_Chunk_) const noexcept { return Slots_[idx_Chunk_].Coord; }
+
+	public:
+		// Once a frame: takes in the chunks finished since the last call, marks those around tile_Center_ used,
+		// and requests the missing ones nearest first, in free slots or those of the least recently used chunks.
+		void Update(Lumina::Int2 const& tile_Center_);
+		// Slots of the chunks the last Update took in.
+		std::span<uint32_t const> Arrived() const noexcept { return Arrived_; }
+		// Updates until every chunk within radius_ (at most Radius_Stream) chunks of tile_Center_'s is resident.
+		// The one call that waits; for loading, not for frames.
+		void Prefetch(Lumina::Int2 const& tile_Center_, uint32_t radius_);
+
+	public:
+		// What a worker makes of the width_ x height_ tiles from origin_, into tiles_ row by row;
+		// a chunk is the region of ChunkSize x ChunkSize at its coordinates times ChunkSize.
+		static void Generate(
+			WorldGenParams const& params_,
+			Lumina::Int2 const& origin_,
+			uint32_t width_,
+			uint32_t height_,
+			int* tiles_,
+			Scratch& scratch_
+		);
+
+	public:
+		uint32_t Num_Resident() const noexcept { return static_cast<uint32_t>(Index_.size()) - Num_Pending_; }
+		uint32_t Num_Pending() const noexcept { return Num_Pending_; }
+		// Fixed at construction.
+		size_t MemoryUsage() const noexcept {
+			return
+				sizeof(Chunk) * Chunks_.capacity() + sizeof(Slot) * Slots_.capacity() +
+				sizeof(uint32_t) * (Free_.capacity() + Arrived_.capacity()) + sizeof(Lumina::Int2) * Offsets_.capacity() +
+				(sizeof(std::pair<uint64_t, uint32_t>) + 1LLU) * Index_.capacity() +
+				// A queue cell is the element after a sequence number.
+				(sizeof(uint64_t) + sizeof(Request)) * Requests_.Capacity() + (sizeof(uint64_t) + sizeof(uint32_t)) * Done_.Capacity();
+		}
+		Statistics const& GetStatistics() const noexcept { return Statistics_; }
+		WorldGenParams const& GetGenParams() const noexcept { return GenParams_; }
+		ChunkStreamingParams const& GetStreamingParams() const noexcept { return StreamingParams_; }
+
+	private:
+		void Unlink(uint32_t idx_Chunk_) noexcept;
+		void PushFront(uint32_t idx_Chunk_) noexcept;
+		// A free slot, or that of the least recently used chunk not used this frame, evicted; InvalidChunk if neither.
+		uint32_t Acquire();
+
+		void Work();
+
+	public:
+		ChunkedWorld(WorldGenParams const& genParams_, ChunkStreamingParams const& streamingParams_);
+		~ChunkedWorld() noexcept;
+
+		ChunkedWorld(ChunkedWorld const&) = delete;
+		ChunkedWorld& operator=(ChunkedWorld const&) = delete;
+
+		//====	======	======	======	======	====//
+
+	private:
+		WorldGenParams GenParams_;
+		ChunkStreamingParams StreamingParams_;
+
+		std::vector<Chunk> Chunks_{};
+		std::vector<Slot> Slots_{};
+		std::vector<uint32_t> Free_{};
+		// Resident and pending chunks alike, so that none is requested twice.
+		Lumina::FlatHashMap<uint64_t, uint32_t> Index_{};
+		uint32_t Head_{ InvalidChunk };
+		uint32_t Tail_{ InvalidChunk };
+		uint32_t Num_Pending_{ 0U };
+		uint64_t Frame_{ 0LLU };
+
+		// Chunk offsets within Radius_Stream, nearest first.
+		std::vector<Lumina::Int2> Offsets_{};
+		std::vector<uint32_t> Arrived_{};
+		Statistics Statistics_{};
+
+		// Each holds at most Num_Chunks, one per slot, so pushes never fail.
+		Lumina::MPMCQueue<Request> Requests_;
+		Lumina::MPMCQueue<uint32_t> Done_;
+		// Released once per request, and once per worker to stop.
+		std::counting_semaphore<> Signal_{ 0 };
+		std::atomic<bool> IsStopping_{ false };
+		std::vector<std::jthread> Workers_{};
+	};
+
+	//----	------	------	------	------	----//
+
+	void ChunkedWorld::Update(Lumina::Int2 const& tile_Center_) {
+		++Frame_;
+		auto const now{ std::chrono::steady_clock::now() };
+
+		Arrived_.clear();
+		for (uint32_t idx_Chunk{ InvalidChunk }; Done_.TryPop(idx_Chunk);) {
+			Slot& slot{ Slots_[idx_Chunk] };
+			slot.IsResident = true;
+			PushFront(idx_Chunk);
+			--Num_Pending_;
+			Arrived_.emplace_back(idx_Chunk);
+
+			auto const latency{ std::chrono::duration_cast<std::chrono::nanoseconds>(now - slot.Time_Requested) };
+			++Statistics_.Num_Generated;
+			Statistics_.Latency_Total += latency;
+			Statistics_.Latency_Max = std::max(Statistics_.Latency_Max, latency);
+		}
+
+		// Everything in range is marked before anything is evicted, so that no request takes the slot of a chunk in range.
+		Lumina::Int2 const center{ ChunkOf(tile_Center_) };
+		for (auto const& offset : Offsets_) {
+			auto const it{ Index_.find(Key({ center.x + offset.x, center.y + offset.y })) };
+			if (it == Index_.end()) { continue; }
+			Slot& slot{ Slots_[it->second] };
+			slot.Frame_LastUsed = Frame_;
+			if (slot.IsResident) {
+				Unlink(it->second);
+				PushFront(it->second);
+			}
+		}
+
+		for (auto const& offset : Offsets_) {
+			Lumina::Int2 const coord{ center.x + offset.x, center.y + offset.y };
+			if (Index_.contains(Key(coord))) { continue; }
+
+			// Out of slots: the nearer chunks have them all.
+			uint32_t const idx_Chunk{ Acquire() };
+			if (idx_Chunk == InvalidChunk) { break; }
+
+			Slot& slot{ Slots_[idx_Chunk] };
+			slot.Coord = coord;
+			slot.Frame_LastUsed = Frame_;
+			slot.Time_Requested = now;
+			slot.IsResident = false;
+			Index_.try_emplace(Key(coord), idx_Chunk);
+			++Num_Pending_;
+			Requests_.TryPush(Request{ coord, idx_Chunk });
+			Signal_.release();
+		}
+	}
+
+	void ChunkedWorld::Prefetch(Lumina::Int2 const& tile_Center_, uint32_t radius_) {
+		assert(radius_ <= StreamingParams_.Radius_Stream);
+		int32_t const radius{ static_cast<int32_t>(radius_) };
+		Lumina::Int2 const center{ ChunkOf(tile_Center_) };
+		for (;;) {
+			Update(tile_Center_);
+			bool isReady{ true };
+			for (int32_t dy{ -radius }; dy <= radius && isReady; ++dy) {
+				for (int32_t dx{ -radius }; dx <= radius && isReady; ++dx) {
+					isReady = FindChunk({ center.x + dx, center.y + dy }) != InvalidChunk;
+				}
+			}
+			if (isReady) { return; }
+			std::this_thread::yield();
+		}
+	}
+
+	void ChunkedWorld::Generate(
+		WorldGenParams const& params_,
+		Lumina::Int2 const& origin_,
+		uint32_t width_,
+		uint32_t height_,
+		int* tiles_,
+		Scratch& scratch_
+	) {
+		// A step leaves the edge of the grid as it was, so after n steps the cells n or more from it are exact.
+		// Those form the window labelled below: the tiles, the row above them, and reach tiles around.
+		uint32_t const reach{ std::max(params_.MinSize_Cave, 1U) };
+		uint32_t const apron{ params_.Num_SmoothingSteps + reach };
+		int32_t const x_Min{ origin_.x - static_cast<int32_t>(apron) };
+		int32_t const y_Min{ origin_.y - static_cast<int32_t>(apron) };
+		auto& automaton{ scratch_.Automaton };
+		automaton.Resize(width_ + 2U * apron, height_ + 2U * apron);
+
+		// Walls are the live cells.
+		auto& initial{ automaton.Grid() };
+		for (uint32_t y{ 0U }; y < initial.Height(); ++y) {
+			for (uint32_t x{ 0U }; x < initial.Width(); ++x) {
+				float const rnd{ TileNoise(params_.Seed, x_Min + static_cast<int32_t>(x), y_Min + static_cast<int32_t>(y)) };
+				initial.Set(x, y, rnd < params_.Probability_Wallification);
+			}
+		}
+
+		automaton.Step(Lumina::AutomatonRule::Caves(params_.Condition_WallifiedByNeighbors), params_.Num_SmoothingSteps);
+
+		// A region under MinSize_Cave tiles with a tile in the rows read below cannot reach the window's edge,
+		// reach tiles out, so it is labelled whole and filled whichever region is being generated.
+		// A region reaching the edge has at least reach tiles, and stays.
+		auto const& grid{ automaton.Grid() };
+		uint32_t const steps{ params_.Num_SmoothingSteps };
+		auto& components{ scratch_.Components };
+		components.Label(
+			width_ + 2U * reach, height_ + 2U * reach,
+			[&grid, steps] (uint32_t x_, uint32_t y_) { return !grid(x_ + steps, y_ + steps); }
+		);
+		auto const isFloor{
+			[&components, &params_] (uint32_t x_, uint32_t y_) {
+				uint32_t const label{ components(x_, y_) };
+				return label != Lumina::ConnectedComponents::Background && components[label].Area >= params_.MinSize_Cave;
+			}
+		};
+		for (uint32_t y{ 0U }; y < height_; ++y) {
+			int* const row{ tiles_ + static_cast<size_t>(y) * width_ };
+			for (uint32_t x{ 0U }; x < width_; ++x) {
+				if (isFloor(x + reach, y + reach)) { row[x] = 0; }
+				else { row[x] = isFloor(x + reach, y + reach + 1U) ? 2 : 1; }
+			}
+		}
+	}
+
+	void ChunkedWorld::Unlink(uint32_t idx_Chunk_) noexcept {
+		Slot& slot{ Slots_[idx_Chunk_] };
+		if (slot.Prev != InvalidChunk) { Slots_[slot.Prev].Next = slot.Next; }
+		else { Head_ = slot.Next; }
+		if (slot.Next != InvalidChunk) { Slots_[slot.Next].Prev = slot.Prev; }
+		else { Tail_ = slot.Prev; }
+		slot.Prev = InvalidChunk;
+		slot.Next = InvalidChunk;
+	}
+
+	void ChunkedWorld::PushFront(uint32_t idx_Chunk_) noexcept {
+		Slot& slot{ Slots_[idx_Chunk_] };
+		slot.Prev = InvalidChunk;
+		slot.Next = Head_;
+		if (Head_ != InvalidChunk) { Slots_[Head_].Prev = idx_Chunk_; }
+		else { Tail_ = idx_Chunk_; }
+		Head_ = idx_Chunk_;
+	}
+
+	uint32_t ChunkedWorld::Acquire() {
+		if (!Free_.empty()) {
+			uint32_t const idx_Chunk{ Free_.back() };
+			Free_.pop_back();
+			return idx_Chunk;
+		}
+		if (Tail_ == InvalidChunk || Slots_[Tail_].Frame_LastUsed == Frame_) { return InvalidChunk; }
+
+		uint32_t const idx_Chunk{ Tail_ };
+		Unlink(idx_Chunk);
+		Index_.erase(Key(Slots_[idx_Chunk].Coord));
+		++Statistics_.Num_Evicted;
+		return idx_Chunk;
+	}
+
+	void ChunkedWorld::Work() {
+		Scratch scratch{};
+		for (;;) {
+			Signal_.acquire();
+			if (IsStopping_.load(std::memory_order_acquire)) { return; }
+
+			// Each release follows a completed push, so there is a request for every acquire.
+			Request request{};
+			[[maybe_unused]] bool const isPopped{ Requests_.TryPop(request) };
+			assert(isPopped);
+			Generate(
+				GenParams_,
+				{ request.Coord.x * ChunkSize, request.Coord.y * ChunkSize },
+				static_cast<uint32_t>(ChunkSize),
+				static_cast<uint32_t>(ChunkSize),
+				Chunks_[request.Slot].data(),
+				scratch
+			);
+			Done_.TryPush(request.Slot);
+		}
+	}
+
+	ChunkedWorld::ChunkedWorld(WorldGenParams const& genParams_, ChunkStreamingParams const& streamingParams_) :
+		GenParams_{ genParams_ },
+		StreamingParams_{ streamingParams_ },
+		Requests_{ streamingParams_.Num_Chunks },
+		Done_{ streamingParams_.Num_Chunks } {
+		int32_t const radius{ static_cast<int32_t>(StreamingParams_.Radius_Stream) };
+		assert(StreamingParams_.Num_Chunks >= static_cast<uint32_t>((2 * radius + 1) * (2 * radius + 1)));
+
+		Chunks_.resize(StreamingParams_.Num_Chunks);
+		Slots_.resize(StreamingParams_.Num_Chunks);
+		Free_.reserve(StreamingParams_.Num_Chunks);
+		for (uint32_t idx_Chunk{ StreamingParams_.Num_Chunks }; idx_Chunk > 0U; --idx_Chunk) { Free_.emplace_back(idx_Chunk - 1U); }
+		Index_.reserve(StreamingParams_.Num_Chunks);
+		Arrived_.reserve(StreamingParams_.Num_Chunks);
+
+		for (int32_t dy{ -radius }; dy <= radius; ++dy) {
+			for (int32_t dx{ -radius }; dx <= radius; ++dx) { Offsets_.emplace_back(dx, dy); }
+		}
+		std::ranges::stable_sort(Offsets_, {}, [] (Lumina::Int2 const& offset_) { return offset_.x * offset_.x + offset_.y * offset_.y; });
+
+		for (uint32_t i{ 0U }; i < StreamingParams_.Num_Workers; ++i) { Workers_.emplace_back([this] () { Work(); }); }
+	}
+
+	ChunkedWorld::~ChunkedWorld() noexcept {
+		IsStopping_.store(true, std::memory_order_release);
+		Signal_.release(static_cast<ptrdiff_t>(Workers_.size()));
+		Workers_.clear();
+	}
+}
\ No newline at end of file
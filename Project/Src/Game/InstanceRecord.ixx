@@ -0,0 +1,113 @@
+module;
+
+#include<immintrin.h>
+
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+
+export module Game.InstanceRecord;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <cmath>;
+import <numbers>;
+
+import Lumina.Math.Vector;
+
+//////	//////	//////	//////	//////	//////
+
+// Compact per-instance state for 2D sprites, laid out to match Assets/Shaders/InstanceRecord.hlsli.
+//
+//	Word[0] : half PositionX	| half PositionY << 16
+//	Word[1] : half Scale		| uint16 Angle.z << 16
+//	Word[2] : uint16 Angle.x	| uint16 Angle.y << 16
+//	Word[3] : uint8 Element		| uint24 Life << 8
+//
+// Angles are stored as fractions of a full turn, so accumulated rotations wrap for free.
+// Positions are taken relative to the scene's render origin and keep 11 significant bits;
+// within 256 units of the origin the error is at most 0.0625 units.
+
+namespace Game {
+	export struct InstanceRecord {
+		uint32_t Word[4];
+	};
+	static_assert(sizeof(InstanceRecord) == 16LLU);
+
+	export struct InstanceState {
+		Lumina::Vec3 Position;
+		Lumina::Vec3 Rotate;
+		float Scale;
+		uint32_t Element;
+		uint32_t Life;
+	};
+
+	//////	//////	//////	//////	//////	//////
+
+	// Not exported, but with module linkage so that the inline Encode/Decode may use them.
+	namespace Quantization {
+		inline constexpr float AngleToTurn{ 65536.0f * std::numbers::inv_pi_v<float> * 0.5f };
+		inline constexpr float TurnToAngle{ 1.0f / AngleToTurn };
+
+		inline constexpr uint32_t MaxLife{ (1U << 24U) - 1U };
+
+		inline uint32_t Angle(float angle_) noexcept {
+			// Goes through int64 so that negative and multi-turn angles wrap instead of saturating.
+			return static_cast<uint32_t>(std::llrint(angle_ * AngleToTurn)) & 0xFFFFU;
+		}
+	}
+
+	//////	//////	//////	//////	//////	//////
+
+	export inline InstanceRecord Encode(
+		Lumina::Vec3 const& position_,
+		Lumina::Vec3 const& rotate_,
+		float scale_,
+		uint32_t element_,
+		uint32_t life_
+	) noexcept {
+		// F16C converts position and scale in one go.
+		__m128i const halves{
+			_mm_cvtps_ph(
+				_mm_setr_ps(position_.x, position_.y, scale_, 0.0f),
+				_MM_FROUND_TO_NEAREST_INT
+			)
+		};
+		uint64_t const bits{ static_cast<uint64_t>(_mm_cvtsi128_si64(halves)) };
+
+		return InstanceRecord{
+			static_cast<uint32_t>(bits),
+			static_cast<uint32_t>((bits >> 32LLU) & 0xFFFFLLU) | (Quantization::Angle(rotate_.z) << 16U),
+			Quantization::Angle(rotate_.x) | (Quantization::Angle(rotate_.y) << 16U),
+			(element_ & 0xFFU) | ((life_ < Quantization::MaxLife ? life_ : Quantization::MaxLife) << 8U),
+		};
+	}
+
+	// Mirrors DecodeInstance() in InstanceRecord.hlsli; used to verify what the GPU will see.
+	export inline InstanceState Decode(InstanceRecord const& record_) noexcept {
+		__m128 const floats{
+			_mm_cvtph_ps(
+				_mm_cvtsi64_si128(
+					static_cast<int64_t>(record_.Word[0]) |
+					(static_cast<int64_t>(record_.Word[1] & 0xFFFFU) << 32LL)
+				)
+			)
+		};
+		alignas(16) float vals[4];
+		_mm_store_ps(vals, floats);
+
+		InstanceState state{};
+		state.Position = { vals[0], vals[1], 0.0f };
+		state.Scale = vals[2];
+		state.Rotate = {
+			static_cast<float>(record_.Word[2] & 0xFFFFU) * Quantization::TurnToAngle,
+			static_cast<float>(record_.Word[2] >> 16U) * Quantization::TurnToAngle,
+			static_cast<float>(record_.Word[1] >> 16U) * Quantization::TurnToAngle,
+		};
+		state.Element = record_.Word[3] & 0xFFU;
+		state.Life = record_.Word[3] >> 8U;
+		return state;
+	}
+}
\ No newline at end of file
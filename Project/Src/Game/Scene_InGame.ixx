@@ -12,10 +12,13 @@ import <cstdint>;
 
 import <cmath>;
 import <numbers>;
+import <random>;
+import <limits>;
 
 import <memory>;
 
 import <vector>;
+import <algorithm>;
 
 import <string>;
 import <format>;
@@ -24,6 +27,12 @@ import Lumina.Math.Numerics;
 import Lumina.Math.Vector;
 import Lumina.Math.Matrix;
 import Lumina.Math.Random;
+import Lumina.Math.Bounds;
+import Lumina.Math.Frustum;
+import Lumina.Math.Culling;
+import Lumina.Math.PoissonDisk;
+import Lumina.Math.AABBTree;
+import Lumina.Math.ConnectedComponents;
 
 import Lumina.WinApp.Context;
 
@@ -33,27 +42,32 @@ import Lumina.DX12.Aux.RenderTextureEX;
 import Lumina.DX12.Context;
 
 import Lumina.Container.List;
+import Lumina.Container.FrameArena;
 import Lumina.Container.Bitset;
 
 import Lumina.Utils.Data;
 import Lumina.Utils.Data.Model;
 import Lumina.Utils.Debug;
 
-import Game.MapGenerator;
+import Game.ChunkedWorld;
+import Game.InstanceRecord;
 
 namespace Game {
 	namespace {
 		constinit float const MapBlockWidth{ 2.0f };
 		constinit float const MapBlockHeight{ 2.0f };
 
-		auto& RndGen{ Lumina::Random::Generator() };
+		// The player's chunk and two on every side are kept, and make up the window of the map the GPU holds.
+		constexpr ChunkStreamingParams StreamingParams{ .Num_Chunks{ 64U }, .Radius_Stream{ 2U }, .Num_Workers{ 2U } };
+		constexpr uint32_t Size_Window{ 2U * StreamingParams.Radius_Stream + 1U };
+		constexpr uint32_t Num_WindowChunks{ Size_Window * Size_Window };
+		constexpr uint32_t Num_WindowTiles{ Num_WindowChunks * ChunkedWorld::Num_TilesPerChunk };
 
-		struct Bounds {
-			float Left;
-			float Right;
-			float Top;
-			float Bottom;
-		};
+		// Radii enclosing plane.obj and cube.obj ([-1, 1] on each axis) under any rotation, before scaling.
+		constinit float const BoundingRadius_Square{ std::numbers::sqrt2_v<float> };
+		constinit float const BoundingRadius_Cube{ std::numbers::sqrt3_v<float> };
+
+		auto& RndGen{ Lumina::Random::Generator() };
 
 		struct RotationAnimation {
 			float InitialAngle;
@@ -78,6 +92,8 @@ namespace Game {
 			Lumina::Mat4 View_{};
 			Lumina::Mat4 Projection_{};
 			Lumina::Mat4 VP_{};
+			// Part of the z = 0 plane, where the game takes place, that VP_ shows.
+			Lumina::Rect2D VisibleRect_{};
 
 			Lumina::DX12::DefaultBuffer DB_{};
 			Lumina::DX12::UploadBuffer UB_{};
@@ -127,11 +143,16 @@ namespace Game {
 				);
 			}
 
+			// The GPU gets the view from origin_, which what it draws is placed relative to.
 			void Update(
-				Lumina::DX12::CommandList const& directList_
+				Lumina::DX12::CommandList const& directList_,
+				Lumina::Vec3 const& origin_
 			) {
 				Lumina::Mat4::Multiply(VP_, View_, Projection_);
-				UB_.Store(&VP_, sizeof(Lumina::Mat4), 0LLU);
+				VisibleRect_ = Lumina::Frustum::Extract(VP_).Footprint(0.0f);
+				Lumina::Mat4 vp_Relative{};
+				Lumina::Mat4::Multiply(vp_Relative, Lumina::Mat4::SRT(Scale_, Rotate_, Translate_ - origin_).Inv(), Projection_);
+				UB_.Store(&vp_Relative, sizeof(Lumina::Mat4), 0LLU);
 				directList_->ResourceBarrier(1U, &Barriers_[0]);
 				directList_->CopyBufferRegion(DB_.Get(), 0LLU, UB_.Get(), 0LLU, sizeof(Lumina::Mat4));
 				directList_->ResourceBarrier(1U, &Barriers_[1]);
@@ -163,12 +184,9 @@ namespace Game {
 			return { static_cast<int>(std::round(Pos_.x * 0.5f)), static_cast<int>(std::round(Pos_.y * 0.5f)) };
 		}
 
-		int GetMapBlock(Lumina::Int2 const& mapPos_, std::vector<std::vector<int>> const& map_) {
-			if (mapPos_.x > -1 && mapPos_.x < static_cast<int>(map_[0].size()) &&
-				mapPos_.y > -1 && mapPos_.y < static_cast<int>(map_.size())) {
-				return map_[mapPos_.y][mapPos_.x];
-			}
-			return 0;
+		// Solid where the chunk is not streamed in yet.
+		int GetMapBlock(Lumina::Int2 const& mapPos_, ChunkedWorld const& world_) {
+			return world_(mapPos_);
 		}
 
 		void SetMapBlockElement(int& mapBlock_, ELEMENT element_) {
@@ -464,7 +482,7 @@ namespace Game {
 				TexParams_.Time = 0.0f;
 			}
 
-			void Update(Lumina::DX12::CommandList const& directList_) {
+			void Update(Lumina::DX12::CommandList const& directList_, Lumina::Vec3 const& origin_) {
 				if (RotAnimY.CurrentFrame <= RotAnimY.TotalFrames) {
 					Rotate.y = Lerp(
 						RotAnimY.InitialAngle,
@@ -493,7 +511,7 @@ namespace Game {
 					sizeof(TextureParams)
 				);
 
-				RenderData_.Transform = Lumina::Mat4::SRT(Scale, Rotate, Position);
+				RenderData_.Transform = Lumina::Mat4::SRT(Scale, Rotate, Position - origin_);
 				UB_RenderData.Store(&RenderData_, sizeof(RenderData), 0LLU);
 
 				directList_->CopyBufferRegion(
@@ -518,12 +536,6 @@ namespace Game {
 
 			ELEMENT ElementType;
 
-			struct RenderData {
-				float Transform[4][4];
-				uint32_t ElementType;
-				float Opacity;
-			};
-
 			static void Update_TreeType(Bullet& pb_) {
 				pb_.Velocity.x += (static_cast<int32_t>(RndGen() & 127U) - 64) * 0.002f;
 				pb_.Velocity.y += (static_cast<int32_t>(RndGen() & 127U) - 64) * 0.002f;
@@ -594,6 +606,9 @@ namespace Game {
 
 			Lumina::List<Bullet> List_{ MaxNum_ };
 			uint32_t Count_Alive{ 0U };
+			uint32_t Count_Visible{ 0U };
+
+			Lumina::AABBBatch Bounds_{};
 
 			std::unique_ptr<Lumina::DX12::ImageTexture> TextureAtlas{ nullptr };
 
@@ -606,15 +621,12 @@ namespace Game {
 
 			Lumina::DX12::DefaultBuffer DB_RenderData{};
 			Lumina::DX12::UploadBuffer UB_RenderData{};
-			Lumina::DX12::DefaultBuffer DB_AliveBulletIndices{};
-			Lumina::DX12::UploadBuffer UB_AliveBulletIndices{};
 
 			MeshTest* Square{ nullptr };
 
 			enum class VIEW_NAME : uint32_t {
 				TEXTURE_ATLAS,
 				RENDER_DATA,
-				ALIVE_BULLET_INDICES,
 			};
 
 			void Initialize(
@@ -632,10 +644,8 @@ namespace Game {
 				uploader << (*TextureAtlas);
 				uploader.End(dx12Context_.DirectQueue());
 
-				DB_RenderData.Initialize(device, sizeof(Bullet::RenderData) * MaxNum_);
+				DB_RenderData.Initialize(device, sizeof(InstanceRecord) * MaxNum_);
 				UB_RenderData.Initialize(device, DB_RenderData.SizeInBytes());
-				DB_AliveBulletIndices.Initialize(device, sizeof(uint32_t) * MaxNum_);
-				UB_AliveBulletIndices.Initialize(device, DB_AliveBulletIndices.SizeInBytes());
 
 				dx12Context_.GlobalDescriptorHeap().Allocate(CSUTable_, 16U);
 				Lumina::DX12::SRV<void>::Create(
@@ -643,16 +653,11 @@ namespace Game {
 					CSUTable_.CPUHandle(VIEW_NAME::TEXTURE_ATLAS),
 					*TextureAtlas
 				);
-				Lumina::DX12::SRV<Bullet::RenderData>::Create(
+				Lumina::DX12::SRV<InstanceRecord>::Create(
 					device,
 					CSUTable_.CPUHandle(VIEW_NAME::RENDER_DATA),
 					DB_RenderData
 				);
-				Lumina::DX12::SRV<uint32_t>::Create(
-					device,
-					CSUTable_.CPUHandle(VIEW_NAME::ALIVE_BULLET_INDICES),
-					DB_AliveBulletIndices
-				);
 
 				auto&& rsSetup{ Lumina::DX12::LoadRootSignatureSetup(config_.at("BulletRS")) };
 				GraphicsRS_.Initialize(device, rsSetup, "BulletRS");
@@ -710,14 +715,17 @@ namespace Game {
 			}
 
 			void Update(
-				Lumina::DX12::CommandList const& directList_
+				Lumina::DX12::CommandList const& directList_,
+				Lumina::Rect2D const& visibleRect_,
+				Lumina::Vec3 const& origin_
 			) {
-				static Bullet::RenderData renderData{};
 				Count_Alive = 0U;
+				Bounds_.Clear();
+				// Culling scratch lives in this thread's frame arena; it is dead once the records are uploaded.
+				auto& arena{ Lumina::FrameArena::Local() };
+				Bullet const** const candidates{ arena.Allocate<Bullet const*>(MaxNum_) };
 				decltype(List_)::Iterator it{ List_ };
 				for (it.Begin(); !it.End(); it.Next()) {
-					int idx = it.Index();
-					UB_AliveBulletIndices.Store(&idx, sizeof(int), sizeof(int) * Count_Alive);
 					auto& bullet = (*it);
 					if (bullet.Life <= 0) {
 						List_.Delete(it);
@@ -747,22 +755,24 @@ namespace Game {
 						}
 					}
 					++bullet.FrameCount;
-					auto&& srt{ Lumina::Mat4::SRT(bullet.Scale * bullet.Size, bullet.Rotate, bullet.Position) };
-					std::memcpy(
-						&renderData.Transform,
-						&srt,
-						sizeof(Lumina::Mat4)
-					);
-					renderData.ElementType = bullet.ElementType;
-					renderData.Opacity = static_cast<float>(bullet.Life) / 180.0f;
-					UB_RenderData.Store(
-						&renderData,
-						sizeof(Bullet::RenderData),
-						sizeof(Bullet::RenderData) * idx
-					);
+					candidates[Count_Alive] = &bullet;
+					float const radius{ bullet.Scale.x * bullet.Size * BoundingRadius_Square };
+					Bounds_.Push(bullet.Position, { radius, radius, 0.0f });
 					++Count_Alive;
 				}
 
+				// Only the instances overlapping the camera's view of the z = 0 plane are uploaded and drawn.
+				// Records are packed densely in visible order, so the instance ID indexes them directly.
+				uint32_t* const visible{ arena.Allocate<uint32_t>(Bounds_.PaddedSize()) };
+				Count_Visible = Lumina::Cull(visibleRect_, Bounds_, visible);
+				for (uint32_t i{ 0U }; i < Count_Visible; ++i) {
+					auto const& bullet{ *candidates[visible[i]] };
+					auto const record{
+						Encode(bullet.Position - origin_, bullet.Rotate, bullet.Scale.x * bullet.Size, bullet.ElementType, static_cast<uint32_t>(bullet.Life))
+					};
+					UB_RenderData.Store(&record, sizeof(InstanceRecord), sizeof(InstanceRecord) * i);
+				}
+
 				D3D12_RESOURCE_BARRIER const barriers[]{
 					{
 						.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION,
@@ -772,14 +782,6 @@ namespace Game {
 							.StateAfter{ D3D12_RESOURCE_STATE_COPY_DEST },
 						},
 					},
-					{
-						.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION,
-						.Transition{
-							.pResource{ DB_AliveBulletIndices.Get() },
-							.StateBefore{ D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE },
-							.StateAfter{ D3D12_RESOURCE_STATE_COPY_DEST },
-						},
-					},
 					{
 						.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION,
 						.Transition{
@@ -788,19 +790,16 @@ namespace Game {
 							.StateAfter{ D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE },
 						},
 					},
-					{
-						.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION,
-						.Transition{
-							.pResource{ DB_AliveBulletIndices.Get() },
-							.StateBefore{ D3D12_RESOURCE_STATE_COPY_DEST },
-							.StateAfter{ D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE },
-						},
-					},
 				};
-				directList_->ResourceBarrier(2U, &barriers[0]);
-				directList_->CopyResource(DB_RenderData.Get(), UB_RenderData.Get());
-				directList_->CopyResource(DB_AliveBulletIndices.Get(), UB_AliveBulletIndices.Get());
-				directList_->ResourceBarrier(2U, &barriers[2]);
+				if (Count_Visible) {
+					directList_->ResourceBarrier(1U, &barriers[0]);
+					directList_->CopyBufferRegion(
+						DB_RenderData.Get(), 0LLU,
+						UB_RenderData.Get(), 0LLU,
+						sizeof(InstanceRecord) * Count_Visible
+					);
+					directList_->ResourceBarrier(1U, &barriers[1]);
+				}
 			}
 
 			void Render(
@@ -815,8 +814,8 @@ namespace Game {
 				directList_->SetGraphicsRootDescriptorTable(2U, CSUTable_.GPUHandle(1U));
 				directList_->IASetVertexBuffers(0U, 1U, &(Square->VBV));
 				directList_->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-				if (Count_Alive) {
-					directList_->DrawInstanced(Square->Num_Vertices, Count_Alive, 0U, 0U);
+				if (Count_Visible) {
+					directList_->DrawInstanced(Square->Num_Vertices, Count_Visible, 0U, 0U);
 				}
 			}
 		};
@@ -833,11 +832,6 @@ namespace Game {
 
 			ELEMENT ElementType;
 
-			struct RenderData {
-				float Transform[4][4];
-				uint32_t ElementType;
-			};
-
 			static void Update_TreeType(Enemy& e_) {
 				e_.Velocity.x += (static_cast<int32_t>(RndGen() & 127U) - 64) * 0.0005f;
 				e_.Velocity.y += (static_cast<int32_t>(RndGen() & 127U) - 64) * 0.0005f;
@@ -865,6 +859,23 @@ namespace Game {
 
 			Lumina::List<Enemy> List_{ MaxNum_ };
 			uint32_t Count_Alive{ 0U };
+			uint32_t Count_Visible{ 0U };
+
+			Lumina::AABBBatch Bounds_{};
+
+			// Ring spawns draw from a blue-noise set around SpawnOrigin_, so successive enemies neither clump nor appear inside blocks.
+			// The set is refilled once used up or once the player has moved a spacing away.
+			static constinit inline float SpawnRadius_Inner_{ 26.0f };
+			static constinit inline float SpawnRadius_Outer_{ 34.0f };
+			static constinit inline float SpawnSpacing_{ 4.0f };
+
+			std::vector<Lumina::Vec2> SpawnSites_{};
+			Lumina::Vec2 SpawnOrigin_{};
+
+			// Hit circles' bounds for hit tests, kept across frames; an enemy only moves in the tree once it leaves its fat box.
+			// Proxies_ holds the proxy of each List_ slot, Invalid for empty slots.
+			Lumina::AABBTree<2U> Targets_{};
+			std::vector<uint32_t> Proxies_{ std::vector<uint32_t>(MaxNum_, Lumina::AABBTree<2U>::Invalid) };
 
 			MeshTest* Mesh{ nullptr };
 
@@ -889,8 +900,44 @@ namespace Game {
 
 			Lumina::DX12::DefaultBuffer DB_RenderData{};
 			Lumina::DX12::UploadBuffer UB_RenderData{};
-			Lumina::DX12::DefaultBuffer DB_AliveEnemyIndices{};
-			Lumina::DX12::UploadBuffer UB_AliveEnemyIndices{};
+
+			template<typename T_IsSolid>
+			bool NextSpawnSite(Lumina::Vec3 const& center_, T_IsSolid&& isSolid_, Lumina::Vec3& pos_) {
+				float const dx{ center_.x - SpawnOrigin_.x };
+				float const dy{ center_.y - SpawnOrigin_.y };
+				if (SpawnSites_.empty() || (dx * dx + dy * dy > SpawnSpacing_ * SpawnSpacing_)) {
+					SpawnOrigin_ = { center_.x, center_.y };
+
+					Lumina::PoissonDisk<2U> sampler{ {
+						.Min{ center_.x - SpawnRadius_Outer_, center_.y - SpawnRadius_Outer_ },
+						.Max{ center_.x + SpawnRadius_Outer_, center_.y + SpawnRadius_Outer_ },
+						.MinRadius{ SpawnSpacing_ },
+						.MaxRadius{ SpawnSpacing_ },
+					} };
+					std::mt19937 rndGen{ RndGen() };
+					sampler.Generate(
+						rndGen,
+						[] (Lumina::Vec2 const&) { return SpawnSpacing_; },
+						[&] (Lumina::Vec2 const& site_) {
+							float const dx_Site{ site_.x - center_.x };
+							float const dy_Site{ site_.y - center_.y };
+							float const dist2{ dx_Site * dx_Site + dy_Site * dy_Site };
+							return
+								(dist2 >= SpawnRadius_Inner_ * SpawnRadius_Inner_) &&
+								(dist2 <= SpawnRadius_Outer_ * SpawnRadius_Outer_) &&
+								!isSolid_(site_);
+						}
+					);
+					SpawnSites_ = sampler.Points();
+					std::shuffle(SpawnSites_.begin(), SpawnSites_.end(), rndGen);
+				}
+				if (SpawnSites_.empty()) { return false; }
+
+				pos_.x = SpawnSites_.back().x;
+				pos_.y = SpawnSites_.back().y;
+				SpawnSites_.pop_back();
+				return true;
+			}
 
 			void Initialize(
 				Lumina::DX12::Context const& dx12Context_,
@@ -900,10 +947,8 @@ namespace Game {
 
 				Texture_.Initialize(device, 64U, 64U);
 
-				DB_RenderData.Initialize(device, sizeof(Enemy::RenderData) * MaxNum_);
+				DB_RenderData.Initialize(device, sizeof(InstanceRecord) * MaxNum_);
 				UB_RenderData.Initialize(device, DB_RenderData.SizeInBytes());
-				DB_AliveEnemyIndices.Initialize(device, sizeof(uint32_t) * MaxNum_);
-				UB_AliveEnemyIndices.Initialize(device, DB_AliveEnemyIndices.SizeInBytes());
 
 				dx12Context_.GlobalDescriptorHeap().Allocate(CSUTable_, 16U);
 
@@ -918,16 +963,11 @@ namespace Game {
 					Texture_
 				);
 
-				Lumina::DX12::SRV<Enemy::RenderData>::Create(
+				Lumina::DX12::SRV<InstanceRecord>::Create(
 					device,
 					CSUTable_.CPUHandle(2U),
 					DB_RenderData
 				);
-				Lumina::DX12::SRV<uint32_t>::Create(
-					device,
-					CSUTable_.CPUHandle(3U),
-					DB_AliveEnemyIndices
-				);
 
 				DB_TextureParams_.Initialize(device, 256LLU);
 				UB_TextureParams_.Initialize(device, DB_TextureParams_.SizeInBytes());
@@ -1013,21 +1053,34 @@ namespace Game {
 				);
 			}
 
+			// Every deletion goes through here, so that no proxy outlives its enemy.
+			void Delete(Lumina::List<Enemy>::Iterator<Enemy>& it_) {
+				uint32_t& proxy{ Proxies_[it_.Index()] };
+				if (proxy != Lumina::AABBTree<2U>::Invalid) {
+					Targets_.DestroyProxy(proxy);
+					proxy = Lumina::AABBTree<2U>::Invalid;
+				}
+				List_.Delete(it_);
+			}
+
 			void Update(
 				Lumina::DX12::CommandList const& directList_,
-				Player const& player_
+				Player const& player_,
+				Lumina::Rect2D const& visibleRect_,
+				Lumina::Vec3 const& origin_
 			) {
-				static Enemy::RenderData renderData{};
 				Count_Alive = 0U;
+				Bounds_.Clear();
+				auto& arena{ Lumina::FrameArena::Local() };
+				Enemy const** const candidates{ arena.Allocate<Enemy const*>(MaxNum_) };
 				decltype(List_)::Iterator it{ List_ };
 				for (it.Begin(); !it.End(); it.Next()) {
-					int idx = it.Index();
-					UB_AliveEnemyIndices.Store(&idx, sizeof(int), sizeof(int) * Count_Alive);
 					auto& enemy = (*it);
 					if (enemy.Life <= 0.0f) {
-						List_.Delete(it);
+						Delete(it);
 						continue;
 					}
+					Lumina::Vec3 const position_Old{ enemy.Position };
 					enemy.Position += enemy.Velocity;
 					switch (enemy.ElementType) {
 						case ELEMENT::TREE: {
@@ -1059,21 +1112,37 @@ namespace Game {
 					++enemy.FrameCount;
 					enemy.Rotate.x += (RndGen() & 127U) * 0.0001f;
 					enemy.Rotate.y += (RndGen() & 127U) * 0.0001f;
-					auto&& srt{ Lumina::Mat4::SRT(enemy.Scale, enemy.Rotate, enemy.Position) };
-					std::memcpy(
-						&renderData.Transform,
-						&srt,
-						sizeof(Lumina::Mat4)
-					);
-					renderData.ElementType = enemy.ElementType;
-					UB_RenderData.Store(
-						&renderData,
-						sizeof(Enemy::RenderData),
-						sizeof(Enemy::RenderData) * idx
-					);
+
+					float const radius_Hit{ enemy.Scale.x };
+					Lumina::AABBTree<2U>::Box const box_Hit{
+						{ enemy.Position.x - radius_Hit, enemy.Position.y - radius_Hit },
+						{ enemy.Position.x + radius_Hit, enemy.Position.y + radius_Hit },
+					};
+					uint32_t& proxy{ Proxies_[it.Index()] };
+					if (proxy == Lumina::AABBTree<2U>::Invalid) {
+						proxy = Targets_.CreateProxy(box_Hit, static_cast<uint32_t>(it.Index()));
+					}
+					else {
+						Targets_.MoveProxy(proxy, box_Hit, { enemy.Position.x - position_Old.x, enemy.Position.y - position_Old.y });
+					}
+
+					candidates[Count_Alive] = &enemy;
+					float const radius{ enemy.Scale.x * BoundingRadius_Cube };
+					Bounds_.Push(enemy.Position, { radius, radius, 0.0f });
 					++Count_Alive;
 				}
 
+				// Only the instances overlapping the camera's view of the z = 0 plane are uploaded and drawn.
+				uint32_t* const visible{ arena.Allocate<uint32_t>(Bounds_.PaddedSize()) };
+				Count_Visible = Lumina::Cull(visibleRect_, Bounds_, visible);
+				for (uint32_t i{ 0U }; i < Count_Visible; ++i) {
+					auto const& enemy{ *candidates[visible[i]] };
+					auto const record{
+						Encode(enemy.Position - origin_, enemy.Rotate, enemy.Scale.x, enemy.ElementType, static_cast<uint32_t>(enemy.Life))
+					};
+					UB_RenderData.Store(&record, sizeof(InstanceRecord), sizeof(InstanceRecord) * i);
+				}
+
 				D3D12_RESOURCE_BARRIER const barriers[]{
 					{
 						.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION,
@@ -1083,14 +1152,6 @@ namespace Game {
 							.StateAfter{ D3D12_RESOURCE_STATE_COPY_DEST },
 						},
 					},
-					{
-						.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION,
-						.Transition{
-							.pResource{ DB_AliveEnemyIndices.Get() },
-							.StateBefore{ D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE },
-							.StateAfter{ D3D12_RESOURCE_STATE_COPY_DEST },
-						},
-					},
 					{
 						.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION,
 						.Transition{
@@ -1099,19 +1160,16 @@ namespace Game {
 							.StateAfter{ D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE },
 						},
 					},
-					{
-						.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION,
-						.Transition{
-							.pResource{ DB_AliveEnemyIndices.Get() },
-							.StateBefore{ D3D12_RESOURCE_STATE_COPY_DEST },
-							.StateAfter{ D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE },
-						},
-					},
 				};
-				directList_->ResourceBarrier(2U, &barriers[0]);
-				directList_->CopyResource(DB_RenderData.Get(), UB_RenderData.Get());
-				directList_->CopyResource(DB_AliveEnemyIndices.Get(), UB_AliveEnemyIndices.Get());
-				directList_->ResourceBarrier(2U, &barriers[2]);
+				if (Count_Visible) {
+					directList_->ResourceBarrier(1U, &barriers[0]);
+					directList_->CopyBufferRegion(
+						DB_RenderData.Get(), 0LLU,
+						UB_RenderData.Get(), 0LLU,
+						sizeof(InstanceRecord) * Count_Visible
+					);
+					directList_->ResourceBarrier(1U, &barriers[1]);
+				}
 			}
 
 			void Render(
@@ -1127,8 +1185,8 @@ namespace Game {
 				directList_->SetGraphicsRootDescriptorTable(3U, CSUTable_.GPUHandle(0U));
 				directList_->IASetVertexBuffers(0U, 1U, &(Mesh->VBV));
 				directList_->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-				if (Count_Alive) {
-					directList_->DrawInstanced(Mesh->Num_Vertices, Count_Alive, 0U, 0U);
+				if (Count_Visible) {
+					directList_->DrawInstanced(Mesh->Num_Vertices, Count_Visible, 0U, 0U);
 				}
 			}
 		};
@@ -1138,6 +1196,9 @@ namespace Game {
 
 			Lumina::List<Bullet> List_{ MaxNum_ };
 			uint32_t Count_Alive{ 0U };
+			uint32_t Count_Visible{ 0U };
+
+			Lumina::AABBBatch Bounds_{};
 
 			std::unique_ptr<Lumina::DX12::ImageTexture> TextureAtlas{ nullptr };
 
@@ -1150,15 +1211,12 @@ namespace Game {
 
 			Lumina::DX12::DefaultBuffer DB_RenderData{};
 			Lumina::DX12::UploadBuffer UB_RenderData{};
-			Lumina::DX12::DefaultBuffer DB_AliveBulletIndices{};
-			Lumina::DX12::UploadBuffer UB_AliveBulletIndices{};
 
 			MeshTest* Square{ nullptr };
 
 			enum class VIEW_NAME : uint32_t {
 				TEXTURE_ATLAS,
 				RENDER_DATA,
-				ALIVE_BULLET_INDICES,
 			};
 
 			void Initialize(
@@ -1176,10 +1234,8 @@ namespace Game {
 				uploader << (*TextureAtlas);
 				uploader.End(dx12Context_.DirectQueue());
 
-				DB_RenderData.Initialize(device, sizeof(Bullet::RenderData) * MaxNum_);
+				DB_RenderData.Initialize(device, sizeof(InstanceRecord) * MaxNum_);
 				UB_RenderData.Initialize(device, DB_RenderData.SizeInBytes());
-				DB_AliveBulletIndices.Initialize(device, sizeof(uint32_t) * MaxNum_);
-				UB_AliveBulletIndices.Initialize(device, DB_AliveBulletIndices.SizeInBytes());
 
 				dx12Context_.GlobalDescriptorHeap().Allocate(CSUTable_, 16U);
 				Lumina::DX12::SRV<void>::Create(
@@ -1187,16 +1243,11 @@ namespace Game {
 					CSUTable_.CPUHandle(VIEW_NAME::TEXTURE_ATLAS),
 					*TextureAtlas
 				);
-				Lumina::DX12::SRV<Bullet::RenderData>::Create(
+				Lumina::DX12::SRV<InstanceRecord>::Create(
 					device,
 					CSUTable_.CPUHandle(VIEW_NAME::RENDER_DATA),
 					DB_RenderData
 				);
-				Lumina::DX12::SRV<uint32_t>::Create(
-					device,
-					CSUTable_.CPUHandle(VIEW_NAME::ALIVE_BULLET_INDICES),
-					DB_AliveBulletIndices
-				);
 
 				auto&& rsSetup{ Lumina::DX12::LoadRootSignatureSetup(config_.at("BulletRS")) };
 				GraphicsRS_.Initialize(device, rsSetup, "BulletRS");
@@ -1254,14 +1305,16 @@ namespace Game {
 			}
 
 			void Update(
-				Lumina::DX12::CommandList const& directList_
+				Lumina::DX12::CommandList const& directList_,
+				Lumina::Rect2D const& visibleRect_,
+				Lumina::Vec3 const& origin_
 			) {
-				static Bullet::RenderData renderData{};
 				Count_Alive = 0U;
+				Bounds_.Clear();
+				auto& arena{ Lumina::FrameArena::Local() };
+				Bullet const** const candidates{ arena.Allocate<Bullet const*>(MaxNum_) };
 				decltype(List_)::Iterator it{ List_ };
 				for (it.Begin(); !it.End(); it.Next()) {
-					int idx = it.Index();
-					UB_AliveBulletIndices.Store(&idx, sizeof(int), sizeof(int) * Count_Alive);
 					auto& bullet = (*it);
 					if (bullet.Life <= 0) {
 						List_.Delete(it);
@@ -1269,22 +1322,23 @@ namespace Game {
 					}
 					bullet.Position += bullet.Velocity;
 					++bullet.FrameCount;
-					auto&& srt{ Lumina::Mat4::SRT(bullet.Scale, bullet.Rotate, bullet.Position) };
-					std::memcpy(
-						&renderData.Transform,
-						&srt,
-						sizeof(Lumina::Mat4)
-					);
-					renderData.ElementType = bullet.ElementType;
-					renderData.Opacity = static_cast<float>(bullet.Life) / 180.0f;
-					UB_RenderData.Store(
-						&renderData,
-						sizeof(Bullet::RenderData),
-						sizeof(Bullet::RenderData) * idx
-					);
+					candidates[Count_Alive] = &bullet;
+					float const radius{ bullet.Scale.x * BoundingRadius_Square };
+					Bounds_.Push(bullet.Position, { radius, radius, 0.0f });
 					++Count_Alive;
 				}
 
+				// Only the instances overlapping the camera's view of the z = 0 plane are uploaded and drawn.
+				uint32_t* const visible{ arena.Allocate<uint32_t>(Bounds_.PaddedSize()) };
+				Count_Visible = Lumina::Cull(visibleRect_, Bounds_, visible);
+				for (uint32_t i{ 0U }; i < Count_Visible; ++i) {
+					auto const& bullet{ *candidates[visible[i]] };
+					auto const record{
+						Encode(bullet.Position - origin_, bullet.Rotate, bullet.Scale.x, bullet.ElementType, static_cast<uint32_t>(bullet.Life))
+					};
+					UB_RenderData.Store(&record, sizeof(InstanceRecord), sizeof(InstanceRecord) * i);
+				}
+
 				D3D12_RESOURCE_BARRIER const barriers[]{
 					{
 						.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION,
@@ -1294,14 +1348,6 @@ namespace Game {
 							.StateAfter{ D3D12_RESOURCE_STATE_COPY_DEST },
 						},
 					},
-					{
-						.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION,
-						.Transition{
-							.pResource{ DB_AliveBulletIndices.Get() },
-							.StateBefore{ D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE },
-							.StateAfter{ D3D12_RESOURCE_STATE_COPY_DEST },
-						},
-					},
 					{
 						.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION,
 						.Transition{
@@ -1310,19 +1356,16 @@ namespace Game {
 							.StateAfter{ D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE },
 						},
 					},
-					{
-						.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION,
-						.Transition{
-							.pResource{ DB_AliveBulletIndices.Get() },
-							.StateBefore{ D3D12_RESOURCE_STATE_COPY_DEST },
-							.StateAfter{ D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE },
-						},
-					},
 				};
-				directList_->ResourceBarrier(2U, &barriers[0]);
-				directList_->CopyResource(DB_RenderData.Get(), UB_RenderData.Get());
-				directList_->CopyResource(DB_AliveBulletIndices.Get(), UB_AliveBulletIndices.Get());
-				directList_->ResourceBarrier(2U, &barriers[2]);
+				if (Count_Visible) {
+					directList_->ResourceBarrier(1U, &barriers[0]);
+					directList_->CopyBufferRegion(
+						DB_RenderData.Get(), 0LLU,
+						UB_RenderData.Get(), 0LLU,
+						sizeof(InstanceRecord) * Count_Visible
+					);
+					directList_->ResourceBarrier(1U, &barriers[1]);
+				}
 			}
 
 			void Render(
@@ -1337,8 +1380,8 @@ namespace Game {
 				directList_->SetGraphicsRootDescriptorTable(2U, CSUTable_.GPUHandle(1U));
 				directList_->IASetVertexBuffers(0U, 1U, &(Square->VBV));
 				directList_->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-				if (Count_Alive) {
-					directList_->DrawInstanced(Square->Num_Vertices, Count_Alive, 0U, 0U);
+				if (Count_Visible) {
+					directList_->DrawInstanced(Square->Num_Vertices, Count_Visible, 0U, 0U);
 				}
 			}
 		};
@@ -1599,9 +1642,13 @@ namespace Game {
 	}
 
 	export class Scene_InGame {
+		// Laid out as MAPMETADATA in Assets/Shaders/InGameMap.*.hlsl.
 		struct MapMetadata {
+			// Of the window, in chunks.
 			uint32_t Width;
 			uint32_t Height;
+			// Of the window's lower left tile from the render origin.
+			Lumina::Float2 Offset;
 		};
 
 	private:
@@ -1625,31 +1672,92 @@ namespace Game {
 				},
 			};
 
+			Lumina::Int2 const tile_Player{ MapPos(Player_->Position) };
+			World_->Update(tile_Player);
+
 			directList_->ResourceBarrier(1U, &barriers[0]);
-			for (uint32_t y = 0; y < MapMetadata_.Height; ++y) {
-				for (uint32_t x = 0; x < MapMetadata_.Width; ++x) {
-					if (MapBlockDamage(Map_[y][x]) >= 400 &&
-						y != 0 && y != MapMetadata_.Height - 1 &&
-						x != 0 && x != MapMetadata_.Width - 1) {
-						Map_[y][x] = 0;
-						UB_MapData_.Store(
-							&Map_[y][x],
-							sizeof(int),
-							sizeof(int) * (MapMetadata_.Width * y + x)
-						);
-						directList_->CopyBufferRegion(
-							Buffer_MapData_.Get(),
-							sizeof(int) * (MapMetadata_.Width * y + x),
-							UB_MapData_.Get(),
-							sizeof(int) * (MapMetadata_.Width * y + x),
-							sizeof(int)
-						);
-					}
+
+			// The window follows the player from chunk to chunk, and is filled anew when it moves;
+			// otherwise only the chunks that came in are.
+			Lumina::Int2 const chunk_Player{ ChunkedWorld::ChunkOf(tile_Player) };
+			int32_t const radius{ static_cast<int32_t>(StreamingParams.Radius_Stream) };
+			if (chunk_Player.x - radius != WindowOrigin_.x || chunk_Player.y - radius != WindowOrigin_.y) {
+				MoveWindow({ chunk_Player.x - radius, chunk_Player.y - radius });
+				for (uint32_t idx_Slot{ 0U }; idx_Slot < Num_WindowChunks; ++idx_Slot) { UploadWindowSlot(directList_, idx_Slot); }
+			}
+			else {
+				for (uint32_t const idx_Chunk : World_->Arrived()) {
+					uint32_t const idx_Slot{ WindowSlot(World_->ChunkCoord(idx_Chunk)) };
+					if (idx_Slot != ChunkedWorld::InvalidChunk) { UploadWindowSlot(directList_, idx_Slot); }
 				}
 			}
+
+			// Blocks hit last frame that took enough damage are gone.
+			for (auto const& tile : Tiles_Hit_) {
+				int* const block{ World_->Find(tile) };
+				if (block == nullptr || MapBlockDamage(*block) < 400) { continue; }
+				*block = 0;
+
+				uint32_t const idx_Slot{ WindowSlot(ChunkedWorld::ChunkOf(tile)) };
+				if (idx_Slot == ChunkedWorld::InvalidChunk) { continue; }
+				size_t const offset{ sizeof(ChunkedWorld::Chunk) * idx_Slot + sizeof(int) * ChunkedWorld::LocalIndex(tile) };
+				UB_MapData_.Store(block, sizeof(int), offset);
+				directList_->CopyBufferRegion(Buffer_MapData_.Get(), offset, UB_MapData_.Get(), offset, sizeof(int));
+			}
+			Tiles_Hit_.clear();
+
 			directList_->ResourceBarrier(1U, &barriers[1]);
 		}
 
+		// The window's slots are its chunks row by row from the lower left, each as ChunkedWorld keeps it;
+		// the slot of a chunk outside the window is InvalidChunk.
+		uint32_t WindowSlot(Lumina::Int2 const& chunk_) const noexcept {
+			int32_t const x{ chunk_.x - WindowOrigin_.x };
+			int32_t const y{ chunk_.y - WindowOrigin_.y };
+			if (x < 0 || y < 0 || x >= static_cast<int32_t>(Size_Window) || y >= static_cast<int32_t>(Size_Window)) {
+				return ChunkedWorld::InvalidChunk;
+			}
+			return static_cast<uint32_t>(y) * Size_Window + static_cast<uint32_t>(x);
+		}
+
+		// Stages a slot's chunk, or floor while it is not resident, and copies it to the GPU's window.
+		void UploadWindowSlot(Lumina::DX12::CommandList const& directList_, uint32_t idx_Slot_) {
+			static ChunkedWorld::Chunk const empty{};
+			Lumina::Int2 const chunk{
+				WindowOrigin_.x + static_cast<int32_t>(idx_Slot_ % Size_Window),
+				WindowOrigin_.y + static_cast<int32_t>(idx_Slot_ / Size_Window),
+			};
+			uint32_t const idx_Chunk{ World_->FindChunk(chunk) };
+			size_t const offset{ sizeof(ChunkedWorld::Chunk) * idx_Slot_ };
+			UB_MapData_.Store(
+				(idx_Chunk != ChunkedWorld::InvalidChunk) ? World_->GetChunk(idx_Chunk).data() : empty.data(),
+				sizeof(ChunkedWorld::Chunk),
+				offset
+			);
+			directList_->CopyBufferRegion(Buffer_MapData_.Get(), offset, UB_MapData_.Get(), offset, sizeof(ChunkedWorld::Chunk));
+		}
+
+		// Everything drawn is placed relative to the window's centre, where half-float positions stay precise
+		// however far the player goes.
+		void MoveWindow(Lumina::Int2 const& origin_) {
+			WindowOrigin_ = origin_;
+			float const halfSize{ static_cast<float>(Size_Window * ChunkedWorld::ChunkSize / 2U) };
+			RenderOrigin_ = {
+				(static_cast<float>(origin_.x * ChunkedWorld::ChunkSize) + halfSize) * MapBlockWidth,
+				(static_cast<float>(origin_.y * ChunkedWorld::ChunkSize) + halfSize) * MapBlockHeight,
+				0.0f
+			};
+		}
+
+		// The part of the z = 0 plane the window covers; what leaves it is gone.
+		bool IsOutsideWindow(Lumina::Vec3 const& pos_) const noexcept {
+			float const halfWidth{ static_cast<float>(Size_Window * ChunkedWorld::ChunkSize / 2U) * MapBlockWidth };
+			float const halfHeight{ static_cast<float>(Size_Window * ChunkedWorld::ChunkSize / 2U) * MapBlockHeight };
+			return
+				pos_.x < RenderOrigin_.x - halfWidth || pos_.x > RenderOrigin_.x + halfWidth ||
+				pos_.y < RenderOrigin_.y - halfHeight || pos_.y > RenderOrigin_.y + halfHeight;
+		}
+
 		void UpdatePlayer(
 			Lumina::WinApp::Context const& winAppContext_,
 			Lumina::DX12::CommandList const& directList_
@@ -1659,8 +1767,10 @@ namespace Game {
 					winAppContext_.WindowInstance(L"Main")
 				).Keyboard()
 			};
-			Keyboard_Previous_.Set(Keyboard_Current_);
+			Keyboard_Previous_ = Keyboard_Current_;
 			keyboard.CurrentState(Keyboard_Current_);
+			// Keys that went down this frame, four words at once instead of one key at a time.
+			auto const keyboard_Pressed{ Lumina::Bitset<256U>::RisingEdges(Keyboard_Current_, Keyboard_Previous_) };
 
 			if (keyboard.IsPressed(Lumina::WinApp::KEY::SPACE)) {
 				if (Player_->ElementPowers[Player_->ElementInUse] > 0.0f) {
@@ -1706,7 +1816,7 @@ namespace Game {
 				}
 
 				Player_->Position.y += 0.25f;
-				if (MapBlockType(GetMapBlock(MapPos(Player_->Position + Lumina::Vec3{ 0.0f, 1.0f, 0.0f }), Map_)) != 0) {
+				if (MapBlockType(GetMapBlock(MapPos(Player_->Position + Lumina::Vec3{ 0.0f, 1.0f, 0.0f }), *World_)) != 0) {
 					Player_->Position.y -= 0.25f;
 				}
 				Player_->DirectionZ = 1;
@@ -1720,7 +1830,7 @@ namespace Game {
 				}
 
 				Player_->Position.y -= 0.25f;
-				if (MapBlockType(GetMapBlock(MapPos(Player_->Position + Lumina::Vec3{ 0.0f, -1.0f, 0.0f }), Map_)) != 0) {
+				if (MapBlockType(GetMapBlock(MapPos(Player_->Position + Lumina::Vec3{ 0.0f, -1.0f, 0.0f }), *World_)) != 0) {
 					Player_->Position.y += 0.25f;
 				}
 				Player_->DirectionZ = -1;
@@ -1743,7 +1853,7 @@ namespace Game {
 
 				Player_->Position.x -= 0.25f;
 
-				if (MapBlockType(GetMapBlock(MapPos(Player_->Position + Lumina::Vec3{ -1.0f, 0.0f, 0.0f }), Map_)) != 0) {
+				if (MapBlockType(GetMapBlock(MapPos(Player_->Position + Lumina::Vec3{ -1.0f, 0.0f, 0.0f }), *World_)) != 0) {
 					Player_->Position.x += 0.25f;
 				}
 				Player_->DirectionY = -1;
@@ -1757,26 +1867,20 @@ namespace Game {
 
 				Player_->Position.x += 0.25f;
 
-				if (MapBlockType(GetMapBlock(MapPos(Player_->Position + Lumina::Vec3{ 1.0f, 0.0f, 0.0f }), Map_)) != 0) {
+				if (MapBlockType(GetMapBlock(MapPos(Player_->Position + Lumina::Vec3{ 1.0f, 0.0f, 0.0f }), *World_)) != 0) {
 					Player_->Position.x -= 0.25f;
 				}
 				Player_->DirectionY = 1;
 			}
 
-			if (
-				Keyboard_Current_[static_cast<int>(Lumina::WinApp::KEY::Z)] &&
-				!Keyboard_Previous_[static_cast<int>(Lumina::WinApp::KEY::Z)]
-			) {
+			if (keyboard_Pressed[static_cast<int>(Lumina::WinApp::KEY::Z)]) {
 				Player_->ElementInUse = static_cast<ELEMENT>((static_cast<int>(Player_->ElementInUse) + 1) % 6);
 			}
-			if (
-				Keyboard_Current_[static_cast<int>(Lumina::WinApp::KEY::X)] &&
-				!Keyboard_Previous_[static_cast<int>(Lumina::WinApp::KEY::X)]
-			) {
+			if (keyboard_Pressed[static_cast<int>(Lumina::WinApp::KEY::X)]) {
 				Player_->ElementInUse = static_cast<ELEMENT>((static_cast<int>(Player_->ElementInUse) + 5) % 6);
 			}
 
-			Player_->Update(directList_);
+			Player_->Update(directList_, RenderOrigin_);
 		}
 
 		void RenderPlayer(Lumina::DX12::CommandList const& directList_) {
@@ -1792,40 +1896,58 @@ namespace Game {
 		}
 
 		void UpdatePlayerBullets(Lumina::DX12::CommandList const& directList_) {
-			PlayerBulletManager_->Update(directList_);
+			PlayerBulletManager_->Update(directList_, Camera_->VisibleRect_, RenderOrigin_);
 
 			decltype(PlayerBulletManager_->List_)::Iterator it{ PlayerBulletManager_->List_ };
 			for (it.Begin(); !it.End(); it.Next()) {
 				auto& bullet = (*it);
 				auto pos = MapPos(bullet.Position);
-				if (MapBlockType(GetMapBlock(MapPos(bullet.Position), Map_)) != 0) {
+				// Bullets pass through chunks not streamed in yet.
+				int* const block{ World_->Find(pos) };
+				if (block != nullptr && MapBlockType(*block) != 0) {
 					switch (bullet.ElementType) {
 						case ELEMENT::TREE: {
-							Bullet::OnHitBlock_TreeType(bullet, Map_[pos.y][pos.x]);
+							Bullet::OnHitBlock_TreeType(bullet, *block);
 							break;
 						}
 						case ELEMENT::FIRE: {
-							Bullet::OnHitBlock_FireType(bullet, Map_[pos.y][pos.x]);
+							Bullet::OnHitBlock_FireType(bullet, *block);
 							break;
 						}
 						case ELEMENT::EARTH: {
-							Bullet::OnHitBlock_EarthType(bullet, Map_[pos.y][pos.x]);
+							Bullet::OnHitBlock_EarthType(bullet, *block);
 							break;
 						}
 						case ELEMENT::METAL: {
-							Bullet::OnHitBlock_MetalType(bullet, Map_[pos.y][pos.x]);
+							Bullet::OnHitBlock_MetalType(bullet, *block);
 							break;
 						}
 						case ELEMENT::WATER: {
-							Bullet::OnHitBlock_WaterType(bullet, Map_[pos.y][pos.x]);
+							Bullet::OnHitBlock_WaterType(bullet, *block);
 							break;
 						}
 						default: {
-							Bullet::OnHitBlock(bullet, Map_[pos.y][pos.x]);
+							Bullet::OnHitBlock(bullet, *block);
 							break;
 						}
 					}
+					Tiles_Hit_.emplace_back(pos);
+				}
+			}
+		}
+
+		// Moves an enemy spawned at the player onto a free site of the spawn ring.
+		void PlaceOnSpawnRing(Lumina::Vec3& pos_) {
+			auto const isSolid{
+				[this] (Lumina::Vec2 const& site_) {
+					return (MapBlockType(GetMapBlock(MapPos({ site_.x, site_.y, 0.0f }), *World_)) != 0);
 				}
+			};
+			if (!EnemyManager_->NextSpawnSite(Player_->Position, isSolid, pos_)) {
+				// Every site on the ring is solid; fall back to an arbitrary point on it.
+				float theta = static_cast<float>(RndGen() % 360U) * 0.0174532925f;
+				pos_.x += std::cos(theta) * 30.0f;
+				pos_.y += std::sin(theta) * 30.0f;
 			}
 		}
 
@@ -1847,24 +1969,20 @@ namespace Game {
 
 				switch (enemy.ElementType) {
 					case ELEMENT::WATER: {
-						enemy.Position.y = MapMetadata_.Height * 2.0f + static_cast<float>(RndGen() % 10U);
+						enemy.Position.y = Camera_->VisibleRect_.MaxY + static_cast<float>(RndGen() % 10U);
 						break;
 					}
 					case ELEMENT::FIRE: {
-						enemy.Position.y = -static_cast<float>(RndGen() % 5U);
+						enemy.Position.y = Camera_->VisibleRect_.MinY - static_cast<float>(RndGen() % 5U);
 						break;
 					}
 					case ELEMENT::TREE:
 					case ELEMENT::EARTH: {
-						float theta = static_cast<float>(RndGen() % 360U) * 0.0174532925f;
-						enemy.Position.x += std::cos(theta) * 30.0f;
-						enemy.Position.y += std::sin(theta) * 30.0f;
+						PlaceOnSpawnRing(enemy.Position);
 						break;
 					}
 					case ELEMENT::METAL: {
-						float theta = static_cast<float>(RndGen() % 360U) * 0.0174532925f;
-						enemy.Position.x += std::cos(theta) * 30.0f;
-						enemy.Position.y += std::sin(theta) * 30.0f;
+						PlaceOnSpawnRing(enemy.Position);
 						if (RndGen() & 1U) {
 							enemy.Velocity.x = 0.2f;
 							if (enemy.Position.x > Player_->Position.x) { enemy.Velocity.x *= -1.0f; }
@@ -1880,18 +1998,14 @@ namespace Game {
 
 			++cnt;
 
-			EnemyManager_->Update(directList_, *Player_);
+			EnemyManager_->Update(directList_, *Player_, Camera_->VisibleRect_, RenderOrigin_);
 
 			decltype(EnemyManager_->List_)::Iterator it_Enemy{ EnemyManager_->List_ };
 			for (it_Enemy.Begin(); !it_Enemy.End(); it_Enemy.Next()) {
 				auto& enemy = (*it_Enemy);
 
-				if (
-					enemy.FrameCount > 60 &&
-					(enemy.Position.x < 0.0f || enemy.Position.x > MapMetadata_.Width * 2.0f ||
-					enemy.Position.y < 0.0f || enemy.Position.y > MapMetadata_.Height * 2.0f)
-				) {
-					EnemyManager_->List_.Delete(it_Enemy);
+				if (enemy.FrameCount > 60 && IsOutsideWindow(enemy.Position)) {
+					EnemyManager_->Delete(it_Enemy);
 				}
 
 				if (enemy.ElementType == ELEMENT::EARTH && enemy.FrameCount % 128 == 127) {
@@ -1920,38 +2034,28 @@ namespace Game {
 				}
 			}
 
-			EnemyBulletManager_->Update(directList_);
+			EnemyBulletManager_->Update(directList_, Camera_->VisibleRect_, RenderOrigin_);
 
 			decltype(EnemyBulletManager_->List_)::Iterator it{ EnemyBulletManager_->List_ };
 			for (it.Begin(); !it.End(); it.Next()) {
 				auto& bullet = (*it);
-				auto pos = MapPos(bullet.Position);
-				if (MapBlockType(GetMapBlock(MapPos(bullet.Position), Map_)) != 0) {
-					Bullet::OnHitBlock(bullet, Map_[pos.y][pos.x]);
+				int* const block{ World_->Find(MapPos(bullet.Position)) };
+				if (block != nullptr && MapBlockType(*block) != 0) {
+					Bullet::OnHitBlock(bullet, *block);
 				}
-				else if (
-					bullet.Position.x < 0.0f || bullet.Position.x > MapMetadata_.Width * 2.0f ||
-					bullet.Position.y < 0.0f || bullet.Position.y > MapMetadata_.Height * 2.0f
-				) {
+				else if (IsOutsideWindow(bullet.Position)) {
 					EnemyBulletManager_->List_.Delete(it);
 				}
 			}
 		}
 
 		void UpdateCamera(Lumina::DX12::CommandList const& directList_) {
-			static Bounds const bounds = {
-				.Left = 20.0f,
-				.Right = 234.0f,
-				.Top = 115.0f,
-				.Bottom = 10.0f,
-			};
+			// The world has no edges to hold the camera back.
 			auto const& playerPos{ Player_->Position };
 			float dx{ playerPos.x - Camera_->Translate_.x };
 			float dy{ playerPos.y - Camera_->Translate_.y };
 			Camera_->Translate_.x += dx * 0.0625f;
 			Camera_->Translate_.y += dy * 0.0625f;
-			Camera_->Translate_.x = std::clamp(Camera_->Translate_.x, bounds.Left, bounds.Right);
-			Camera_->Translate_.y = std::clamp(Camera_->Translate_.y, bounds.Bottom, bounds.Top);
 
 			/*ImGui::Begin("Camera");
 			ImGui::DragFloat3("Rotate##Camera", Camera_->Rotate_(), 0.01f);
@@ -1965,7 +2069,7 @@ namespace Game {
 				Camera_->Translate_
 			);
 			Camera_->View_ = Camera_->SRT_.Inv();
-			Camera_->Update(directList_);
+			Camera_->Update(directList_, RenderOrigin_);
 		}
 
 		void CheckCollision() {
@@ -1978,7 +2082,7 @@ namespace Game {
 				float dy = Player_->Position.y - enemy.Position.y;
 				float d = Player_->Scale.x + enemy.Scale.x;
 				if (dx * dx + dy * dy <= d * d) {
-					EnemyManager_->List_.Delete(it_Enemy);
+					EnemyManager_->Delete(it_Enemy);
 				}
 			}
 
@@ -1996,20 +2100,54 @@ namespace Game {
 			}
 
 			// Player bullets vs. enemies
-			
+			// Enemies are kept in a dynamic AABB tree, so that a bullet only visits the ones whose bounds it touches.
+
+			// The per-slot arrays are scratch for this function only, so the scope hands them back on return.
+			auto& arena{ Lumina::FrameArena::Local() };
+			Lumina::FrameArena::Scope const scope{ arena };
+			Enemy const** const targets{ arena.Allocate<Enemy const*>(EnemyManager::MaxNum_) };
+			uint8_t* const isHit{ arena.Allocate<uint8_t>(EnemyManager::MaxNum_) };
+			std::fill_n(isHit, EnemyManager::MaxNum_, uint8_t{ 0U });
+			for (it_Enemy.Begin(); !it_Enemy.End(); it_Enemy.Next()) {
+				targets[it_Enemy.Index()] = &*it_Enemy;
+			}
+
+			auto& enemies{ *EnemyManager_ };
 			decltype(PlayerBulletManager_->List_)::Iterator it_PlayerBullet{ PlayerBulletManager_->List_ };
 			for (it_PlayerBullet.Begin(); !it_PlayerBullet.End(); it_PlayerBullet.Next()) {
 				auto& bullet = *it_PlayerBullet;
-				for (it_Enemy.Begin(); !it_Enemy.End(); it_Enemy.Next()) {
-					auto& enemy = *it_Enemy;
-					float dx = bullet.Position.x - enemy.Position.x;
-					float dy = bullet.Position.y - enemy.Position.y;
-					float d = bullet.Scale.x + enemy.Scale.x;
-					if (dx * dx + dy * dy <= d * d) {
-						PlayerBulletManager_->List_.Delete(it_PlayerBullet);
-						EnemyManager_->List_.Delete(it_Enemy);
-						break;
+
+				// A bullet takes out the nearest enemy it touches that no other bullet has hit yet.
+				uint32_t slot_Hit{ Lumina::AABBTree<2U>::Invalid };
+				float dist2_Hit{ std::numeric_limits<float>::max() };
+				float const radius_Bullet{ bullet.Scale.x };
+				enemies.Targets_.Query(
+					{
+						{ bullet.Position.x - radius_Bullet, bullet.Position.y - radius_Bullet },
+						{ bullet.Position.x + radius_Bullet, bullet.Position.y + radius_Bullet },
+					},
+					[&] (uint32_t proxy_) {
+						uint32_t const slot{ enemies.Targets_.UserData(proxy_) };
+						Enemy const& enemy{ *targets[slot] };
+						float dx = bullet.Position.x - enemy.Position.x;
+						float dy = bullet.Position.y - enemy.Position.y;
+						float dist2 = dx * dx + dy * dy;
+						float d = radius_Bullet + enemy.Scale.x;
+						if (dist2 <= d * d && dist2 < dist2_Hit && !isHit[slot]) {
+							slot_Hit = slot;
+							dist2_Hit = dist2;
+						}
 					}
+				);
+				if (slot_Hit != Lumina::AABBTree<2U>::Invalid) {
+					PlayerBulletManager_->List_.Delete(it_PlayerBullet);
+					isHit[slot_Hit] = 1U;
+				}
+			}
+
+			for (it_Enemy.Begin(); !it_Enemy.End(); it_Enemy.Next()) {
+				if (isHit[it_Enemy.Index()]) {
+					EnemyManager_->Delete(it_Enemy);
 				}
 			}
 		}
@@ -2019,12 +2157,15 @@ namespace Game {
 			Lumina::WinApp::Context const& winAppContext_,
 			Lumina::DX12::CommandList const& directList_
 		) {
+			Lumina::Utils::Debug::AllocationTracker::TagScope const tagScope{ Lumina::Utils::Debug::ALLOCATION_TAG::GAME };
+
 			UpdateMap(directList_);
 			UpdatePlayer(winAppContext_, directList_);
+			// The camera only follows the player; updating it first lets the managers cull against this frame's view.
+			UpdateCamera(directList_);
 			UpdatePlayerBullets(directList_);
 			UpdateEnemies(directList_);
 			CheckCollision();
-			UpdateCamera(directList_);
 			UIManager_->Update(directList_, *Player_);
 		}
 
@@ -2045,7 +2186,12 @@ namespace Game {
 		);
 
 	private:
-		std::vector<std::vector<int>> Map_;
+		std::unique_ptr<ChunkedWorld> World_{ nullptr };
+		// Lower left chunk of the window.
+		Lumina::Int2 WindowOrigin_{};
+		Lumina::Vec3 RenderOrigin_{};
+		// Blocks player bullets hit, for the next UpdateMap to check.
+		std::vector<Lumina::Int2> Tiles_Hit_{};
 		MapMetadata MapMetadata_{};
 
 		Lumina::DX12::DefaultBuffer Buffer_MapData_{};
@@ -2093,56 +2239,91 @@ namespace Game {
 	private:
 		Lumina::Bitset<256U> Keyboard_Current_{};
 		Lumina::Bitset<256U> Keyboard_Previous_{};
+
+		#if defined(_DEBUG)
+		size_t FrameArenaHighWater_{ 0LLU };
+		#endif
 	};
 
 	void Scene_InGame::InitializeMap(
 		Lumina::DX12::Context const& dx12Context_,
 		NLohmannJSON const& config_
 	) {
-		MapMetadata_.Width = 128U;
-		MapMetadata_.Height = 64U;
-
-		std::unique_ptr<CellularAutomata> mapGen{ new CellularAutomata{} };
-		mapGen->Run(MapMetadata_.Width, MapMetadata_.Height);
-		mapGen->GetMap(Map_);
-		for (size_t i_Row{ 0LLU }; i_Row < (Map_.size() >> 1U); ++i_Row) {
-			Map_.at(i_Row).swap(Map_.at((Map_.size() - 1LLU) - i_Row));
-		}
-		auto const& caves{ mapGen->GetCaves() };
-		auto caveID{ Lumina::Random::Generator()() % static_cast<uint32_t>(caves.size()) };
-		auto tileID{ Lumina::Random::Generator()() % static_cast<uint32_t>(caves[caveID].size()) };
-		PlayerInitialTile_ = caves[caveID][tileID];
-		mapGen.reset();
-
-		/*auto& logger{ Lumina::Utils::Debug::Logger::Instance() };
-		for (auto& mapRow : Map_) {
-			for (auto& mapTile : mapRow) {
-				if ((mapTile & ((1 << 20U) - 1)) != 0) {
-					if ((mapTile & ((1 << 20U) - 1)) == 2) {
-						logger.ConsolePrint(".");
-					}
-					else { logger.ConsolePrint("#"); }
-				}
-				else {
-					logger.ConsolePrint(" ");
+		// With a "MapSeed" in the config every launch plays the same world; without one each launch rolls a new one.
+		WorldGenParams const worldGenParams{
+			.Seed{ config_.contains("MapSeed") ? config_.at("MapSeed").get<uint64_t>() : Lumina::Random::Generator()() },
+		};
+		World_.reset(new ChunkedWorld{ worldGenParams, StreamingParams });
+		World_->Prefetch({ 0, 0 }, StreamingParams.Radius_Stream);
+		int32_t const radius{ static_cast<int32_t>(StreamingParams.Radius_Stream) };
+		MoveWindow({ -radius, -radius });
+
+		// The player starts on the floor nearest the origin that belongs to a cave of at least MinSize_Cave tiles
+		// within the prefetched chunks, so never in a pocket sealed off around it; in the unlikely case that there
+		// is none, in a room of 5 x 5 tiles dug out around the origin.
+		int32_t const side{ (2 * radius + 1) * ChunkedWorld::ChunkSize };
+		int32_t const tile_Min{ -radius * ChunkedWorld::ChunkSize };
+		Lumina::ConnectedComponents caves{};
+		caves.Label(
+			static_cast<uint32_t>(side), static_cast<uint32_t>(side),
+			[this, tile_Min] (uint32_t x_, uint32_t y_) {
+				return MapBlockType((*World_)({ tile_Min + static_cast<int32_t>(x_), tile_Min + static_cast<int32_t>(y_) })) == 0;
+			}
+		);
+		auto const isInCave{
+			[&caves, &worldGenParams, tile_Min] (int32_t x_, int32_t y_) {
+				uint32_t const label{ caves(static_cast<uint32_t>(x_ - tile_Min), static_cast<uint32_t>(y_ - tile_Min)) };
+				return label != Lumina::ConnectedComponents::Background && caves[label].Area >= worldGenParams.MinSize_Cave;
+			}
+		};
+
+		PlayerInitialTile_ = { 0, 0 };
+		bool isFound{ false };
+		for (int32_t r{ 0 }; r < ChunkedWorld::ChunkSize * radius && !isFound; ++r) {
+			for (int32_t y{ -r }; y <= r && !isFound; ++y) {
+				for (int32_t x{ -r }; x <= r && !isFound; ++x) {
+					bool const isOnRing{ x == -r || x == r || y == -r || y == r };
+					if (!isOnRing || !isInCave(x, y)) { continue; }
+					PlayerInitialTile_ = { x, y };
+					isFound = true;
 				}
 			}
-			logger.ConsolePrint("\n");
-		}*/
+		}
+		if (!isFound) {
+			for (int32_t y{ -2 }; y <= 2; ++y) {
+				for (int32_t x{ -2 }; x <= 2; ++x) { *World_->Find({ x, y }) = 0; }
+			}
+			// The rock under the room now has floor above it.
+			for (int32_t x{ -2 }; x <= 2; ++x) {
+				int& tile{ *World_->Find({ x, -3 }) };
+				if (tile == 1) { tile = 2; }
+			}
+		}
 
 		auto const& device{ dx12Context_.Device() };
 		auto& cmdQueue{ dx12Context_.DirectQueue() };
 
-		Buffer_MapData_.Initialize(device, sizeof(int) * MapMetadata_.Width * MapMetadata_.Height, "MapData");
+		MapMetadata_ = {
+			.Width{ Size_Window },
+			.Height{ Size_Window },
+			.Offset{
+				-static_cast<float>(Size_Window * ChunkedWorld::ChunkSize / 2U) * MapBlockWidth,
+				-static_cast<float>(Size_Window * ChunkedWorld::ChunkSize / 2U) * MapBlockHeight,
+			},
+		};
+		Buffer_MapData_.Initialize(device, sizeof(ChunkedWorld::Chunk) * Num_WindowChunks, "MapData");
 		Buffer_MapMetadata_.Initialize(device, (sizeof(MapMetadata) + 0xFF) & ~0xFF, "MapMetadata");
 
 		UB_MapData_.Initialize(device, Buffer_MapData_.SizeInBytes());
-		for (size_t i_Row{ 0LLU }; i_Row < Map_.size(); ++i_Row) {
-			auto const& mapRow{ Map_.at(i_Row) };
+		for (uint32_t idx_Slot{ 0U }; idx_Slot < Num_WindowChunks; ++idx_Slot) {
+			Lumina::Int2 const chunk{
+				WindowOrigin_.x + static_cast<int32_t>(idx_Slot % Size_Window),
+				WindowOrigin_.y + static_cast<int32_t>(idx_Slot / Size_Window),
+			};
 			UB_MapData_.Store(
-				mapRow.data(),
-				sizeof(int) * mapRow.size(),
-				sizeof(int) * mapRow.size() * i_Row
+				World_->GetChunk(World_->FindChunk(chunk)).data(),
+				sizeof(ChunkedWorld::Chunk),
+				sizeof(ChunkedWorld::Chunk) * idx_Slot
 			);
 		}
 		Lumina::DX12::UploadBuffer uploadBuf_MapMetadata{};
@@ -2156,7 +2337,7 @@ namespace Game {
 		cmdList->CopyResource(Buffer_MapData_.Get(), UB_MapData_.Get());
 		cmdList->CopyResource(Buffer_MapMetadata_.Get(), uploadBuf_MapMetadata.Get());
 
-		UAB_Indices_Active_.Initialize(device, sizeof(uint32_t) * MapMetadata_.Width * MapMetadata_.Height);
+		UAB_Indices_Active_.Initialize(device, sizeof(uint32_t) * Num_WindowTiles);
 		UAB_ActiveCounter_.Initialize(device, sizeof(uint32_t) * 1LLU);
 		UB_ActiveCounterReset_.Initialize(device, sizeof(uint32_t) * 1LLU);
 		uint32_t const counterResetVal{ 0U };
@@ -2294,7 +2475,7 @@ namespace Game {
 		Player_->Initialize(dx12Context_, config);
 		Player_->Position = {
 			PlayerInitialTile_.x * 2.0f,
-			((MapMetadata_.Height - 1U) - PlayerInitialTile_.y) * 2.0f,
+			PlayerInitialTile_.y * 2.0f,
 			0.0f
 		};
 		Player_->Mesh = &Mesh_Cube_;
@@ -2319,6 +2500,8 @@ namespace Game {
 		[[maybe_unused]] Lumina::DX12::Context const& dx12Context_,
 		Lumina::DX12::CommandList const& directList_
 	) {
+		Lumina::Utils::Debug::AllocationTracker::TagScope const tagScope{ Lumina::Utils::Debug::ALLOCATION_TAG::GAME };
+
 		static D3D12_RESOURCE_BARRIER const barriers[]{
 			 {
 				 .Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION,
@@ -2375,7 +2558,7 @@ namespace Game {
 		ComputeList_->ResourceBarrier(1U, barriers + 0U);
 		ComputeList_->CopyResource(UAB_ActiveCounter_.Get(), UB_ActiveCounterReset_.Get());
 		ComputeList_->ResourceBarrier(1U, barriers + 1U);
-		ComputeList_->Dispatch((MapMetadata_.Width * MapMetadata_.Height) >> 8U, 1U, 1U);
+		ComputeList_->Dispatch(Num_WindowTiles >> 8U, 1U, 1U);
 		ComputeList_->ResourceBarrier(2U, barriers + 2U);
 		ComputeList_->CopyResource(RBB_ActiveCounter_.Get(), UAB_ActiveCounter_.Get());
 
@@ -2418,5 +2601,18 @@ namespace Game {
 		EnemyManager_->Render(directList_, Camera_->CSUTable_, CSUTable_.GPUHandle(4U));
 		EnemyBulletManager_->Render(directList_, Camera_->CSUTable_, CSUTable_.GPUHandle(7U));
 		UIManager_->Render(directList_);
+
+		#if defined(_DEBUG)
+		auto const& arena{ Lumina::FrameArena::Local() };
+		if (arena.HighWater() > FrameArenaHighWater_) {
+			FrameArenaHighWater_ = arena.HighWater();
+			Lumina::Utils::Debug::Logger::Default().Message<0U>(
+				"<Game.Scene_InGame> Frame arena high-water mark: {} bytes in {} block(s).\n",
+				FrameArenaHighWater_,
+				arena.Num_Blocks()
+			);
+		}
+		#endif
+		Lumina::FrameArena::EndFrame();
 	}
 }
\ No newline at end of file
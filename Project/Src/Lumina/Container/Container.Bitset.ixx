@@ -1,91 +1,358 @@
+module;
+
+#include<immintrin.h>
+
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+
 export module Lumina.Container.Bitset;
 
 //****	******	******	******	******	****//
 
-import <memory>;
+import <cstdint>;
 import <cassert>;
 
+import <bit>;
+
 //////	//////	//////	//////	//////	//////
 
+// Fixed-size bitset stored inline as 64-bit words; bit i lives in Words_[i / 64] at i % 64,
+// which is the same memory layout as the byte array of the earlier implementation.
+// Bits past N in the last word are kept zero, so whole-word operations never need masking on read.
+// From AVX2_MinWords words up, bulk operations run 256 bits at a time.
+
 namespace Lumina {
 	export template<uint32_t N>
 	class Bitset {
+		static_assert(N > 0U);
+
+	public:
+		static constexpr uint32_t Num_Words{ (N + 63U) >> 6U };
+		// Returned by FindFirst/FindNext when no set bit remains.
+		static constexpr uint32_t NPos{ N };
+
+	private:
+		static constexpr uint32_t AVX2_MinWords{ 16U };
+		static constexpr uint64_t LastWordMask{ (N & 63U) ? ((1LLU << (N & 63U)) - 1LLU) : ~0LLU };
+
 	public:
 		constexpr bool operator[](uint32_t pos_) const;
-		constexpr const uint8_t* operator()() const noexcept;
+		constexpr uint64_t const* operator()() const noexcept;
+
+		bool operator==(Bitset<N> const& rhs_) const noexcept;
+
+		Bitset<N> operator&(Bitset<N> const& rhs_) const noexcept;
+		Bitset<N> operator|(Bitset<N> const& rhs_) const noexcept;
+		Bitset<N> operator^(Bitset<N> const& rhs_) const noexcept;
+		// this & ~rhs_
+		Bitset<N> AndNot(Bitset<N> const& rhs_) const noexcept;
+
+		Bitset<N>& operator&=(Bitset<N> const& rhs_) noexcept;
+		Bitset<N>& operator|=(Bitset<N> const& rhs_) noexcept;
+		Bitset<N>& operator^=(Bitset<N> const& rhs_) noexcept;
+
+		// Bits that are set in current_ but not in previous_ (e.g. keys pressed this frame), as (current ^ previous) & current.
+		static Bitset<N> RisingEdges(Bitset<N> const& current_, Bitset<N> const& previous_) noexcept;
+		// Bits that are set in previous_ but not in current_ (e.g. keys released this frame).
+		static Bitset<N> FallingEdges(Bitset<N> const& current_, Bitset<N> const& previous_) noexcept;
 
 	public:
 		constexpr Bitset<N>& Set(uint32_t pos_, bool val_ = true);
-		constexpr Bitset<N>& Set(const Bitset<N>& bitset_);
-		Bitset<N>& SetAllZero() {
-			std::memset(Data_, 0, sizeof(uint8_t) * DataLength());
-			return (*this);
-		}
+		constexpr Bitset<N>& Set(Bitset<N> const& bitset_);
+		constexpr Bitset<N>& Flip(uint32_t pos_);
+		// Sets or clears [first_, last_).
+		constexpr Bitset<N>& SetRange(uint32_t first_, uint32_t last_, bool val_ = true);
+		Bitset<N>& SetAllZero() noexcept;
+		Bitset<N>& SetAllOne() noexcept;
 
-	private:
-		constexpr uint32_t DataLength() const noexcept;
+	public:
+		uint32_t Count() const noexcept;
+		constexpr bool Any() const noexcept;
+		constexpr bool None() const noexcept { return !Any(); }
+
+		constexpr uint32_t FindFirst() const noexcept;
+		// First set bit after pos_.
+		constexpr uint32_t FindNext(uint32_t pos_) const noexcept;
+		// Calls func_(pos) for every set bit in ascending order.
+		template<typename T_Func>
+		constexpr void ForEachSet(T_Func&& func_) const;
 
+	private:
 		constexpr uint32_t Index(uint32_t pos_) const noexcept;
-		constexpr uint32_t Target(uint32_t pos_) const noexcept;
+		constexpr uint64_t Target(uint32_t pos_) const noexcept;
+
+		constexpr uint32_t FindFrom(uint32_t idx_Word_, uint64_t word_) const noexcept;
+
+		template<typename T_WordOp, typename T_VectorOp>
+		static void Combine(uint64_t* dst_, uint64_t const* lhs_, uint64_t const* rhs_, T_WordOp&& wordOp_, T_VectorOp&& vectorOp_) noexcept;
 
 	public:
-		Bitset();
-		~Bitset() noexcept;
+		constexpr Bitset() noexcept = default;
 
 	private:
-		uint8_t* Data_{ nullptr };
+		alignas(32) uint64_t Words_[Num_Words]{};
 	};
 
+	//----	------	------	------	------	----//
+
 	template<uint32_t N>
 	constexpr bool Bitset<N>::operator[](uint32_t pos_) const {
-		return (Data_[Index(pos_)] & Target(pos_));
+		assert(pos_ < N);
+		return (Words_[Index(pos_)] & Target(pos_)) != 0LLU;
+	}
+
+	template<uint32_t N>
+	constexpr uint64_t const* Bitset<N>::operator()() const noexcept {
+		return Words_;
+	}
+
+	template<uint32_t N>
+	bool Bitset<N>::operator==(Bitset<N> const& rhs_) const noexcept {
+		uint64_t diff{ 0LLU };
+		for (uint32_t i{ 0U }; i < Num_Words; ++i) {
+			diff |= Words_[i] ^ rhs_.Words_[i];
+		}
+		return (diff == 0LLU);
+	}
+
+	//----	------	------	------	------	----//
+
+	template<uint32_t N>
+	template<typename T_WordOp, typename T_VectorOp>
+	void Bitset<N>::Combine(
+		uint64_t* dst_,
+		uint64_t const* lhs_,
+		uint64_t const* rhs_,
+		T_WordOp&& wordOp_,
+		T_VectorOp&& vectorOp_
+	) noexcept {
+		uint32_t i{ 0U };
+		if constexpr (Num_Words >= AVX2_MinWords) {
+			for (; i + 4U <= Num_Words; i += 4U) {
+				__m256i const lhs{ _mm256_load_si256(reinterpret_cast<__m256i const*>(lhs_ + i)) };
+				__m256i const rhs{ _mm256_load_si256(reinterpret_cast<__m256i const*>(rhs_ + i)) };
+				_mm256_store_si256(reinterpret_cast<__m256i*>(dst_ + i), vectorOp_(lhs, rhs));
+			}
+		}
+		for (; i < Num_Words; ++i) {
+			dst_[i] = wordOp_(lhs_[i], rhs_[i]);
+		}
+	}
+
+	template<uint32_t N>
+	Bitset<N> Bitset<N>::operator&(Bitset<N> const& rhs_) const noexcept {
+		Bitset<N> result{};
+		Combine(
+			result.Words_, Words_, rhs_.Words_,
+			[] (uint64_t lhs_, uint64_t rhs_) { return lhs_ & rhs_; },
+			[] (__m256i lhs_, __m256i rhs_) { return _mm256_and_si256(lhs_, rhs_); }
+		);
+		return result;
+	}
+
+	template<uint32_t N>
+	Bitset<N> Bitset<N>::operator|(Bitset<N> const& rhs_) const noexcept {
+		Bitset<N> result{};
+		Combine(
+			result.Words_, Words_, rhs_.Words_,
+			[] (uint64_t lhs_, uint64_t rhs_) { return lhs_ | rhs_; },
+			[] (__m256i lhs_, __m256i rhs_) { return _mm256_or_si256(lhs_, rhs_); }
+		);
+		return result;
+	}
+
+	template<uint32_t N>
+	Bitset<N> Bitset<N>::operator^(Bitset<N> const& rhs_) const noexcept {
+		Bitset<N> result{};
+		Combine(
+			result.Words_, Words_, rhs_.Words_,
+			[] (uint64_t lhs_, uint64_t rhs_) { return lhs_ ^ rhs_; },
+			[] (__m256i lhs_, __m256i rhs_) { return _mm256_xor_si256(lhs_, rhs_); }
+		);
+		return result;
+	}
+
+	template<uint32_t N>
+	Bitset<N> Bitset<N>::AndNot(Bitset<N> const& rhs_) const noexcept {
+		Bitset<N> result{};
+		Combine(
+			result.Words_, Words_, rhs_.Words_,
+			[] (uint64_t lhs_, uint64_t rhs_) { return lhs_ & ~rhs_; },
+			// _mm256_andnot_si256 negates its first operand.
+			[] (__m256i lhs_, __m256i rhs_) { return _mm256_andnot_si256(rhs_, lhs_); }
+		);
+		return result;
 	}
 
 	template<uint32_t N>
-	constexpr const uint8_t* Bitset<N>::operator()() const noexcept {
-		return Data_;
+	Bitset<N>& Bitset<N>::operator&=(Bitset<N> const& rhs_) noexcept {
+		return (*this = (*this & rhs_));
 	}
 
+	template<uint32_t N>
+	Bitset<N>& Bitset<N>::operator|=(Bitset<N> const& rhs_) noexcept {
+		return (*this = (*this | rhs_));
+	}
+
+	template<uint32_t N>
+	Bitset<N>& Bitset<N>::operator^=(Bitset<N> const& rhs_) noexcept {
+		return (*this = (*this ^ rhs_));
+	}
+
+	template<uint32_t N>
+	Bitset<N> Bitset<N>::RisingEdges(Bitset<N> const& current_, Bitset<N> const& previous_) noexcept {
+		Bitset<N> result{};
+		Combine(
+			result.Words_, current_.Words_, previous_.Words_,
+			[] (uint64_t cur_, uint64_t prev_) { return (cur_ ^ prev_) & cur_; },
+			[] (__m256i cur_, __m256i prev_) { return _mm256_and_si256(_mm256_xor_si256(cur_, prev_), cur_); }
+		);
+		return result;
+	}
+
+	template<uint32_t N>
+	Bitset<N> Bitset<N>::FallingEdges(Bitset<N> const& current_, Bitset<N> const& previous_) noexcept {
+		return RisingEdges(previous_, current_);
+	}
+
+	//----	------	------	------	------	----//
+
 	template<uint32_t N>
 	constexpr Bitset<N>& Bitset<N>::Set(uint32_t pos_, bool val_) {
-		auto idx{ Index(pos_) };
-		auto target{ Target(pos_) };
-		Data_[idx] &= (0xFFU - target);
-		Data_[idx] |= val_ * target;
+		assert(pos_ < N);
+		auto& word{ Words_[Index(pos_)] };
+		word = (word & ~Target(pos_)) | (static_cast<uint64_t>(val_) << (pos_ & 63U));
+		return *this;
+	}
 
+	template<uint32_t N>
+	constexpr Bitset<N>& Bitset<N>::Set(Bitset<N> const& bitset_) {
+		*this = bitset_;
 		return *this;
 	}
 
 	template<uint32_t N>
-	constexpr Bitset<N>& Bitset<N>::Set(const Bitset<N>& bitset_) {
-		std::memcpy(Data_, bitset_.Data_, sizeof(uint8_t) * DataLength());
+	constexpr Bitset<N>& Bitset<N>::Flip(uint32_t pos_) {
+		assert(pos_ < N);
+		Words_[Index(pos_)] ^= Target(pos_);
 		return *this;
 	}
 
 	template<uint32_t N>
-	constexpr uint32_t Bitset<N>::DataLength() const noexcept { return (N + 0x07U) >> 3U; }
+	constexpr Bitset<N>& Bitset<N>::SetRange(uint32_t first_, uint32_t last_, bool val_) {
+		assert(first_ <= last_ && last_ <= N);
+		if (first_ == last_) { return *this; }
+
+		uint32_t const idx_First{ Index(first_) };
+		uint32_t const idx_Last{ Index(last_ - 1U) };
+		uint64_t const mask_First{ ~0LLU << (first_ & 63U) };
+		uint64_t const mask_Last{ ~0LLU >> (63U - ((last_ - 1U) & 63U)) };
+		uint64_t const fill{ val_ ? ~0LLU : 0LLU };
+
+		if (idx_First == idx_Last) {
+			uint64_t const mask{ mask_First & mask_Last };
+			Words_[idx_First] = (Words_[idx_First] & ~mask) | (fill & mask);
+			return *this;
+		}
+		Words_[idx_First] = (Words_[idx_First] & ~mask_First) | (fill & mask_First);
+		for (uint32_t i{ idx_First + 1U }; i < idx_Last; ++i) {
+			Words_[i] = fill;
+		}
+		Words_[idx_Last] = (Words_[idx_Last] & ~mask_Last) | (fill & mask_Last);
+		return *this;
+	}
 
 	template<uint32_t N>
-	constexpr uint32_t Bitset<N>::Index(uint32_t pos_) const noexcept { return pos_ >> 3U; }
+	Bitset<N>& Bitset<N>::SetAllZero() noexcept {
+		for (auto& word : Words_) { word = 0LLU; }
+		return *this;
+	}
 
 	template<uint32_t N>
-	constexpr uint32_t Bitset<N>::Target(uint32_t pos_) const noexcept { return 1U << (pos_ & 0x07U); }
+	Bitset<N>& Bitset<N>::SetAllOne() noexcept {
+		for (auto& word : Words_) { word = ~0LLU; }
+		Words_[Num_Words - 1U] &= LastWordMask;
+		return *this;
+	}
+
+	//----	------	------	------	------	----//
 
 	template<uint32_t N>
-	Bitset<N>::Bitset() {
-		static_assert(N > 0U);
+	uint32_t Bitset<N>::Count() const noexcept {
+		uint32_t i{ 0U };
+		uint64_t cnt{ 0LLU };
+		if constexpr (Num_Words >= AVX2_MinWords) {
+			// Mula's nibble lookup: pshufb counts each nibble, sad_epu8 sums the bytes into 64-bit lanes.
+			__m256i const lut{
+				_mm256_setr_epi8(
+					0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+					0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+				)
+			};
+			__m256i const mask_Low{ _mm256_set1_epi8(0x0F) };
+			__m256i acc{ _mm256_setzero_si256() };
+			for (; i + 4U <= Num_Words; i += 4U) {
+				__m256i const words{ _mm256_load_si256(reinterpret_cast<__m256i const*>(Words_ + i)) };
+				__m256i const cnt_Low{ _mm256_shuffle_epi8(lut, _mm256_and_si256(words, mask_Low)) };
+				__m256i const cnt_High{ _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(words, 4), mask_Low)) };
+				acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_add_epi8(cnt_Low, cnt_High), _mm256_setzero_si256()));
+			}
+			cnt += static_cast<uint64_t>(_mm256_extract_epi64(acc, 0)) + static_cast<uint64_t>(_mm256_extract_epi64(acc, 1));
+			cnt += static_cast<uint64_t>(_mm256_extract_epi64(acc, 2)) + static_cast<uint64_t>(_mm256_extract_epi64(acc, 3));
+		}
+		for (; i < Num_Words; ++i) {
+			cnt += static_cast<uint64_t>(std::popcount(Words_[i]));
+		}
+		return static_cast<uint32_t>(cnt);
+	}
+
+	template<uint32_t N>
+	constexpr bool Bitset<N>::Any() const noexcept {
+		uint64_t any{ 0LLU };
+		for (auto const word : Words_) { any |= word; }
+		return (any != 0LLU);
+	}
+
+	template<uint32_t N>
+	constexpr uint32_t Bitset<N>::FindFrom(uint32_t idx_Word_, uint64_t word_) const noexcept {
+		for (;;) {
+			if (word_ != 0LLU) {
+				return (idx_Word_ << 6U) + static_cast<uint32_t>(std::countr_zero(word_));
+			}
+			if (++idx_Word_ >= Num_Words) { return NPos; }
+			word_ = Words_[idx_Word_];
+		}
+	}
+
+	template<uint32_t N>
+	constexpr uint32_t Bitset<N>::FindFirst() const noexcept {
+		return FindFrom(0U, Words_[0]);
+	}
 
-		assert(Data_ == nullptr);
-		Data_ = new uint8_t[DataLength()];
-		assert(Data_ != nullptr);
-		std::memset(Data_, 0, sizeof(uint8_t) * DataLength());
+	template<uint32_t N>
+	constexpr uint32_t Bitset<N>::FindNext(uint32_t pos_) const noexcept {
+		if (pos_ + 1U >= N) { return NPos; }
+		uint32_t const pos{ pos_ + 1U };
+		return FindFrom(Index(pos), Words_[Index(pos)] & (~0LLU << (pos & 63U)));
 	}
 
 	template<uint32_t N>
-	Bitset<N>::~Bitset() noexcept {
-		if (Data_ != nullptr) {
-			delete[] Data_;
-			Data_ = nullptr;
+	template<typename T_Func>
+	constexpr void Bitset<N>::ForEachSet(T_Func&& func_) const {
+		for (uint32_t idx_Word{ 0U }; idx_Word < Num_Words; ++idx_Word) {
+			// Clears the lowest set bit each step, so the cost follows the number of set bits.
+			for (uint64_t word{ Words_[idx_Word] }; word != 0LLU; word &= word - 1LLU) {
+				func_((idx_Word << 6U) + static_cast<uint32_t>(std::countr_zero(word)));
+			}
 		}
 	}
+
+	//----	------	------	------	------	----//
+
+	template<uint32_t N>
+	constexpr uint32_t Bitset<N>::Index(uint32_t pos_) const noexcept { return pos_ >> 6U; }
+
+	template<uint32_t N>
+	constexpr uint64_t Bitset<N>::Target(uint32_t pos_) const noexcept { return 1LLU << (pos_ & 63U); }
 }
\ No newline at end of file
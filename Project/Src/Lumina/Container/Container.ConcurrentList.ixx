@@ -0,0 +1,229 @@
+export module Lumina.Container.ConcurrentList;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cassert>;
+
+import <atomic>;
+import <memory>;
+
+//////	//////	//////	//////	//////	//////
+
+// Fixed-capacity pool like List, for spawning and deleting from several threads at once during an update.
+//
+//	- Free slots form a lock-free stack threaded through Next_. The head packs a 32-bit tag above the index,
+//	  and every successful CAS bumps the tag, so a head that was popped and pushed back in between (ABA) fails the CAS.
+//	- Each thread spawns through its own Spawner, which takes slots from the stack in runs of CacheSize
+//	  and hands them out without touching shared state.
+//	- Delete only marks the slot and pushes it onto a retired stack. Deleted elements stay readable,
+//	  and are still visited by ForEach, until Tick() returns them to the free stack.
+//
+// Tick() is the barrier: call it once per frame after the parallel part of the update has joined,
+// so that no thread still holds a pointer to an element being recycled.
+
+namespace Lumina {
+	export template<typename T>
+	class ConcurrentList {
+	public:
+		static constexpr uint32_t Invalid{ 0xFFFFFFFFU };
+		static constexpr uint32_t CacheSize{ 32U };
+
+	private:
+		enum class STATE : uint8_t {
+			FREE,
+			ACTIVE,
+			RETIRED,
+		};
+
+		static constexpr uint64_t Pack(uint32_t tag_, uint32_t idx_) noexcept { return (static_cast<uint64_t>(tag_) << 32U) | idx_; }
+		static constexpr uint32_t Tag(uint64_t head_) noexcept { return static_cast<uint32_t>(head_ >> 32U); }
+		static constexpr uint32_t Index(uint64_t head_) noexcept { return static_cast<uint32_t>(head_); }
+
+		//----	------	------	------	------	----//
+
+	public:
+		// Per-thread front end; not shareable between threads.
+		class Spawner {
+		public:
+			// Returns nullptr when no free slot is left, instead of asserting like List::NewElement.
+			[[nodiscard]] T* NewElement();
+
+		public:
+			explicit Spawner(ConcurrentList<T>& list_) : List_{ &list_ } {}
+			// Returns the unused cached slots to the list.
+			~Spawner() noexcept;
+
+			Spawner(Spawner const&) = delete;
+			Spawner& operator=(Spawner const&) = delete;
+
+		private:
+			ConcurrentList<T>* List_{ nullptr };
+			uint32_t Cache_[CacheSize]{};
+			uint32_t Num_Cached_{ 0U };
+		};
+
+		//----	------	------	------	------	----//
+
+	public:
+		// Safe from any thread; deleting the same element twice before Tick() is a no-op.
+		void Delete(T const& element_);
+		void Delete(uint32_t idx_);
+
+		// Recycles the slots deleted since the last call. Returns how many.
+		uint32_t Tick();
+
+		// Visits (element, index) for every active slot, including ones deleted since the last Tick(). Not thread-safe against Tick().
+		template<typename T_Func>
+		void ForEach(T_Func&& func_);
+
+	public:
+		uint32_t Capacity() const noexcept { return Capacity_; }
+		// Spawned minus recycled; deleted elements count until Tick().
+		uint32_t Size() const noexcept { return Num_Active_.load(std::memory_order_relaxed); }
+		uint32_t IndexOf(T const& element_) const noexcept { return static_cast<uint32_t>(&element_ - Elements_.get()); }
+		T& operator[](uint32_t idx_) noexcept { return Elements_[idx_]; }
+
+	private:
+		// Pops up to num_ slots with one CAS. Returns how many.
+		uint32_t PopFree(uint32_t* dst_, uint32_t num_) noexcept;
+		// Pushes the chain first_ -> ... -> last_, already linked through Next_, with one CAS.
+		void PushFree(uint32_t first_, uint32_t last_) noexcept;
+
+	public:
+		explicit ConcurrentList(uint32_t capacity_);
+		~ConcurrentList() noexcept = default;
+
+		ConcurrentList(ConcurrentList const&) = delete;
+		ConcurrentList& operator=(ConcurrentList const&) = delete;
+
+		//====	======	======	======	======	====//
+
+	private:
+		alignas(64) std::atomic<uint64_t> FreeHead_{ Pack(0U, Invalid) };
+		// Pushed from many threads and drained only by Tick(), so it cannot suffer ABA and needs no tag.
+		alignas(64) std::atomic<uint32_t> RetiredHead_{ Invalid };
+		alignas(64) std::atomic<uint32_t> Num_Active_{ 0U };
+
+		alignas(64) std::unique_ptr<T[]> Elements_{ nullptr };
+		std::unique_ptr<std::atomic<STATE>[]> States_{ nullptr };
+		std::unique_ptr<std::atomic<uint32_t>[]> Next_{ nullptr };
+		uint32_t Capacity_{ 0U };
+	};
+
+	//----	------	------	------	------	----//
+
+	template<typename T>
+	T* ConcurrentList<T>::Spawner::NewElement() {
+		if (Num_Cached_ == 0U) {
+			Num_Cached_ = List_->PopFree(Cache_, CacheSize);
+			if (Num_Cached_ == 0U) { return nullptr; }
+		}
+		uint32_t const idx{ Cache_[--Num_Cached_] };
+		List_->States_[idx].store(STATE::ACTIVE, std::memory_order_relaxed);
+		List_->Num_Active_.fetch_add(1U, std::memory_order_relaxed);
+		return &List_->Elements_[idx];
+	}
+
+	template<typename T>
+	ConcurrentList<T>::Spawner::~Spawner() noexcept {
+		if (Num_Cached_ == 0U) { return; }
+		for (uint32_t i{ 0U }; i + 1U < Num_Cached_; ++i) {
+			List_->Next_[Cache_[i]].store(Cache_[i + 1U], std::memory_order_relaxed);
+		}
+		List_->PushFree(Cache_[0], Cache_[Num_Cached_ - 1U]);
+		Num_Cached_ = 0U;
+	}
+
+	//----	------	------	------	------	----//
+
+	template<typename T>
+	void ConcurrentList<T>::Delete(T const& element_) {
+		Delete(IndexOf(element_));
+	}
+
+	template<typename T>
+	void ConcurrentList<T>::Delete(uint32_t idx_) {
+		assert(idx_ < Capacity_);
+		STATE expected{ STATE::ACTIVE };
+		if (!States_[idx_].compare_exchange_strong(expected, STATE::RETIRED, std::memory_order_relaxed)) { return; }
+
+		uint32_t head{ RetiredHead_.load(std::memory_order_relaxed) };
+		do {
+			Next_[idx_].store(head, std::memory_order_relaxed);
+		} while (!RetiredHead_.compare_exchange_weak(head, idx_, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	template<typename T>
+	uint32_t ConcurrentList<T>::Tick() {
+		uint32_t const first{ RetiredHead_.exchange(Invalid, std::memory_order_acquire) };
+		if (first == Invalid) { return 0U; }
+
+		// The retired chain is already linked through Next_, so it goes onto the free stack whole.
+		uint32_t num{ 1U };
+		uint32_t last{ first };
+		States_[first].store(STATE::FREE, std::memory_order_relaxed);
+		for (uint32_t idx{ Next_[first].load(std::memory_order_relaxed) }; idx != Invalid; idx = Next_[idx].load(std::memory_order_relaxed)) {
+			States_[idx].store(STATE::FREE, std::memory_order_relaxed);
+			last = idx;
+			++num;
+		}
+		PushFree(first, last);
+		Num_Active_.fetch_sub(num, std::memory_order_relaxed);
+		return num;
+	}
+
+	template<typename T>
+	template<typename T_Func>
+	void ConcurrentList<T>::ForEach(T_Func&& func_) {
+		for (uint32_t i{ 0U }; i < Capacity_; ++i) {
+			if (States_[i].load(std::memory_order_relaxed) != STATE::FREE) { func_(Elements_[i], i); }
+		}
+	}
+
+	//----	------	------	------	------	----//
+
+	template<typename T>
+	uint32_t ConcurrentList<T>::PopFree(uint32_t* dst_, uint32_t num_) noexcept {
+		uint64_t head{ FreeHead_.load(std::memory_order_acquire) };
+		for (;;) {
+			if (Index(head) == Invalid) { return 0U; }
+
+			// The walk may read links that other threads are rewriting; the CAS only succeeds if the head,
+			// and with it the whole stack, is unchanged since it was loaded, in which case the links were intact.
+			uint32_t num{ 0U };
+			uint32_t next{ Index(head) };
+			while (num < num_ && next != Invalid) {
+				dst_[num++] = next;
+				next = Next_[next].load(std::memory_order_relaxed);
+			}
+			if (FreeHead_.compare_exchange_weak(head, Pack(Tag(head) + 1U, next), std::memory_order_acquire, std::memory_order_acquire)) {
+				return num;
+			}
+		}
+	}
+
+	template<typename T>
+	void ConcurrentList<T>::PushFree(uint32_t first_, uint32_t last_) noexcept {
+		uint64_t head{ FreeHead_.load(std::memory_order_relaxed) };
+		do {
+			Next_[last_].store(Index(head), std::memory_order_relaxed);
+		} while (!FreeHead_.compare_exchange_weak(head, Pack(Tag(head) + 1U, first_), std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	//----	------	------	------	------	----//
+
+	template<typename T>
+	ConcurrentList<T>::ConcurrentList(uint32_t capacity_) :
+		Elements_{ std::make_unique<T[]>(capacity_) },
+		States_{ std::make_unique<std::atomic<STATE>[]>(capacity_) },
+		Next_{ std::make_unique<std::atomic<uint32_t>[]>(capacity_) },
+		Capacity_{ capacity_ } {
+		assert(capacity_ > 0U && capacity_ < Invalid);
+		for (uint32_t i{ 0U }; i < Capacity_; ++i) {
+			States_[i].store(STATE::FREE, std::memory_order_relaxed);
+			Next_[i].store((i + 1U < Capacity_) ? (i + 1U) : Invalid, std::memory_order_relaxed);
+		}
+		FreeHead_.store(Pack(0U, 0U), std::memory_order_release);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+export module Lumina.Container.DisjointSet;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cassert>;
+
+import <memory>;
+import <utility>;
+
+//////	//////	//////	//////	//////	//////
+
+// Union-find over the elements 0 .. Capacity() - 1, with union by rank and full path compression.
+//
+// Reset() makes every element a singleton. Resize() only provides the storage, for callers that create elements
+// as they go (connected-component labelling) and would rather not touch memory they may never use:
+// an element must then be made a singleton with MakeSet() before anything else sees it.
+// Elements whose sets are disjoint may be worked on from different threads at once.
+
+namespace Lumina {
+	export class DisjointSet {
+	public:
+		void MakeSet(uint32_t element_) noexcept {
+			assert(element_ < Capacity_);
+			Parents_[element_] = element_;
+			Ranks_[element_] = 0U;
+		}
+
+		uint32_t Find(uint32_t element_) noexcept {
+			assert(element_ < Capacity_);
+			uint32_t root{ element_ };
+			while (Parents_[root] != root) { root = Parents_[root]; }
+			while (Parents_[element_] != root) { element_ = std::exchange(Parents_[element_], root); }
+			return root;
+		}
+
+		// Returns false if both were in the same set already.
+		bool Union(uint32_t element0_, uint32_t element1_) noexcept {
+			uint32_t root0{ Find(element0_) };
+			uint32_t root1{ Find(element1_) };
+			if (root0 == root1) { return false; }
+
+			if (Ranks_[root0] < Ranks_[root1]) { std::swap(root0, root1); }
+			Parents_[root1] = root0;
+			Ranks_[root0] += static_cast<uint8_t>(Ranks_[root0] == Ranks_[root1]);
+			return true;
+		}
+
+		bool IsConnected(uint32_t element0_, uint32_t element1_) noexcept { return Find(element0_) == Find(element1_); }
+
+	public:
+		uint32_t Capacity() const noexcept { return Capacity_; }
+
+		void Reset(uint32_t num_Elements_) {
+			Resize(num_Elements_);
+			for (uint32_t i{ 0U }; i < num_Elements_; ++i) { MakeSet(i); }
+		}
+		// Leaves every element undefined.
+		void Resize(uint32_t capacity_) {
+			if (capacity_ > Allocated_) {
+				Parents_ = std::make_unique_for_overwrite<uint32_t[]>(capacity_);
+				Ranks_ = std::make_unique_for_overwrite<uint8_t[]>(capacity_);
+				Allocated_ = capacity_;
+			}
+			Capacity_ = capacity_;
+		}
+
+	public:
+		explicit DisjointSet(uint32_t num_Elements_ = 0U) { Reset(num_Elements_); }
+
+		//====	======	======	======	======	====//
+
+	private:
+		std::unique_ptr<uint32_t[]> Parents_{};
+		// Bounds the height of each tree; log2 of the element count at most, so a byte is plenty.
+		std::unique_ptr<uint8_t[]> Ranks_{};
+
+		uint32_t Capacity_{ 0U };
+		uint32_t Allocated_{ 0U };
+	};
+}
\ No newline at end of file
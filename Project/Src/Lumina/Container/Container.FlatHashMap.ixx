@@ -0,0 +1,536 @@
+module;
+
+#include<immintrin.h>
+
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+
+export module Lumina.Container.FlatHashMap;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cstddef>;
+import <cassert>;
+
+import <bit>;
+import <new>;
+import <algorithm>;
+import <memory>;
+import <utility>;
+import <tuple>;
+import <functional>;
+import <initializer_list>;
+import <type_traits>;
+import <stdexcept>;
+
+import <string>;
+import <string_view>;
+
+//////	//////	//////	//////	//////	//////
+
+// Open-addressing hash map in the SwissTable layout: elements sit in one flat slot array next to an array of
+// one-byte control words, so a lookup touches no node and allocates nothing.
+//
+//	- A control byte is EMPTY, DELETED, or, for a full slot, the low 7 bits of the key's hash (H2).
+//	- The table is probed a group of 16 control bytes at a time; one SSE2 compare yields every slot in the group
+//	  whose H2 matches, and the key comparison runs only on those. A group that holds an EMPTY ends the probe.
+//	- Groups are aligned and visited in triangular order from the one picked by the upper hash bits (H1),
+//	  which reaches every group because the number of groups is a power of two.
+//	- The load factor stays below 7/8; erase leaves a tombstone only where a probe could have passed through.
+//
+// Iteration runs in slot order. That order depends only on the keys, the insertion history, and the capacity,
+// never on addresses, so it is the same from run to run. Erasing never moves other elements, so iterators and
+// references stay valid across erase (including erase while iterating) and are invalidated only by a rehash,
+// which an insert triggers only once size() would exceed what reserve() asked for.
+//
+// Lookups are heterogeneous when both T_Hash and T_Equal declare is_transparent, as FlatHash<std::string> and
+// std::equal_to<> do, so a std::string-keyed map is searched by string_view or literal without building a key.
+
+namespace Lumina {
+	export template<typename K>
+	struct FlatHash : std::hash<K> {};
+
+	export template<>
+	struct FlatHash<std::string> {
+		using is_transparent = void;
+		size_t operator()(std::string_view str_) const noexcept { return std::hash<std::string_view>{}(str_); }
+	};
+
+	//----	------	------	------	------	----//
+
+	export template<typename K, typename V, typename T_Hash = FlatHash<K>, typename T_Equal = std::equal_to<>>
+	class FlatHashMap {
+	public:
+		using key_type = K;
+		using mapped_type = V;
+		// Keys are reachable through iterators as non-const; they must not be modified in place.
+		using value_type = std::pair<K, V>;
+		using size_type = size_t;
+		using hasher = T_Hash;
+		using key_equal = T_Equal;
+
+		static constexpr size_type GroupWidth{ 16LLU };
+
+	private:
+		static constexpr int8_t Ctrl_Empty{ -128 };
+		static constexpr int8_t Ctrl_Deleted{ -2 };
+
+		static constexpr bool IsTransparent{ requires { typename T_Hash::is_transparent; typename T_Equal::is_transparent; } };
+		template<typename T_Key>
+		static constexpr bool IsLookupKey{ IsTransparent || std::is_same_v<std::remove_cvref_t<T_Key>, K> };
+
+		// 16 control bytes, compared all at once.
+		struct Group {
+			__m128i Ctrl;
+
+			explicit Group(int8_t const* ctrl_) noexcept : Ctrl{ _mm_load_si128(reinterpret_cast<__m128i const*>(ctrl_)) } {}
+
+			uint32_t Match(int8_t h2_) const noexcept { return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(Ctrl, _mm_set1_epi8(h2_)))); }
+			uint32_t MatchEmpty() const noexcept { return Match(Ctrl_Empty); }
+			// Both EMPTY and DELETED have the sign bit set, and H2 never does.
+			uint32_t MatchFree() const noexcept { return static_cast<uint32_t>(_mm_movemask_epi8(Ctrl)); }
+		};
+
+		//----	------	------	------	------	----//
+
+		template<bool IsConst>
+		class Iterator {
+			friend FlatHashMap;
+			template<bool>
+			friend class Iterator;
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = FlatHashMap::value_type;
+			using difference_type = std::ptrdiff_t;
+			using pointer = std::conditional_t<IsConst, value_type const*, value_type*>;
+			using reference = std::conditional_t<IsConst, value_type const&, value_type&>;
+
+		public:
+			reference operator*() const noexcept { return *Slot_; }
+			pointer operator->() const noexcept { return Slot_; }
+
+			Iterator& operator++() noexcept {
+				++Ctrl_;
+				++Slot_;
+				SkipFree();
+				return *this;
+			}
+			Iterator operator++(int) noexcept {
+				Iterator const prev{ *this };
+				++(*this);
+				return prev;
+			}
+
+			bool operator==(Iterator const& rhs_) const noexcept { return Ctrl_ == rhs_.Ctrl_; }
+
+			operator Iterator<true>() const noexcept requires (!IsConst) { return Iterator<true>{ Ctrl_, Slot_, End_ }; }
+
+		public:
+			Iterator() noexcept = default;
+
+		private:
+			Iterator(int8_t const* ctrl_, pointer slot_, int8_t const* end_) noexcept :
+				Ctrl_{ ctrl_ }, Slot_{ slot_ }, End_{ end_ } {}
+
+			void SkipFree() noexcept {
+				while (Ctrl_ != End_ && *Ctrl_ < 0) {
+					++Ctrl_;
+					++Slot_;
+				}
+			}
+
+		private:
+			int8_t const* Ctrl_{ nullptr };
+			pointer Slot_{ nullptr };
+			int8_t const* End_{ nullptr };
+		};
+
+	public:
+		using iterator = Iterator<false>;
+		using const_iterator = Iterator<true>;
+
+		//----	------	------	------	------	----//
+
+	public:
+		iterator begin() noexcept {
+			iterator it{ MakeIterator(0LLU) };
+			it.SkipFree();
+			return it;
+		}
+		const_iterator begin() const noexcept { return const_cast<FlatHashMap&>(*this).begin(); }
+		const_iterator cbegin() const noexcept { return begin(); }
+		iterator end() noexcept { return MakeIterator(Capacity_); }
+		const_iterator end() const noexcept { return const_cast<FlatHashMap&>(*this).end(); }
+		const_iterator cend() const noexcept { return end(); }
+
+		bool empty() const noexcept { return Size_ == 0LLU; }
+		size_type size() const noexcept { return Size_; }
+		size_type capacity() const noexcept { return Capacity_; }
+
+	public:
+		iterator find(K const& key_) { return FindImpl(key_); }
+		const_iterator find(K const& key_) const { return const_cast<FlatHashMap&>(*this).FindImpl(key_); }
+		template<typename T_Key> requires IsLookupKey<T_Key>
+		iterator find(T_Key const& key_) { return FindImpl(key_); }
+		template<typename T_Key> requires IsLookupKey<T_Key>
+		const_iterator find(T_Key const& key_) const { return const_cast<FlatHashMap&>(*this).FindImpl(key_); }
+
+		bool contains(K const& key_) const { return find(key_) != end(); }
+		template<typename T_Key> requires IsLookupKey<T_Key>
+		bool contains(T_Key const& key_) const { return find(key_) != end(); }
+		size_type count(K const& key_) const { return contains(key_) ? 1LLU : 0LLU; }
+
+		V& at(K const& key_);
+		V const& at(K const& key_) const { return const_cast<FlatHashMap&>(*this).at(key_); }
+
+		V& operator[](K const& key_) { return try_emplace(key_).first->second; }
+		V& operator[](K&& key_) { return try_emplace(std::move(key_)).first->second; }
+
+	public:
+		// Constructs the key from key_, and the value from args_, only if the key is absent.
+		template<typename...ArgTypes>
+		std::pair<iterator, bool> try_emplace(K const& key_, ArgTypes&&...args_) { return TryEmplace(key_, std::forward<ArgTypes>(args_)...); }
+		template<typename...ArgTypes>
+		std::pair<iterator, bool> try_emplace(K&& key_, ArgTypes&&...args_) { return TryEmplace(std::move(key_), std::forward<ArgTypes>(args_)...); }
+		template<typename T_Key, typename...ArgTypes> requires (IsTransparent && !std::is_same_v<std::remove_cvref_t<T_Key>, K>)
+		std::pair<iterator, bool> try_emplace(T_Key&& key_, ArgTypes&&...args_) { return TryEmplace(std::forward<T_Key>(key_), std::forward<ArgTypes>(args_)...); }
+
+		template<typename T_Key, typename T_Val>
+		std::pair<iterator, bool> emplace(T_Key&& key_, T_Val&& val_) { return try_emplace(std::forward<T_Key>(key_), std::forward<T_Val>(val_)); }
+		std::pair<iterator, bool> insert(value_type const& val_) { return try_emplace(val_.first, val_.second); }
+		std::pair<iterator, bool> insert(value_type&& val_) { return try_emplace(std::move(val_.first), std::move(val_.second)); }
+
+		template<typename T_Val>
+		std::pair<iterator, bool> insert_or_assign(K const& key_, T_Val&& val_);
+
+		// Returns the iterator following pos_; no other element moves.
+		iterator erase(const_iterator pos_);
+		iterator erase(iterator pos_) { return erase(const_iterator{ pos_ }); }
+		size_type erase(K const& key_) { return EraseImpl(key_); }
+		template<typename T_Key> requires IsLookupKey<T_Key>
+		size_type erase(T_Key const& key_) { return EraseImpl(key_); }
+
+		void clear() noexcept;
+		// Makes room for num_ elements in total, so that inserting up to that many causes no rehash.
+		void reserve(size_type num_);
+
+	private:
+		template<typename T_Key>
+		size_t Hash(T_Key const& key_) const;
+		static constexpr size_type H1(size_t hash_) noexcept { return hash_ >> 7U; }
+		static constexpr int8_t H2(size_t hash_) noexcept { return static_cast<int8_t>(hash_ & 0x7FLLU); }
+		// Capacity_ * 7/8, the number of full slots the table may hold.
+		static constexpr size_type MaxLoad(size_type capacity_) noexcept { return capacity_ - capacity_ / 8LLU; }
+
+		template<typename T_Key>
+		size_type FindIndex(T_Key const& key_, size_t hash_) const;
+		template<typename T_Key>
+		iterator FindImpl(T_Key const& key_);
+		template<typename T_Key, typename...ArgTypes>
+		std::pair<iterator, bool> TryEmplace(T_Key&& key_, ArgTypes&&...args_);
+		template<typename T_Key>
+		size_type EraseImpl(T_Key const& key_);
+		// Index of the first EMPTY or DELETED slot on the probe sequence of hash_.
+		size_type FindFree(size_t hash_) const noexcept;
+		// Claims a free slot for hash_, growing the table first if that slot would use up the last EMPTY allowance.
+		size_type PrepareInsert(size_t hash_);
+
+		void SetCtrl(size_type idx_, int8_t ctrl_) noexcept { Ctrl_[idx_] = ctrl_; }
+		void Rehash(size_type capacity_);
+		void Allocate(size_type capacity_);
+		void Deallocate() noexcept;
+		void DestroyAll() noexcept;
+
+		iterator MakeIterator(size_type idx_) noexcept { return iterator{ Ctrl_ + idx_, Slots_ + idx_, Ctrl_ + Capacity_ }; }
+
+	public:
+		FlatHashMap() noexcept = default;
+		FlatHashMap(std::initializer_list<value_type> vals_);
+		~FlatHashMap() noexcept;
+
+		FlatHashMap(FlatHashMap const& other_);
+		FlatHashMap(FlatHashMap&& other_) noexcept;
+		FlatHashMap& operator=(FlatHashMap const& other_);
+		FlatHashMap& operator=(FlatHashMap&& other_) noexcept;
+
+		//====	======	======	======	======	====//
+
+	private:
+		int8_t* Ctrl_{ nullptr };
+		value_type* Slots_{ nullptr };
+		size_type Capacity_{ 0LLU };
+		size_type Size_{ 0LLU };
+		// EMPTY slots that may still be filled before the load limit; tombstones do not give any back.
+		size_type GrowthLeft_{ 0LLU };
+
+		[[no_unique_address]] T_Hash Hasher_{};
+		[[no_unique_address]] T_Equal Equal_{};
+	};
+
+	//----	------	------	------	------	----//
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	V& FlatHashMap<K, V, T_Hash, T_Equal>::at(K const& key_) {
+		iterator const it{ find(key_) };
+		if (it == end()) { throw std::out_of_range{ "<FlatHashMap> Key not found.\n" }; }
+		return it->second;
+	}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	template<typename T_Val>
+	auto FlatHashMap<K, V, T_Hash, T_Equal>::insert_or_assign(K const& key_, T_Val&& val_) -> std::pair<iterator, bool> {
+		auto result{ try_emplace(key_, std::forward<T_Val>(val_)) };
+		if (!result.second) { result.first->second = std::forward<T_Val>(val_); }
+		return result;
+	}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	auto FlatHashMap<K, V, T_Hash, T_Equal>::erase(const_iterator pos_) -> iterator {
+		size_type const idx{ static_cast<size_type>(pos_.Ctrl_ - Ctrl_) };
+		assert(idx < Capacity_ && Ctrl_[idx] >= 0);
+
+		std::destroy_at(Slots_ + idx);
+		--Size_;
+		// A group that still holds an EMPTY stops every probe reaching it, so no probe can have passed through
+		// this slot to a later group and it may become EMPTY again. Otherwise it has to stay a tombstone.
+		if (Group{ Ctrl_ + (idx & ~(GroupWidth - 1LLU)) }.MatchEmpty() != 0U) {
+			SetCtrl(idx, Ctrl_Empty);
+			++GrowthLeft_;
+		}
+		else { SetCtrl(idx, Ctrl_Deleted); }
+
+		iterator it{ MakeIterator(idx) };
+		it.SkipFree();
+		return it;
+	}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	void FlatHashMap<K, V, T_Hash, T_Equal>::clear() noexcept {
+		DestroyAll();
+		if (Capacity_ > 0LLU) {
+			std::fill_n(Ctrl_, Capacity_, Ctrl_Empty);
+			GrowthLeft_ = MaxLoad(Capacity_);
+		}
+		Size_ = 0LLU;
+	}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	void FlatHashMap<K, V, T_Hash, T_Equal>::reserve(size_type num_) {
+		if (num_ <= Size_ + GrowthLeft_) { return; }
+		size_type capacity{ std::bit_ceil(num_ + num_ / 7LLU + 1LLU) };
+		if (capacity < GroupWidth) { capacity = GroupWidth; }
+		Rehash(capacity);
+	}
+
+	//----	------	------	------	------	----//
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	template<typename T_Key>
+	size_t FlatHashMap<K, V, T_Hash, T_Equal>::Hash(T_Key const& key_) const {
+		// std::hash of an integer is the identity on some standard libraries; the final mix of MurmurHash3 spreads
+		// every input bit over both H1 and H2.
+		uint64_t hash{ static_cast<uint64_t>(Hasher_(key_)) };
+		hash ^= hash >> 33U;
+		hash *= 0xFF51AFD7ED558CCDLLU;
+		hash ^= hash >> 33U;
+		return static_cast<size_t>(hash);
+	}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	template<typename T_Key>
+	auto FlatHashMap<K, V, T_Hash, T_Equal>::FindIndex(T_Key const& key_, size_t hash_) const -> size_type {
+		if (Capacity_ == 0LLU) { return Capacity_; }
+
+		size_type const mask_Group{ Capacity_ / GroupWidth - 1LLU };
+		int8_t const h2{ H2(hash_) };
+		size_type idx_Group{ H1(hash_) & mask_Group };
+		for (size_type num_Probed{ 1LLU }; ; ++num_Probed) {
+			size_type const idx_First{ idx_Group * GroupWidth };
+			Group const group{ Ctrl_ + idx_First };
+			for (uint32_t match{ group.Match(h2) }; match != 0U; match &= match - 1U) {
+				size_type const idx{ idx_First + static_cast<size_type>(std::countr_zero(match)) };
+				if (Equal_(Slots_[idx].first, key_)) { return idx; }
+			}
+			if (group.MatchEmpty() != 0U || num_Probed > mask_Group) { return Capacity_; }
+			idx_Group = (idx_Group + num_Probed) & mask_Group;
+		}
+	}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	template<typename T_Key>
+	auto FlatHashMap<K, V, T_Hash, T_Equal>::FindImpl(T_Key const& key_) -> iterator {
+		size_type const idx{ FindIndex(key_, Hash(key_)) };
+		return (idx == Capacity_) ? end() : MakeIterator(idx);
+	}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	template<typename T_Key, typename...ArgTypes>
+	auto FlatHashMap<K, V, T_Hash, T_Equal>::TryEmplace(T_Key&& key_, ArgTypes&&...args_) -> std::pair<iterator, bool> {
+		size_t const hash{ Hash(key_) };
+		if (size_type const idx{ FindIndex(key_, hash) }; idx != Capacity_) { return { MakeIterator(idx), false }; }
+
+		size_type const idx{ PrepareInsert(hash) };
+		std::construct_at(
+			Slots_ + idx,
+			std::piecewise_construct,
+			std::forward_as_tuple(std::forward<T_Key>(key_)),
+			std::forward_as_tuple(std::forward<ArgTypes>(args_)...)
+		);
+		SetCtrl(idx, H2(hash));
+		++Size_;
+		return { MakeIterator(idx), true };
+	}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	template<typename T_Key>
+	auto FlatHashMap<K, V, T_Hash, T_Equal>::EraseImpl(T_Key const& key_) -> size_type {
+		size_type const idx{ FindIndex(key_, Hash(key_)) };
+		if (idx == Capacity_) { return 0LLU; }
+		erase(MakeIterator(idx));
+		return 1LLU;
+	}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	auto FlatHashMap<K, V, T_Hash, T_Equal>::FindFree(size_t hash_) const noexcept -> size_type {
+		// The load limit keeps at least one free slot, so this always terminates.
+		size_type const mask_Group{ Capacity_ / GroupWidth - 1LLU };
+		size_type idx_Group{ H1(hash_) & mask_Group };
+		for (size_type num_Probed{ 1LLU }; ; ++num_Probed) {
+			if (uint32_t const match{ Group{ Ctrl_ + idx_Group * GroupWidth }.MatchFree() }; match != 0U) {
+				return idx_Group * GroupWidth + static_cast<size_type>(std::countr_zero(match));
+			}
+			idx_Group = (idx_Group + num_Probed) & mask_Group;
+		}
+	}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	auto FlatHashMap<K, V, T_Hash, T_Equal>::PrepareInsert(size_t hash_) -> size_type {
+		if (Capacity_ == 0LLU) { Rehash(GroupWidth); }
+
+		size_type idx{ FindFree(hash_) };
+		// Reusing a tombstone costs nothing; taking an EMPTY needs allowance left.
+		if (GrowthLeft_ == 0LLU && Ctrl_[idx] != Ctrl_Deleted) {
+			// Mostly tombstones: rebuild at the same size to clear them, instead of doubling.
+			Rehash((Size_ * 2LLU <= MaxLoad(Capacity_)) ? Capacity_ : Capacity_ * 2LLU);
+			idx = FindFree(hash_);
+		}
+		if (Ctrl_[idx] == Ctrl_Empty) { --GrowthLeft_; }
+		return idx;
+	}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	void FlatHashMap<K, V, T_Hash, T_Equal>::Rehash(size_type capacity_) {
+		assert(std::has_single_bit(capacity_) && capacity_ >= GroupWidth && MaxLoad(capacity_) >= Size_);
+
+		int8_t* const ctrl_Old{ Ctrl_ };
+		value_type* const slots_Old{ Slots_ };
+		size_type const capacity_Old{ Capacity_ };
+
+		Allocate(capacity_);
+		GrowthLeft_ = MaxLoad(capacity_) - Size_;
+		for (size_type i{ 0LLU }; i < capacity_Old; ++i) {
+			if (ctrl_Old[i] < 0) { continue; }
+			size_t const hash{ Hash(slots_Old[i].first) };
+			size_type const idx{ FindFree(hash) };
+			std::construct_at(Slots_ + idx, std::move(slots_Old[i]));
+			std::destroy_at(slots_Old + i);
+			SetCtrl(idx, H2(hash));
+		}
+
+		if (ctrl_Old != nullptr) {
+			::operator delete(ctrl_Old, std::align_val_t{ GroupWidth });
+			std::allocator<value_type>{}.deallocate(slots_Old, capacity_Old);
+		}
+	}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	void FlatHashMap<K, V, T_Hash, T_Equal>::Allocate(size_type capacity_) {
+		Ctrl_ = static_cast<int8_t*>(::operator new(capacity_, std::align_val_t{ GroupWidth }));
+		Slots_ = std::allocator<value_type>{}.allocate(capacity_);
+		Capacity_ = capacity_;
+		std::fill_n(Ctrl_, Capacity_, Ctrl_Empty);
+	}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	void FlatHashMap<K, V, T_Hash, T_Equal>::Deallocate() noexcept {
+		if (Ctrl_ == nullptr) { return; }
+		::operator delete(Ctrl_, std::align_val_t{ GroupWidth });
+		std::allocator<value_type>{}.deallocate(Slots_, Capacity_);
+		Ctrl_ = nullptr;
+		Slots_ = nullptr;
+		Capacity_ = 0LLU;
+		Size_ = 0LLU;
+		GrowthLeft_ = 0LLU;
+	}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	void FlatHashMap<K, V, T_Hash, T_Equal>::DestroyAll() noexcept {
+		if constexpr (!std::is_trivially_destructible_v<value_type>) {
+			for (size_type i{ 0LLU }; i < Capacity_; ++i) {
+				if (Ctrl_[i] >= 0) { std::destroy_at(Slots_ + i); }
+			}
+		}
+	}
+
+	//----	------	------	------	------	----//
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	FlatHashMap<K, V, T_Hash, T_Equal>::FlatHashMap(std::initializer_list<value_type> vals_) {
+		reserve(vals_.size());
+		for (value_type const& val : vals_) { insert(val); }
+	}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	FlatHashMap<K, V, T_Hash, T_Equal>::~FlatHashMap() noexcept {
+		DestroyAll();
+		Deallocate();
+	}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	FlatHashMap<K, V, T_Hash, T_Equal>::FlatHashMap(FlatHashMap const& other_) :
+		Hasher_{ other_.Hasher_ }, Equal_{ other_.Equal_ } {
+		reserve(other_.Size_);
+		for (value_type const& val : other_) { insert(val); }
+	}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	FlatHashMap<K, V, T_Hash, T_Equal>::FlatHashMap(FlatHashMap&& other_) noexcept :
+		Ctrl_{ std::exchange(other_.Ctrl_, nullptr) },
+		Slots_{ std::exchange(other_.Slots_, nullptr) },
+		Capacity_{ std::exchange(other_.Capacity_, 0LLU) },
+		Size_{ std::exchange(other_.Size_, 0LLU) },
+		GrowthLeft_{ std::exchange(other_.GrowthLeft_, 0LLU) },
+		Hasher_{ std::move(other_.Hasher_) },
+		Equal_{ std::move(other_.Equal_) } {}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	auto FlatHashMap<K, V, T_Hash, T_Equal>::operator=(FlatHashMap const& other_) -> FlatHashMap& {
+		if (this != &other_) {
+			clear();
+			Hasher_ = other_.Hasher_;
+			Equal_ = other_.Equal_;
+			reserve(other_.Size_);
+			for (value_type const& val : other_) { insert(val); }
+		}
+		return *this;
+	}
+
+	template<typename K, typename V, typename T_Hash, typename T_Equal>
+	auto FlatHashMap<K, V, T_Hash, T_Equal>::operator=(FlatHashMap&& other_) noexcept -> FlatHashMap& {
+		if (this != &other_) {
+			DestroyAll();
+			Deallocate();
+			Ctrl_ = std::exchange(other_.Ctrl_, nullptr);
+			Slots_ = std::exchange(other_.Slots_, nullptr);
+			Capacity_ = std::exchange(other_.Capacity_, 0LLU);
+			Size_ = std::exchange(other_.Size_, 0LLU);
+			GrowthLeft_ = std::exchange(other_.GrowthLeft_, 0LLU);
+			Hasher_ = std::move(other_.Hasher_);
+			Equal_ = std::move(other_.Equal_);
+		}
+		return *this;
+	}
+}
\ No newline at end of file
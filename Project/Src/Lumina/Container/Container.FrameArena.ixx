@@ -0,0 +1,243 @@
+export module Lumina.Container.FrameArena;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cstddef>;
+import <cstring>;
+
+import <new>;
+import <memory>;
+import <memory_resource>;
+import <type_traits>;
+
+import <atomic>;
+
+import <vector>;
+import <algorithm>;
+import <utility>;
+
+//////	//////	//////	//////	//////	//////
+
+// Linear allocator for memory that lives at most one frame: culling candidates, collision scratch, formatted strings.
+//
+//	- Allocation bumps an offset within the current block; a block that runs out chains the next one,
+//	  so the arena never fails, it only grows. Blocks are kept across frames.
+//	- Nothing is freed on its own. Rewind() returns to a Marker, Reset() to the start, both in O(1);
+//	  Scope rewinds on destruction, for scratch nested inside a frame.
+//	- Resource adapts the arena to std::pmr, so that standard containers can live in it.
+//	  Its deallocate is a no-op: reserve up front, as every reallocation leaves the old buffer behind.
+//	- Local() is the calling thread's own arena. EndFrame() bumps a global frame count,
+//	  and each thread's arena resets itself the first time Local() is called in a new frame.
+//
+// Objects placed here are never destroyed, hence Allocate<T> and New<T> insist on trivially destructible types.
+// In debug builds freed memory is overwritten with Poison, as is every new block, so stale reads stand out.
+
+namespace Lumina {
+	export class FrameArena {
+		struct Block {
+			std::byte* Data;
+			size_t Size;
+			// Bytes handed out before the arena moved on to the next block.
+			size_t Used;
+		};
+
+	public:
+		// Where the arena stood; Rewind() frees everything allocated since.
+		struct Marker {
+			uint32_t Block;
+			size_t Offset;
+			size_t Used;
+		};
+
+		class Scope {
+		public:
+			explicit Scope(FrameArena& arena_) noexcept : Arena_{ arena_ }, Marker_{ arena_.Mark() } {}
+			~Scope() noexcept { Arena_.Rewind(Marker_); }
+
+			Scope(Scope const&) = delete;
+			Scope& operator=(Scope const&) = delete;
+
+		private:
+			FrameArena& Arena_;
+			Marker const Marker_;
+		};
+
+		class Resource final : public std::pmr::memory_resource {
+		public:
+			explicit Resource(FrameArena& arena_) noexcept : Arena_{ arena_ } {}
+
+		private:
+			void* do_allocate(size_t size_, size_t alignment_) override { return Arena_.Allocate(size_, alignment_); }
+			void do_deallocate(void*, size_t, size_t) override {}
+			bool do_is_equal(std::pmr::memory_resource const& other_) const noexcept override { return this == &other_; }
+
+		private:
+			FrameArena& Arena_;
+		};
+
+		//----	------	------	------	------	----//
+
+	public:
+		static constexpr size_t DefaultBlockSize{ 64LLU * 1024LLU };
+		// Blocks start on a cache line, so alignments up to this never pad the first allocation of a block.
+		static constexpr size_t BlockAlignment{ 64LLU };
+		static constexpr std::byte Poison{ 0xCD };
+
+	public:
+		// alignment_ must be a power of two.
+		void* Allocate(size_t size_, size_t alignment_ = alignof(std::max_align_t));
+
+		// Uninitialized storage for num_ objects.
+		template<typename T> requires std::is_trivially_destructible_v<T>
+		T* Allocate(size_t num_) { return static_cast<T*>(Allocate(sizeof(T) * num_, alignof(T))); }
+
+		template<typename T, typename...ArgTypes> requires std::is_trivially_destructible_v<T>
+		T* New(ArgTypes&&...args_) { return ::new (Allocate(sizeof(T), alignof(T))) T{ std::forward<ArgTypes>(args_)... }; }
+
+		Marker Mark() const noexcept { return { Current_, Offset_, Used_ }; }
+		// marker_ must come from this arena and not lie past the current position.
+		void Rewind(Marker const& marker_) noexcept;
+		void Reset() noexcept { Rewind({ 0U, 0LLU, 0LLU }); }
+
+		Resource& MemoryResource() noexcept { return Resource_; }
+
+	public:
+		// Bytes handed out since the last Reset(), alignment padding included.
+		size_t Used() const noexcept { return Used_; }
+		// The most Used() has ever been; what a single block would need to hold a frame.
+		size_t HighWater() const noexcept { return std::max(HighWater_, Used_); }
+		size_t Capacity() const noexcept;
+		uint32_t Num_Blocks() const noexcept { return static_cast<uint32_t>(Blocks_.size()); }
+
+	public:
+		// The calling thread's arena; valid until the thread's first Local() call after the next EndFrame().
+		static FrameArena& Local();
+		static void EndFrame() noexcept { Frame_.fetch_add(1LLU, std::memory_order_relaxed); }
+
+	private:
+		void* AllocateSlow(size_t size_, size_t alignment_);
+		static Block NewBlock(size_t size_);
+		static void Fill(Block const& block_, size_t begin_, size_t end_) noexcept;
+
+	public:
+		explicit FrameArena(size_t blockSize_ = DefaultBlockSize);
+		~FrameArena() noexcept;
+
+		FrameArena(FrameArena const&) = delete;
+		FrameArena& operator=(FrameArena const&) = delete;
+
+		//====	======	======	======	======	====//
+
+	private:
+		std::vector<Block> Blocks_{};
+		uint32_t Current_{ 0U };
+		size_t Offset_{ 0LLU };
+
+		size_t Used_{ 0LLU };
+		size_t HighWater_{ 0LLU };
+
+		size_t BlockSize_{ DefaultBlockSize };
+		Resource Resource_{ *this };
+
+		static inline std::atomic<uint64_t> Frame_{ 0LLU };
+	};
+
+	//----	------	------	------	------	----//
+
+	inline void* FrameArena::Allocate(size_t size_, size_t alignment_) {
+		Block const& block{ Blocks_[Current_] };
+		size_t const padding{ (0LLU - reinterpret_cast<uintptr_t>(block.Data + Offset_)) & (alignment_ - 1LLU) };
+		size_t const end{ Offset_ + padding + size_ };
+		if (end > block.Size) { return AllocateSlow(size_, alignment_); }
+
+		void* const ptr{ block.Data + Offset_ + padding };
+		Used_ += end - Offset_;
+		Offset_ = end;
+		return ptr;
+	}
+
+	void* FrameArena::AllocateSlow(size_t size_, size_t alignment_) {
+		Blocks_[Current_].Used = Offset_;
+
+		// Retained blocks past the current one are free; take the first that fits, or chain a new one after the current.
+		size_t const required{ size_ + (alignment_ > BlockAlignment ? alignment_ : 0LLU) };
+		auto const it{
+			std::find_if(
+				Blocks_.begin() + Current_ + 1LLU, Blocks_.end(),
+				[required] (Block const& block_) { return block_.Size >= required; }
+			)
+		};
+		if (it != Blocks_.end()) {
+			std::iter_swap(it, Blocks_.begin() + Current_ + 1LLU);
+		}
+		else {
+			Blocks_.insert(Blocks_.begin() + Current_ + 1LLU, NewBlock(std::max(BlockSize_, required)));
+		}
+
+		++Current_;
+		Offset_ = 0LLU;
+		return Allocate(size_, alignment_);
+	}
+
+	void FrameArena::Rewind(Marker const& marker_) noexcept {
+		HighWater_ = std::max(HighWater_, Used_);
+
+		#if defined(_DEBUG)
+		Blocks_[Current_].Used = Offset_;
+		for (uint32_t i{ marker_.Block }; i <= Current_; ++i) {
+			Fill(Blocks_[i], (i == marker_.Block) ? marker_.Offset : 0LLU, Blocks_[i].Used);
+		}
+		#endif
+
+		Current_ = marker_.Block;
+		Offset_ = marker_.Offset;
+		Used_ = marker_.Used;
+	}
+
+	size_t FrameArena::Capacity() const noexcept {
+		size_t capacity{ 0LLU };
+		for (auto const& block : Blocks_) { capacity += block.Size; }
+		return capacity;
+	}
+
+	FrameArena& FrameArena::Local() {
+		thread_local FrameArena arena{};
+		thread_local uint64_t frame{ 0LLU };
+
+		uint64_t const current{ Frame_.load(std::memory_order_relaxed) };
+		if (frame != current) {
+			arena.Reset();
+			frame = current;
+		}
+		return arena;
+	}
+
+	FrameArena::Block FrameArena::NewBlock(size_t size_) {
+		Block const block{
+			static_cast<std::byte*>(::operator new(size_, std::align_val_t{ BlockAlignment })),
+			size_,
+			0LLU
+		};
+		#if defined(_DEBUG)
+		Fill(block, 0LLU, size_);
+		#endif
+		return block;
+	}
+
+	void FrameArena::Fill(Block const& block_, size_t begin_, size_t end_) noexcept {
+		if (begin_ < end_) { std::memset(block_.Data + begin_, static_cast<int>(Poison), end_ - begin_); }
+	}
+
+	//----	------	------	------	------	----//
+
+	FrameArena::FrameArena(size_t blockSize_) : BlockSize_{ std::max(blockSize_, BlockAlignment) } {
+		Blocks_.emplace_back(NewBlock(BlockSize_));
+	}
+
+	FrameArena::~FrameArena() noexcept {
+		for (auto const& block : Blocks_) {
+			::operator delete(block.Data, std::align_val_t{ BlockAlignment });
+		}
+	}
+}
\ No newline at end of file
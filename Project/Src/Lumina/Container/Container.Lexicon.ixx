@@ -0,0 +1,218 @@
+export module Lumina.Container.Lexicon;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cstddef>;
+import <cstring>;
+
+import <bit>;
+import <array>;
+import <utility>;
+import <type_traits>;
+
+import <string_view>;
+
+import <stdexcept>;
+
+//////	//////	//////	//////	//////	//////
+
+// Fixed table of (lexis, content) pairs, e.g. the names of D3D12 enumerators in JSON setups,
+// built at compile time around a perfect hash so that a lookup costs one hash, one probe, and one compare.
+//
+// The hash is CHD-style hash-and-displace:
+//	- Every lexis is hashed once, eight bytes per step. The mixed hash picks a bucket of about two entries.
+//	- Buckets are placed largest first; each gets the smallest seed under which all its entries land
+//	  on distinct, still empty slots when the seed is mixed into the hash.
+//	- A lookup recomputes the slot from its bucket's seed and compares the one candidate, so a lexis
+//	  that is not in the table is rejected rather than mistaken for whichever entry shares its slot.
+//
+// The constructor is consteval and looks every entry up once when it is done: a duplicate lexis,
+// a table no seed separates, or an entry that does not round-trip fails to compile.
+// Entries keep their declaration order for Lexis/Content, which the editor combos list by index.
+
+namespace Lumina {
+	export template<typename T, size_t N>
+	class Lexicon {
+		static_assert(N > 0LLU);
+
+	public:
+		using Entry = std::pair<std::string_view, T>;
+
+		static constexpr size_t Num_Slots{ std::bit_ceil(N) };
+		static constexpr size_t Num_Buckets{ std::bit_ceil((N + 1LLU) / 2LLU) };
+
+	private:
+		static constexpr uint32_t Invalid{ 0xFFFFFFFFU };
+		static constexpr uint32_t MaxSeed{ 1U << 20U };
+
+	public:
+		constexpr size_t Size() const noexcept { return N; }
+
+		constexpr std::string_view Lexis(int idx_) const { return Entries_.at(idx_).first; }
+		constexpr T Content(int idx_) const { return Entries_.at(idx_).second; }
+
+	public:
+		// nullptr if lexis_ is not in the table.
+		constexpr T const* TryFind(std::string_view lexis_) const noexcept;
+		constexpr T Find(std::string_view lexis_) const;
+		// Reverse lookup; a linear scan, as it only serves the editor UI.
+		constexpr std::string_view Find(T content_) const;
+
+	public:
+		static constexpr uint64_t Hash(std::string_view lexis_) noexcept;
+
+	private:
+		static constexpr uint64_t Mix(uint64_t hash_) noexcept;
+		// Little-endian, like every target of this tree, so that compile-time and run-time hashes agree.
+		static constexpr uint64_t Load(char const* src_, size_t num_) noexcept;
+		static constexpr size_t Bucket(uint64_t hash_) noexcept { return static_cast<size_t>(Mix(hash_) >> 32U) & (Num_Buckets - 1LLU); }
+		static constexpr size_t Slot(uint64_t hash_, uint32_t seed_) noexcept { return static_cast<size_t>(Mix(hash_ ^ (seed_ * 0x9E3779B97F4A7C15LLU))) & (Num_Slots - 1LLU); }
+
+	public:
+		consteval explicit Lexicon(Entry const (&entries_)[N]);
+
+		//====	======	======	======	======	====//
+
+	private:
+		std::array<Entry, N> Entries_{};
+		std::array<uint32_t, Num_Buckets> Seeds_{};
+		// Index into Entries_, or Invalid.
+		std::array<uint32_t, Num_Slots> Slots_{};
+	};
+
+	// Deduces N from the braced list: MakeLexicon<D3D12_FILL_MODE>({ { "Solid", D3D12_FILL_MODE_SOLID }, ... }).
+	export template<typename T, size_t N>
+	consteval Lexicon<T, N> MakeLexicon(std::pair<std::string_view, T> const (&entries_)[N]) {
+		return Lexicon<T, N>{ entries_ };
+	}
+
+	//----	------	------	------	------	----//
+
+	template<typename T, size_t N>
+	constexpr T const* Lexicon<T, N>::TryFind(std::string_view lexis_) const noexcept {
+		uint64_t const hash{ Hash(lexis_) };
+		uint32_t const idx{ Slots_[Slot(hash, Seeds_[Bucket(hash)])] };
+		return (idx != Invalid && Entries_[idx].first == lexis_) ? &Entries_[idx].second : nullptr;
+	}
+
+	template<typename T, size_t N>
+	constexpr T Lexicon<T, N>::Find(std::string_view lexis_) const {
+		T const* const content{ TryFind(lexis_) };
+		if (content == nullptr) { throw std::runtime_error{ "Entry not found!\n" }; }
+		return *content;
+	}
+
+	template<typename T, size_t N>
+	constexpr std::string_view Lexicon<T, N>::Find(T content_) const {
+		for (auto const& entry : Entries_) {
+			if (content_ == entry.second) {
+				return entry.first;
+			}
+		}
+		throw std::runtime_error{ "Entry not found!\n" };
+	}
+
+	//----	------	------	------	------	----//
+
+	template<typename T, size_t N>
+	constexpr uint64_t Lexicon<T, N>::Hash(std::string_view lexis_) noexcept {
+		constexpr uint64_t multiplier{ 0x9E3779B97F4A7C15LLU };
+		char const* const src{ lexis_.data() };
+		size_t const size{ lexis_.size() };
+
+		uint64_t hash{ 0xCBF29CE484222325LLU ^ size };
+		auto const step{ [&hash, multiplier] (uint64_t word_) {
+			hash = (hash ^ word_) * multiplier;
+			hash ^= hash >> 32U;
+		} };
+		if (size < 8LLU) {
+			step(Load(src, size));
+			return hash;
+		}
+		size_t i{ 0LLU };
+		for (; i + 8LLU <= size; i += 8LLU) { step(Load(src + i, 8LLU)); }
+		// The tail as the last eight bytes, overlapping the previous word, rather than byte by byte.
+		if (i < size) { step(Load(src + size - 8LLU, 8LLU)); }
+		return hash;
+	}
+
+	template<typename T, size_t N>
+	constexpr uint64_t Lexicon<T, N>::Load(char const* src_, size_t num_) noexcept {
+		if (!std::is_constant_evaluated() && num_ == 8LLU) {
+			uint64_t word{ 0LLU };
+			std::memcpy(&word, src_, 8LLU);
+			return word;
+		}
+		uint64_t word{ 0LLU };
+		for (size_t i{ 0LLU }; i < num_; ++i) { word |= static_cast<uint64_t>(static_cast<uint8_t>(src_[i])) << (i * 8LLU); }
+		return word;
+	}
+
+	template<typename T, size_t N>
+	constexpr uint64_t Lexicon<T, N>::Mix(uint64_t hash_) noexcept {
+		hash_ ^= hash_ >> 33U;
+		hash_ *= 0xFF51AFD7ED558CCDLLU;
+		hash_ ^= hash_ >> 33U;
+		return hash_;
+	}
+
+	//----	------	------	------	------	----//
+
+	template<typename T, size_t N>
+	consteval Lexicon<T, N>::Lexicon(Entry const (&entries_)[N]) {
+		std::array<uint64_t, N> hashes{};
+		for (size_t i{ 0LLU }; i < N; ++i) {
+			Entries_[i] = entries_[i];
+			hashes[i] = Hash(entries_[i].first);
+			for (size_t j{ 0LLU }; j < i; ++j) {
+				// Also catches two lexes with the same 64-bit hash, which no seed could tell apart.
+				if (hashes[j] == hashes[i]) { throw std::logic_error{ "<Lexicon> Duplicate lexis or hash!\n" }; }
+			}
+		}
+
+		std::array<uint32_t, Num_Buckets> sizes_Bucket{};
+		for (size_t i{ 0LLU }; i < N; ++i) { ++sizes_Bucket[Bucket(hashes[i])]; }
+
+		// Largest buckets first, while most slots are still free.
+		std::array<uint32_t, Num_Buckets> order{};
+		for (uint32_t i{ 0U }; i < Num_Buckets; ++i) {
+			uint32_t j{ i };
+			for (; j > 0U && sizes_Bucket[order[j - 1U]] < sizes_Bucket[i]; --j) { order[j] = order[j - 1U]; }
+			order[j] = i;
+		}
+
+		Slots_.fill(Invalid);
+		for (uint32_t const idx_Bucket : order) {
+			if (sizes_Bucket[idx_Bucket] == 0U) { break; }
+
+			uint32_t seed{ 0U };
+			for (; seed < MaxSeed; ++seed) {
+				std::array<size_t, N> slots{};
+				uint32_t num{ 0U };
+				bool isPlaced{ true };
+				for (size_t i{ 0LLU }; i < N && isPlaced; ++i) {
+					if (Bucket(hashes[i]) != idx_Bucket) { continue; }
+					size_t const slot{ Slot(hashes[i], seed) };
+					isPlaced = (Slots_[slot] == Invalid);
+					for (uint32_t k{ 0U }; k < num && isPlaced; ++k) { isPlaced = (slots[k] != slot); }
+					slots[num++] = slot;
+				}
+				if (!isPlaced) { continue; }
+
+				num = 0U;
+				for (size_t i{ 0LLU }; i < N; ++i) {
+					if (Bucket(hashes[i]) == idx_Bucket) { Slots_[slots[num++]] = static_cast<uint32_t>(i); }
+				}
+				break;
+			}
+			if (seed == MaxSeed) { throw std::logic_error{ "<Lexicon> No seed separates the bucket!\n" }; }
+			Seeds_[idx_Bucket] = seed;
+		}
+
+		// Every table in the tree round-trips at compile time, or the build fails here.
+		for (size_t i{ 0LLU }; i < N; ++i) {
+			if (TryFind(Entries_[i].first) != &Entries_[i].second) { throw std::logic_error{ "<Lexicon> Entry does not round-trip!\n" }; }
+		}
+	}
+}
\ No newline at end of file
@@ -2,8 +2,11 @@ export module Lumina.Container.List;
 
 //****	******	******	******	******	****//
 
-import <memory>;
+import <cstdint>;
 import <cassert>;
+import <cstring>;
+
+import <memory>;
 
 namespace Lumina {
 	export template<typename T>
@@ -75,7 +78,7 @@ namespace Lumina {
 		}
 
 	public:
-		template<typename T>
+		template<typename U>
 		class Iterator;
 
 		explicit List() { Initialize(32U); }
@@ -144,17 +147,17 @@ namespace Lumina {
 
 		constexpr bool IsFull() const noexcept { return (Inactive_First == -1); }
 
-		template<typename T>
+		template<typename U>
 		class Iterator {
 			friend List;
 
 		private:
-			List<T> const* Iteratee_{ nullptr };
+			List<U> const* Iteratee_{ nullptr };
 			int Index_Current{ -1 };
 			int Index_Next{ -1 };
 
 		public:
-			explicit Iterator(List<T> const& iteratee_) : Iteratee_{ &iteratee_ } {}
+			explicit Iterator(List<U> const& iteratee_) : Iteratee_{ &iteratee_ } {}
 			~Iterator() = default;
 
 			constexpr void Begin() {
@@ -167,7 +170,7 @@ namespace Lumina {
 				Index_Next = (Index_Next == -1) ? (-1) : (Iteratee_->Table_Next[Index_Next]);
 			}
 
-			inline T& operator*() {
+			inline U& operator*() {
 				assert(Index_Current != -1);
 				return Iteratee_->Table_Element[Index_Current];
 			};
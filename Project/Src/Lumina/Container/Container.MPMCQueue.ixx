@@ -0,0 +1,225 @@
+export module Lumina.Container.MPMCQueue;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cstddef>;
+import <cassert>;
+import <cstring>;
+
+import <bit>;
+import <atomic>;
+import <memory>;
+import <utility>;
+import <type_traits>;
+
+//////	//////	//////	//////	//////	//////
+
+// Bounded lock-free queue for any number of producers and consumers, after Dmitry Vyukov's design.
+// Each cell carries a sequence number that says whose turn it is:
+//	Sequence == pos			free for the producer that claims position pos
+//	Sequence == pos + 1		holds the element of position pos, ready for its consumer
+// A consumer hands the cell on to the producer one lap later by storing pos + capacity.
+// Producers contend only on EnqueuePos_ and consumers only on DequeuePos_, with one CAS per operation (or per batch).
+
+namespace Lumina {
+	export template<typename T>
+	class MPMCQueue {
+		static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>);
+
+	private:
+		static constexpr size_t CacheLineSize{ 64LLU };
+		static constexpr bool IsTrivial{ std::is_trivially_copyable_v<T> };
+
+		struct Cell {
+			std::atomic<uint64_t> Sequence;
+			alignas(T) std::byte Storage[sizeof(T)];
+		};
+
+	public:
+		template<typename...ArgTypes>
+		bool TryEmplace(ArgTypes&&...args_);
+		bool TryPush(T const& val_) { return TryEmplace(val_); }
+		bool TryPush(T&& val_) { return TryEmplace(std::move(val_)); }
+		// Claims up to num_ consecutive positions with a single CAS and fills them in order; returns how many.
+		// Elements of one batch stay contiguous in the queue, so consumers see them in the same order.
+		uint32_t TryPushBatch(T const* src_, uint32_t num_);
+
+		bool TryPop(T& dst_);
+		uint32_t TryPopBatch(T* dst_, uint32_t num_);
+
+	public:
+		uint32_t Capacity() const noexcept { return Mask_ + 1U; }
+		uint32_t SizeApprox() const noexcept;
+
+	private:
+		// Number of consecutive cells from pos_ (at most num_) whose sequence is pos + offset_, i.e. ready for this side.
+		uint32_t CountReady(uint64_t pos_, uint32_t num_, uint64_t offset_) const noexcept;
+
+		static void Store(Cell& cell_, T const& val_) {
+			if constexpr (IsTrivial) { std::memcpy(cell_.Storage, &val_, sizeof(T)); }
+			else { std::construct_at(reinterpret_cast<T*>(cell_.Storage), val_); }
+		}
+		static void Load(Cell& cell_, T& dst_) noexcept {
+			if constexpr (IsTrivial) { std::memcpy(&dst_, cell_.Storage, sizeof(T)); }
+			else {
+				T* const element{ std::launder(reinterpret_cast<T*>(cell_.Storage)) };
+				dst_ = std::move(*element);
+				std::destroy_at(element);
+			}
+		}
+
+	public:
+		// Rounded up to a power of two, and to at least 2 so that "ready to push" and "ready to pop" stay distinct.
+		explicit MPMCQueue(uint32_t capacity_);
+		~MPMCQueue() noexcept;
+
+		MPMCQueue(MPMCQueue const&) = delete;
+		MPMCQueue& operator=(MPMCQueue const&) = delete;
+
+		//====	======	======	======	======	====//
+
+	private:
+		alignas(CacheLineSize) std::atomic<uint64_t> EnqueuePos_{ 0LLU };
+		alignas(CacheLineSize) std::atomic<uint64_t> DequeuePos_{ 0LLU };
+
+		alignas(CacheLineSize) Cell* Cells_{ nullptr };
+		uint32_t Mask_{ 0U };
+	};
+
+	//----	------	------	------	------	----//
+
+	template<typename T>
+	template<typename...ArgTypes>
+	bool MPMCQueue<T>::TryEmplace(ArgTypes&&...args_) {
+		uint64_t pos{ EnqueuePos_.load(std::memory_order_relaxed) };
+		Cell* cell{ nullptr };
+		for (;;) {
+			cell = &Cells_[pos & Mask_];
+			int64_t const diff{ static_cast<int64_t>(cell->Sequence.load(std::memory_order_acquire) - pos) };
+			if (diff == 0) {
+				if (EnqueuePos_.compare_exchange_weak(pos, pos + 1LLU, std::memory_order_relaxed)) { break; }
+			}
+			// The consumer of the previous lap has not finished: full.
+			else if (diff < 0) { return false; }
+			else { pos = EnqueuePos_.load(std::memory_order_relaxed); }
+		}
+		std::construct_at(reinterpret_cast<T*>(cell->Storage), std::forward<ArgTypes>(args_)...);
+		cell->Sequence.store(pos + 1LLU, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	uint32_t MPMCQueue<T>::TryPushBatch(T const* src_, uint32_t num_) {
+		if (num_ == 0U) { return 0U; }
+
+		uint64_t pos{ EnqueuePos_.load(std::memory_order_relaxed) };
+		uint32_t num{ 0U };
+		for (;;) {
+			// A ready cell stays ready until the producer owning its position fills it, so the count holds after the CAS.
+			num = CountReady(pos, num_, 0LLU);
+			if (num == 0U) {
+				int64_t const diff{ static_cast<int64_t>(Cells_[pos & Mask_].Sequence.load(std::memory_order_acquire) - pos) };
+				if (diff < 0) { return 0U; }
+				pos = EnqueuePos_.load(std::memory_order_relaxed);
+				continue;
+			}
+			if (EnqueuePos_.compare_exchange_weak(pos, pos + num, std::memory_order_relaxed)) { break; }
+		}
+		for (uint32_t i{ 0U }; i < num; ++i) {
+			Cell& cell{ Cells_[(pos + i) & Mask_] };
+			Store(cell, src_[i]);
+			cell.Sequence.store(pos + i + 1LLU, std::memory_order_release);
+		}
+		return num;
+	}
+
+	template<typename T>
+	bool MPMCQueue<T>::TryPop(T& dst_) {
+		uint64_t pos{ DequeuePos_.load(std::memory_order_relaxed) };
+		Cell* cell{ nullptr };
+		for (;;) {
+			cell = &Cells_[pos & Mask_];
+			int64_t const diff{ static_cast<int64_t>(cell->Sequence.load(std::memory_order_acquire) - (pos + 1LLU)) };
+			if (diff == 0) {
+				if (DequeuePos_.compare_exchange_weak(pos, pos + 1LLU, std::memory_order_relaxed)) { break; }
+			}
+			// The producer of this position has not finished: empty.
+			else if (diff < 0) { return false; }
+			else { pos = DequeuePos_.load(std::memory_order_relaxed); }
+		}
+		Load(*cell, dst_);
+		cell->Sequence.store(pos + Capacity(), std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	uint32_t MPMCQueue<T>::TryPopBatch(T* dst_, uint32_t num_) {
+		if (num_ == 0U) { return 0U; }
+
+		uint64_t pos{ DequeuePos_.load(std::memory_order_relaxed) };
+		uint32_t num{ 0U };
+		for (;;) {
+			num = CountReady(pos, num_, 1LLU);
+			if (num == 0U) {
+				int64_t const diff{ static_cast<int64_t>(Cells_[pos & Mask_].Sequence.load(std::memory_order_acquire) - (pos + 1LLU)) };
+				if (diff < 0) { return 0U; }
+				pos = DequeuePos_.load(std::memory_order_relaxed);
+				continue;
+			}
+			if (DequeuePos_.compare_exchange_weak(pos, pos + num, std::memory_order_relaxed)) { break; }
+		}
+		for (uint32_t i{ 0U }; i < num; ++i) {
+			Cell& cell{ Cells_[(pos + i) & Mask_] };
+			Load(cell, dst_[i]);
+			cell.Sequence.store(pos + i + Capacity(), std::memory_order_release);
+		}
+		return num;
+	}
+
+	template<typename T>
+	uint32_t MPMCQueue<T>::CountReady(uint64_t pos_, uint32_t num_, uint64_t offset_) const noexcept {
+		uint32_t num{ 0U };
+		uint32_t const num_Max{ (num_ < Capacity()) ? num_ : Capacity() };
+		while (num < num_Max && Cells_[(pos_ + num) & Mask_].Sequence.load(std::memory_order_acquire) == pos_ + num + offset_) {
+			++num;
+		}
+		return num;
+	}
+
+	template<typename T>
+	uint32_t MPMCQueue<T>::SizeApprox() const noexcept {
+		uint64_t const head{ DequeuePos_.load(std::memory_order_relaxed) };
+		uint64_t const tail{ EnqueuePos_.load(std::memory_order_relaxed) };
+		return (tail > head) ? static_cast<uint32_t>((tail - head < Capacity()) ? (tail - head) : Capacity()) : 0U;
+	}
+
+	//----	------	------	------	------	----//
+
+	template<typename T>
+	MPMCQueue<T>::MPMCQueue(uint32_t capacity_) {
+		assert(capacity_ > 0U && capacity_ <= (1U << 31U));
+		Mask_ = std::bit_ceil((capacity_ < 2U) ? 2U : capacity_) - 1U;
+		Cells_ = new Cell[Mask_ + 1U];
+		for (uint32_t i{ 0U }; i <= Mask_; ++i) {
+			Cells_[i].Sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	template<typename T>
+	MPMCQueue<T>::~MPMCQueue() noexcept {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			uint64_t const tail{ EnqueuePos_.load(std::memory_order_acquire) };
+			for (uint64_t pos{ DequeuePos_.load(std::memory_order_acquire) }; pos != tail; ++pos) {
+				Cell& cell{ Cells_[pos & Mask_] };
+				if (cell.Sequence.load(std::memory_order_acquire) == pos + 1LLU) {
+					std::destroy_at(std::launder(reinterpret_cast<T*>(cell.Storage)));
+				}
+			}
+		}
+		if (Cells_ != nullptr) {
+			delete[] Cells_;
+			Cells_ = nullptr;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,341 @@
+export module Lumina.Container.ObjectPool;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cstddef>;
+import <cassert>;
+
+import <new>;
+import <memory>;
+import <memory_resource>;
+import <utility>;
+
+import <atomic>;
+import <mutex>;
+import <thread>;
+
+import <vector>;
+import <algorithm>;
+
+//////	//////	//////	//////	//////	//////
+
+// Fixed-size allocation for engine objects that come and go one at a time: textures, their upload data, list nodes.
+//
+//	- BlockPool carves blocks of one size out of slabs of Num_BlocksPerSlab blocks. The newest slab is carved
+//	  on demand, and freed blocks go onto an intrusive free list threaded through their first bytes,
+//	  so that a block is reused before a new one is carved. Slabs are only freed with the pool.
+//	- The free list sits behind a spin lock, as objects are often released on another thread than they were made on
+//	  (ImageTextureUploader clears its batch on a worker). A thread that churns through many objects
+//	  goes through its own Cache, which moves blocks to and from the pool CacheSize / 2 at a time.
+//	- ObjectPool<T> constructs and destroys in place; UniPtr returns the object to its pool.
+//	- PoolResource adapts a BlockPool to std::pmr, passing requests larger than a block on upstream.
+//
+// Statistics count blocks crossing the shared free list: blocks sitting in a Cache count as live.
+// Every object must be returned, and every Cache destroyed, before its pool.
+
+namespace Lumina {
+	export class BlockPool {
+	public:
+		struct Statistics {
+			uint64_t Num_Allocations;
+			uint64_t Num_Deallocations;
+			uint32_t Num_Live;
+			uint32_t Peak_Live;
+			uint32_t Num_Slabs;
+			// Block size times blocks per slab times slabs.
+			size_t SizeInBytes;
+		};
+
+	private:
+		struct FreeBlock {
+			FreeBlock* Next;
+		};
+
+		// Held for a handful of pointer swaps at a time; yields rather than spinning hot if it ever has to wait.
+		struct SpinLock {
+			void lock() noexcept {
+				while (Flag.test_and_set(std::memory_order_acquire)) {
+					while (Flag.test(std::memory_order_relaxed)) { std::this_thread::yield(); }
+				}
+			}
+			void unlock() noexcept { Flag.clear(std::memory_order_release); }
+
+			std::atomic_flag Flag{};
+		};
+
+		//----	------	------	------	------	----//
+
+	public:
+		[[nodiscard]] void* Allocate();
+		void Deallocate(void* block_) noexcept;
+
+		// One lock for num_ blocks, for caches.
+		void Allocate(void** blocks_, uint32_t num_);
+		void Deallocate(void* const* blocks_, uint32_t num_) noexcept;
+
+	public:
+		size_t BlockSize() const noexcept { return BlockSize_; }
+		size_t BlockAlignment() const noexcept { return BlockAlignment_; }
+		Statistics Stats() const noexcept;
+
+	private:
+		void* Pop();
+		void Push(void* block_) noexcept;
+		void AddSlab();
+
+	public:
+		BlockPool(size_t blockSize_, size_t blockAlignment_, uint32_t num_BlocksPerSlab_);
+		~BlockPool() noexcept;
+
+		BlockPool(BlockPool const&) = delete;
+		BlockPool& operator=(BlockPool const&) = delete;
+
+		//====	======	======	======	======	====//
+
+	private:
+		FreeBlock* FreeList_{ nullptr };
+		std::byte* Fresh_{ nullptr };
+		uint32_t Num_Fresh_{ 0U };
+
+		std::vector<std::byte*> Slabs_{};
+		Statistics Stats_{};
+		mutable SpinLock Lock_{};
+
+		size_t BlockSize_;
+		size_t BlockAlignment_;
+		uint32_t Num_BlocksPerSlab_;
+	};
+
+	//////	//////	//////	//////	//////	//////
+
+	export template<typename T>
+	class ObjectPool {
+	public:
+		static constexpr uint32_t CacheSize{ 32U };
+
+		struct Deleter {
+			void operator()(T* ptr_) const noexcept { Pool->Delete(ptr_); }
+
+			ObjectPool<T>* Pool;
+		};
+		using UniPtr = std::unique_ptr<T, Deleter>;
+
+		// Per-thread front end; not shareable between threads. Objects may be deleted through any cache of the same pool.
+		class Cache {
+		public:
+			template<typename...ArgTypes>
+			[[nodiscard]] T* New(ArgTypes&&...args_);
+			void Delete(T* ptr_) noexcept;
+
+		public:
+			explicit Cache(ObjectPool<T>& pool_) noexcept : Pool_{ &pool_ } {}
+			// Returns the cached blocks to the pool.
+			~Cache() noexcept { Pool_->Pool_.Deallocate(Blocks_, Num_Cached_); }
+
+			Cache(Cache const&) = delete;
+			Cache& operator=(Cache const&) = delete;
+
+		private:
+			ObjectPool<T>* Pool_{ nullptr };
+			void* Blocks_[CacheSize]{};
+			uint32_t Num_Cached_{ 0U };
+		};
+
+		//----	------	------	------	------	----//
+
+	public:
+		template<typename...ArgTypes>
+		[[nodiscard]] T* New(ArgTypes&&...args_);
+		// No-op on nullptr.
+		void Delete(T* ptr_) noexcept;
+
+		template<typename...ArgTypes>
+		[[nodiscard]] UniPtr MakeUnique(ArgTypes&&...args_) { return UniPtr{ New(std::forward<ArgTypes>(args_)...), Deleter{ this } }; }
+
+		BlockPool::Statistics Stats() const noexcept { return Pool_.Stats(); }
+
+	public:
+		explicit ObjectPool(uint32_t num_PerSlab_ = 64U) :
+			Pool_{ std::max(sizeof(T), sizeof(void*)), std::max(alignof(T), alignof(void*)), num_PerSlab_ } {}
+
+		ObjectPool(ObjectPool const&) = delete;
+		ObjectPool& operator=(ObjectPool const&) = delete;
+
+		//====	======	======	======	======	====//
+
+	private:
+		BlockPool Pool_;
+	};
+
+	//////	//////	//////	//////	//////	//////
+
+	export class PoolResource final : public std::pmr::memory_resource {
+	public:
+		BlockPool::Statistics Stats() const noexcept { return Pool_.Stats(); }
+
+	private:
+		void* do_allocate(size_t size_, size_t alignment_) override;
+		void do_deallocate(void* ptr_, size_t size_, size_t alignment_) override;
+		bool do_is_equal(std::pmr::memory_resource const& other_) const noexcept override { return this == &other_; }
+
+	public:
+		// Requests of up to blockSize_ bytes, aligned to at most alignof(std::max_align_t), come from the pool.
+		explicit PoolResource(
+			size_t blockSize_,
+			uint32_t num_BlocksPerSlab_ = 256U,
+			std::pmr::memory_resource* upstream_ = std::pmr::get_default_resource()
+		) : Pool_{ blockSize_, alignof(std::max_align_t), num_BlocksPerSlab_ }, Upstream_{ upstream_ } {}
+
+		//====	======	======	======	======	====//
+
+	private:
+		BlockPool Pool_;
+		std::pmr::memory_resource* Upstream_{ nullptr };
+	};
+
+	//----	------	------	------	------	----//
+
+	void* BlockPool::Allocate() {
+		std::lock_guard const lock{ Lock_ };
+		return Pop();
+	}
+
+	void BlockPool::Deallocate(void* block_) noexcept {
+		std::lock_guard const lock{ Lock_ };
+		Push(block_);
+	}
+
+	void BlockPool::Allocate(void** blocks_, uint32_t num_) {
+		std::lock_guard const lock{ Lock_ };
+		for (uint32_t i{ 0U }; i < num_; ++i) { blocks_[i] = Pop(); }
+	}
+
+	void BlockPool::Deallocate(void* const* blocks_, uint32_t num_) noexcept {
+		std::lock_guard const lock{ Lock_ };
+		for (uint32_t i{ 0U }; i < num_; ++i) { Push(blocks_[i]); }
+	}
+
+	BlockPool::Statistics BlockPool::Stats() const noexcept {
+		std::lock_guard const lock{ Lock_ };
+		return Stats_;
+	}
+
+	//----	------	------	------	------	----//
+
+	void* BlockPool::Pop() {
+		void* block{ FreeList_ };
+		if (block != nullptr) {
+			FreeList_ = FreeList_->Next;
+		}
+		else {
+			if (Num_Fresh_ == 0U) { AddSlab(); }
+			block = Fresh_;
+			Fresh_ += BlockSize_;
+			--Num_Fresh_;
+		}
+
+		++Stats_.Num_Allocations;
+		Stats_.Peak_Live = std::max(Stats_.Peak_Live, ++Stats_.Num_Live);
+		return block;
+	}
+
+	void BlockPool::Push(void* block_) noexcept {
+		assert(Stats_.Num_Live > 0U);
+		FreeList_ = ::new (block_) FreeBlock{ FreeList_ };
+
+		++Stats_.Num_Deallocations;
+		--Stats_.Num_Live;
+	}
+
+	void BlockPool::AddSlab() {
+		Slabs_.reserve(Slabs_.size() + 1LLU);
+		Fresh_ = static_cast<std::byte*>(::operator new(BlockSize_ * Num_BlocksPerSlab_, std::align_val_t{ BlockAlignment_ }));
+		Num_Fresh_ = Num_BlocksPerSlab_;
+		Slabs_.emplace_back(Fresh_);
+
+		Stats_.Num_Slabs = static_cast<uint32_t>(Slabs_.size());
+		Stats_.SizeInBytes += BlockSize_ * Num_BlocksPerSlab_;
+	}
+
+	//----	------	------	------	------	----//
+
+	BlockPool::BlockPool(size_t blockSize_, size_t blockAlignment_, uint32_t num_BlocksPerSlab_) :
+		BlockAlignment_{ std::max(blockAlignment_, alignof(FreeBlock)) },
+		Num_BlocksPerSlab_{ std::max(num_BlocksPerSlab_, 1U) } {
+		// A stride that keeps every block of a slab aligned.
+		BlockSize_ = (std::max(blockSize_, sizeof(FreeBlock)) + BlockAlignment_ - 1LLU) & ~(BlockAlignment_ - 1LLU);
+	}
+
+	BlockPool::~BlockPool() noexcept {
+		assert(Stats_.Num_Live == 0U && "<BlockPool> Blocks outlive their pool!");
+		for (std::byte* const slab : Slabs_) {
+			::operator delete(slab, std::align_val_t{ BlockAlignment_ });
+		}
+	}
+
+	//----	------	------	------	------	----//
+
+	template<typename T>
+	template<typename...ArgTypes>
+	T* ObjectPool<T>::New(ArgTypes&&...args_) {
+		void* const block{ Pool_.Allocate() };
+		try {
+			return ::new (block) T{ std::forward<ArgTypes>(args_)... };
+		}
+		catch (...) {
+			Pool_.Deallocate(block);
+			throw;
+		}
+	}
+
+	template<typename T>
+	void ObjectPool<T>::Delete(T* ptr_) noexcept {
+		if (ptr_ == nullptr) { return; }
+		ptr_->~T();
+		Pool_.Deallocate(ptr_);
+	}
+
+	template<typename T>
+	template<typename...ArgTypes>
+	T* ObjectPool<T>::Cache::New(ArgTypes&&...args_) {
+		if (Num_Cached_ == 0U) {
+			Pool_->Pool_.Allocate(Blocks_, CacheSize / 2U);
+			Num_Cached_ = CacheSize / 2U;
+		}
+		void* const block{ Blocks_[--Num_Cached_] };
+		try {
+			return ::new (block) T{ std::forward<ArgTypes>(args_)... };
+		}
+		catch (...) {
+			Blocks_[Num_Cached_++] = block;
+			throw;
+		}
+	}
+
+	template<typename T>
+	void ObjectPool<T>::Cache::Delete(T* ptr_) noexcept {
+		if (ptr_ == nullptr) { return; }
+		ptr_->~T();
+		if (Num_Cached_ == CacheSize) {
+			Pool_->Pool_.Deallocate(Blocks_ + CacheSize / 2U, CacheSize / 2U);
+			Num_Cached_ = CacheSize / 2U;
+		}
+		Blocks_[Num_Cached_++] = ptr_;
+	}
+
+	//----	------	------	------	------	----//
+
+	void* PoolResource::do_allocate(size_t size_, size_t alignment_) {
+		if (size_ <= Pool_.BlockSize() && alignment_ <= Pool_.BlockAlignment()) { return Pool_.Allocate(); }
+		return Upstream_->allocate(size_, alignment_);
+	}
+
+	void PoolResource::do_deallocate(void* ptr_, size_t size_, size_t alignment_) {
+		if (size_ <= Pool_.BlockSize() && alignment_ <= Pool_.BlockAlignment()) {
+			Pool_.Deallocate(ptr_);
+			return;
+		}
+		Upstream_->deallocate(ptr_, size_, alignment_);
+	}
+}
\ No newline at end of file
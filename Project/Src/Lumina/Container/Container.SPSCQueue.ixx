@@ -0,0 +1,196 @@
+export module Lumina.Container.SPSCQueue;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cstddef>;
+import <cassert>;
+import <cstring>;
+
+import <bit>;
+import <atomic>;
+import <memory>;
+import <utility>;
+import <algorithm>;
+import <type_traits>;
+
+//////	//////	//////	//////	//////	//////
+
+// Bounded lock-free ring for exactly one producer thread and one consumer thread.
+// Head_ is written only by the consumer and Tail_ only by the producer, each on its own cache line;
+// each side also keeps a private copy of the other's index and reloads it only when the ring looks full or empty,
+// so the shared lines move between cores once per batch of operations rather than once per element.
+//
+// Positions are free-running 64-bit counters; the slot is position & Mask_.
+
+namespace Lumina {
+	export template<typename T>
+	class SPSCQueue {
+		static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>);
+
+	private:
+		static constexpr size_t CacheLineSize{ 64LLU };
+		static constexpr bool IsTrivial{ std::is_trivially_copyable_v<T> };
+
+		struct Slot {
+			alignas(T) std::byte Storage[sizeof(T)];
+		};
+
+	public:
+		// Producer only.
+		template<typename...ArgTypes>
+		bool TryEmplace(ArgTypes&&...args_);
+		bool TryPush(T const& val_) { return TryEmplace(val_); }
+		bool TryPush(T&& val_) { return TryEmplace(std::move(val_)); }
+		// Pushes as many of src_[0, num_) as fit, in order, and returns how many; publishes them with a single store.
+		uint32_t TryPushBatch(T const* src_, uint32_t num_);
+
+		// Consumer only.
+		bool TryPop(T& dst_);
+		uint32_t TryPopBatch(T* dst_, uint32_t num_);
+
+	public:
+		uint32_t Capacity() const noexcept { return Mask_ + 1U; }
+		// Exact when called from either end while the other is idle; otherwise a snapshot.
+		uint32_t SizeApprox() const noexcept;
+		bool IsEmptyApprox() const noexcept { return SizeApprox() == 0U; }
+
+	private:
+		T* Element(uint64_t pos_) const noexcept { return std::launder(reinterpret_cast<T*>(Slots_[pos_ & Mask_].Storage)); }
+
+	public:
+		// Rounded up to a power of two.
+		explicit SPSCQueue(uint32_t capacity_);
+		~SPSCQueue() noexcept;
+
+		SPSCQueue(SPSCQueue const&) = delete;
+		SPSCQueue& operator=(SPSCQueue const&) = delete;
+
+		//====	======	======	======	======	====//
+
+	private:
+		// Consumer side
+		alignas(CacheLineSize) std::atomic<uint64_t> Head_{ 0LLU };
+		uint64_t Tail_Cached_{ 0LLU };
+
+		// Producer side
+		alignas(CacheLineSize) std::atomic<uint64_t> Tail_{ 0LLU };
+		uint64_t Head_Cached_{ 0LLU };
+
+		// Read-only after construction
+		alignas(CacheLineSize) Slot* Slots_{ nullptr };
+		uint32_t Mask_{ 0U };
+	};
+
+	//----	------	------	------	------	----//
+
+	template<typename T>
+	template<typename...ArgTypes>
+	bool SPSCQueue<T>::TryEmplace(ArgTypes&&...args_) {
+		uint64_t const tail{ Tail_.load(std::memory_order_relaxed) };
+		if (tail - Head_Cached_ > Mask_) {
+			Head_Cached_ = Head_.load(std::memory_order_acquire);
+			if (tail - Head_Cached_ > Mask_) { return false; }
+		}
+		std::construct_at(reinterpret_cast<T*>(Slots_[tail & Mask_].Storage), std::forward<ArgTypes>(args_)...);
+		Tail_.store(tail + 1LLU, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	uint32_t SPSCQueue<T>::TryPushBatch(T const* src_, uint32_t num_) {
+		uint64_t const tail{ Tail_.load(std::memory_order_relaxed) };
+		uint64_t num_Free{ Capacity() - (tail - Head_Cached_) };
+		if (num_Free < num_) {
+			Head_Cached_ = Head_.load(std::memory_order_acquire);
+			num_Free = Capacity() - (tail - Head_Cached_);
+		}
+		uint32_t const num{ static_cast<uint32_t>(std::min<uint64_t>(num_, num_Free)) };
+		if (num == 0U) { return 0U; }
+
+		if constexpr (IsTrivial) {
+			// At most two runs: up to the end of the array, then from its start.
+			uint32_t const idx_First{ static_cast<uint32_t>(tail & Mask_) };
+			uint32_t const num_First{ std::min(num, Capacity() - idx_First) };
+			std::memcpy(Slots_[idx_First].Storage, src_, sizeof(T) * num_First);
+			std::memcpy(Slots_[0].Storage, src_ + num_First, sizeof(T) * (num - num_First));
+		}
+		else {
+			for (uint32_t i{ 0U }; i < num; ++i) {
+				std::construct_at(reinterpret_cast<T*>(Slots_[(tail + i) & Mask_].Storage), src_[i]);
+			}
+		}
+		Tail_.store(tail + num, std::memory_order_release);
+		return num;
+	}
+
+	template<typename T>
+	bool SPSCQueue<T>::TryPop(T& dst_) {
+		uint64_t const head{ Head_.load(std::memory_order_relaxed) };
+		if (head == Tail_Cached_) {
+			Tail_Cached_ = Tail_.load(std::memory_order_acquire);
+			if (head == Tail_Cached_) { return false; }
+		}
+		T* const element{ Element(head) };
+		dst_ = std::move(*element);
+		std::destroy_at(element);
+		Head_.store(head + 1LLU, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	uint32_t SPSCQueue<T>::TryPopBatch(T* dst_, uint32_t num_) {
+		uint64_t const head{ Head_.load(std::memory_order_relaxed) };
+		if (Tail_Cached_ - head < num_) {
+			Tail_Cached_ = Tail_.load(std::memory_order_acquire);
+		}
+		uint32_t const num{ static_cast<uint32_t>(std::min<uint64_t>(num_, Tail_Cached_ - head)) };
+		if (num == 0U) { return 0U; }
+
+		if constexpr (IsTrivial) {
+			uint32_t const idx_First{ static_cast<uint32_t>(head & Mask_) };
+			uint32_t const num_First{ std::min(num, Capacity() - idx_First) };
+			std::memcpy(dst_, Slots_[idx_First].Storage, sizeof(T) * num_First);
+			std::memcpy(dst_ + num_First, Slots_[0].Storage, sizeof(T) * (num - num_First));
+		}
+		else {
+			for (uint32_t i{ 0U }; i < num; ++i) {
+				T* const element{ Element(head + i) };
+				dst_[i] = std::move(*element);
+				std::destroy_at(element);
+			}
+		}
+		Head_.store(head + num, std::memory_order_release);
+		return num;
+	}
+
+	template<typename T>
+	uint32_t SPSCQueue<T>::SizeApprox() const noexcept {
+		uint64_t const head{ Head_.load(std::memory_order_acquire) };
+		uint64_t const tail{ Tail_.load(std::memory_order_acquire) };
+		return (tail > head) ? static_cast<uint32_t>(std::min<uint64_t>(tail - head, Capacity())) : 0U;
+	}
+
+	//----	------	------	------	------	----//
+
+	template<typename T>
+	SPSCQueue<T>::SPSCQueue(uint32_t capacity_) {
+		assert(capacity_ > 0U && capacity_ <= (1U << 31U));
+		Mask_ = std::bit_ceil(capacity_) - 1U;
+		Slots_ = new Slot[Mask_ + 1U];
+	}
+
+	template<typename T>
+	SPSCQueue<T>::~SPSCQueue() noexcept {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			uint64_t const tail{ Tail_.load(std::memory_order_acquire) };
+			for (uint64_t pos{ Head_.load(std::memory_order_relaxed) }; pos != tail; ++pos) {
+				std::destroy_at(Element(pos));
+			}
+		}
+		if (Slots_ != nullptr) {
+			delete[] Slots_;
+			Slots_ = nullptr;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,397 @@
+export module Lumina.Container.SmallVector;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cstddef>;
+import <cassert>;
+import <cstring>;
+
+import <memory>;
+import <utility>;
+import <iterator>;
+import <algorithm>;
+import <compare>;
+import <stdexcept>;
+import <type_traits>;
+import <initializer_list>;
+
+//////	//////	//////	//////	//////	//////
+
+// std::vector with room for N elements inside the object: no allocation until the (N + 1)th element,
+// after which the elements move to the heap like a std::vector would. Iterators are plain pointers.
+//
+// Trivially copyable elements are relocated with memcpy/memmove when growing, inserting, erasing and moving;
+// other types are moved and destroyed one by one.
+//
+// Differences from std::vector: moving a SmallVector whose elements are inline moves the elements,
+// so iterators into the source do not carry over, and swap() is three moves rather than a pointer swap.
+
+namespace Lumina {
+	export template<typename T, uint32_t N, typename T_Allocator = std::allocator<T>>
+	class SmallVector {
+		static_assert(N > 0U);
+
+	public:
+		using value_type = T;
+		using allocator_type = T_Allocator;
+		using size_type = size_t;
+		using difference_type = ptrdiff_t;
+		using reference = T&;
+		using const_reference = T const&;
+		using pointer = T*;
+		using const_pointer = T const*;
+		using iterator = T*;
+		using const_iterator = T const*;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		static constexpr size_type InlineCapacity{ N };
+
+	private:
+		using AllocatorTraits = std::allocator_traits<T_Allocator>;
+
+		static constexpr bool IsTriviallyRelocatable{ std::is_trivially_copyable_v<T> };
+
+		//----	------	------	------	------	----//
+
+	public:
+		reference operator[](size_type idx_) noexcept {
+			assert(idx_ < Size_);
+			return Data_[idx_];
+		}
+		const_reference operator[](size_type idx_) const noexcept {
+			assert(idx_ < Size_);
+			return Data_[idx_];
+		}
+		reference at(size_type idx_) {
+			if (idx_ >= Size_) { throw std::out_of_range{ "Lumina::SmallVector::at" }; }
+			return Data_[idx_];
+		}
+		const_reference at(size_type idx_) const {
+			if (idx_ >= Size_) { throw std::out_of_range{ "Lumina::SmallVector::at" }; }
+			return Data_[idx_];
+		}
+
+		reference front() noexcept { return Data_[0]; }
+		const_reference front() const noexcept { return Data_[0]; }
+		reference back() noexcept { return Data_[Size_ - 1LLU]; }
+		const_reference back() const noexcept { return Data_[Size_ - 1LLU]; }
+		pointer data() noexcept { return Data_; }
+		const_pointer data() const noexcept { return Data_; }
+
+		iterator begin() noexcept { return Data_; }
+		const_iterator begin() const noexcept { return Data_; }
+		const_iterator cbegin() const noexcept { return Data_; }
+		iterator end() noexcept { return Data_ + Size_; }
+		const_iterator end() const noexcept { return Data_ + Size_; }
+		const_iterator cend() const noexcept { return Data_ + Size_; }
+		reverse_iterator rbegin() noexcept { return reverse_iterator{ end() }; }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator{ end() }; }
+		const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator{ end() }; }
+		reverse_iterator rend() noexcept { return reverse_iterator{ begin() }; }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator{ begin() }; }
+		const_reverse_iterator crend() const noexcept { return const_reverse_iterator{ begin() }; }
+
+		//----	------	------	------	------	----//
+
+	public:
+		[[nodiscard]] bool empty() const noexcept { return Size_ == 0LLU; }
+		size_type size() const noexcept { return Size_; }
+		size_type capacity() const noexcept { return Capacity_; }
+		size_type max_size() const noexcept { return AllocatorTraits::max_size(Allocator_); }
+		allocator_type get_allocator() const noexcept { return Allocator_; }
+		// True while the elements live in the object itself.
+		bool IsInline() const noexcept { return Data_ == InlineData(); }
+
+		void reserve(size_type capacity_) {
+			if (capacity_ > Capacity_) { Reallocate(capacity_); }
+		}
+		// Moves the elements back inline if they fit, otherwise trims the heap block.
+		void shrink_to_fit() {
+			if (IsInline() || Size_ == Capacity_) { return; }
+			if (Size_ <= N) {
+				T* const data_Heap{ Data_ };
+				size_type const capacity_Heap{ Capacity_ };
+				Relocate(InlineData(), data_Heap, Size_);
+				AllocatorTraits::deallocate(Allocator_, data_Heap, capacity_Heap);
+				Data_ = InlineData();
+				Capacity_ = N;
+			}
+			else { Reallocate(Size_); }
+		}
+
+		//----	------	------	------	------	----//
+
+	public:
+		void clear() noexcept {
+			DestroyRange(Data_, Data_ + Size_);
+			Size_ = 0LLU;
+		}
+
+		template<typename...ArgTypes>
+		reference emplace_back(ArgTypes&&...args_) {
+			if (Size_ < Capacity_) {
+				AllocatorTraits::construct(Allocator_, Data_ + Size_, std::forward<ArgTypes>(args_)...);
+			}
+			else {
+				// The new element is built before the old ones move, so that args_ may refer into this vector.
+				size_type const capacity{ NextCapacity(Size_ + 1LLU) };
+				T* const data{ AllocatorTraits::allocate(Allocator_, capacity) };
+				AllocatorTraits::construct(Allocator_, data + Size_, std::forward<ArgTypes>(args_)...);
+				Relocate(data, Data_, Size_);
+				ReleaseHeap();
+				Data_ = data;
+				Capacity_ = capacity;
+			}
+			return Data_[Size_++];
+		}
+		void push_back(T const& val_) { emplace_back(val_); }
+		void push_back(T&& val_) { emplace_back(std::move(val_)); }
+		void pop_back() noexcept {
+			assert(Size_ > 0LLU);
+			AllocatorTraits::destroy(Allocator_, Data_ + --Size_);
+		}
+
+		template<typename...ArgTypes>
+		iterator emplace(const_iterator pos_, ArgTypes&&...args_) {
+			size_type const idx{ static_cast<size_type>(pos_ - Data_) };
+			assert(idx <= Size_);
+			if (idx == Size_) {
+				emplace_back(std::forward<ArgTypes>(args_)...);
+				return Data_ + idx;
+			}
+			// Built first for the same reason as in emplace_back.
+			T val(std::forward<ArgTypes>(args_)...);
+			Grow(Size_ + 1LLU);
+			if constexpr (IsTriviallyRelocatable) {
+				std::memmove(static_cast<void*>(Data_ + idx + 1LLU), Data_ + idx, sizeof(T) * (Size_ - idx));
+				AllocatorTraits::construct(Allocator_, Data_ + idx, std::move(val));
+			}
+			else {
+				AllocatorTraits::construct(Allocator_, Data_ + Size_, std::move(Data_[Size_ - 1LLU]));
+				std::move_backward(Data_ + idx, Data_ + Size_ - 1LLU, Data_ + Size_);
+				Data_[idx] = std::move(val);
+			}
+			++Size_;
+			return Data_ + idx;
+		}
+		iterator insert(const_iterator pos_, T const& val_) { return emplace(pos_, val_); }
+		iterator insert(const_iterator pos_, T&& val_) { return emplace(pos_, std::move(val_)); }
+		iterator insert(const_iterator pos_, size_type num_, T const& val_) {
+			size_type const idx{ static_cast<size_type>(pos_ - Data_) };
+			T const val(val_);
+			Grow(Size_ + num_);
+			for (size_type i{ 0LLU }; i < num_; ++i) { emplace_back(val); }
+			std::rotate(Data_ + idx, Data_ + Size_ - num_, Data_ + Size_);
+			return Data_ + idx;
+		}
+		template<std::input_iterator T_InputIterator>
+		iterator insert(const_iterator pos_, T_InputIterator first_, T_InputIterator last_) {
+			size_type const idx{ static_cast<size_type>(pos_ - Data_) };
+			size_type const num_Before{ Size_ };
+			if constexpr (std::forward_iterator<T_InputIterator>) {
+				Grow(Size_ + static_cast<size_type>(std::distance(first_, last_)));
+			}
+			for (; first_ != last_; ++first_) { emplace_back(*first_); }
+			std::rotate(Data_ + idx, Data_ + num_Before, Data_ + Size_);
+			return Data_ + idx;
+		}
+		iterator insert(const_iterator pos_, std::initializer_list<T> list_) { return insert(pos_, list_.begin(), list_.end()); }
+
+		iterator erase(const_iterator pos_) { return erase(pos_, pos_ + 1); }
+		iterator erase(const_iterator first_, const_iterator last_) {
+			T* const first{ Data_ + (first_ - Data_) };
+			T* const last{ Data_ + (last_ - Data_) };
+			if (first == last) { return first; }
+			if constexpr (IsTriviallyRelocatable) {
+				std::memmove(static_cast<void*>(first), last, sizeof(T) * static_cast<size_type>(end() - last));
+			}
+			else {
+				T* const end_Moved{ std::move(last, end(), first) };
+				DestroyRange(end_Moved, end());
+			}
+			Size_ -= static_cast<size_type>(last - first);
+			return first;
+		}
+
+		void resize(size_type size_) {
+			if (size_ < Size_) {
+				DestroyRange(Data_ + size_, Data_ + Size_);
+				Size_ = size_;
+				return;
+			}
+			reserve(size_);
+			for (; Size_ < size_; ++Size_) { AllocatorTraits::construct(Allocator_, Data_ + Size_); }
+		}
+		void resize(size_type size_, T const& val_) {
+			if (size_ <= Size_) {
+				resize(size_);
+				return;
+			}
+			insert(end(), size_ - Size_, val_);
+		}
+
+		void assign(size_type num_, T const& val_) {
+			T const val(val_);
+			clear();
+			reserve(num_);
+			for (size_type i{ 0LLU }; i < num_; ++i) { emplace_back(val); }
+		}
+		template<std::input_iterator T_InputIterator>
+		void assign(T_InputIterator first_, T_InputIterator last_) {
+			clear();
+			insert(end(), first_, last_);
+		}
+		void assign(std::initializer_list<T> list_) { assign(list_.begin(), list_.end()); }
+
+		void swap(SmallVector& other_) {
+			if (this == &other_) { return; }
+			SmallVector tmp{ std::move(other_) };
+			other_ = std::move(*this);
+			*this = std::move(tmp);
+		}
+
+		//----	------	------	------	------	----//
+
+	public:
+		friend bool operator==(SmallVector const& lhs_, SmallVector const& rhs_) {
+			return std::equal(lhs_.begin(), lhs_.end(), rhs_.begin(), rhs_.end());
+		}
+		friend auto operator<=>(SmallVector const& lhs_, SmallVector const& rhs_) requires std::three_way_comparable<T> {
+			return std::lexicographical_compare_three_way(lhs_.begin(), lhs_.end(), rhs_.begin(), rhs_.end());
+		}
+		friend void swap(SmallVector& lhs_, SmallVector& rhs_) { lhs_.swap(rhs_); }
+
+		//----	------	------	------	------	----//
+
+	private:
+		T* InlineData() noexcept { return reinterpret_cast<T*>(Inline_); }
+		T const* InlineData() const noexcept { return reinterpret_cast<T const*>(Inline_); }
+
+		size_type NextCapacity(size_type required_) const noexcept { return std::max<size_type>(Capacity_ * 2LLU, required_); }
+		// Geometric growth for the inserting paths, so that repeated inserts stay amortized O(1) like push_back.
+		void Grow(size_type required_) {
+			if (required_ > Capacity_) { Reallocate(NextCapacity(required_)); }
+		}
+
+		// Moves num_ elements into uninitialized dst_ and ends the lifetime of the sources.
+		void Relocate(T* dst_, T* src_, size_type num_) noexcept {
+			if constexpr (IsTriviallyRelocatable) {
+				if (num_ > 0LLU) { std::memcpy(static_cast<void*>(dst_), src_, sizeof(T) * num_); }
+			}
+			else {
+				for (size_type i{ 0LLU }; i < num_; ++i) {
+					AllocatorTraits::construct(Allocator_, dst_ + i, std::move(src_[i]));
+					AllocatorTraits::destroy(Allocator_, src_ + i);
+				}
+			}
+		}
+
+		void DestroyRange(T* first_, T* last_) noexcept {
+			if constexpr (!std::is_trivially_destructible_v<T>) {
+				for (; first_ != last_; ++first_) { AllocatorTraits::destroy(Allocator_, first_); }
+			}
+		}
+
+		void Reallocate(size_type capacity_) {
+			T* const data{ AllocatorTraits::allocate(Allocator_, capacity_) };
+			Relocate(data, Data_, Size_);
+			ReleaseHeap();
+			Data_ = data;
+			Capacity_ = capacity_;
+		}
+
+		void ReleaseHeap() noexcept {
+			if (!IsInline()) { AllocatorTraits::deallocate(Allocator_, Data_, Capacity_); }
+		}
+
+		// Takes other_'s elements, stealing its heap block when the allocators allow it; other_ is left empty and inline.
+		void TakeFrom(SmallVector& other_) {
+			bool const canSteal{ !other_.IsInline() && (AllocatorTraits::is_always_equal::value || Allocator_ == other_.Allocator_) };
+			if (canSteal) {
+				Data_ = other_.Data_;
+				Capacity_ = other_.Capacity_;
+				Size_ = other_.Size_;
+			}
+			else {
+				reserve(other_.Size_);
+				Relocate(Data_, other_.Data_, other_.Size_);
+				Size_ = other_.Size_;
+				other_.ReleaseHeap();
+			}
+			other_.Data_ = other_.InlineData();
+			other_.Capacity_ = N;
+			other_.Size_ = 0LLU;
+		}
+
+		//----	------	------	------	------	----//
+
+	public:
+		SmallVector() noexcept(noexcept(T_Allocator())) = default;
+		explicit SmallVector(T_Allocator const& allocator_) noexcept : Allocator_{ allocator_ } {}
+		explicit SmallVector(size_type size_, T_Allocator const& allocator_ = T_Allocator()) : Allocator_{ allocator_ } { resize(size_); }
+		SmallVector(size_type size_, T const& val_, T_Allocator const& allocator_ = T_Allocator()) : Allocator_{ allocator_ } { assign(size_, val_); }
+		template<std::input_iterator T_InputIterator>
+		SmallVector(T_InputIterator first_, T_InputIterator last_, T_Allocator const& allocator_ = T_Allocator()) : Allocator_{ allocator_ } {
+			insert(end(), first_, last_);
+		}
+		SmallVector(std::initializer_list<T> list_, T_Allocator const& allocator_ = T_Allocator()) : Allocator_{ allocator_ } {
+			insert(end(), list_.begin(), list_.end());
+		}
+
+		SmallVector(SmallVector const& other_) :
+			Allocator_{ AllocatorTraits::select_on_container_copy_construction(other_.Allocator_) } {
+			insert(end(), other_.begin(), other_.end());
+		}
+		SmallVector(SmallVector&& other_) noexcept : Allocator_{ std::move(other_.Allocator_) } { TakeFrom(other_); }
+
+		SmallVector& operator=(SmallVector const& other_) {
+			if (this != &other_) {
+				if constexpr (AllocatorTraits::propagate_on_container_copy_assignment::value) {
+					if (Allocator_ != other_.Allocator_) {
+						clear();
+						shrink_to_fit();
+						ReleaseHeap();
+						Data_ = InlineData();
+						Capacity_ = N;
+					}
+					Allocator_ = other_.Allocator_;
+				}
+				assign(other_.begin(), other_.end());
+			}
+			return *this;
+		}
+		SmallVector& operator=(SmallVector&& other_) noexcept {
+			if (this != &other_) {
+				clear();
+				ReleaseHeap();
+				Data_ = InlineData();
+				Capacity_ = N;
+				if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value) {
+					Allocator_ = std::move(other_.Allocator_);
+				}
+				TakeFrom(other_);
+			}
+			return *this;
+		}
+		SmallVector& operator=(std::initializer_list<T> list_) {
+			assign(list_.begin(), list_.end());
+			return *this;
+		}
+
+		~SmallVector() noexcept {
+			clear();
+			ReleaseHeap();
+		}
+
+		//====	======	======	======	======	====//
+
+	private:
+		T* Data_{ InlineData() };
+		size_type Size_{ 0LLU };
+		size_type Capacity_{ N };
+		[[no_unique_address]] T_Allocator Allocator_{};
+		alignas(T) std::byte Inline_[sizeof(T) * N];
+	};
+}
\ No newline at end of file
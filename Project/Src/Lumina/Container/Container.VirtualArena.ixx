@@ -0,0 +1,294 @@
+module;
+
+#if defined(_WIN32)
+#include<Windows.h>
+#else
+#include<sys/mman.h>
+#include<unistd.h>
+#endif
+
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+
+export module Lumina.Container.VirtualArena;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cstddef>;
+
+import <new>;
+import <memory_resource>;
+import <type_traits>;
+
+//////	//////	//////	//////	//////	//////
+
+// Linear allocator over one contiguous reservation of address space, for grids and pools too large for the heap
+// to place well: terrain fields, generated maps, particle staging.
+//
+//	- The whole capacity is reserved up front and pages are committed as the arena grows into them,
+//	  so a generous capacity costs address space only. Addresses never move.
+//	- With PAGE_SIZE::LARGE the arena asks for large (huge) pages, cutting TLB misses on passes over the whole grid.
+//	  Windows needs the "Lock pages in memory" privilege and commits a large-page arena in full;
+//	  Linux tries the explicit hugetlb pool, then transparent huge pages over an aligned reservation.
+//	  Where neither is available the arena quietly uses small pages; UsesLargePages() tells which.
+//	- Rewind() returns to a Marker and Reset() to the start, in O(1); Trim() decommits what lies past the current offset.
+//	- Resource adapts the arena to std::pmr. As with FrameArena its deallocate is a no-op.
+//
+// Allocation past the capacity, or a failed commit, throws std::bad_alloc.
+
+namespace Lumina {
+	export enum class PAGE_SIZE : uint8_t {
+		SMALL,
+		LARGE,
+	};
+
+	export class VirtualArena {
+	public:
+		// Where the arena stood; Rewind() frees everything allocated since.
+		using Marker = size_t;
+
+		class Resource final : public std::pmr::memory_resource {
+		public:
+			explicit Resource(VirtualArena& arena_) noexcept : Arena_{ arena_ } {}
+
+		private:
+			void* do_allocate(size_t size_, size_t alignment_) override { return Arena_.Allocate(size_, alignment_); }
+			void do_deallocate(void*, size_t, size_t) override {}
+			bool do_is_equal(std::pmr::memory_resource const& other_) const noexcept override { return this == &other_; }
+
+		private:
+			VirtualArena& Arena_;
+		};
+
+		//----	------	------	------	------	----//
+
+	public:
+		// alignment_ must be a power of two.
+		void* Allocate(size_t size_, size_t alignment_ = alignof(std::max_align_t));
+
+		// Uninitialized storage for num_ objects.
+		template<typename T> requires std::is_trivially_destructible_v<T>
+		T* Allocate(size_t num_) { return static_cast<T*>(Allocate(sizeof(T) * num_, alignof(T))); }
+
+		Marker Mark() const noexcept { return Offset_; }
+		// marker_ must come from this arena and not lie past the current position.
+		void Rewind(Marker marker_) noexcept { Offset_ = marker_; }
+		void Reset() noexcept { Offset_ = 0LLU; }
+		// Gives the pages past the current offset back to the system. A no-op for arenas committed in full.
+		void Trim() noexcept;
+
+		Resource& MemoryResource() noexcept { return Resource_; }
+
+	public:
+		size_t Used() const noexcept { return Offset_; }
+		size_t Committed() const noexcept { return Committed_; }
+		size_t Capacity() const noexcept { return Reserved_; }
+		// The granularity of commits; the large page size when large pages are in use.
+		size_t PageSize() const noexcept { return PageSize_; }
+		bool UsesLargePages() const noexcept { return UsesLargePages_; }
+
+	public:
+		// The system's large page size, or zero if it has none.
+		static size_t LargePageSize() noexcept;
+		// The granularity of small-page commits.
+		static size_t SmallPageSize() noexcept;
+
+	private:
+		void* AllocateSlow(size_t size_, size_t alignment_);
+		void Commit(size_t end_);
+
+		bool ReserveLarge();
+		void ReserveSmall();
+		void Release() noexcept;
+
+	public:
+		explicit VirtualArena(size_t capacity_, PAGE_SIZE pageSize_ = PAGE_SIZE::SMALL);
+		~VirtualArena() noexcept { Release(); }
+
+		VirtualArena(VirtualArena const&) = delete;
+		VirtualArena& operator=(VirtualArena const&) = delete;
+
+		//====	======	======	======	======	====//
+
+	private:
+		std::byte* Base_{ nullptr };
+		size_t Offset_{ 0LLU };
+		size_t Committed_{ 0LLU };
+		size_t Reserved_{ 0LLU };
+
+		size_t PageSize_{ 0LLU };
+		bool UsesLargePages_{ false };
+		// Committed in full at reservation, with nothing to commit on demand or to trim.
+		bool IsPinned_{ false };
+
+		#if !defined(_WIN32)
+		// The start and length of the mapping, which an aligned reservation pads on both sides.
+		void* Mapping_{ nullptr };
+		size_t MappingSize_{ 0LLU };
+		#endif
+
+		Resource Resource_{ *this };
+	};
+
+	//----	------	------	------	------	----//
+
+	inline void* VirtualArena::Allocate(size_t size_, size_t alignment_) {
+		size_t const begin{ (Offset_ + alignment_ - 1LLU) & ~(alignment_ - 1LLU) };
+		size_t const end{ begin + size_ };
+		if (end > Committed_ || end < begin) { return AllocateSlow(size_, alignment_); }
+
+		Offset_ = end;
+		return Base_ + begin;
+	}
+
+	void* VirtualArena::AllocateSlow(size_t size_, size_t alignment_) {
+		size_t const begin{ (Offset_ + alignment_ - 1LLU) & ~(alignment_ - 1LLU) };
+		if (begin > Reserved_ || size_ > Reserved_ - begin) { throw std::bad_alloc{}; }
+
+		Commit(begin + size_);
+		Offset_ = begin + size_;
+		return Base_ + begin;
+	}
+
+	void VirtualArena::Commit(size_t end_) {
+		if (IsPinned_) { throw std::bad_alloc{}; }
+
+		size_t const committed{ (end_ + PageSize_ - 1LLU) & ~(PageSize_ - 1LLU) };
+		size_t const num_Bytes{ ((committed < Reserved_) ? committed : Reserved_) - Committed_ };
+		#if defined(_WIN32)
+		if (::VirtualAlloc(Base_ + Committed_, num_Bytes, MEM_COMMIT, PAGE_READWRITE) == nullptr) { throw std::bad_alloc{}; }
+		#else
+		if (::mprotect(Base_ + Committed_, num_Bytes, PROT_READ | PROT_WRITE) != 0) { throw std::bad_alloc{}; }
+		#endif
+		Committed_ += num_Bytes;
+	}
+
+	void VirtualArena::Trim() noexcept {
+		if (IsPinned_) { return; }
+
+		size_t const keep{ (Offset_ + PageSize_ - 1LLU) & ~(PageSize_ - 1LLU) };
+		if (keep >= Committed_) { return; }
+		#if defined(_WIN32)
+		::VirtualFree(Base_ + keep, Committed_ - keep, MEM_DECOMMIT);
+		#else
+		::madvise(Base_ + keep, Committed_ - keep, MADV_DONTNEED);
+		::mprotect(Base_ + keep, Committed_ - keep, PROT_NONE);
+		#endif
+		Committed_ = keep;
+	}
+
+	//----	------	------	------	------	----//
+
+	size_t VirtualArena::LargePageSize() noexcept {
+		#if defined(_WIN32)
+		return ::GetLargePageMinimum();
+		#else
+		// Every x86-64 Linux with huge pages has 2 MiB ones.
+		return 2LLU * 1024LLU * 1024LLU;
+		#endif
+	}
+
+	size_t VirtualArena::SmallPageSize() noexcept {
+		#if defined(_WIN32)
+		SYSTEM_INFO info{};
+		::GetSystemInfo(&info);
+		return info.dwAllocationGranularity;
+		#else
+		return static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+		#endif
+	}
+
+	bool VirtualArena::ReserveLarge() {
+		size_t const pageSize{ LargePageSize() };
+		if (pageSize == 0LLU) { return false; }
+		size_t const size{ (Reserved_ + pageSize - 1LLU) & ~(pageSize - 1LLU) };
+
+		#if defined(_WIN32)
+		// Large pages are locked in memory, so the process needs the privilege held and enabled.
+		static bool const hasPrivilege{
+			[] () {
+				HANDLE token{ nullptr };
+				if (!::OpenProcessToken(::GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) { return false; }
+				TOKEN_PRIVILEGES privileges{ .PrivilegeCount{ 1U } };
+				privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+				bool const isEnabled{
+					::LookupPrivilegeValueW(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid) &&
+					::AdjustTokenPrivileges(token, FALSE, &privileges, 0U, nullptr, nullptr) &&
+					::GetLastError() == ERROR_SUCCESS
+				};
+				::CloseHandle(token);
+				return isEnabled;
+			}()
+		};
+		if (!hasPrivilege) { return false; }
+
+		// Large pages cannot be reserved and committed apart.
+		void* const base{ ::VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE) };
+		if (base == nullptr) { return false; }
+
+		Base_ = static_cast<std::byte*>(base);
+		Committed_ = size;
+		IsPinned_ = true;
+		#else
+		void* const mapping{ ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0) };
+		if (mapping != MAP_FAILED) {
+			Base_ = static_cast<std::byte*>(mapping);
+			Mapping_ = mapping;
+			MappingSize_ = size;
+			Committed_ = size;
+			IsPinned_ = true;
+		}
+		else {
+			// No hugetlb pool; reserve with room to align on a huge page, which transparent huge pages need.
+			MappingSize_ = size + pageSize;
+			Mapping_ = ::mmap(nullptr, MappingSize_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+			if (Mapping_ == MAP_FAILED) { throw std::bad_alloc{}; }
+			uintptr_t const address{ reinterpret_cast<uintptr_t>(Mapping_) };
+			Base_ = static_cast<std::byte*>(Mapping_) + ((0LLU - address) & (pageSize - 1LLU));
+			if (::madvise(Base_, size, MADV_HUGEPAGE) != 0) {
+				::munmap(Mapping_, MappingSize_);
+				Base_ = nullptr;
+				Mapping_ = nullptr;
+				return false;
+			}
+		}
+		#endif
+
+		Reserved_ = size;
+		PageSize_ = pageSize;
+		UsesLargePages_ = true;
+		return true;
+	}
+
+	void VirtualArena::ReserveSmall() {
+		PageSize_ = SmallPageSize();
+		Reserved_ = (Reserved_ + PageSize_ - 1LLU) & ~(PageSize_ - 1LLU);
+
+		#if defined(_WIN32)
+		Base_ = static_cast<std::byte*>(::VirtualAlloc(nullptr, Reserved_, MEM_RESERVE, PAGE_NOACCESS));
+		if (Base_ == nullptr) { throw std::bad_alloc{}; }
+		#else
+		MappingSize_ = Reserved_;
+		Mapping_ = ::mmap(nullptr, MappingSize_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		if (Mapping_ == MAP_FAILED) { throw std::bad_alloc{}; }
+		Base_ = static_cast<std::byte*>(Mapping_);
+		#endif
+	}
+
+	void VirtualArena::Release() noexcept {
+		#if defined(_WIN32)
+		if (Base_ != nullptr) { ::VirtualFree(Base_, 0LLU, MEM_RELEASE); }
+		#else
+		if (Mapping_ != nullptr) { ::munmap(Mapping_, MappingSize_); }
+		#endif
+	}
+
+	//----	------	------	------	------	----//
+
+	VirtualArena::VirtualArena(size_t capacity_, PAGE_SIZE pageSize_) : Reserved_{ capacity_ } {
+		if (pageSize_ == PAGE_SIZE::LARGE && ReserveLarge()) { return; }
+		ReserveSmall();
+	}
+}
\ No newline at end of file
@@ -19,15 +19,15 @@ import <type_traits>;
 
 import <memory>;
 import <utility>;
-import <any>;
 
 import <vector>;
-import <unordered_map>;
 
 import <string>;
 
 import Lumina.DX12;
 
+import Lumina.Container.Lexicon;
+
 import Lumina.Utils.Data;
 import Lumina.Utils.Debug;
 
@@ -104,153 +104,131 @@ namespace Lumina::DX12 {
 	}
 
 	namespace {
+		// Every field type has exactly one section, so the section is picked at compile time from T,
+		// and only the value string is looked up, in a perfect-hash table built at compile time.
 		class Lexicon {
-		private:
-			template<typename T>
-			using Section = std::unordered_map<std::string, T>;
-
-			//====	======	======	======	======	====//
-
 		public:
 			template<typename T>
 			static T LookUp(const JSON& jsonObj_, std::string_view key_) {
-				auto ptr_Table{ Sections_.at(key_.data()) };
-				std::string_view val{ GetString(jsonObj_, key_) };
-				return std::any_cast<const Section<T>*>(ptr_Table)->at(val.data());
+				return Section<T>().Find(GetString(jsonObj_, key_));
+			}
+			template<typename T>
+			static T LookUp(const JSON& jsonObj_, [[maybe_unused]] std::string_view key_, uint32_t index_) {
+				return Section<T>().Find(GetString(jsonObj_, index_));
 			}
+
+		private:
 			template<typename T>
-			static T LookUp(const JSON& jsonObj_, std::string_view key_, uint32_t index_) {
-				auto ptr_Table{ Sections_.at(key_.data()) };
-				std::string_view val{ GetString(jsonObj_, index_) };
-				return std::any_cast<const Section<T>*>(ptr_Table)->at(val.data());
+			static constexpr auto const& Section() noexcept {
+				if constexpr (std::is_same_v<T, D3D12_SHADER_VISIBILITY>) { return ShaderVisibilities_; }
+				else if constexpr (std::is_same_v<T, D3D12_ROOT_PARAMETER_TYPE>) { return RootParameterTypes_; }
+				else if constexpr (std::is_same_v<T, D3D12_DESCRIPTOR_RANGE_TYPE>) { return DescriptorRangeTypes_; }
+				else if constexpr (std::is_same_v<T, D3D12_FILTER_REDUCTION_TYPE>) { return FilterReductionTypes_; }
+				else if constexpr (std::is_same_v<T, uint32_t>) { return FilterTypes_; }
+				else if constexpr (std::is_same_v<T, D3D12_TEXTURE_ADDRESS_MODE>) { return TextureAddressMode_; }
+				else if constexpr (std::is_same_v<T, D3D12_BLEND>) { return Blends_; }
+				else if constexpr (std::is_same_v<T, D3D12_BLEND_OP>) { return BlendOperations_; }
+				else if constexpr (std::is_same_v<T, D3D12_LOGIC_OP>) { return LogicOperations_; }
+				else if constexpr (std::is_same_v<T, D3D12_FILL_MODE>) { return FillModes_; }
+				else if constexpr (std::is_same_v<T, D3D12_CULL_MODE>) { return CullModes_; }
+				else if constexpr (std::is_same_v<T, D3D12_DEPTH_WRITE_MASK>) { return DepthWriteMasks_; }
+				else if constexpr (std::is_same_v<T, D3D12_COMPARISON_FUNC>) { return ComparisonFuncs_; }
+				else if constexpr (std::is_same_v<T, D3D12_PRIMITIVE_TOPOLOGY_TYPE>) { return PrimitiveTopologyTypes_; }
+				else if constexpr (std::is_same_v<T, DXGI_FORMAT>) { return InputElementFormats_; }
+				else { static_assert(sizeof(T) == 0LLU, "<Lexicon> No section for this type."); }
 			}
 
 			//====	======	======	======	======	====//
 
 		private:
-			static inline const Section<D3D12_SHADER_VISIBILITY> ShaderVisibilities_{
+			static constexpr auto ShaderVisibilities_{ Lumina::MakeLexicon<D3D12_SHADER_VISIBILITY>({
 				{ "All", D3D12_SHADER_VISIBILITY_ALL },
 				{ "Vertex", D3D12_SHADER_VISIBILITY_VERTEX },
 				{ "Pixel", D3D12_SHADER_VISIBILITY_PIXEL },
-			};
+			}) };
 
-			static inline const Section<D3D12_ROOT_PARAMETER_TYPE> RootParameterTypes_{
+			static constexpr auto RootParameterTypes_{ Lumina::MakeLexicon<D3D12_ROOT_PARAMETER_TYPE>({
 				{ "DescriptorTable", D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE },
 				{ "32BitConstants", D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS },
 				{ "CBV", D3D12_ROOT_PARAMETER_TYPE_CBV },
 				{ "SRV", D3D12_ROOT_PARAMETER_TYPE_SRV },
 				{ "UAV", D3D12_ROOT_PARAMETER_TYPE_UAV },
-			};
-			static inline const Section<D3D12_DESCRIPTOR_RANGE_TYPE> DescriptorRangeTypes_{
+			}) };
+			static constexpr auto DescriptorRangeTypes_{ Lumina::MakeLexicon<D3D12_DESCRIPTOR_RANGE_TYPE>({
 				{ "CBV", D3D12_DESCRIPTOR_RANGE_TYPE_CBV },
 				{ "SRV", D3D12_DESCRIPTOR_RANGE_TYPE_SRV },
 				{ "UAV", D3D12_DESCRIPTOR_RANGE_TYPE_UAV },
 				{ "Sampler", D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER },
-			};
+			}) };
 
-			static inline const Section<D3D12_FILTER_REDUCTION_TYPE> FilterReductionTypes_{
+			static constexpr auto FilterReductionTypes_{ Lumina::MakeLexicon<D3D12_FILTER_REDUCTION_TYPE>({
 				{ "Standard", D3D12_FILTER_REDUCTION_TYPE_STANDARD },
 				{ "Comparison", D3D12_FILTER_REDUCTION_TYPE_COMPARISON },
 				{ "Minimum", D3D12_FILTER_REDUCTION_TYPE_MINIMUM },
 				{ "Maximum", D3D12_FILTER_REDUCTION_TYPE_MAXIMUM },
-			};
-			static inline const Section<uint32_t> FilterTypes_{
+			}) };
+			static constexpr auto FilterTypes_{ Lumina::MakeLexicon<uint32_t>({
 				{ "Point", 0b00 },
 				{ "Bilinear", 0b01 },
-			};
+			}) };
 
-			static inline const Section<D3D12_TEXTURE_ADDRESS_MODE> TextureAddressMode_{
+			static constexpr auto TextureAddressMode_{ Lumina::MakeLexicon<D3D12_TEXTURE_ADDRESS_MODE>({
 				{ "Wrap", D3D12_TEXTURE_ADDRESS_MODE_WRAP },
 				{ "Clamp", D3D12_TEXTURE_ADDRESS_MODE_CLAMP },
 				{ "Border", D3D12_TEXTURE_ADDRESS_MODE_BORDER },
 				{ "Mirror", D3D12_TEXTURE_ADDRESS_MODE_MIRROR },
 				{ "MirrorOnce", D3D12_TEXTURE_ADDRESS_MODE_MIRROR_ONCE },
-			};
+			}) };
 
 			//----	------	------	------	------	----//
 
-			static inline const Section<D3D12_BLEND> Blends_{
+			static constexpr auto Blends_{ Lumina::MakeLexicon<D3D12_BLEND>({
 				{ "One", D3D12_BLEND_ONE },
 				{ "SrcColor", D3D12_BLEND_SRC_COLOR },
 				{ "InvSrcColor", D3D12_BLEND_INV_SRC_COLOR },
 				{ "SrcAlpha", D3D12_BLEND_SRC_ALPHA },
 				{ "InvSrcAlpha", D3D12_BLEND_INV_SRC_ALPHA },
-			};
-			static inline const Section<D3D12_BLEND_OP> BlendOperations_{
+			}) };
+			static constexpr auto BlendOperations_{ Lumina::MakeLexicon<D3D12_BLEND_OP>({
 				{ "Src+Dst", D3D12_BLEND_OP_ADD },
-			};
-			static inline const Section<D3D12_LOGIC_OP> LogicOperations_{
+			}) };
+			static constexpr auto LogicOperations_{ Lumina::MakeLexicon<D3D12_LOGIC_OP>({
 				{ "None", D3D12_LOGIC_OP_NOOP },
-			};
+			}) };
 
-			static inline const Section<D3D12_FILL_MODE> FillModes_{
+			static constexpr auto FillModes_{ Lumina::MakeLexicon<D3D12_FILL_MODE>({
 				{ "Wireframe", D3D12_FILL_MODE_WIREFRAME },
 				{ "Solid", D3D12_FILL_MODE_SOLID },
-			};
-			static inline const Section<D3D12_CULL_MODE> CullModes_{
+			}) };
+			static constexpr auto CullModes_{ Lumina::MakeLexicon<D3D12_CULL_MODE>({
 				{ "None", D3D12_CULL_MODE_NONE },		// All polygons will be drawn regardless of facing direction.
 				{ "Front", D3D12_CULL_MODE_FRONT },		// Front-facing polygons will not be drawn.
 				{ "Back", D3D12_CULL_MODE_BACK },		// Back-facing polygons will not be drawn.
-			};
+			}) };
 
-			static inline const Section<D3D12_DEPTH_WRITE_MASK> DepthWriteMasks_{
+			static constexpr auto DepthWriteMasks_{ Lumina::MakeLexicon<D3D12_DEPTH_WRITE_MASK>({
 				{ "Zero", D3D12_DEPTH_WRITE_MASK_ZERO },
 				{ "All", D3D12_DEPTH_WRITE_MASK_ALL },
-			};
-			static inline const Section<D3D12_COMPARISON_FUNC> ComparisonFuncs_{
+			}) };
+			static constexpr auto ComparisonFuncs_{ Lumina::MakeLexicon<D3D12_COMPARISON_FUNC>({
 				{ "LessEqual", D3D12_COMPARISON_FUNC_LESS_EQUAL },
-			};
+			}) };
 
-			static inline const Section<D3D12_PRIMITIVE_TOPOLOGY_TYPE> PrimitiveTopologyTypes_{
+			static constexpr auto PrimitiveTopologyTypes_{ Lumina::MakeLexicon<D3D12_PRIMITIVE_TOPOLOGY_TYPE>({
 				{ "Point", D3D12_PRIMITIVE_TOPOLOGY_TYPE_POINT },
 				{ "Line", D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE },
 				{ "Triangle", D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE },
 				{ "Patch", D3D12_PRIMITIVE_TOPOLOGY_TYPE_PATCH },
-			};
+			}) };
 
-			static inline const Section<DXGI_FORMAT> InputElementFormats_{
+			static constexpr auto InputElementFormats_{ Lumina::MakeLexicon<DXGI_FORMAT>({
 				{ "float2", DXGI_FORMAT_R32G32_FLOAT },
 				{ "float3", DXGI_FORMAT_R32G32B32_FLOAT },
 				{ "float4", DXGI_FORMAT_R32G32B32A32_FLOAT },
 				{ "uint", DXGI_FORMAT_R32_UINT },
 				{ "uint2", DXGI_FORMAT_R32G32_UINT },
 				{ "uint3", DXGI_FORMAT_R32G32B32_UINT },
-			};
-
-			//----	------	------	------	------	----//
-
-			static inline const Section<std::any> Sections_{
-				{ "ShaderVisibility", &ShaderVisibilities_ },
-
-				{ "ParameterType", &RootParameterTypes_ },
-				{ "RangeType", &DescriptorRangeTypes_ },
-
-				{ "ReductionType", &FilterReductionTypes_ },
-				{ "MinFilter", &FilterTypes_ },
-				{ "MagFilter", &FilterTypes_ },
-				{ "MipFilter", &FilterTypes_ },
-
-				{ "TextureAddressU", &TextureAddressMode_ },
-				{ "TextureAddressV", &TextureAddressMode_ },
-				{ "TextureAddressW", &TextureAddressMode_ },
-
-				{ "SrcBlend", &Blends_ },
-				{ "DestBlend", &Blends_ },
-				{ "BlendOp", &BlendOperations_ },
-				{ "SrcBlendAlpha", &Blends_ },
-				{ "DestBlendAlpha", &Blends_ },
-				{ "BlendOpAlpha", &BlendOperations_ },
-				{ "LogicOp", &LogicOperations_ },
-
-				{ "FillMode", &FillModes_ },
-				{ "CullMode", &CullModes_ },
-				{ "PrimitiveTopologyType", &PrimitiveTopologyTypes_ },
-
-				{ "DepthWriteMask", &DepthWriteMasks_ },
-				{ "DepthFunc", &ComparisonFuncs_ },
-
-				{ "InputElementFormat", &InputElementFormats_ },
-			};
+			}) };
 		};
 	}
 
@@ -37,6 +37,8 @@ import : Debug;
 
 import Lumina.Mixins;
 
+import Lumina.Container.ObjectPool;
+
 import Lumina.Utils.String;
 import Lumina.Utils.Debug;
 
@@ -66,6 +68,8 @@ export namespace Lumina::DX12 {
 	//////	//////	//////	//////	//////	//////
 
 	class ImageSet : private DirectX::ScratchImage {
+		friend ObjectPool<ImageSet>;
+
 	public:
 		inline const DirectX::Image* operator()() const noexcept { return GetImages(); }
 
@@ -75,11 +79,14 @@ export namespace Lumina::DX12 {
 		//----	------	------	------	------	----//
 
 	public:
-		[[nodiscard]] static UniPtr<ImageSet> Create(
+		[[nodiscard]] static ObjectPool<ImageSet>::UniPtr Create(
 			std::string_view filePath_,
 			DirectX::WIC_FLAGS flags_ = DirectX::WIC_FLAGS_FORCE_SRGB
 		);
 
+	private:
+		static ObjectPool<ImageSet>& Pool();
+
 		//----	------	------	------	------	----//
 
 	private:
@@ -96,6 +103,8 @@ export namespace Lumina::DX12 {
 	//////	//////	//////	//////	//////	//////
 
 	class MipChain : private DirectX::ScratchImage {
+		friend ObjectPool<MipChain>;
+
 	public:
 		inline const DirectX::Image* operator()() const noexcept { return GetImages(); }
 
@@ -105,11 +114,14 @@ export namespace Lumina::DX12 {
 		//----	------	------	------	------	----//
 
 	public:
-		[[nodiscard]] static UniPtr<MipChain> Create(
+		[[nodiscard]] static ObjectPool<MipChain>::UniPtr Create(
 			const ImageSet& imgSet_,
 			DirectX::TEX_FILTER_FLAGS flags_TexFilter_ = DirectX::TEX_FILTER_SRGB
 		);
 
+	private:
+		static ObjectPool<MipChain>& Pool();
+
 		//----	------	------	------	------	----//
 
 	private:
@@ -262,13 +274,17 @@ namespace Lumina::DX12 {
 	//	ImageSet								//
 	//////	//////	//////	//////	//////	//////
 
-	UniPtr<ImageSet> ImageSet::Create(
+	ObjectPool<ImageSet>::UniPtr ImageSet::Create(
 		std::string_view filePath_,
 		DirectX::WIC_FLAGS flags_
 	) {
-		return UniPtr<ImageSet>{
-			new ImageSet{ filePath_, flags_ }
-		};
+		return Pool().MakeUnique(filePath_, flags_);
+	}
+
+	// Loading makes and drops image sets one after another, so a handful of blocks serve them all.
+	ObjectPool<ImageSet>& ImageSet::Pool() {
+		static ObjectPool<ImageSet> pool{ 4U };
+		return pool;
 	}
 
 	//----	------	------	------	------	----//
@@ -295,13 +311,16 @@ namespace Lumina::DX12 {
 	//	MipChain								//
 	//////	//////	//////	//////	//////	//////
 
-	UniPtr<MipChain> MipChain::Create(
+	ObjectPool<MipChain>::UniPtr MipChain::Create(
 		const ImageSet& imgSet_,
 		DirectX::TEX_FILTER_FLAGS flags_TexFilter_
 	) {
-		return UniPtr<MipChain>{
-			new MipChain{ imgSet_, flags_TexFilter_ }
-		};
+		return Pool().MakeUnique(imgSet_, flags_TexFilter_);
+	}
+
+	ObjectPool<MipChain>& MipChain::Pool() {
+		static ObjectPool<MipChain> pool{ 4U };
+		return pool;
 	}
 
 	//----	------	------	------	------	----//
@@ -380,6 +399,7 @@ namespace Lumina::DX12 {
 	class ImageTexture::ResourceMetadata {
 		friend SubresourceMetadata;
 		friend Intermediate;
+		friend ObjectPool<ResourceMetadata>;
 
 		//====	======	======	======	======	====//
 
@@ -388,6 +408,9 @@ namespace Lumina::DX12 {
 
 		inline uint64_t SizeInBytes_IntermediateData() const noexcept;
 
+	private:
+		static ObjectPool<ResourceMetadata>& Pool();
+
 		//----	------	------	------	------	----//
 
 	private:
@@ -418,6 +441,7 @@ namespace Lumina::DX12 {
 
 	class ImageTexture::Intermediate final {
 		friend ImageTexture;
+		friend ObjectPool<Intermediate>;
 
 		//====	======	======	======	======	====//
 
@@ -434,6 +458,8 @@ namespace Lumina::DX12 {
 		void AnalyzeSubresourceData(const GraphicsDevice& device_);
 		void CopySubresourceData(const GraphicsDevice& device_);
 
+		static ObjectPool<Intermediate>& Pool();
+
 		//----	------	------	------	------	----//
 
 	private:
@@ -451,7 +477,7 @@ namespace Lumina::DX12 {
 		const ImageTexture* ImageTexture_{ nullptr };
 
 		std::vector<D3D12_SUBRESOURCE_DATA> Subresources_{};
-		UniPtr<ResourceMetadata> Metadata_{ nullptr };
+		ObjectPool<ResourceMetadata>::UniPtr Metadata_{ nullptr };
 		UploadBuffer Buffer_{};
 	};
 }
@@ -579,6 +605,13 @@ namespace Lumina::DX12 {
 		}
 	}
 
+	//----	------	------	------	------	----//
+
+	ObjectPool<ImageTexture::ResourceMetadata>& ImageTexture::ResourceMetadata::Pool() {
+		static ObjectPool<ResourceMetadata> pool{ 16U };
+		return pool;
+	}
+
 	//////	//////	//////	//////	//////	//////
 	//	ImageTexture::Intermediate				//
 	//////	//////	//////	//////	//////	//////
@@ -618,13 +651,11 @@ namespace Lumina::DX12 {
 	}
 
 	void ImageTexture::Intermediate::AnalyzeSubresourceData(const GraphicsDevice& device_) {
-		Metadata_ = UniPtr<ResourceMetadata>{
-			new ResourceMetadata{
-				device_,
-				*ImageTexture_,
-				Subresources_
-			}
-		};
+		Metadata_ = ResourceMetadata::Pool().MakeUnique(
+			device_,
+			*ImageTexture_,
+			Subresources_
+		);
 	}
 
 	// Copies subresource data into the intermediate buffer.
@@ -674,6 +705,14 @@ namespace Lumina::DX12 {
 	ImageTexture::Intermediate::~Intermediate() noexcept {
 		Subresources_.clear();
 	}
+
+	//----	------	------	------	------	----//
+
+	// Every batch of the uploader makes one per texture and releases them on its clearing thread, hence a pool that locks.
+	ObjectPool<ImageTexture::Intermediate>& ImageTexture::Intermediate::Pool() {
+		static ObjectPool<Intermediate> pool{ 16U };
+		return pool;
+	}
 }
 
 //****	******	******	******	******	****//
@@ -706,13 +745,13 @@ namespace Lumina::DX12 {
 		const MipChain& mipChain_
 	) {
 		if (IntermediateData_ == nullptr) {
-			IntermediateData_ = new Intermediate{ device_, *this, mipChain_ };
+			IntermediateData_ = Intermediate::Pool().New(device_, *this, mipChain_);
 		}
 	}
 
 	inline void ImageTexture::ReleaseIntermediateData() noexcept {
 		if (IntermediateData_ != nullptr) {
-			delete IntermediateData_;
+			Intermediate::Pool().Delete(IntermediateData_);
 			IntermediateData_ = nullptr;
 		}
 	}
@@ -801,6 +840,9 @@ namespace Lumina::DX12 {
 
 		auto upload{
 			[&, this]() {
+				// The tag is per thread, and this runs on its own.
+				Utils::Debug::AllocationTracker::TagScope const tagScope{ Utils::Debug::ALLOCATION_TAG::GRAPHICS };
+
 				// Orders the intermediate data of the batched textures
 				// to be copied to the resources in the default heap.
 				for (auto const* tex : BatchedTextures_) {
@@ -872,6 +914,8 @@ namespace Lumina::DX12 {
 			"<DX12.ImageTextureUploader> Can't batch ready-to-upload textures outside a Begin-End block!\n"
 		};
 
+		Utils::Debug::AllocationTracker::TagScope const tagScope{ Utils::Debug::ALLOCATION_TAG::GRAPHICS };
+
 		if (tex_.Status_ == ImageTexture::STATUS::READY_TO_UPLOAD) {
 			tex_.Status_ = ImageTexture::STATUS::UPLOAD_IN_PROGRESS;
 
@@ -0,0 +1,576 @@
+export module Lumina.Math.AABBTree;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cmath>;
+
+import <limits>;
+
+import <vector>;
+import <algorithm>;
+import <utility>;
+import <type_traits>;
+
+import Lumina.Math.Vector;
+
+import Lumina.Container.SmallVector;
+
+//////	//////	//////	//////	//////	//////
+
+#define INLINE_NAMESPACE_MATH_BEGIN		inline namespace Math {
+#define INLINE_NAMESPACE_MATH_END		}
+
+//****	******	******	******	******	****//
+
+//////	//////	//////	//////	//////	//////
+//	AABBTree								//
+//////	//////	//////	//////	//////	//////
+
+// Dynamic bounding volume hierarchy for objects that move every frame, in the manner of Box2D's b2DynamicTree.
+//
+//	- Every proxy is a leaf holding a fat box: its tight box grown by Margin, and stretched further
+//	  along its displacement. MoveProxy() only touches the tree once the tight box escapes the fat one,
+//	  so slow movers cost a containment test per frame.
+//	- Insertion walks down to the sibling that adds the least surface area (perimeter in 2D),
+//	  comparing the cost of pairing up here against a lower bound of the cost further down.
+//	- On the way back up each ancestor tries swapping a child with a grandchild on the other side,
+//	  taking the swap that shrinks the reshaped child most. This keeps the tree shallow without an explicit balance factor.
+//
+// Proxy ids are node indices; they stay valid until DestroyProxy(), whatever happens to the tree around them.
+// Query results are proxy ids, in no particular order.
+
+export namespace Lumina {
+	INLINE_NAMESPACE_MATH_BEGIN
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	class AABBTree {
+	public:
+		using Point = std::conditional_t<(N_Dims == 2U), Vec2, Vec3>;
+
+		struct Box {
+			Point Min;
+			Point Max;
+		};
+
+		static constexpr uint32_t Invalid{ 0xFFFFFFFFU };
+		static constexpr float DefaultMargin{ 0.1f };
+		// How many frames of displacement the fat box looks ahead.
+		static constexpr float Prediction{ 4.0f };
+
+	private:
+		struct Node {
+			Box Bounds;
+			// Doubles as the next free node while on the free list.
+			uint32_t Parent;
+			uint32_t Child1;
+			uint32_t Child2;
+			// 0 for leaves, Invalid for free nodes.
+			uint32_t Height;
+			uint32_t UserData;
+		};
+
+		//----	------	------	------	------	----//
+
+	public:
+		uint32_t CreateProxy(Box const& box_, uint32_t userData_);
+		void DestroyProxy(uint32_t proxy_);
+		// displacement_ is how far the object moved since the last call. Returns true if the proxy was reinserted.
+		bool MoveProxy(uint32_t proxy_, Box const& box_, Point const& displacement_);
+		void Clear() noexcept;
+
+		Box const& FatBounds(uint32_t proxy_) const noexcept { return Nodes_[proxy_].Bounds; }
+		uint32_t UserData(uint32_t proxy_) const noexcept { return Nodes_[proxy_].UserData; }
+
+	public:
+		uint32_t Num_Proxies() const noexcept { return Num_Proxies_; }
+		uint32_t Height() const noexcept { return (Root_ == Invalid) ? 0U : Nodes_[Root_].Height; }
+		// Total area of the internal nodes over the area of the root: the surface area heuristic's measure of the tree.
+		float AreaRatio() const noexcept;
+		// Checks links, heights and enclosure of every node; for tests.
+		bool Validate() const;
+
+		//----	------	------	------	------	----//
+
+	public:
+		// Calls visit_(proxy) for every fat box overlapping region_.
+		template<typename T_Visit>
+		void Query(Box const& region_, T_Visit&& visit_) const;
+
+		// Casts origin_ + t * direction_ for t in [0, maxT_]. visit_(proxy, maxT) is called for every fat box the ray enters
+		// and returns the new maxT: the hit distance to clip the ray there, maxT to go on, or 0 to stop.
+		template<typename T_Visit>
+		void RayCast(Point const& origin_, Point const& direction_, float maxT_, T_Visit&& visit_) const;
+
+		// Calls visit_(proxyA, proxyB) once for every pair of overlapping fat boxes, with proxyA < proxyB.
+		template<typename T_Visit>
+		void QueryPairs(T_Visit&& visit_) const;
+
+		//----	------	------	------	------	----//
+
+	public:
+		static bool Overlaps(Box const& lhs_, Box const& rhs_) noexcept;
+		static bool Contains(Box const& outer_, Box const& inner_) noexcept;
+		static Box Union(Box const& lhs_, Box const& rhs_) noexcept;
+		// Perimeter in 2D and surface area in 3D, both halved.
+		static float Area(Box const& box_) noexcept;
+
+	private:
+		bool IsLeaf(uint32_t idx_) const noexcept { return Nodes_[idx_].Child1 == Invalid; }
+
+		uint32_t AllocateNode();
+		void FreeNode(uint32_t idx_) noexcept;
+
+		void InsertLeaf(uint32_t leaf_);
+		void RemoveLeaf(uint32_t leaf_);
+		// Refits and rotates every node from idx_ to the root.
+		void Ascend(uint32_t idx_);
+		void Rotate(uint32_t idx_);
+		void Refit(uint32_t idx_) noexcept;
+
+		Box Fatten(Box const& box_, Point const& displacement_) const noexcept;
+
+	public:
+		explicit AABBTree(float margin_ = DefaultMargin) : Margin_{ margin_ } {}
+
+		//====	======	======	======	======	====//
+
+	private:
+		std::vector<Node> Nodes_{};
+		uint32_t Root_{ Invalid };
+		uint32_t FreeList_{ Invalid };
+		uint32_t Num_Proxies_{ 0U };
+
+		float Margin_;
+	};
+
+	//----	------	------	------	------	----//
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	uint32_t AABBTree<N_Dims>::CreateProxy(Box const& box_, uint32_t userData_) {
+		uint32_t const leaf{ AllocateNode() };
+		Node& node{ Nodes_[leaf] };
+		node.Bounds = Fatten(box_, Point{});
+		node.Height = 0U;
+		node.UserData = userData_;
+		InsertLeaf(leaf);
+		++Num_Proxies_;
+		return leaf;
+	}
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	void AABBTree<N_Dims>::DestroyProxy(uint32_t proxy_) {
+		RemoveLeaf(proxy_);
+		FreeNode(proxy_);
+		--Num_Proxies_;
+	}
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	bool AABBTree<N_Dims>::MoveProxy(uint32_t proxy_, Box const& box_, Point const& displacement_) {
+		Box const& bounds{ Nodes_[proxy_].Bounds };
+		if (Contains(bounds, box_)) {
+			// Still inside, unless the fat box has grown far past what the object now needs (it stopped after a dash).
+			Box huge{ box_ };
+			for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+				float const reach{ 4.0f * Margin_ + Prediction * std::abs(displacement_[idx_Dim]) };
+				huge.Min[idx_Dim] -= reach;
+				huge.Max[idx_Dim] += reach;
+			}
+			if (Contains(huge, bounds)) { return false; }
+		}
+
+		RemoveLeaf(proxy_);
+		Nodes_[proxy_].Bounds = Fatten(box_, displacement_);
+		InsertLeaf(proxy_);
+		return true;
+	}
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	void AABBTree<N_Dims>::Clear() noexcept {
+		Nodes_.clear();
+		Root_ = Invalid;
+		FreeList_ = Invalid;
+		Num_Proxies_ = 0U;
+	}
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	float AABBTree<N_Dims>::AreaRatio() const noexcept {
+		if (Root_ == Invalid || IsLeaf(Root_)) { return 0.0f; }
+
+		float area_Total{ 0.0f };
+		for (auto const& node : Nodes_) {
+			if (node.Height != Invalid && node.Height > 0U) { area_Total += Area(node.Bounds); }
+		}
+		return area_Total / Area(Nodes_[Root_].Bounds);
+	}
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	bool AABBTree<N_Dims>::Validate() const {
+		if (Root_ == Invalid) { return Num_Proxies_ == 0U; }
+		if (Nodes_[Root_].Parent != Invalid) { return false; }
+
+		uint32_t num_Leaves{ 0U };
+		uint32_t num_Nodes{ 0U };
+		SmallVector<uint32_t, 64U> stack{};
+		stack.push_back(Root_);
+		while (!stack.empty()) {
+			uint32_t const idx{ stack.back() };
+			stack.pop_back();
+			++num_Nodes;
+
+			Node const& node{ Nodes_[idx] };
+			if (IsLeaf(idx)) {
+				if (node.Height != 0U) { return false; }
+				++num_Leaves;
+				continue;
+			}
+			Node const& child1{ Nodes_[node.Child1] };
+			Node const& child2{ Nodes_[node.Child2] };
+			if (child1.Parent != idx || child2.Parent != idx) { return false; }
+			if (node.Height != 1U + std::max(child1.Height, child2.Height)) { return false; }
+			if (!Contains(node.Bounds, child1.Bounds) || !Contains(node.Bounds, child2.Bounds)) { return false; }
+			stack.push_back(node.Child1);
+			stack.push_back(node.Child2);
+		}
+
+		uint32_t num_Free{ 0U };
+		for (uint32_t idx{ FreeList_ }; idx != Invalid; idx = Nodes_[idx].Parent) { ++num_Free; }
+		return num_Leaves == Num_Proxies_ && num_Nodes == 2U * num_Leaves - 1U && num_Nodes + num_Free == Nodes_.size();
+	}
+
+	//----	------	------	------	------	----//
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	template<typename T_Visit>
+	void AABBTree<N_Dims>::Query(Box const& region_, T_Visit&& visit_) const {
+		if (Root_ == Invalid) { return; }
+
+		SmallVector<uint32_t, 64U> stack{};
+		stack.push_back(Root_);
+		while (!stack.empty()) {
+			uint32_t const idx{ stack.back() };
+			stack.pop_back();
+
+			Node const& node{ Nodes_[idx] };
+			if (!Overlaps(node.Bounds, region_)) { continue; }
+			if (node.Child1 == Invalid) {
+				visit_(idx);
+			}
+			else {
+				stack.push_back(node.Child1);
+				stack.push_back(node.Child2);
+			}
+		}
+	}
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	template<typename T_Visit>
+	void AABBTree<N_Dims>::RayCast(Point const& origin_, Point const& direction_, float maxT_, T_Visit&& visit_) const {
+		if (Root_ == Invalid) { return; }
+
+		Point invDirection{};
+		for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+			invDirection[idx_Dim] = (direction_[idx_Dim] != 0.0f) ? 1.0f / direction_[idx_Dim] : 0.0f;
+		}
+		// Slab test; an axis the ray runs parallel to only needs the origin inside the slab.
+		auto const isHit{
+			[&] (Box const& box_, float maxT_Current_) {
+				float t_Enter{ 0.0f };
+				float t_Exit{ maxT_Current_ };
+				for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+					if (direction_[idx_Dim] == 0.0f) {
+						if (origin_[idx_Dim] < box_.Min[idx_Dim] || origin_[idx_Dim] > box_.Max[idx_Dim]) { return false; }
+						continue;
+					}
+					float t1{ (box_.Min[idx_Dim] - origin_[idx_Dim]) * invDirection[idx_Dim] };
+					float t2{ (box_.Max[idx_Dim] - origin_[idx_Dim]) * invDirection[idx_Dim] };
+					if (t1 > t2) { std::swap(t1, t2); }
+					t_Enter = std::max(t_Enter, t1);
+					t_Exit = std::min(t_Exit, t2);
+					if (t_Enter > t_Exit) { return false; }
+				}
+				return true;
+			}
+		};
+
+		float maxT{ maxT_ };
+		SmallVector<uint32_t, 64U> stack{};
+		stack.push_back(Root_);
+		while (!stack.empty() && maxT > 0.0f) {
+			uint32_t const idx{ stack.back() };
+			stack.pop_back();
+
+			Node const& node{ Nodes_[idx] };
+			if (!isHit(node.Bounds, maxT)) { continue; }
+			if (node.Child1 == Invalid) {
+				maxT = std::min(maxT, static_cast<float>(visit_(idx, maxT)));
+			}
+			else {
+				stack.push_back(node.Child1);
+				stack.push_back(node.Child2);
+			}
+		}
+	}
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	template<typename T_Visit>
+	void AABBTree<N_Dims>::QueryPairs(T_Visit&& visit_) const {
+		if (Root_ == Invalid) { return; }
+
+		// The tree against itself: a node paired with itself splits into its children's self pairs and their cross pair,
+		// so that every two leaves meet in exactly one pair of subtrees, and disjoint subtrees are never descended into.
+		SmallVector<std::pair<uint32_t, uint32_t>, 64U> stack{};
+		stack.emplace_back(Root_, Root_);
+		while (!stack.empty()) {
+			auto const [idx_A, idx_B] { stack.back() };
+			stack.pop_back();
+
+			Node const& a{ Nodes_[idx_A] };
+			Node const& b{ Nodes_[idx_B] };
+			if (idx_A == idx_B) {
+				if (a.Child1 == Invalid) { continue; }
+				stack.emplace_back(a.Child1, a.Child1);
+				stack.emplace_back(a.Child2, a.Child2);
+				stack.emplace_back(a.Child1, a.Child2);
+				continue;
+			}
+			if (!Overlaps(a.Bounds, b.Bounds)) { continue; }
+
+			if (a.Child1 == Invalid && b.Child1 == Invalid) {
+				visit_(std::min(idx_A, idx_B), std::max(idx_A, idx_B));
+			}
+			// Descend into the larger of the two.
+			else if (b.Child1 == Invalid || (a.Child1 != Invalid && Area(a.Bounds) > Area(b.Bounds))) {
+				stack.emplace_back(a.Child1, idx_B);
+				stack.emplace_back(a.Child2, idx_B);
+			}
+			else {
+				stack.emplace_back(idx_A, b.Child1);
+				stack.emplace_back(idx_A, b.Child2);
+			}
+		}
+	}
+
+	//----	------	------	------	------	----//
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	bool AABBTree<N_Dims>::Overlaps(Box const& lhs_, Box const& rhs_) noexcept {
+		for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+			if (lhs_.Max[idx_Dim] < rhs_.Min[idx_Dim] || rhs_.Max[idx_Dim] < lhs_.Min[idx_Dim]) { return false; }
+		}
+		return true;
+	}
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	bool AABBTree<N_Dims>::Contains(Box const& outer_, Box const& inner_) noexcept {
+		for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+			if (inner_.Min[idx_Dim] < outer_.Min[idx_Dim] || inner_.Max[idx_Dim] > outer_.Max[idx_Dim]) { return false; }
+		}
+		return true;
+	}
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	typename AABBTree<N_Dims>::Box AABBTree<N_Dims>::Union(Box const& lhs_, Box const& rhs_) noexcept {
+		Box box{};
+		for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+			box.Min[idx_Dim] = std::min(lhs_.Min[idx_Dim], rhs_.Min[idx_Dim]);
+			box.Max[idx_Dim] = std::max(lhs_.Max[idx_Dim], rhs_.Max[idx_Dim]);
+		}
+		return box;
+	}
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	float AABBTree<N_Dims>::Area(Box const& box_) noexcept {
+		float const dx{ box_.Max[0] - box_.Min[0] };
+		float const dy{ box_.Max[1] - box_.Min[1] };
+		if constexpr (N_Dims == 2U) {
+			return dx + dy;
+		}
+		else {
+			float const dz{ box_.Max[2] - box_.Min[2] };
+			return dx * dy + dy * dz + dz * dx;
+		}
+	}
+
+	//----	------	------	------	------	----//
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	uint32_t AABBTree<N_Dims>::AllocateNode() {
+		uint32_t idx{ FreeList_ };
+		if (idx != Invalid) {
+			FreeList_ = Nodes_[idx].Parent;
+		}
+		else {
+			idx = static_cast<uint32_t>(Nodes_.size());
+			Nodes_.emplace_back();
+		}
+		Nodes_[idx] = Node{ {}, Invalid, Invalid, Invalid, 0U, 0U };
+		return idx;
+	}
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	void AABBTree<N_Dims>::FreeNode(uint32_t idx_) noexcept {
+		Nodes_[idx_].Parent = FreeList_;
+		Nodes_[idx_].Height = Invalid;
+		FreeList_ = idx_;
+	}
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	void AABBTree<N_Dims>::InsertLeaf(uint32_t leaf_) {
+		if (Root_ == Invalid) {
+			Root_ = leaf_;
+			Nodes_[leaf_].Parent = Invalid;
+			return;
+		}
+
+		// Pairing the leaf with a node costs the area of their union, plus the growth of every ancestor on the way down.
+		// Descending further costs at least that growth again, so stop once both children cost more than pairing here.
+		Box const bounds_Leaf{ Nodes_[leaf_].Bounds };
+		uint32_t sibling{ Root_ };
+		while (!IsLeaf(sibling)) {
+			Node const& node{ Nodes_[sibling] };
+			float const area{ Area(node.Bounds) };
+			float const area_Combined{ Area(Union(node.Bounds, bounds_Leaf)) };
+			float const cost{ 2.0f * area_Combined };
+			float const cost_Inherited{ 2.0f * (area_Combined - area) };
+
+			auto const descentCost{
+				[&] (uint32_t idx_Child_) {
+					Node const& child{ Nodes_[idx_Child_] };
+					float const area_Union{ Area(Union(child.Bounds, bounds_Leaf)) };
+					return (child.Child1 == Invalid ? area_Union : area_Union - Area(child.Bounds)) + cost_Inherited;
+				}
+			};
+			float const cost1{ descentCost(node.Child1) };
+			float const cost2{ descentCost(node.Child2) };
+			if (cost < cost1 && cost < cost2) { break; }
+			sibling = (cost1 < cost2) ? node.Child1 : node.Child2;
+		}
+
+		uint32_t const parent_Old{ Nodes_[sibling].Parent };
+		uint32_t const parent_New{ AllocateNode() };
+		{
+			Node& node{ Nodes_[parent_New] };
+			node.Parent = parent_Old;
+			node.Bounds = Union(bounds_Leaf, Nodes_[sibling].Bounds);
+			node.Child1 = sibling;
+			node.Child2 = leaf_;
+			node.Height = Nodes_[sibling].Height + 1U;
+		}
+		Nodes_[sibling].Parent = parent_New;
+		Nodes_[leaf_].Parent = parent_New;
+
+		if (parent_Old == Invalid) {
+			Root_ = parent_New;
+			return;
+		}
+		Node& node_Old{ Nodes_[parent_Old] };
+		(node_Old.Child1 == sibling ? node_Old.Child1 : node_Old.Child2) = parent_New;
+		Ascend(parent_Old);
+	}
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	void AABBTree<N_Dims>::RemoveLeaf(uint32_t leaf_) {
+		if (leaf_ == Root_) {
+			Root_ = Invalid;
+			return;
+		}
+
+		uint32_t const parent{ Nodes_[leaf_].Parent };
+		uint32_t const grandParent{ Nodes_[parent].Parent };
+		uint32_t const sibling{ (Nodes_[parent].Child1 == leaf_) ? Nodes_[parent].Child2 : Nodes_[parent].Child1 };
+		FreeNode(parent);
+
+		Nodes_[sibling].Parent = grandParent;
+		if (grandParent == Invalid) {
+			Root_ = sibling;
+			return;
+		}
+		Node& node{ Nodes_[grandParent] };
+		(node.Child1 == parent ? node.Child1 : node.Child2) = sibling;
+		Ascend(grandParent);
+	}
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	void AABBTree<N_Dims>::Ascend(uint32_t idx_) {
+		for (; idx_ != Invalid; idx_ = Nodes_[idx_].Parent) {
+			Refit(idx_);
+			Rotate(idx_);
+		}
+	}
+
+	// With children B (D, E) and C (F, G), the candidates are B <-> F, B <-> G, C <-> D and C <-> E.
+	// A's own box is the same either way; only the child that takes the swapped-in node changes shape.
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	void AABBTree<N_Dims>::Rotate(uint32_t idx_) {
+		Node const& a{ Nodes_[idx_] };
+		uint32_t const b{ a.Child1 };
+		uint32_t const c{ a.Child2 };
+
+		// The best swap found: the node moving down (into inner) and the grandchild of inner moving up.
+		uint32_t down{ Invalid };
+		uint32_t up{ Invalid };
+		uint32_t inner{ Invalid };
+		float gain_Best{ 0.0f };
+
+		auto const consider{
+			[&] (uint32_t down_, uint32_t inner_) {
+				Node const& node_Inner{ Nodes_[inner_] };
+				if (node_Inner.Child1 == Invalid) { return; }
+				float const area{ Area(node_Inner.Bounds) };
+				// Swapping down_ with one grandchild leaves inner_ holding down_ and the other grandchild.
+				float const gain1{ area - Area(Union(Nodes_[down_].Bounds, Nodes_[node_Inner.Child2].Bounds)) };
+				float const gain2{ area - Area(Union(Nodes_[down_].Bounds, Nodes_[node_Inner.Child1].Bounds)) };
+				if (gain1 > gain_Best) {
+					gain_Best = gain1;
+					down = down_;
+					up = node_Inner.Child1;
+					inner = inner_;
+				}
+				if (gain2 > gain_Best) {
+					gain_Best = gain2;
+					down = down_;
+					up = node_Inner.Child2;
+					inner = inner_;
+				}
+			}
+		};
+		consider(b, c);
+		consider(c, b);
+		if (down == Invalid) { return; }
+
+		Node& node_A{ Nodes_[idx_] };
+		(node_A.Child1 == down ? node_A.Child1 : node_A.Child2) = up;
+		Nodes_[up].Parent = idx_;
+
+		Node& node_Inner{ Nodes_[inner] };
+		(node_Inner.Child1 == up ? node_Inner.Child1 : node_Inner.Child2) = down;
+		Nodes_[down].Parent = inner;
+
+		Refit(inner);
+		Refit(idx_);
+	}
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	void AABBTree<N_Dims>::Refit(uint32_t idx_) noexcept {
+		Node& node{ Nodes_[idx_] };
+		Node const& child1{ Nodes_[node.Child1] };
+		Node const& child2{ Nodes_[node.Child2] };
+		node.Bounds = Union(child1.Bounds, child2.Bounds);
+		node.Height = 1U + std::max(child1.Height, child2.Height);
+	}
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	typename AABBTree<N_Dims>::Box AABBTree<N_Dims>::Fatten(Box const& box_, Point const& displacement_) const noexcept {
+		Box fat{ box_ };
+		for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+			fat.Min[idx_Dim] -= Margin_;
+			fat.Max[idx_Dim] += Margin_;
+			float const d{ Prediction * displacement_[idx_Dim] };
+			(d < 0.0f ? fat.Min[idx_Dim] : fat.Max[idx_Dim]) += d;
+		}
+		return fat;
+	}
+
+	INLINE_NAMESPACE_MATH_END
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+export module Lumina.Math.Bounds;
+
+//****	******	******	******	******	****//
+
+import <cmath>;
+
+import <algorithm>;
+
+import Lumina.Math.Vector;
+
+//////	//////	//////	//////	//////	//////
+
+#define INLINE_NAMESPACE_MATH_BEGIN		inline namespace Math {
+#define INLINE_NAMESPACE_MATH_END		}
+
+//****	******	******	******	******	****//
+
+//////	//////	//////	//////	//////	//////
+//	AABB									//
+//////	//////	//////	//////	//////	//////
+
+export namespace Lumina {
+	INLINE_NAMESPACE_MATH_BEGIN
+
+	// Axis-aligned box stored as center and half extent, which is what plane tests consume.
+	struct AABB {
+		Vec3 Center;
+		Vec3 Extent;
+
+		static AABB FromMinMax(Vec3 const& min_, Vec3 const& max_) noexcept {
+			return AABB{
+				.Center{ (min_ + max_) * 0.5f },
+				.Extent{ (max_ - min_) * 0.5f },
+			};
+		}
+
+		Vec3 Min() const noexcept { return Center - Extent; }
+		Vec3 Max() const noexcept { return Center + Extent; }
+
+		static AABB Merge(AABB const& lhs_, AABB const& rhs_) noexcept {
+			Vec3 const min_LHS{ lhs_.Min() }, max_LHS{ lhs_.Max() };
+			Vec3 const min_RHS{ rhs_.Min() }, max_RHS{ rhs_.Max() };
+			return FromMinMax(
+				{ std::min(min_LHS.x, min_RHS.x), std::min(min_LHS.y, min_RHS.y), std::min(min_LHS.z, min_RHS.z) },
+				{ std::max(max_LHS.x, max_RHS.x), std::max(max_LHS.y, max_RHS.y), std::max(max_LHS.z, max_RHS.z) }
+			);
+		}
+
+		bool Overlaps(AABB const& rhs_) const noexcept {
+			return
+				std::abs(Center.x - rhs_.Center.x) <= Extent.x + rhs_.Extent.x &&
+				std::abs(Center.y - rhs_.Center.y) <= Extent.y + rhs_.Extent.y &&
+				std::abs(Center.z - rhs_.Center.z) <= Extent.z + rhs_.Extent.z;
+		}
+	};
+
+	INLINE_NAMESPACE_MATH_END
+}
+
+//////	//////	//////	//////	//////	//////
+//	Sphere									//
+//////	//////	//////	//////	//////	//////
+
+export namespace Lumina {
+	INLINE_NAMESPACE_MATH_BEGIN
+
+	struct Sphere {
+		Vec3 Center;
+		float Radius;
+
+		AABB Bounds() const noexcept {
+			return AABB{
+				.Center{ Center },
+				.Extent{ Radius, Radius, Radius },
+			};
+		}
+	};
+
+	INLINE_NAMESPACE_MATH_END
+}
+
+//////	//////	//////	//////	//////	//////
+//	Rect2D									//
+//////	//////	//////	//////	//////	//////
+
+export namespace Lumina {
+	INLINE_NAMESPACE_MATH_BEGIN
+
+	// Region on an XY plane, e.g. the part of the world a camera sees at the depth of a 2D scene.
+	struct Rect2D {
+		float MinX;
+		float MinY;
+		float MaxX;
+		float MaxY;
+
+		bool IsEmpty() const noexcept { return (MinX > MaxX) || (MinY > MaxY); }
+
+		bool Overlaps(AABB const& box_) const noexcept {
+			return
+				box_.Center.x + box_.Extent.x >= MinX && box_.Center.x - box_.Extent.x <= MaxX &&
+				box_.Center.y + box_.Extent.y >= MinY && box_.Center.y - box_.Extent.y <= MaxY;
+		}
+	};
+
+	INLINE_NAMESPACE_MATH_END
+}
\ No newline at end of file
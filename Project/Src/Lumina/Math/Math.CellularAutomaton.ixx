@@ -0,0 +1,300 @@
+module;
+
+#include<immintrin.h>
+
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+
+export module Lumina.Math.CellularAutomaton;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cassert>;
+import <cstring>;
+
+import <vector>;
+import <utility>;
+
+//////	//////	//////	//////	//////	//////
+
+#define INLINE_NAMESPACE_MATH_BEGIN		inline namespace Math {
+#define INLINE_NAMESPACE_MATH_END		}
+
+//****	******	******	******	******	****//
+
+// Life-like cellular automata on grids of one bit per cell, stepped synchronously into a second buffer.
+//
+//	- Column x of a row is bit x % 64 of its word x / 64. Rows are padded to a multiple of four words,
+//	  with a zero guard word on either side, so that the kernels read the neighbouring words without bounds checks.
+//	- Neighbour counts are bit-sliced: the eight neighbours of a whole word of cells are summed at once by full adders
+//	  over the rows above, beside and below shifted by one cell, into four bit planes of the count.
+//	  The rule is then logic on those planes; nothing is counted cell by cell.
+//	- The AVX2 kernel does the same on four words, 256 cells, per iteration.
+//	- Cells on the edge of the grid have no full neighbourhood and keep their state.
+
+//////	//////	//////	//////	//////	//////
+//	CellularAutomaton						//
+//////	//////	//////	//////	//////	//////
+
+export namespace Lumina {
+	INLINE_NAMESPACE_MATH_BEGIN
+
+	// Bit n of Birth: a dead cell with n live neighbours comes alive. Bit n of Survival: a live one with n stays alive.
+	struct AutomatonRule {
+		uint16_t Birth;
+		uint16_t Survival;
+
+		// Cave smoothing, walls being the live cells: more than threshold_ walls around makes a wall, fewer makes a floor.
+		static constexpr AutomatonRule Caves(uint32_t threshold_ = 4U) noexcept {
+			uint16_t const atLeast{ static_cast<uint16_t>(0x1FFU & ~((1U << threshold_) - 1U)) };
+			return AutomatonRule{
+				.Birth{ static_cast<uint16_t>(atLeast & ~(1U << threshold_)) },
+				.Survival{ atLeast },
+			};
+		}
+	};
+
+	enum class INSTRUCTION_SET : uint8_t {
+		SCALAR,
+		AVX2,
+	};
+
+	class BitGrid {
+	public:
+		bool operator()(uint32_t x_, uint32_t y_) const noexcept {
+			assert(x_ < Width_ && y_ < Height_);
+			return (Row(y_)[x_ >> 6U] >> (x_ & 63U)) & 1LLU;
+		}
+		void Set(uint32_t x_, uint32_t y_, bool isAlive_) noexcept {
+			assert(x_ < Width_ && y_ < Height_);
+			uint64_t& word{ Row(y_)[x_ >> 6U] };
+			uint64_t const bit{ 1LLU << (x_ & 63U) };
+			word = isAlive_ ? (word | bit) : (word & ~bit);
+		}
+
+		// Num_Words() words; bits past Width() are zero.
+		uint64_t* Row(uint32_t y_) noexcept { return Words_.data() + static_cast<size_t>(y_) * Stride_ + 1LLU; }
+		uint64_t const* Row(uint32_t y_) const noexcept { return Words_.data() + static_cast<size_t>(y_) * Stride_ + 1LLU; }
+
+		bool operator==(BitGrid const& rhs_) const noexcept = default;
+
+	public:
+		uint32_t Width() const noexcept { return Width_; }
+		uint32_t Height() const noexcept { return Height_; }
+		// Words per row, padding included.
+		uint32_t Num_Words() const noexcept { return Num_Words_; }
+
+		// Every cell dead.
+		void Resize(uint32_t width_, uint32_t height_) {
+			Width_ = width_;
+			Height_ = height_;
+			Num_Words_ = (((Width_ + 63U) >> 6U) + 3U) & ~3U;
+			Stride_ = Num_Words_ + 2U;
+			Words_.assign(static_cast<size_t>(Stride_) * Height_, 0LLU);
+		}
+
+	public:
+		BitGrid() = default;
+		BitGrid(uint32_t width_, uint32_t height_) { Resize(width_, height_); }
+
+		//====	======	======	======	======	====//
+
+	private:
+		std::vector<uint64_t> Words_{};
+		uint32_t Width_{ 0U };
+		uint32_t Height_{ 0U };
+		uint32_t Num_Words_{ 0U };
+		uint32_t Stride_{ 0U };
+	};
+
+	class CellularAutomaton {
+	public:
+		// Steps every cell at once, num_Steps_ times.
+		void Step(AutomatonRule const& rule_, uint32_t num_Steps_ = 1U, INSTRUCTION_SET instructionSet_ = INSTRUCTION_SET::AVX2);
+
+	public:
+		// The current generation; stepping swaps buffers, so take it again afterwards.
+		BitGrid& Grid() noexcept { return Current_; }
+		BitGrid const& Grid() const noexcept { return Current_; }
+
+		// Every cell dead.
+		void Resize(uint32_t width_, uint32_t height_);
+
+		//====	======	======	======	======	====//
+
+	private:
+		BitGrid Current_{};
+		BitGrid Next_{};
+		// Set for the cells a step may change: neither on the edge of the grid nor past its width.
+		std::vector<uint64_t> Interior_{};
+	};
+
+	INLINE_NAMESPACE_MATH_END
+}
+
+//////	//////	//////	//////	//////	//////
+//	Kernels									//
+//////	//////	//////	//////	//////	//////
+
+namespace Lumina {
+	INLINE_NAMESPACE_MATH_BEGIN
+
+	namespace {
+		struct Scalar {
+			using Lane = uint64_t;
+			static constexpr uint32_t Num_Words{ 1U };
+
+			static Lane Load(uint64_t const* words_) noexcept { return *words_; }
+			static void Store(uint64_t* words_, Lane lane_) noexcept { *words_ = lane_; }
+			static Lane Broadcast(uint64_t word_) noexcept { return word_; }
+
+			static Lane And(Lane lhs_, Lane rhs_) noexcept { return lhs_ & rhs_; }
+			static Lane Or(Lane lhs_, Lane rhs_) noexcept { return lhs_ | rhs_; }
+			static Lane Xor(Lane lhs_, Lane rhs_) noexcept { return lhs_ ^ rhs_; }
+			static Lane Not(Lane lane_) noexcept { return ~lane_; }
+
+			// Each cell's west neighbour in its place: the row moved up a bit, with the top bit of the word before carried in.
+			static Lane West(uint64_t const* words_) noexcept { return (words_[0] << 1U) | (words_[-1] >> 63U); }
+			static Lane East(uint64_t const* words_) noexcept { return (words_[0] >> 1U) | (words_[1] << 63U); }
+		};
+
+		struct AVX2 {
+			using Lane = __m256i;
+			static constexpr uint32_t Num_Words{ 4U };
+
+			static Lane Load(uint64_t const* words_) noexcept { return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(words_)); }
+			static void Store(uint64_t* words_, Lane lane_) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(words_), lane_); }
+			static Lane Broadcast(uint64_t word_) noexcept { return _mm256_set1_epi64x(static_cast<long long>(word_)); }
+
+			static Lane And(Lane lhs_, Lane rhs_) noexcept { return _mm256_and_si256(lhs_, rhs_); }
+			static Lane Or(Lane lhs_, Lane rhs_) noexcept { return _mm256_or_si256(lhs_, rhs_); }
+			static Lane Xor(Lane lhs_, Lane rhs_) noexcept { return _mm256_xor_si256(lhs_, rhs_); }
+			static Lane Not(Lane lane_) noexcept { return _mm256_xor_si256(lane_, _mm256_set1_epi64x(-1LL)); }
+
+			// The words before and after come from unaligned loads one word off, so each lane carries in from its own neighbour.
+			static Lane West(uint64_t const* words_) noexcept {
+				return _mm256_or_si256(_mm256_slli_epi64(Load(words_), 1), _mm256_srli_epi64(Load(words_ - 1), 63));
+			}
+			static Lane East(uint64_t const* words_) noexcept {
+				return _mm256_or_si256(_mm256_srli_epi64(Load(words_), 1), _mm256_slli_epi64(Load(words_ + 1), 63));
+			}
+		};
+
+		template<typename T_Kernel>
+		void StepInterior(BitGrid const& src_, BitGrid& dst_, uint64_t const* interior_, AutomatonRule const& rule_) noexcept {
+			using K = T_Kernel;
+			using Lane = typename K::Lane;
+
+			// For every neighbour count the rule cares about, what a cell with that count becomes:
+			// (cell & (Birth ^ Survival)) ^ Birth, with each flag widened to a whole lane.
+			struct Term {
+				uint32_t Count;
+				Lane Birth;
+				Lane Difference;
+			};
+			Term terms[9]{};
+			uint32_t num_Terms{ 0U };
+			for (uint32_t count{ 0U }; count <= 8U; ++count) {
+				bool const isBirth{ ((rule_.Birth >> count) & 1U) != 0U };
+				bool const isSurvival{ ((rule_.Survival >> count) & 1U) != 0U };
+				if (!isBirth && !isSurvival) { continue; }
+				terms[num_Terms++] = {
+					count,
+					K::Broadcast(isBirth ? ~0LLU : 0LLU),
+					K::Broadcast((isBirth != isSurvival) ? ~0LLU : 0LLU),
+				};
+			}
+
+			// (a & b) | (c & (a ^ b)): the carry of a full adder.
+			auto const majority{ [] (Lane a_, Lane b_, Lane c_) { return K::Or(K::And(a_, b_), K::And(c_, K::Xor(a_, b_))); } };
+
+			for (uint32_t y{ 1U }; y + 1U < src_.Height(); ++y) {
+				uint64_t const* const rowAbove{ src_.Row(y - 1U) };
+				uint64_t const* const row{ src_.Row(y) };
+				uint64_t const* const rowBelow{ src_.Row(y + 1U) };
+				uint64_t* const rowNext{ dst_.Row(y) };
+
+				for (uint32_t i{ 0U }; i < src_.Num_Words(); i += K::Num_Words) {
+					// Two-bit sums of the three cells above, the three below and the two beside.
+					Lane const above{ K::Load(rowAbove + i) };
+					Lane const aboveW{ K::West(rowAbove + i) };
+					Lane const aboveE{ K::East(rowAbove + i) };
+					Lane const above0{ K::Xor(K::Xor(aboveW, above), aboveE) };
+					Lane const above1{ majority(aboveW, above, aboveE) };
+
+					Lane const below{ K::Load(rowBelow + i) };
+					Lane const belowW{ K::West(rowBelow + i) };
+					Lane const belowE{ K::East(rowBelow + i) };
+					Lane const below0{ K::Xor(K::Xor(belowW, below), belowE) };
+					Lane const below1{ majority(belowW, below, belowE) };
+
+					Lane const cell{ K::Load(row + i) };
+					Lane const west{ K::West(row + i) };
+					Lane const east{ K::East(row + i) };
+					Lane const beside0{ K::Xor(west, east) };
+					Lane const beside1{ K::And(west, east) };
+
+					// Their total, 0 to 8, as bit planes of weight 1, 2, 4 and 8.
+					Lane const count0{ K::Xor(K::Xor(above0, below0), beside0) };
+					Lane const carry0{ majority(above0, below0, beside0) };
+					Lane const sum1{ K::Xor(K::Xor(above1, below1), beside1) };
+					Lane const carry1{ majority(above1, below1, beside1) };
+					Lane const count1{ K::Xor(sum1, carry0) };
+					Lane const carry2{ K::And(sum1, carry0) };
+					Lane const count2{ K::Xor(carry1, carry2) };
+					Lane const count3{ K::And(carry1, carry2) };
+
+					Lane const planes[2][4]{
+						{ K::Not(count0), K::Not(count1), K::Not(count2), K::Not(count3) },
+						{ count0, count1, count2, count3 },
+					};
+					Lane next{ K::Broadcast(0LLU) };
+					for (uint32_t idx_Term{ 0U }; idx_Term < num_Terms; ++idx_Term) {
+						Term const& term{ terms[idx_Term] };
+						Lane const isCount{
+							K::And(
+								K::And(planes[term.Count & 1U][0], planes[(term.Count >> 1U) & 1U][1]),
+								K::And(planes[(term.Count >> 2U) & 1U][2], planes[(term.Count >> 3U) & 1U][3])
+							)
+						};
+						next = K::Or(next, K::And(isCount, K::Xor(K::And(cell, term.Difference), term.Birth)));
+					}
+
+					Lane const interior{ K::Load(interior_ + i) };
+					K::Store(rowNext + i, K::Or(K::And(next, interior), K::And(cell, K::Not(interior))));
+				}
+			}
+		}
+	}
+
+	//----	------	------	------	------	----//
+
+	void CellularAutomaton::Step(AutomatonRule const& rule_, uint32_t num_Steps_, INSTRUCTION_SET instructionSet_) {
+		uint32_t const height{ Current_.Height() };
+		if (height == 0U) { return; }
+
+		for (uint32_t step{ 0U }; step < num_Steps_; ++step) {
+			if (instructionSet_ == INSTRUCTION_SET::AVX2) { StepInterior<AVX2>(Current_, Next_, Interior_.data(), rule_); }
+			else { StepInterior<Scalar>(Current_, Next_, Interior_.data(), rule_); }
+
+			// The first and last rows are all edge.
+			size_t const rowSize{ sizeof(uint64_t) * Current_.Num_Words() };
+			std::memcpy(Next_.Row(0U), Current_.Row(0U), rowSize);
+			std::memcpy(Next_.Row(height - 1U), Current_.Row(height - 1U), rowSize);
+
+			std::swap(Current_, Next_);
+		}
+	}
+
+	void CellularAutomaton::Resize(uint32_t width_, uint32_t height_) {
+		Current_.Resize(width_, height_);
+		Next_.Resize(width_, height_);
+
+		Interior_.assign(Current_.Num_Words(), 0LLU);
+		for (uint32_t x{ 1U }; x + 1U < width_; ++x) { Interior_[x >> 6U] |= 1LLU << (x & 63U); }
+	}
+
+	INLINE_NAMESPACE_MATH_END
+}
\ No newline at end of file
@@ -0,0 +1,289 @@
+export module Lumina.Math.ConnectedComponents;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cassert>;
+
+import <vector>;
+import <algorithm>;
+import <limits>;
+
+import <thread>;
+
+import Lumina.Math.Numerics;
+import Lumina.Container.DisjointSet;
+
+//////	//////	//////	//////	//////	//////
+
+#define INLINE_NAMESPACE_MATH_BEGIN		inline namespace Math {
+#define INLINE_NAMESPACE_MATH_END		}
+
+//****	******	******	******	******	****//
+
+//////	//////	//////	//////	//////	//////
+//	ConnectedComponents						//
+//////	//////	//////	//////	//////	//////
+
+// Two-pass scanline labelling of a grid, with union-find over provisional labels.
+//
+//	- The first pass gives each foreground cell the label of an earlier neighbour (west and north, plus the north
+//	  diagonals with 8-connectivity), a new label if it has none, and unites the labels of neighbours that differ.
+//	- Provisional labels are then resolved to final ones, numbered from 1 in the order a row-major scan first meets
+//	  each component; the same numbering a flood fill started from every unvisited cell gives.
+//	- The second pass rewrites the grid with the final labels and gathers each component's area, bounds and centroid.
+//
+// With num_Strips_ > 1 both passes run on horizontal strips in parallel; strips take disjoint ranges of provisional labels,
+// and are stitched together along their first rows in between. isForeground_ is then called from several threads.
+
+export namespace Lumina {
+	INLINE_NAMESPACE_MATH_BEGIN
+
+	enum class CONNECTIVITY : uint8_t {
+		FOUR,
+		EIGHT,
+	};
+
+	class ConnectedComponents {
+	public:
+		// The label of the cells in no component.
+		static constexpr uint32_t Background{ 0U };
+
+		struct Component {
+			uint32_t Area;
+			// Inclusive bounds, in cells.
+			Int2 Min;
+			Int2 Max;
+			Float2 Centroid;
+		};
+
+	private:
+		struct Accumulator {
+			uint32_t Area{ 0U };
+			Int2 Min{ std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::max() };
+			Int2 Max{ -1, -1 };
+			uint64_t SumX{ 0LLU };
+			uint64_t SumY{ 0LLU };
+		};
+
+		struct Strip {
+			uint32_t RowBegin;
+			uint32_t RowEnd;
+			// Provisional labels of the strip are FirstLabel + 1 .. FirstLabel + Num_Labels.
+			uint32_t FirstLabel;
+			uint32_t Num_Labels;
+		};
+
+		//----	------	------	------	------	----//
+
+	public:
+		template<typename T_IsForeground>
+		void Label(
+			uint32_t width_, uint32_t height_,
+			T_IsForeground const& isForeground_,
+			CONNECTIVITY connectivity_ = CONNECTIVITY::FOUR,
+			uint32_t num_Strips_ = 1U
+		);
+
+	public:
+		uint32_t Width() const noexcept { return Width_; }
+		uint32_t Height() const noexcept { return Height_; }
+		uint32_t Num_Components() const noexcept { return static_cast<uint32_t>(Components_.size()); }
+
+		uint32_t operator()(uint32_t x_, uint32_t y_) const noexcept { return Labels_[y_ * Width_ + x_]; }
+		std::vector<uint32_t> const& Labels() const noexcept { return Labels_; }
+
+		// label_ in 1 .. Num_Components()
+		Component const& operator[](uint32_t label_) const noexcept { return Components_[label_ - 1U]; }
+		std::vector<Component> const& Components() const noexcept { return Components_; }
+
+	private:
+		template<typename T_IsForeground>
+		void LabelStrip(Strip& strip_, T_IsForeground const& isForeground_, CONNECTIVITY connectivity_);
+		// Unites the labels along the first row of a strip with those in the last row of the one above.
+		void StitchStrip(Strip const& strip_, CONNECTIVITY connectivity_);
+		// Maps every provisional label to its final one; sequential, over labels rather than cells.
+		uint32_t Resolve();
+		void RelabelStrip(Strip const& strip_, std::vector<Accumulator>& accumulators_);
+
+		//====	======	======	======	======	====//
+
+	private:
+		std::vector<uint32_t> Labels_{};
+		std::vector<Component> Components_{};
+
+		DisjointSet Provisional_{};
+		std::vector<uint32_t> Finals_{};
+		std::vector<Strip> Strips_{};
+
+		uint32_t Width_{ 0U };
+		uint32_t Height_{ 0U };
+	};
+
+	//----	------	------	------	------	----//
+
+	template<typename T_IsForeground>
+	void ConnectedComponents::Label(
+		uint32_t width_, uint32_t height_,
+		T_IsForeground const& isForeground_,
+		CONNECTIVITY connectivity_,
+		uint32_t num_Strips_
+	) {
+		Width_ = width_;
+		Height_ = height_;
+		Labels_.resize(static_cast<size_t>(Width_) * Height_);
+		Components_.clear();
+		if (Width_ == 0U || Height_ == 0U) { return; }
+
+		// A row starts a new label only after a background cell, so it never needs more than half its width.
+		uint32_t const num_LabelsPerRow{ (Width_ + 1U) / 2U };
+		Provisional_.Resize(Height_ * num_LabelsPerRow + 1U);
+		Finals_.resize(Provisional_.Capacity());
+
+		num_Strips_ = std::clamp(num_Strips_, 1U, Height_);
+		uint32_t const num_RowsPerStrip{ (Height_ + num_Strips_ - 1U) / num_Strips_ };
+		Strips_.clear();
+		for (uint32_t rowBegin{ 0U }; rowBegin < Height_; rowBegin += num_RowsPerStrip) {
+			Strips_.emplace_back(rowBegin, std::min(rowBegin + num_RowsPerStrip, Height_), rowBegin * num_LabelsPerRow, 0U);
+		}
+
+		// Runs work_ on every strip, on the calling thread for the first.
+		auto const forEachStrip{
+			[this] (auto const& work_) {
+				std::vector<std::jthread> workers{};
+				for (uint32_t i{ 1U }; i < static_cast<uint32_t>(Strips_.size()); ++i) {
+					workers.emplace_back([&work_, i] () { work_(i); });
+				}
+				work_(0U);
+			}
+		};
+
+		forEachStrip([&] (uint32_t idx_Strip_) { LabelStrip(Strips_[idx_Strip_], isForeground_, connectivity_); });
+		for (uint32_t i{ 1U }; i < static_cast<uint32_t>(Strips_.size()); ++i) { StitchStrip(Strips_[i], connectivity_); }
+
+		uint32_t const num_Components{ Resolve() };
+
+		std::vector<std::vector<Accumulator>> accumulators(Strips_.size());
+		forEachStrip(
+			[&] (uint32_t idx_Strip_) {
+				accumulators[idx_Strip_].resize(num_Components);
+				RelabelStrip(Strips_[idx_Strip_], accumulators[idx_Strip_]);
+			}
+		);
+
+		Components_.resize(num_Components);
+		for (uint32_t idx_Component{ 0U }; idx_Component < num_Components; ++idx_Component) {
+			Accumulator total{};
+			for (auto const& stripAccumulators : accumulators) {
+				Accumulator const& part{ stripAccumulators[idx_Component] };
+				total.Area += part.Area;
+				total.Min = { std::min(total.Min.x, part.Min.x), std::min(total.Min.y, part.Min.y) };
+				total.Max = { std::max(total.Max.x, part.Max.x), std::max(total.Max.y, part.Max.y) };
+				total.SumX += part.SumX;
+				total.SumY += part.SumY;
+			}
+			float const inv_Area{ 1.0f / static_cast<float>(total.Area) };
+			Components_[idx_Component] = {
+				.Area{ total.Area },
+				.Min{ total.Min },
+				.Max{ total.Max },
+				.Centroid{ static_cast<float>(total.SumX) * inv_Area, static_cast<float>(total.SumY) * inv_Area },
+			};
+		}
+	}
+
+	template<typename T_IsForeground>
+	void ConnectedComponents::LabelStrip(Strip& strip_, T_IsForeground const& isForeground_, CONNECTIVITY connectivity_) {
+		uint32_t nextLabel{ strip_.FirstLabel };
+
+		for (uint32_t y{ strip_.RowBegin }; y < strip_.RowEnd; ++y) {
+			uint32_t* const row{ Labels_.data() + static_cast<size_t>(y) * Width_ };
+			// The first row of a strip looks at nothing above; StitchStrip() joins it up afterwards.
+			uint32_t const* const rowAbove{ (y > strip_.RowBegin) ? row - Width_ : nullptr };
+
+			for (uint32_t x{ 0U }; x < Width_; ++x) {
+				if (!isForeground_(x, y)) {
+					row[x] = Background;
+					continue;
+				}
+
+				uint32_t label{ Background };
+				auto const join{
+					[this, &label] (uint32_t neighbour_) {
+						if (neighbour_ == Background) { return; }
+						if (label == Background) { label = neighbour_; }
+						else if (label != neighbour_) { Provisional_.Union(label, neighbour_); }
+					}
+				};
+				if (x > 0U) { join(row[x - 1U]); }
+				if (rowAbove != nullptr) {
+					join(rowAbove[x]);
+					if (connectivity_ == CONNECTIVITY::EIGHT) {
+						if (x > 0U) { join(rowAbove[x - 1U]); }
+						if (x + 1U < Width_) { join(rowAbove[x + 1U]); }
+					}
+				}
+
+				if (label == Background) {
+					label = ++nextLabel;
+					Provisional_.MakeSet(label);
+				}
+				row[x] = label;
+			}
+		}
+
+		strip_.Num_Labels = nextLabel - strip_.FirstLabel;
+	}
+
+	void ConnectedComponents::StitchStrip(Strip const& strip_, CONNECTIVITY connectivity_) {
+		uint32_t const* const row{ Labels_.data() + static_cast<size_t>(strip_.RowBegin) * Width_ };
+		uint32_t const* const rowAbove{ row - Width_ };
+
+		for (uint32_t x{ 0U }; x < Width_; ++x) {
+			if (row[x] == Background) { continue; }
+
+			if (rowAbove[x] != Background) { Provisional_.Union(row[x], rowAbove[x]); }
+			if (connectivity_ == CONNECTIVITY::EIGHT) {
+				if (x > 0U && rowAbove[x - 1U] != Background) { Provisional_.Union(row[x], rowAbove[x - 1U]); }
+				if (x + 1U < Width_ && rowAbove[x + 1U] != Background) { Provisional_.Union(row[x], rowAbove[x + 1U]); }
+			}
+		}
+	}
+
+	uint32_t ConnectedComponents::Resolve() {
+		for (auto const& strip : Strips_) {
+			std::fill_n(Finals_.begin() + strip.FirstLabel + 1LLU, strip.Num_Labels, Background);
+		}
+
+		// Provisional labels are handed out in scan order, strip after strip, so the first label met of each set
+		// belongs to the component's first cell: numbering roots in label order numbers components in scan order.
+		uint32_t num_Components{ 0U };
+		for (auto const& strip : Strips_) {
+			for (uint32_t label{ strip.FirstLabel + 1U }; label <= strip.FirstLabel + strip.Num_Labels; ++label) {
+				uint32_t const root{ Provisional_.Find(label) };
+				if (Finals_[root] == Background) { Finals_[root] = ++num_Components; }
+				Finals_[label] = Finals_[root];
+			}
+		}
+		return num_Components;
+	}
+
+	void ConnectedComponents::RelabelStrip(Strip const& strip_, std::vector<Accumulator>& accumulators_) {
+		for (uint32_t y{ strip_.RowBegin }; y < strip_.RowEnd; ++y) {
+			uint32_t* const row{ Labels_.data() + static_cast<size_t>(y) * Width_ };
+			for (uint32_t x{ 0U }; x < Width_; ++x) {
+				if (row[x] == Background) { continue; }
+
+				row[x] = Finals_[row[x]];
+				Accumulator& accumulator{ accumulators_[row[x] - 1U] };
+				++accumulator.Area;
+				accumulator.Min = { std::min(accumulator.Min.x, static_cast<int32_t>(x)), std::min(accumulator.Min.y, static_cast<int32_t>(y)) };
+				accumulator.Max = { std::max(accumulator.Max.x, static_cast<int32_t>(x)), std::max(accumulator.Max.y, static_cast<int32_t>(y)) };
+				accumulator.SumX += x;
+				accumulator.SumY += y;
+			}
+		}
+	}
+
+	INLINE_NAMESPACE_MATH_END
+}
\ No newline at end of file
@@ -0,0 +1,345 @@
+module;
+
+#include<immintrin.h>
+
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+
+export module Lumina.Math.Culling;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <cmath>;
+import <limits>;
+import <bit>;
+
+import <vector>;
+import <array>;
+
+import Lumina.Math.Vector;
+import Lumina.Math.Bounds;
+import Lumina.Math.Frustum;
+
+//////	//////	//////	//////	//////	//////
+
+#define INLINE_NAMESPACE_MATH_BEGIN		inline namespace Math {
+#define INLINE_NAMESPACE_MATH_END		}
+
+//****	******	******	******	******	****//
+
+// Bounding volumes are kept as structure-of-arrays so that the kernels test 8 objects per AVX2 iteration.
+// Streams are padded to a multiple of 8 with NaN centers, which fail every comparison and are never reported visible.
+
+//////	//////	//////	//////	//////	//////
+//	AABBBatch								//
+//////	//////	//////	//////	//////	//////
+
+export namespace Lumina {
+	INLINE_NAMESPACE_MATH_BEGIN
+
+	class AABBBatch {
+	public:
+		enum STREAM : uint32_t {
+			CENTER_X,
+			CENTER_Y,
+			CENTER_Z,
+			EXTENT_X,
+			EXTENT_Y,
+			EXTENT_Z,
+			NUM_STREAMS,
+		};
+
+		//----	------	------	------	------	----//
+
+	public:
+		void Clear() noexcept {
+			for (auto& stream : Streams_) { stream.clear(); }
+			Size_ = 0U;
+		}
+		void Reserve(uint32_t num_) {
+			for (auto& stream : Streams_) { stream.reserve((num_ + 7U) & ~7U); }
+		}
+
+		// Returns the index the kernels report for this box.
+		uint32_t Push(Vec3 const& center_, Vec3 const& extent_) {
+			if ((Size_ & 7U) == 0U) {
+				for (uint32_t i_Stream{ 0U }; i_Stream < NUM_STREAMS; ++i_Stream) {
+					Streams_[i_Stream].resize(Size_ + 8U, (i_Stream < EXTENT_X) ? std::numeric_limits<float>::quiet_NaN() : 0.0f);
+				}
+			}
+			Streams_[CENTER_X][Size_] = center_.x;
+			Streams_[CENTER_Y][Size_] = center_.y;
+			Streams_[CENTER_Z][Size_] = center_.z;
+			Streams_[EXTENT_X][Size_] = extent_.x;
+			Streams_[EXTENT_Y][Size_] = extent_.y;
+			Streams_[EXTENT_Z][Size_] = extent_.z;
+			return Size_++;
+		}
+		uint32_t Push(AABB const& box_) { return Push(box_.Center, box_.Extent); }
+
+		AABB operator[](uint32_t idx_) const noexcept {
+			return AABB{
+				.Center{ Streams_[CENTER_X][idx_], Streams_[CENTER_Y][idx_], Streams_[CENTER_Z][idx_] },
+				.Extent{ Streams_[EXTENT_X][idx_], Streams_[EXTENT_Y][idx_], Streams_[EXTENT_Z][idx_] },
+			};
+		}
+
+		uint32_t Size() const noexcept { return Size_; }
+		// Number of slots a visible-index buffer handed to Cull() must provide.
+		uint32_t PaddedSize() const noexcept { return (Size_ + 7U) & ~7U; }
+		float const* Stream(STREAM stream_) const noexcept { return Streams_[stream_].data(); }
+
+		//====	======	======	======	======	====//
+
+	private:
+		std::array<std::vector<float>, NUM_STREAMS> Streams_{};
+		uint32_t Size_{ 0U };
+	};
+
+	INLINE_NAMESPACE_MATH_END
+}
+
+//////	//////	//////	//////	//////	//////
+//	SphereBatch								//
+//////	//////	//////	//////	//////	//////
+
+export namespace Lumina {
+	INLINE_NAMESPACE_MATH_BEGIN
+
+	class SphereBatch {
+	public:
+		enum STREAM : uint32_t {
+			CENTER_X,
+			CENTER_Y,
+			CENTER_Z,
+			RADIUS,
+			NUM_STREAMS,
+		};
+
+		//----	------	------	------	------	----//
+
+	public:
+		void Clear() noexcept {
+			for (auto& stream : Streams_) { stream.clear(); }
+			Size_ = 0U;
+		}
+		void Reserve(uint32_t num_) {
+			for (auto& stream : Streams_) { stream.reserve((num_ + 7U) & ~7U); }
+		}
+
+		uint32_t Push(Vec3 const& center_, float radius_) {
+			if ((Size_ & 7U) == 0U) {
+				for (uint32_t i_Stream{ 0U }; i_Stream < NUM_STREAMS; ++i_Stream) {
+					Streams_[i_Stream].resize(Size_ + 8U, (i_Stream < RADIUS) ? std::numeric_limits<float>::quiet_NaN() : 0.0f);
+				}
+			}
+			Streams_[CENTER_X][Size_] = center_.x;
+			Streams_[CENTER_Y][Size_] = center_.y;
+			Streams_[CENTER_Z][Size_] = center_.z;
+			Streams_[RADIUS][Size_] = radius_;
+			return Size_++;
+		}
+		uint32_t Push(Sphere const& sphere_) { return Push(sphere_.Center, sphere_.Radius); }
+
+		Sphere operator[](uint32_t idx_) const noexcept {
+			return Sphere{
+				.Center{ Streams_[CENTER_X][idx_], Streams_[CENTER_Y][idx_], Streams_[CENTER_Z][idx_] },
+				.Radius{ Streams_[RADIUS][idx_] },
+			};
+		}
+
+		uint32_t Size() const noexcept { return Size_; }
+		uint32_t PaddedSize() const noexcept { return (Size_ + 7U) & ~7U; }
+		float const* Stream(STREAM stream_) const noexcept { return Streams_[stream_].data(); }
+
+		//====	======	======	======	======	====//
+
+	private:
+		std::array<std::vector<float>, NUM_STREAMS> Streams_{};
+		uint32_t Size_{ 0U };
+	};
+
+	INLINE_NAMESPACE_MATH_END
+}
+
+//////	//////	//////	//////	//////	//////
+//	Kernels									//
+//////	//////	//////	//////	//////	//////
+
+namespace Lumina {
+	INLINE_NAMESPACE_MATH_BEGIN
+
+	namespace {
+		// For each 8-bit visibility mask, the lane indices of its set bits packed in 3-bit fields.
+		constexpr std::array<uint32_t, 256LLU> CompactionTable{
+			[] () {
+				std::array<uint32_t, 256LLU> table{};
+				for (uint32_t mask{ 0U }; mask < 256U; ++mask) {
+					uint32_t num_Set{ 0U };
+					for (uint32_t lane{ 0U }; lane < 8U; ++lane) {
+						if (mask & (1U << lane)) {
+							table[mask] |= lane << (3U * num_Set++);
+						}
+					}
+				}
+				return table;
+			}()
+		};
+
+		// Appends base_ + lane for every set lane of mask_ to dst_, writing all 8 slots unconditionally.
+		inline uint32_t Compact(uint32_t* dst_, uint32_t mask_, uint32_t base_) noexcept {
+			__m256i const lanes{
+				_mm256_and_si256(
+					_mm256_srlv_epi32(
+						_mm256_set1_epi32(static_cast<int>(CompactionTable[mask_])),
+						_mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21)
+					),
+					_mm256_set1_epi32(7)
+				)
+			};
+			_mm256_storeu_si256(
+				reinterpret_cast<__m256i*>(dst_),
+				_mm256_add_epi32(lanes, _mm256_set1_epi32(static_cast<int>(base_)))
+			);
+			return static_cast<uint32_t>(std::popcount(mask_));
+		}
+
+		// Same evaluation order as Frustum::Intersects, so that both agree bit for bit.
+		inline __m256 PlaneDistance(__m256 const (&plane_)[4], __m256 x_, __m256 y_, __m256 z_) noexcept {
+			return _mm256_add_ps(
+				_mm256_add_ps(
+					_mm256_add_ps(_mm256_mul_ps(plane_[0], x_), _mm256_mul_ps(plane_[1], y_)),
+					_mm256_mul_ps(plane_[2], z_)
+				),
+				plane_[3]
+			);
+		}
+	}
+
+	//////	//////	//////	//////	//////	//////
+
+	// Writes the indices of the boxes intersecting the frustum to visible_, which needs batch_.PaddedSize() slots.
+	// Returns the number of visible boxes.
+	export uint32_t Cull(Frustum const& frustum_, AABBBatch const& batch_, uint32_t* visible_) noexcept {
+		__m256 planes[Frustum::NUM_PLANES][4];
+		__m256 absPlanes[Frustum::NUM_PLANES][3];
+		for (uint32_t i_Plane{ 0U }; i_Plane < Frustum::NUM_PLANES; ++i_Plane) {
+			auto const& plane{ frustum_.Plane(i_Plane) };
+			for (uint32_t i{ 0U }; i < 4U; ++i) {
+				planes[i_Plane][i] = _mm256_set1_ps(plane[i]);
+			}
+			for (uint32_t i{ 0U }; i < 3U; ++i) {
+				absPlanes[i_Plane][i] = _mm256_set1_ps(std::abs(plane[i]));
+			}
+		}
+
+		float const* const centerX{ batch_.Stream(AABBBatch::CENTER_X) };
+		float const* const centerY{ batch_.Stream(AABBBatch::CENTER_Y) };
+		float const* const centerZ{ batch_.Stream(AABBBatch::CENTER_Z) };
+		float const* const extentX{ batch_.Stream(AABBBatch::EXTENT_X) };
+		float const* const extentY{ batch_.Stream(AABBBatch::EXTENT_Y) };
+		float const* const extentZ{ batch_.Stream(AABBBatch::EXTENT_Z) };
+		__m256 const zero{ _mm256_setzero_ps() };
+
+		uint32_t num_Visible{ 0U };
+		for (uint32_t base{ 0U }; base < batch_.PaddedSize(); base += 8U) {
+			__m256 const cx{ _mm256_loadu_ps(centerX + base) };
+			__m256 const cy{ _mm256_loadu_ps(centerY + base) };
+			__m256 const cz{ _mm256_loadu_ps(centerZ + base) };
+			__m256 const ex{ _mm256_loadu_ps(extentX + base) };
+			__m256 const ey{ _mm256_loadu_ps(extentY + base) };
+			__m256 const ez{ _mm256_loadu_ps(extentZ + base) };
+
+			__m256 inside{ _mm256_castsi256_ps(_mm256_set1_epi32(-1)) };
+			for (uint32_t i_Plane{ 0U }; i_Plane < Frustum::NUM_PLANES; ++i_Plane) {
+				__m256 const dist{ PlaneDistance(planes[i_Plane], cx, cy, cz) };
+				__m256 const radius{
+					_mm256_add_ps(
+						_mm256_add_ps(_mm256_mul_ps(absPlanes[i_Plane][0], ex), _mm256_mul_ps(absPlanes[i_Plane][1], ey)),
+						_mm256_mul_ps(absPlanes[i_Plane][2], ez)
+					)
+				};
+				inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(dist, radius), zero, _CMP_GE_OQ));
+			}
+			num_Visible += Compact(visible_ + num_Visible, static_cast<uint32_t>(_mm256_movemask_ps(inside)), base);
+		}
+		return num_Visible;
+	}
+
+	export uint32_t Cull(Frustum const& frustum_, SphereBatch const& batch_, uint32_t* visible_) noexcept {
+		__m256 planes[Frustum::NUM_PLANES][4];
+		for (uint32_t i_Plane{ 0U }; i_Plane < Frustum::NUM_PLANES; ++i_Plane) {
+			auto const& plane{ frustum_.Plane(i_Plane) };
+			for (uint32_t i{ 0U }; i < 4U; ++i) {
+				planes[i_Plane][i] = _mm256_set1_ps(plane[i]);
+			}
+		}
+
+		float const* const centerX{ batch_.Stream(SphereBatch::CENTER_X) };
+		float const* const centerY{ batch_.Stream(SphereBatch::CENTER_Y) };
+		float const* const centerZ{ batch_.Stream(SphereBatch::CENTER_Z) };
+		float const* const radii{ batch_.Stream(SphereBatch::RADIUS) };
+		__m256 const zero{ _mm256_setzero_ps() };
+
+		uint32_t num_Visible{ 0U };
+		for (uint32_t base{ 0U }; base < batch_.PaddedSize(); base += 8U) {
+			__m256 const cx{ _mm256_loadu_ps(centerX + base) };
+			__m256 const cy{ _mm256_loadu_ps(centerY + base) };
+			__m256 const cz{ _mm256_loadu_ps(centerZ + base) };
+			__m256 const radius{ _mm256_loadu_ps(radii + base) };
+
+			__m256 inside{ _mm256_castsi256_ps(_mm256_set1_epi32(-1)) };
+			for (uint32_t i_Plane{ 0U }; i_Plane < Frustum::NUM_PLANES; ++i_Plane) {
+				__m256 const dist{ PlaneDistance(planes[i_Plane], cx, cy, cz) };
+				inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(dist, radius), zero, _CMP_GE_OQ));
+			}
+			num_Visible += Compact(visible_ + num_Visible, static_cast<uint32_t>(_mm256_movemask_ps(inside)), base);
+		}
+		return num_Visible;
+	}
+
+	// 2D fast path: tests the XY extents of the boxes against a frustum footprint (see Frustum::Footprint).
+	export uint32_t Cull(Rect2D const& rect_, AABBBatch const& batch_, uint32_t* visible_) noexcept {
+		__m256 const minX{ _mm256_set1_ps(rect_.MinX) };
+		__m256 const minY{ _mm256_set1_ps(rect_.MinY) };
+		__m256 const maxX{ _mm256_set1_ps(rect_.MaxX) };
+		__m256 const maxY{ _mm256_set1_ps(rect_.MaxY) };
+
+		float const* const centerX{ batch_.Stream(AABBBatch::CENTER_X) };
+		float const* const centerY{ batch_.Stream(AABBBatch::CENTER_Y) };
+		float const* const extentX{ batch_.Stream(AABBBatch::EXTENT_X) };
+		float const* const extentY{ batch_.Stream(AABBBatch::EXTENT_Y) };
+
+		uint32_t num_Visible{ 0U };
+		for (uint32_t base{ 0U }; base < batch_.PaddedSize(); base += 8U) {
+			__m256 const cx{ _mm256_loadu_ps(centerX + base) };
+			__m256 const cy{ _mm256_loadu_ps(centerY + base) };
+			__m256 const ex{ _mm256_loadu_ps(extentX + base) };
+			__m256 const ey{ _mm256_loadu_ps(extentY + base) };
+
+			__m256 const insideX{
+				_mm256_and_ps(
+					_mm256_cmp_ps(_mm256_add_ps(cx, ex), minX, _CMP_GE_OQ),
+					_mm256_cmp_ps(_mm256_sub_ps(cx, ex), maxX, _CMP_LE_OQ)
+				)
+			};
+			__m256 const insideY{
+				_mm256_and_ps(
+					_mm256_cmp_ps(_mm256_add_ps(cy, ey), minY, _CMP_GE_OQ),
+					_mm256_cmp_ps(_mm256_sub_ps(cy, ey), maxY, _CMP_LE_OQ)
+				)
+			};
+			num_Visible += Compact(
+				visible_ + num_Visible,
+				static_cast<uint32_t>(_mm256_movemask_ps(_mm256_and_ps(insideX, insideY))),
+				base
+			);
+		}
+		return num_Visible;
+	}
+
+	INLINE_NAMESPACE_MATH_END
+}
\ No newline at end of file
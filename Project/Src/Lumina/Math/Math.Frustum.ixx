@@ -0,0 +1,137 @@
+export module Lumina.Math.Frustum;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <cmath>;
+import <limits>;
+
+import <algorithm>;
+import <initializer_list>;
+
+import Lumina.Math.Vector;
+import Lumina.Math.Matrix;
+import Lumina.Math.Bounds;
+
+//////	//////	//////	//////	//////	//////
+
+#define INLINE_NAMESPACE_MATH_BEGIN		inline namespace Math {
+#define INLINE_NAMESPACE_MATH_END		}
+
+//****	******	******	******	******	****//
+
+//////	//////	//////	//////	//////	//////
+//	Frustum									//
+//////	//////	//////	//////	//////	//////
+
+export namespace Lumina {
+	INLINE_NAMESPACE_MATH_BEGIN
+
+	class Frustum {
+	public:
+		enum PLANE : uint32_t {
+			LEFT,
+			RIGHT,
+			BOTTOM,
+			TOP,
+			NEAR_CLIP,
+			FAR_CLIP,
+			NUM_PLANES,
+		};
+
+		//----	------	------	------	------	----//
+
+	public:
+		// Extracts the planes of a view-projection applied to row vectors (v * VP), with D3D clip depth [0, w].
+		// Planes face inward and are normalized, so plane tests yield signed distances.
+		static Frustum Extract(Mat4 const& viewProjection_) noexcept {
+			auto const column{
+				[&viewProjection_] (int idx_) {
+					return Vec4{ viewProjection_[0][idx_], viewProjection_[1][idx_], viewProjection_[2][idx_], viewProjection_[3][idx_] };
+				}
+			};
+			Vec4 const col0{ column(0) };
+			Vec4 const col1{ column(1) };
+			Vec4 const col2{ column(2) };
+			Vec4 const col3{ column(3) };
+
+			Frustum frustum{};
+			frustum.Planes_[LEFT] = col3 + col0;
+			frustum.Planes_[RIGHT] = col3 - col0;
+			frustum.Planes_[BOTTOM] = col3 + col1;
+			frustum.Planes_[TOP] = col3 - col1;
+			frustum.Planes_[NEAR_CLIP] = col2;
+			frustum.Planes_[FAR_CLIP] = col3 - col2;
+			for (auto& plane : frustum.Planes_) {
+				plane = plane * (1.0f / std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z));
+			}
+			frustum.Inv_ViewProjection_ = viewProjection_.Inv();
+			return frustum;
+		}
+
+		//----	------	------	------	------	----//
+
+	public:
+		Vec4 const& Plane(uint32_t idx_) const noexcept { return Planes_[idx_]; }
+
+		// Scalar reference for the batched kernels in Lumina.Math.Culling; keep the evaluation order in sync.
+		bool Intersects(AABB const& box_) const noexcept {
+			for (auto const& plane : Planes_) {
+				float const dist{ plane.x * box_.Center.x + plane.y * box_.Center.y + plane.z * box_.Center.z + plane.w };
+				float const radius{ std::abs(plane.x) * box_.Extent.x + std::abs(plane.y) * box_.Extent.y + std::abs(plane.z) * box_.Extent.z };
+				if (!(dist + radius >= 0.0f)) { return false; }
+			}
+			return true;
+		}
+		bool Intersects(Sphere const& sphere_) const noexcept {
+			for (auto const& plane : Planes_) {
+				float const dist{ plane.x * sphere_.Center.x + plane.y * sphere_.Center.y + plane.z * sphere_.Center.z + plane.w };
+				if (!(dist + sphere_.Radius >= 0.0f)) { return false; }
+			}
+			return true;
+		}
+
+		// Bounding rectangle of the cross-section at the XY plane of the given depth.
+		// A 2D scene rendered through a perspective or orthographic camera can then be culled with 4 compares per object.
+		// Edges that do not reach the plane between the near and far planes are clamped, which keeps the result conservative.
+		Rect2D Footprint(float z_) const noexcept {
+			Rect2D rect{
+				.MinX{ std::numeric_limits<float>::max() },
+				.MinY{ std::numeric_limits<float>::max() },
+				.MaxX{ std::numeric_limits<float>::lowest() },
+				.MaxY{ std::numeric_limits<float>::lowest() },
+			};
+			for (float const ndcY : { -1.0f, 1.0f }) {
+				for (float const ndcX : { -1.0f, 1.0f }) {
+					Vec4 pt_Near{ Vec4{ ndcX, ndcY, 0.0f, 1.0f } * Inv_ViewProjection_ };
+					Vec4 pt_Far{ Vec4{ ndcX, ndcY, 1.0f, 1.0f } * Inv_ViewProjection_ };
+					pt_Near = pt_Near * (1.0f / pt_Near.w);
+					pt_Far = pt_Far * (1.0f / pt_Far.w);
+
+					float const dz{ pt_Far.z - pt_Near.z };
+					float const t{
+						(std::abs(dz) > std::numeric_limits<float>::epsilon()) ?
+						std::clamp((z_ - pt_Near.z) / dz, 0.0f, 1.0f) :
+						0.0f
+					};
+					float const x{ pt_Near.x + (pt_Far.x - pt_Near.x) * t };
+					float const y{ pt_Near.y + (pt_Far.y - pt_Near.y) * t };
+					rect.MinX = std::min(rect.MinX, x);
+					rect.MinY = std::min(rect.MinY, y);
+					rect.MaxX = std::max(rect.MaxX, x);
+					rect.MaxY = std::max(rect.MaxY, y);
+				}
+			}
+			return rect;
+		}
+
+		//====	======	======	======	======	====//
+
+	private:
+		Vec4 Planes_[NUM_PLANES]{};
+		Mat4 Inv_ViewProjection_{};
+	};
+
+	INLINE_NAMESPACE_MATH_END
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+export module Lumina.Math.GridPath;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cassert>;
+
+import <cmath>;
+import <cstdlib>;
+
+import <vector>;
+import <algorithm>;
+import <limits>;
+
+import Lumina.Math.Numerics;
+
+//////	//////	//////	//////	//////	//////
+
+#define INLINE_NAMESPACE_MATH_BEGIN		inline namespace Math {
+#define INLINE_NAMESPACE_MATH_END		}
+
+//****	******	******	******	******	****//
+
+//////	//////	//////	//////	//////	//////
+//	GridPathFinder							//
+//////	//////	//////	//////	//////	//////
+
+// A* over the 4-connected cells of a grid, each cell costing what a callback says to step into.
+//
+//	- The open set is a binary heap with lazy deletion: a cell whose cost drops is pushed again,
+//	  and the stale entry is skipped when it comes up.
+//	- The heuristic is the Manhattan distance times minCost_, which must not exceed the cost of any cell
+//	  for the path to be the cheapest. Zero turns the search into Dijkstra's.
+//	- Per-cell state is stamped with the search it belongs to, so a search touches only the cells it reaches
+//	  and many short searches on one large grid cost nothing to set up.
+
+export namespace Lumina {
+	INLINE_NAMESPACE_MATH_BEGIN
+
+	class GridPathFinder {
+	private:
+		struct Node {
+			// Cost so far plus the heuristic.
+			float Estimate;
+			float Cost;
+			uint32_t Cell;
+		};
+
+		//----	------	------	------	------	----//
+
+	public:
+		// Writes the cells from start_ to goal_, both included, to path_. Returns false if goal_ is out of reach,
+		// where cost_(x, y) returns infinity for cells that cannot be entered.
+		template<typename T_Cost>
+		bool Find(
+			uint32_t width_, uint32_t height_,
+			Int2 const& start_, Int2 const& goal_,
+			T_Cost const& cost_, float minCost_,
+			std::vector<Int2>& path_
+		);
+
+	public:
+		// Of the last path found.
+		float Cost() const noexcept { return Cost_; }
+		// Cells taken off the open set by the last search.
+		uint32_t Num_Expanded() const noexcept { return Num_Expanded_; }
+
+	private:
+		void Prepare(uint32_t num_Cells_);
+
+		//====	======	======	======	======	====//
+
+	private:
+		std::vector<float> Costs_{};
+		std::vector<uint32_t> Parents_{};
+		std::vector<uint32_t> Stamps_{};
+		uint32_t Stamp_{ 0U };
+
+		std::vector<Node> Open_{};
+
+		float Cost_{ 0.0f };
+		uint32_t Num_Expanded_{ 0U };
+	};
+
+	//----	------	------	------	------	----//
+
+	template<typename T_Cost>
+	bool GridPathFinder::Find(
+		uint32_t width_, uint32_t height_,
+		Int2 const& start_, Int2 const& goal_,
+		T_Cost const& cost_, float minCost_,
+		std::vector<Int2>& path_
+	) {
+		assert(start_.x >= 0 && start_.y >= 0 && static_cast<uint32_t>(start_.x) < width_ && static_cast<uint32_t>(start_.y) < height_);
+		assert(goal_.x >= 0 && goal_.y >= 0 && static_cast<uint32_t>(goal_.x) < width_ && static_cast<uint32_t>(goal_.y) < height_);
+
+		path_.clear();
+		Cost_ = 0.0f;
+		Num_Expanded_ = 0U;
+		Prepare(width_ * height_);
+
+		auto const heuristic{
+			[&goal_, minCost_] (uint32_t x_, uint32_t y_) {
+				uint32_t const dx{ static_cast<uint32_t>(std::abs(static_cast<int32_t>(x_) - goal_.x)) };
+				uint32_t const dy{ static_cast<uint32_t>(std::abs(static_cast<int32_t>(y_) - goal_.y)) };
+				return static_cast<float>(dx + dy) * minCost_;
+			}
+		};
+		// Cheapest estimate on top; ties go to the deeper node, which is closer to the goal.
+		auto const isWorse{
+			[] (Node const& lhs_, Node const& rhs_) {
+				return (lhs_.Estimate != rhs_.Estimate) ? (lhs_.Estimate > rhs_.Estimate) : (lhs_.Cost < rhs_.Cost);
+			}
+		};
+
+		uint32_t const idx_Start{ static_cast<uint32_t>(start_.y) * width_ + static_cast<uint32_t>(start_.x) };
+		uint32_t const idx_Goal{ static_cast<uint32_t>(goal_.y) * width_ + static_cast<uint32_t>(goal_.x) };
+		Stamps_[idx_Start] = Stamp_;
+		Costs_[idx_Start] = 0.0f;
+		Parents_[idx_Start] = idx_Start;
+		Open_.emplace_back(heuristic(static_cast<uint32_t>(start_.x), static_cast<uint32_t>(start_.y)), 0.0f, idx_Start);
+
+		while (!Open_.empty()) {
+			std::pop_heap(Open_.begin(), Open_.end(), isWorse);
+			Node const node{ Open_.back() };
+			Open_.pop_back();
+			if (node.Cost > Costs_[node.Cell]) { continue; }
+
+			++Num_Expanded_;
+			if (node.Cell == idx_Goal) { break; }
+
+			uint32_t const x{ node.Cell % width_ };
+			uint32_t const y{ node.Cell / width_ };
+			auto const visit{
+				[&] (uint32_t nx_, uint32_t ny_) {
+					uint32_t const idx_Neighbour{ ny_ * width_ + nx_ };
+					float const cost{ node.Cost + static_cast<float>(cost_(nx_, ny_)) };
+					if (!(cost < std::numeric_limits<float>::infinity())) { return; }
+					if (Stamps_[idx_Neighbour] == Stamp_ && !(cost < Costs_[idx_Neighbour])) { return; }
+
+					Stamps_[idx_Neighbour] = Stamp_;
+					Costs_[idx_Neighbour] = cost;
+					Parents_[idx_Neighbour] = node.Cell;
+					Open_.emplace_back(cost + heuristic(nx_, ny_), cost, idx_Neighbour);
+					std::push_heap(Open_.begin(), Open_.end(), isWorse);
+				}
+			};
+			if (x > 0U) { visit(x - 1U, y); }
+			if (x + 1U < width_) { visit(x + 1U, y); }
+			if (y > 0U) { visit(x, y - 1U); }
+			if (y + 1U < height_) { visit(x, y + 1U); }
+		}
+		Open_.clear();
+
+		if (Stamps_[idx_Goal] != Stamp_) { return false; }
+
+		Cost_ = Costs_[idx_Goal];
+		for (uint32_t idx_Cell{ idx_Goal }; ; idx_Cell = Parents_[idx_Cell]) {
+			path_.emplace_back(static_cast<int32_t>(idx_Cell % width_), static_cast<int32_t>(idx_Cell / width_));
+			if (idx_Cell == idx_Start) { break; }
+		}
+		std::reverse(path_.begin(), path_.end());
+		return true;
+	}
+
+	void GridPathFinder::Prepare(uint32_t num_Cells_) {
+		if (Stamps_.size() < num_Cells_) {
+			Costs_.resize(num_Cells_);
+			Parents_.resize(num_Cells_);
+			Stamps_.resize(num_Cells_, Stamp_);
+		}
+
+		// Every stamp in use is below the next one; on wrapping around, they all start over.
+		if (++Stamp_ == 0U) {
+			std::fill(Stamps_.begin(), Stamps_.end(), 0U);
+			Stamp_ = 1U;
+		}
+	}
+
+	INLINE_NAMESPACE_MATH_END
+}
\ No newline at end of file
@@ -0,0 +1,268 @@
+export module Lumina.Math.KDTree;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <limits>;
+
+import <vector>;
+import <algorithm>;
+import <type_traits>;
+
+import Lumina.Math.Vector;
+
+//////	//////	//////	//////	//////	//////
+
+#define INLINE_NAMESPACE_MATH_BEGIN		inline namespace Math {
+#define INLINE_NAMESPACE_MATH_END		}
+
+//****	******	******	******	******	****//
+
+//////	//////	//////	//////	//////	//////
+//	KDTree									//
+//////	//////	//////	//////	//////	//////
+
+// Static k-d tree without child pointers: a node is the median of its range [lo, hi) and sits at mid = (lo + hi) / 2,
+// with its children being [lo, mid) and [mid + 1, hi). Only the split axis is stored per node.
+// Ranges of LeafSize entries or fewer are scanned linearly.
+//
+// Query results are the indices of the points as passed to Build().
+
+export namespace Lumina {
+	INLINE_NAMESPACE_MATH_BEGIN
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	class KDTree {
+	public:
+		using Point = std::conditional_t<(N_Dims == 2U), Vec2, Vec3>;
+
+		static constexpr uint32_t Invalid{ 0xFFFFFFFFU };
+		static constexpr uint32_t LeafSize{ 8U };
+
+	private:
+		struct Entry {
+			Point Position;
+			uint32_t Index;
+		};
+
+		//----	------	------	------	------	----//
+
+	public:
+		uint32_t Size() const noexcept { return static_cast<uint32_t>(Entries_.size()); }
+		bool IsEmpty() const noexcept { return Entries_.empty(); }
+
+		// O(n log n); storage is kept across calls, so rebuilding every frame does not allocate once warmed up.
+		void Build(std::vector<Point> const& points_) {
+			Entries_.resize(points_.size());
+			SplitAxes_.resize(points_.size());
+			for (uint32_t i{ 0U }; i < static_cast<uint32_t>(points_.size()); ++i) {
+				Entries_[i] = Entry{ points_[i], i };
+			}
+			Split(0U, Size());
+		}
+
+		// For the same set of points after they have moved: starts from the previous permutation,
+		// which is already close to partitioned when the points moved little, and so saves most of the swaps.
+		void Rebuild(std::vector<Point> const& points_) {
+			if (points_.size() != Entries_.size()) {
+				Build(points_);
+				return;
+			}
+			for (auto& entry : Entries_) {
+				entry.Position = points_[entry.Index];
+			}
+			Split(0U, Size());
+		}
+
+		//----	------	------	------	------	----//
+
+	public:
+		// Returns Invalid if no point lies within maxRadius_.
+		uint32_t Nearest(Point const& query_, float maxRadius_ = std::numeric_limits<float>::infinity()) const {
+			uint32_t idx_Nearest{ Invalid };
+			float bound2{ maxRadius_ * maxRadius_ };
+			Search(
+				query_, 0U, Size(), bound2,
+				[&idx_Nearest] (Entry const& entry_, float dist2_, float& bound2_) {
+					if (dist2_ < bound2_) {
+						bound2_ = dist2_;
+						idx_Nearest = entry_.Index;
+					}
+				}
+			);
+			return idx_Nearest;
+		}
+
+		// Writes up to k_ indices and squared distances, nearest first, and returns how many were found.
+		uint32_t KNearest(
+			Point const& query_,
+			uint32_t k_,
+			uint32_t* indices_,
+			float* dist2s_,
+			float maxRadius_ = std::numeric_limits<float>::infinity()
+		) const {
+			if (k_ == 0U) { return 0U; }
+
+			uint32_t num_Found{ 0U };
+			float const maxRadius2{ maxRadius_ * maxRadius_ };
+			float bound2{ maxRadius2 };
+			Search(
+				query_, 0U, Size(), bound2,
+				[&] (Entry const& entry_, float dist2_, float& bound2_) {
+					if (!(dist2_ < bound2_)) { return; }
+
+					// Insertion into the sorted prefix; k is small enough that this beats a heap.
+					uint32_t pos{ (num_Found < k_) ? num_Found++ : (k_ - 1U) };
+					for (; pos > 0U && dist2s_[pos - 1U] > dist2_; --pos) {
+						indices_[pos] = indices_[pos - 1U];
+						dist2s_[pos] = dist2s_[pos - 1U];
+					}
+					indices_[pos] = entry_.Index;
+					dist2s_[pos] = dist2_;
+					bound2_ = (num_Found < k_) ? maxRadius2 : dist2s_[k_ - 1U];
+				}
+			);
+			return num_Found;
+		}
+
+		// Calls visit_(index, dist2) for every point with dist2 <= radius_^2, in no particular order.
+		template<typename T_Visit>
+		void ForEachInRadius(Point const& query_, float radius_, T_Visit&& visit_) const {
+			float bound2{ radius_ * radius_ };
+			Search(
+				query_, 0U, Size(), bound2,
+				[&visit_] (Entry const& entry_, float dist2_, float& bound2_) {
+					if (dist2_ <= bound2_) { visit_(entry_.Index, dist2_); }
+				}
+			);
+		}
+
+		// Appends the indices within radius_ and returns how many were appended.
+		uint32_t InRadius(Point const& query_, float radius_, std::vector<uint32_t>& indices_) const {
+			size_t const num_Before{ indices_.size() };
+			ForEachInRadius(query_, radius_, [&indices_] (uint32_t idx_, float) { indices_.emplace_back(idx_); });
+			return static_cast<uint32_t>(indices_.size() - num_Before);
+		}
+
+		//----	------	------	------	------	----//
+		//	Batched queries						//
+		//----	------	------	------	------	----//
+
+	public:
+		void Nearest(
+			std::vector<Point> const& queries_,
+			std::vector<uint32_t>& indices_,
+			float maxRadius_ = std::numeric_limits<float>::infinity()
+		) const {
+			indices_.resize(queries_.size());
+			for (size_t i{ 0LLU }; i < queries_.size(); ++i) {
+				indices_[i] = Nearest(queries_[i], maxRadius_);
+			}
+		}
+
+		// Row i of the outputs holds the k_ nearest to queries_[i]; unfilled slots are Invalid and infinity.
+		void KNearest(
+			std::vector<Point> const& queries_,
+			uint32_t k_,
+			std::vector<uint32_t>& indices_,
+			std::vector<float>& dist2s_,
+			float maxRadius_ = std::numeric_limits<float>::infinity()
+		) const {
+			indices_.assign(queries_.size() * k_, Invalid);
+			dist2s_.assign(queries_.size() * k_, std::numeric_limits<float>::infinity());
+			for (size_t i{ 0LLU }; i < queries_.size(); ++i) {
+				KNearest(queries_[i], k_, &indices_[i * k_], &dist2s_[i * k_], maxRadius_);
+			}
+		}
+
+		// The hits of queries_[i] are indices_[offsets_[i], offsets_[i + 1]).
+		void InRadius(
+			std::vector<Point> const& queries_,
+			float radius_,
+			std::vector<uint32_t>& offsets_,
+			std::vector<uint32_t>& indices_
+		) const {
+			offsets_.resize(queries_.size() + 1LLU);
+			indices_.clear();
+			offsets_[0] = 0U;
+			for (size_t i{ 0LLU }; i < queries_.size(); ++i) {
+				InRadius(queries_[i], radius_, indices_);
+				offsets_[i + 1LLU] = static_cast<uint32_t>(indices_.size());
+			}
+		}
+
+		//----	------	------	------	------	----//
+
+	private:
+		static float Distance2(Point const& lhs_, Point const& rhs_) noexcept {
+			float dist2{ 0.0f };
+			for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+				float const d{ lhs_[idx_Dim] - rhs_[idx_Dim] };
+				dist2 += d * d;
+			}
+			return dist2;
+		}
+
+		// Splits along the widest axis of the range, which copes better with clustered points than cycling the axes.
+		void Split(uint32_t lo_, uint32_t hi_) {
+			while (hi_ - lo_ > LeafSize) {
+				Point min{ Entries_[lo_].Position };
+				Point max{ Entries_[lo_].Position };
+				for (uint32_t i{ lo_ + 1U }; i < hi_; ++i) {
+					for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+						min[idx_Dim] = std::min(min[idx_Dim], Entries_[i].Position[idx_Dim]);
+						max[idx_Dim] = std::max(max[idx_Dim], Entries_[i].Position[idx_Dim]);
+					}
+				}
+				uint32_t axis{ 0U };
+				for (uint32_t idx_Dim{ 1U }; idx_Dim < N_Dims; ++idx_Dim) {
+					if (max[idx_Dim] - min[idx_Dim] > max[axis] - min[axis]) { axis = idx_Dim; }
+				}
+
+				uint32_t const mid{ (lo_ + hi_) >> 1U };
+				std::nth_element(
+					Entries_.begin() + lo_, Entries_.begin() + mid, Entries_.begin() + hi_,
+					[axis] (Entry const& lhs_, Entry const& rhs_) { return lhs_.Position[axis] < rhs_.Position[axis]; }
+				);
+				SplitAxes_[mid] = static_cast<uint8_t>(axis);
+
+				Split(lo_, mid);
+				lo_ = mid + 1U;
+			}
+		}
+
+		// visit_(entry, dist2, bound2) may shrink bound2, the squared distance beyond which subtrees are skipped.
+		template<typename T_Visit>
+		void Search(Point const& query_, uint32_t lo_, uint32_t hi_, float& bound2_, T_Visit&& visit_) const {
+			while (hi_ - lo_ > LeafSize) {
+				uint32_t const mid{ (lo_ + hi_) >> 1U };
+				Entry const& node{ Entries_[mid] };
+				visit_(node, Distance2(query_, node.Position), bound2_);
+
+				// Entries before mid are <= the node on its axis and entries after are >=, so |d| bounds the far side.
+				float const d{ query_[SplitAxes_[mid]] - node.Position[SplitAxes_[mid]] };
+				if (d < 0.0f) {
+					Search(query_, lo_, mid, bound2_, visit_);
+					lo_ = mid + 1U;
+				}
+				else {
+					Search(query_, mid + 1U, hi_, bound2_, visit_);
+					hi_ = mid;
+				}
+				if (d * d > bound2_) { return; }
+			}
+			for (uint32_t i{ lo_ }; i < hi_; ++i) {
+				visit_(Entries_[i], Distance2(query_, Entries_[i].Position), bound2_);
+			}
+		}
+
+		//====	======	======	======	======	====//
+
+	private:
+		std::vector<Entry> Entries_{};
+		std::vector<uint8_t> SplitAxes_{};
+	};
+
+	INLINE_NAMESPACE_MATH_END
+}
\ No newline at end of file
@@ -1,12 +1,19 @@
 module;
 
 // Disables warning against uninitialized local variables only in the header.
+#if defined(_MSC_VER)
 #pragma warning(disable : 4700)
+#endif
 #include<External/niswegmann.small-matrix-inverse/invert4x4_sse.h>
+#if defined(_MSC_VER)
 #pragma warning(default : 4700)
+#endif
+#include<immintrin.h>
 
 // Disables warning against nameless structs/unions.
+#if defined(_MSC_VER)
 #pragma warning(disable : 4201)
+#endif
 
 //////	//////	//////	//////	//////	//////
 //////	//////	//////	//////	//////	//////
@@ -24,8 +31,6 @@ import <cmath>;
 
 import <memory>;
 
-import <immintrin.h>;
-
 //////	//////	//////	//////	//////	//////
 
 #define INLINE_NAMESPACE_MATH_BEGIN		inline namespace Math {
@@ -36,7 +41,7 @@ import <immintrin.h>;
 namespace Lumina {
 	INLINE_NAMESPACE_MATH_BEGIN
 
-	class Mat4;
+	export class Mat4;
 
 	INLINE_NAMESPACE_MATH_END
 
@@ -53,8 +58,7 @@ namespace Lumina {
 export namespace Lumina {
 	INLINE_NAMESPACE_MATH_BEGIN
 
-	__declspec(align(32U))
-	class Mat4 {
+	class alignas(32U) Mat4 {
 	public:
 		constexpr float* operator[](int idx_) noexcept { return Entries_[idx_]; }
 		constexpr float const* operator[](int idx_) const noexcept { return Entries_[idx_]; }
@@ -351,12 +355,12 @@ export namespace Lumina {
 	public:
 		static Mat4 Rotate(Float3 const& eulerAngle_) {
 			float const
-				cosAlpha{ std::cosf(eulerAngle_.x)},
-				sinAlpha{ std::sinf(eulerAngle_.x) },
-				cosBeta{ std::cosf(eulerAngle_.y) },
-				sinBeta{ std::sinf(eulerAngle_.y) },
-				cosGamma{ std::cosf(eulerAngle_.z)},
-				sinGamma{ std::sinf(eulerAngle_.z)};
+				cosAlpha{ std::cos(eulerAngle_.x)},
+				sinAlpha{ std::sin(eulerAngle_.x) },
+				cosBeta{ std::cos(eulerAngle_.y) },
+				sinBeta{ std::sin(eulerAngle_.y) },
+				cosGamma{ std::cos(eulerAngle_.z)},
+				sinGamma{ std::sin(eulerAngle_.z)};
 
 			return Mat4{
 				cosBeta * cosGamma,
@@ -381,12 +385,12 @@ export namespace Lumina {
 
 		static Mat4 SRT(Vec3 const& scale_, Vec3 const& rotate_, Vec3 const& translate_) {
 			float const
-				cosAlpha{ std::cosf(rotate_.x) },
-				sinAlpha{ std::sinf(rotate_.x) },
-				cosBeta{ std::cosf(rotate_.y) },
-				sinBeta{ std::sinf(rotate_.y) },
-				cosGamma{ std::cosf(rotate_.z) },
-				sinGamma{ std::sinf(rotate_.z) };
+				cosAlpha{ std::cos(rotate_.x) },
+				sinAlpha{ std::sin(rotate_.x) },
+				cosBeta{ std::cos(rotate_.y) },
+				sinBeta{ std::sin(rotate_.y) },
+				cosGamma{ std::cos(rotate_.z) },
+				sinGamma{ std::sin(rotate_.z) };
 
 			Mat4 srt{
 				cosBeta * cosGamma,
@@ -432,7 +436,7 @@ export namespace Lumina {
 		}
 
 		static Mat4 PerspectiveFOV(float fovY_, float aspectRatio_, float nearClip_, float farClip_) {
-			float const cotTheta{ 1.0f / std::tanf(fovY_ * 0.5f) };
+			float const cotTheta{ 1.0f / std::tan(fovY_ * 0.5f) };
 			float const inv_FrustumHeight{ 1.0f / (farClip_ - nearClip_) };
 			return Mat4{
 				(1.0f / aspectRatio_) * cotTheta, 0.0f, 0.0f, 0.0f,
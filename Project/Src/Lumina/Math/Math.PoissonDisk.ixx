@@ -0,0 +1,361 @@
+export module Lumina.Math.PoissonDisk;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <cmath>;
+import <numbers>;
+import <random>;
+
+import <array>;
+import <vector>;
+import <algorithm>;
+import <type_traits>;
+
+import <atomic>;
+import <thread>;
+
+import Lumina.Math.Vector;
+
+//////	//////	//////	//////	//////	//////
+
+#define INLINE_NAMESPACE_MATH_BEGIN		inline namespace Math {
+#define INLINE_NAMESPACE_MATH_END		}
+
+//****	******	******	******	******	****//
+
+//////	//////	//////	//////	//////	//////
+//	PoissonDisk								//
+//////	//////	//////	//////	//////	//////
+
+// Blue-noise point sets after Bridson, "Fast Poisson Disk Sampling in Arbitrary Dimensions" (2007).
+//
+// Every accepted point p carries a radius r(p) in [MinRadius, MaxRadius], and any two points p, q
+// keep dist(p, q) >= max(r(p), r(q)). The background grid uses cells of MinRadius / sqrt(N),
+// so a cell holds at most one point and a neighbourhood query visits ceil(MaxRadius / cell) cells each way.
+
+export namespace Lumina {
+	INLINE_NAMESPACE_MATH_BEGIN
+
+	template<uint32_t N_Dims> requires (N_Dims == 2U || N_Dims == 3U)
+	class PoissonDisk {
+	public:
+		using Point = std::conditional_t<(N_Dims == 2U), Vec2, Vec3>;
+
+		struct Params {
+			Point Min;
+			Point Max;
+			// Radius callbacks are clamped into [MinRadius, MaxRadius].
+			float MinRadius;
+			float MaxRadius;
+			// Candidates tried around an active point before it retires.
+			uint32_t Num_Attempts{ 30U };
+			// Darts thrown to restart growth once the active list runs dry, so that masks split into disjoint regions still fill up.
+			uint32_t Num_Seeds{ 64U };
+		};
+
+	private:
+		// Radius == 0 marks an empty cell.
+		struct Cell {
+			Point Position;
+			float Radius;
+		};
+
+		using CellCoord = std::array<int32_t, 3>;
+
+		//----	------	------	------	------	----//
+
+	public:
+		Params const& Parameters() const noexcept { return Params_; }
+		std::vector<Point> const& Points() const noexcept { return Points_; }
+
+		// Accepts the point if it lies in the domain and keeps its spacing from every accepted point.
+		// Useful for discrete candidate sets, e.g. tiles, where darts would mostly miss.
+		bool TryInsert(Point const& pos_, float radius_) {
+			float const radius{ ClampRadius(radius_) };
+			if (!IsInDomain(pos_) || !IsFarEnough(pos_, radius)) { return false; }
+			Store(pos_, radius);
+			Points_.emplace_back(pos_);
+			return true;
+		}
+
+		// Grows the point set over the whole domain, starting from the points already accepted.
+		// radius_ : Point -> float, the local spacing; a density d maps to a radius of about 1 / pow(d, 1 / N).
+		// mask_ : Point -> bool, false rejects the position (e.g. a solid tile).
+		template<typename T_Radius, typename T_Mask>
+		void Generate(std::mt19937& rndGen_, T_Radius&& radius_, T_Mask&& mask_) {
+			std::vector<Cell> actives{};
+			actives.reserve(Points_.size());
+			for (auto const& point : Points_) {
+				actives.emplace_back(Grid_[CellIndex(ToCell(point))]);
+			}
+			Grow({ 0, 0, 0 }, Num_Cells_, rndGen_, radius_, mask_, actives, Points_);
+		}
+		void Generate(std::mt19937& rndGen_) {
+			Generate(
+				rndGen_,
+				[radius = Params_.MinRadius] (Point const&) { return radius; },
+				[] (Point const&) { return true; }
+			);
+		}
+
+		// Splits the domain into tiles of at least tileCells_ grid cells per axis and grows them on num_Threads_ threads.
+		// Tiles run in 2^N phases of a checkerboard colouring; a tile spans more than the query reach,
+		// so tiles of one colour never see each other's cells. The callbacks must be safe to call concurrently.
+		// The result depends on seed_ only, not on the number of threads.
+		template<typename T_Radius, typename T_Mask>
+		void GenerateTiled(
+			uint32_t seed_,
+			T_Radius&& radius_,
+			T_Mask&& mask_,
+			int32_t tileCells_ = 64,
+			uint32_t num_Threads_ = std::thread::hardware_concurrency()
+		) {
+			int32_t const tileSize{ std::max(tileCells_, Reach_ + 1) };
+			CellCoord num_Tiles{ 1, 1, 1 };
+			for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+				num_Tiles[idx_Dim] = (Num_Cells_[idx_Dim] + tileSize - 1) / tileSize;
+			}
+			uint32_t const num_TilesTotal{ static_cast<uint32_t>(num_Tiles[0] * num_Tiles[1] * num_Tiles[2]) };
+
+			std::vector<std::vector<Point>> tilePoints(num_TilesTotal);
+			std::vector<uint32_t> tiles{};
+			tiles.reserve(num_TilesTotal);
+
+			auto const growTile{
+				[&] (uint32_t idx_Tile_) {
+					CellCoord const tile{
+						static_cast<int32_t>(idx_Tile_ % static_cast<uint32_t>(num_Tiles[0])),
+						static_cast<int32_t>((idx_Tile_ / static_cast<uint32_t>(num_Tiles[0])) % static_cast<uint32_t>(num_Tiles[1])),
+						static_cast<int32_t>(idx_Tile_ / static_cast<uint32_t>(num_Tiles[0] * num_Tiles[1])),
+					};
+					CellCoord first{ 0, 0, 0 };
+					CellCoord last{ 1, 1, 1 };
+					for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+						first[idx_Dim] = tile[idx_Dim] * tileSize;
+						last[idx_Dim] = std::min(first[idx_Dim] + tileSize, Num_Cells_[idx_Dim]);
+					}
+
+					std::seed_seq seq{ seed_, idx_Tile_ };
+					std::mt19937 rndGen{ seq };
+					std::vector<Cell> actives{};
+					Grow(first, last, rndGen, radius_, mask_, actives, tilePoints[idx_Tile_]);
+				}
+			};
+
+			uint32_t const num_Threads{ std::max(num_Threads_, 1U) };
+			for (uint32_t color{ 0U }; color < (1U << N_Dims); ++color) {
+				tiles.clear();
+				for (uint32_t idx_Tile{ 0U }; idx_Tile < num_TilesTotal; ++idx_Tile) {
+					uint32_t const x{ idx_Tile % static_cast<uint32_t>(num_Tiles[0]) };
+					uint32_t const y{ (idx_Tile / static_cast<uint32_t>(num_Tiles[0])) % static_cast<uint32_t>(num_Tiles[1]) };
+					uint32_t const z{ idx_Tile / static_cast<uint32_t>(num_Tiles[0] * num_Tiles[1]) };
+					if (((x & 1U) | ((y & 1U) << 1U) | ((z & 1U) << 2U)) == color) { tiles.emplace_back(idx_Tile); }
+				}
+
+				std::atomic<uint32_t> next{ 0U };
+				auto const worker{
+					[&] () {
+						for (uint32_t idx{ next++ }; idx < static_cast<uint32_t>(tiles.size()); idx = next++) {
+							growTile(tiles[idx]);
+						}
+					}
+				};
+				std::vector<std::thread> threads{};
+				for (uint32_t idx_Thread{ 1U }; idx_Thread < std::min(num_Threads, static_cast<uint32_t>(tiles.size())); ++idx_Thread) {
+					threads.emplace_back(worker);
+				}
+				worker();
+				for (auto& thread : threads) { thread.join(); }
+			}
+
+			for (auto const& points : tilePoints) {
+				Points_.insert(Points_.end(), points.cbegin(), points.cend());
+			}
+		}
+
+		//----	------	------	------	------	----//
+
+	private:
+		float ClampRadius(float radius_) const noexcept {
+			return std::clamp(radius_, Params_.MinRadius, Params_.MaxRadius);
+		}
+
+		bool IsInDomain(Point const& pos_) const noexcept {
+			for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+				if (!(pos_[idx_Dim] >= Params_.Min[idx_Dim] && pos_[idx_Dim] < Params_.Max[idx_Dim])) { return false; }
+			}
+			return true;
+		}
+
+		CellCoord ToCell(Point const& pos_) const noexcept {
+			CellCoord cell{ 0, 0, 0 };
+			for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+				cell[idx_Dim] = std::min(
+					static_cast<int32_t>((pos_[idx_Dim] - Params_.Min[idx_Dim]) * Inv_CellSize_),
+					Num_Cells_[idx_Dim] - 1
+				);
+			}
+			return cell;
+		}
+
+		size_t CellIndex(CellCoord const& cell_) const noexcept {
+			return (static_cast<size_t>(cell_[2]) * Num_Cells_[1] + cell_[1]) * Num_Cells_[0] + cell_[0];
+		}
+
+		bool IsFarEnough(Point const& pos_, float radius_) const noexcept {
+			CellCoord const cell{ ToCell(pos_) };
+			// Most rejected candidates land in an occupied cell.
+			if (Grid_[CellIndex(cell)].Radius != 0.0f) { return false; }
+
+			CellCoord first{ 0, 0, 0 };
+			CellCoord last{ 0, 0, 0 };
+			for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+				first[idx_Dim] = std::max(cell[idx_Dim] - Reach_, 0);
+				last[idx_Dim] = std::min(cell[idx_Dim] + Reach_, Num_Cells_[idx_Dim] - 1);
+			}
+
+			for (int32_t z{ first[2] }; z <= last[2]; ++z) {
+				for (int32_t y{ first[1] }; y <= last[1]; ++y) {
+					Cell const* row{ &Grid_[CellIndex({ 0, y, z })] };
+					for (int32_t x{ first[0] }; x <= last[0]; ++x) {
+						Cell const& neighbour{ row[x] };
+						if (neighbour.Radius == 0.0f) { continue; }
+
+						float dist2{ 0.0f };
+						for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+							float const d{ pos_[idx_Dim] - neighbour.Position[idx_Dim] };
+							dist2 += d * d;
+						}
+						float const spacing{ std::max(radius_, neighbour.Radius) };
+						if (dist2 < spacing * spacing) { return false; }
+					}
+				}
+			}
+			return true;
+		}
+
+		void Store(Point const& pos_, float radius_) noexcept {
+			Grid_[CellIndex(ToCell(pos_))] = Cell{ pos_, radius_ };
+		}
+
+		// [0, 1) from the top 24 bits; std::uniform_real_distribution costs more than the rest of a candidate.
+		static float Unit(std::mt19937& rndGen_) noexcept {
+			return static_cast<float>(rndGen_() >> 8U) * 0x1.0p-24f;
+		}
+
+		// Uniform over the shell [radius_, 2 radius_] around center_.
+		static Point Candidate(Point const& center_, float radius_, std::mt19937& rndGen_) noexcept {
+			if constexpr (N_Dims == 2U) {
+				float const theta{ 2.0f * std::numbers::pi_v<float> * Unit(rndGen_) };
+				float const r{ radius_ * std::sqrt(1.0f + 3.0f * Unit(rndGen_)) };
+				return Point{ center_.x + r * std::cos(theta), center_.y + r * std::sin(theta) };
+			}
+			else {
+				float const z{ 2.0f * Unit(rndGen_) - 1.0f };
+				float const phi{ 2.0f * std::numbers::pi_v<float> * Unit(rndGen_) };
+				float const s{ std::sqrt(std::max(1.0f - z * z, 0.0f)) };
+				float const r{ radius_ * std::cbrt(1.0f + 7.0f * Unit(rndGen_)) };
+				return Point{ center_.x + r * s * std::cos(phi), center_.y + r * s * std::sin(phi), center_.z + r * z };
+			}
+		}
+
+		// Runs Bridson's active-list loop, accepting only points whose cell lies in [first_, last_).
+		template<typename T_Radius, typename T_Mask>
+		void Grow(
+			CellCoord const& first_,
+			CellCoord const& last_,
+			std::mt19937& rndGen_,
+			T_Radius& radius_,
+			T_Mask& mask_,
+			std::vector<Cell>& actives_,
+			std::vector<Point>& points_
+		) {
+			Point min_Region{};
+			Point max_Region{};
+			for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+				min_Region[idx_Dim] = Params_.Min[idx_Dim] + static_cast<float>(first_[idx_Dim]) * CellSize_;
+				max_Region[idx_Dim] = std::min(Params_.Min[idx_Dim] + static_cast<float>(last_[idx_Dim]) * CellSize_, Params_.Max[idx_Dim]);
+			}
+
+			auto const tryAccept{
+				[&] (Point const& pos_) {
+					if (!IsInDomain(pos_)) { return false; }
+					CellCoord const cell{ ToCell(pos_) };
+					for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+						if (cell[idx_Dim] < first_[idx_Dim] || cell[idx_Dim] >= last_[idx_Dim]) { return false; }
+					}
+					if (!mask_(pos_)) { return false; }
+
+					float const radius{ ClampRadius(radius_(pos_)) };
+					if (!IsFarEnough(pos_, radius)) { return false; }
+
+					Store(pos_, radius);
+					points_.emplace_back(pos_);
+					actives_.emplace_back(Cell{ pos_, radius });
+					return true;
+				}
+			};
+
+			for (;;) {
+				while (!actives_.empty()) {
+					size_t const idx_Active{ static_cast<size_t>(rndGen_() % static_cast<uint32_t>(actives_.size())) };
+					Cell const active{ actives_[idx_Active] };
+
+					bool isFound{ false };
+					for (uint32_t cnt_Attempt{ 0U }; cnt_Attempt < Params_.Num_Attempts && !isFound; ++cnt_Attempt) {
+						isFound = tryAccept(Candidate(active.Position, active.Radius, rndGen_));
+					}
+					if (!isFound) {
+						actives_[idx_Active] = actives_.back();
+						actives_.pop_back();
+					}
+				}
+
+				bool isSeeded{ false };
+				for (uint32_t cnt_Seed{ 0U }; cnt_Seed < Params_.Num_Seeds && !isSeeded; ++cnt_Seed) {
+					Point dart{};
+					for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+						dart[idx_Dim] = min_Region[idx_Dim] + (max_Region[idx_Dim] - min_Region[idx_Dim]) * Unit(rndGen_);
+					}
+					isSeeded = tryAccept(dart);
+				}
+				if (!isSeeded) { break; }
+			}
+		}
+
+		//====	======	======	======	======	====//
+
+	public:
+		explicit PoissonDisk(Params const& params_) :
+			Params_{ params_ } {
+			Params_.MaxRadius = std::max(Params_.MaxRadius, Params_.MinRadius);
+			CellSize_ = Params_.MinRadius / std::sqrt(static_cast<float>(N_Dims));
+			Inv_CellSize_ = 1.0f / CellSize_;
+			Reach_ = static_cast<int32_t>(std::ceil(Params_.MaxRadius * Inv_CellSize_));
+
+			size_t num_Cells{ 1LLU };
+			for (uint32_t idx_Dim{ 0U }; idx_Dim < N_Dims; ++idx_Dim) {
+				Num_Cells_[idx_Dim] = std::max(
+					static_cast<int32_t>(std::ceil((Params_.Max[idx_Dim] - Params_.Min[idx_Dim]) * Inv_CellSize_)),
+					1
+				);
+				num_Cells *= static_cast<size_t>(Num_Cells_[idx_Dim]);
+			}
+			Grid_.assign(num_Cells, Cell{});
+		}
+
+	private:
+		Params Params_{};
+		float CellSize_{};
+		float Inv_CellSize_{};
+		int32_t Reach_{};
+		CellCoord Num_Cells_{ 1, 1, 1 };
+
+		std::vector<Cell> Grid_{};
+		std::vector<Point> Points_{};
+	};
+
+	INLINE_NAMESPACE_MATH_END
+}
\ No newline at end of file
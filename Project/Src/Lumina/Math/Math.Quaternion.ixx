@@ -1,7 +1,9 @@
 module;
 
 // Disables warning against nameless structs/unions.
+#if defined(_MSC_VER)
 #pragma warning(disable : 4201)
+#endif
 
 //////	//////	//////	//////	//////	//////
 //////	//////	//////	//////	//////	//////
@@ -12,6 +14,7 @@ export module Lumina.Math.Quaternion;
 //****	******	******	******	******	****//
 
 import <cmath>;
+import <cstring>;
 
 import Lumina.Math.Numerics;
 import Lumina.Math.Vector;
@@ -97,7 +100,7 @@ namespace Lumina {
 				);
 			}
 
-			static constexpr auto Rotate(Vec4 const& vec4_, Quaternion const& quat_) noexcept -> Vec4 {
+			static auto Rotate(Vec4 const& vec4_, Quaternion const& quat_) noexcept -> Vec4 {
 				Quaternion&& vec4_Rotated{ quat_ * Quaternion{ vec4_ } *quat_.Reciprocal() };
 				return Vec4{ reinterpret_cast<float const*>(&vec4_Rotated) };
 			}
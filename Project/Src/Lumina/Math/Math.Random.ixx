@@ -13,13 +13,6 @@ import <memory>;
 
 //****	******	******	******	******	****//
 
-namespace {
-	template<typename T>
-	using UniPtr = std::unique_ptr<T>;
-}
-
-//****	******	******	******	******	****//
-
 namespace Lumina {
 	INLINE_NAMESPACE_NUMERICS_BEGIN
 
@@ -36,7 +29,7 @@ namespace Lumina {
 
 	public:
 		static inline Engine& Generator() {
-			static UniPtr<Engine> engine{ new Engine{} };
+			static std::unique_ptr<Engine> engine{ new Engine{} };
 			return *engine;
 		}
 	};
@@ -0,0 +1,271 @@
+export module Lumina.Math.SpanningTree;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <cmath>;
+
+import <vector>;
+import <algorithm>;
+import <limits>;
+
+import Lumina.Math.Numerics;
+import Lumina.Container.DisjointSet;
+
+//////	//////	//////	//////	//////	//////
+
+#define INLINE_NAMESPACE_MATH_BEGIN		inline namespace Math {
+#define INLINE_NAMESPACE_MATH_END		}
+
+//****	******	******	******	******	****//
+
+//////	//////	//////	//////	//////	//////
+//	RegionSpanningTree						//
+//////	//////	//////	//////	//////	//////
+
+// Links regions of a grid (caves, rooms, islands) with a minimum spanning tree over the distances between them,
+// each link joining the closest cells of its two regions.
+//
+//	- Regions are given by their sites, the cells on their boundary; the closest pair of cells of two regions
+//	  is always a pair of boundary cells, so nothing inside a region needs looking at.
+//	- Sites are bucketed in a uniform grid of Radius cells, so that every pair of sites at most Radius apart
+//	  lies in neighbouring buckets. Each site keeps its nearest site of every other region found there,
+//	  and Kruskal's algorithm runs over those candidates, with union-find over the regions.
+//	- While the regions are not all joined the radius doubles, and only pairs still in different trees are looked for.
+//	  Every such pair is longer than all links taken so far, so the tree stays minimal. Those searches start from
+//	  the sites outside the largest tree only, which by then holds most of them.
+//	- Extra links, the shortest candidates the tree did not take, close loops.
+
+export namespace Lumina {
+	INLINE_NAMESPACE_MATH_BEGIN
+
+	class RegionSpanningTree {
+	public:
+		struct Site {
+			Int2 Cell;
+			uint32_t Region;
+		};
+
+		struct Link {
+			Int2 From;
+			Int2 To;
+			uint32_t Region0;
+			uint32_t Region1;
+			uint32_t Distance2;
+		};
+
+		struct Params {
+			// Extra links as a fraction of the tree's, for loops.
+			float Ratio_ExtraLinks{ 0.0f };
+			// Of the first search, in cells.
+			uint32_t InitialRadius{ 8U };
+		};
+
+	private:
+		struct Candidate {
+			uint64_t Regions;
+			uint32_t Distance2;
+			uint32_t Site0;
+			uint32_t Site1;
+		};
+
+		//----	------	------	------	------	----//
+
+	public:
+		// sites_ hold the boundary cells of regions 0 .. num_Regions_ - 1, each region with at least one.
+		void Build(uint32_t num_Regions_, std::vector<Site> const& sites_, Params const& params_);
+		void Build(uint32_t num_Regions_, std::vector<Site> const& sites_) { Build(num_Regions_, sites_, Params{}); }
+
+	public:
+		// The tree's links, shortest first, then the extra ones.
+		std::vector<Link> const& Links() const noexcept { return Links_; }
+		uint32_t Num_TreeLinks() const noexcept { return Num_TreeLinks_; }
+		// The radius the last search ran at.
+		uint32_t Radius() const noexcept { return Radius_; }
+
+	private:
+		// The tree holding the most sites; the one the searches after the first had best not start from.
+		uint32_t LargestTree(uint32_t num_Regions_, std::vector<Site> const& sites_);
+		// extent_: the larger side of the sites' bounds, in cells.
+		void Bucket(std::vector<Site> const& sites_, uint32_t extent_);
+		// Appends each site's nearest site, within Radius_, of every region not yet in its tree.
+		// The sites of skipTree_ only get found from the other side.
+		void FindCandidates(std::vector<Site> const& sites_, uint32_t skipTree_);
+
+		//====	======	======	======	======	====//
+
+	private:
+		std::vector<Link> Links_{};
+		uint32_t Num_TreeLinks_{ 0U };
+
+		DisjointSet Trees_{};
+		std::vector<Candidate> Candidates_{};
+		std::vector<Candidate> Rejected_{};
+
+		// Sites by bucket, row-major; Offsets_[i] .. Offsets_[i + 1] index Order_ for bucket i.
+		std::vector<uint32_t> Offsets_{};
+		std::vector<uint32_t> Order_{};
+		Int2 Origin_{ 0, 0 };
+		uint32_t Num_BucketsX_{ 0U };
+		uint32_t Num_BucketsY_{ 0U };
+		uint32_t Radius_{ 0U };
+
+		static constexpr uint32_t NoTree{ 0xFFFFFFFFU };
+	};
+
+	//----	------	------	------	------	----//
+
+	void RegionSpanningTree::Build(uint32_t num_Regions_, std::vector<Site> const& sites_, Params const& params_) {
+		Links_.clear();
+		Num_TreeLinks_ = 0U;
+		Rejected_.clear();
+		Trees_.Reset(num_Regions_);
+		if (num_Regions_ < 2U) { return; }
+
+		Int2 min{ std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::max() };
+		Int2 max{ std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::min() };
+		for (auto const& site : sites_) {
+			min = { std::min(min.x, site.Cell.x), std::min(min.y, site.Cell.y) };
+			max = { std::max(max.x, site.Cell.x), std::max(max.y, site.Cell.y) };
+		}
+		Origin_ = min;
+		uint32_t const extent{ static_cast<uint32_t>(std::max(max.x - min.x, max.y - min.y)) + 1U };
+
+		auto const toLink{
+			[&sites_] (Candidate const& candidate_) {
+				return Link{
+					.From{ sites_[candidate_.Site0].Cell },
+					.To{ sites_[candidate_.Site1].Cell },
+					.Region0{ sites_[candidate_.Site0].Region },
+					.Region1{ sites_[candidate_.Site1].Region },
+					.Distance2{ candidate_.Distance2 },
+				};
+			}
+		};
+
+		// Once the radius spans the diagonal of the bounds every pair is a candidate, so the loop ends there at the latest.
+		for (Radius_ = std::max(params_.InitialRadius, 1U); Num_TreeLinks_ + 1U < num_Regions_; Radius_ *= 2U) {
+			Bucket(sites_, extent);
+			Candidates_.clear();
+			FindCandidates(sites_, (Num_TreeLinks_ == 0U) ? NoTree : LargestTree(num_Regions_, sites_));
+
+			// The nearest pair for each two regions, then Kruskal over those, shortest first.
+			std::sort(
+				Candidates_.begin(), Candidates_.end(),
+				[] (Candidate const& lhs_, Candidate const& rhs_) {
+					return (lhs_.Regions != rhs_.Regions) ? (lhs_.Regions < rhs_.Regions) : (lhs_.Distance2 < rhs_.Distance2);
+				}
+			);
+			Candidates_.erase(
+				std::unique(
+					Candidates_.begin(), Candidates_.end(),
+					[] (Candidate const& lhs_, Candidate const& rhs_) { return lhs_.Regions == rhs_.Regions; }
+				),
+				Candidates_.end()
+			);
+			std::stable_sort(
+				Candidates_.begin(), Candidates_.end(),
+				[] (Candidate const& lhs_, Candidate const& rhs_) { return lhs_.Distance2 < rhs_.Distance2; }
+			);
+
+			for (auto const& candidate : Candidates_) {
+				if (Trees_.Union(sites_[candidate.Site0].Region, sites_[candidate.Site1].Region)) {
+					Links_.emplace_back(toLink(candidate));
+					++Num_TreeLinks_;
+				}
+				else { Rejected_.emplace_back(candidate); }
+			}
+
+			if (Radius_ >= 2U * extent) { break; }
+		}
+
+		uint32_t const num_Extra{
+			std::min(
+				static_cast<uint32_t>(std::lround(params_.Ratio_ExtraLinks * static_cast<float>(Num_TreeLinks_))),
+				static_cast<uint32_t>(Rejected_.size())
+			)
+		};
+		// Later rounds only add longer candidates, so Rejected_ is in order already.
+		for (uint32_t i{ 0U }; i < num_Extra; ++i) { Links_.emplace_back(toLink(Rejected_[i])); }
+	}
+
+	void RegionSpanningTree::Bucket(std::vector<Site> const& sites_, uint32_t extent_) {
+		Num_BucketsX_ = (extent_ + Radius_ - 1U) / Radius_;
+		Num_BucketsY_ = Num_BucketsX_;
+
+		auto const bucketOf{
+			[this] (Int2 const& cell_) {
+				uint32_t const x{ static_cast<uint32_t>(cell_.x - Origin_.x) / Radius_ };
+				uint32_t const y{ static_cast<uint32_t>(cell_.y - Origin_.y) / Radius_ };
+				return y * Num_BucketsX_ + x;
+			}
+		};
+
+		// Counting sort of the sites by bucket.
+		Offsets_.assign(static_cast<size_t>(Num_BucketsX_) * Num_BucketsY_ + 1LLU, 0U);
+		for (auto const& site : sites_) { ++Offsets_[bucketOf(site.Cell) + 1U]; }
+		for (size_t i{ 1LLU }; i < Offsets_.size(); ++i) { Offsets_[i] += Offsets_[i - 1LLU]; }
+
+		Order_.resize(sites_.size());
+		std::vector<uint32_t> cursors(Offsets_.begin(), Offsets_.end() - 1);
+		for (uint32_t idx_Site{ 0U }; idx_Site < static_cast<uint32_t>(sites_.size()); ++idx_Site) {
+			Order_[cursors[bucketOf(sites_[idx_Site].Cell)]++] = idx_Site;
+		}
+	}
+
+	uint32_t RegionSpanningTree::LargestTree(uint32_t num_Regions_, std::vector<Site> const& sites_) {
+		std::vector<uint32_t> num_Sites(num_Regions_, 0U);
+		for (auto const& site : sites_) { ++num_Sites[Trees_.Find(site.Region)]; }
+		return static_cast<uint32_t>(std::ranges::max_element(num_Sites) - num_Sites.begin());
+	}
+
+	void RegionSpanningTree::FindCandidates(std::vector<Site> const& sites_, uint32_t skipTree_) {
+		uint32_t const radius2{ Radius_ * Radius_ };
+		// With no tree skipped each pair is looked at once, from the site that comes first in bucket order, over half
+		// the neighbouring buckets. Otherwise every bucket around is searched, as the other site may be one that is skipped.
+		bool const isHalf{ skipTree_ == NoTree };
+		std::vector<Candidate> nearest{};
+
+		for (uint32_t by{ 0U }; by < Num_BucketsY_; ++by) {
+			for (uint32_t bx{ 0U }; bx < Num_BucketsX_; ++bx) {
+				uint32_t const idx_Bucket{ by * Num_BucketsX_ + bx };
+				for (uint32_t i{ Offsets_[idx_Bucket] }; i < Offsets_[idx_Bucket + 1U]; ++i) {
+					uint32_t const idx_Site{ Order_[i] };
+					Site const& site{ sites_[idx_Site] };
+					uint32_t const tree{ Trees_.Find(site.Region) };
+					if (tree == skipTree_) { continue; }
+
+					nearest.clear();
+					for (uint32_t ny{ (isHalf || by == 0U) ? by : by - 1U }; ny <= std::min(by + 1U, Num_BucketsY_ - 1U); ++ny) {
+						uint32_t const nxBegin{ (isHalf && ny == by) ? bx : ((bx > 0U) ? bx - 1U : 0U) };
+						for (uint32_t nx{ nxBegin }; nx <= std::min(bx + 1U, Num_BucketsX_ - 1U); ++nx) {
+							uint32_t const idx_Neighbour{ ny * Num_BucketsX_ + nx };
+							uint32_t const first{ (isHalf && idx_Neighbour == idx_Bucket) ? i + 1U : Offsets_[idx_Neighbour] };
+							for (uint32_t j{ first }; j < Offsets_[idx_Neighbour + 1U]; ++j) {
+								uint32_t const idx_Other{ Order_[j] };
+								Site const& other{ sites_[idx_Other] };
+								if (other.Region == site.Region || Trees_.Find(other.Region) == tree) { continue; }
+
+								int32_t const dx{ other.Cell.x - site.Cell.x };
+								int32_t const dy{ other.Cell.y - site.Cell.y };
+								uint32_t const distance2{ static_cast<uint32_t>(dx * dx + dy * dy) };
+								if (distance2 > radius2) { continue; }
+
+								uint64_t const regions{
+									(static_cast<uint64_t>(std::min(site.Region, other.Region)) << 32U) | std::max(site.Region, other.Region)
+								};
+								auto const found{ std::ranges::find(nearest, regions, &Candidate::Regions) };
+								if (found == nearest.end()) { nearest.emplace_back(regions, distance2, idx_Site, idx_Other); }
+								else if (distance2 < found->Distance2) { *found = { regions, distance2, idx_Site, idx_Other }; }
+							}
+						}
+					}
+					Candidates_.insert(Candidates_.end(), nearest.begin(), nearest.end());
+				}
+			}
+		}
+	}
+
+	INLINE_NAMESPACE_MATH_END
+}
\ No newline at end of file
@@ -1,10 +1,18 @@
+module;
+
+#include<immintrin.h>
+
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+
 export module Lumina.Math.Vector;
 
 //****	******	******	******	******	****//
 
-import <cmath>;
+import <cstdint>;
 
-import <immintrin.h>;
+import <cmath>;
 
 //////	//////	//////	//////	//////	//////
 
@@ -16,9 +24,9 @@ import <immintrin.h>;
 namespace Lumina {
 	INLINE_NAMESPACE_MATH_BEGIN
 
-	class Vec2;
-	class Vec3;
-	class Vec4;
+	export class Vec2;
+	export class Vec3;
+	export class Vec4;
 
 	INLINE_NAMESPACE_MATH_END
 }
@@ -127,8 +135,7 @@ export namespace Lumina {
 
 	// Credits: https://github.com/pelletier/vector3/blob/master/vector3.h
 
-	__declspec(align(16U))
-	class Vec3 {
+	class alignas(16U) Vec3 {
 		friend Vec4;
 
 		//====	======	======	======	======	====//
@@ -299,8 +306,7 @@ export namespace Lumina {
 export namespace Lumina {
 	INLINE_NAMESPACE_MATH_BEGIN
 
-	__declspec(align(16U))
-	class Vec4 {
+	class alignas(16U) Vec4 {
 		friend Vec3;
 
 		//====	======	======	======	======	====//
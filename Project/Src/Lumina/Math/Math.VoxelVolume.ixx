@@ -0,0 +1,740 @@
+export module Lumina.Math.VoxelVolume;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cassert>;
+
+import <bit>;
+import <array>;
+import <vector>;
+import <algorithm>;
+import <utility>;
+import <limits>;
+
+import Lumina.Math.Numerics;
+import Lumina.Container.FlatHashMap;
+import Lumina.Container.DisjointSet;
+
+//////	//////	//////	//////	//////	//////
+
+#define INLINE_NAMESPACE_MATH_BEGIN		inline namespace Math {
+#define INLINE_NAMESPACE_MATH_END		}
+
+//****	******	******	******	******	****//
+
+// Volumes of one bit per voxel, kept sparse as 8 x 8 x 8 bricks in a hash grid: only bricks holding a set voxel take memory,
+// so caves carved out of solid rock cost in proportion to their air rather than to the volume around it.
+//
+//	- Voxel (x, y, z) of a brick is bit (y % 8) * 8 + x % 8 of its word z % 8; a brick is eight words, one cache line.
+//	- Bricks sit in one array in the order they were made, found through a FlatHashMap from their packed coordinates.
+//	- VoxelAutomaton steps life-like rules over the 26 neighbours, bit-sliced as CellularAutomaton does in 2D: each slice
+//	  is summed with its neighbours shifted in from the adjacent bricks, 64 voxels per operation. Only bricks with a voxel
+//	  set, and those beside them, are visited; bricks that come out empty are dropped.
+//	- VoxelComponents labels 6-connected components: flood fills by bit dilation within each brick,
+//	  then union-find over those pieces across brick faces.
+//	- Outside the volume, and in bricks never made, every voxel is unset.
+
+//////	//////	//////	//////	//////	//////
+//	SparseVoxelVolume						//
+//////	//////	//////	//////	//////	//////
+
+export namespace Lumina {
+	INLINE_NAMESPACE_MATH_BEGIN
+
+	// Bit n of Birth: an unset voxel with n of its 26 neighbours set becomes set. Bit n of Survival: a set one with n stays set.
+	struct VoxelRule {
+		uint32_t Birth;
+		uint32_t Survival;
+
+		// Set with at least birth_ set neighbours, kept with at least survival_; birth_ must be 1 or more.
+		static constexpr VoxelRule AtLeast(uint32_t birth_, uint32_t survival_) noexcept {
+			constexpr uint32_t all{ (1U << 27U) - 1U };
+			return VoxelRule{
+				.Birth{ all & ~((1U << birth_) - 1U) },
+				.Survival{ all & ~((1U << survival_) - 1U) },
+			};
+		}
+	};
+
+	class SparseVoxelVolume {
+	public:
+		// One word per z; bit y * 8 + x of each.
+		using Brick = std::array<uint64_t, 8>;
+
+		static constexpr uint32_t BrickSize{ 8U };
+		static constexpr uint32_t InvalidBrick{ std::numeric_limits<uint32_t>::max() };
+
+	public:
+		bool operator()(uint32_t x_, uint32_t y_, uint32_t z_) const noexcept {
+			assert(x_ < Width_ && y_ < Height_ && z_ < Depth_);
+			uint32_t const idx_Brick{ FindBrick({ static_cast<int32_t>(x_ >> 3U), static_cast<int32_t>(y_ >> 3U), static_cast<int32_t>(z_ >> 3U) }) };
+			return (idx_Brick != InvalidBrick) && ((Bricks_[idx_Brick][z_ & 7U] >> (((y_ & 7U) << 3U) | (x_ & 7U))) & 1LLU);
+		}
+		// Unsetting leaves the brick in place, empty or not; Compact() drops the empty ones.
+		void Set(uint32_t x_, uint32_t y_, uint32_t z_, bool isSet_);
+		// Sets every voxel within radius_ of center_, clipped to the volume.
+		void FillSphere(Int3 const& center_, int32_t radius_);
+
+		// Leaves in surface_ the set voxels with at least one of their six neighbours unset.
+		void ExtractSurface(SparseVoxelVolume& surface_) const;
+
+	public:
+		uint32_t Num_Bricks() const noexcept { return static_cast<uint32_t>(Bricks_.size()); }
+		// idx_Brick_ in 0 .. Num_Bricks() - 1
+		Brick& GetBrick(uint32_t idx_Brick_) noexcept { return Bricks_[idx_Brick_]; }
+		Brick const& GetBrick(uint32_t idx_Brick_) const noexcept { return Bricks_[idx_Brick_]; }
+		// In bricks; the voxel at its origin is 8 times that.
+		Int3 BrickCoord(uint32_t idx_Brick_) const noexcept {
+			uint64_t const key{ Keys_[idx_Brick_] };
+			return { static_cast<int32_t>(key & KeyMask), static_cast<int32_t>((key >> 21U) & KeyMask), static_cast<int32_t>(key >> 42U) };
+		}
+
+		// InvalidBrick for a brick never made, or outside the volume.
+		uint32_t FindBrick(Int3 const& brick_) const noexcept {
+			if (!IsInside(brick_)) { return InvalidBrick; }
+			auto const it{ Index_.find(Key(brick_)) };
+			return (it != Index_.end()) ? it->second : InvalidBrick;
+		}
+		// Makes the brick, all unset, if it is not there yet; it must be inside the volume.
+		uint32_t TouchBrick(Int3 const& brick_) {
+			assert(IsInside(brick_));
+			auto const [it, isInserted]{ Index_.try_emplace(Key(brick_), Num_Bricks()) };
+			if (isInserted) {
+				Bricks_.emplace_back();
+				Keys_.emplace_back(Key(brick_));
+			}
+			return it->second;
+		}
+		bool IsInside(Int3 const& brick_) const noexcept {
+			return
+				static_cast<uint32_t>(brick_.x) < (Width_ >> 3U) &&
+				static_cast<uint32_t>(brick_.y) < (Height_ >> 3U) &&
+				static_cast<uint32_t>(brick_.z) < (Depth_ >> 3U);
+		}
+
+		// Drops the bricks with no voxel set; the others keep their order.
+		void Compact();
+
+	public:
+		uint32_t Width() const noexcept { return Width_; }
+		uint32_t Height() const noexcept { return Height_; }
+		uint32_t Depth() const noexcept { return Depth_; }
+
+		uint64_t Num_Voxels() const noexcept;
+		// Bytes held by the bricks and their index, spare capacity included.
+		size_t MemoryUsage() const noexcept {
+			return
+				sizeof(Brick) * Bricks_.capacity() + sizeof(uint64_t) * Keys_.capacity() +
+				(sizeof(std::pair<uint64_t, uint32_t>) + 1LLU) * Index_.capacity();
+		}
+
+		// Every voxel unset; storage is kept for reuse. Sizes are whole bricks, up to 2^21 of them along each axis.
+		void Resize(uint32_t width_, uint32_t height_, uint32_t depth_) {
+			assert(((width_ | height_ | depth_) & 7U) == 0U);
+			assert((width_ >> 3U) <= KeyMask + 1LLU && (height_ >> 3U) <= KeyMask + 1LLU && (depth_ >> 3U) <= KeyMask + 1LLU);
+			Width_ = width_;
+			Height_ = height_;
+			Depth_ = depth_;
+			Bricks_.clear();
+			Keys_.clear();
+			Index_.clear();
+		}
+		void Reserve(uint32_t num_Bricks_) {
+			Bricks_.reserve(num_Bricks_);
+			Keys_.reserve(num_Bricks_);
+			Index_.reserve(num_Bricks_);
+		}
+
+	public:
+		SparseVoxelVolume() = default;
+		SparseVoxelVolume(uint32_t width_, uint32_t height_, uint32_t depth_) { Resize(width_, height_, depth_); }
+
+		// Brick coordinates packed 21 bits each; what the index is keyed by.
+		static uint64_t Key(Int3 const& brick_) noexcept {
+			return
+				static_cast<uint64_t>(static_cast<uint32_t>(brick_.x)) |
+				(static_cast<uint64_t>(static_cast<uint32_t>(brick_.y)) << 21U) |
+				(static_cast<uint64_t>(static_cast<uint32_t>(brick_.z)) << 42U);
+		}
+
+	private:
+		static constexpr uint64_t KeyMask{ (1LLU << 21U) - 1LLU };
+
+		//====	======	======	======	======	====//
+
+	private:
+		std::vector<Brick> Bricks_{};
+		// Packed brick coordinates, by brick.
+		std::vector<uint64_t> Keys_{};
+		FlatHashMap<uint64_t, uint32_t> Index_{};
+
+		uint32_t Width_{ 0U };
+		uint32_t Height_{ 0U };
+		uint32_t Depth_{ 0U };
+	};
+
+	class VoxelAutomaton {
+	public:
+		// Steps every voxel at once, num_Steps_ times. The rule must not set a voxel with no neighbour set, Birth bit 0,
+		// as that would fill every brick never made.
+		void Step(VoxelRule const& rule_, uint32_t num_Steps_ = 1U);
+
+	public:
+		// The current generation; stepping swaps buffers, so take it again afterwards.
+		SparseVoxelVolume& Volume() noexcept { return Current_; }
+		SparseVoxelVolume const& Volume() const noexcept { return Current_; }
+
+		// Every voxel unset.
+		void Resize(uint32_t width_, uint32_t height_, uint32_t depth_) {
+			Current_.Resize(width_, height_, depth_);
+			Next_.Resize(width_, height_, depth_);
+		}
+
+		//====	======	======	======	======	====//
+
+	private:
+		SparseVoxelVolume Current_{};
+		SparseVoxelVolume Next_{};
+		// Bricks not in the current generation that a voxel beside them may set.
+		std::vector<Int3> Frontier_{};
+		FlatHashMap<uint64_t, bool> IsQueued_{};
+	};
+
+	class VoxelComponents {
+	public:
+		// The label of the voxels in no component.
+		static constexpr uint32_t Background{ 0U };
+
+		struct Component {
+			uint64_t Volume;
+			// Inclusive bounds, in voxels.
+			Int3 Min;
+			Int3 Max;
+		};
+
+	private:
+		// The voxels of one component within one brick.
+		struct Piece {
+			SparseVoxelVolume::Brick Mask;
+			uint32_t Label;
+		};
+
+		//----	------	------	------	------	----//
+
+	public:
+		// Numbers components from 1 in the order of the volume's bricks, and of their lowest voxel within the first brick.
+		void Label(SparseVoxelVolume const& volume_);
+
+	public:
+		uint32_t Num_Components() const noexcept { return static_cast<uint32_t>(Components_.size()); }
+
+		// volume_ must be the one last labelled, unchanged since.
+		uint32_t operator()(SparseVoxelVolume const& volume_, uint32_t x_, uint32_t y_, uint32_t z_) const noexcept;
+
+		// label_ in 1 .. Num_Components()
+		Component const& operator[](uint32_t label_) const noexcept { return Components_[label_ - 1U]; }
+		std::vector<Component> const& Components() const noexcept { return Components_; }
+
+		// Calls f_(idx_Brick, mask, label) for every brick's share of every component.
+		template<typename T_Function>
+		void ForEachPiece(T_Function const& f_) const {
+			for (uint32_t idx_Brick{ 0U }; idx_Brick + 1LLU < FirstPieces_.size(); ++idx_Brick) {
+				for (uint32_t idx_Piece{ FirstPieces_[idx_Brick] }; idx_Piece < FirstPieces_[idx_Brick + 1U]; ++idx_Piece) {
+					f_(idx_Brick, Pieces_[idx_Piece].Mask, Pieces_[idx_Piece].Label);
+				}
+			}
+		}
+
+	private:
+		// Splits a brick into its 6-connected pieces.
+		void Split(SparseVoxelVolume::Brick const& brick_);
+
+		//====	======	======	======	======	====//
+
+	private:
+		std::vector<Piece> Pieces_{};
+		// Pieces of brick i are FirstPieces_[i] .. FirstPieces_[i + 1] - 1.
+		std::vector<uint32_t> FirstPieces_{};
+		std::vector<Component> Components_{};
+
+		DisjointSet Provisional_{};
+		std::vector<uint32_t> Finals_{};
+	};
+
+	INLINE_NAMESPACE_MATH_END
+}
+
+//////	//////	//////	//////	//////	//////
+//	Kernels									//
+//////	//////	//////	//////	//////	//////
+
+namespace Lumina {
+	INLINE_NAMESPACE_MATH_BEGIN
+
+	namespace {
+		using Brick = SparseVoxelVolume::Brick;
+
+		constinit Brick const EmptyBrick{};
+
+		// The voxels at x = 0 and x = 7 of a slice.
+		constexpr uint64_t Column_West{ 0x0101010101010101LLU };
+		constexpr uint64_t Column_East{ 0x8080808080808080LLU };
+		// The voxels at y = 0 and y = 7.
+		constexpr uint64_t Row_North{ 0x00000000000000FFLLU };
+		constexpr uint64_t Row_South{ 0xFF00000000000000LLU };
+
+		// Each voxel's west (x - 1) neighbour in its place: the slice moved up a bit, with the east column of the brick
+		// to the west carried in.
+		uint64_t West(uint64_t slice_, uint64_t sliceWest_) noexcept { return ((slice_ << 1U) & ~Column_West) | ((sliceWest_ >> 7U) & Column_West); }
+		uint64_t East(uint64_t slice_, uint64_t sliceEast_) noexcept { return ((slice_ >> 1U) & ~Column_East) | ((sliceEast_ << 7U) & Column_East); }
+		// y - 1 and y + 1.
+		uint64_t North(uint64_t slice_, uint64_t sliceNorth_) noexcept { return (slice_ << 8U) | (sliceNorth_ >> 56U); }
+		uint64_t South(uint64_t slice_, uint64_t sliceSouth_) noexcept { return (slice_ >> 8U) | (sliceSouth_ << 56U); }
+
+		// (a & b) | (c & (a ^ b)): the carry of a full adder.
+		uint64_t Majority(uint64_t a_, uint64_t b_, uint64_t c_) noexcept { return (a_ & b_) | (c_ & (a_ ^ b_)); }
+
+		uint64_t Union(Brick const& brick_) noexcept {
+			uint64_t all{ 0LLU };
+			for (uint64_t const slice : brick_) { all |= slice; }
+			return all;
+		}
+
+		// The bricks around one, offset (dx, dy, dz) at [dz + 1][dy + 1][dx + 1]; EmptyBrick where there is none.
+		using Neighbourhood = Brick const* [3][3][3];
+
+		void Gather(SparseVoxelVolume const& volume_, Int3 const& brick_, Neighbourhood& around_) noexcept {
+			for (int32_t dz{ -1 }; dz <= 1; ++dz) {
+				for (int32_t dy{ -1 }; dy <= 1; ++dy) {
+					for (int32_t dx{ -1 }; dx <= 1; ++dx) {
+						uint32_t const idx_Brick{ volume_.FindBrick({ brick_.x + dx, brick_.y + dy, brick_.z + dz }) };
+						around_[dz + 1][dy + 1][dx + 1] = (idx_Brick != SparseVoxelVolume::InvalidBrick) ? &volume_.GetBrick(idx_Brick) : &EmptyBrick;
+					}
+				}
+			}
+		}
+
+		// The set voxels among the nine around each voxel of slice z_ (itself included), 0 to 9, as bit planes of weight 1, 2, 4 and 8.
+		void SumLayer(Brick const* const (&layer_)[3][3], uint32_t z_, uint64_t (&sum_)[4]) noexcept {
+			uint64_t ones[3]{};
+			uint64_t twos[3]{};
+			for (uint32_t dy{ 0U }; dy < 3U; ++dy) {
+				// Row dy of the nine, in the brick to the west, its own, and the one to the east.
+				uint64_t rows[3]{};
+				for (uint32_t dx{ 0U }; dx < 3U; ++dx) {
+					uint64_t const slice{ (*layer_[1][dx])[z_] };
+					rows[dx] =
+						(dy == 0U) ? North(slice, (*layer_[0][dx])[z_]) :
+						(dy == 1U) ? slice :
+						South(slice, (*layer_[2][dx])[z_]);
+				}
+				uint64_t const west{ West(rows[1], rows[0]) };
+				uint64_t const east{ East(rows[1], rows[2]) };
+				ones[dy] = west ^ rows[1] ^ east;
+				twos[dy] = Majority(west, rows[1], east);
+			}
+
+			uint64_t const carry1{ Majority(ones[0], ones[1], ones[2]) };
+			uint64_t const sum2{ twos[0] ^ twos[1] ^ twos[2] };
+			uint64_t const carry2{ Majority(twos[0], twos[1], twos[2]) };
+			uint64_t const carry3{ sum2 & carry1 };
+			sum_[0] = ones[0] ^ ones[1] ^ ones[2];
+			sum_[1] = sum2 ^ carry1;
+			sum_[2] = carry2 ^ carry3;
+			sum_[3] = carry2 & carry3;
+		}
+
+		// For every total the rule cares about, what a voxel with that total becomes: (cell & (Birth ^ Survival)) ^ Birth,
+		// with each flag widened to a whole word. The total counts the voxel itself, so a set voxel's neighbours are one fewer.
+		struct Term {
+			uint32_t Total;
+			uint64_t Birth;
+			uint64_t Difference;
+		};
+
+		uint32_t MakeTerms(VoxelRule const& rule_, Term (&terms_)[28]) noexcept {
+			uint32_t num_Terms{ 0U };
+			for (uint32_t total{ 0U }; total <= 27U; ++total) {
+				bool const isBirth{ total <= 26U && ((rule_.Birth >> total) & 1U) != 0U };
+				bool const isSurvival{ total >= 1U && ((rule_.Survival >> (total - 1U)) & 1U) != 0U };
+				if (!isBirth && !isSurvival) { continue; }
+				terms_[num_Terms++] = {
+					total,
+					isBirth ? ~0LLU : 0LLU,
+					(isBirth != isSurvival) ? ~0LLU : 0LLU,
+				};
+			}
+			return num_Terms;
+		}
+
+		Brick StepBrick(Neighbourhood const& around_, Term const* terms_, uint32_t num_Terms_) noexcept {
+			// Layer sums of slices -1 to 8, the first and last from the bricks below and above.
+			uint64_t layers[10][4]{};
+			for (uint32_t i{ 0U }; i < 10U; ++i) {
+				uint32_t const idx_Layer{ (i == 0U) ? 0U : (i == 9U) ? 2U : 1U };
+				SumLayer(around_[idx_Layer], (i + 7U) & 7U, layers[i]);
+			}
+
+			Brick next{};
+			for (uint32_t z{ 0U }; z < 8U; ++z) {
+				// The three layers added, 0 to 27, into five planes.
+				uint64_t total[5]{ layers[z][0], layers[z][1], layers[z][2], layers[z][3], 0LLU };
+				for (uint32_t i{ 1U }; i <= 2U; ++i) {
+					uint64_t carry{ 0LLU };
+					for (uint32_t bit{ 0U }; bit < 4U; ++bit) {
+						uint64_t const sum{ total[bit] ^ layers[z + i][bit] ^ carry };
+						carry = Majority(total[bit], layers[z + i][bit], carry);
+						total[bit] = sum;
+					}
+					total[4] ^= carry;
+				}
+
+				uint64_t const planes[2][5]{
+					{ ~total[0], ~total[1], ~total[2], ~total[3], ~total[4] },
+					{ total[0], total[1], total[2], total[3], total[4] },
+				};
+				uint64_t const cell{ (*around_[1][1][1])[z] };
+				uint64_t slice{ 0LLU };
+				for (uint32_t idx_Term{ 0U }; idx_Term < num_Terms_; ++idx_Term) {
+					Term const& term{ terms_[idx_Term] };
+					uint64_t const isTotal{
+						planes[term.Total & 1U][0] & planes[(term.Total >> 1U) & 1U][1] & planes[(term.Total >> 2U) & 1U][2] &
+						planes[(term.Total >> 3U) & 1U][3] & planes[(term.Total >> 4U) & 1U][4]
+					};
+					slice |= isTotal & ((cell & term.Difference) ^ term.Birth);
+				}
+				next[z] = slice;
+			}
+			return next;
+		}
+
+		// One step of a 6-connected flood fill, kept within the brick.
+		Brick Dilate(Brick const& fill_) noexcept {
+			Brick grown{};
+			for (uint32_t z{ 0U }; z < 8U; ++z) {
+				uint64_t const slice{ fill_[z] };
+				grown[z] =
+					slice | ((slice << 1U) & ~Column_West) | ((slice >> 1U) & ~Column_East) | (slice << 8U) | (slice >> 8U) |
+					((z > 0U) ? fill_[z - 1U] : 0LLU) | ((z < 7U) ? fill_[z + 1U] : 0LLU);
+			}
+			return grown;
+		}
+	}
+
+	//----	------	------	------	------	----//
+
+	void SparseVoxelVolume::Set(uint32_t x_, uint32_t y_, uint32_t z_, bool isSet_) {
+		assert(x_ < Width_ && y_ < Height_ && z_ < Depth_);
+		Int3 const brick{ static_cast<int32_t>(x_ >> 3U), static_cast<int32_t>(y_ >> 3U), static_cast<int32_t>(z_ >> 3U) };
+		uint32_t const idx_Brick{ isSet_ ? TouchBrick(brick) : FindBrick(brick) };
+		if (idx_Brick == InvalidBrick) { return; }
+
+		uint64_t& slice{ Bricks_[idx_Brick][z_ & 7U] };
+		uint64_t const bit{ 1LLU << (((y_ & 7U) << 3U) | (x_ & 7U)) };
+		slice = isSet_ ? (slice | bit) : (slice & ~bit);
+	}
+
+	void SparseVoxelVolume::FillSphere(Int3 const& center_, int32_t radius_) {
+		if (radius_ < 0) { return; }
+		Int3 const min{ std::max(center_.x - radius_, 0), std::max(center_.y - radius_, 0), std::max(center_.z - radius_, 0) };
+		Int3 const max{
+			std::min(center_.x + radius_, static_cast<int32_t>(Width_) - 1),
+			std::min(center_.y + radius_, static_cast<int32_t>(Height_) - 1),
+			std::min(center_.z + radius_, static_cast<int32_t>(Depth_) - 1),
+		};
+
+		// A brick at a time, so that each is looked up once rather than once per voxel; a row at a time within it,
+		// as the ball covers one run of x in every row it meets.
+		for (int32_t bz{ min.z >> 3 }; bz <= (max.z >> 3); ++bz) {
+			for (int32_t by{ min.y >> 3 }; by <= (max.y >> 3); ++by) {
+				for (int32_t bx{ min.x >> 3 }; bx <= (max.x >> 3); ++bx) {
+					int32_t const x_Begin{ std::max(bx << 3, min.x) };
+					int32_t const x_End{ std::min((bx << 3) + 7, max.x) };
+
+					Brick* brick{ nullptr };
+					for (int32_t z{ std::max(bz << 3, min.z) }; z <= std::min((bz << 3) + 7, max.z); ++z) {
+						uint64_t slice{ 0LLU };
+						for (int32_t y{ std::max(by << 3, min.y) }; y <= std::min((by << 3) + 7, max.y); ++y) {
+							int32_t const rest{ radius_ * radius_ - (y - center_.y) * (y - center_.y) - (z - center_.z) * (z - center_.z) };
+							if (rest < 0) { continue; }
+							int32_t halfWidth{ 0 };
+							while ((halfWidth + 1) * (halfWidth + 1) <= rest) { ++halfWidth; }
+
+							int32_t const x0{ std::max(center_.x - halfWidth, x_Begin) };
+							int32_t const x1{ std::min(center_.x + halfWidth, x_End) };
+							if (x0 > x1) { continue; }
+							uint64_t const run{ (0xFFLLU >> (7 - (x1 - x0))) << (x0 & 7) };
+							slice |= run << ((y & 7) << 3);
+						}
+						if (slice == 0LLU) { continue; }
+						if (brick == nullptr) { brick = &Bricks_[TouchBrick({ bx, by, bz })]; }
+						(*brick)[z & 7] |= slice;
+					}
+				}
+			}
+		}
+	}
+
+	void SparseVoxelVolume::ExtractSurface(SparseVoxelVolume& surface_) const {
+		surface_.Resize(Width_, Height_, Depth_);
+
+		auto const find{
+			[this] (Int3 const& brick_) -> Brick const& {
+				uint32_t const idx_Brick{ FindBrick(brick_) };
+				return (idx_Brick != InvalidBrick) ? Bricks_[idx_Brick] : EmptyBrick;
+			}
+		};
+		for (uint32_t idx_Brick{ 0U }; idx_Brick < Num_Bricks(); ++idx_Brick) {
+			Brick const& brick{ Bricks_[idx_Brick] };
+			if (Union(brick) == 0LLU) { continue; }
+
+			Int3 const coord{ BrickCoord(idx_Brick) };
+			Brick const& west{ find({ coord.x - 1, coord.y, coord.z }) };
+			Brick const& east{ find({ coord.x + 1, coord.y, coord.z }) };
+			Brick const& north{ find({ coord.x, coord.y - 1, coord.z }) };
+			Brick const& south{ find({ coord.x, coord.y + 1, coord.z }) };
+			uint64_t const below{ find({ coord.x, coord.y, coord.z - 1 })[7] };
+			uint64_t const above{ find({ coord.x, coord.y, coord.z + 1 })[0] };
+
+			Brick surface{};
+			uint64_t any{ 0LLU };
+			for (uint32_t z{ 0U }; z < 8U; ++z) {
+				uint64_t const slice{ brick[z] };
+				uint64_t const inner{
+					slice &
+					West(slice, west[z]) & East(slice, east[z]) & North(slice, north[z]) & South(slice, south[z]) &
+					((z > 0U) ? brick[z - 1U] : below) & ((z < 7U) ? brick[z + 1U] : above)
+				};
+				surface[z] = slice & ~inner;
+				any |= surface[z];
+			}
+			if (any != 0LLU) { surface_.GetBrick(surface_.TouchBrick(coord)) = surface; }
+		}
+	}
+
+	void SparseVoxelVolume::Compact() {
+		uint32_t num_Kept{ 0U };
+		for (uint32_t idx_Brick{ 0U }; idx_Brick < Num_Bricks(); ++idx_Brick) {
+			if (Union(Bricks_[idx_Brick]) == 0LLU) {
+				Index_.erase(Keys_[idx_Brick]);
+				continue;
+			}
+			if (num_Kept != idx_Brick) {
+				Bricks_[num_Kept] = Bricks_[idx_Brick];
+				Keys_[num_Kept] = Keys_[idx_Brick];
+				Index_[Keys_[num_Kept]] = num_Kept;
+			}
+			++num_Kept;
+		}
+		Bricks_.resize(num_Kept);
+		Keys_.resize(num_Kept);
+	}
+
+	uint64_t SparseVoxelVolume::Num_Voxels() const noexcept {
+		uint64_t num_Voxels{ 0LLU };
+		for (auto const& brick : Bricks_) {
+			for (uint64_t const slice : brick) { num_Voxels += static_cast<uint64_t>(std::popcount(slice)); }
+		}
+		return num_Voxels;
+	}
+
+	//----	------	------	------	------	----//
+
+	void VoxelAutomaton::Step(VoxelRule const& rule_, uint32_t num_Steps_) {
+		assert((rule_.Birth & 1U) == 0U);
+		Term terms[28]{};
+		uint32_t const num_Terms{ MakeTerms(rule_, terms) };
+
+		Neighbourhood around{};
+		for (uint32_t step{ 0U }; step < num_Steps_; ++step) {
+			Next_.Resize(Current_.Width(), Current_.Height(), Current_.Depth());
+			Next_.Reserve(Current_.Num_Bricks());
+			Frontier_.clear();
+			IsQueued_.clear();
+
+			auto const step_Brick{
+				[this, &around, &terms, num_Terms] (Int3 const& coord_) {
+					Gather(Current_, coord_, around);
+					Brick const next{ StepBrick(around, terms, num_Terms) };
+					if (Union(next) != 0LLU) { Next_.GetBrick(Next_.TouchBrick(coord_)) = next; }
+				}
+			};
+
+			for (uint32_t idx_Brick{ 0U }; idx_Brick < Current_.Num_Bricks(); ++idx_Brick) {
+				Int3 const coord{ Current_.BrickCoord(idx_Brick) };
+				step_Brick(coord);
+
+				// A brick not yet made can only be born into from a voxel on the face, edge or corner it shares with this one.
+				Brick const& brick{ Current_.GetBrick(idx_Brick) };
+				uint64_t const all{ Union(brick) };
+				if (all == 0LLU) { continue; }
+				bool const isTouching[3][3]{
+					{ (all & Column_West) != 0LLU, true, (all & Column_East) != 0LLU },
+					{ (all & Row_North) != 0LLU, true, (all & Row_South) != 0LLU },
+					{ brick[0] != 0LLU, true, brick[7] != 0LLU },
+				};
+				for (int32_t dz{ -1 }; dz <= 1; ++dz) {
+					if (!isTouching[2][dz + 1]) { continue; }
+					for (int32_t dy{ -1 }; dy <= 1; ++dy) {
+						if (!isTouching[1][dy + 1]) { continue; }
+						for (int32_t dx{ -1 }; dx <= 1; ++dx) {
+							if (!isTouching[0][dx + 1] || (dx == 0 && dy == 0 && dz == 0)) { continue; }
+							Int3 const neighbour{ coord.x + dx, coord.y + dy, coord.z + dz };
+							if (!Current_.IsInside(neighbour) || Current_.FindBrick(neighbour) != SparseVoxelVolume::InvalidBrick) { continue; }
+							if (IsQueued_.try_emplace(SparseVoxelVolume::Key(neighbour), true).second) { Frontier_.emplace_back(neighbour); }
+						}
+					}
+				}
+			}
+			for (auto const& coord : Frontier_) { step_Brick(coord); }
+
+			std::swap(Current_, Next_);
+		}
+	}
+
+	//----	------	------	------	------	----//
+
+	void VoxelComponents::Label(SparseVoxelVolume const& volume_) {
+		Pieces_.clear();
+		FirstPieces_.resize(volume_.Num_Bricks() + 1LLU);
+		Components_.clear();
+
+		for (uint32_t idx_Brick{ 0U }; idx_Brick < volume_.Num_Bricks(); ++idx_Brick) {
+			FirstPieces_[idx_Brick] = static_cast<uint32_t>(Pieces_.size());
+			Split(volume_.GetBrick(idx_Brick));
+		}
+		FirstPieces_.back() = static_cast<uint32_t>(Pieces_.size());
+		uint32_t const num_Pieces{ static_cast<uint32_t>(Pieces_.size()) };
+		Provisional_.Reset(num_Pieces);
+
+		// Pieces that touch across the west, north and lower faces of the next bricks along belong together.
+		for (uint32_t idx_Brick{ 0U }; idx_Brick < volume_.Num_Bricks(); ++idx_Brick) {
+			if (FirstPieces_[idx_Brick] == FirstPieces_[idx_Brick + 1U]) { continue; }
+			Int3 const coord{ volume_.BrickCoord(idx_Brick) };
+			Brick const& brick{ volume_.GetBrick(idx_Brick) };
+
+			auto const join{
+				[this, idx_Brick] (uint32_t idx_Neighbour_, auto const& isTouching_) {
+					if (idx_Neighbour_ == SparseVoxelVolume::InvalidBrick) { return; }
+					for (uint32_t idx_Piece{ FirstPieces_[idx_Brick] }; idx_Piece < FirstPieces_[idx_Brick + 1U]; ++idx_Piece) {
+						for (uint32_t idx_Other{ FirstPieces_[idx_Neighbour_] }; idx_Other < FirstPieces_[idx_Neighbour_ + 1U]; ++idx_Other) {
+							if (isTouching_(Pieces_[idx_Piece].Mask, Pieces_[idx_Other].Mask)) { Provisional_.Union(idx_Piece, idx_Other); }
+						}
+					}
+				}
+			};
+			if ((Union(brick) & Column_East) != 0LLU) {
+				join(
+					volume_.FindBrick({ coord.x + 1, coord.y, coord.z }),
+					[] (Brick const& lhs_, Brick const& rhs_) {
+						uint64_t touching{ 0LLU };
+						for (uint32_t z{ 0U }; z < 8U; ++z) { touching |= ((lhs_[z] & Column_East) >> 7U) & rhs_[z]; }
+						return touching != 0LLU;
+					}
+				);
+			}
+			if ((Union(brick) & Row_South) != 0LLU) {
+				join(
+					volume_.FindBrick({ coord.x, coord.y + 1, coord.z }),
+					[] (Brick const& lhs_, Brick const& rhs_) {
+						uint64_t touching{ 0LLU };
+						for (uint32_t z{ 0U }; z < 8U; ++z) { touching |= (lhs_[z] >> 56U) & rhs_[z]; }
+						return touching != 0LLU;
+					}
+				);
+			}
+			if (brick[7] != 0LLU) {
+				join(
+					volume_.FindBrick({ coord.x, coord.y, coord.z + 1 }),
+					[] (Brick const& lhs_, Brick const& rhs_) { return (lhs_[7] & rhs_[0]) != 0LLU; }
+				);
+			}
+		}
+
+		// Final labels in piece order, which is brick order, and their volumes and bounds.
+		Finals_.assign(num_Pieces, Background);
+		for (uint32_t idx_Brick{ 0U }; idx_Brick < volume_.Num_Bricks(); ++idx_Brick) {
+			Int3 const origin{ volume_.BrickCoord(idx_Brick) };
+			for (uint32_t idx_Piece{ FirstPieces_[idx_Brick] }; idx_Piece < FirstPieces_[idx_Brick + 1U]; ++idx_Piece) {
+				Piece& piece{ Pieces_[idx_Piece] };
+				uint32_t const root{ Provisional_.Find(idx_Piece) };
+				if (Finals_[root] == Background) {
+					Components_.emplace_back(
+						0LLU,
+						Int3{ std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::max() },
+						Int3{ -1, -1, -1 }
+					);
+					Finals_[root] = Num_Components();
+				}
+				piece.Label = Finals_[root];
+
+				// Columns, rows and slices in use, each as a byte.
+				uint64_t const all{ Union(piece.Mask) };
+				uint32_t columns{ 0U };
+				uint32_t rows{ 0U };
+				uint32_t slices{ 0U };
+				for (uint32_t i{ 0U }; i < 8U; ++i) {
+					columns |= static_cast<uint32_t>(all >> (i << 3U)) & 0xFFU;
+					rows |= ((all >> (i << 3U)) & 0xFFLLU) != 0LLU ? (1U << i) : 0U;
+					slices |= (piece.Mask[i] != 0LLU) ? (1U << i) : 0U;
+				}
+
+				Component& component{ Components_[piece.Label - 1U] };
+				for (uint64_t const slice : piece.Mask) { component.Volume += static_cast<uint64_t>(std::popcount(slice)); }
+				Int3 const min{
+					(origin.x << 3) + std::countr_zero(columns),
+					(origin.y << 3) + std::countr_zero(rows),
+					(origin.z << 3) + std::countr_zero(slices),
+				};
+				Int3 const max{
+					(origin.x << 3) + 31 - std::countl_zero(columns),
+					(origin.y << 3) + 31 - std::countl_zero(rows),
+					(origin.z << 3) + 31 - std::countl_zero(slices),
+				};
+				component.Min = { std::min(component.Min.x, min.x), std::min(component.Min.y, min.y), std::min(component.Min.z, min.z) };
+				component.Max = { std::max(component.Max.x, max.x), std::max(component.Max.y, max.y), std::max(component.Max.z, max.z) };
+			}
+		}
+	}
+
+	uint32_t VoxelComponents::operator()(SparseVoxelVolume const& volume_, uint32_t x_, uint32_t y_, uint32_t z_) const noexcept {
+		uint32_t const idx_Brick{ volume_.FindBrick({ static_cast<int32_t>(x_ >> 3U), static_cast<int32_t>(y_ >> 3U), static_cast<int32_t>(z_ >> 3U) }) };
+		if (idx_Brick == SparseVoxelVolume::InvalidBrick) { return Background; }
+
+		uint64_t const bit{ 1LLU << (((y_ & 7U) << 3U) | (x_ & 7U)) };
+		for (uint32_t idx_Piece{ FirstPieces_[idx_Brick] }; idx_Piece < FirstPieces_[idx_Brick + 1U]; ++idx_Piece) {
+			if ((Pieces_[idx_Piece].Mask[z_ & 7U] & bit) != 0LLU) { return Pieces_[idx_Piece].Label; }
+		}
+		return Background;
+	}
+
+	void VoxelComponents::Split(Brick const& brick_) {
+		// A full brick, the common case inside caves, is one piece without any filling.
+		bool isFull{ true };
+		for (uint64_t const slice : brick_) { isFull = isFull && (slice == ~0LLU); }
+		if (isFull) {
+			Pieces_.emplace_back(brick_, Background);
+			return;
+		}
+
+		Brick remaining{ brick_ };
+		for (uint32_t z{ 0U }; z < 8U; ++z) {
+			while (remaining[z] != 0LLU) {
+				// Grown from the lowest voxel left until it fills its piece.
+				Brick fill{};
+				fill[z] = remaining[z] & (~remaining[z] + 1LLU);
+				for (;;) {
+					Brick grown{ Dilate(fill) };
+					for (uint32_t i{ 0U }; i < 8U; ++i) { grown[i] &= brick_[i]; }
+					if (grown == fill) { break; }
+					fill = grown;
+				}
+				for (uint32_t i{ 0U }; i < 8U; ++i) { remaining[i] &= ~fill[i]; }
+				Pieces_.emplace_back(fill, Background);
+			}
+		}
+	}
+
+	INLINE_NAMESPACE_MATH_END
+}
\ No newline at end of file
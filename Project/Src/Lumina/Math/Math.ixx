@@ -9,7 +9,19 @@ export import Lumina.Math.Random;
 export import Lumina.Math.Vector;
 export import Lumina.Math.Matrix;
 
+export import Lumina.Math.Bounds;
+export import Lumina.Math.Frustum;
+export import Lumina.Math.Culling;
+
 export import Lumina.Math.PerlinNoise;
+export import Lumina.Math.PoissonDisk;
+export import Lumina.Math.KDTree;
+export import Lumina.Math.AABBTree;
+export import Lumina.Math.ConnectedComponents;
+export import Lumina.Math.CellularAutomaton;
+export import Lumina.Math.SpanningTree;
+export import Lumina.Math.GridPath;
+export import Lumina.Math.VoxelVolume;
 
 export import <cmath>;
 export import <numbers>;
\ No newline at end of file
@@ -1,10 +1,10 @@
 module;
 
 #include<vector>
-#include<unordered_map>
 
 #include<string>
 #include<format>
+#include<charconv>
 
 #include<fstream>
 #include<sstream>
@@ -21,6 +21,9 @@ import Lumina.Utils.Debug;
 
 import Lumina.Math.Numerics;
 
+import Lumina.Container.SmallVector;
+import Lumina.Container.FlatHashMap;
+
 export using NLohmannJSON = nlohmann::json;
 
 //////	//////	//////	//////	//////	//////
@@ -79,6 +82,7 @@ namespace Lumina::Utils {
 
 	template<>
 	NLohmannJSON LoadFromFile(std::string_view fileName_, std::string_view directory_) {
+		Debug::AllocationTracker::TagScope const tagScope{ Debug::ALLOCATION_TAG::ASSETS };
 		std::string&& filePath{ GetFilePath(fileName_, directory_) };
 		std::ifstream&& ifs{ LoadFileStream(filePath) };
 
@@ -181,7 +185,7 @@ namespace Lumina::Utils {
 			//////	//////	//////	//////	//////	//////
 
 		private:
-			static inline std::unordered_map<Specifier, Statement> const Statements_{
+			static inline FlatHashMap<std::string_view, Statement> const Statements_{
 				{ "v", &ReadPosition },
 				{ "vt", &ReadTexCoord },
 				{ "vn", &ReadNormal },
@@ -209,25 +213,30 @@ namespace Lumina::Utils {
 		}
 
 		void WavefrontOBJParser::ReadFace(std::istringstream& iss_) {
+			// "p/t/n" tokens fit the small-string buffer, and the indices of up to a quad stay inline,
+			// so a face costs no allocation beyond the growth of Vertices_ itself.
 			std::string str_Vert{};
-			std::string str_VertElemIdx{};
+			SmallVector<uint32_t, 12U> indices{};
 
-			auto& face{ Faces_.emplace_back() };
-			face.Index_Vertex_First = static_cast<uint32_t>(Vertices_.size());
-			
 			while (iss_ >> str_Vert) {
-				std::istringstream iss_Vert{ str_Vert };
-
-				auto& vert{ Vertices_.emplace_back() };
+				char const* it{ str_Vert.data() };
+				char const* const it_End{ str_Vert.data() + str_Vert.size() };
 				for (uint32_t i_VertElem{ 0U }; i_VertElem < 3U; ++i_VertElem) {
-					std::getline(iss_Vert, str_VertElemIdx, '/');
 					// 0 -> PositionID
 					// 1 -> TexCoordID
 					// 2 -> NormalID
-					*(reinterpret_cast<uint32_t*>(&vert) + i_VertElem) = std::stoi(str_VertElemIdx) - 1U;
+					uint32_t idx{ 0U };
+					it = std::from_chars(it, it_End, idx).ptr;
+					indices.emplace_back(idx - 1U);
+					if (it != it_End) { ++it; }
 				}
 			}
 
+			auto& face{ Faces_.emplace_back() };
+			face.Index_Vertex_First = static_cast<uint32_t>(Vertices_.size());
+			for (size_t i{ 0LLU }; i < indices.size(); i += 3LLU) {
+				Vertices_.emplace_back(indices[i], indices[i + 1LLU], indices[i + 2LLU]);
+			}
 			face.Index_Vertex_Last = static_cast<uint32_t>(Vertices_.size()) - 1U;
 		}
 
@@ -243,6 +252,7 @@ namespace Lumina::Utils {
 
 	template<>
 	WavefrontOBJ LoadFromFile(std::string_view fileName_, std::string_view directory_) {
+		Debug::AllocationTracker::TagScope const tagScope{ Debug::ALLOCATION_TAG::ASSETS };
 		std::string&& filePath{ GetFilePath(fileName_, directory_) };
 		std::ifstream&& ifs{ LoadFileStream(filePath) };
 
@@ -293,7 +303,7 @@ namespace Lumina::Utils {
 			~WavefrontMTLParser() noexcept = default;
 
 		private:
-			static inline std::unordered_map<Specifier, Statement> Statements_{
+			static inline FlatHashMap<std::string_view, Statement> const Statements_{
 				{ "map_Kd", &ReadTextureFileName },
 			};
 		};
@@ -309,6 +319,7 @@ namespace Lumina::Utils {
 
 	template<>
 	WavefrontMTL LoadFromFile(std::string_view fileName_, std::string_view directory_) {
+		Debug::AllocationTracker::TagScope const tagScope{ Debug::ALLOCATION_TAG::ASSETS };
 		std::string&& filePath{ GetFilePath(fileName_, directory_) };
 		std::ifstream&& ifs{ LoadFileStream(filePath) };
 
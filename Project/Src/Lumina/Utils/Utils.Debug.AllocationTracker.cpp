@@ -0,0 +1,94 @@
+#include<cstdint>
+#include<cstdlib>
+#include<cstddef>
+
+#include<new>
+
+import Lumina.Utils.Debug.AllocationTracker;
+
+// The replacements of the global operator new and delete that feed AllocationTracker.
+// A plain translation unit rather than a module unit: replacement allocation functions must not be attached to a named module.
+
+#if defined(LUMINA_TRACK_ALLOCATIONS)
+
+namespace {
+	using Lumina::Utils::Debug::AllocationTracker;
+	using Lumina::Utils::Debug::ALLOCATION_TAG;
+
+	constexpr size_t DefaultAlignment{ __STDCPP_DEFAULT_NEW_ALIGNMENT__ };
+
+	// Sits right before every block. Offset leads back to what malloc returned, which differs for over-aligned blocks.
+	struct Header {
+		size_t Size;
+		uint32_t Offset;
+		ALLOCATION_TAG Tag;
+		uint8_t Reserved[3];
+	};
+	// A block right after the header keeps malloc's alignment.
+	static_assert(sizeof(Header) == DefaultAlignment);
+
+	void* Allocate(size_t size_, size_t alignment_) noexcept {
+		size_t const alignment{ (alignment_ > DefaultAlignment) ? alignment_ : DefaultAlignment };
+		// malloc already aligns to the default new alignment, so only over-aligned blocks need the slack.
+		size_t const slack{ (alignment > DefaultAlignment) ? alignment : 0LLU };
+		std::byte* const base{ static_cast<std::byte*>(std::malloc(sizeof(Header) + slack + size_)) };
+		if (base == nullptr) { return nullptr; }
+
+		uintptr_t const address{ reinterpret_cast<uintptr_t>(base + sizeof(Header)) };
+		std::byte* const block{ base + sizeof(Header) + ((0LLU - address) & (alignment - 1LLU)) };
+		::new (block - sizeof(Header)) Header{
+			size_,
+			static_cast<uint32_t>(block - base),
+			AllocationTracker::OnAllocate(size_),
+			{},
+		};
+		return block;
+	}
+
+	void* AllocateOrThrow(size_t size_, size_t alignment_) {
+		while (true) {
+			if (void* const block{ Allocate(size_, alignment_) }; block != nullptr) { return block; }
+			std::new_handler const handler{ std::get_new_handler() };
+			if (handler == nullptr) { throw std::bad_alloc{}; }
+			handler();
+		}
+	}
+
+	void Deallocate(void* block_) noexcept {
+		if (block_ == nullptr) { return; }
+
+		std::byte* const block{ static_cast<std::byte*>(block_) };
+		Header const& header{ *reinterpret_cast<Header const*>(block - sizeof(Header)) };
+		AllocationTracker::OnDeallocate(header.Size, header.Tag);
+		std::free(block - header.Offset);
+	}
+}
+
+//----	------	------	------	------	----//
+
+void* operator new(size_t size_) { return AllocateOrThrow(size_, DefaultAlignment); }
+void* operator new[](size_t size_) { return AllocateOrThrow(size_, DefaultAlignment); }
+void* operator new(size_t size_, std::nothrow_t const&) noexcept { return Allocate(size_, DefaultAlignment); }
+void* operator new[](size_t size_, std::nothrow_t const&) noexcept { return Allocate(size_, DefaultAlignment); }
+
+void* operator new(size_t size_, std::align_val_t alignment_) { return AllocateOrThrow(size_, static_cast<size_t>(alignment_)); }
+void* operator new[](size_t size_, std::align_val_t alignment_) { return AllocateOrThrow(size_, static_cast<size_t>(alignment_)); }
+void* operator new(size_t size_, std::align_val_t alignment_, std::nothrow_t const&) noexcept { return Allocate(size_, static_cast<size_t>(alignment_)); }
+void* operator new[](size_t size_, std::align_val_t alignment_, std::nothrow_t const&) noexcept { return Allocate(size_, static_cast<size_t>(alignment_)); }
+
+// Every form of delete is replaced, since none of the library's own could free a block with a header.
+void operator delete(void* block_) noexcept { Deallocate(block_); }
+void operator delete[](void* block_) noexcept { Deallocate(block_); }
+void operator delete(void* block_, size_t) noexcept { Deallocate(block_); }
+void operator delete[](void* block_, size_t) noexcept { Deallocate(block_); }
+void operator delete(void* block_, std::nothrow_t const&) noexcept { Deallocate(block_); }
+void operator delete[](void* block_, std::nothrow_t const&) noexcept { Deallocate(block_); }
+
+void operator delete(void* block_, std::align_val_t) noexcept { Deallocate(block_); }
+void operator delete[](void* block_, std::align_val_t) noexcept { Deallocate(block_); }
+void operator delete(void* block_, size_t, std::align_val_t) noexcept { Deallocate(block_); }
+void operator delete[](void* block_, size_t, std::align_val_t) noexcept { Deallocate(block_); }
+void operator delete(void* block_, std::align_val_t, std::nothrow_t const&) noexcept { Deallocate(block_); }
+void operator delete[](void* block_, std::align_val_t, std::nothrow_t const&) noexcept { Deallocate(block_); }
+
+#endif
\ No newline at end of file
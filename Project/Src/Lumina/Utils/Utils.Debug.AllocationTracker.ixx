@@ -0,0 +1,211 @@
+export module Lumina.Utils.Debug.AllocationTracker;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cassert>;
+
+import <atomic>;
+
+import <string>;
+import <string_view>;
+import <format>;
+import <iterator>;
+
+//////	//////	//////	//////	//////	//////
+
+// Heap accounting per subsystem, in builds that define LUMINA_TRACK_ALLOCATIONS (the Debug configurations).
+//
+//	- The global operator new and delete are replaced (Utils.Debug.AllocationTracker.cpp) with versions that put
+//	  a small header in front of every block, recording its size and the tag it was allocated under.
+//	  A block is thus accounted to its own tag wherever and on whatever thread it is freed.
+//	- TagScope sets the calling thread's tag until it goes out of scope; scopes nest.
+//	- NoAllocationScope counts the calling thread's allocations within it, and in debug builds asserts
+//	  at the allocating call, where the call stack names the culprit, unless made to only count.
+//
+// Without the switch nothing is replaced, IsEnabled is false, the scopes compile to nothing and every statistic reads zero.
+// Only operator new is seen: malloc, COM and ImGui's allocator are not.
+
+namespace Lumina::Utils::Debug {
+	export enum class ALLOCATION_TAG : uint8_t {
+		UNTAGGED,
+		GRAPHICS,
+		AUDIO,
+		// Model, material and JSON loading.
+		ASSETS,
+		GAME,
+		// Logging and tool UI.
+		DEBUG,
+	};
+
+	export class AllocationTracker {
+	public:
+		#if defined(LUMINA_TRACK_ALLOCATIONS)
+		static constexpr bool IsEnabled{ true };
+		#else
+		static constexpr bool IsEnabled{ false };
+		#endif
+
+		static constexpr uint32_t Num_Tags{ 6U };
+		static constexpr std::string_view TagNames[Num_Tags]{ "Untagged", "Graphics", "Audio", "Assets", "Game", "Debug" };
+
+		struct Statistics {
+			uint64_t Num_Allocations;
+			uint64_t Num_Deallocations;
+			uint64_t LiveBytes;
+			uint64_t PeakBytes;
+			// Every byte ever allocated; the churn.
+			uint64_t TotalBytes;
+		};
+
+		class TagScope {
+		public:
+			explicit TagScope(ALLOCATION_TAG tag_) noexcept : Tag_Previous_{ IsEnabled ? Tag_ : ALLOCATION_TAG::UNTAGGED } {
+				if constexpr (IsEnabled) { Tag_ = tag_; }
+			}
+			~TagScope() noexcept {
+				if constexpr (IsEnabled) { Tag_ = Tag_Previous_; }
+			}
+
+			TagScope(TagScope const&) = delete;
+			TagScope& operator=(TagScope const&) = delete;
+
+		private:
+			ALLOCATION_TAG const Tag_Previous_;
+		};
+
+		class NoAllocationScope {
+		public:
+			// Allocations on this thread since construction.
+			uint64_t Num_Allocations() const noexcept { return Num_ThreadAllocations_ - Num_Allocations_Begin_; }
+
+		public:
+			// With asserts_ false the scope only counts, for loops that are not allocation-free yet.
+			explicit NoAllocationScope(bool asserts_ = true) noexcept :
+				Num_Allocations_Begin_{ Num_ThreadAllocations_ }, Asserts_{ asserts_ } {
+				if constexpr (IsEnabled) {
+					if (Asserts_) { ++Num_StrictScopes_; }
+				}
+			}
+			~NoAllocationScope() noexcept {
+				if constexpr (IsEnabled) {
+					if (Asserts_) { --Num_StrictScopes_; }
+				}
+			}
+
+			NoAllocationScope(NoAllocationScope const&) = delete;
+			NoAllocationScope& operator=(NoAllocationScope const&) = delete;
+
+		private:
+			uint64_t const Num_Allocations_Begin_;
+			bool const Asserts_;
+		};
+
+		//----	------	------	------	------	----//
+
+	public:
+		static Statistics Stats(ALLOCATION_TAG tag_) noexcept;
+		static Statistics Total() noexcept;
+		static ALLOCATION_TAG CurrentTag() noexcept { return Tag_; }
+		static uint64_t Num_ThreadAllocations() noexcept { return Num_ThreadAllocations_; }
+
+		// One line per tag that has seen an allocation, then the total.
+		static std::string Report();
+
+	public:
+		// For the operator new and delete replacements only.
+		static ALLOCATION_TAG OnAllocate(size_t size_) noexcept;
+		static void OnDeallocate(size_t size_, ALLOCATION_TAG tag_) noexcept;
+
+		//====	======	======	======	======	====//
+
+	private:
+		struct Counters {
+			std::atomic<uint64_t> Num_Allocations;
+			std::atomic<uint64_t> Num_Deallocations;
+			std::atomic<uint64_t> LiveBytes;
+			std::atomic<uint64_t> PeakBytes;
+			std::atomic<uint64_t> TotalBytes;
+		};
+
+		static inline Counters Counters_[Num_Tags]{};
+
+		static inline thread_local ALLOCATION_TAG Tag_{ ALLOCATION_TAG::UNTAGGED };
+		static inline thread_local uint64_t Num_ThreadAllocations_{ 0LLU };
+		static inline thread_local uint32_t Num_StrictScopes_{ 0U };
+	};
+
+	//----	------	------	------	------	----//
+
+	AllocationTracker::Statistics AllocationTracker::Stats(ALLOCATION_TAG tag_) noexcept {
+		Counters const& counters{ Counters_[static_cast<uint32_t>(tag_)] };
+		return Statistics{
+			.Num_Allocations{ counters.Num_Allocations.load(std::memory_order_relaxed) },
+			.Num_Deallocations{ counters.Num_Deallocations.load(std::memory_order_relaxed) },
+			.LiveBytes{ counters.LiveBytes.load(std::memory_order_relaxed) },
+			.PeakBytes{ counters.PeakBytes.load(std::memory_order_relaxed) },
+			.TotalBytes{ counters.TotalBytes.load(std::memory_order_relaxed) },
+		};
+	}
+
+	// The peak is the sum of the tags' peaks, which may not have been reached at the same time.
+	AllocationTracker::Statistics AllocationTracker::Total() noexcept {
+		Statistics total{};
+		for (uint32_t i{ 0U }; i < Num_Tags; ++i) {
+			Statistics const stats{ Stats(static_cast<ALLOCATION_TAG>(i)) };
+			total.Num_Allocations += stats.Num_Allocations;
+			total.Num_Deallocations += stats.Num_Deallocations;
+			total.LiveBytes += stats.LiveBytes;
+			total.PeakBytes += stats.PeakBytes;
+			total.TotalBytes += stats.TotalBytes;
+		}
+		return total;
+	}
+
+	std::string AllocationTracker::Report() {
+		// Taken up front, so that the report's own strings are not in it.
+		Statistics stats[Num_Tags]{};
+		for (uint32_t i{ 0U }; i < Num_Tags; ++i) { stats[i] = Stats(static_cast<ALLOCATION_TAG>(i)); }
+		Statistics const total{ Total() };
+
+		std::string report{
+			std::format("<AllocationTracker> {:<10} {:>14} {:>14} {:>16} {:>12} {:>12}\n", "Tag", "Live (B)", "Peak (B)", "Total (B)", "Allocs", "Frees")
+		};
+		auto const appendLine{
+			[&report] (std::string_view name_, Statistics const& stats_) {
+				std::format_to(
+					std::back_inserter(report),
+					"<AllocationTracker> {:<10} {:>14} {:>14} {:>16} {:>12} {:>12}\n",
+					name_, stats_.LiveBytes, stats_.PeakBytes, stats_.TotalBytes, stats_.Num_Allocations, stats_.Num_Deallocations
+				);
+			}
+		};
+		for (uint32_t i{ 0U }; i < Num_Tags; ++i) {
+			if (stats[i].Num_Allocations > 0LLU) { appendLine(TagNames[i], stats[i]); }
+		}
+		appendLine("Total", total);
+		return report;
+	}
+
+	//----	------	------	------	------	----//
+
+	ALLOCATION_TAG AllocationTracker::OnAllocate(size_t size_) noexcept {
+		assert(Num_StrictScopes_ == 0U && "<AllocationTracker> Allocation inside a NoAllocationScope!");
+		++Num_ThreadAllocations_;
+
+		ALLOCATION_TAG const tag{ Tag_ };
+		Counters& counters{ Counters_[static_cast<uint32_t>(tag)] };
+		counters.Num_Allocations.fetch_add(1LLU, std::memory_order_relaxed);
+		counters.TotalBytes.fetch_add(size_, std::memory_order_relaxed);
+		uint64_t const live{ counters.LiveBytes.fetch_add(size_, std::memory_order_relaxed) + size_ };
+		uint64_t peak{ counters.PeakBytes.load(std::memory_order_relaxed) };
+		while (peak < live && !counters.PeakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+		return tag;
+	}
+
+	void AllocationTracker::OnDeallocate(size_t size_, ALLOCATION_TAG tag_) noexcept {
+		Counters& counters{ Counters_[static_cast<uint32_t>(tag_)] };
+		counters.Num_Deallocations.fetch_add(1LLU, std::memory_order_relaxed);
+		counters.LiveBytes.fetch_sub(size_, std::memory_order_relaxed);
+	}
+}
\ No newline at end of file
@@ -11,6 +11,7 @@ import <string>;
 import <format>;
 
 import Lumina.Utils.Time;
+import Lumina.Utils.Debug.AllocationTracker;
 
 //////	//////	//////	//////	//////	//////
 
@@ -30,6 +31,7 @@ namespace Lumina::Utils::Debug {
 		void Message(std::format_string<ArgTypes...> const formatStr_, ArgTypes&&...args_) {
 			if (SeverityLevelThreshold_ > SeverityLevel) { return; }
 
+			AllocationTracker::TagScope const tagScope{ ALLOCATION_TAG::DEBUG };
 			TimestampedOutput(
 				// Implementation of std::format
 				std::vformat(
@@ -77,6 +79,7 @@ namespace Lumina::Utils::Debug {
 	public:
 		template<typename...Types>
 		inline void ConsolePrint(std::format_string<Types...> const formatStr_, Types&&...args_) {
+			AllocationTracker::TagScope const tagScope{ ALLOCATION_TAG::DEBUG };
 			// Implementation of std::format
 			auto&& logStr{
 				std::forward<std::string>(
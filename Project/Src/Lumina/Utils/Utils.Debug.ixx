@@ -3,4 +3,5 @@ export module Lumina.Utils.Debug;
 //****	******	******	******	******	****//
 
 export import : Logger;
-export import : Exception;
\ No newline at end of file
+export import : Exception;
+export import Lumina.Utils.Debug.AllocationTracker;
\ No newline at end of file
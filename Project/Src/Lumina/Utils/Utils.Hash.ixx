@@ -0,0 +1,51 @@
+export module Lumina.Utils.Hash;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cstddef>;
+
+import <bit>;
+import <array>;
+import <type_traits>;
+
+//////	//////	//////	//////	//////	//////
+
+// 64-bit FNV-1a over whatever is appended to it, for keys that must stay the same from run to run and build to build
+// (cache keys, content hashes), which std::hash does not promise.
+//
+// Values are appended by their object representation, so append fields one by one rather than structs with padding.
+
+namespace Lumina::Utils {
+	export class FNV1a {
+	public:
+		FNV1a& Append(void const* data_, size_t size_) noexcept {
+			auto const* bytes{ static_cast<uint8_t const*>(data_) };
+			for (size_t i{ 0LLU }; i < size_; ++i) {
+				State_ ^= bytes[i];
+				State_ *= Prime;
+			}
+			return *this;
+		}
+
+		template<typename T> requires std::is_trivially_copyable_v<T>
+		constexpr FNV1a& Append(T const& value_) noexcept {
+			auto const bytes{ std::bit_cast<std::array<uint8_t, sizeof(T)>>(value_) };
+			for (uint8_t const byte : bytes) {
+				State_ ^= byte;
+				State_ *= Prime;
+			}
+			return *this;
+		}
+
+		constexpr uint64_t Value() const noexcept { return State_; }
+
+		//====	======	======	======	======	====//
+
+	private:
+		static constexpr uint64_t Basis{ 0xCBF29CE484222325LLU };
+		static constexpr uint64_t Prime{ 0x00000100000001B3LLU };
+
+		uint64_t State_{ Basis };
+	};
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+module;
+
+#if defined(_WIN32)
+#include<Windows.h>
+#else
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<fcntl.h>
+#include<unistd.h>
+#endif
+
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+
+export module Lumina.Utils.MappedFile;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cstddef>;
+
+import <string>;
+import <utility>;
+
+//////	//////	//////	//////	//////	//////
+
+// A whole file mapped read-only into memory: its pages are read in as they are touched, and shared with the
+// system's file cache rather than copied. For caches and other files read far more than written.
+//
+// Open() returns false, rather than throwing, for a file that is missing, empty or cannot be mapped,
+// as a cache miss is nothing exceptional.
+
+namespace Lumina::Utils {
+	export class MappedFile {
+	public:
+		bool Open(std::string const& path_);
+		void Close() noexcept;
+
+	public:
+		bool IsOpen() const noexcept { return Data_ != nullptr; }
+		std::byte const* Data() const noexcept { return Data_; }
+		size_t Size() const noexcept { return Size_; }
+
+	public:
+		MappedFile() noexcept = default;
+		explicit MappedFile(std::string const& path_) { Open(path_); }
+		~MappedFile() noexcept { Close(); }
+
+		MappedFile(MappedFile&& other_) noexcept :
+			Data_{ std::exchange(other_.Data_, nullptr) },
+			Size_{ std::exchange(other_.Size_, 0LLU) } {}
+		MappedFile& operator=(MappedFile&& other_) noexcept {
+			if (this != &other_) {
+				Close();
+				Data_ = std::exchange(other_.Data_, nullptr);
+				Size_ = std::exchange(other_.Size_, 0LLU);
+			}
+			return *this;
+		}
+
+		MappedFile(MappedFile const&) = delete;
+		MappedFile& operator=(MappedFile const&) = delete;
+
+		//====	======	======	======	======	====//
+
+	private:
+		std::byte const* Data_{ nullptr };
+		size_t Size_{ 0LLU };
+	};
+
+	//----	------	------	------	------	----//
+
+	bool MappedFile::Open(std::string const& path_) {
+		Close();
+
+		#if defined(_WIN32)
+		HANDLE const file{ ::CreateFileA(path_.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+		if (file == INVALID_HANDLE_VALUE) { return false; }
+
+		LARGE_INTEGER size{};
+		if (!::GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+			::CloseHandle(file);
+			return false;
+		}
+		// The view keeps the file open; neither handle is needed past this.
+		HANDLE const mapping{ ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0U, 0U, nullptr) };
+		::CloseHandle(file);
+		if (mapping == nullptr) { return false; }
+
+		void const* const view{ ::MapViewOfFile(mapping, FILE_MAP_READ, 0U, 0U, 0LLU) };
+		::CloseHandle(mapping);
+		if (view == nullptr) { return false; }
+
+		Data_ = static_cast<std::byte const*>(view);
+		Size_ = static_cast<size_t>(size.QuadPart);
+		#else
+		int const file{ ::open(path_.c_str(), O_RDONLY) };
+		if (file < 0) { return false; }
+
+		struct stat info{};
+		if (::fstat(file, &info) != 0 || info.st_size <= 0) {
+			::close(file);
+			return false;
+		}
+		void* const view{ ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0) };
+		::close(file);
+		if (view == MAP_FAILED) { return false; }
+
+		Data_ = static_cast<std::byte const*>(view);
+		Size_ = static_cast<size_t>(info.st_size);
+		#endif
+		return true;
+	}
+
+	void MappedFile::Close() noexcept {
+		if (Data_ == nullptr) { return; }
+
+		#if defined(_WIN32)
+		::UnmapViewOfFile(Data_);
+		#else
+		::munmap(const_cast<std::byte*>(Data_), Size_);
+		#endif
+		Data_ = nullptr;
+		Size_ = 0LLU;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+module;
+
+#if defined(_WIN32)
+#include<Windows.h>
+#endif
+
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+//////	//////	//////	//////	//////	//////
+
+export module Lumina.Utils.Path;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+
+import <string>;
+import <filesystem>;
+import <system_error>;
+
+//////	//////	//////	//////	//////	//////
+
+// Paths anchored at the running executable rather than at the working directory, which depends on how the program was
+// started: a debugger, a shortcut and a shell each start it somewhere else. For files the program writes for itself.
+
+namespace Lumina::Utils {
+	// The directory the executable is in; the working directory if the system does not say.
+	export std::filesystem::path ExecutableDirectory() {
+		#if defined(_WIN32)
+		std::wstring path(MAX_PATH, L'\0');
+		while (true) {
+			uint32_t const length{ ::GetModuleFileNameW(nullptr, path.data(), static_cast<DWORD>(path.size())) };
+			if (length == 0U) { return std::filesystem::current_path(); }
+			// A path that fills the buffer may have been cut short.
+			if (length < path.size()) {
+				path.resize(length);
+				break;
+			}
+			path.resize(path.size() * 2LLU);
+		}
+		return std::filesystem::path{ path }.parent_path();
+		#else
+		std::error_code error{};
+		std::filesystem::path const path{ std::filesystem::read_symlink("/proc/self/exe", error) };
+		return error ? std::filesystem::current_path() : path.parent_path();
+		#endif
+	}
+
+	// path_ taken from the executable's directory if relative; as it is if absolute.
+	export std::filesystem::path FromExecutableDirectory(std::filesystem::path const& path_) {
+		return path_.is_absolute() ? path_ : ExecutableDirectory() / path_;
+	}
+}
\ No newline at end of file
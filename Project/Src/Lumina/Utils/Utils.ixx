@@ -4,4 +4,7 @@ export module Lumina.Utils;
 
 export import Lumina.Utils.String;
 export import Lumina.Utils.Data;
-export import Lumina.Utils.Debug;
\ No newline at end of file
+export import Lumina.Utils.Debug;
+export import Lumina.Utils.Hash;
+export import Lumina.Utils.MappedFile;
+export import Lumina.Utils.Path;
\ No newline at end of file
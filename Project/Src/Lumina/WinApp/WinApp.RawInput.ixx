@@ -15,12 +15,11 @@ import <cstdint>;
 import <memory>;
 import <functional>;
 
-import <unordered_map>;
-
 import <string>;
 
 import Lumina.Mixins;
 import Lumina.Container.Bitset;
+import Lumina.Container.FlatHashMap;
 import Lumina.Utils.Debug;
 
 //////	//////	//////	//////	//////	//////
@@ -410,7 +409,7 @@ namespace Lumina::WinApp {
 	private:
 		std::function<LRESULT CALLBACK(HWND, UINT, WPARAM, LPARAM)> Callback_{ nullptr };
 
-		std::unordered_map<Message, MessageProcessor> MessageProcessors_{};
+		FlatHashMap<Message, MessageProcessor> MessageProcessors_{};
 
 		RawKeyboard* Keyboard_{ nullptr };
 		RawMouse* Mouse_{ nullptr };
@@ -79,11 +79,11 @@ private:
 		}
 	}
 
-	template<typename T>
+	template<typename T, size_t N>
 	bool Combo(
 		T& content_,
 		int& item_,
-		Lumina::Editor::Lexicon<T> const& lexicon_,
+		Lumina::Editor::Lexicon<T, N> const& lexicon_,
 		char const* label_
 	) {
 		bool ret{ false };
@@ -566,21 +566,21 @@ private:
 	std::vector<std::string> TableNameInputBuffers_{};
 	std::vector<D3D12_STATIC_SAMPLER_DESC> RSStaticSamplers_{};
 
-	static inline Lumina::Editor::Lexicon<D3D12_SHADER_VISIBILITY> const ShaderVisibilities_{
+	static constexpr auto ShaderVisibilities_{ Lumina::Editor::MakeLexicon<D3D12_SHADER_VISIBILITY>({
 		{ "All", D3D12_SHADER_VISIBILITY_ALL },
 		{ "Vertex", D3D12_SHADER_VISIBILITY_VERTEX },
 		{ "Pixel", D3D12_SHADER_VISIBILITY_PIXEL },
-	};
-	static inline Lumina::Editor::Lexicon<D3D12_ROOT_PARAMETER_TYPE> const RootParameterTypes_{
+	}) };
+	static constexpr auto RootParameterTypes_{ Lumina::Editor::MakeLexicon<D3D12_ROOT_PARAMETER_TYPE>({
 		{ "DescriptorTable", D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE },
 		{ "32BitConstants", D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS },
 		{ "CBV", D3D12_ROOT_PARAMETER_TYPE_CBV },
 		{ "SRV", D3D12_ROOT_PARAMETER_TYPE_SRV },
 		{ "UAV", D3D12_ROOT_PARAMETER_TYPE_UAV },
-	};
-	static inline Lumina::Editor::Lexicon<D3D12_DESCRIPTOR_RANGE_TYPE> const DescriptorRangeTypes_{
+	}) };
+	static constexpr auto DescriptorRangeTypes_{ Lumina::Editor::MakeLexicon<D3D12_DESCRIPTOR_RANGE_TYPE>({
 		{ "SRV", D3D12_DESCRIPTOR_RANGE_TYPE_SRV },
 		{ "UAV", D3D12_DESCRIPTOR_RANGE_TYPE_UAV },
 		{ "CBV", D3D12_DESCRIPTOR_RANGE_TYPE_CBV },
-	};
+	}) };
 };
\ No newline at end of file
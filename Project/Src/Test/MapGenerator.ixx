@@ -3,12 +3,35 @@ export module Game.MapGenerator;
 import <cstdint>;
 
 import <numeric>;
+import <random>;
 
 import <vector>;
 import <array>;
+import <algorithm>;
+import <limits>;
+
+import <cstring>;
+import <string>;
+import <format>;
+import <fstream>;
+import <filesystem>;
 
 import Lumina.Math.Numerics;
 import Lumina.Math.Random;
+import Lumina.Math.PoissonDisk;
+import Lumina.Math.PerlinNoise;
+
+import Lumina.Math.CellularAutomaton;
+import Lumina.Math.ConnectedComponents;
+import Lumina.Math.SpanningTree;
+import Lumina.Math.GridPath;
+import Lumina.Math.VoxelVolume;
+
+import Lumina.Container.SmallVector;
+
+import Lumina.Utils.Hash;
+import Lumina.Utils.MappedFile;
+import Lumina.Utils.Path;
 
 namespace Game {
 	namespace {
@@ -30,6 +53,23 @@ namespace Game {
 			{ 0, -1, 0 }, { 0, 1, 0 },
 			{ 0, 0, -1 }, { 0, 0, 1 },
 		};
+
+		// "LMAP", little-endian.
+		constexpr uint32_t MapFileMagic{ 0x50414D4CU };
+		// Bump on any change to what the generator makes from given params, or to the file layout;
+		// it is part of every cache key, so older files are simply never found again.
+		constexpr uint32_t MapFileVersion{ 2U };
+
+		// Followed by the tiles, row by row, as int32_t, and then Num_Features Int2.
+		struct MapFileHeader {
+			uint32_t Magic;
+			uint32_t Version;
+			uint64_t Key;
+			uint32_t Width;
+			uint32_t Height;
+			uint32_t Num_Features;
+			uint32_t Length_Tunnels;
+		};
 	}
 }
 
@@ -167,7 +207,7 @@ namespace Game {
 			};
 			float rnd{
 				static_cast<float>(
-					Lumina::Random::Generator()() & 0xFFFFU
+					RndGen_() & 0xFFFFU
 				) * 0.0000152587890625f
 			};
 			for (size_t idx_Dir{ 0LLU }; idx_Dir < Probabilities_Direction_.size(); ++idx_Dir) {
@@ -191,13 +231,15 @@ namespace Game {
 		}
 
 	public:
-		RandomWalk3D(uint32_t width_, uint32_t height_, uint32_t depth_) :
+		// Draws from rndGen_, which must outlive the walker, so that walks from the same seed are the same.
+		RandomWalk3D(uint32_t width_, uint32_t height_, uint32_t depth_, std::mt19937& rndGen_) :
+			RndGen_{ rndGen_ },
 			MapWidth_{ width_ },
 			MapHeight_{ height_ },
 			MapDepth_{ depth_ } {
-			Position_.x = 1U + Lumina::Random::Generator()() % (MapWidth_ - 2U);
-			Position_.y = 1U + Lumina::Random::Generator()() % (MapHeight_ - 2U);
-			Position_.z = 1U + Lumina::Random::Generator()() % (MapDepth_ - 2U);
+			Position_.x = 1U + RndGen_() % (MapWidth_ - 2U);
+			Position_.y = 1U + RndGen_() % (MapHeight_ - 2U);
+			Position_.z = 1U + RndGen_() % (MapDepth_ - 2U);
 		}
 
 	private:
@@ -205,6 +247,7 @@ namespace Game {
 		DIRECTION PreviousDirection_{};
 		std::array<float, 6> Probabilities_Direction_{};
 
+		std::mt19937& RndGen_;
 		uint32_t MapWidth_{};
 		uint32_t MapHeight_{};
 		uint32_t MapDepth_{};
@@ -214,143 +257,94 @@ namespace Game {
 		float Margins_[6]{ 0.25f, 0.75f, 0.25f, 0.75f, 0.25f, 0.75f, };
 	};
 
-	export class CellularAutomata {
-	private:
-		constexpr uint32_t Num_AdjacentWalls(Lumina::Int2 const& tilePos_) {
-			auto const* mapRowAbove{ Map_[tilePos_.y - 1].data() };
-			auto const* mapRow{ Map_[tilePos_.y].data() };
-			auto const* mapRowBelow{ Map_[tilePos_.y + 1].data() };
-
-			uint32_t cnt{ 0U };
-			{
-				cnt += (mapRowAbove[tilePos_.x - 1] != 0);
-				cnt += (mapRowAbove[tilePos_.x] != 0);
-				cnt += (mapRowAbove[tilePos_.x + 1] != 0);
-				cnt += (mapRow[tilePos_.x - 1] != 0);
-				cnt += (mapRow[tilePos_.x + 1] != 0);
-				cnt += (mapRowBelow[tilePos_.x - 1] != 0);
-				cnt += (mapRowBelow[tilePos_.x] != 0);
-				cnt += (mapRowBelow[tilePos_.x + 1] != 0);
-			}
-
-			return cnt;
+	// Everything a map is generated from, the seed included; equal params give equal maps.
+	export struct MapGenParams {
+		uint32_t Width{ 128U };
+		uint32_t Height{ 64U };
+		uint64_t Seed{ 0LLU };
+
+		// Rows and columns kept wall along each side. The outermost is wall even at 0, as every later stage reads a tile's neighbours.
+		uint32_t Margin{ 1U };
+		float Probability_Wallification{ 0.45f };
+		uint32_t Condition_WallifiedByNeighbors{ 4U };
+		uint32_t Num_SmoothingSteps{ 4U };
+		uint32_t MinSize_Cave{ 16U };
+
+		// Tunnels past the fewest that join every cave, as a fraction of those.
+		float Ratio_ExtraTunnels{ 0.0f };
+		// Per tile a tunnel passes through. Floor must be the cheapest, as the search's heuristic counts on it.
+		float Cost_Floor{ 1.0f };
+		float Cost_Rock{ 4.0f };
+		// Rock costs up to this fraction more or less, varying smoothly at this many cycles per tile.
+		float Amplitude_RockNoise{ 0.5f };
+		float Frequency_RockNoise{ 0.08f };
+		uint32_t Radius_Tunnel{ 1U };
+
+		float Spacing_Features{ 6.0f };
+
+		// Names the map in a cache. Covers every field and the generator's version, so a change to either misses.
+		uint64_t Key() const noexcept {
+			Lumina::Utils::FNV1a hash{};
+			hash.Append(MapFileVersion)
+				.Append(Width).Append(Height).Append(Seed)
+				.Append(Margin).Append(Probability_Wallification).Append(Condition_WallifiedByNeighbors)
+				.Append(Num_SmoothingSteps).Append(MinSize_Cave)
+				.Append(Ratio_ExtraTunnels).Append(Cost_Floor).Append(Cost_Rock)
+				.Append(Amplitude_RockNoise).Append(Frequency_RockNoise).Append(Radius_Tunnel)
+				.Append(Spacing_Features);
+			return hash.Value();
 		}
+	};
 
-		// To be revised
-		constexpr bool CheckConnectivity(uint32_t idx_Cave0_, uint32_t idx_Cave1_) {
-			std::vector<int> checkTable{};
-			checkTable.assign(CaveConnectivities_.size(), 0);
-
-			uint32_t idx_CurrentCave{ idx_Cave0_ };
-			for (size_t cnt_It{ 0U }; (cnt_It < CaveConnectivities_.size()) && (idx_CurrentCave != idx_Cave1_); ++cnt_It) {
-				checkTable[idx_CurrentCave] = 1;
-				for (
-					uint32_t idx_NextCave = 0U;
-					(idx_NextCave < static_cast<uint32_t>(CaveConnectivities_.size()));
-					++idx_NextCave
-				) {
-					if (
-						(idx_CurrentCave != idx_NextCave) &&
-						CaveConnectivities_[idx_CurrentCave][idx_NextCave] &&
-						!checkTable[idx_NextCave]
-					) {
-						idx_CurrentCave = idx_NextCave;
-						idx_NextCave = static_cast<uint32_t>(CaveConnectivities_.size());
-					}
-				}
-			}
-			
-			return (idx_CurrentCave == idx_Cave1_);
-		}
+	export class CellularAutomata {
+	public:
+		// Tile lists are reserved to their cave's area up front; the smallest caves kept, of MinSize_Cave (16 by default) tiles,
+		// fit inline.
+		using CaveTiles = Lumina::SmallVector<Lumina::Int2, 16U>;
 
 	private:
-		void Flood(uint32_t tileX_, uint32_t tileY_) {
-			if ((tileX_ < 0) || (tileX_ >= MapWidth_)) { return; }
-			if ((tileY_ < 0) || (tileY_ >= MapHeight_)) { return; }
-			if (Map_[tileY_][tileX_] != 0) { return; }
-
-			Map_[tileY_][tileX_] ^= ((Caves_.size()) << 20U);
-			Caves_.back().emplace_back(tileX_, tileY_);
-
-			Flood(tileX_ - 1U, tileY_);
-			Flood(tileX_ + 1U, tileY_);
-			Flood(tileX_, tileY_ - 1U);
-			Flood(tileX_, tileY_ + 1U);
-		}
-
+		// Carves the cheapest path between the two tiles over TunnelCosts_, Radius_Tunnel tiles around it,
+		// keeping the border solid. Carved tiles cost as floor to later tunnels, which tend to share them.
 		void GenerateTunnel(Lumina::Int2 const& pos_Start_, Lumina::Int2 const& pos_Goal_) {
-			Lumina::Int2 pos{ pos_Start_ };
-			std::array<float, 4> probs_Dir{};
-
-			//----	------	------	------	------	----//
-
-			while ((pos.x != pos_Goal_.x) || (pos.y != pos_Goal_.y)) {
-				probs_Dir.fill(1.0f);
-
-				//----	------	------	------	------	----//
-
-				if (pos.x > pos_Goal_.x) {
-					probs_Dir[DIRECTION::LEFTWARD] += 2.0f;
-				}
-				else if (pos.x < pos_Goal_.x) {
-					probs_Dir[DIRECTION::RIGHTWARD] += 2.0f;
-				}
-
-				if (pos.y > pos_Goal_.y) {
-					probs_Dir[DIRECTION::UPWARD] += 2.0f;
-				}
-				else if (pos.y < pos_Goal_.y) {
-					probs_Dir[DIRECTION::DOWNWARD] += 2.0f;
-				}
-
-				//----	------	------	------	------	----//
-
-				float const inv_Sum{
-					1.0f / (
-						std::reduce(
-							probs_Dir.cbegin(),
-							probs_Dir.cend()
-						)
-					)
-				};
-				float rnd{
-					static_cast<float>(
-						Lumina::Random::Generator()() & 0xFFFFU
-					) * 0.0000152587890625f
-				};
-				for (size_t idx_Dir{ 0LLU }; idx_Dir < probs_Dir.size(); ++idx_Dir) {
-					auto& prob_Dir{ probs_Dir[idx_Dir] };
-					prob_Dir *= inv_Sum;
-					if (rnd < prob_Dir) {
-						Lumina::Int2 const& dPos{ Displacements_2D[idx_Dir] };
-						Lumina::Int2 newPos{ pos.x + dPos.x, pos.y + dPos.y };
-						if (
-							(newPos.x >= 1 && newPos.x < static_cast<int32_t>(MapWidth_) - 1) &&
-							(newPos.y >= 1 && newPos.y < static_cast<int32_t>(MapHeight_) - 1)
-						) {
-							pos = newPos;
-							Map_[pos.y][pos.x] = 0;
-							break;
-						}
+			bool const isFound{
+				Tunneler_.Find(
+					Params_.Width, Params_.Height, pos_Start_, pos_Goal_,
+					[this] (uint32_t x_, uint32_t y_) { return TunnelCosts_[y_ * Params_.Width + x_]; },
+					Params_.Cost_Floor, TunnelPath_
+				)
+			};
+			if (!isFound) { return; }
+			Length_Tunnels_ += static_cast<uint32_t>(TunnelPath_.size()) - 1U;
+
+			int32_t const radius{ static_cast<int32_t>(Params_.Radius_Tunnel) };
+			for (auto const& pos : TunnelPath_) {
+				for (int32_t y{ std::max(pos.y - radius, 1) }; y <= std::min(pos.y + radius, static_cast<int32_t>(Params_.Height) - 2); ++y) {
+					for (int32_t x{ std::max(pos.x - radius, 1) }; x <= std::min(pos.x + radius, static_cast<int32_t>(Params_.Width) - 2); ++x) {
+						int32_t const dx{ x - pos.x };
+						int32_t const dy{ y - pos.y };
+						if (dx * dx + dy * dy > radius * radius) { continue; }
+
+						// Cave tiles keep their number; only rock is dug out.
+						if (Map_[y][x] == 1) { Map_[y][x] = 0; }
+						TunnelCosts_[y * Params_.Width + x] = Params_.Cost_Floor;
 					}
-					rnd -= prob_Dir;
 				}
 			}
 		}
 
 	private:
 		void SetInitialState() {
-			auto& rndGen{ Lumina::Random::Generator() };
-
-			for (uint32_t y{ MapMargin_ }; y < (MapHeight_ - MapMargin_); ++y) {
+			// The automaton leaves edge cells as they are, so a floor tile on the border would stay one.
+			uint32_t const margin{ std::max(Params_.Margin, 1U) };
+			for (uint32_t y{ margin }; y + margin < Params_.Height; ++y) {
 				auto* mapRow{ Map_.at(y).data() };
-				for (uint32_t x{ MapMargin_ }; x < (MapWidth_ - MapMargin_); ++x) {
+				for (uint32_t x{ margin }; x + margin < Params_.Width; ++x) {
 					float rnd{
 						static_cast<float>(
-							rndGen() & 0xFFFFU
+							RndGen_() & 0xFFFFU
 						) * 0.0000152587890625f
 					};
-					if (rnd >= Probability_Wallification_) {
+					if (rnd >= Params_.Probability_Wallification) {
 						mapRow[x] = 0;
 					}
 				}
@@ -358,103 +352,152 @@ namespace Game {
 		}
 
 		void GenerateCaves() {
-			Lumina::Int2 tile{};
-			for (uint32_t cnt_It{ 0U }; cnt_It < Iterations_; ++cnt_It) {
-				tile.x = 1U + Lumina::Random::Generator()() % (MapWidth_ - 2U);
-				tile.y = 1U + Lumina::Random::Generator()() % (MapHeight_ - 2U);
-				uint32_t num_Walls{ Num_AdjacentWalls(tile) };
-				if (num_Walls > Condition_WallifiedByNeighbors_) { Map_[tile.y][tile.x] = 1; }
-				else if (num_Walls < Condition_WallifiedByNeighbors_) { Map_[tile.y][tile.x] = 0; }
+			// Walls are the live cells; each step smooths the whole map at once, the border staying wall.
+			Lumina::CellularAutomaton automaton{};
+			automaton.Resize(Params_.Width, Params_.Height);
+			for (uint32_t y{ 0U }; y < Params_.Height; ++y) {
+				auto const* mapRow{ Map_.at(y).data() };
+				for (uint32_t x{ 0U }; x < Params_.Width; ++x) {
+					automaton.Grid().Set(x, y, mapRow[x] != 0);
+				}
+			}
+
+			automaton.Step(Lumina::AutomatonRule::Caves(Params_.Condition_WallifiedByNeighbors), Params_.Num_SmoothingSteps);
+
+			auto const& grid{ automaton.Grid() };
+			for (uint32_t y{ 0U }; y < Params_.Height; ++y) {
+				auto* mapRow{ Map_.at(y).data() };
+				for (uint32_t x{ 0U }; x < Params_.Width; ++x) {
+					mapRow[x] = grid(x, y) ? 1 : 0;
+				}
 			}
 		}
 
 		void IdentifyCaves() {
-			for (uint32_t y{ 0U }; y < MapHeight_; ++y) {
+			// Floor tiles, 4-connected as the player walks, numbered in scan order.
+			Lumina::ConnectedComponents components{};
+			components.Label(Params_.Width, Params_.Height, [this] (uint32_t x_, uint32_t y_) { return Map_[y_][x_] == 0; });
+
+			// Components below MinSize_Cave are filled back in; the rest become caves, numbered from 1 in the upper bits of their tiles.
+			constexpr uint32_t Filled{ 0xFFFFFFFFU };
+			std::vector<uint32_t> idx_Caves(components.Num_Components() + 1U, Filled);
+			Caves_.clear();
+			for (uint32_t label{ 1U }; label <= components.Num_Components(); ++label) {
+				if (components[label].Area < Params_.MinSize_Cave) { continue; }
+				idx_Caves[label] = static_cast<uint32_t>(Caves_.size());
+				Caves_.emplace_back().reserve(components[label].Area);
+			}
+
+			for (uint32_t y{ 0U }; y < Params_.Height; ++y) {
 				auto* mapRow{ Map_.at(y).data() };
-				for (uint32_t x{ 0U }; x < MapWidth_; ++x) {
-					if (mapRow[x] == 0) {
-						auto& newCave{ Caves_.emplace_back() };
-						Flood(x, y);
-						if (newCave.size() < MinSize_Cave_) {
-							for (auto const& tilePos : newCave) {
-								Map_[tilePos.y][tilePos.x] = 1;
-							}
-							Caves_.pop_back();
-						}
-						else {
-							CaveConnectivities_.emplace_back();
-						}
+				for (uint32_t x{ 0U }; x < Params_.Width; ++x) {
+					uint32_t const label{ components(x, y) };
+					if (label == Lumina::ConnectedComponents::Background) { continue; }
+
+					uint32_t const idx_Cave{ idx_Caves[label] };
+					if (idx_Cave == Filled) {
+						mapRow[x] = 1;
+						continue;
 					}
+					mapRow[x] = static_cast<int>((idx_Cave + 1U) << 20U);
+					Caves_[idx_Cave].emplace_back(x, y);
 				}
 			}
 		}
 
 		void ConnectCaves() {
-			for (auto& connectivity : CaveConnectivities_) {
-				connectivity.assign(CaveConnectivities_.size(), 0);
-			}
-
-			uint32_t idx_Cave0{};
-			uint32_t idx_Cave1{};
-			for (idx_Cave0 = 0U; idx_Cave0 < static_cast<uint32_t>(Caves_.size()); ++idx_Cave0) {
-				CaveConnectivities_[idx_Cave0][idx_Cave0] = 1;
-				uint32_t shortestDist2{ 0xFFFFFFFFU };
-
-				auto& cave0{ Caves_[idx_Cave0] };
-				auto const idx0{ Lumina::Random::Generator()() % static_cast<uint32_t>(cave0.size()) };
-				Lumina::Int2 pos0{ cave0[idx0] };
-				Lumina::Int2 pos1{};
-
-				for (uint32_t idx_Cave1Canditate = 0U; idx_Cave1Canditate < static_cast<uint32_t>(Caves_.size()); ++idx_Cave1Canditate) {
-					if (CheckConnectivity(idx_Cave0, idx_Cave1Canditate)) { continue; }
-
-					auto& cave1{ Caves_[idx_Cave1Canditate] };
-					auto const idx1{ Lumina::Random::Generator()() % static_cast<uint32_t>(cave1.size()) };
-					auto const& pos1Candidate{ cave1[idx1] };
-
-					int32_t const dx{ pos0.x - pos1Candidate.x };
-					int32_t const dy{ pos0.y - pos1Candidate.y };
-					uint32_t const dist2{ static_cast<uint32_t>(dx * dx) + static_cast<uint32_t>(dy * dy) };
-					if (shortestDist2 > dist2) {
-						shortestDist2 = dist2;
-						pos1 = pos1Candidate;
-						idx_Cave1 = idx_Cave1Canditate;
+			// Cave tiles beside a wall; the closest tiles of two caves are always among them.
+			// SetInitialState keeps the border wall, so every cave tile has all four neighbours on the map.
+			std::vector<Lumina::RegionSpanningTree::Site> sites{};
+			for (uint32_t idx_Cave{ 0U }; idx_Cave < static_cast<uint32_t>(Caves_.size()); ++idx_Cave) {
+				for (auto const& tile : Caves_[idx_Cave]) {
+					int const cave{ Map_[tile.y][tile.x] };
+					if (
+						Map_[tile.y][tile.x - 1] != cave || Map_[tile.y][tile.x + 1] != cave ||
+						Map_[tile.y - 1][tile.x] != cave || Map_[tile.y + 1][tile.x] != cave
+					) {
+						sites.emplace_back(tile, idx_Cave);
 					}
 				}
+			}
 
-				if ((pos1.x != 0) && (pos1.y != 0)) {
-					GenerateTunnel(pos0, pos1);
-					CaveConnectivities_[idx_Cave0][idx_Cave1] = 1;
-					CaveConnectivities_[idx_Cave1][idx_Cave0] = 1;
+			// What a tunnel pays to step into each tile: little through open floor, more through rock that noise
+			// makes harder in places, so that tunnels wind around it; nothing gets through the border.
+			Lumina::PerlinNoise const noise{
+				Params_.Frequency_RockNoise, 2U, 0.5f,
+				{ 0.0f, 0.0f, static_cast<float>(RndGen_() & 0xFFFFU) }
+			};
+			TunnelCosts_.resize(Params_.Width * Params_.Height);
+			for (uint32_t y{ 0U }; y < Params_.Height; ++y) {
+				for (uint32_t x{ 0U }; x < Params_.Width; ++x) {
+					float& cost{ TunnelCosts_[y * Params_.Width + x] };
+					if (x == 0U || y == 0U || x + 1U == Params_.Width || y + 1U == Params_.Height) {
+						cost = std::numeric_limits<float>::infinity();
+					}
+					else if (Map_[y][x] != 1) {
+						cost = Params_.Cost_Floor;
+					}
+					else {
+						float const rock{ Params_.Cost_Rock * (1.0f + Params_.Amplitude_RockNoise * noise(static_cast<float>(x), static_cast<float>(y), 0.0f)) };
+						cost = std::max(rock, Params_.Cost_Floor);
+					}
 				}
 			}
+
+			// The fewest, shortest tunnels that join every cave, plus a few more for loops.
+			Lumina::RegionSpanningTree tunnels{};
+			tunnels.Build(static_cast<uint32_t>(Caves_.size()), sites, { .Ratio_ExtraLinks{ Params_.Ratio_ExtraTunnels } });
+			Length_Tunnels_ = 0U;
+			for (auto const& tunnel : tunnels.Links()) {
+				GenerateTunnel(tunnel.From, tunnel.To);
+			}
 		}
 
 		void GenerateFeatures() {
-			for (uint32_t y{ 1U }; y < MapHeight_ - 1U; ++y) {
-				for (uint32_t x{ 1U }; x < MapWidth_ - 1U; ++x) {
+			std::vector<Lumina::Int2> spots{};
+			for (uint32_t y{ 1U }; y < Params_.Height - 1U; ++y) {
+				for (uint32_t x{ 1U }; x < Params_.Width - 1U; ++x) {
 					int tile = Map_[y][x] & ((1 << 20U) - 1);
 					int tileBelow = Map_[y + 1U][x] & ((1 << 20U) - 1);
 					if ((tile == 0) && (tileBelow != 0)) {
 						Map_[y + 1U][x] &= ~((1 << 20U) - 1);
 						Map_[y + 1U][x] |= 2;
+						spots.emplace_back(x, y);
 					}
 				}
 			}
+
+			// Feature sites stand on the surfaces marked above, at least Spacing_Features apart.
+			// Surfaces are too thin for Bridson's darts to hit, so every spot is offered once, in random order.
+			std::mt19937 rndGen{ RndGen_() };
+			std::shuffle(spots.begin(), spots.end(), rndGen);
+
+			Lumina::PoissonDisk<2U> sampler{ {
+				.Min{ 0.0f, 0.0f },
+				.Max{ static_cast<float>(Params_.Width), static_cast<float>(Params_.Height) },
+				.MinRadius{ Params_.Spacing_Features },
+				.MaxRadius{ Params_.Spacing_Features },
+			} };
+			Features_.clear();
+			for (auto const& spot : spots) {
+				if (sampler.TryInsert({ static_cast<float>(spot.x) + 0.5f, static_cast<float>(spot.y) + 0.5f }, Params_.Spacing_Features)) {
+					Features_.emplace_back(spot);
+				}
+			}
 		}
 
 		void GenerateItems() {
 
 		}
 
-	public:
-		void Run(uint32_t mapWidth_, uint32_t mapHeight_) {
-			MapWidth_ = mapWidth_;
-			MapHeight_ = mapHeight_;
+	private:
+		void Generate() {
+			std::seed_seq seeds{ static_cast<uint32_t>(Params_.Seed), static_cast<uint32_t>(Params_.Seed >> 32U) };
+			RndGen_.seed(seeds);
 
-			Map_.resize(MapHeight_);
+			Map_.resize(Params_.Height);
 			for (auto& mapRow : Map_) {
-				mapRow.assign(MapWidth_, 1);
+				mapRow.assign(Params_.Width, 1);
 			}
 
 			SetInitialState();
@@ -464,30 +507,244 @@ namespace Game {
 			GenerateFeatures();
 		}
 
+		bool Load(std::string const& path_) {
+			Lumina::Utils::MappedFile file{};
+			if (!file.Open(path_) || file.Size() < sizeof(MapFileHeader)) { return false; }
+
+			MapFileHeader header{};
+			std::memcpy(&header, file.Data(), sizeof(MapFileHeader));
+			size_t const size_Row{ sizeof(int32_t) * Params_.Width };
+			size_t const size_Tiles{ size_Row * Params_.Height };
+			size_t const size_Features{ sizeof(Lumina::Int2) * header.Num_Features };
+			if (
+				header.Magic != MapFileMagic || header.Version != MapFileVersion || header.Key != Params_.Key() ||
+				header.Width != Params_.Width || header.Height != Params_.Height ||
+				file.Size() != sizeof(MapFileHeader) + size_Tiles + size_Features
+			) {
+				return false;
+			}
+
+			std::byte const* data{ file.Data() + sizeof(MapFileHeader) };
+			Map_.resize(Params_.Height);
+			for (auto& mapRow : Map_) {
+				mapRow.resize(Params_.Width);
+				std::memcpy(mapRow.data(), data, size_Row);
+				data += size_Row;
+			}
+			Length_Tunnels_ = header.Length_Tunnels;
+			Features_.resize(header.Num_Features);
+			std::memcpy(Features_.data(), data, size_Features);
+
+			// Caves are not stored: their tiles carry their number, and a scan finds them in the order IdentifyCaves did.
+			Caves_.clear();
+			for (uint32_t y{ 0U }; y < Params_.Height; ++y) {
+				auto const* mapRow{ Map_[y].data() };
+				for (uint32_t x{ 0U }; x < Params_.Width; ++x) {
+					uint32_t const cave{ static_cast<uint32_t>(mapRow[x]) >> 20U };
+					if (cave == 0U || (mapRow[x] & ((1 << 20U) - 1)) != 0) { continue; }
+					if (Caves_.size() < cave) { Caves_.resize(cave); }
+					Caves_[cave - 1U].emplace_back(x, y);
+				}
+			}
+			return true;
+		}
+
+		// Written next to the final path and renamed over it, so that a reader never maps a half-written file.
+		// A cache that cannot be written is no reason to fail: the map is simply generated again next time.
+		void Store(std::string const& path_) const {
+			std::error_code error{};
+			std::filesystem::path const path{ path_ };
+			std::filesystem::create_directories(path.parent_path(), error);
+
+			std::filesystem::path const path_Temp{ path_ + ".tmp" };
+			{
+				std::ofstream ofs{ path_Temp, std::ios::binary | std::ios::trunc };
+				if (!ofs) { return; }
+
+				MapFileHeader const header{
+					.Magic{ MapFileMagic },
+					.Version{ MapFileVersion },
+					.Key{ Params_.Key() },
+					.Width{ Params_.Width },
+					.Height{ Params_.Height },
+					.Num_Features{ static_cast<uint32_t>(Features_.size()) },
+					.Length_Tunnels{ Length_Tunnels_ },
+				};
+				ofs.write(reinterpret_cast<char const*>(&header), sizeof(MapFileHeader));
+				for (auto const& mapRow : Map_) {
+					ofs.write(reinterpret_cast<char const*>(mapRow.data()), static_cast<std::streamsize>(sizeof(int32_t) * mapRow.size()));
+				}
+				ofs.write(reinterpret_cast<char const*>(Features_.data()), static_cast<std::streamsize>(sizeof(Lumina::Int2) * Features_.size()));
+				if (!ofs) {
+					ofs.close();
+					std::filesystem::remove(path_Temp, error);
+					return;
+				}
+			}
+			std::filesystem::rename(path_Temp, path, error);
+		}
+
+	public:
+		// The same params_ give the same map, tile for tile.
+		void Run(MapGenParams const& params_) {
+			Params_ = params_;
+			Generate();
+		}
+
+		// Maps the file an earlier run left in directory_ for the same params_, or generates the map and leaves one there.
+		// A relative directory_ is taken from the executable's directory, so that the cache does not move with the working one.
+		// Returns whether the map came from the file.
+		bool Run(MapGenParams const& params_, std::string_view directory_) {
+			Params_ = params_;
+			std::string const path{ CachePath(params_, directory_) };
+			if (Load(path)) { return true; }
+
+			Generate();
+			Store(path);
+			return false;
+		}
+
+		static std::string CachePath(MapGenParams const& params_, std::string_view directory_) {
+			return (Lumina::Utils::FromExecutableDirectory(directory_) / std::format("{:016X}.map", params_.Key())).string();
+		}
+
 		// Temporary
 		void GetMap(std::vector<std::vector<int>>& map_) {
 			map_ = Map_;
 		}
 
-		std::vector<std::vector<Lumina::Int2>> const& GetCaves() const {
+		std::vector<CaveTiles> const& GetCaves() const {
 			return Caves_;
 		}
 
+		std::vector<Lumina::Int2> const& GetFeatures() const {
+			return Features_;
+		}
+
+		// Steps along every tunnel's path, before the brush widens it.
+		uint32_t GetTunnelLength() const noexcept {
+			return Length_Tunnels_;
+		}
+
+		MapGenParams const& GetParams() const noexcept {
+			return Params_;
+		}
+
 	private:
 		std::vector<std::vector<int>> Map_{};
-		std::vector<std::vector<Lumina::Int2>> Caves_{};
-		std::vector<std::vector<int>> CaveConnectivities_{};
+		std::vector<CaveTiles> Caves_{};
+		std::vector<Lumina::Int2> Features_{};
 
-		uint32_t MapWidth_{ 128U };
-		uint32_t MapHeight_{ 64U };
-		uint32_t MapMargin_{ 1U };
+		Lumina::GridPathFinder Tunneler_{};
+		std::vector<float> TunnelCosts_{};
+		std::vector<Lumina::Int2> TunnelPath_{};
+		uint32_t Length_Tunnels_{ 0U };
 
+		MapGenParams Params_{};
+		std::mt19937 RndGen_{};
 		uint32_t MaxSize_Cave_{ 500U };
-		uint32_t MinSize_Cave_{ 16U };
+	};
+
+	// Everything a cave volume is generated from, the seed included; equal params give equal volumes.
+	// Sizes are whole bricks, multiples of 8.
+	export struct VoxelCaveParams {
+		uint32_t Width{ 256U };
+		uint32_t Height{ 256U };
+		uint32_t Depth{ 256U };
+		uint64_t Seed{ 0LLU };
+
+		// Each walker digs out a ball of Radius_Brush voxels around every position it takes, Radius_Brush + 1 voxels
+		// clear of the sides.
+		uint32_t Num_Walkers{ 24U };
+		uint32_t Num_StepsPerWalker{ 4096U };
+		uint32_t Radius_Brush{ 2U };
+
+		// Smoothing of the open voxels: rock with at least Threshold_Birth open neighbours of 26 opens,
+		// open voxels with fewer than Threshold_Survival fill in.
+		uint32_t Num_SmoothingSteps{ 3U };
+		uint32_t Threshold_Birth{ 14U };
+		uint32_t Threshold_Survival{ 10U };
+		// Caves of fewer voxels are filled in.
+		uint32_t MinSize_Cave{ 512U };
+	};
+
+	// Caves dug by 3D random walks into solid rock. Only the open voxels are stored, in a SparseVoxelVolume,
+	// so memory follows the caves rather than the volume around them.
+	export class VoxelCaves {
+	private:
+		void Dig() {
+			uint32_t const margin{ Params_.Radius_Brush + 1U };
+			int32_t const offset{ static_cast<int32_t>(margin) };
+			auto& volume{ Automaton_.Volume() };
+			for (uint32_t i{ 0U }; i < Params_.Num_Walkers; ++i) {
+				RandomWalk3D walker{ Params_.Width - 2U * margin, Params_.Height - 2U * margin, Params_.Depth - 2U * margin, RndGen_ };
+				for (uint32_t step{ 0U }; step < Params_.Num_StepsPerWalker; ++step) {
+					Lumina::Int3 const& pos{ walker.Position() };
+					volume.FillSphere({ pos.x + offset, pos.y + offset, pos.z + offset }, static_cast<int32_t>(Params_.Radius_Brush));
+					walker();
+				}
+			}
+		}
+
+		// Fills in the caves under MinSize_Cave, and labels what is left.
+		void IdentifyCaves() {
+			auto& volume{ Automaton_.Volume() };
+			Caves_.Label(volume);
+
+			bool isFilled{ false };
+			Caves_.ForEachPiece(
+				[this, &volume, &isFilled] (uint32_t idx_Brick_, Lumina::SparseVoxelVolume::Brick const& mask_, uint32_t label_) {
+					if (Caves_[label_].Volume >= Params_.MinSize_Cave) { return; }
+					auto& brick{ volume.GetBrick(idx_Brick_) };
+					for (uint32_t z{ 0U }; z < 8U; ++z) { brick[z] &= ~mask_[z]; }
+					isFilled = true;
+				}
+			);
+			if (isFilled) {
+				volume.Compact();
+				Caves_.Label(volume);
+			}
+		}
+
+	public:
+		// The same params_ give the same caves, voxel for voxel.
+		void Run(VoxelCaveParams const& params_) {
+			Params_ = params_;
+			std::seed_seq seeds{ static_cast<uint32_t>(Params_.Seed), static_cast<uint32_t>(Params_.Seed >> 32U) };
+			RndGen_.seed(seeds);
+
+			Automaton_.Resize(Params_.Width, Params_.Height, Params_.Depth);
+			Dig();
+			Automaton_.Step(Lumina::VoxelRule::AtLeast(Params_.Threshold_Birth, Params_.Threshold_Survival), Params_.Num_SmoothingSteps);
+			IdentifyCaves();
+			Automaton_.Volume().ExtractSurface(Surface_);
+		}
+
+		// Set voxels are open.
+		Lumina::SparseVoxelVolume const& GetVolume() const noexcept {
+			return Automaton_.Volume();
+		}
+
+		// The open voxels beside rock, where walls, floors and ceilings go.
+		Lumina::SparseVoxelVolume const& GetSurface() const noexcept {
+			return Surface_;
+		}
+
+		Lumina::VoxelComponents const& GetCaves() const noexcept {
+			return Caves_;
+		}
+
+		VoxelCaveParams const& GetParams() const noexcept {
+			return Params_;
+		}
+
+	private:
+		Lumina::VoxelAutomaton Automaton_{};
+		Lumina::SparseVoxelVolume Surface_{};
+		Lumina::VoxelComponents Caves_{};
 
-		uint32_t Iterations_{ 30000U };
-		uint32_t Condition_WallifiedByNeighbors_{ 4U };
-		float Probability_Wallification_{ 0.45f };
+		VoxelCaveParams Params_{};
+		std::mt19937 RndGen_{};
 	};
 
 	export class MapGenerator {
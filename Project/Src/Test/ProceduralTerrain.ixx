@@ -8,6 +8,8 @@ module;
 
 export module Lumina.ProceduralTerrain;
 
+import <memory>;
+
 import Lumina.DX12;
 import Lumina.DX12.Context;
 import Lumina.DX12.Aux;
@@ -16,41 +18,21 @@ import Lumina.DX12.Aux.View;
 import Lumina.Utils.Data;
 
 import Lumina.Math.Numerics;
-import Lumina.Math.Vector;
-import Lumina.Math.PerlinNoise;
 
 import Lumina.Utils.ImGui;
 
+import Lumina.TerrainPipeline;
+
 namespace Lumina {
 	namespace {
 		struct Vertex {
 			Float4 Position;
 		};
-
-		struct MapSurflet {
-			float Elevation;
-			Float3 Normal;
-		};
-
-		struct Climate {
-			float Temperature;
-			float Precipitation;
-		};
-
-		struct NoiseParam {
-			float Frequency;
-			float Redist;
-			Float3 Offset;
-			uint32_t Num_Octaves;
-			float Persistance;
-		};
 	}
 
 	export class Terrain {
 	public:
-		void UpdateElevation(DX12::CommandQueue& directQueue_);
-		void UpdateTemperature(DX12::CommandQueue& directQueue_);
-		void UpdatePrecipitation(DX12::CommandQueue& directQueue_);
+		// Submits what the editor changed to the pipeline, and uploads what of its latest result is new.
 		void Update(DX12::CommandQueue& directQueue_);
 
 		void Render(
@@ -65,7 +47,11 @@ namespace Lumina {
 		);
 
 		Terrain() = default;
-		~Terrain();
+		~Terrain() = default;
+
+	private:
+		// Copies the parts of the latest result that changed to the GPU, without waiting for the copy.
+		void Upload(DX12::CommandQueue& directQueue_);
 
 	private:
 		DX12::CommandAllocator ComputeAllocator_{};
@@ -89,8 +75,14 @@ namespace Lumina {
 		DX12::Shader RenderPixelShader_{};
 		DX12::GraphicsPSO RenderPSO_{};
 
-		MapSurflet* MapSurflets_{ nullptr };
-		Climate* ClimateData_{ nullptr };
+		// Builds the fields on its worker, keeping every stage; rebuilds only what a change reaches.
+		std::unique_ptr<TerrainPipeline> Pipeline_{};
+		TerrainParams Params_{};
+		// Those of the params last submitted, and of the result last uploaded.
+		uint64_t Submission_Last_{ 0LLU };
+		uint64_t Submission_Uploaded_{ 0LLU };
+		// Of the last upload, which has to be done before DirectList_ and the upload buffers are reused.
+		uint64_t FenceValue_Upload_{ 0LLU };
 		uint32_t Width_{ 512U };
 		uint32_t Height_{ 512U };
 
@@ -98,194 +90,70 @@ namespace Lumina {
 		DX12::DefaultBuffer QuadIndexBuffer_{};
 		D3D12_VERTEX_BUFFER_VIEW QuadVBV_{};
 		D3D12_INDEX_BUFFER_VIEW QuadIBV_{};
-
-		NoiseParam ElevationNoiseParam_{
-			.Frequency{ 0.4f },
-			.Redist{ 2.0f },
-			.Offset{ 0.0f, 0.0f, 0.0f },
-			.Num_Octaves{ 8U },
-			.Persistance{ 0.5f },
-		};
-		float Insulation_{ 0.3f };
-		int IsFormingTerraces_{ 0 };
-		float TerraceFactor_{ 8.0f };
-
-		NoiseParam TemperatureNoiseParam_{
-			.Frequency{ 1.0f },
-			.Redist{ 1.0f },
-			.Offset{ 1.0f, 3.0f, 5.0f },
-			.Num_Octaves{ 2U },
-			.Persistance{ 0.25f },
-		};
-		NoiseParam PrecipitationNoiseParam_{
-			.Frequency{ 2.0f },
-			.Redist{ 1.0f },
-			.Offset{ 2.0f, 3.0f, 4.0f },
-			.Num_Octaves{ 2U },
-			.Persistance{ 0.25f },
-		};
 	};
 
-	void Terrain::UpdateElevation(DX12::CommandQueue& directQueue_) {
-		const Math::PerlinNoise noiseGen{
-			ElevationNoiseParam_.Frequency,
-			ElevationNoiseParam_.Num_Octaves,
-			ElevationNoiseParam_.Persistance,
-			ElevationNoiseParam_.Offset
-		};
-
-		constexpr float div{ 1.0f / 32.0f };
-		const float inv_Width = 1.0f / static_cast<float>(Width_);
-		const float inv_Height = 1.0f / static_cast<float>(Height_);
-		float inv_TerraceFactor_{ 1.0f / TerraceFactor_ };
-
-		for (uint32_t v = 0; v < Height_; ++v) {
-			for (uint32_t u = 0; u < Width_; ++u) {
-				const float noise{ noiseGen(u * div, v * div, 0.0f) };
-
-				const float nu = 2.0f * u * inv_Width - 1.0f;
-				const float nv = 2.0f * v * inv_Height - 1.0f;
-				const float island = (1.0f - nu * nu) * (1.0f - nv * nv);
-				const float val = noise * (1.0f - Insulation_) + island * Insulation_;
-
-				auto& surflet{ MapSurflets_[v * Width_ + u] };
-
-				surflet.Elevation = std::pow(val, ElevationNoiseParam_.Redist);
-				surflet.Elevation *= 2.0f;
-				if (IsFormingTerraces_) {
-					surflet.Elevation *= TerraceFactor_;
-					surflet.Elevation = std::round(surflet.Elevation);
-					surflet.Elevation *= inv_TerraceFactor_;
-				}
-			}
-		}
-
-		for (uint32_t v = 0; v < Height_; ++v) {
-			uint32_t v0 = (v == 0) ? (v) : (v - 1);
-			uint32_t v1 = (v == Height_ - 1) ? (v) : (v + 1);
-			
-			for (uint32_t u = 0; u < Width_; ++u) {
-				uint32_t u0 = (u == 0) ? (u) : (u - 1);
-				uint32_t u1 = (u == Width_ - 1) ? (u) : (u + 1);
-
-				Vec3 df_du{ (u1 - u0) * div, 0.0f, MapSurflets_[v * Width_ + u1].Elevation - MapSurflets_[v * Width_ + u0].Elevation};
-				Vec3 df_dv{ 0.0f, (v1 - v0) * div, MapSurflets_[v1 * Width_ + u].Elevation - MapSurflets_[v0 * Width_ + u].Elevation };
-				Vec3 unit{ Vec3::Cross(df_du, df_dv) };
-				unit = unit.Unit();
-				MapSurflets_[v * Width_ + u].Normal = { unit.x, unit.y, unit.z };
-			}
-		}
-
-		MapSurfletUpload_.Store(MapSurflets_, MapSurfletUpload_.SizeInBytes(), 0U);
-		DirectList_->CopyResource(MapSurfletBuffer_.Get(), MapSurfletUpload_.Get());
-		directQueue_ << DirectList_;
-		directQueue_.CPUWait(directQueue_.ExecuteBatchedCommandLists());
-		DirectList_.Reset(DirectAllocator_);
-	}
-
-	void Terrain::UpdateTemperature(DX12::CommandQueue& directQueue_) {
-		Math::PerlinNoise noiseGen{
-			TemperatureNoiseParam_.Frequency,
-			TemperatureNoiseParam_.Num_Octaves,
-			TemperatureNoiseParam_.Persistance,
-			TemperatureNoiseParam_.Offset
-		};
-
-		constexpr float div{ 1.0f / 32.0f };
-		const float inv_Height = 1.0f / static_cast<float>(Height_);
-
-		for (uint32_t v = 0; v < Height_; ++v) {
-			float latFactor{
-				(1.0f - std::abs(static_cast<int32_t>(v << 1U) - static_cast<int32_t>(Height_)) * inv_Height)
-			};
-			for (uint32_t u = 0; u < Width_; ++u) {
-				const float noise{ noiseGen(u * div, v * div, 0.0f) };
-
-				float elvFactor{
-					1.0f - MapSurflets_[v * Width_ + u].Elevation * 0.5f
-				};
-
-				auto& climate{ ClimateData_[v * Width_ + u] };
-				climate.Temperature = std::pow(noise, TemperatureNoiseParam_.Redist);
-				climate.Temperature =
-					climate.Temperature * 0.65f +
-					std::pow(latFactor, 1.5f) * 0.35f;
-				climate.Temperature *= elvFactor;
-			}
-		}
-
-		ClimateUpload_.Store(ClimateData_, ClimateUpload_.SizeInBytes(), 0U);
-		DirectList_->CopyResource(ClimateBuffer_.Get(), ClimateUpload_.Get());
-		directQueue_ << DirectList_;
-		directQueue_.CPUWait(directQueue_.ExecuteBatchedCommandLists());
-		DirectList_.Reset(DirectAllocator_);
-	}
-
-	void Terrain::UpdatePrecipitation(DX12::CommandQueue& directQueue_) {
-		Math::PerlinNoise noiseGen{
-			PrecipitationNoiseParam_.Frequency,
-			PrecipitationNoiseParam_.Num_Octaves,
-			PrecipitationNoiseParam_.Persistance,
-			PrecipitationNoiseParam_.Offset
-		};
-
-		constexpr float div{ 1.0f / 32.0f };
-
-		for (uint32_t v = 0; v < Height_; ++v) {
-			for (uint32_t u = 0; u < Width_; ++u) {
-				const float noise{ noiseGen(u * div, v * div, 0.0f) };
-
-				auto& climate{ ClimateData_[v * Width_ + u] };
-				climate.Precipitation = std::pow(noise, PrecipitationNoiseParam_.Redist);
-			}
-		}
-
-		ClimateUpload_.Store(ClimateData_, ClimateUpload_.SizeInBytes(), 0U);
-		DirectList_->CopyResource(ClimateBuffer_.Get(), ClimateUpload_.Get());
-		directQueue_ << DirectList_;
-		directQueue_.CPUWait(directQueue_.ExecuteBatchedCommandLists());
-		DirectList_.Reset(DirectAllocator_);
-	}
-
 	void Terrain::Update(DX12::CommandQueue& directQueue_){
 		ImGui::Begin("Procedural Terrain");
 
+		// Every tweak goes to the pipeline straight away; it waits for them to settle itself.
+		bool isChanged{ false };
+
 		ImGui::SeparatorText("Elevation");
-		ImGui::DragFloat("Frequency##TerElv", &ElevationNoiseParam_.Frequency, 0.01f);
-		ImGui::DragFloat("Redistribution##TerElv", &ElevationNoiseParam_.Redist, 0.01f);
-		ImGui::DragFloat3("Offset##TerElv", reinterpret_cast<float*>(&ElevationNoiseParam_.Offset), 0.01f);
-		ImGui::DragInt("Octaves##TerElv", reinterpret_cast<int*>(&ElevationNoiseParam_.Num_Octaves), 0.1f, 1, 32);
-		ImGui::DragFloat("Persistance##TerElv", &ElevationNoiseParam_.Persistance, 0.01f, 0.0f, 0.875f);
-		ImGui::DragFloat("Insulation##TerElv", &Insulation_, 0.01f, 0.0f, 1.0f);
-		ImGui::Checkbox("Is Forming Terraces##TerElv", reinterpret_cast<bool*>(&IsFormingTerraces_));
-		ImGui::DragFloat("Terrace Factor##TerElv", &TerraceFactor_, 0.01f, 1.0f, 32.0f);
-		if (ImGui::Button("Update##TerElv")) {
-			UpdateElevation(directQueue_);
-		}
+		isChanged |= ImGui::DragFloat("Frequency##TerElv", &Params_.Elevation.Frequency, 0.01f);
+		isChanged |= ImGui::DragFloat("Redistribution##TerElv", &Params_.Elevation.Redist, 0.01f);
+		isChanged |= ImGui::DragFloat3("Offset##TerElv", reinterpret_cast<float*>(&Params_.Elevation.Offset), 0.01f);
+		isChanged |= ImGui::DragInt("Octaves##TerElv", reinterpret_cast<int*>(&Params_.Elevation.Num_Octaves), 0.1f, 1, 32);
+		isChanged |= ImGui::DragFloat("Persistance##TerElv", &Params_.Elevation.Persistance, 0.01f, 0.0f, 0.875f);
+		isChanged |= ImGui::DragFloat("Insulation##TerElv", &Params_.Insulation, 0.01f, 0.0f, 1.0f);
+		isChanged |= ImGui::Checkbox("Is Forming Terraces##TerElv", &Params_.IsFormingTerraces);
+		isChanged |= ImGui::DragFloat("Terrace Factor##TerElv", &Params_.TerraceFactor, 0.01f, 1.0f, 32.0f);
 
 		ImGui::SeparatorText("Temperature");
-		ImGui::DragFloat("Frequency##TerTmp", &TemperatureNoiseParam_.Frequency, 0.01f);
-		ImGui::DragFloat("Redistribution##TerTmp", &TemperatureNoiseParam_.Redist, 0.01f);
-		ImGui::DragFloat3("Offset##TerTmp", reinterpret_cast<float*>(&TemperatureNoiseParam_.Offset), 0.01f);
-		ImGui::DragInt("Octaves##TerTmp", reinterpret_cast<int*>(&TemperatureNoiseParam_.Num_Octaves), 0.1f, 1, 32);
-		ImGui::DragFloat("Persistance##TerTmp", &TemperatureNoiseParam_.Persistance, 0.01f, 0.0f, 0.875f);
-		if (ImGui::Button("Update##TerTmp")) {
-			UpdateTemperature(directQueue_);
-		}
+		isChanged |= ImGui::DragFloat("Frequency##TerTmp", &Params_.Temperature.Frequency, 0.01f);
+		isChanged |= ImGui::DragFloat("Redistribution##TerTmp", &Params_.Temperature.Redist, 0.01f);
+		isChanged |= ImGui::DragFloat3("Offset##TerTmp", reinterpret_cast<float*>(&Params_.Temperature.Offset), 0.01f);
+		isChanged |= ImGui::DragInt("Octaves##TerTmp", reinterpret_cast<int*>(&Params_.Temperature.Num_Octaves), 0.1f, 1, 32);
+		isChanged |= ImGui::DragFloat("Persistance##TerTmp", &Params_.Temperature.Persistance, 0.01f, 0.0f, 0.875f);
 
 		ImGui::SeparatorText("Precipitation");
-		ImGui::DragFloat("Frequency##TerPcp", &PrecipitationNoiseParam_.Frequency, 0.01f);
-		ImGui::DragFloat("Redistribution##TerPcp", &PrecipitationNoiseParam_.Redist, 0.01f);
-		ImGui::DragFloat3("Offset##TerPcp", reinterpret_cast<float*>(&PrecipitationNoiseParam_.Offset), 0.01f);
-		ImGui::DragInt("Octaves##TerPcp", reinterpret_cast<int*>(&PrecipitationNoiseParam_.Num_Octaves), 0.1f, 1, 32);
-		ImGui::DragFloat("Persistance##TerPcp", &PrecipitationNoiseParam_.Persistance, 0.01f, 0.0f, 0.875f);
-		if (ImGui::Button("Update##TerPcp")) {
-			UpdatePrecipitation(directQueue_);
+		isChanged |= ImGui::DragFloat("Frequency##TerPcp", &Params_.Precipitation.Frequency, 0.01f);
+		isChanged |= ImGui::DragFloat("Redistribution##TerPcp", &Params_.Precipitation.Redist, 0.01f);
+		isChanged |= ImGui::DragFloat3("Offset##TerPcp", reinterpret_cast<float*>(&Params_.Precipitation.Offset), 0.01f);
+		isChanged |= ImGui::DragInt("Octaves##TerPcp", reinterpret_cast<int*>(&Params_.Precipitation.Num_Octaves), 0.1f, 1, 32);
+		isChanged |= ImGui::DragFloat("Persistance##TerPcp", &Params_.Precipitation.Persistance, 0.01f, 0.0f, 0.875f);
+
+		if (isChanged) {
+			Submission_Last_ = Pipeline_->Submit(Params_);
 		}
+		Upload(directQueue_);
+
+		ImGui::Separator();
+		ImGui::Text((Submission_Uploaded_ < Submission_Last_) ? "Regenerating..." : "Up to date");
 
 		ImGui::End();
 	}
 
+	void Terrain::Upload(DX12::CommandQueue& directQueue_) {
+		Pipeline_->ReadLatest([this, &directQueue_] (TerrainPipeline::Result const& result_, uint32_t outputs_) {
+			Submission_Uploaded_ = result_.Submission;
+			if (outputs_ == 0U) { return; }
+
+			// A result takes far longer than a copy, so the last one is long done by now.
+			directQueue_.CPUWait(FenceValue_Upload_);
+			DirectList_.Reset(DirectAllocator_);
+			if ((outputs_ & TerrainPipeline::OUTPUT_SURFLETS) != 0U) {
+				MapSurfletUpload_.Store(result_.Surflets, MapSurfletUpload_.SizeInBytes(), 0U);
+				DirectList_->CopyResource(MapSurfletBuffer_.Get(), MapSurfletUpload_.Get());
+			}
+			if ((outputs_ & TerrainPipeline::OUTPUT_CLIMATE) != 0U) {
+				ClimateUpload_.Store(result_.ClimateData, ClimateUpload_.SizeInBytes(), 0U);
+				DirectList_->CopyResource(ClimateBuffer_.Get(), ClimateUpload_.Get());
+			}
+			directQueue_ << DirectList_;
+			FenceValue_Upload_ = directQueue_.ExecuteBatchedCommandLists();
+		});
+	}
+
 	void Terrain::Render(
 		DX12::CommandList& directList_,
 		const DX12::DescriptorHeap& cbvsrvuavHeap_,
@@ -318,11 +186,11 @@ namespace Lumina {
 		DirectAllocator_.Initialize(device, D3D12_COMMAND_LIST_TYPE_DIRECT, "GraphicsCmdAllocator@Terrain");
 		DirectList_.Initialize(device, DirectAllocator_, "GraphicsCmdList@Terrain");
 
-		MapSurflets_ = new MapSurflet[Width_ * Height_];
+		Pipeline_ = std::make_unique<TerrainPipeline>(Width_, Height_, Params_);
+
 		MapSurfletBuffer_.Initialize(device, sizeof(MapSurflet) * Width_ * Height_, "MapSurflet");
 		MapSurfletUpload_.Initialize(device, MapSurfletBuffer_.SizeInBytes(), "MapSurfletUpload");
 
-		ClimateData_ = new Climate[Width_ * Height_];
 		ClimateBuffer_.Initialize(device, sizeof(Climate) * Width_ * Height_, "ClimateMap");
 		ClimateUpload_.Initialize(device, ClimateBuffer_.SizeInBytes(), "ClimateMapUpload");
 
@@ -411,21 +279,8 @@ namespace Lumina {
 
 		DirectList_->CopyResource(QuadVertexBuffer_.Get(), vbTmp.Get());
 		DirectList_->CopyResource(QuadIndexBuffer_.Get(), ibTmp.Get());
+		// Left closed; Upload resets it when a result comes in.
 		directQueue << DirectList_;
 		directQueue.CPUWait(directQueue.ExecuteBatchedCommandLists());
-		DirectList_.Reset(DirectAllocator_);
-
-		UpdateElevation(directQueue);
-	}
-
-	Terrain::~Terrain() {
-		if (MapSurflets_ != nullptr) {
-			delete[] MapSurflets_;
-			MapSurflets_ = nullptr;
-		}
-		if (ClimateData_ != nullptr) {
-			delete[] ClimateData_;
-			ClimateData_ = nullptr;
-		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,527 @@
+export module Lumina.TerrainPipeline;
+
+//****	******	******	******	******	****//
+
+import <cstdint>;
+import <cstddef>;
+
+import <cmath>;
+import <chrono>;
+import <atomic>;
+import <mutex>;
+import <condition_variable>;
+import <stop_token>;
+import <thread>;
+
+import <memory>;
+import <array>;
+
+import Lumina.Math.Numerics;
+import Lumina.Math.Vector;
+import Lumina.Math.PerlinNoise;
+
+import Lumina.Container.VirtualArena;
+
+//////	//////	//////	//////	//////	//////
+
+// The CPU side of the procedural terrain: elevation, normals and climate over a grid, built in stages on a worker thread.
+//
+//	- Every stage keeps what it made, and runs again only when a param it reads, or a stage it reads from, changes;
+//	  dragging the redistribution of the temperature costs the temperature stage alone, not three noise fields.
+//	- Params submitted in quick succession are taken together once none has come for the debounce delay.
+//	  Newer params also cut a run short, between stages or between rows of noise; the stages that finished
+//	  keep what they made.
+//	- A run writes its result into the back of two buffers, swapped with the front under a lock once whole.
+//	  The owner reads the front under the same lock, so neither side waits on the other but for the swap.
+
+namespace Lumina {
+	export struct NoiseParam {
+		float Frequency;
+		float Redist;
+		Float3 Offset;
+		uint32_t Num_Octaves;
+		float Persistance;
+	};
+
+	// Laid out as the terrain's structured buffers are read in Assets/ShaderTest/Terrain*.hlsl.
+	export struct MapSurflet {
+		float Elevation;
+		Float3 Normal;
+	};
+
+	export struct Climate {
+		float Temperature;
+		float Precipitation;
+	};
+
+	// Everything the terrain is made from; the defaults are what the editor starts with.
+	export struct TerrainParams {
+		NoiseParam Elevation{
+			.Frequency{ 0.4f },
+			.Redist{ 2.0f },
+			.Offset{ 0.0f, 0.0f, 0.0f },
+			.Num_Octaves{ 8U },
+			.Persistance{ 0.5f },
+		};
+		float Insulation{ 0.3f };
+		bool IsFormingTerraces{ false };
+		float TerraceFactor{ 8.0f };
+
+		NoiseParam Temperature{
+			.Frequency{ 1.0f },
+			.Redist{ 1.0f },
+			.Offset{ 1.0f, 3.0f, 5.0f },
+			.Num_Octaves{ 2U },
+			.Persistance{ 0.25f },
+		};
+		NoiseParam Precipitation{
+			.Frequency{ 2.0f },
+			.Redist{ 1.0f },
+			.Offset{ 2.0f, 3.0f, 4.0f },
+			.Num_Octaves{ 2U },
+			.Persistance{ 0.25f },
+		};
+	};
+
+	export class TerrainPipeline {
+	public:
+		// Every stage comes after those it reads.
+		enum STAGE : uint32_t {
+			ELEVATION_NOISE,
+			MASK,
+			REDISTRIBUTION,
+			TERRACES,
+			NORMALS,
+			TEMPERATURE_NOISE,
+			TEMPERATURE,
+			PRECIPITATION_NOISE,
+			PRECIPITATION,
+			NUM_STAGES,
+		};
+
+		// Bits telling which parts of a result changed.
+		enum OUTPUT : uint32_t {
+			OUTPUT_SURFLETS = 1U << 0U,
+			OUTPUT_CLIMATE = 1U << 1U,
+			OUTPUT_ALL = OUTPUT_SURFLETS | OUTPUT_CLIMATE,
+		};
+
+		struct Result {
+			// Width x height of each, row by row.
+			MapSurflet* Surflets;
+			Climate* ClimateData;
+			// That of the last params it is of, as Submit returned it; 0 for those the pipeline was built with.
+			uint64_t Submission;
+		};
+
+		// As of the latest result.
+		struct Statistics {
+			uint64_t Num_Results{ 0LLU };
+			// Runs of each stage, those of runs cut short included.
+			std::array<uint64_t, NUM_STAGES> Num_Runs{};
+			// From the params of a result being submitted to it being swapped in, debounce included.
+			std::chrono::nanoseconds Latency_Last{};
+			std::chrono::nanoseconds Latency_Max{};
+		};
+
+	public:
+		// Takes params_ for the next run, in place of those not yet taken; returns the count of submissions so far.
+		uint64_t Submit(TerrainParams const& params_);
+		// Calls read_(Result const&, uint32_t outputs) with the front result if one came since the last call,
+		// outputs telling which parts changed since then, if any; returns whether it was called.
+		// The worker cannot swap in a newer result until read_ returns.
+		template<typename Reader>
+		bool ReadLatest(Reader&& read_) {
+			std::lock_guard<std::mutex> lockGuard{ Mutex_ };
+			if (Num_Read_ == Statistics_.Num_Results) { return false; }
+			read_(Results_[idx_Back_ ^ 1U], Outputs_Unread_);
+			Num_Read_ = Statistics_.Num_Results;
+			Outputs_Unread_ = 0U;
+			return true;
+		}
+
+	public:
+		uint32_t Width() const noexcept { return Width_; }
+		uint32_t Height() const noexcept { return Height_; }
+		Statistics GetStatistics() const {
+			std::lock_guard<std::mutex> lockGuard{ Mutex_ };
+			return Statistics_;
+		}
+
+	private:
+		// Stages whose own params differ between the two, without those reading from them.
+		static uint32_t Invalidated(TerrainParams const& old_, TerrainParams const& new_) noexcept;
+		// Adds to stages_ every stage reading from one in it.
+		static uint32_t Propagate(uint32_t stages_) noexcept;
+
+		// Returns whether the stage finished; noise gives up between rows once isCancelled_() holds.
+		template<typename Cancelled>
+		bool Run(STAGE stage_, Cancelled const& isCancelled_);
+		// Writes the outputs_ of the stages into result_.
+		void Write(Result const& result_, uint32_t outputs_) const noexcept;
+
+		void Work(std::stop_token stop_);
+
+	public:
+		// The first run takes params_ without waiting out delay_Debounce_.
+		TerrainPipeline(
+			uint32_t width_,
+			uint32_t height_,
+			TerrainParams const& params_ = {},
+			std::chrono::nanoseconds delay_Debounce_ = std::chrono::milliseconds{ 50 }
+		);
+		~TerrainPipeline() noexcept = default;
+
+		TerrainPipeline(TerrainPipeline const&) = delete;
+		TerrainPipeline& operator=(TerrainPipeline const&) = delete;
+
+		//====	======	======	======	======	====//
+
+	private:
+		uint32_t Width_;
+		uint32_t Height_;
+		std::chrono::nanoseconds Delay_Debounce_;
+
+		// Every field and both results; on large pages where the system allows.
+		std::unique_ptr<VirtualArena> Fields_{};
+
+		// What each stage made, read by the worker alone.
+		float* ElevationNoise_{ nullptr };
+		float* Mask_{ nullptr };
+		float* Redistributed_{ nullptr };
+		float* Elevation_{ nullptr };
+		Float3* Normals_{ nullptr };
+		float* TemperatureNoise_{ nullptr };
+		float* Temperature_{ nullptr };
+		float* PrecipitationNoise_{ nullptr };
+		float* Precipitation_{ nullptr };
+
+		// The worker's: the params the stages are of, those still to run, and the outputs they changed.
+		TerrainParams Params_{};
+		uint32_t Stages_Dirty_{ (1U << NUM_STAGES) - 1U };
+		uint32_t Outputs_Pending_{ 0U };
+		// Outputs each result has yet to catch up on, having been behind the front when it was written.
+		uint32_t Outputs_Outdated_[2]{ OUTPUT_ALL, OUTPUT_ALL };
+		std::array<uint64_t, NUM_STAGES> Num_Runs_{};
+
+		Result Results_[2]{};
+
+		mutable std::mutex Mutex_{};
+		std::condition_variable_any Condition_{};
+		// Guarded by Mutex_; IsSubmitted_ is also read without it, to cut a run short.
+		TerrainParams Submitted_{};
+		std::chrono::steady_clock::time_point Time_Submitted_{};
+		uint64_t Num_Submissions_{ 0LLU };
+		std::atomic<bool> IsSubmitted_{ false };
+		uint32_t idx_Back_{ 0U };
+		uint32_t Outputs_Unread_{ 0U };
+		uint64_t Num_Read_{ 0LLU };
+		Statistics Statistics_{};
+
+		// Last, so that it stops before anything it works on goes.
+		std::jthread Worker_{};
+	};
+}
+
+//****	******	******	******	******	****//
+
+namespace Lumina {
+	// The grid is sampled every 1/32 of a unit, whatever its size.
+	inline constexpr float SampleSpacing{ 1.0f / 32.0f };
+
+	namespace {
+		bool IsSameNoise(NoiseParam const& lhs_, NoiseParam const& rhs_) noexcept {
+			return
+				lhs_.Frequency == rhs_.Frequency &&
+				lhs_.Offset.x == rhs_.Offset.x && lhs_.Offset.y == rhs_.Offset.y && lhs_.Offset.z == rhs_.Offset.z &&
+				lhs_.Num_Octaves == rhs_.Num_Octaves &&
+				lhs_.Persistance == rhs_.Persistance;
+		}
+	}
+
+	// Returns whether every row was sampled.
+	// Neither this nor SampleSpacing is in the unnamed namespace: Run(), a template the module exports, uses both.
+	template<typename Cancelled>
+	bool SampleNoise(NoiseParam const& param_, uint32_t width_, uint32_t height_, float* field_, Cancelled const& isCancelled_) {
+		PerlinNoise const noiseGen{
+			param_.Frequency,
+			param_.Num_Octaves,
+			param_.Persistance,
+			param_.Offset
+		};
+		for (uint32_t v{ 0U }; v < height_; ++v) {
+			if (isCancelled_()) { return false; }
+			for (uint32_t u{ 0U }; u < width_; ++u) {
+				field_[v * width_ + u] = noiseGen(u * SampleSpacing, v * SampleSpacing, 0.0f);
+			}
+		}
+		return true;
+	}
+
+	namespace {
+		constexpr uint32_t Bit(uint32_t stage_) noexcept { return 1U << stage_; }
+
+		// The stages each stage reads from.
+		constexpr std::array<uint32_t, TerrainPipeline::NUM_STAGES> Reads{
+			0U,
+			0U,
+			Bit(TerrainPipeline::ELEVATION_NOISE) | Bit(TerrainPipeline::MASK),
+			Bit(TerrainPipeline::REDISTRIBUTION),
+			Bit(TerrainPipeline::TERRACES),
+			0U,
+			Bit(TerrainPipeline::TEMPERATURE_NOISE) | Bit(TerrainPipeline::TERRACES),
+			0U,
+			Bit(TerrainPipeline::PRECIPITATION_NOISE),
+		};
+
+		// The output each stage shows up in, if any.
+		constexpr std::array<uint32_t, TerrainPipeline::NUM_STAGES> Outputs{
+			0U,
+			0U,
+			0U,
+			TerrainPipeline::OUTPUT_SURFLETS,
+			TerrainPipeline::OUTPUT_SURFLETS,
+			0U,
+			TerrainPipeline::OUTPUT_CLIMATE,
+			0U,
+			TerrainPipeline::OUTPUT_CLIMATE,
+		};
+	}
+
+	uint64_t TerrainPipeline::Submit(TerrainParams const& params_) {
+		uint64_t submission{ 0LLU };
+		{
+			std::lock_guard<std::mutex> lockGuard{ Mutex_ };
+			Submitted_ = params_;
+			Time_Submitted_ = std::chrono::steady_clock::now();
+			submission = ++Num_Submissions_;
+			IsSubmitted_.store(true, std::memory_order_relaxed);
+		}
+		Condition_.notify_one();
+		return submission;
+	}
+
+	//----	------	------	------	------	----//
+
+	uint32_t TerrainPipeline::Invalidated(TerrainParams const& old_, TerrainParams const& new_) noexcept {
+		uint32_t stages{ 0U };
+		if (!IsSameNoise(old_.Elevation, new_.Elevation)) { stages |= Bit(ELEVATION_NOISE); }
+		if (old_.Elevation.Redist != new_.Elevation.Redist || old_.Insulation != new_.Insulation) { stages |= Bit(REDISTRIBUTION); }
+		// The factor is only read while forming terraces.
+		if (old_.IsFormingTerraces != new_.IsFormingTerraces || (new_.IsFormingTerraces && old_.TerraceFactor != new_.TerraceFactor)) {
+			stages |= Bit(TERRACES);
+		}
+		if (!IsSameNoise(old_.Temperature, new_.Temperature)) { stages |= Bit(TEMPERATURE_NOISE); }
+		if (old_.Temperature.Redist != new_.Temperature.Redist) { stages |= Bit(TEMPERATURE); }
+		if (!IsSameNoise(old_.Precipitation, new_.Precipitation)) { stages |= Bit(PRECIPITATION_NOISE); }
+		if (old_.Precipitation.Redist != new_.Precipitation.Redist) { stages |= Bit(PRECIPITATION); }
+		return stages;
+	}
+
+	uint32_t TerrainPipeline::Propagate(uint32_t stages_) noexcept {
+		// Stages come after those they read, so one pass carries a change all the way down.
+		for (uint32_t stage{ 0U }; stage < NUM_STAGES; ++stage) {
+			if ((stages_ & Reads[stage]) != 0U) { stages_ |= Bit(stage); }
+		}
+		return stages_;
+	}
+
+	//----	------	------	------	------	----//
+
+	template<typename Cancelled>
+	bool TerrainPipeline::Run(STAGE stage_, Cancelled const& isCancelled_) {
+		switch (stage_) {
+			case ELEVATION_NOISE: {
+				return SampleNoise(Params_.Elevation, Width_, Height_, ElevationNoise_, isCancelled_);
+			}
+			// Falls off towards the edges, making an island of what Insulation weighs it in for.
+			case MASK: {
+				float const inv_Width{ 1.0f / static_cast<float>(Width_) };
+				float const inv_Height{ 1.0f / static_cast<float>(Height_) };
+				for (uint32_t v{ 0U }; v < Height_; ++v) {
+					for (uint32_t u{ 0U }; u < Width_; ++u) {
+						float const nu{ 2.0f * u * inv_Width - 1.0f };
+						float const nv{ 2.0f * v * inv_Height - 1.0f };
+						Mask_[v * Width_ + u] = (1.0f - nu * nu) * (1.0f - nv * nv);
+					}
+				}
+				break;
+			}
+			case REDISTRIBUTION: {
+				float const insulation{ Params_.Insulation };
+				for (uint32_t i{ 0U }; i < Width_ * Height_; ++i) {
+					float const val{ ElevationNoise_[i] * (1.0f - insulation) + Mask_[i] * insulation };
+					Redistributed_[i] = std::pow(val, Params_.Elevation.Redist) * 2.0f;
+				}
+				break;
+			}
+			case TERRACES: {
+				float const terraceFactor{ Params_.TerraceFactor };
+				float const inv_TerraceFactor{ 1.0f / terraceFactor };
+				for (uint32_t i{ 0U }; i < Width_ * Height_; ++i) {
+					Elevation_[i] = Params_.IsFormingTerraces ?
+						std::round(Redistributed_[i] * terraceFactor) * inv_TerraceFactor :
+						Redistributed_[i];
+				}
+				break;
+			}
+			case NORMALS: {
+				for (uint32_t v{ 0U }; v < Height_; ++v) {
+					uint32_t const v0{ (v == 0U) ? v : (v - 1U) };
+					uint32_t const v1{ (v == Height_ - 1U) ? v : (v + 1U) };
+
+					for (uint32_t u{ 0U }; u < Width_; ++u) {
+						uint32_t const u0{ (u == 0U) ? u : (u - 1U) };
+						uint32_t const u1{ (u == Width_ - 1U) ? u : (u + 1U) };
+
+						Vec3 const df_du{ (u1 - u0) * SampleSpacing, 0.0f, Elevation_[v * Width_ + u1] - Elevation_[v * Width_ + u0] };
+						Vec3 const df_dv{ 0.0f, (v1 - v0) * SampleSpacing, Elevation_[v1 * Width_ + u] - Elevation_[v0 * Width_ + u] };
+						Vec3 const unit{ Vec3::Cross(df_du, df_dv).Unit() };
+						Normals_[v * Width_ + u] = { unit.x, unit.y, unit.z };
+					}
+				}
+				break;
+			}
+			case TEMPERATURE_NOISE: {
+				return SampleNoise(Params_.Temperature, Width_, Height_, TemperatureNoise_, isCancelled_);
+			}
+			// Colder towards the poles and up high.
+			case TEMPERATURE: {
+				float const inv_Height{ 1.0f / static_cast<float>(Height_) };
+				for (uint32_t v{ 0U }; v < Height_; ++v) {
+					float const latFactor{
+						(1.0f - std::abs(static_cast<int32_t>(v << 1U) - static_cast<int32_t>(Height_)) * inv_Height)
+					};
+					float const latTerm{ std::pow(latFactor, 1.5f) * 0.35f };
+					for (uint32_t u{ 0U }; u < Width_; ++u) {
+						uint32_t const i{ v * Width_ + u };
+						float const elvFactor{ 1.0f - Elevation_[i] * 0.5f };
+						Temperature_[i] = (std::pow(TemperatureNoise_[i], Params_.Temperature.Redist) * 0.65f + latTerm) * elvFactor;
+					}
+				}
+				break;
+			}
+			case PRECIPITATION_NOISE: {
+				return SampleNoise(Params_.Precipitation, Width_, Height_, PrecipitationNoise_, isCancelled_);
+			}
+			case PRECIPITATION: {
+				for (uint32_t i{ 0U }; i < Width_ * Height_; ++i) {
+					Precipitation_[i] = std::pow(PrecipitationNoise_[i], Params_.Precipitation.Redist);
+				}
+				break;
+			}
+			default: {
+				break;
+			}
+		}
+		return true;
+	}
+
+	void TerrainPipeline::Write(Result const& result_, uint32_t outputs_) const noexcept {
+		uint32_t const num_Tiles{ Width_ * Height_ };
+		if ((outputs_ & OUTPUT_SURFLETS) != 0U) {
+			for (uint32_t i{ 0U }; i < num_Tiles; ++i) { result_.Surflets[i] = { Elevation_[i], Normals_[i] }; }
+		}
+		if ((outputs_ & OUTPUT_CLIMATE) != 0U) {
+			for (uint32_t i{ 0U }; i < num_Tiles; ++i) { result_.ClimateData[i] = { Temperature_[i], Precipitation_[i] }; }
+		}
+	}
+
+	//----	------	------	------	------	----//
+
+	void TerrainPipeline::Work(std::stop_token stop_) {
+		std::unique_lock<std::mutex> lock{ Mutex_ };
+		while (true) {
+			if (!Condition_.wait(lock, stop_, [this] { return IsSubmitted_.load(std::memory_order_relaxed); })) { return; }
+			// Waits for the params to settle; every submission in the meantime pushes the start back.
+			for (
+				auto deadline{ Time_Submitted_ + Delay_Debounce_ };
+				std::chrono::steady_clock::now() < deadline;
+				deadline = Time_Submitted_ + Delay_Debounce_
+			) {
+				Condition_.wait_until(lock, stop_, deadline, [] { return false; });
+				if (stop_.stop_requested()) { return; }
+			}
+
+			IsSubmitted_.store(false, std::memory_order_relaxed);
+			Stages_Dirty_ = Propagate(Stages_Dirty_ | Invalidated(Params_, Submitted_));
+			Params_ = Submitted_;
+			auto const time_Submitted{ Time_Submitted_ };
+			uint64_t const submission{ Num_Submissions_ };
+			lock.unlock();
+
+			auto const isCancelled{
+				[this, &stop_] () { return IsSubmitted_.load(std::memory_order_relaxed) || stop_.stop_requested(); }
+			};
+			for (uint32_t stage{ 0U }; stage < NUM_STAGES && !isCancelled(); ++stage) {
+				if ((Stages_Dirty_ & Bit(stage)) == 0U) { continue; }
+				++Num_Runs_[stage];
+				if (!Run(static_cast<STAGE>(stage), isCancelled)) { break; }
+				Stages_Dirty_ &= ~Bit(stage);
+				Outputs_Pending_ |= Outputs[stage];
+			}
+			// Cut short; the stages left run with the newer params, or not at all when stopping.
+			if (Stages_Dirty_ != 0U) {
+				lock.lock();
+				continue;
+			}
+
+			// The back result is the owner's no longer, nor again until the swap.
+			uint32_t const idx_Back{ idx_Back_ };
+			Write(Results_[idx_Back], Outputs_Pending_ | Outputs_Outdated_[idx_Back]);
+			Outputs_Outdated_[idx_Back] = 0U;
+			Results_[idx_Back].Submission = submission;
+			Outputs_Outdated_[idx_Back ^ 1U] |= Outputs_Pending_;
+
+			lock.lock();
+			idx_Back_ = idx_Back ^ 1U;
+			Outputs_Unread_ |= Outputs_Pending_;
+			Outputs_Pending_ = 0U;
+
+			auto const latency{ std::chrono::steady_clock::now() - time_Submitted };
+			++Statistics_.Num_Results;
+			Statistics_.Num_Runs = Num_Runs_;
+			Statistics_.Latency_Last = std::chrono::duration_cast<std::chrono::nanoseconds>(latency);
+			if (Statistics_.Latency_Last > Statistics_.Latency_Max) { Statistics_.Latency_Max = Statistics_.Latency_Last; }
+		}
+	}
+
+	//----	------	------	------	------	----//
+
+	TerrainPipeline::TerrainPipeline(
+		uint32_t width_,
+		uint32_t height_,
+		TerrainParams const& params_,
+		std::chrono::nanoseconds delay_Debounce_
+	) :
+		Width_{ width_ },
+		Height_{ height_ },
+		Delay_Debounce_{ delay_Debounce_ },
+		Params_{ params_ },
+		Submitted_{ params_ } {
+		size_t const num_Tiles{ static_cast<size_t>(Width_) * Height_ };
+		Fields_ = std::make_unique<VirtualArena>(
+			(sizeof(float) * 8LLU + sizeof(Float3) + (sizeof(MapSurflet) + sizeof(Climate)) * 2LLU) * num_Tiles + 256LLU,
+			PAGE_SIZE::LARGE
+		);
+
+		ElevationNoise_ = Fields_->Allocate<float>(num_Tiles);
+		Mask_ = Fields_->Allocate<float>(num_Tiles);
+		Redistributed_ = Fields_->Allocate<float>(num_Tiles);
+		Elevation_ = Fields_->Allocate<float>(num_Tiles);
+		Normals_ = Fields_->Allocate<Float3>(num_Tiles);
+		TemperatureNoise_ = Fields_->Allocate<float>(num_Tiles);
+		Temperature_ = Fields_->Allocate<float>(num_Tiles);
+		PrecipitationNoise_ = Fields_->Allocate<float>(num_Tiles);
+		Precipitation_ = Fields_->Allocate<float>(num_Tiles);
+		for (auto& result : Results_) {
+			result.Surflets = Fields_->Allocate<MapSurflet>(num_Tiles);
+			result.ClimateData = Fields_->Allocate<Climate>(num_Tiles);
+		}
+
+		// Every stage is dirty to begin with.
+		Time_Submitted_ = std::chrono::steady_clock::now() - Delay_Debounce_;
+		IsSubmitted_.store(true, std::memory_order_relaxed);
+		Worker_ = std::jthread{ [this] (std::stop_token stop_) { Work(stop_); } };
+	}
+}
\ No newline at end of file
@@ -306,10 +306,7 @@ int32_t WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 	 
 	auto& directQueue{ dx12Context.DirectQueue() };
 	/*Lumina::Terrain terrain{};
-	terrain.Initialize(dx12Context);
-	terrain.UpdateElevation(directQueue);
-	terrain.UpdateTemperature(directQueue);
-	terrain.UpdatePrecipitation(directQueue);*/
+	terrain.Initialize(dx12Context);*/
 
 	//----	------	------	------	------	----//
 
@@ -329,7 +326,16 @@ int32_t WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 	auto const& keyboard = mainWindowRawInput.Keyboard();
 	auto const& mouse = mainWindowRawInput.Mouse();
 
+	// Allocations the main thread made in the previous frame, and the frames that made any past the first few,
+	// for the Performance window.
+	uint64_t num_FrameAllocations{ 0LLU };
+	uint64_t num_AllocatingFrames{ 0LLU };
+	uint64_t num_Frames{ 0LLU };
+
 	while (winAppContext.ProcessMessage() == 0) {
+		// The frame is to allocate nothing once warmed up; counted only, as the tool UI still does.
+		LU::Debug::AllocationTracker::NoAllocationScope const frameScope{ false };
+
 		dx12Context.BeginFrame(cmdList);
 		
 		//----	------	------	------	------	----//
@@ -438,49 +444,60 @@ int32_t WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 		auto deltaTime = horometer.DeltaTime();
 		auto fps = 1000.0f / static_cast<float>(deltaTime.count());
 
-		ImGui::Begin("Performance");
-		ImGui::Text("Frame Time = %u", horometer.DeltaTime().count());
-		ImGui::Text("FPS = %f", fps);
-		ImGui::Text("FPS = %f", ImGui::GetIO().Framerate);
-		ImGui::End();
-
-		ImGui::Begin("Raw Input Test");
-
-		ImGui::SeparatorText("Keyboard");
-		ImGui::BulletText("L SHIFT = %d", keyboard.IsPressed(Lumina::WinApp::KEY::SHIFT_LEFT));
-		ImGui::BulletText("R SHIFT = %d", keyboard.IsPressed(Lumina::WinApp::KEY::SHIFT_RIGHT));
-		ImGui::BulletText("L CTRL = %d", keyboard.IsPressed(Lumina::WinApp::KEY::CTRL_LEFT));
-		ImGui::BulletText("R CTRL = %d", keyboard.IsPressed(Lumina::WinApp::KEY::CTRL_RIGHT));
-
-		ImGui::SeparatorText("Mouse");
-		ImGui::BulletText("PosX = %d", mouse.PosX());
-		ImGui::BulletText("PosY = %d", mouse.PosY());
-		ImGui::BulletText("DeltaX = %d", mouse.DeltaX());
-		ImGui::BulletText("DeltaY = %d", mouse.DeltaY());
-		ImGui::BulletText("LeftButton = %d", mouse.LeftButton());
-		ImGui::BulletText("RightButton = %d", mouse.RightButton());
-		ImGui::BulletText("Wheel = %d", mouse.Wheel());
-		ImGui::BulletText("Wheel = %d", mouse.DeltaWheel());
-		ImGui::End();
-
-		ImGui::Begin("Quaternion");
-		static Lumina::Quaternion pose{};
-		static Lumina::Vec4 vec{ 0.0f, 0.0f, 0.0f, 1.0f };
-		static Lumina::Float3 poseAxis{ 1.0f, 0.0f, 0.0f };
-		static float poseAngle{ 0.0f };
-		ImGui::DragFloat3("Axis", &poseAxis.x, 0.01f);
-		ImGui::DragFloat("Angle", &poseAngle, 0.01f);
-		ImGui::DragFloat4("Vec", vec(), 0.01f);
-		pose = Lumina::Quaternion::RotateAbout(poseAxis, poseAngle);
-		ImGui::DragFloat4("Rotate", &pose.x, 0.0f);
-		ImGui::Text("Re = %f", pose.Re(), 0.0f);
-		ImGui::Text("Im = (%f, %f, %f)", pose.Im().x, pose.Im().y, pose.Im().z, 0.0f);
-		ImGui::DragFloat4("Rotated Vec", Lumina::Quaternion::Rotate(vec, pose)(), 0.0f);
-		ImGui::End();
-
-		ImGui::ShowStyleEditor();
-
-		dxEditor.Update();
+		{
+			// Tool UI: labels formatted every frame, and ImGui's own state.
+			LU::Debug::AllocationTracker::TagScope const tagScope{ LU::Debug::ALLOCATION_TAG::DEBUG };
+
+			ImGui::Begin("Performance");
+			ImGui::Text("Frame Time = %u", horometer.DeltaTime().count());
+			ImGui::Text("FPS = %f", fps);
+			ImGui::Text("FPS = %f", ImGui::GetIO().Framerate);
+			if constexpr (LU::Debug::AllocationTracker::IsEnabled) {
+				auto const total{ LU::Debug::AllocationTracker::Total() };
+				ImGui::Text("Allocations / Frame = %llu", num_FrameAllocations);
+				ImGui::Text("Allocating Frames = %llu / %llu", num_AllocatingFrames, num_Frames);
+				ImGui::Text("Live Heap = %llu KiB (Peak %llu KiB)", total.LiveBytes >> 10U, total.PeakBytes >> 10U);
+			}
+			ImGui::End();
+
+			ImGui::Begin("Raw Input Test");
+
+			ImGui::SeparatorText("Keyboard");
+			ImGui::BulletText("L SHIFT = %d", keyboard.IsPressed(Lumina::WinApp::KEY::SHIFT_LEFT));
+			ImGui::BulletText("R SHIFT = %d", keyboard.IsPressed(Lumina::WinApp::KEY::SHIFT_RIGHT));
+			ImGui::BulletText("L CTRL = %d", keyboard.IsPressed(Lumina::WinApp::KEY::CTRL_LEFT));
+			ImGui::BulletText("R CTRL = %d", keyboard.IsPressed(Lumina::WinApp::KEY::CTRL_RIGHT));
+
+			ImGui::SeparatorText("Mouse");
+			ImGui::BulletText("PosX = %d", mouse.PosX());
+			ImGui::BulletText("PosY = %d", mouse.PosY());
+			ImGui::BulletText("DeltaX = %d", mouse.DeltaX());
+			ImGui::BulletText("DeltaY = %d", mouse.DeltaY());
+			ImGui::BulletText("LeftButton = %d", mouse.LeftButton());
+			ImGui::BulletText("RightButton = %d", mouse.RightButton());
+			ImGui::BulletText("Wheel = %d", mouse.Wheel());
+			ImGui::BulletText("Wheel = %d", mouse.DeltaWheel());
+			ImGui::End();
+
+			ImGui::Begin("Quaternion");
+			static Lumina::Quaternion pose{};
+			static Lumina::Vec4 vec{ 0.0f, 0.0f, 0.0f, 1.0f };
+			static Lumina::Float3 poseAxis{ 1.0f, 0.0f, 0.0f };
+			static float poseAngle{ 0.0f };
+			ImGui::DragFloat3("Axis", &poseAxis.x, 0.01f);
+			ImGui::DragFloat("Angle", &poseAngle, 0.01f);
+			ImGui::DragFloat4("Vec", vec(), 0.01f);
+			pose = Lumina::Quaternion::RotateAbout(poseAxis, poseAngle);
+			ImGui::DragFloat4("Rotate", &pose.x, 0.0f);
+			ImGui::Text("Re = %f", pose.Re(), 0.0f);
+			ImGui::Text("Im = (%f, %f, %f)", pose.Im().x, pose.Im().y, pose.Im().z, 0.0f);
+			ImGui::DragFloat4("Rotated Vec", Lumina::Quaternion::Rotate(vec, pose)(), 0.0f);
+			ImGui::End();
+
+			ImGui::ShowStyleEditor();
+
+			dxEditor.Update();
+		}
 
 		//pnTest.Update();
 
@@ -495,6 +512,15 @@ int32_t WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 		if (keyboard.IsPressed(Lumina::WinApp::KEY::ESC)) {
 			::SendMessage(mainWindow.Handle(), WM_CLOSE, 0, 0);
 		}
+
+		num_FrameAllocations = frameScope.Num_Allocations();
+		// The first frames fill caches and pools.
+		constexpr uint64_t Num_WarmUpFrames{ 60LLU };
+		if (++num_Frames > Num_WarmUpFrames && num_FrameAllocations > 0LLU) { ++num_AllocatingFrames; }
+	}
+
+	if constexpr (LU::Debug::AllocationTracker::IsEnabled) {
+		LU::Debug::Logger::Default().Message<0U>("{}", LU::Debug::AllocationTracker::Report());
 	}
 
 	directQueue.SignalAndCPUWait();